@@ -0,0 +1,412 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - Benchmark.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Loopback benchmarks of the LiCAS ECI. The LiCAS simulator is executed in the same process and
+ * the interface is connected to it through localhost, measuring the hot paths of the interface:
+ * sending of control references and command-to-feedback latency. The results are printed on
+ * stderr, one per line, with the format "BENCH <name> <value> <units>". It fails if a reference is
+ * not received back, if the idle mode does not reduce the wake-ups of the reception thread or does
+ * not return to full rate within one feedback period, if the threads of the reactor are not
+ * accounted or a thread has a negative CPU usage, if the send and receive paths allocate memory,
+ * or if an event raised while the interface is closed is delivered by the thread raising it. This program is also used for training the profile of the PGO build (see LICAS_ECI_PGO
+ * option).
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_Scheduler.h"
+#include "../LiCAS_Simulator/LiCAS_Simulator.h"
+#include "Benchmark_Common.h"
+
+
+// Loopback ports (different from the default ones to coexist with a running LiCAS ECI)
+#define BENCH_UDP_CMD_PORT		23100
+#define BENCH_UDP_FEEDBACK_PORT	24100
+#define BENCH_FEEDBACK_RATE		500
+#define BENCH_LOOPBACK_TIMEOUT	0.5		// Timeout of the reference received back in [s]
+#define BENCH_SETTLING_TIMEOUT	5.0		// Timeout of the processing of the burst of references in [s]
+#define BENCH_IDLE_WAKEUP_RATIO	0.1		// Maximum ratio of the wake-ups in idle mode to the ones at full rate
+
+
+// Sink of the results, so the compiler can not remove the benchmarked operations
+static volatile float sink = 0;
+
+
+/*
+ * Time per call of the send path (packet building and sendto)
+ */
+static void benchmarkSend(LiCAS_ECI_UDP * licas_eci, int numIterations)
+{
+	float qLref[NUM_ARM_JOINTS] = {0};
+	float qRref[NUM_ARM_JOINTS] = {0};
+	double t0 = 0;
+	int k = 0;
+	
+	
+	t0 = getTime();
+	for(k = 0; k < numIterations; k++)
+	{
+		qLref[0] = 1e-4*k;
+		licas_eci->sendJointPositionRef(qLref, qRref, 0.02);
+	}
+	
+	printResult("send_joint_ref", 1e9*(getTime() - t0)/numIterations, "ns");
+	
+	// Wait until the simulator has processed the burst of references (some may be dropped by the
+	// socket buffer, so the last reference is sent again until it is followed)
+	t0 = getTime();
+	while(licas_eci->qL[0] != qLref[0] && getTime() - t0 < BENCH_SETTLING_TIMEOUT)
+	{
+		licas_eci->sendJointPositionRef(qLref, qRref, 0);
+		usleep(10000);
+	}
+}
+
+
+/*
+ * Time per call of the elapsed time stamp
+ */
+static void benchmarkElapsedTime(LiCAS_ECI_UDP * licas_eci, int numIterations)
+{
+	double t0 = 0;
+	int k = 0;
+	
+	
+	t0 = getTime();
+	for(k = 0; k < numIterations; k++)
+		sink = licas_eci->getElapsedTime();
+	
+	printResult("elapsed_time", 1e9*(getTime() - t0)/numIterations, "ns");
+}
+
+
+/*
+ * Latency from sending a joint reference to receiving it back in the feedback of the simulator.
+ * Every reference must be received back before the timeout.
+ */
+static int benchmarkLoopbackLatency(LiCAS_ECI_UDP * licas_eci, int numIterations)
+{
+	std::vector<double> latency;
+	float qLref[NUM_ARM_JOINTS] = {0};
+	float qRref[NUM_ARM_JOINTS] = {0};
+	double t0 = 0;
+	double sum = 0;
+	int numLost = 0;
+	int k = 0;
+	
+	
+	latency.reserve(numIterations);
+	for(k = 0; k < numIterations; k++)
+	{
+		qLref[0] = (float)(k + 1);
+		t0 = getTime();
+		licas_eci->sendJointPositionRef(qLref, qRref, 0);
+		while(licas_eci->qL[0] != qLref[0] && getTime() - t0 < BENCH_LOOPBACK_TIMEOUT)
+			usleep(50);
+		if(licas_eci->qL[0] != qLref[0])
+			numLost++;
+		latency.push_back(getTime() - t0);
+		sum += latency.back();
+	}
+	std::sort(latency.begin(), latency.end());
+	
+	printResult("loopback_latency_mean", 1e6*sum/numIterations, "us");
+	printResult("loopback_latency_p50", 1e6*latency[numIterations/2], "us");
+	printResult("loopback_latency_p99", 1e6*latency[(99*numIterations)/100], "us");
+	
+	
+	return checkResult("loopback_all_received", numLost == 0);
+}
+
+
+/*
+ * Wake-ups per second of the reception thread at full rate and in idle mode (adaptive scheduling),
+ * and time to return to full rate when a new command is sent. The idle mode must reduce the
+ * wake-ups, and the full rate must be restored within one feedback period.
+ */
+static int benchmarkIdleScheduling(LiCAS_ECI_UDP * licas_eci)
+{
+	LiCAS_ECI_STATISTICS statistics;
+	float qLref[NUM_ARM_JOINTS] = {0};
+	float qRref[NUM_ARM_JOINTS] = {0};
+	float wakeupsFullRate = 0;
+	float wakeupsIdle = 0;
+	double t0 = 0;
+	double resumeTime = 0;
+	int flagIdle = 0;
+	int errorCode = 0;
+	
+	
+	licas_eci->sendJointPositionRef(qLref, qRref, 0);
+	usleep(1200000);
+	licas_eci->getStatistics(&statistics);
+	wakeupsFullRate = statistics.rxWakeupsPerSecond;
+	printResult("rx_wakeups_full_rate", wakeupsFullRate, "1/s");
+	
+	// Stationary arms and constant commands: the interface enters in idle mode
+	licas_eci->setIdlePolicy(1, 0.5, 0.1);
+	usleep(2500000);
+	licas_eci->getStatistics(&statistics);
+	wakeupsIdle = statistics.rxWakeupsPerSecond;
+	flagIdle = statistics.flagIdle;
+	printResult("rx_wakeups_idle", wakeupsIdle, "1/s");
+	
+	// New command: time until the interface returns to full rate and the reference is received back
+	qLref[0] = 0.5;
+	t0 = getTime();
+	licas_eci->sendJointPositionRef(qLref, qRref, 0);
+	do
+	{
+		usleep(50);
+		licas_eci->getStatistics(&statistics);
+		resumeTime = getTime() - t0;
+	} while(statistics.flagIdle == 1 && resumeTime < 0.5);
+	while(licas_eci->qL[0] != qLref[0] && getTime() - t0 < 0.5)
+		usleep(50);
+	printResult("idle_resume_full_rate", 1e6*resumeTime, "us");
+	printResult("idle_resume_latency", 1e6*(getTime() - t0), "us");
+	
+	licas_eci->setIdlePolicy(0, 0.5, 0.1);
+	
+	errorCode |= checkResult("idle_wakeups_reduced", flagIdle == 1 && wakeupsIdle < BENCH_IDLE_WAKEUP_RATIO*wakeupsFullRate);
+	errorCode |= checkResult("idle_resume_within_feedback_period", resumeTime < 1.0/BENCH_FEEDBACK_RATE);
+	
+	
+	return errorCode;
+}
+
+
+// Tasks of the rate groups benchmark
+static void controlTask(void * userData)
+{
+	float qLref[NUM_ARM_JOINTS] = {0};
+	float qRref[NUM_ARM_JOINTS] = {0};
+	
+	
+	((LiCAS_ECI_UDP*)userData)->sendJointPositionRef(qLref, qRref, 0);
+}
+
+
+static void plannerTask(void *)
+{
+	volatile double sum = 0;
+	int k = 0;
+	
+	
+	for(k = 0; k < 20000; k++)
+		sum += sqrt((double)k);
+}
+
+
+static void uiTask(void * userData)
+{
+	LiCAS_ECI_STATISTICS statistics;
+	
+	
+	((LiCAS_ECI_UDP*)userData)->getStatistics(&statistics);
+}
+
+
+static void healthTask(void *)
+{
+	// Slow task: offloaded to the worker thread so it never delays the control task
+	usleep(30000);
+}
+
+
+/*
+ * Rate groups of a typical application (500 Hz control, 50 Hz planner, 10 Hz UI and 1 Hz health
+ * check) sharing the reactor thread and the worker thread: release jitter and overruns
+ */
+static void benchmarkScheduler(LiCAS_ECI_UDP * licas_eci, int scale)
+{
+	LiCAS_ECI_Reactor reactor("eci_reactor");
+	LiCAS_ECI_Scheduler scheduler(&reactor);
+	LiCAS_ECI_TASK_STATISTICS statistics;
+	char name[64];
+	int group = 0;
+	int k = 0;
+	
+	
+	group = scheduler.addRateGroup(0.002, 0);
+	scheduler.addTask(group, "control", controlTask, licas_eci, 10);
+	group = scheduler.addRateGroup(0.02, 0);
+	scheduler.addTask(group, "planner", plannerTask, NULL, 5);
+	group = scheduler.addRateGroup(0.1, 0);
+	scheduler.addTask(group, "ui", uiTask, licas_eci, 0);
+	group = scheduler.addRateGroup(1.0, 1);
+	scheduler.addTask(group, "health", healthTask, NULL, 0);
+	
+	// The reactor and worker threads are accounted in the statistics of the interface
+	licas_eci->accountReactorThreads(&reactor);
+	
+	if(scheduler.start() != 0 || reactor.start(0) != 0)
+	{
+		fprintf(stderr, "ERROR [in benchmarkScheduler]: could not start the scheduler\n");
+		return;
+	}
+	usleep(2000000*scale);
+	reactor.stop();
+	scheduler.stop();
+	
+	for(k = 0; k < scheduler.getNumTasks(); k++)
+	{
+		scheduler.getTaskStatistics(k, &statistics);
+		snprintf(name, sizeof(name), "sched_%s_release_jitter_max", statistics.name);
+		printResult(name, statistics.releaseJitterMax, "us");
+		snprintf(name, sizeof(name), "sched_%s_execution_time_mean", statistics.name);
+		printResult(name, statistics.executionTimeMean, "us");
+		snprintf(name, sizeof(name), "sched_%s_overruns", statistics.name);
+		printResult(name, (double)statistics.numOverruns, "releases");
+	}
+	printResult("sched_missed_ticks", (double)scheduler.getNumMissedTicks(), "ticks");
+}
+
+
+/*
+ * CPU usage and wake-up latency of the threads of the interface, also exported as metrics file
+ */
+static int reportThreadStatistics(LiCAS_ECI_UDP * licas_eci)
+{
+	LiCAS_ECI_STATISTICS statistics;
+	char name[64];
+	int flagCpuUsageValid = 1;
+	int numReactorThreads = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	licas_eci->getStatistics(&statistics);
+	for(k = 0; k < statistics.numThreads; k++)
+	{
+		if(statistics.threads[k].cpuUsage < 0)
+			flagCpuUsageValid = 0;
+		if(strcmp(statistics.threads[k].name, "eci_reactor") == 0 || strcmp(statistics.threads[k].name, "eci_worker") == 0)
+			numReactorThreads++;
+		snprintf(name, sizeof(name), "%s_cpu_usage", statistics.threads[k].name);
+		printResult(name, statistics.threads[k].cpuUsage, "%");
+		snprintf(name, sizeof(name), "%s_wakeup_latency_mean", statistics.threads[k].name);
+		printResult(name, statistics.threads[k].wakeupLatencyMean, "us");
+		snprintf(name, sizeof(name), "%s_wakeup_latency_max", statistics.threads[k].name);
+		printResult(name, statistics.threads[k].wakeupLatencyMax, "us");
+	}
+	printResult("rx_unknown_packets", (double)statistics.numUnknownPackets, "packets");
+	
+	// Each thread is accounted by itself (no negative CPU usage), including the reactor threads
+	errorCode |= checkResult("thread_cpu_usage_valid", flagCpuUsageValid == 1);
+	errorCode |= checkResult("reactor_threads_accounted", numReactorThreads == 2);
+	
+	licas_eci->exportMetrics("LiCAS_ECI_Benchmark.prom");
+	
+	
+	return errorCode;
+}
+
+
+// Callback of the events, counting the events delivered
+static void countEvent(const LiCAS_ECI_EVENT *, void * userData)
+{
+	(*(int*)userData)++;
+}
+
+
+/*
+ * Events raised while the interface is closed (command sent without socket). They must not be
+ * delivered by the thread raising them, but kept in the ring until the interface is destroyed.
+ */
+static int benchmarkDeferredEvents(LiCAS_ECI_UDP * licas_eci, int * numDelivered)
+{
+	LiCAS_ECI_STATISTICS statistics;
+	float qLref[NUM_ARM_JOINTS] = {0};
+	float qRref[NUM_ARM_JOINTS] = {0};
+	uint64_t numDeferred = 0;
+	
+	
+	licas_eci->getStatistics(&statistics);
+	numDeferred = statistics.numDeferredEvents;
+	*numDelivered = 0;
+	licas_eci->setEventCallback(countEvent, numDelivered);
+	licas_eci->sendJointPositionRef(qLref, qRref, 0);
+	licas_eci->getStatistics(&statistics);
+	printResult("events_deferred", (double)(statistics.numDeferredEvents - numDeferred), "events");
+	
+	
+	return checkResult("events_not_delivered_inline", statistics.numDeferredEvents > numDeferred && *numDelivered == 0);
+}
+
+
+int main(int argc, char ** argv)
+{
+	LiCAS_Simulator * licas_sim = NULL;
+	LiCAS_ECI_UDP * licas_eci = NULL;
+	int numDelivered = 0;
+	int scale = 1;
+	int errorCode = 0;
+	
+	
+	// Optional scale factor of the number of iterations
+	if(argc > 1)
+		scale = atoi(argv[1]);
+	if(scale < 1)
+		scale = 1;
+	
+	licas_sim = new LiCAS_Simulator("LiCAS_Benchmark_Simulator");
+	licas_eci = new LiCAS_ECI_UDP("LiCAS_Benchmark_Interface");
+	
+	errorCode = licas_sim->openSimulator("127.0.0.1", BENCH_UDP_CMD_PORT, BENCH_UDP_FEEDBACK_PORT, BENCH_FEEDBACK_RATE);
+	if(errorCode == 0)
+		errorCode = licas_eci->openUDPInterface("127.0.0.1", BENCH_UDP_CMD_PORT, BENCH_UDP_FEEDBACK_PORT);
+	if(errorCode == 0)
+		errorCode = licas_eci->waitForLink(2.0);
+	
+	if(errorCode != 0)
+		fprintf(stderr, "ERROR [in main]: could not run the loopback benchmarks\n");
+	else
+	{
+		benchmarkElapsedTime(licas_eci, 1000000*scale);
+		benchmarkSend(licas_eci, 100000*scale);
+		errorCode |= benchmarkLoopbackLatency(licas_eci, 200*scale);
+		errorCode |= benchmarkIdleScheduling(licas_eci);
+		benchmarkScheduler(licas_eci, scale);
+		errorCode |= reportThreadStatistics(licas_eci);
+		
+		errorCode |= licas_eci->closeInterface();
+		
+		// The send and receive paths must not allocate memory (counted with LICAS_ECI_ALLOC_TRACKING)
+		printResult("hot_path_allocations", (double)licas_eci->getHotPathAllocations(), "allocations");
+		errorCode |= checkResult("hot_path_no_allocations", licas_eci->getHotPathAllocations() == 0);
+		
+		errorCode |= benchmarkDeferredEvents(licas_eci, &numDelivered);
+	}
+	licas_sim->closeSimulator();
+	
+	// The deferred events are delivered by the destructor
+	delete licas_eci;
+	delete licas_sim;
+	
+	
+	return errorCode;
+}
+
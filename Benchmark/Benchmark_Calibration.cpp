@@ -0,0 +1,184 @@
+/*
+ *
+ * LiCAS Kinematics - Benchmark_Calibration.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Benchmarks of the kinematic calibration (LiCAS_Calibration). The samples are generated with a
+ * perturbed geometry of the arm (joint offsets, link lengths and shoulder position) and a noise of
+ * 0.5 mm in the measured TCP position, as a data log with some motion capture samples. The
+ * nominal geometry is fitted with one thread and with all the cores, and the time of the fit, the
+ * residual error and the error of the parameters are measured. The results are printed on stderr
+ * with the format "BENCH <name> <value> <units>". It fails if the fitted joint offsets or lengths
+ * are not within the tolerances.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_Kinematics/LiCAS_Calibration.h"
+#include "Benchmark_Common.h"
+
+
+#define NUM_SAMPLES			1000000		// Samples of the data log
+#define MOCAP_RATIO			10			// One motion capture sample every MOCAP_RATIO samples
+#define MEASUREMENT_NOISE	0.0005		// Noise of the TCP position in [m]
+#define OFFSET_TOLERANCE	0.001		// Maximum error of the fitted joint offsets in [rad]
+#define LENGTH_TOLERANCE	0.001		// Maximum error of the fitted lengths in [m]
+
+
+/*
+ * Uniform random number in [min, max]
+ */
+static float getRandom(float min, float max)
+{
+	return min + (max - min)*rand()/RAND_MAX;
+}
+
+
+/*
+ * Gaussian random number (Box-Muller)
+ */
+static float getGaussian(float sigma)
+{
+	float u1 = (rand() + 1.0)/(RAND_MAX + 2.0);
+	float u2 = (rand() + 1.0)/(RAND_MAX + 2.0);
+	
+	
+	return sigma*sqrt(-2*log(u1))*cos(2*M_PI*u2);
+}
+
+
+/*
+ * Synthetic samples of the arm with the given geometry
+ */
+static void generateSamples(const LiCAS_ARM_GEOMETRY & geometry, int numSamples, LiCAS_Calibration * calibration)
+{
+	LiCAS_ArmKinematics kinematics(LiCAS_ARM_LEFT, geometry);
+	LiCAS_ARM_FRAMES frames;
+	float q[NUM_ARM_JOINTS];
+	float p[3];
+	int flagBaseFrame = 0;
+	int n = 0;
+	int k = 0;
+	
+	
+	for(n = 0; n < numSamples; n++)
+	{
+		q[0] = getRandom(-1.5, 0.5);
+		q[1] = getRandom(-0.2, 1.2);
+		q[2] = getRandom(-1.0, 1.0);
+		q[3] = getRandom(-2.0, -0.2);
+		kinematics.forwardKinematics(q, &frames);
+		flagBaseFrame = (n % MOCAP_RATIO == 0) ? 1 : 0;
+		for(k = 0; k < 3; k++)
+			p[k] = frames.T_tcp(k, 3) + getGaussian(MEASUREMENT_NOISE);
+		if(flagBaseFrame == 0)
+		{
+			p[1] -= geometry.shoulderOffsetY;
+			p[2] -= geometry.shoulderOffsetZ;
+		}
+		calibration->addSample(q, p, flagBaseFrame);
+	}
+}
+
+
+/*
+ * Fit the geometry and print the results
+ */
+static int runCalibration(LiCAS_Calibration * calibration, const LiCAS_ARM_GEOMETRY & realGeometry, int numThreads, const char * name)
+{
+	LiCAS_ARM_GEOMETRY geometry;
+	LiCAS_CALIBRATION_RESULT result;
+	char label[128];
+	float offsetError = 0;
+	float lengthError = 0;
+	int k = 0;
+	
+	
+	if(calibration->solve(numThreads, &geometry, &result) != 0)
+	{
+		fprintf(stderr, "ERROR [in runCalibration]: the fit did not converge\n");
+		return 1;
+	}
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+		offsetError = fmax(offsetError, fabs(geometry.jointOffset[k] - realGeometry.jointOffset[k]));
+	lengthError = fmax(fabs(geometry.upperArmLength - realGeometry.upperArmLength), fabs(geometry.forearmLength - realGeometry.forearmLength));
+	lengthError = fmax(lengthError, fabs(geometry.shoulderOffsetY - realGeometry.shoulderOffsetY));
+	lengthError = fmax(lengthError, fabs(geometry.shoulderOffsetZ - realGeometry.shoulderOffsetZ));
+	
+	snprintf(label, sizeof(label), "calibration_%s_threads", name);
+	printResult(label, result.numThreads, "");
+	snprintf(label, sizeof(label), "calibration_%s_time", name);
+	printResult(label, result.solveTime, "s");
+	snprintf(label, sizeof(label), "calibration_%s_iterations", name);
+	printResult(label, result.numIterations, "");
+	snprintf(label, sizeof(label), "calibration_%s_rms_initial", name);
+	printResult(label, 1e3*result.rmsInitial, "mm");
+	snprintf(label, sizeof(label), "calibration_%s_rms_final", name);
+	printResult(label, 1e3*result.rmsFinal, "mm");
+	snprintf(label, sizeof(label), "calibration_%s_offset_error_max", name);
+	printResult(label, 1e3*offsetError, "mrad");
+	snprintf(label, sizeof(label), "calibration_%s_length_error_max", name);
+	printResult(label, 1e3*lengthError, "mm");
+	
+	snprintf(label, sizeof(label), "calibration_%s_parameters_within_tolerance", name);
+	
+	
+	return checkResult(label, offsetError < OFFSET_TOLERANCE && lengthError < LENGTH_TOLERANCE);
+}
+
+
+int main(int argc, char ** argv)
+{
+	LiCAS_ARM_GEOMETRY nominalGeometry = LiCAS_ArmKinematics::getDefaultGeometry();
+	LiCAS_ARM_GEOMETRY realGeometry = nominalGeometry;
+	LiCAS_Calibration calibration(LiCAS_ARM_LEFT, nominalGeometry);
+	int numSamples = NUM_SAMPLES;
+	int numCores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	int errorCode = 0;
+	
+	
+	// Optional number of samples
+	if(argc > 1)
+		numSamples = atoi(argv[1]);
+	if(numSamples < 100)
+		numSamples = 100;
+	
+	// Real geometry: errors of the assembly and the zero of the encoders
+	realGeometry.jointOffset[0] = 0.020;
+	realGeometry.jointOffset[1] = -0.015;
+	realGeometry.jointOffset[2] = 0.030;
+	realGeometry.jointOffset[3] = -0.025;
+	realGeometry.upperArmLength += 0.004;
+	realGeometry.forearmLength -= 0.003;
+	realGeometry.shoulderOffsetY += 0.005;
+	realGeometry.shoulderOffsetZ -= 0.002;
+	
+	srand(1);
+	generateSamples(realGeometry, numSamples, &calibration);
+	printResult("calibration_samples", numSamples, "");
+	printResult("calibration_cores", numCores, "");
+	
+	errorCode = runCalibration(&calibration, realGeometry, 1, "single");
+	if(errorCode == 0)
+		errorCode = runCalibration(&calibration, realGeometry, 0, "parallel");
+	
+	
+	return errorCode;
+}
+
@@ -0,0 +1,69 @@
+/*
+ *
+ * LiCAS ECI - Benchmark_Common.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Functions shared by the benchmarks. The results are printed on stderr, one per line, with the
+ * format "BENCH <name> <value> <units>", and the checks of the results with the format
+ * "CHECK <name> PASS|FAIL". A benchmark returns non-zero if any check fails, so the benchmarks are
+ * also executed as tests (ctest).
+ *
+ */
+
+#ifndef BENCHMARK_COMMON_H_
+#define BENCHMARK_COMMON_H_
+
+
+// Standard library
+#include <stdio.h>
+#include <time.h>
+
+
+/*
+ * Monotonic time in [s]
+ */
+static inline double getTime()
+{
+	struct timespec t;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	
+	
+	return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+
+/*
+ * Print a result of the benchmark
+ */
+static inline void printResult(const char * name, double value, const char * units)
+{
+	fprintf(stderr, "BENCH %s %.3f %s\n", name, value, units);
+}
+
+
+/*
+ * Print the check of a result. Returns 0 if it passed, 1 otherwise.
+ *
+ * Parameters:
+ * 	(1) Name of the check
+ * 	(2) 1 if the result satisfies the acceptance condition
+ */
+static inline int checkResult(const char * name, int flagPassed)
+{
+	fprintf(stderr, "CHECK %s %s\n", name, (flagPassed != 0) ? "PASS" : "FAIL");
+	
+	
+	return (flagPassed != 0) ? 0 : 1;
+}
+
+#endif
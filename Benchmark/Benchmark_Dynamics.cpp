@@ -0,0 +1,316 @@
+/*
+ *
+ * LiCAS Kinematics - Benchmark_Dynamics.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Benchmarks of the rigid body dynamics of the arms (LiCAS_ArmDynamics). The inverse dynamics is
+ * validated against the regressor of LiCAS_Regressor, an independent formulation in the base frame
+ * and in double precision (tau = Y*theta with the parameters of the arm), and the inertia matrix of
+ * the CRBA is validated against the columns of the inverse dynamics (M*e_k = tau(q, 0, e_k) -
+ * tau(q, 0, 0)), for random states of both arms. The time of the inverse dynamics, gravity torques
+ * and inertia matrix of both arms is also measured. The online payload estimation
+ * (LiCAS_PayloadEstimator) is evaluated with the torques of a known payload along a periodic
+ * motion sampled at the feedback rate, including the gravity feedforward with the estimate. The
+ * results are printed on stderr with the format "BENCH <name> <value> <units>". It fails if a
+ * validation error or the error of the estimated mass exceeds its tolerance.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_Kinematics/LiCAS_ArmDynamics.h"
+#include "../LiCAS_Identification/LiCAS_Regressor.h"
+#include "../LiCAS_Identification/LiCAS_PayloadEstimator.h"
+#include "Benchmark_Common.h"
+
+
+#define NUM_VALIDATION_STATES	1000
+#define NUM_TIMING_CALLS		1000000
+#define TORQUE_TOLERANCE		1e-4	// Maximum error of the validation in [Nm]
+#define PAYLOAD_RATE			500.0	// Rate of the feedback samples of the payload estimation in [Hz]
+#define PAYLOAD_DURATION		20.0	// Duration of the payload estimation in [s]
+#define PAYLOAD_TORQUE_NOISE	0.01	// Amplitude of the noise of the joint torques in [Nm]
+#define PAYLOAD_MASS_TOLERANCE	0.01	// Maximum error of the estimated mass in [kg]
+
+
+// Sink of the results, so the compiler can not remove the benchmarked operations
+static volatile float sink = 0;
+
+
+static float getRandom(float amplitude)
+{
+	return amplitude*(2.0*rand()/RAND_MAX - 1);
+}
+
+
+/*
+ * Inverse dynamics and inertia matrix against the regressor and the inverse dynamics
+ */
+static int runValidation(int side, const char * name)
+{
+	LiCAS_ARM_GEOMETRY geometry = LiCAS_ArmKinematics::getDefaultGeometry();
+	LiCAS_ARM_DYNAMICS parameters = LiCAS_ArmDynamics::getDefaultDynamics();
+	LiCAS_ArmDynamics * dynamics = NULL;
+	LiCAS_Regressor * regressor = NULL;
+	LiCAS_REGRESSOR Y;
+	LiCAS_JointMatrix M;
+	double theta[NUM_ARM_DYNAMIC_PARAMETERS];
+	float q[NUM_ARM_JOINTS];
+	float dq[NUM_ARM_JOINTS];
+	float ddq[NUM_ARM_JOINTS];
+	float zero[NUM_ARM_JOINTS] = {0, 0, 0, 0};
+	float unit[NUM_ARM_JOINTS];
+	float tau[NUM_ARM_JOINTS];
+	float tauBias[NUM_ARM_JOINTS];
+	char label[128];
+	double tauRegressor = 0;
+	double regressorError = 0;
+	double massMatrixError = 0;
+	double maxTorque = 0;
+	int errorCode = 0;
+	int n = 0;
+	int i = 0;
+	int j = 0;
+	int k = 0;
+	
+	
+	// Products of inertia and lateral centers of mass, so the mirror of the right arm is checked
+	for(i = 0; i < NUM_ARM_JOINTS; i++)
+	{
+		parameters.centerOfMass[i][0] = 0.01;
+		parameters.centerOfMass[i][1] = 0.005*(i + 1);
+		parameters.inertia[i][1] = 1e-5;
+		parameters.inertia[i][4] = -2e-5;
+	}
+	dynamics = new LiCAS_ArmDynamics(side, geometry, parameters);
+	regressor = new LiCAS_Regressor(side, geometry);
+	dynamics->getParameters(theta);
+	
+	for(n = 0; n < NUM_VALIDATION_STATES; n++)
+	{
+		for(i = 0; i < NUM_ARM_JOINTS; i++)
+		{
+			q[i] = getRandom(M_PI);
+			dq[i] = getRandom(3);
+			ddq[i] = getRandom(20);
+		}
+		
+		// Regressor
+		dynamics->inverseDynamics(q, dq, ddq, tau);
+		regressor->getRegressor(q, dq, ddq, Y);
+		for(i = 0; i < NUM_ARM_JOINTS; i++)
+		{
+			tauRegressor = 0;
+			for(k = 0; k < NUM_ARM_DYNAMIC_PARAMETERS; k++)
+				tauRegressor += Y[i][k]*theta[k];
+			regressorError = fmax(regressorError, fabs(tau[i] - tauRegressor));
+			maxTorque = fmax(maxTorque, fabs(tauRegressor));
+		}
+		
+		// Columns of the inertia matrix
+		dynamics->getMassMatrix(q, &M);
+		dynamics->inverseDynamics(q, zero, zero, tauBias);
+		for(j = 0; j < NUM_ARM_JOINTS; j++)
+		{
+			for(i = 0; i < NUM_ARM_JOINTS; i++)
+				unit[i] = (i == j) ? 1 : 0;
+			dynamics->inverseDynamics(q, zero, unit, tau);
+			for(i = 0; i < NUM_ARM_JOINTS; i++)
+				massMatrixError = fmax(massMatrixError, fabs(M(i, j) - (tau[i] - tauBias[i])));
+		}
+	}
+	delete regressor;
+	delete dynamics;
+	
+	snprintf(label, sizeof(label), "dynamics_%s_torque_max", name);
+	printResult(label, maxTorque, "Nm");
+	snprintf(label, sizeof(label), "dynamics_%s_regressor_error_max", name);
+	printResult(label, 1e6*regressorError, "uNm");
+	snprintf(label, sizeof(label), "dynamics_%s_mass_matrix_error_max", name);
+	printResult(label, 1e6*massMatrixError, "ukgm2");
+	
+	snprintf(label, sizeof(label), "dynamics_%s_rnea_matches_regressor", name);
+	errorCode = checkResult(label, regressorError < TORQUE_TOLERANCE);
+	snprintf(label, sizeof(label), "dynamics_%s_crba_matches_rnea", name);
+	errorCode |= checkResult(label, massMatrixError < TORQUE_TOLERANCE);
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Time of the dynamics of both arms
+ */
+static void runTiming()
+{
+	LiCAS_ArmDynamics dynamicsL(LiCAS_ARM_LEFT, LiCAS_ArmKinematics::getDefaultGeometry(), LiCAS_ArmDynamics::getDefaultDynamics());
+	LiCAS_ArmDynamics dynamicsR(LiCAS_ARM_RIGHT, LiCAS_ArmKinematics::getDefaultGeometry(), LiCAS_ArmDynamics::getDefaultDynamics());
+	LiCAS_JointMatrix ML;
+	LiCAS_JointMatrix MR;
+	float q[NUM_ARM_JOINTS] = {0.3, 0.2, -0.4, -1.0};
+	float dq[NUM_ARM_JOINTS] = {0.5, -0.8, 1.1, 0.6};
+	float ddq[NUM_ARM_JOINTS] = {1.5, -2.0, 0.7, 3.0};
+	float tauL[NUM_ARM_JOINTS];
+	float tauR[NUM_ARM_JOINTS];
+	double t0 = 0;
+	int n = 0;
+	
+	
+	t0 = getTime();
+	for(n = 0; n < NUM_TIMING_CALLS; n++)
+	{
+		q[0] += 1e-6;
+		dynamicsL.inverseDynamics(q, dq, ddq, tauL);
+		dynamicsR.inverseDynamics(q, dq, ddq, tauR);
+		sink += tauL[0] + tauR[0];
+	}
+	printResult("dynamics_rnea_both_arms", 1e9*(getTime() - t0)/NUM_TIMING_CALLS, "ns");
+	
+	t0 = getTime();
+	for(n = 0; n < NUM_TIMING_CALLS; n++)
+	{
+		q[0] += 1e-6;
+		dynamicsL.getGravityTorque(q, tauL);
+		dynamicsR.getGravityTorque(q, tauR);
+		sink += tauL[0] + tauR[0];
+	}
+	printResult("dynamics_gravity_both_arms", 1e9*(getTime() - t0)/NUM_TIMING_CALLS, "ns");
+	
+	t0 = getTime();
+	for(n = 0; n < NUM_TIMING_CALLS; n++)
+	{
+		q[0] += 1e-6;
+		dynamicsL.getMassMatrix(q, &ML);
+		dynamicsR.getMassMatrix(q, &MR);
+		sink += ML(0, 0) + MR(0, 0);
+	}
+	printResult("dynamics_crba_both_arms", 1e9*(getTime() - t0)/NUM_TIMING_CALLS, "ns");
+}
+
+
+/*
+ * Payload estimation with the torques of a known payload along a periodic motion of both arms
+ */
+static int runPayload()
+{
+	LiCAS_ARM_GEOMETRY geometry = LiCAS_ArmKinematics::getDefaultGeometry();
+	LiCAS_ARM_DYNAMICS parameters = LiCAS_ArmDynamics::getDefaultDynamics();
+	LiCAS_PayloadEstimator estimator(geometry, parameters, 0.999);
+	LiCAS_ArmDynamics * armWithPayload[2];
+	LiCAS_ArmDynamics * feedforward[2];
+	const float payloadMass[2] = {0.3, 0.5};
+	const float payloadPosition[2][3] = {{0.02, 0.0, -0.25}, {0.0, -0.03, -0.22}};
+	const float amplitude[NUM_ARM_JOINTS] = {0.6, 0.4, 0.8, 0.7};
+	const float frequency[NUM_ARM_JOINTS] = {0.23, 0.31, 0.17, 0.41};
+	const float offset[NUM_ARM_JOINTS] = {0.2, 0.3, 0.0, -1.0};
+	float q[NUM_ARM_JOINTS];
+	float dq[NUM_ARM_JOINTS];
+	float ddq[NUM_ARM_JOINTS];
+	float tau[NUM_ARM_JOINTS];
+	float tauFeedforward[NUM_ARM_JOINTS];
+	float mass = 0;
+	float position[3];
+	double updateTime = 0;
+	double massError = 0;
+	double positionError = 0;
+	double gravityError = 0;
+	double t0 = 0;
+	double w = 0;
+	float t = 0;
+	int numSamples = (int)(PAYLOAD_DURATION*PAYLOAD_RATE);
+	int side = 0;
+	int n = 0;
+	int k = 0;
+	
+	
+	for(side = 0; side < 2; side++)
+	{
+		armWithPayload[side] = new LiCAS_ArmDynamics(side, geometry, parameters);
+		armWithPayload[side]->setPayload(payloadMass[side], payloadPosition[side]);
+		feedforward[side] = new LiCAS_ArmDynamics(side, geometry, parameters);
+	}
+	estimator.setFeedforward(feedforward[LiCAS_ARM_LEFT], feedforward[LiCAS_ARM_RIGHT]);
+	
+	for(n = 0; n < numSamples; n++)
+	{
+		t = n/PAYLOAD_RATE;
+		for(side = 0; side < 2; side++)
+		{
+			for(k = 0; k < NUM_ARM_JOINTS; k++)
+			{
+				w = 2*M_PI*frequency[k];
+				q[k] = offset[k] + amplitude[k]*sin(w*t);
+				dq[k] = amplitude[k]*w*cos(w*t);
+				ddq[k] = -amplitude[k]*w*w*sin(w*t);
+			}
+			armWithPayload[side]->inverseDynamics(q, dq, ddq, tau);
+			for(k = 0; k < NUM_ARM_JOINTS; k++)
+				tau[k] += getRandom(PAYLOAD_TORQUE_NOISE);
+			
+			t0 = getTime();
+			estimator.update(side, q, dq, tau, t);
+			updateTime += getTime() - t0;
+		}
+	}
+	
+	// Estimate and gravity feedforward with the estimate
+	for(side = 0; side < 2; side++)
+	{
+		estimator.getPayload(side, &mass, position);
+		massError = fmax(massError, fabs(mass - payloadMass[side]));
+		for(k = 0; k < 3; k++)
+			positionError = fmax(positionError, fabs(position[k] - payloadPosition[side][k]));
+		for(n = 0; n < NUM_VALIDATION_STATES; n++)
+		{
+			for(k = 0; k < NUM_ARM_JOINTS; k++)
+				q[k] = getRandom(M_PI);
+			armWithPayload[side]->getGravityTorque(q, tau);
+			feedforward[side]->getGravityTorque(q, tauFeedforward);
+			for(k = 0; k < NUM_ARM_JOINTS; k++)
+				gravityError = fmax(gravityError, fabs(tau[k] - tauFeedforward[k]));
+		}
+		delete armWithPayload[side];
+		delete feedforward[side];
+	}
+	
+	printResult("payload_update_time", 1e9*updateTime/(2*numSamples), "ns");
+	printResult("payload_mass_error_max", 1e3*massError, "g");
+	printResult("payload_position_error_max", 1e3*positionError, "mm");
+	printResult("payload_gravity_feedforward_error_max", 1e3*gravityError, "mNm");
+	
+	
+	return checkResult("payload_mass_within_tolerance", massError < PAYLOAD_MASS_TOLERANCE);
+}
+
+
+int main()
+{
+	int errorCode = 0;
+	
+	
+	srand(1);
+	errorCode |= runValidation(LiCAS_ARM_LEFT, "left");
+	errorCode |= runValidation(LiCAS_ARM_RIGHT, "right");
+	errorCode |= runPayload();
+	runTiming();
+	
+	
+	return errorCode;
+}
+
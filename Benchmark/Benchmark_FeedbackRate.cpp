@@ -0,0 +1,155 @@
+/*
+ *
+ * LiCAS ECI - Benchmark_FeedbackRate.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Loopback benchmarks of the feedback rate negotiation against the in-process LiCAS simulator. For
+ * each feedback rate (monitoring, intermediate and contact tasks), the time until the request is
+ * acknowledged, the feedback rate measured, the wake-ups and CPU usage of the reception thread and
+ * the receive buffer adapted to the rate are reported. The detection time of the feedback watchdog
+ * is measured stopping the simulator at each rate. The results are printed on stderr with the
+ * format "BENCH <name> <value> <units>". It fails if a request is not acknowledged, if the measured
+ * rate differs from the requested one or if the watchdog does not detect the stop.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "../LiCAS_Simulator/LiCAS_Simulator.h"
+#include "Benchmark_Common.h"
+
+
+#define BENCH_CMD_PORT				23500
+#define BENCH_FEEDBACK_PORT			24500
+#define BENCH_LOOP_RATE				500.0	// Rate of the simulation loop in [Hz]
+#define BENCH_ACK_TIMEOUT			1.0		// Timeout of the acknowledgment in [s]
+#define BENCH_MEASURE_TIME			2.5		// Time at each rate before reading the statistics in [s]
+#define BENCH_WATCHDOG_TIMEOUT		2.0		// Maximum time waiting for the watchdog in [s]
+#define BENCH_RATE_TOLERANCE		0.05	// Maximum relative error of the measured feedback rate
+
+
+// Feedback rates: monitoring, intermediate and contact tasks
+static const float benchRate[3] = {20.0, 100.0, 500.0};
+
+
+/*
+ * CPU usage of the reception thread of the interface in the last second in [%]
+ */
+static float getRxCpuUsage(const LiCAS_ECI_STATISTICS * statistics)
+{
+	float cpuUsage = 0;
+	int k = 0;
+	
+	
+	for(k = 0; k < statistics->numThreads && k < MAX_ECI_THREADS; k++)
+	{
+		if(strcmp(statistics->threads[k].name, "eci_rx") == 0)
+			cpuUsage = statistics->threads[k].cpuUsage;
+	}
+	
+	
+	return cpuUsage;
+}
+
+
+int main()
+{
+	LiCAS_Simulator * licas_sim = NULL;
+	LiCAS_ECI_UDP * licas_eci = NULL;
+	LiCAS_ECI_STATISTICS statistics;
+	char name[128];
+	uint64_t numTimeouts = 0;
+	double t_start = 0;
+	int errorCode = 0;
+	int n = 0;
+	
+	
+	licas_sim = new LiCAS_Simulator("LiCAS_Benchmark_Sim");
+	licas_eci = new LiCAS_ECI_UDP("LiCAS_Benchmark");
+	licas_eci->setEventCallback(NULL, NULL);
+	
+	errorCode = licas_sim->openSimulator("127.0.0.1", BENCH_CMD_PORT, BENCH_FEEDBACK_PORT, BENCH_LOOP_RATE);
+	if(errorCode == 0)
+		errorCode = licas_eci->openUDPInterface("127.0.0.1", BENCH_CMD_PORT, BENCH_FEEDBACK_PORT);
+	if(errorCode == 0)
+		errorCode = licas_eci->waitForLink(2.0);
+	if(errorCode != 0)
+	{
+		fprintf(stderr, "ERROR [in main]: could not open the loopback setup\n");
+		return 1;
+	}
+	
+	// Negotiation and adaptation of the interface at each rate
+	for(n = 0; n < 3 && errorCode == 0; n++)
+	{
+		t_start = getTime();
+		errorCode = licas_eci->requestFeedbackRate(benchRate[n], LiCAS_FEEDBACK_CHANNEL_ALL, BENCH_ACK_TIMEOUT);
+		sprintf(name, "feedback_rate_%.0f_acknowledged", benchRate[n]);
+		if(checkResult(name, errorCode == 0) != 0)
+			break;
+		sprintf(name, "feedback_rate_%.0f_ack_time", benchRate[n]);
+		printResult(name, 1e3*(getTime() - t_start), "ms");
+		
+		usleep((useconds_t)(1e6*BENCH_MEASURE_TIME));
+		licas_eci->getStatistics(&statistics);
+		sprintf(name, "feedback_rate_%.0f_measured", benchRate[n]);
+		printResult(name, statistics.feedbackRateMeasured, "Hz");
+		sprintf(name, "feedback_rate_%.0f_rx_wakeups", benchRate[n]);
+		printResult(name, statistics.rxWakeupsPerSecond, "wakeups/s");
+		sprintf(name, "feedback_rate_%.0f_rx_cpu_usage", benchRate[n]);
+		printResult(name, getRxCpuUsage(&statistics), "%");
+		sprintf(name, "feedback_rate_%.0f_rx_buffer", benchRate[n]);
+		printResult(name, statistics.rxBufferSize/1024.0, "KiB");
+		sprintf(name, "feedback_rate_%.0f_watchdog_timeout", benchRate[n]);
+		printResult(name, 1e3*statistics.feedbackTimeout, "ms");
+		sprintf(name, "feedback_rate_%.0f_measured_as_requested", benchRate[n]);
+		errorCode = checkResult(name, fabs(statistics.feedbackRateMeasured - benchRate[n]) < BENCH_RATE_TOLERANCE*benchRate[n]);
+	}
+	
+	// Detection time of the feedback watchdog when the simulator stops, at the lowest and highest rate
+	for(n = 0; n < 3 && errorCode == 0; n += 2)
+	{
+		errorCode = licas_eci->requestFeedbackRate(benchRate[n], LiCAS_FEEDBACK_CHANNEL_JOINT_POS, BENCH_ACK_TIMEOUT);
+		usleep(500000);
+		numTimeouts = licas_eci->getEventCount(LiCAS_EVENT_FEEDBACK_TIMEOUT);
+		licas_sim->closeSimulator();
+		t_start = getTime();
+		while(licas_eci->getEventCount(LiCAS_EVENT_FEEDBACK_TIMEOUT) == numTimeouts && getTime() - t_start < BENCH_WATCHDOG_TIMEOUT)
+			usleep(1000);
+		sprintf(name, "feedback_rate_%.0f_watchdog_detection", benchRate[n]);
+		printResult(name, 1e3*(getTime() - t_start), "ms");
+		sprintf(name, "feedback_rate_%.0f_watchdog_detected", benchRate[n]);
+		errorCode |= checkResult(name, licas_eci->getEventCount(LiCAS_EVENT_FEEDBACK_TIMEOUT) != numTimeouts);
+		
+		// The simulator restarts at the loop rate with all the channels
+		if(errorCode == 0)
+			errorCode = licas_sim->openSimulator("127.0.0.1", BENCH_CMD_PORT, BENCH_FEEDBACK_PORT, BENCH_LOOP_RATE);
+		usleep(200000);
+	}
+	printResult("feedback_rate_requests_received", (double)licas_sim->getNumFeedbackRateRequests(), "packets");
+	
+	licas_eci->closeInterface();
+	licas_sim->closeSimulator();
+	delete licas_eci;
+	delete licas_sim;
+	
+	
+	return errorCode;
+}
@@ -0,0 +1,254 @@
+/*
+ *
+ * LiCAS ECI - Benchmark_FloatingBase.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Loopback benchmarks of the floating base compensation (LiCAS_FloatingBase) with the in-process
+ * LiCAS simulator and the base pose simulator (1 kHz, measurements with 5 ms of age). The TCP of
+ * both arms holds a fixed point in the world frame while the platform moves, and the error of the
+ * TCP of the simulator in the world frame (with the true pose of the platform) is measured without
+ * latency compensation and with the latency estimated from the feedback history. The time of the
+ * conversion of the targets and the error of the TCP in the world frame given by the feedback are
+ * also measured. The results are printed on stderr with the format "BENCH <name> <value> <units>".
+ * It fails if the TCP does not hold the point within the tolerance or base poses are discarded.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "../LiCAS_Simulator/LiCAS_Simulator.h"
+#include "../LiCAS_Simulator/LiCAS_BasePoseSimulator.h"
+#include "../LiCAS_Motion/LiCAS_FloatingBase.h"
+#include "Benchmark_Common.h"
+
+
+#define BENCH_UDP_CMD_PORT			23200
+#define BENCH_UDP_FEEDBACK_PORT		24200
+#define BENCH_UDP_BASE_POSE_PORT	25200
+#define BENCH_CONTROL_RATE			500.0	// Rate of the control loop and of the feedback in [Hz]
+#define BENCH_BASE_POSE_RATE		1000.0	// Rate of the base pose data packets in [Hz]
+#define BENCH_BASE_POSE_AGE			0.005	// Age of the base pose measurements in [s]
+#define BENCH_SETTLING_TIME			0.5		// Time excluded from the error statistics in [s]
+#define BENCH_DURATION				10.5	// Duration of each run in [s] (settling plus the period of the motion of the base)
+#define BENCH_CONVERSION_CALLS		100000
+#define BENCH_ARMS_OFFSET			-0.1	// Position of the frame of the arms below the base (Z axis) in [m]
+#define BENCH_HOLD_TOLERANCE		0.002	// Maximum RMS error of the TCP in the world frame with compensation in [m]
+
+
+/*
+ * Pose of the frame of the arms in the world frame with the true pose of the simulated platform
+ */
+static LiCAS_Transform getTrueArmsTransform(LiCAS_BasePoseSimulator * publisher, double t)
+{
+	LiCAS_BASE_POSE_DATA_PACKET dataPacketBasePose;
+	LiCAS_Transform T = LiCAS_Transform::identity();
+	float w = 0;
+	float x = 0;
+	float y = 0;
+	float z = 0;
+	int k = 0;
+	
+	
+	LiCAS_BasePoseSimulator::getPose(t - publisher->getStartTime(), &dataPacketBasePose);
+	w = dataPacketBasePose.orientation[0];
+	x = dataPacketBasePose.orientation[1];
+	y = dataPacketBasePose.orientation[2];
+	z = dataPacketBasePose.orientation[3];
+	T(0, 0) = 1 - 2*(y*y + z*z);
+	T(0, 1) = 2*(x*y - w*z);
+	T(0, 2) = 2*(x*z + w*y);
+	T(1, 0) = 2*(x*y + w*z);
+	T(1, 1) = 1 - 2*(x*x + z*z);
+	T(1, 2) = 2*(y*z - w*x);
+	T(2, 0) = 2*(x*z - w*y);
+	T(2, 1) = 2*(y*z + w*x);
+	T(2, 2) = 1 - 2*(x*x + y*y);
+	for(k = 0; k < 3; k++)
+		T(k, 3) = dataPacketBasePose.position[k];
+	
+	
+	return T*LiCAS_Translation(0.0, 0.0, BENCH_ARMS_OFFSET);
+}
+
+
+/*
+ * Hold the TCP of both arms at a fixed point of the world frame while the platform moves. Returns
+ * the RMS error of the TCP of the simulator in the world frame in [m].
+ */
+static double runHold(LiCAS_ECI_UDP * licas_eci, LiCAS_Simulator * licas_sim, LiCAS_BasePoseSimulator * publisher,
+		LiCAS_FloatingBase * floatingBase, const LiCAS_Vector3 & pLworld, const LiCAS_Vector3 & pRworld,
+		double * errorMax, double * fusionErrorMax)
+{
+	LiCAS_Transform T_world_arms;
+	LiCAS_Vector3 pL;
+	LiCAS_Vector3 pR;
+	LiCAS_Vector3 pLfused;
+	LiCAS_Vector3 pRfused;
+	LiCAS_Vector3 eL;
+	LiCAS_Vector3 eR;
+	struct timespec t_next;
+	long periodNs = (long)(1e9/BENCH_CONTROL_RATE);
+	double t0 = LiCAS_FloatingBase::getTime();
+	double t = 0;
+	double sum = 0;
+	int numSamples = 0;
+	int k = 0;
+	
+	
+	*errorMax = 0;
+	*fusionErrorMax = 0;
+	clock_gettime(CLOCK_MONOTONIC, &t_next);
+	while((t = LiCAS_FloatingBase::getTime()) - t0 < BENCH_DURATION)
+	{
+		// Error of the TCP of the simulator with the true pose of the platform
+		T_world_arms = getTrueArmsTransform(publisher, t);
+		for(k = 0; k < 3; k++)
+		{
+			pL[k] = licas_sim->pL[k];
+			pR[k] = licas_sim->pR[k];
+		}
+		pL = LiCAS_TransformPoint(T_world_arms, pL);
+		pR = LiCAS_TransformPoint(T_world_arms, pR);
+		if(t - t0 > BENCH_SETTLING_TIME)
+		{
+			eL = pL - pLworld;
+			eR = pR - pRworld;
+			sum += dot(eL, eL) + dot(eR, eR);
+			*errorMax = fmax(*errorMax, fmax(norm(eL), norm(eR)));
+			numSamples += 2;
+			
+			// TCP in the world frame from the feedback and the base pose history
+			floatingBase->getWorldTCP(&pLfused, &pRfused);
+			*fusionErrorMax = fmax(*fusionErrorMax, fmax(norm(pLfused - pL), norm(pRfused - pR)));
+		}
+		
+		floatingBase->sendWorldTCPRef(licas_eci, pLworld, pRworld, 1.0/BENCH_CONTROL_RATE);
+		
+		t_next.tv_nsec += periodNs;
+		while(t_next.tv_nsec >= 1000000000)
+		{
+			t_next.tv_nsec -= 1000000000;
+			t_next.tv_sec++;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t_next, NULL);
+	}
+	
+	
+	return sqrt(sum/numSamples);
+}
+
+
+int main()
+{
+	LiCAS_Simulator * licas_sim = NULL;
+	LiCAS_ECI_UDP * licas_eci = NULL;
+	LiCAS_BasePoseSimulator * publisher = NULL;
+	LiCAS_FloatingBase * floatingBase = NULL;
+	LiCAS_Transform T_world_arms;
+	LiCAS_Vector3 pLworld;
+	LiCAS_Vector3 pRworld;
+	LiCAS_Vector3 pArm;
+	double errorRMS = 0;
+	double errorMax = 0;
+	double fusionErrorMax = 0;
+	double t0 = 0;
+	int errorCode = 0;
+	int n = 0;
+	
+	
+	licas_sim = new LiCAS_Simulator("LiCAS_Benchmark_Simulator");
+	licas_eci = new LiCAS_ECI_UDP("LiCAS_Benchmark_Interface");
+	publisher = new LiCAS_BasePoseSimulator();
+	floatingBase = new LiCAS_FloatingBase(LiCAS_Translation(0.0, 0.0, BENCH_ARMS_OFFSET));
+	licas_eci->setEventCallback(NULL, NULL);
+	licas_eci->setFeedbackCallback(LiCAS_FloatingBase::feedbackCallback, floatingBase);
+	
+	errorCode = licas_sim->openSimulator("127.0.0.1", BENCH_UDP_CMD_PORT, BENCH_UDP_FEEDBACK_PORT, BENCH_CONTROL_RATE);
+	if(errorCode == 0)
+		errorCode = licas_eci->openUDPInterface("127.0.0.1", BENCH_UDP_CMD_PORT, BENCH_UDP_FEEDBACK_PORT);
+	if(errorCode == 0)
+		errorCode = floatingBase->openBasePoseChannel(BENCH_UDP_BASE_POSE_PORT);
+	if(errorCode == 0)
+		errorCode = publisher->openPublisher("127.0.0.1", BENCH_UDP_BASE_POSE_PORT, BENCH_BASE_POSE_RATE, BENCH_BASE_POSE_AGE);
+	if(errorCode == 0)
+		errorCode = licas_eci->waitForLink(2.0);
+	if(errorCode != 0)
+	{
+		fprintf(stderr, "ERROR [in main]: could not open the loopback setup\n");
+		return 1;
+	}
+	usleep(300000);
+	
+	// Targets in the world frame: the initial position of the TCP of each arm
+	t0 = LiCAS_FloatingBase::getTime();
+	if(floatingBase->worldToArm(LiCAS_Vector3::zeros(), t0, &pArm) != 0)
+	{
+		fprintf(stderr, "ERROR [in main]: no base pose received\n");
+		errorCode = 1;
+	}
+	else
+	{
+		T_world_arms = getTrueArmsTransform(publisher, t0);
+		pArm[0] = 0.0;
+		pArm[1] = 0.25;
+		pArm[2] = -0.35;
+		pLworld = LiCAS_TransformPoint(T_world_arms, pArm);
+		pArm[1] = -0.25;
+		pRworld = LiCAS_TransformPoint(T_world_arms, pArm);
+		
+		// Time of the conversion of a target with the pose of the base at the current time
+		t0 = LiCAS_FloatingBase::getTime();
+		for(n = 0; n < BENCH_CONVERSION_CALLS; n++)
+			floatingBase->worldToArm(pLworld, t0 - 0.001*(n % 100), &pArm);
+		printResult("floating_base_conversion_time", 1e9*(LiCAS_FloatingBase::getTime() - t0)/BENCH_CONVERSION_CALLS, "ns");
+		
+		// Without latency compensation
+		floatingBase->setLatency(0, 0, 0);
+		errorRMS = runHold(licas_eci, licas_sim, publisher, floatingBase, pLworld, pRworld, &errorMax, &fusionErrorMax);
+		printResult("floating_base_uncompensated_error_rms", 1e3*errorRMS, "mm");
+		printResult("floating_base_uncompensated_error_max", 1e3*errorMax, "mm");
+		
+		// Latency estimated from the feedback history
+		floatingBase->setLatency(0, 1, 0);
+		errorRMS = runHold(licas_eci, licas_sim, publisher, floatingBase, pLworld, pRworld, &errorMax, &fusionErrorMax);
+		printResult("floating_base_compensated_error_rms", 1e3*errorRMS, "mm");
+		printResult("floating_base_compensated_error_max", 1e3*errorMax, "mm");
+		printResult("floating_base_latency_estimate", 1e3*floatingBase->getLatency(), "ms");
+		printResult("floating_base_world_tcp_feedback_error_max", 1e3*fusionErrorMax, "mm");
+		printResult("floating_base_pose_packets", (double)floatingBase->getNumBasePosePackets(), "packets");
+		printResult("floating_base_discarded_packets", (double)floatingBase->getNumDiscardedPackets(), "packets");
+		
+		errorCode |= checkResult("floating_base_hold_within_tolerance", errorRMS < BENCH_HOLD_TOLERANCE);
+		errorCode |= checkResult("floating_base_no_discarded_packets", floatingBase->getNumDiscardedPackets() == 0);
+	}
+	
+	publisher->closePublisher();
+	floatingBase->closeBasePoseChannel();
+	licas_eci->closeInterface();
+	licas_sim->closeSimulator();
+	delete floatingBase;
+	delete publisher;
+	delete licas_eci;
+	delete licas_sim;
+	
+	
+	return errorCode;
+}
+
@@ -0,0 +1,308 @@
+/*
+ *
+ * LiCAS Identification - Benchmark_Identification.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Benchmarks of the identification of the frequency response of the joints. A synthetic joint
+ * servo (second order system of 8 Hz and damping 0.4, discretized with the bilinear transform at
+ * 500 Hz, plus a delay of 3 samples and a measurement noise of 0.1 mrad) is excited with the chirp
+ * and the multisine of LiCAS_Excitation, and the Bode diagram estimated by LiCAS_FrequencyResponse
+ * is compared with the exact response of the system in the reliable points. The time of the
+ * excitation signal and of the estimate are also measured. The results are printed on stderr with
+ * the format "BENCH <name> <value> <units>". It fails if the error of the Bode diagram or of the
+ * estimated delay exceeds its tolerance.
+ *
+ * The identification of the dynamic parameters is also measured: time of the regressor, number of
+ * base parameters, and condition number and time of the optimized excitation trajectory with one
+ * thread and with all the cores (the result must be the same, and better conditioned than the
+ * random trajectory).
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <complex>
+#include <vector>
+
+
+// Specific library
+#include "../LiCAS_Identification/LiCAS_Excitation.h"
+#include "../LiCAS_Identification/LiCAS_FrequencyResponse.h"
+#include "../LiCAS_Identification/LiCAS_ExcitationOptimizer.h"
+#include "Benchmark_Common.h"
+
+
+#define SAMPLE_RATE			500.0
+#define SERVO_FREQUENCY		8.0		// Natural frequency of the servo in [Hz]
+#define SERVO_DAMPING		0.4
+#define SERVO_DELAY			3		// Delay of the servo in [samples]
+#define MEASUREMENT_NOISE	1e-4	// Noise of the joint position in [rad]
+#define SEGMENT_LENGTH		4096
+#define REGRESSOR_CALLS		100000
+#define OPTIMIZER_STARTS	8
+#define MAGNITUDE_TOLERANCE	1.0		// Maximum error of the magnitude in the reliable points in [dB]
+#define PHASE_TOLERANCE		15.0	// Maximum error of the phase in the reliable points in [deg]
+
+
+// Sink of the results, so the compiler can not remove the benchmarked operations
+static volatile float sink = 0;
+
+
+// Coefficients of the servo (bilinear transform of wn^2/(s^2 + 2*zeta*wn*s + wn^2))
+static double b[3];
+static double a[3];
+
+
+static void initServo()
+{
+	double wn = 2*M_PI*SERVO_FREQUENCY;
+	double K = 2*SAMPLE_RATE;
+	double a0 = K*K + 2*SERVO_DAMPING*wn*K + wn*wn;
+	
+	
+	b[0] = wn*wn/a0;
+	b[1] = 2*wn*wn/a0;
+	b[2] = wn*wn/a0;
+	a[0] = 1;
+	a[1] = (2*wn*wn - 2*K*K)/a0;
+	a[2] = (K*K - 2*SERVO_DAMPING*wn*K + wn*wn)/a0;
+}
+
+
+/*
+ * Exact frequency response of the servo
+ */
+static std::complex<double> getServoResponse(double f)
+{
+	std::complex<double> z1 = std::polar(1.0, -2*M_PI*f/SAMPLE_RATE);
+	
+	
+	return (b[0] + b[1]*z1 + b[2]*z1*z1)/(a[0] + a[1]*z1 + a[2]*z1*z1)*std::pow(z1, SERVO_DELAY);
+}
+
+
+/*
+ * Gaussian random number (Box-Muller)
+ */
+static float getGaussian(float sigma)
+{
+	float u1 = (rand() + 1.0)/(RAND_MAX + 2.0);
+	float u2 = (rand() + 1.0)/(RAND_MAX + 2.0);
+	
+	
+	return sigma*sqrt(-2*log(u1))*cos(2*M_PI*u2);
+}
+
+
+/*
+ * Response of the servo with measurement noise to an input signal
+ */
+static void simulateServo(const std::vector<float> & x, std::vector<float> & y)
+{
+	double u[3] = {0, 0, 0};
+	double v[3] = {0, 0, 0};
+	size_t n = 0;
+	
+	
+	y.assign(x.size(), 0);
+	for(n = 0; n < x.size(); n++)
+	{
+		u[2] = u[1];
+		u[1] = u[0];
+		u[0] = (n >= SERVO_DELAY) ? x[n - SERVO_DELAY] : 0;
+		v[2] = v[1];
+		v[1] = v[0];
+		v[0] = b[0]*u[0] + b[1]*u[1] + b[2]*u[2] - a[1]*v[1] - a[2]*v[2];
+		y[n] = v[0] + getGaussian(MEASUREMENT_NOISE);
+	}
+}
+
+
+/*
+ * Excite the servo, estimate its response and compare it with the exact one
+ */
+static int runIdentification(int type, const char * name)
+{
+	LiCAS_EXCITATION_PARAMETERS parameters = LiCAS_Excitation::getDefaultParameters();
+	LiCAS_Excitation excitation;
+	LiCAS_FrequencyResponse response;
+	std::complex<double> H;
+	std::vector<float> x;
+	std::vector<float> y;
+	char label[128];
+	double magnitudeError = 0;
+	double phaseError = 0;
+	double t0 = 0;
+	int numSamples = 0;
+	int numReliablePoints = 0;
+	int numRepetitions = 20;
+	int n = 0;
+	int k = 0;
+	
+	
+	parameters.type = type;
+	parameters.period = 1.0/SAMPLE_RATE;
+	parameters.jointMask = EXCITATION_JOINT_LEFT(0);
+	if(excitation.setParameters(parameters) != 0)
+	{
+		fprintf(stderr, "ERROR [in runIdentification]: invalid parameters of the excitation\n");
+		return 1;
+	}
+	
+	// Excitation signal
+	numSamples = (int)(parameters.duration*SAMPLE_RATE);
+	x.resize(numSamples);
+	t0 = getTime();
+	for(n = 0; n < numSamples; n++)
+		x[n] = excitation.getSignal(n/SAMPLE_RATE);
+	snprintf(label, sizeof(label), "excitation_%s_signal", name);
+	printResult(label, 1e9*(getTime() - t0)/numSamples, "ns");
+	simulateServo(x, y);
+	
+	// Estimate
+	t0 = getTime();
+	for(n = 0; n < numRepetitions; n++)
+		response.estimate(x.data(), y.data(), numSamples, SAMPLE_RATE, SEGMENT_LENGTH);
+	sink += response.getPoint(0).magnitude;
+	snprintf(label, sizeof(label), "bode_%s_estimate_time", name);
+	printResult(label, 1e3*(getTime() - t0)/numRepetitions, "ms");
+	
+	// Error w.r.t. the exact response in the reliable points
+	for(k = 0; k < response.getNumPoints(); k++)
+	{
+		const LiCAS_BODE_POINT & point = response.getPoint(k);
+		
+		if(point.coherence < COHERENCE_THRESHOLD)
+			continue;
+		H = getServoResponse(point.frequency);
+		magnitudeError = fmax(magnitudeError, fabs(point.magnitude - 20*log10(std::abs(H))));
+		phaseError = fmax(phaseError, fabs(fmod(point.phase - std::arg(H)*180/M_PI + 540.0, 360.0) - 180.0));
+		numReliablePoints++;
+	}
+	snprintf(label, sizeof(label), "bode_%s_reliable_points", name);
+	printResult(label, numReliablePoints, "");
+	snprintf(label, sizeof(label), "bode_%s_magnitude_error_max", name);
+	printResult(label, magnitudeError, "dB");
+	snprintf(label, sizeof(label), "bode_%s_phase_error_max", name);
+	printResult(label, phaseError, "deg");
+	snprintf(label, sizeof(label), "bode_%s_bandwidth", name);
+	printResult(label, response.getBandwidth(), "Hz");
+	
+	snprintf(label, sizeof(label), "bode_%s_within_tolerance", name);
+	
+	
+	return checkResult(label, numReliablePoints > 0 && magnitudeError < MAGNITUDE_TOLERANCE && phaseError < PHASE_TOLERANCE);
+}
+
+
+/*
+ * Delay estimated for a pure delay of the servo (error below one sample)
+ */
+static int runDelay()
+{
+	LiCAS_EXCITATION_PARAMETERS parameters = LiCAS_Excitation::getDefaultParameters();
+	LiCAS_Excitation excitation;
+	LiCAS_FrequencyResponse response;
+	std::vector<float> x;
+	std::vector<float> y;
+	int numSamples = 0;
+	int n = 0;
+	
+	
+	parameters.period = 1.0/SAMPLE_RATE;
+	excitation.setParameters(parameters);
+	numSamples = (int)(parameters.duration*SAMPLE_RATE);
+	x.resize(numSamples);
+	y.resize(numSamples);
+	for(n = 0; n < numSamples; n++)
+	{
+		x[n] = excitation.getSignal(n/SAMPLE_RATE);
+		y[n] = (n >= SERVO_DELAY) ? x[n - SERVO_DELAY] : 0;
+	}
+	response.estimate(x.data(), y.data(), numSamples, SAMPLE_RATE, SEGMENT_LENGTH);
+	printResult("bode_delay_error", 1e6*fabs(response.getDelay() - SERVO_DELAY/SAMPLE_RATE), "us");
+	
+	
+	return checkResult("bode_delay_within_one_sample", fabs(response.getDelay() - SERVO_DELAY/SAMPLE_RATE) < 1.0/SAMPLE_RATE);
+}
+
+
+/*
+ * Regressor of the dynamics and optimization of the excitation trajectory
+ */
+static int runDynamics()
+{
+	LiCAS_Regressor regressor(LiCAS_ARM_LEFT, LiCAS_ArmKinematics::getDefaultGeometry());
+	LiCAS_ExcitationOptimizer optimizer(regressor);
+	LiCAS_OPTIMIZER_PARAMETERS parameters = LiCAS_ExcitationOptimizer::getDefaultParameters();
+	LiCAS_OPTIMIZER_RESULT resultSingle;
+	LiCAS_OPTIMIZER_RESULT resultMulti;
+	LiCAS_FOURIER_TRAJECTORY trajectory;
+	LiCAS_REGRESSOR Y;
+	float q[NUM_ARM_JOINTS] = {0.3, 0.2, -0.4, -1.0};
+	float dq[NUM_ARM_JOINTS] = {0.5, -0.8, 1.1, 0.6};
+	float ddq[NUM_ARM_JOINTS] = {1.5, -2.0, 0.7, 3.0};
+	double t0 = 0;
+	int errorCode = 0;
+	int n = 0;
+	
+	
+	t0 = getTime();
+	for(n = 0; n < REGRESSOR_CALLS; n++)
+	{
+		q[0] += 1e-6;
+		regressor.getRegressor(q, dq, ddq, Y);
+		sink += Y[0][0];
+	}
+	printResult("regressor_time", 1e9*(getTime() - t0)/REGRESSOR_CALLS, "ns");
+	printResult("regressor_base_parameters", regressor.getNumBaseParameters(), "");
+	
+	parameters.numStarts = OPTIMIZER_STARTS;
+	parameters.numThreads = 1;
+	optimizer.setParameters(parameters);
+	errorCode |= optimizer.optimize(&trajectory, &resultSingle);
+	parameters.numThreads = 0;
+	optimizer.setParameters(parameters);
+	errorCode |= optimizer.optimize(&trajectory, &resultMulti);
+	printResult("excitation_condition_random", resultSingle.conditionInitial, "");
+	printResult("excitation_condition_optimized", resultSingle.conditionFinal, "");
+	printResult("excitation_optimizer_time_1_thread", resultSingle.optimizationTime, "s");
+	printResult("excitation_optimizer_threads", resultMulti.numThreads, "");
+	printResult("excitation_optimizer_time_all_threads", resultMulti.optimizationTime, "s");
+	printResult("excitation_optimizer_speedup", resultSingle.optimizationTime/resultMulti.optimizationTime, "");
+	errorCode |= checkResult("excitation_optimizer_same_result_all_threads", resultMulti.conditionFinal == resultSingle.conditionFinal);
+	errorCode |= checkResult("excitation_optimizer_improves_condition", resultSingle.conditionFinal < resultSingle.conditionInitial);
+	
+	
+	return errorCode;
+}
+
+
+int main()
+{
+	int errorCode = 0;
+	
+	
+	srand(1);
+	initServo();
+	errorCode |= runIdentification(EXCITATION_CHIRP, "chirp");
+	errorCode |= runIdentification(EXCITATION_MULTISINE, "multisine");
+	errorCode |= runDelay();
+	errorCode |= runDynamics();
+	
+	
+	return errorCode;
+}
+
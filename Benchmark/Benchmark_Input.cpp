@@ -0,0 +1,225 @@
+/*
+ *
+ * LiCAS ECI - Benchmark_Input.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Loopback benchmarks of the operator input stream (LiCAS_OperatorInput) with two input replayers:
+ * a slow device with a large jitter (joystick through a wireless link) and a fast device with a small
+ * jitter (haptic device), both replaying a sum of sinusoids with noise. The input is resampled at the
+ * rate of a control loop and compared with the signal of the devices (without noise) at the same
+ * time, holding the last sample (baseline), predicting it, and smoothing and predicting it. The time
+ * of the resampling and of the mapping are also measured. The results are printed on stderr with the
+ * format "BENCH <name> <value> <units>". It fails if the prediction does not reduce the error of the
+ * slow device w.r.t. holding the last sample, or if input data packets are discarded.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_Motion/LiCAS_OperatorInput.h"
+#include "../LiCAS_Simulator/LiCAS_InputReplayer.h"
+#include "Benchmark_Common.h"
+
+
+#define BENCH_INPUT_PORT			25300
+#define BENCH_NUM_AXES				3
+#define BENCH_DURATION				6.0		// Duration of the recordings in [s]
+#define BENCH_WARMUP				0.5		// Time before the evaluation (offset window and filter) in [s]
+#define BENCH_CONTROL_RATE			500.0	// Rate of the control loop in [Hz]
+#define BENCH_MAX_PREDICTION		0.05	// Maximum prediction of the input in [s]
+#define BENCH_DISCOUNT				0.5		// Discount factor of the smoothing
+#define BENCH_NOISE					0.001	// Amplitude of the uniform noise of the samples of the devices
+
+
+// Input devices: rate in [Hz] and jitter in [s]
+static const char * deviceName[2] = {"slow", "fast"};
+static const float deviceRate[2] = {125.0, 500.0};
+static const float deviceJitter[2] = {0.004, 0.001};
+
+
+/*
+ * Signal of an axis of the devices at a given time
+ */
+static float getSignal(int axis, double t)
+{
+	return 0.1*sin(2*M_PI*1.0*t + axis) + 0.03*sin(2*M_PI*3.0*t + 2*axis);
+}
+
+
+/*
+ * Replay the devices and resample the input in a control loop. Returns the RMS error of each device
+ * w.r.t. the signal, and the mean time of the resampling and of the mapping.
+ */
+static int runInput(float discount, float maxPrediction, double rmsError[2], double * inputTime, double * referencesTime, uint64_t * numPackets, uint64_t * numDiscarded)
+{
+	LiCAS_OperatorInput * operatorInput = NULL;
+	LiCAS_InputReplayer * replayer[2] = {NULL, NULL};
+	struct timespec deadline;
+	float axes[MAX_INPUT_AXES];
+	float values[MAX_INPUT_AXES];
+	float refL[NUM_ARM_JOINTS];
+	float refR[NUM_ARM_JOINTS];
+	double errorSum[2] = {0, 0};
+	double t_start = 0;
+	double t = 0;
+	double t_call = 0;
+	double inputTimeSum = 0;
+	double referencesTimeSum = 0;
+	long period_ns = (long)(1e9/BENCH_CONTROL_RATE);
+	unsigned int seed = 1;
+	int numSamples = 0;
+	int numCycles = 0;
+	int errorCode = 0;
+	int device = 0;
+	int n = 0;
+	int k = 0;
+	
+	
+	operatorInput = new LiCAS_OperatorInput();
+	operatorInput->setSmoothing(discount, maxPrediction);
+	for(k = 0; k < BENCH_NUM_AXES; k++)
+	{
+		operatorInput->setMapping(k, 0, k, 1.0, 0.3);
+		operatorInput->setMapping(3 + k, 1, k, 1.0, -0.3);
+	}
+	errorCode = operatorInput->openInputChannel(BENCH_INPUT_PORT);
+	
+	// Recordings of the devices
+	for(device = 0; device < 2 && errorCode == 0; device++)
+	{
+		replayer[device] = new LiCAS_InputReplayer();
+		numSamples = (int)(BENCH_DURATION*deviceRate[device]);
+		for(n = 0; n < numSamples; n++)
+		{
+			for(k = 0; k < BENCH_NUM_AXES; k++)
+				axes[k] = getSignal(k, n/deviceRate[device]) + BENCH_NOISE*(2.0*rand_r(&seed)/RAND_MAX - 1);
+			replayer[device]->addSample(n/deviceRate[device], axes, BENCH_NUM_AXES);
+		}
+		errorCode = replayer[device]->openReplayer("127.0.0.1", BENCH_INPUT_PORT, device, deviceJitter[device], 0);
+	}
+	
+	// Control loop, after the warm up
+	if(errorCode == 0)
+	{
+		t_start = replayer[0]->getStartTime();
+		deadline.tv_sec = (time_t)(t_start + BENCH_WARMUP);
+		deadline.tv_nsec = (long)(1e9*(t_start + BENCH_WARMUP - deadline.tv_sec));
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+		while(LiCAS_OperatorInput::getTime() - t_start < BENCH_DURATION - BENCH_WARMUP)
+		{
+			t = LiCAS_OperatorInput::getTime();
+			for(device = 0; device < 2; device++)
+			{
+				t_call = LiCAS_OperatorInput::getTime();
+				operatorInput->getInput(device, t, values, NULL);
+				inputTimeSum += LiCAS_OperatorInput::getTime() - t_call;
+				for(k = 0; k < BENCH_NUM_AXES; k++)
+					errorSum[device] += pow(values[k] - getSignal(k, t - replayer[device]->getStartTime()), 2);
+			}
+			t_call = LiCAS_OperatorInput::getTime();
+			operatorInput->getReferences(t, refL, refR);
+			referencesTimeSum += LiCAS_OperatorInput::getTime() - t_call;
+			numCycles++;
+			
+			deadline.tv_nsec += period_ns;
+			while(deadline.tv_nsec >= 1000000000L)
+			{
+				deadline.tv_nsec -= 1000000000L;
+				deadline.tv_sec++;
+			}
+			clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+		}
+		for(device = 0; device < 2; device++)
+			rmsError[device] = sqrt(errorSum[device]/(numCycles*BENCH_NUM_AXES));
+		*inputTime = inputTimeSum/(2*numCycles);
+		*referencesTime = referencesTimeSum/numCycles;
+		*numPackets = operatorInput->getNumInputPackets(0) + operatorInput->getNumInputPackets(1);
+		*numDiscarded = operatorInput->getNumDiscardedPackets();
+	}
+	
+	for(device = 0; device < 2; device++)
+	{
+		if(replayer[device] != NULL)
+			delete replayer[device];
+	}
+	delete operatorInput;
+	
+	
+	return errorCode;
+}
+
+
+int main()
+{
+	const char * configName[3] = {"hold", "predicted", "smoothed"};
+	const float configDiscount[3] = {0, 0, BENCH_DISCOUNT};
+	const float configPrediction[3] = {0, BENCH_MAX_PREDICTION, BENCH_MAX_PREDICTION};
+	char name[128];
+	double rmsError[2] = {0, 0};
+	double holdError = 0;
+	double inputTime = 0;
+	double referencesTime = 0;
+	uint64_t numPackets = 0;
+	uint64_t numDiscarded = 0;
+	int errorCode = 0;
+	int config = 0;
+	int device = 0;
+	
+	
+	for(config = 0; config < 3 && errorCode == 0; config++)
+	{
+		errorCode = runInput(configDiscount[config], configPrediction[config], rmsError, &inputTime, &referencesTime, &numPackets, &numDiscarded);
+		if(errorCode != 0)
+		{
+			fprintf(stderr, "ERROR [in main]: could not open the loopback setup\n");
+			break;
+		}
+		for(device = 0; device < 2; device++)
+		{
+			sprintf(name, "input_%s_%s_rms_error", deviceName[device], configName[config]);
+			printResult(name, 1e3*rmsError[device], "mm");
+		}
+		sprintf(name, "input_%s_packets", configName[config]);
+		printResult(name, (double)numPackets, "packets");
+		sprintf(name, "input_%s_discarded", configName[config]);
+		printResult(name, (double)numDiscarded, "packets");
+		
+		// The slow device (large jitter) is the one that benefits from the prediction
+		if(config == 0)
+			holdError = rmsError[0];
+		else
+		{
+			sprintf(name, "input_%s_%s_better_than_hold", deviceName[0], configName[config]);
+			errorCode |= checkResult(name, rmsError[0] < holdError);
+		}
+		sprintf(name, "input_%s_no_discarded", configName[config]);
+		errorCode |= checkResult(name, numDiscarded == 0);
+	}
+	
+	// Time of the resampling of a device and of the mapping of both devices (last configuration)
+	if(errorCode == 0)
+	{
+		printResult("input_get_input_time", 1e6*inputTime, "us");
+		printResult("input_get_references_time", 1e6*referencesTime, "us");
+	}
+	
+	
+	return errorCode;
+}
+
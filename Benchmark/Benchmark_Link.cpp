@@ -0,0 +1,289 @@
+/*
+ *
+ * LiCAS ECI - Benchmark_Link.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Loopback benchmarks of the detection of the link loss against the in-process LiCAS simulator,
+ * with the reception executed by the own thread of the interface and by a reactor. While joint
+ * position references are sent at the command rate, the simulator is stopped (as if the LiCAS
+ * control program died) and the time until the link down event (ICMP error of the sender socket)
+ * and until the feedback watchdog timeout is measured. Then the simulator is restarted and the
+ * time until the link up event is measured. The results are printed on stderr with the format
+ * "BENCH <name> <value> <units>". It fails if the link down is not detected before the watchdog
+ * or if the link up is not detected.
+ *
+ * With the arguments <interface> <board IP>, the link monitor of the network interface is measured
+ * instead against a simulator executed on the other side of the interface (for example a veth pair
+ * to a network namespace, see Tools/link_monitor_veth.sh): the interface is set down and up (root
+ * required) and the time until the interface down event, the commands held and the time until the
+ * interface up event and the first feedback after it are reported.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_Reactor.h"
+#include "../LiCAS_Simulator/LiCAS_Simulator.h"
+#include "Benchmark_Common.h"
+
+
+#define BENCH_CMD_PORT				23600
+#define BENCH_FEEDBACK_PORT			24600
+#define BENCH_IF_CMD_PORT			23700	// Ports of the simulator on the other side of the interface
+#define BENCH_IF_FEEDBACK_PORT		24700
+#define BENCH_FEEDBACK_RATE			500.0	// Rate of the feedback of the simulator in [Hz]
+#define BENCH_PERIOD				0.01	// Period of the commands in [s]
+#define BENCH_MAX_WAIT				2.0		// Maximum time waiting for each event in [s]
+#define BENCH_HOLD_TIME				0.2		// Time sending commands while the interface is down in [s]
+
+
+/*
+ * Send joint position references at the command rate until the count of the event code increases,
+ * returning the time waited in [s] (or the maximum wait time)
+ */
+static double waitForEvent(LiCAS_ECI_UDP * licas_eci, uint16_t code, uint64_t count, double t_start)
+{
+	float qLref[NUM_ARM_JOINTS] = {0};
+	float qRref[NUM_ARM_JOINTS] = {0};
+	
+	
+	while(licas_eci->getEventCount(code) == count && getTime() - t_start < BENCH_MAX_WAIT)
+	{
+		licas_eci->sendJointPositionRef(qLref, qRref, BENCH_PERIOD);
+		usleep((useconds_t)(1e6*BENCH_PERIOD));
+	}
+	
+	
+	return getTime() - t_start;
+}
+
+
+/*
+ * Stop and restart the simulator, measuring the detection times of the interface
+ */
+static int runLink(LiCAS_ECI_UDP * licas_eci, LiCAS_Simulator * licas_sim, const char * mode)
+{
+	char name[128];
+	uint64_t numLinkDown = 0;
+	uint64_t numTimeouts = 0;
+	uint64_t numLinkUp = 0;
+	double downDetection = 0;
+	double watchdogDetection = 0;
+	double t_start = 0;
+	int errorCode = 0;
+	
+	
+	usleep(300000);
+	numLinkDown = licas_eci->getEventCount(LiCAS_EVENT_LINK_DOWN);
+	numTimeouts = licas_eci->getEventCount(LiCAS_EVENT_FEEDBACK_TIMEOUT);
+	numLinkUp = licas_eci->getEventCount(LiCAS_EVENT_LINK_UP);
+	
+	// The control program dies
+	licas_sim->closeSimulator();
+	t_start = getTime();
+	downDetection = waitForEvent(licas_eci, LiCAS_EVENT_LINK_DOWN, numLinkDown, t_start);
+	sprintf(name, "link_%s_down_detection", mode);
+	printResult(name, 1e3*downDetection, "ms");
+	watchdogDetection = waitForEvent(licas_eci, LiCAS_EVENT_FEEDBACK_TIMEOUT, numTimeouts, t_start);
+	sprintf(name, "link_%s_watchdog_detection", mode);
+	printResult(name, 1e3*watchdogDetection, "ms");
+	sprintf(name, "link_%s_down_before_watchdog", mode);
+	errorCode = checkResult(name, licas_eci->getEventCount(LiCAS_EVENT_LINK_DOWN) != numLinkDown && downDetection < watchdogDetection);
+	
+	// The control program restarts
+	errorCode |= licas_sim->openSimulator("127.0.0.1", BENCH_CMD_PORT, BENCH_FEEDBACK_PORT, BENCH_FEEDBACK_RATE);
+	t_start = getTime();
+	sprintf(name, "link_%s_up_detection", mode);
+	printResult(name, 1e3*waitForEvent(licas_eci, LiCAS_EVENT_LINK_UP, numLinkUp, t_start), "ms");
+	sprintf(name, "link_%s_up_detected", mode);
+	errorCode |= checkResult(name, licas_eci->getEventCount(LiCAS_EVENT_LINK_UP) != numLinkUp);
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Set the network interface up or down (SIOCSIFFLAGS)
+ */
+static int setInterfaceUp(const char * interfaceName, int flagUp)
+{
+	struct ifreq request;
+	int ioctlSocket = -1;
+	int errorCode = 0;
+	
+	
+	bzero(&request, sizeof(request));
+	strncpy(request.ifr_name, interfaceName, IFNAMSIZ - 1);
+	ioctlSocket = socket(AF_INET, SOCK_DGRAM, 0);
+	if(ioctlSocket < 0 || ioctl(ioctlSocket, SIOCGIFFLAGS, &request) != 0)
+		errorCode = 1;
+	else
+	{
+		if(flagUp == 1)
+			request.ifr_flags |= IFF_UP;
+		else
+			request.ifr_flags &= ~IFF_UP;
+		if(ioctl(ioctlSocket, SIOCSIFFLAGS, &request) != 0)
+			errorCode = 1;
+	}
+	if(ioctlSocket >= 0)
+		close(ioctlSocket);
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Set the network interface down and up, measuring the detection times of the link monitor
+ */
+static int runInterface(const char * interfaceName, const char * boardAddress)
+{
+	LiCAS_ECI_UDP * licas_eci = NULL;
+	LiCAS_ECI_STATISTICS statistics;
+	float qLref[NUM_ARM_JOINTS] = {0};
+	float qRref[NUM_ARM_JOINTS] = {0};
+	uint64_t numFeedbackPackets = 0;
+	uint64_t numInterfaceDown = 0;
+	uint64_t numInterfaceUp = 0;
+	double t_start = 0;
+	int errorCode = 0;
+	
+	
+	licas_eci = new LiCAS_ECI_UDP("LiCAS_Benchmark");
+	licas_eci->setEventCallback(NULL, NULL);
+	errorCode = licas_eci->openUDPInterface(boardAddress, BENCH_IF_CMD_PORT, BENCH_IF_FEEDBACK_PORT);
+	if(errorCode == 0)
+		errorCode = licas_eci->waitForLink(2.0);
+	if(errorCode == 0)
+		errorCode = licas_eci->openLinkMonitor(NULL);
+	if(errorCode == 0)
+	{
+		// The interface of the route to the board is the one given
+		licas_eci->getStatistics(&statistics);
+		if(statistics.interfaceIndex != (int)if_nametoindex(interfaceName))
+		{
+			errorCode = 1;
+			fprintf(stderr, "ERROR [in runInterface]: route to %s not through %s\n", boardAddress, interfaceName);
+		}
+	}
+	if(errorCode == 0)
+	{
+		usleep(300000);
+		
+		// The interface goes down
+		numInterfaceDown = licas_eci->getEventCount(LiCAS_EVENT_INTERFACE_DOWN);
+		numInterfaceUp = licas_eci->getEventCount(LiCAS_EVENT_INTERFACE_UP);
+		t_start = getTime();
+		errorCode = setInterfaceUp(interfaceName, 0);
+		printResult("link_interface_down_detection", 1e3*waitForEvent(licas_eci, LiCAS_EVENT_INTERFACE_DOWN, numInterfaceDown, t_start), "ms");
+		
+		// Commands sent while the interface is down
+		t_start = getTime();
+		while(getTime() - t_start < BENCH_HOLD_TIME)
+		{
+			licas_eci->sendJointPositionRef(qLref, qRref, BENCH_PERIOD);
+			usleep((useconds_t)(1e6*BENCH_PERIOD));
+		}
+		licas_eci->getStatistics(&statistics);
+		printResult("link_interface_held_commands", (double)statistics.numHeldCommands, "packets");
+		
+		// The interface is up again
+		t_start = getTime();
+		if(setInterfaceUp(interfaceName, 1) != 0)
+			errorCode = 1;
+		printResult("link_interface_up_detection", 1e3*waitForEvent(licas_eci, LiCAS_EVENT_INTERFACE_UP, numInterfaceUp, t_start), "ms");
+		licas_eci->getStatistics(&statistics);
+		numFeedbackPackets = statistics.numFeedbackPackets;
+		while(statistics.numFeedbackPackets == numFeedbackPackets && getTime() - t_start < BENCH_MAX_WAIT)
+		{
+			usleep(1000);
+			licas_eci->getStatistics(&statistics);
+		}
+		printResult("link_interface_feedback_restored", 1e3*(getTime() - t_start), "ms");
+	}
+	licas_eci->closeInterface();
+	delete licas_eci;
+	
+	
+	return errorCode;
+}
+
+
+int main(int argc, char ** argv)
+{
+	LiCAS_Simulator * licas_sim = NULL;
+	LiCAS_ECI_UDP * licas_eci = NULL;
+	LiCAS_ECI_Reactor * reactor = NULL;
+	int errorCode = 0;
+	
+	
+	// Link monitor of a network interface
+	if(argc >= 3)
+	{
+		errorCode = runInterface(argv[1], argv[2]);
+		if(errorCode != 0)
+			fprintf(stderr, "ERROR [in main]: could not run the network interface setup\n");
+		return errorCode;
+	}
+	
+	licas_sim = new LiCAS_Simulator("LiCAS_Benchmark_Sim");
+	errorCode = licas_sim->openSimulator("127.0.0.1", BENCH_CMD_PORT, BENCH_FEEDBACK_PORT, BENCH_FEEDBACK_RATE);
+	
+	// Reception executed by the own thread of the interface
+	licas_eci = new LiCAS_ECI_UDP("LiCAS_Benchmark");
+	licas_eci->setEventCallback(NULL, NULL);
+	if(errorCode == 0)
+		errorCode = licas_eci->openUDPInterface("127.0.0.1", BENCH_CMD_PORT, BENCH_FEEDBACK_PORT);
+	if(errorCode == 0)
+		errorCode = licas_eci->waitForLink(2.0);
+	if(errorCode == 0)
+		errorCode = runLink(licas_eci, licas_sim, "thread");
+	licas_eci->closeInterface();
+	delete licas_eci;
+	
+	// Reception executed by a reactor
+	reactor = new LiCAS_ECI_Reactor("eci_reactor");
+	licas_eci = new LiCAS_ECI_UDP("LiCAS_Benchmark");
+	licas_eci->setEventCallback(NULL, NULL);
+	if(errorCode == 0)
+		errorCode = licas_eci->openUDPInterface("127.0.0.1", BENCH_CMD_PORT, BENCH_FEEDBACK_PORT, reactor);
+	if(errorCode == 0)
+		errorCode = reactor->start(0);
+	if(errorCode == 0)
+		errorCode = licas_eci->waitForLink(2.0);
+	if(errorCode == 0)
+		errorCode = runLink(licas_eci, licas_sim, "reactor");
+	reactor->stop();
+	licas_eci->closeInterface();
+	delete licas_eci;
+	delete reactor;
+	
+	if(errorCode != 0)
+		fprintf(stderr, "ERROR [in main]: could not open the loopback setup\n");
+	
+	licas_sim->closeSimulator();
+	delete licas_sim;
+	
+	
+	return errorCode;
+}
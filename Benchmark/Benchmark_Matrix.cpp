@@ -0,0 +1,211 @@
+/*
+ *
+ * LiCAS Kinematics - Benchmark_Matrix.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Benchmarks of the fixed-size matrices (LiCAS_Matrix.h) against naive loops with the dimensions
+ * known only at run time, as in generic dynamic-size libraries. The sizes are those of the arms:
+ * 4x4 transforms, 3xNUM_ARM_JOINTS Jacobians and 8-state filters. The results are printed on
+ * stderr with the format "BENCH <name> <value> <units>". It fails if a fixed-size product differs
+ * from the naive one or if the residual of a solution exceeds the tolerance.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_Kinematics/LiCAS_Matrix.h"
+#include "Benchmark_Common.h"
+
+
+#define MATRIX_TOLERANCE	1e-4	// Maximum difference between the implementations and residual of the solutions
+
+
+// Sink of the results, so the compiler can not remove the benchmarked operations
+static volatile float sink = 0;
+
+
+/*
+ * Naive product with run-time dimensions: C(m x n) = A(m x k)*B(k x n). Not specialized by the
+ * compiler for the constant dimensions of the calls (noipa).
+ */
+static void __attribute__((noipa)) naiveProduct(const float * A, const float * B, float * C, int m, int k, int n)
+{
+	float sum = 0;
+	int i = 0;
+	int j = 0;
+	int l = 0;
+	
+	
+	for(i = 0; i < m; i++)
+	{
+		for(j = 0; j < n; j++)
+		{
+			sum = 0;
+			for(l = 0; l < k; l++)
+				sum += A[i*k + l]*B[l*n + j];
+			C[i*n + j] = sum;
+		}
+	}
+}
+
+
+/*
+ * Product of fixed-size matrices in a non-inlined function, as the naive product
+ */
+template <int M, int K, int N>
+static void __attribute__((noinline)) fixedProduct(const LiCAS_Matrix<M, K> & A, const LiCAS_Matrix<K, N> & B, LiCAS_Matrix<M, N> & C)
+{
+	C = A*B;
+}
+
+
+/*
+ * Time per product of the fixed-size and naive implementations (same result)
+ */
+template <int M, int K, int N>
+static int benchmarkProduct(const char * name, int numIterations)
+{
+	LiCAS_Matrix<M, K> A;
+	LiCAS_Matrix<K, N> B;
+	LiCAS_Matrix<M, N> C;
+	LiCAS_Matrix<M, N> Cnaive;
+	char resultName[64];
+	float error = 0;
+	double t0 = 0;
+	int k = 0;
+	
+	
+	for(k = 0; k < M*K; k++)
+		A.data[k] = 0.01*(k + 1);
+	for(k = 0; k < K*N; k++)
+		B.data[k] = 0.02*(k + 1);
+	
+	t0 = getTime();
+	for(k = 0; k < numIterations; k++)
+	{
+		A.data[0] = 1e-6*k;
+		fixedProduct(A, B, C);
+		sink += C.data[0];
+	}
+	snprintf(resultName, sizeof(resultName), "matrix_%s_fixed", name);
+	printResult(resultName, 1e9*(getTime() - t0)/numIterations, "ns");
+	
+	t0 = getTime();
+	for(k = 0; k < numIterations; k++)
+	{
+		A.data[0] = 1e-6*k;
+		naiveProduct(A.data, B.data, C.data, M, K, N);
+		sink += C.data[0];
+	}
+	snprintf(resultName, sizeof(resultName), "matrix_%s_naive", name);
+	printResult(resultName, 1e9*(getTime() - t0)/numIterations, "ns");
+	
+	// The last product of both implementations
+	Cnaive = C;
+	fixedProduct(A, B, C);
+	for(k = 0; k < M*N; k++)
+		error = fmax(error, fabs(C.data[k] - Cnaive.data[k]));
+	snprintf(resultName, sizeof(resultName), "matrix_%s_matches_naive", name);
+	
+	
+	return checkResult(resultName, error < MATRIX_TOLERANCE);
+}
+
+
+/*
+ * Time per solution of a symmetric positive definite system (filter update), checking the residual
+ */
+template <int N>
+static int benchmarkSolve(const char * name, int numIterations)
+{
+	LiCAS_Matrix<N, N> A = LiCAS_Matrix<N, N>::identity();
+	LiCAS_Matrix<N, 1> b;
+	LiCAS_Matrix<N, 1> x;
+	LiCAS_Matrix<N, 1> xLU;
+	char resultName[64];
+	float residual = 0;
+	double t0 = 0;
+	int i = 0;
+	int k = 0;
+	
+	
+	for(i = 0; i < N; i++)
+	{
+		A(i, i) = 2 + i;
+		if(i > 0)
+			A(i, i - 1) = A(i - 1, i) = 0.5;
+		b.data[i] = 1;
+	}
+	
+	t0 = getTime();
+	for(k = 0; k < numIterations; k++)
+	{
+		b.data[0] = 1e-6*k;
+		LiCAS_Solve(A, b, x);
+		sink += x.data[0];
+	}
+	snprintf(resultName, sizeof(resultName), "matrix_%s_lu", name);
+	printResult(resultName, 1e9*(getTime() - t0)/numIterations, "ns");
+	xLU = x;
+	
+	t0 = getTime();
+	for(k = 0; k < numIterations; k++)
+	{
+		b.data[0] = 1e-6*k;
+		LiCAS_CholeskySolve(A, b, x);
+		sink += x.data[0];
+	}
+	snprintf(resultName, sizeof(resultName), "matrix_%s_cholesky", name);
+	printResult(resultName, 1e9*(getTime() - t0)/numIterations, "ns");
+	
+	// Residual of the last solution of both methods
+	for(i = 0; i < N; i++)
+	{
+		residual = fmax(residual, fabs((A*xLU).data[i] - b.data[i]));
+		residual = fmax(residual, fabs((A*x).data[i] - b.data[i]));
+	}
+	snprintf(resultName, sizeof(resultName), "matrix_%s_residual_within_tolerance", name);
+	
+	
+	return checkResult(resultName, residual < MATRIX_TOLERANCE);
+}
+
+
+int main(int argc, char ** argv)
+{
+	int scale = 1;
+	int errorCode = 0;
+	
+	
+	// Optional scale factor of the number of iterations
+	if(argc > 1)
+		scale = atoi(argv[1]);
+	if(scale < 1)
+		scale = 1;
+	
+	errorCode |= benchmarkProduct<4, 4, 4>("transform_4x4", 2000000*scale);
+	errorCode |= benchmarkProduct<3, NUM_ARM_JOINTS, 1>("jacobian_3x4_vector", 2000000*scale);
+	errorCode |= benchmarkProduct<NUM_ARM_JOINTS, 3, NUM_ARM_JOINTS>("jacobian_transpose_product", 2000000*scale);
+	errorCode |= benchmarkProduct<8, 8, 8>("filter_8x8", 500000*scale);
+	errorCode |= benchmarkSolve<NUM_ARM_JOINTS>("solve_4x4", 1000000*scale);
+	errorCode |= benchmarkSolve<8>("solve_8x8", 500000*scale);
+	
+	
+	return errorCode;
+}
+
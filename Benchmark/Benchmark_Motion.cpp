@@ -0,0 +1,320 @@
+/*
+ *
+ * LiCAS Motion - Benchmark_Motion.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Benchmarks of the look-ahead blending of waypoints (LiCAS_WaypointBlender). A random path of
+ * joint waypoints of both arms is streamed to the blender at 500 Hz, appending the waypoints with
+ * a short look-ahead while the motion runs. The duration of the motion is compared against the
+ * motion that stops at every waypoint (null tolerance), the velocity, acceleration and corner
+ * deviation are checked against the limits, and the time of the update and addWaypoint calls is
+ * measured. The linear and circular motions of the TCP (LiCAS_CartesianMove) are checked computing
+ * the forward kinematics of the streamed joint references, measuring the time of the validation
+ * and the update calls. The results are printed on stderr with the format "BENCH <name> <value>
+ * <units>". It fails if a limit or the tolerance is exceeded, if the blending does not shorten the
+ * motion, or if the TCP leaves the path.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_Packets.h"
+#include "../LiCAS_Motion/LiCAS_WaypointBlender.h"
+#include "../LiCAS_Motion/LiCAS_CartesianMove.h"
+#include "Benchmark_Common.h"
+
+
+#define NUM_AXES			(2*NUM_ARM_JOINTS)
+#define NUM_WAYPOINTS		500
+#define CONTROL_PERIOD		0.002	// Update period in [s]
+#define LOOK_AHEAD			8		// Waypoints appended in advance
+#define MAX_VELOCITY		1.5		// Joint velocity limit in [rad/s]
+#define MAX_ACCELERATION	6.0		// Joint acceleration limit in [rad/s^2]
+#define TOLERANCE			0.02	// Blending tolerance in [rad]
+#define ARC_RADIUS			0.06	// Radius of the circular motion in [m]
+#define LIMIT_MARGIN		0.01	// Relative margin of the checks of the limits and the tolerance (sampling of the motion)
+#define PATH_TOLERANCE		0.001	// Maximum distance of the TCP to the path of MoveL and MoveC in [m]
+
+
+typedef struct
+{
+	double duration;			// Duration of the motion in [s]
+	double velocityMax;			// Maximum velocity of the axes relative to the limit
+	double accelerationMax;		// Maximum acceleration of the axes relative to the limit
+	double deviationMax;		// Maximum distance from the waypoints to the trajectory in [rad]
+	double updateTimeMean;		// Execution time of update() in [ns]
+	double updateTimeMax;
+	double addTimeMean;			// Execution time of addWaypoint() in [ns]
+	double addTimeMax;
+} MOTION_RESULT;
+
+
+/*
+ * Stream the waypoints to the blender, appending them with a fixed look-ahead
+ */
+static void runMotion(float waypoints[][NUM_AXES], float tolerance, MOTION_RESULT * result)
+{
+	LiCAS_WaypointBlender blender(NUM_AXES);
+	float maxVelocity[NUM_AXES];
+	float maxAcceleration[NUM_AXES];
+	float q[NUM_AXES];
+	float dq[NUM_AXES];
+	float dq_prev[NUM_AXES] = {0};
+	float distanceMin[NUM_WAYPOINTS];
+	float distance = 0;
+	double t0 = 0;
+	double elapsed = 0;
+	int64_t index = 0;
+	int numUpdates = 0;
+	int numAdded = 1;
+	int k = 0;
+	
+	
+	for(k = 0; k < NUM_AXES; k++)
+	{
+		maxVelocity[k] = MAX_VELOCITY;
+		maxAcceleration[k] = MAX_ACCELERATION;
+	}
+	for(k = 0; k < NUM_WAYPOINTS; k++)
+		distanceMin[k] = 1e9;
+	blender.setLimits(maxVelocity, maxAcceleration);
+	blender.setTolerance(tolerance);
+	blender.reset(waypoints[0]);
+	
+	result->duration = 0;
+	result->velocityMax = 0;
+	result->accelerationMax = 0;
+	result->deviationMax = 0;
+	result->updateTimeMax = 0;
+	result->addTimeMax = 0;
+	result->updateTimeMean = 0;
+	result->addTimeMean = 0;
+	do
+	{
+		// Keep the look-ahead
+		while(numAdded < NUM_WAYPOINTS && blender.getNumPendingWaypoints() < LOOK_AHEAD)
+		{
+			t0 = getTime();
+			blender.addWaypoint(waypoints[numAdded]);
+			elapsed = getTime() - t0;
+			result->addTimeMean += elapsed;
+			result->addTimeMax = fmax(result->addTimeMax, elapsed);
+			numAdded++;
+		}
+		
+		t0 = getTime();
+		blender.update(CONTROL_PERIOD, q, dq);
+		elapsed = getTime() - t0;
+		result->updateTimeMean += elapsed;
+		result->updateTimeMax = fmax(result->updateTimeMax, elapsed);
+		numUpdates++;
+		
+		// Limits and distance to the waypoints of the current segment
+		for(k = 0; k < NUM_AXES; k++)
+		{
+			result->velocityMax = fmax(result->velocityMax, fabs(dq[k])/MAX_VELOCITY);
+			result->accelerationMax = fmax(result->accelerationMax, fabs(dq[k] - dq_prev[k])/CONTROL_PERIOD/MAX_ACCELERATION);
+			dq_prev[k] = dq[k];
+		}
+		for(index = blender.getWaypointIndex(); index <= blender.getWaypointIndex() + 1 && index < NUM_WAYPOINTS; index++)
+		{
+			distance = 0;
+			for(k = 0; k < NUM_AXES; k++)
+				distance += (q[k] - waypoints[index][k])*(q[k] - waypoints[index][k]);
+			distanceMin[index] = fmin(distanceMin[index], sqrt(distance));
+		}
+	} while(blender.isMoving() || numAdded < NUM_WAYPOINTS);
+	
+	for(k = 0; k < NUM_WAYPOINTS; k++)
+		result->deviationMax = fmax(result->deviationMax, distanceMin[k]);
+	result->duration = numUpdates*CONTROL_PERIOD;
+	result->updateTimeMean = 1e9*result->updateTimeMean/numUpdates;
+	result->updateTimeMax *= 1e9;
+	result->addTimeMean = 1e9*result->addTimeMean/(NUM_WAYPOINTS - 1);
+	result->addTimeMax *= 1e9;
+}
+
+
+/*
+ * Stream a planned Cartesian motion, measuring the time of the update calls and the distance of
+ * the TCP of the left arm to the path (a line or a circle of given center and radius)
+ */
+static void runCartesianMove(LiCAS_CartesianMove & move, const LiCAS_ArmKinematics & kinematics, const LiCAS_Vector3 & p0, const LiCAS_Vector3 & p1,
+		const LiCAS_Vector3 * center, MOTION_RESULT * result)
+{
+	LiCAS_Vector3 p;
+	LiCAS_Vector3 p_prev = p0;
+	LiCAS_Vector3 u = (1.0f/norm(p1 - p0))*(p1 - p0);
+	float qL[NUM_ARM_JOINTS];
+	float qR[NUM_ARM_JOINTS];
+	double t0 = 0;
+	double elapsed = 0;
+	int numUpdates = 0;
+	int flagMoving = 1;
+	
+	
+	result->deviationMax = 0;
+	result->velocityMax = 0;
+	result->updateTimeMean = 0;
+	result->updateTimeMax = 0;
+	while(flagMoving == 1)
+	{
+		t0 = getTime();
+		flagMoving = move.update(qL, qR);
+		elapsed = getTime() - t0;
+		result->updateTimeMean += elapsed;
+		result->updateTimeMax = fmax(result->updateTimeMax, elapsed);
+		numUpdates++;
+		
+		p = kinematics.getTCPPosition(qL);
+		if(center != NULL)
+			result->deviationMax = fmax(result->deviationMax, fabs(norm(p - *center) - ARC_RADIUS));
+		else
+			result->deviationMax = fmax(result->deviationMax, norm((p - p0) - dot(p - p0, u)*u));
+		result->velocityMax = fmax(result->velocityMax, norm(p - p_prev)/CONTROL_PERIOD);
+		p_prev = p;
+	}
+	result->duration = numUpdates*CONTROL_PERIOD;
+	result->deviationMax = fmax(result->deviationMax, norm(p - p1));
+	result->updateTimeMean = 1e9*result->updateTimeMean/numUpdates;
+	result->updateTimeMax *= 1e9;
+}
+
+
+/*
+ * Linear and circular motions of the TCP, and rejection of an unreachable target
+ */
+static int benchmarkCartesianMoves()
+{
+	LiCAS_ArmKinematics kinematicsL(LiCAS_ARM_LEFT, LiCAS_ArmKinematics::getDefaultGeometry());
+	LiCAS_ArmKinematics kinematicsR(LiCAS_ARM_RIGHT, LiCAS_ArmKinematics::getDefaultGeometry());
+	LiCAS_CartesianMove move(kinematicsL, kinematicsR);
+	LiCAS_Vector3 p0;
+	LiCAS_Vector3 pL;
+	LiCAS_Vector3 pR;
+	LiCAS_Vector3 via;
+	LiCAS_Vector3 center;
+	MOTION_RESULT result;
+	float q[NUM_ARM_JOINTS] = {-0.6, 0.2, 0.1, -1.5};
+	double t0 = 0;
+	int errorCode = 0;
+	int checkErrors = 0;
+	
+	
+	// MoveL: 10 cm forward with both arms
+	p0 = kinematicsL.getTCPPosition(q);
+	pL = p0;
+	pL[0] += 0.10;
+	pR = kinematicsR.getTCPPosition(q);
+	pR[0] += 0.10;
+	t0 = getTime();
+	errorCode = move.moveL(q, q, &pL, &pR);
+	printResult("movel_validation_time", 1e3*(getTime() - t0), "ms");
+	checkErrors |= checkResult("movel_accepted", errorCode == 0);
+	if(errorCode == 0)
+	{
+		runCartesianMove(move, kinematicsL, p0, pL, NULL, &result);
+		printResult("movel_duration", result.duration, "s");
+		printResult("movel_path_error_max", 1e3*result.deviationMax, "mm");
+		printResult("movel_tcp_speed_max", result.velocityMax, "m/s");
+		printResult("movel_update_mean", result.updateTimeMean, "ns");
+		printResult("movel_update_max", result.updateTimeMax, "ns");
+		checkErrors |= checkResult("movel_path_within_tolerance", result.deviationMax < PATH_TOLERANCE);
+	}
+	
+	// MoveC: half circle in the horizontal plane with the left arm
+	center = p0;
+	center[1] += ARC_RADIUS;
+	via = center;
+	via[0] += ARC_RADIUS;
+	pL = center;
+	pL[1] += ARC_RADIUS;
+	t0 = getTime();
+	errorCode = move.moveC(q, q, &via, &pL, NULL, NULL);
+	printResult("movec_validation_time", 1e3*(getTime() - t0), "ms");
+	checkErrors |= checkResult("movec_accepted", errorCode == 0);
+	if(errorCode == 0)
+	{
+		runCartesianMove(move, kinematicsL, p0, pL, &center, &result);
+		printResult("movec_duration", result.duration, "s");
+		printResult("movec_path_error_max", 1e3*result.deviationMax, "mm");
+		printResult("movec_update_mean", result.updateTimeMean, "ns");
+		checkErrors |= checkResult("movec_path_within_tolerance", result.deviationMax < PATH_TOLERANCE);
+	}
+	
+	// Target out of the workspace: rejected before the execution
+	pL = p0;
+	pL[0] += 0.5;
+	errorCode = move.moveL(q, q, &pL, NULL);
+	printResult("movel_unreachable_result", errorCode, "code");
+	printResult("movel_unreachable_failure_time", move.getFailureTime(), "s");
+	checkErrors |= checkResult("movel_unreachable_rejected", errorCode != 0);
+	
+	
+	return checkErrors;
+}
+
+
+int main()
+{
+	static float waypoints[NUM_WAYPOINTS][NUM_AXES];
+	MOTION_RESULT blended;
+	MOTION_RESULT stopped;
+	int errorCode = 0;
+	int k = 0;
+	int j = 0;
+	
+	
+	// Random walk of the joints with steps of 0.05 to 0.25 rad
+	srand(1);
+	for(j = 0; j < NUM_AXES; j++)
+		waypoints[0][j] = 0;
+	for(k = 1; k < NUM_WAYPOINTS; k++)
+	{
+		for(j = 0; j < NUM_AXES; j++)
+		{
+			waypoints[k][j] = waypoints[k - 1][j] + (0.05 + 0.2*rand()/RAND_MAX)*((rand() & 1) ? 1 : -1);
+			waypoints[k][j] = fmax(-1.5, fmin(1.5, waypoints[k][j]));
+		}
+	}
+	
+	runMotion(waypoints, TOLERANCE, &blended);
+	runMotion(waypoints, 0, &stopped);
+	
+	printResult("blend_motion_time", blended.duration, "s");
+	printResult("blend_stop_motion_time", stopped.duration, "s");
+	printResult("blend_velocity_ratio_max", blended.velocityMax, "x");
+	printResult("blend_acceleration_ratio_max", blended.accelerationMax, "x");
+	printResult("blend_deviation_max", 1e3*blended.deviationMax, "mrad");
+	printResult("blend_stop_deviation_max", 1e3*stopped.deviationMax, "mrad");
+	printResult("blend_update_mean", blended.updateTimeMean, "ns");
+	printResult("blend_update_max", blended.updateTimeMax, "ns");
+	printResult("blend_add_waypoint_mean", blended.addTimeMean, "ns");
+	printResult("blend_add_waypoint_max", blended.addTimeMax, "ns");
+	
+	errorCode |= checkResult("blend_shorter_than_stop", blended.duration < stopped.duration);
+	errorCode |= checkResult("blend_velocity_within_limit", blended.velocityMax <= 1 + LIMIT_MARGIN);
+	errorCode |= checkResult("blend_acceleration_within_limit", blended.accelerationMax <= 1 + LIMIT_MARGIN);
+	errorCode |= checkResult("blend_deviation_within_tolerance", blended.deviationMax <= TOLERANCE*(1 + LIMIT_MARGIN));
+	
+	errorCode |= benchmarkCartesianMoves();
+	
+	
+	return errorCode;
+}
+
@@ -0,0 +1,459 @@
+/*
+ *
+ * LiCAS ECI - Benchmark_Multipath.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Loopback benchmarks of the multipath redundant transport against the in-process LiCAS simulator.
+ * Each path goes through a relay thread that emulates a lossy radio link (fixed delay, random jitter
+ * and random loss, like netem), so no privileges are needed (the path B of the simulator is bound to
+ * the loopback interface, which is allowed without privileges from Linux 5.7). The loss of the
+ * command and feedback data packets is measured with one path and with two paths of the same loss,
+ * and the statistics of each path (loss, share of first copies, delay w.r.t. the first copy and
+ * latency) are reported. The results are printed on stderr with the format "BENCH <name> <value>
+ * <units>". It fails if two paths do not reduce the loss of one path, if with two lossless paths a
+ * command is not delivered exactly once or both paths are sent from the same socket, if the paths
+ * are still reported after closing the interface, if the feedback is not delivered or the latency
+ * is not measured again after the simulator restarts its sequence, or if a data packet of a single
+ * path is unwrapped.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <poll.h>
+#include <pthread.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "../LiCAS_Simulator/LiCAS_Simulator.h"
+#include "Benchmark_Common.h"
+
+
+#define BENCH_CMD_PORT				23800	// Command ports of the paths at the ECI side (+1 for the path B)
+#define BENCH_FEEDBACK_PORT			24800	// Feedback ports of the paths at the ECI side (+1 for the path B)
+#define BENCH_SIM_PORT_OFFSET		10		// Offset of the ports at the simulator side of the relays
+#define BENCH_LOOP_RATE				500.0	// Rate of the simulation loop in [Hz]
+#define BENCH_COMMAND_RATE			100.0	// Rate of the commands in [Hz]
+#define BENCH_RUN_TIME				5.0		// Duration of each run in [s]
+#define BENCH_RELAY_QUEUE			512		// Data packets in flight of each relay
+#define BENCH_LOSS_RATE				0.1		// Loss of each path
+#define BENCH_RESTART_TIME			0.5		// Time before and after the restart of the simulator in [s]
+#define BENCH_RESTART_DELIVERY		0.9		// Minimum fraction of the feedback delivered after the restart
+#define BENCH_SIM_PATH_B_INTERFACE	"lo"	// Network interface of the path B at the simulator side
+
+
+// Relay emulating a lossy path in one direction
+typedef struct
+{
+	int socketRelay;
+	struct sockaddr_in addrDestination;
+	float delay;				// Fixed delay in [s]
+	float jitter;				// Maximum random delay added in [s]
+	float lossRate;				// Fraction of the data packets dropped
+	unsigned int seed;
+	char packets[BENCH_RELAY_QUEUE][MAX_MULTIPATH_PACKET_SIZE];
+	int sizes[BENCH_RELAY_QUEUE];
+	double releaseTimes[BENCH_RELAY_QUEUE];	// 0 if the slot is free
+	int sourcePort;				// Source port of the last data packet received (sender socket of the path)
+	int flagTerminate;
+	pthread_t thread;
+} BENCH_RELAY;
+
+
+// Data packets of a run in both directions
+typedef struct
+{
+	uint64_t numCommandsSent;
+	uint64_t numCommandsReceived;
+	double commandLoss;			// Fraction of the commands not received by the simulator
+	double feedbackLoss;		// Fraction of the feedback data packets not received by the ECI
+	int numPathsClosed;			// Paths reported by the ECI after closing the interface
+} BENCH_RUN_RESULT;
+
+
+/*
+ * Receive the data packets, drop or delay them, and send them to the destination when released
+ */
+static void * relayThreadFunction(void * arg)
+{
+	BENCH_RELAY * relay = (BENCH_RELAY*)arg;
+	struct pollfd pollFd;
+	struct sockaddr_in addrSource;
+	socklen_t addrSourceSize = sizeof(addrSource);
+	char buffer[MAX_MULTIPATH_PACKET_SIZE];
+	double t = 0;
+	int dataReceived = 0;
+	int k = 0;
+	
+	
+	pollFd.fd = relay->socketRelay;
+	pollFd.events = POLLIN;
+	while(__atomic_load_n(&relay->flagTerminate, __ATOMIC_ACQUIRE) == 0)
+	{
+		poll(&pollFd, 1, 1);
+		t = getTime();
+		while((dataReceived = recvfrom(relay->socketRelay, buffer, sizeof(buffer), MSG_DONTWAIT, (struct sockaddr*)&addrSource, &addrSourceSize)) > 0)
+		{
+			__atomic_store_n(&relay->sourcePort, ntohs(addrSource.sin_port), __ATOMIC_RELEASE);
+			if((float)rand_r(&relay->seed)/RAND_MAX < relay->lossRate)
+				continue;
+			for(k = 0; k < BENCH_RELAY_QUEUE && relay->releaseTimes[k] != 0; k++);
+			if(k == BENCH_RELAY_QUEUE)
+				continue;
+			memcpy(relay->packets[k], buffer, dataReceived);
+			relay->sizes[k] = dataReceived;
+			relay->releaseTimes[k] = t + relay->delay + relay->jitter*rand_r(&relay->seed)/RAND_MAX;
+		}
+		for(k = 0; k < BENCH_RELAY_QUEUE; k++)
+		{
+			if(relay->releaseTimes[k] != 0 && relay->releaseTimes[k] <= t)
+			{
+				sendto(relay->socketRelay, relay->packets[k], relay->sizes[k], 0, (struct sockaddr*)&relay->addrDestination, sizeof(struct sockaddr_in));
+				relay->releaseTimes[k] = 0;
+			}
+		}
+	}
+	
+	
+	return NULL;
+}
+
+
+/*
+ * Start a relay from a local port to another one
+ */
+static int startRelay(BENCH_RELAY * relay, int listenPort, int destinationPort, float delay, float jitter, float lossRate, unsigned int seed)
+{
+	struct sockaddr_in addrRelay;
+	
+	
+	bzero(relay, sizeof(BENCH_RELAY));
+	relay->socketRelay = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	addrRelay.sin_family = AF_INET;
+	addrRelay.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addrRelay.sin_port = htons(listenPort);
+	if(relay->socketRelay < 0 || bind(relay->socketRelay, (struct sockaddr*)&addrRelay, sizeof(addrRelay)) < 0)
+		return 1;
+	relay->addrDestination.sin_family = AF_INET;
+	relay->addrDestination.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	relay->addrDestination.sin_port = htons(destinationPort);
+	relay->delay = delay;
+	relay->jitter = jitter;
+	relay->lossRate = lossRate;
+	relay->seed = seed;
+	pthread_create(&relay->thread, NULL, relayThreadFunction, relay);
+	
+	
+	return 0;
+}
+
+
+static void stopRelay(BENCH_RELAY * relay)
+{
+	__atomic_store_n(&relay->flagTerminate, 1, __ATOMIC_RELEASE);
+	pthread_join(relay->thread, NULL);
+	close(relay->socketRelay);
+}
+
+
+/*
+ * Start the relays of both paths in both directions with the same loss. Path A: low delay with high
+ * jitter (Wi-Fi). Path B: higher delay with low jitter (LTE).
+ */
+static int startRelays(BENCH_RELAY * relays, float lossRate)
+{
+	int errorCode = 0;
+	
+	
+	errorCode |= startRelay(&relays[0], BENCH_CMD_PORT, BENCH_CMD_PORT + BENCH_SIM_PORT_OFFSET, 0.002, 0.008, lossRate, 1);
+	errorCode |= startRelay(&relays[1], BENCH_FEEDBACK_PORT + BENCH_SIM_PORT_OFFSET, BENCH_FEEDBACK_PORT, 0.002, 0.008, lossRate, 2);
+	errorCode |= startRelay(&relays[2], BENCH_CMD_PORT + 1, BENCH_CMD_PORT + BENCH_SIM_PORT_OFFSET + 1, 0.005, 0.001, lossRate, 3);
+	errorCode |= startRelay(&relays[3], BENCH_FEEDBACK_PORT + BENCH_SIM_PORT_OFFSET + 1, BENCH_FEEDBACK_PORT + 1, 0.005, 0.001, lossRate, 4);
+	if(errorCode != 0)
+		fprintf(stderr, "ERROR [in startRelays]: could not start the relays of the paths\n");
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Send commands over one or two paths and report the loss and the statistics of the paths
+ */
+static int runPaths(int numPaths, const char * label, BENCH_RUN_RESULT * result)
+{
+	LiCAS_Simulator * licas_sim = NULL;
+	LiCAS_ECI_UDP * licas_eci = NULL;
+	LiCAS_ECI_STATISTICS statistics;
+	LiCAS_ECI_PATH_STATISTICS simPaths[MAX_MULTIPATH_PATHS];
+	const char * pathNames[2] = {"a", "b"};
+	float qLref[NUM_ARM_JOINTS];
+	float qRref[NUM_ARM_JOINTS];
+	char name[128];
+	uint64_t numCommandsSent = 0;
+	uint64_t numCommandsReceived = 0;
+	uint64_t numFeedbackSent = 0;
+	uint64_t numFeedbackReceived = 0;
+	double t_start = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	bzero(qLref, sizeof(qLref));
+	bzero(qRref, sizeof(qRref));
+	licas_sim = new LiCAS_Simulator("LiCAS_Benchmark_Sim");
+	licas_eci = new LiCAS_ECI_UDP("LiCAS_Benchmark");
+	licas_eci->setEventCallback(NULL, NULL);
+	
+	errorCode = licas_sim->openSimulator("127.0.0.1", BENCH_CMD_PORT + BENCH_SIM_PORT_OFFSET, BENCH_FEEDBACK_PORT + BENCH_SIM_PORT_OFFSET, BENCH_LOOP_RATE);
+	if(errorCode == 0)
+		errorCode = licas_eci->openUDPInterface("127.0.0.1", BENCH_CMD_PORT, BENCH_FEEDBACK_PORT);
+	if(errorCode == 0 && numPaths == 2)
+		errorCode = licas_sim->addPath("127.0.0.1", BENCH_CMD_PORT + BENCH_SIM_PORT_OFFSET + 1, BENCH_FEEDBACK_PORT + BENCH_SIM_PORT_OFFSET + 1, BENCH_SIM_PATH_B_INTERFACE);
+	if(errorCode == 0 && numPaths == 2)
+		errorCode = licas_eci->addPath("127.0.0.1", BENCH_CMD_PORT + 1, BENCH_FEEDBACK_PORT + 1, NULL);
+	if(errorCode == 0)
+		errorCode = licas_eci->waitForLink(2.0);
+	if(errorCode != 0)
+	{
+		fprintf(stderr, "ERROR [in runPaths]: could not open the loopback setup with %d paths\n", numPaths);
+		licas_eci->closeInterface();
+		licas_sim->closeSimulator();
+		delete licas_eci;
+		delete licas_sim;
+		return 1;
+	}
+	
+	// Commands at a constant rate, counting the data packets in both directions
+	licas_eci->getStatistics(&statistics);
+	numFeedbackReceived = statistics.numFeedbackPackets;
+	numFeedbackSent = licas_sim->getNumFeedbackPackets();
+	numCommandsReceived = licas_sim->getNumControlRefPackets();
+	t_start = getTime();
+	while(getTime() - t_start < BENCH_RUN_TIME)
+	{
+		qLref[0] = 0.1*sin(getTime() - t_start);
+		if(licas_eci->sendJointPositionRef(qLref, qRref, 0.1) == 0)
+			numCommandsSent++;
+		usleep((useconds_t)(1e6/BENCH_COMMAND_RATE));
+	}
+	usleep(100000);
+	licas_eci->getStatistics(&statistics);
+	numFeedbackReceived = statistics.numFeedbackPackets - numFeedbackReceived;
+	numFeedbackSent = licas_sim->getNumFeedbackPackets() - numFeedbackSent;
+	numCommandsReceived = licas_sim->getNumControlRefPackets() - numCommandsReceived;
+	
+	result->numCommandsSent = numCommandsSent;
+	result->numCommandsReceived = numCommandsReceived;
+	result->commandLoss = 1.0 - (double)numCommandsReceived/(numCommandsSent > 0 ? numCommandsSent : 1);
+	result->feedbackLoss = 1.0 - (double)numFeedbackReceived/(numFeedbackSent > 0 ? numFeedbackSent : 1);
+	sprintf(name, "multipath_%s_command_loss", label);
+	printResult(name, 100.0*result->commandLoss, "%");
+	sprintf(name, "multipath_%s_feedback_loss", label);
+	printResult(name, 100.0*result->feedbackLoss, "%");
+	
+	// Statistics of each path: feedback received by the ECI and commands received by the simulator
+	if(numPaths == 2)
+	{
+		licas_sim->getPathStatistics(simPaths);
+		for(k = 0; k < numPaths; k++)
+		{
+			sprintf(name, "multipath_%s_path_%s_feedback_loss", label, pathNames[k]);
+			printResult(name, 100.0*statistics.paths[k].lossRate, "%");
+			sprintf(name, "multipath_%s_path_%s_feedback_first", label, pathNames[k]);
+			printResult(name, 100.0*statistics.paths[k].numFirst/(numFeedbackReceived > 0 ? numFeedbackReceived : 1), "%");
+			sprintf(name, "multipath_%s_path_%s_feedback_delay", label, pathNames[k]);
+			printResult(name, statistics.paths[k].delayMean, "ms");
+			sprintf(name, "multipath_%s_path_%s_feedback_latency", label, pathNames[k]);
+			printResult(name, statistics.paths[k].latencyMean, "ms");
+			sprintf(name, "multipath_%s_path_%s_command_loss", label, pathNames[k]);
+			printResult(name, 100.0*simPaths[k].lossRate, "%");
+			sprintf(name, "multipath_%s_path_%s_command_first", label, pathNames[k]);
+			printResult(name, 100.0*simPaths[k].numFirst/(numCommandsReceived > 0 ? numCommandsReceived : 1), "%");
+		}
+	}
+	
+	licas_eci->closeInterface();
+	licas_eci->getStatistics(&statistics);
+	result->numPathsClosed = statistics.numPaths;
+	licas_sim->closeSimulator();
+	delete licas_eci;
+	delete licas_sim;
+	
+	
+	return 0;
+}
+
+
+/*
+ * Restart the simulator with two lossless paths shortly after opening it, so the sequence numbers of
+ * its feedback start again behind the newest one received by the ECI (new epoch). Returns the check
+ * that the feedback sent after the restart is delivered.
+ */
+static int runRestart()
+{
+	LiCAS_Simulator * licas_sim = NULL;
+	LiCAS_ECI_UDP * licas_eci = NULL;
+	LiCAS_ECI_STATISTICS statistics;
+	uint64_t numFeedbackSent = 0;
+	uint64_t numFeedbackReceived = 0;
+	int errorCode = 0;
+	
+	
+	licas_sim = new LiCAS_Simulator("LiCAS_Benchmark_Sim");
+	licas_eci = new LiCAS_ECI_UDP("LiCAS_Benchmark");
+	licas_eci->setEventCallback(NULL, NULL);
+	
+	errorCode = licas_sim->openSimulator("127.0.0.1", BENCH_CMD_PORT + BENCH_SIM_PORT_OFFSET, BENCH_FEEDBACK_PORT + BENCH_SIM_PORT_OFFSET, BENCH_LOOP_RATE);
+	if(errorCode == 0)
+		errorCode = licas_eci->openUDPInterface("127.0.0.1", BENCH_CMD_PORT, BENCH_FEEDBACK_PORT);
+	if(errorCode == 0)
+		errorCode = licas_sim->addPath("127.0.0.1", BENCH_CMD_PORT + BENCH_SIM_PORT_OFFSET + 1, BENCH_FEEDBACK_PORT + BENCH_SIM_PORT_OFFSET + 1, BENCH_SIM_PATH_B_INTERFACE);
+	if(errorCode == 0)
+		errorCode = licas_eci->addPath("127.0.0.1", BENCH_CMD_PORT + 1, BENCH_FEEDBACK_PORT + 1, NULL);
+	if(errorCode == 0)
+		errorCode = licas_eci->waitForLink(2.0);
+	if(errorCode == 0)
+	{
+		usleep((useconds_t)(1e6*BENCH_RESTART_TIME));
+		licas_sim->closeSimulator();
+		errorCode = licas_sim->openSimulator("127.0.0.1", BENCH_CMD_PORT + BENCH_SIM_PORT_OFFSET, BENCH_FEEDBACK_PORT + BENCH_SIM_PORT_OFFSET, BENCH_LOOP_RATE);
+		if(errorCode == 0)
+			errorCode = licas_sim->addPath("127.0.0.1", BENCH_CMD_PORT + BENCH_SIM_PORT_OFFSET + 1, BENCH_FEEDBACK_PORT + BENCH_SIM_PORT_OFFSET + 1, BENCH_SIM_PATH_B_INTERFACE);
+	}
+	if(errorCode != 0)
+		fprintf(stderr, "ERROR [in runRestart]: could not open or restart the loopback setup\n");
+	else
+	{
+		// Feedback delivered after the restart (the first data packets in flight are excluded)
+		usleep(100000);
+		licas_eci->getStatistics(&statistics);
+		numFeedbackReceived = statistics.numFeedbackPackets;
+		numFeedbackSent = licas_sim->getNumFeedbackPackets();
+		usleep((useconds_t)(1e6*BENCH_RESTART_TIME));
+		licas_eci->getStatistics(&statistics);
+		numFeedbackReceived = statistics.numFeedbackPackets - numFeedbackReceived;
+		numFeedbackSent = licas_sim->getNumFeedbackPackets() - numFeedbackSent;
+		printResult("multipath_restart_feedback_delivered", 100.0*numFeedbackReceived/(numFeedbackSent > 0 ? numFeedbackSent : 1), "%");
+		errorCode = checkResult("multipath_restart_feedback_delivered", numFeedbackSent > 0 && numFeedbackReceived >= BENCH_RESTART_DELIVERY*numFeedbackSent);
+	}
+	
+	licas_eci->closeInterface();
+	licas_sim->closeSimulator();
+	delete licas_eci;
+	delete licas_sim;
+	
+	
+	return (errorCode != 0) ? 1 : 0;
+}
+
+
+/*
+ * Envelopes of the multipath transport without sockets: a data packet of a single path starting with
+ * the identifier of the envelope is not unwrapped, and the latency of a path is measured again when
+ * the sender restarts with its clock behind (new epoch). Returns the checks.
+ */
+static int checkEnvelopes()
+{
+	LiCAS_ECI_Multipath sender;
+	LiCAS_ECI_Multipath receiver;
+	LiCAS_ECI_PATH_STATISTICS paths[MAX_MULTIPATH_PATHS];
+	LiCAS_FEEDBACK_DATA_PACKET dataPacket;
+	char buffer[MAX_MULTIPATH_PACKET_SIZE];
+	int size = 0;
+	int errorCode = 0;
+	
+	
+	// Feedback data packet of a board not setting the packet ID, whose first byte matches the envelope
+	bzero(&dataPacket, sizeof(dataPacket));
+	*(uint8_t*)&dataPacket = LiCAS_PACKET_ID_MULTIPATH;
+	errorCode |= checkResult("multipath_single_path_not_unwrapped", receiver.isWrapped((const char*)&dataPacket, sizeof(dataPacket)) == 0);
+	
+	// One data packet with a latency of 10 ms, then the sender restarts with its clock 100 s behind
+	// and sends two data packets with a latency of 20 and 30 ms (5 ms above the minimum)
+	sender.setNumPaths(2);
+	receiver.setNumPaths(2);
+	size = sender.wrapPacket(buffer, &dataPacket, sizeof(dataPacket), 100.0);
+	if(receiver.isWrapped(buffer, size) == 1)
+		receiver.acceptPacket(buffer, size, 100.01);
+	sender.restart();
+	size = sender.wrapPacket(buffer, &dataPacket, sizeof(dataPacket), 0.0);
+	if(receiver.isWrapped(buffer, size) == 1)
+		receiver.acceptPacket(buffer, size, 100.04);
+	size = sender.wrapPacket(buffer, &dataPacket, sizeof(dataPacket), 0.01);
+	if(receiver.isWrapped(buffer, size) == 1)
+		receiver.acceptPacket(buffer, size, 100.06);
+	receiver.getStatistics(paths);
+	printResult("multipath_restart_latency", paths[0].latencyMean, "ms");
+	errorCode |= checkResult("multipath_restart_latency_measured_again", paths[0].numReceived == 3 && fabs(paths[0].latencyMean - 5.0) < 1.0);
+	
+	
+	return errorCode;
+}
+
+
+int main()
+{
+	BENCH_RELAY * relays = NULL;
+	BENCH_RUN_RESULT single;
+	BENCH_RUN_RESULT dual;
+	BENCH_RUN_RESULT lossless;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	// One and two paths with the same loss
+	relays = new BENCH_RELAY[4];
+	errorCode = checkEnvelopes();
+	if(errorCode == 0)
+		errorCode = startRelays(relays, BENCH_LOSS_RATE);
+	if(errorCode == 0)
+		errorCode = runPaths(1, "1", &single);
+	if(errorCode == 0)
+		errorCode = runPaths(2, "2", &dual);
+	for(k = 0; k < 4; k++)
+		stopRelay(&relays[k]);
+	if(errorCode == 0)
+	{
+		errorCode |= checkResult("multipath_2_command_loss_below_1", dual.commandLoss < single.commandLoss);
+		errorCode |= checkResult("multipath_2_feedback_loss_below_1", dual.feedbackLoss < single.feedbackLoss);
+		errorCode |= checkResult("multipath_closed_single_path", dual.numPathsClosed == 1);
+	}
+	
+	// Two lossless paths: every command delivered once (no copy lost, no duplicate delivered)
+	if(errorCode == 0)
+		errorCode = startRelays(relays, 0);
+	if(errorCode == 0)
+	{
+		errorCode = runPaths(2, "lossless", &lossless);
+		if(errorCode == 0)
+			errorCode = checkResult("multipath_lossless_commands_delivered_once", lossless.numCommandsSent > 0 && lossless.numCommandsReceived == lossless.numCommandsSent);
+		
+		// Each path sent from its own socket at both sides (different source ports at the relays)
+		if(errorCode == 0)
+			errorCode = checkResult("multipath_paths_sent_from_own_sockets", relays[0].sourcePort != relays[2].sourcePort && relays[1].sourcePort != relays[3].sourcePort);
+		
+		// Simulator restarted with the ECI open: its sequence numbers start again
+		errorCode |= runRestart();
+		for(k = 0; k < 4; k++)
+			stopRelay(&relays[k]);
+	}
+	delete [] relays;
+	
+	
+	return errorCode;
+}
@@ -0,0 +1,173 @@
+/*
+ *
+ * LiCAS Kinematics - Benchmark_SDF.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Benchmarks of the distance field of the environment (LiCAS_SDF). A synthetic environment with
+ * a power line (conductor of 15 mm of radius in front of the arms) is built, the distance of the
+ * field is compared against the analytic one, and the time of the point, capsule and arm queries
+ * is measured. The results are printed on stderr with the format "BENCH <name> <value> <units>".
+ * It fails if the error of the field exceeds the voxel size.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <vector>
+
+
+// Specific library
+#include "../LiCAS_Kinematics/LiCAS_SDF.h"
+#include "Benchmark_Common.h"
+
+
+// Power line: conductor parallel to the Y axis
+#define LINE_X			0.35	// Position of the conductor in [m]
+#define LINE_Z			-0.30
+#define LINE_RADIUS		0.015	// Radius of the conductor in [m]
+#define LINE_LENGTH		2.0		// Length of the conductor in [m]
+#define SDF_RESOLUTION	0.01	// Voxel size in [m]
+#define SDF_FILE_NAME	"LiCAS_SDF_Benchmark.sdf"
+
+
+// Sink of the results, so the compiler can not remove the benchmarked operations
+static volatile float sink = 0;
+
+
+/*
+ * Analytic distance to the surface of the conductor
+ */
+static float lineDistance(const LiCAS_Vector3 & p)
+{
+	return sqrt((p[0] - LINE_X)*(p[0] - LINE_X) + (p[2] - LINE_Z)*(p[2] - LINE_Z)) - LINE_RADIUS;
+}
+
+
+/*
+ * Points of the surface of the conductor
+ */
+static void buildEnvironment(std::vector<LiCAS_Vector3> & points)
+{
+	LiCAS_Vector3 p;
+	float angle = 0;
+	float y = 0;
+	
+	
+	for(y = -0.5*LINE_LENGTH; y <= 0.5*LINE_LENGTH; y += 0.5*SDF_RESOLUTION)
+	{
+		for(angle = 0; angle < 2*M_PI; angle += 0.25*SDF_RESOLUTION/LINE_RADIUS)
+		{
+			p[0] = LINE_X + LINE_RADIUS*cos(angle);
+			p[1] = y;
+			p[2] = LINE_Z + LINE_RADIUS*sin(angle);
+			points.push_back(p);
+		}
+	}
+}
+
+
+int main(int argc, char ** argv)
+{
+	std::vector<LiCAS_Vector3> points;
+	LiCAS_ArmKinematics kinematics(LiCAS_ARM_LEFT, LiCAS_ArmKinematics::getDefaultGeometry());
+	LiCAS_CLEARANCE clearance[NUM_ARM_LINKS];
+	LiCAS_CAPSULE capsules[NUM_ARM_LINKS];
+	LiCAS_SDF sdf;
+	LiCAS_Vector3 p;
+	float q[NUM_ARM_JOINTS] = {0};
+	float distance = 0;
+	float errorMax = 0;
+	double t0 = 0;
+	int numIterations = 1000000;
+	int numSamples = 0;
+	int scale = 1;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	// Optional scale factor of the number of iterations
+	if(argc > 1)
+		scale = atoi(argv[1]);
+	if(scale < 1)
+		scale = 1;
+	numIterations *= scale;
+	
+	buildEnvironment(points);
+	t0 = getTime();
+	if(LiCAS_SDF::build(points, SDF_RESOLUTION, 0.5, 1.0, SDF_FILE_NAME) != 0 || sdf.open(SDF_FILE_NAME) != 0)
+	{
+		fprintf(stderr, "ERROR [in main]: could not build the distance field\n");
+		return 1;
+	}
+	printResult("sdf_build_time", getTime() - t0, "s");
+	
+	// Error of the field with respect to the analytic distance (in the non saturated region)
+	srand(1);
+	for(k = 0; k < 100000; k++)
+	{
+		p[0] = LINE_X - 0.3 + 0.6*rand()/RAND_MAX;
+		p[1] = -0.4 + 0.8*rand()/RAND_MAX;
+		p[2] = LINE_Z - 0.3 + 0.6*rand()/RAND_MAX;
+		if(lineDistance(p) > SDF_RESOLUTION && lineDistance(p) < 0.25)
+		{
+			errorMax = fmax(errorMax, fabs(sdf.getDistance(p) - lineDistance(p)));
+			numSamples++;
+		}
+	}
+	printResult("sdf_distance_error_max", 1e3*errorMax, "mm");
+	errorCode = checkResult("sdf_distance_within_voxel", numSamples > 0 && errorMax < SDF_RESOLUTION);
+	
+	// Point query with gradient
+	t0 = getTime();
+	for(k = 0; k < numIterations; k++)
+	{
+		p[0] = LINE_X - 0.1 + 1e-7*k;
+		p[1] = 0;
+		p[2] = LINE_Z + 0.1;
+		sdf.query(p, &distance, &capsules[0].p0);
+		sink += distance;
+	}
+	printResult("sdf_point_query", 1e9*(getTime() - t0)/numIterations, "ns");
+	
+	// Capsule query: forearm reaching the conductor
+	q[0] = -1.0;
+	q[3] = -0.6;
+	kinematics.getCapsules(q, capsules);
+	t0 = getTime();
+	for(k = 0; k < numIterations/10; k++)
+	{
+		sdf.queryCapsule(capsules[1], &clearance[1]);
+		sink += clearance[1].distance;
+	}
+	printResult("sdf_capsule_query", 1e9*(getTime() - t0)/(numIterations/10), "ns");
+	printResult("sdf_forearm_clearance", 1e3*clearance[1].distance, "mm");
+	
+	// Arm query: forward kinematics and clearance of the links
+	t0 = getTime();
+	for(k = 0; k < numIterations/10; k++)
+	{
+		q[0] = -1.0 + 1e-7*k;
+		sdf.queryArm(kinematics, q, clearance);
+		sink += clearance[0].distance;
+	}
+	printResult("sdf_arm_query", 1e9*(getTime() - t0)/(numIterations/10), "ns");
+	
+	sdf.close();
+	remove(SDF_FILE_NAME);
+	
+	
+	return errorCode;
+}
+
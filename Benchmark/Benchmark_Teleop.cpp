@@ -0,0 +1,206 @@
+/*
+ *
+ * LiCAS ECI - Benchmark_Teleop.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Loopback benchmarks of the bilateral teleoperation bridge (LiCAS_TeleopBridge) with two
+ * in-process LiCAS simulators (master and slave) and both interfaces in one reactor. A third
+ * interface plays the role of the operator, moving the master with joint position steps, and the
+ * end-to-end latency from the master to the slave is measured on the state of the simulators (time
+ * between the crossings of the middle of each step). The time spent by the bridge forwarding each
+ * master feedback and the peak effort of the slave reflected on the master are also measured. The
+ * results are printed on stderr with the format "BENCH <name> <value> <units>". It fails if the
+ * slave does not follow every step or the bridge could not send references to the slave.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_Reactor.h"
+#include "../LiCAS_Simulator/LiCAS_Simulator.h"
+#include "../LiCAS_Motion/LiCAS_TeleopBridge.h"
+#include "Benchmark_Common.h"
+
+
+#define BENCH_MASTER_CMD_PORT		23300
+#define BENCH_MASTER_FEEDBACK_PORT	24300
+#define BENCH_SLAVE_CMD_PORT		23301
+#define BENCH_SLAVE_FEEDBACK_PORT	24301
+#define BENCH_OPERATOR_RX_PORT		24302	// Not used: the master feedback is received by the bridge
+#define BENCH_FEEDBACK_RATE			500.0	// Rate of the feedback of both simulators in [Hz]
+#define BENCH_NUM_STEPS				50
+#define BENCH_STEP_SIZE				0.2		// Size of the joint position steps of the master in [rad]
+#define BENCH_STEP_TIMEOUT			0.1		// Maximum time waiting for the slave after each step in [s]
+#define BENCH_POLL_PERIOD_US		20		// Period of the sampling of the state of the simulators in [us]
+
+
+/*
+ * Move the master with joint position steps of the first joint of the left arm and measure the
+ * time between the crossings of the middle of each step by the master and by the slave. Returns
+ * the number of steps followed by the slave, and the maximum effort of the slave reflected on the
+ * master.
+ */
+static int runSteps(LiCAS_ECI_UDP * licas_operator, LiCAS_Simulator * licas_simMaster, LiCAS_Simulator * licas_simSlave,
+		LiCAS_TeleopBridge * bridge, double * latencyMean, double * latencyMax, float * effortMax)
+{
+	float qLref[NUM_ARM_JOINTS] = {0};
+	float qRref[NUM_ARM_JOINTS] = {0};
+	float effortL[NUM_ARM_JOINTS];
+	float effortR[NUM_ARM_JOINTS];
+	double t_master = 0;
+	double t_slave = 0;
+	double t_step = 0;
+	double latencySum = 0;
+	float threshold = 0;
+	float sign = 1;
+	int numSteps = 0;
+	int n = 0;
+	int k = 0;
+	
+	
+	*latencyMean = 0;
+	*latencyMax = 0;
+	*effortMax = 0;
+	for(n = 0; n < BENCH_NUM_STEPS; n++)
+	{
+		// Step of the master (reached in the next cycle of the simulator)
+		sign = (n % 2 == 0) ? 1 : -1;
+		qLref[0] = (n % 2 == 0) ? BENCH_STEP_SIZE : 0;
+		threshold = 0.5*BENCH_STEP_SIZE;
+		licas_operator->sendJointPositionRef(qLref, qRref, 0);
+		
+		t_master = 0;
+		t_slave = 0;
+		t_step = getTime();
+		while(t_slave == 0 && getTime() - t_step < BENCH_STEP_TIMEOUT)
+		{
+			if(t_master == 0 && sign*(licas_simMaster->qL[0] - threshold) > 0)
+				t_master = getTime();
+			if(t_master != 0 && sign*(licas_simSlave->qL[0] - threshold) > 0)
+				t_slave = getTime();
+			bridge->getSlaveEffort(effortL, effortR);
+			for(k = 0; k < NUM_ARM_JOINTS; k++)
+				*effortMax = fmax(*effortMax, fmax(fabs(effortL[k]), fabs(effortR[k])));
+			usleep(BENCH_POLL_PERIOD_US);
+		}
+		if(t_slave != 0)
+		{
+			latencySum += t_slave - t_master;
+			*latencyMax = fmax(*latencyMax, t_slave - t_master);
+			numSteps++;
+		}
+		
+		// The slave settles before the next step
+		usleep(50000);
+	}
+	if(numSteps > 0)
+		*latencyMean = latencySum/numSteps;
+	
+	
+	return numSteps;
+}
+
+
+int main()
+{
+	LiCAS_Simulator * licas_simMaster = NULL;
+	LiCAS_Simulator * licas_simSlave = NULL;
+	LiCAS_ECI_UDP * licas_master = NULL;
+	LiCAS_ECI_UDP * licas_slave = NULL;
+	LiCAS_ECI_UDP * licas_operator = NULL;
+	LiCAS_ECI_Reactor * reactor = NULL;
+	LiCAS_TeleopBridge * bridge = NULL;
+	LiCAS_TELEOP_STATISTICS statistics;
+	float effortMax = 0;
+	double latencyMean = 0;
+	double latencyMax = 0;
+	int numSteps = 0;
+	int errorCode = 0;
+	
+	
+	licas_simMaster = new LiCAS_Simulator("LiCAS_Benchmark_Master");
+	licas_simSlave = new LiCAS_Simulator("LiCAS_Benchmark_Slave");
+	licas_master = new LiCAS_ECI_UDP("LiCAS_Benchmark_Master");
+	licas_slave = new LiCAS_ECI_UDP("LiCAS_Benchmark_Slave");
+	licas_operator = new LiCAS_ECI_UDP("LiCAS_Benchmark_Operator");
+	reactor = new LiCAS_ECI_Reactor("teleop");
+	bridge = new LiCAS_TeleopBridge(licas_master, licas_slave);
+	bridge->setEffortReflection(TELEOP_DEFAULT_PWM_TORQUE, 1.0, TELEOP_DEFAULT_EFFORT_CUTOFF);
+	licas_master->setEventCallback(NULL, NULL);
+	licas_slave->setEventCallback(NULL, NULL);
+	licas_operator->setEventCallback(NULL, NULL);
+	
+	errorCode = licas_simMaster->openSimulator("127.0.0.1", BENCH_MASTER_CMD_PORT, BENCH_MASTER_FEEDBACK_PORT, BENCH_FEEDBACK_RATE);
+	if(errorCode == 0)
+		errorCode = licas_simSlave->openSimulator("127.0.0.1", BENCH_SLAVE_CMD_PORT, BENCH_SLAVE_FEEDBACK_PORT, BENCH_FEEDBACK_RATE);
+	if(errorCode == 0)
+		errorCode = licas_master->openUDPInterface("127.0.0.1", BENCH_MASTER_CMD_PORT, BENCH_MASTER_FEEDBACK_PORT, reactor);
+	if(errorCode == 0)
+		errorCode = licas_slave->openUDPInterface("127.0.0.1", BENCH_SLAVE_CMD_PORT, BENCH_SLAVE_FEEDBACK_PORT, reactor);
+	if(errorCode == 0)
+		errorCode = licas_operator->openUDPInterface("127.0.0.1", BENCH_MASTER_CMD_PORT, BENCH_OPERATOR_RX_PORT);
+	if(errorCode == 0)
+		errorCode = reactor->start(0);
+	if(errorCode == 0)
+		errorCode = licas_master->waitForLink(2.0);
+	if(errorCode == 0)
+		errorCode = licas_slave->waitForLink(2.0);
+	if(errorCode != 0)
+	{
+		fprintf(stderr, "ERROR [in main]: could not open the loopback setup\n");
+		return 1;
+	}
+	usleep(200000);
+	
+	// End-to-end latency from the master to the slave
+	numSteps = runSteps(licas_operator, licas_simMaster, licas_simSlave, bridge, &latencyMean, &latencyMax, &effortMax);
+	printResult("teleop_master_to_slave_latency_mean", 1e3*latencyMean, "ms");
+	printResult("teleop_master_to_slave_latency_max", 1e3*latencyMax, "ms");
+	printResult("teleop_steps_followed", numSteps, "steps");
+	printResult("teleop_slave_effort_max", effortMax, "Nm");
+	
+	// Time of the bridge from the master feedback to the slave references
+	bridge->getStatistics(&statistics);
+	printResult("teleop_forward_time_mean", statistics.forwardTimeMean, "us");
+	printResult("teleop_forward_time_max", statistics.forwardTimeMax, "us");
+	printResult("teleop_master_packets", (double)statistics.numMasterPackets, "packets");
+	printResult("teleop_slave_packets", (double)statistics.numSlavePackets, "packets");
+	printResult("teleop_send_errors", (double)statistics.numSendErrors, "errors");
+	errorCode |= checkResult("teleop_all_steps_followed", numSteps == BENCH_NUM_STEPS);
+	errorCode |= checkResult("teleop_no_send_errors", statistics.numSendErrors == 0);
+	
+	reactor->stop();
+	licas_operator->closeInterface();
+	licas_slave->closeInterface();
+	licas_master->closeInterface();
+	licas_simSlave->closeSimulator();
+	licas_simMaster->closeSimulator();
+	delete bridge;
+	delete reactor;
+	delete licas_operator;
+	delete licas_slave;
+	delete licas_master;
+	delete licas_simSlave;
+	delete licas_simMaster;
+	
+	
+	return errorCode;
+}
+
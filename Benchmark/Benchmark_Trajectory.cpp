@@ -0,0 +1,219 @@
+/*
+ *
+ * LiCAS ECI - Benchmark_Trajectory.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Loopback benchmarks of the trajectory chunks against the in-process LiCAS simulator. A sinusoidal
+ * joint trajectory is streamed with a random delay of each command (jitter) and a random loss of
+ * commands, sending one joint position reference per period (baseline) or a chunk with the next
+ * setpoints of the trajectory per period. The position of the simulated arm is compared with the
+ * trajectory delayed by the time that gives the lowest error (the delay of each method is also
+ * reported). The results are printed on stderr with the format "BENCH <name> <value> <units>".
+ * It fails if the chunks do not reduce the error of the single references or the setpoint buffer
+ * of the simulator runs out.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <vector>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "../LiCAS_Simulator/LiCAS_Simulator.h"
+#include "Benchmark_Common.h"
+
+
+#define BENCH_CMD_PORT				23400
+#define BENCH_FEEDBACK_PORT			24400
+#define BENCH_FEEDBACK_RATE			500.0	// Rate of the feedback of the simulator in [Hz]
+#define BENCH_PERIOD				0.01	// Period of the commands in [s]
+#define BENCH_CHUNK_SETPOINTS		8		// Setpoints of each trajectory chunk
+#define BENCH_JITTER				0.008	// Maximum random delay of the commands in [s]
+#define BENCH_LOSS					0.05	// Probability of loss of a command
+#define BENCH_DURATION				4.0		// Duration of the trajectory in [s]
+#define BENCH_SETTLING				0.5		// Time before the evaluation in [s]
+#define BENCH_MAX_DELAY				0.1		// Maximum delay of the arm w.r.t. the trajectory in [s]
+#define BENCH_AMPLITUDE				0.5		// Amplitude of the trajectory in [rad]
+#define BENCH_FREQUENCY				0.5		// Frequency of the trajectory in [Hz]
+
+
+static void sleepUntil(double t)
+{
+	struct timespec deadline;
+	
+	
+	deadline.tv_sec = (time_t)t;
+	deadline.tv_nsec = (long)(1e9*(t - deadline.tv_sec));
+	clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+}
+
+
+/*
+ * Position of the first joint of the arms along the trajectory
+ */
+static float getTrajectory(double t)
+{
+	return (t < 0) ? 0 : BENCH_AMPLITUDE*sin(2*M_PI*BENCH_FREQUENCY*t);
+}
+
+
+/*
+ * Stream the trajectory with jitter and loss of the commands, one reference (flagChunks = 0) or one
+ * chunk (flagChunks = 1) per period, sampling the position of the simulated arm at the start of
+ * each period. Returns the RMS and maximum error of the position w.r.t. the trajectory with the
+ * delay of the lowest RMS error.
+ */
+static void runTrajectory(LiCAS_ECI_UDP * licas_eci, LiCAS_Simulator * licas_sim, int flagChunks, double * rmsError, double * maxError, double * delay)
+{
+	LiCAS_TRAJECTORY_SETPOINT setpoints[BENCH_CHUNK_SETPOINTS];
+	std::vector<double> t_sample;
+	std::vector<float> q_sample;
+	float qLref[NUM_ARM_JOINTS] = {0};
+	float qRref[NUM_ARM_JOINTS] = {0};
+	unsigned int seed = 1;
+	double t_eci = 0;
+	double t_start = 0;
+	double t = 0;
+	double errorSum = 0;
+	double errorMax = 0;
+	double error = 0;
+	double d = 0;
+	int numSamples = 0;
+	int m = 0;
+	int n = 0;
+	
+	
+	bzero(setpoints, sizeof(setpoints));
+	*rmsError = -1;
+	t_eci = licas_eci->getElapsedTime();
+	t_start = getTime();
+	licas_eci->startTrajectory();
+	for(m = 0; m*BENCH_PERIOD < BENCH_DURATION; m++)
+	{
+		// Position of the arm at the start of the period
+		sleepUntil(t_start + m*BENCH_PERIOD);
+		t_sample.push_back(getTime() - t_start);
+		q_sample.push_back(licas_sim->qL[0]);
+		
+		// Random delay and loss of the command
+		sleepUntil(t_start + m*BENCH_PERIOD + BENCH_JITTER*rand_r(&seed)/RAND_MAX);
+		if(rand_r(&seed) < BENCH_LOSS*RAND_MAX)
+			continue;
+		
+		if(flagChunks == 0)
+		{
+			qLref[0] = getTrajectory(m*BENCH_PERIOD);
+			qRref[0] = qLref[0];
+			licas_eci->sendJointPositionRef(qLref, qRref, BENCH_PERIOD);
+		}
+		else
+		{
+			for(n = 0; n < BENCH_CHUNK_SETPOINTS; n++)
+			{
+				setpoints[n].t = t_eci + (m + n)*BENCH_PERIOD;
+				setpoints[n].refL[0] = getTrajectory((m + n)*BENCH_PERIOD);
+				setpoints[n].refR[0] = setpoints[n].refL[0];
+			}
+			licas_eci->sendJointTrajectoryChunk(m, setpoints, BENCH_CHUNK_SETPOINTS);
+		}
+	}
+	
+	// Delay of the arm with the lowest error
+	for(d = 0; d <= BENCH_MAX_DELAY; d += 0.001)
+	{
+		errorSum = 0;
+		errorMax = 0;
+		numSamples = 0;
+		for(n = 0; n < (int)t_sample.size(); n++)
+		{
+			t = t_sample[n];
+			if(t < BENCH_SETTLING)
+				continue;
+			error = fabs(q_sample[n] - getTrajectory(t - d));
+			errorSum += error*error;
+			errorMax = fmax(errorMax, error);
+			numSamples++;
+		}
+		if(numSamples > 0 && (*rmsError < 0 || sqrt(errorSum/numSamples) < *rmsError))
+		{
+			*rmsError = sqrt(errorSum/numSamples);
+			*maxError = errorMax;
+			*delay = d;
+		}
+	}
+	
+	// Back to the initial position
+	qLref[0] = 0;
+	qRref[0] = 0;
+	licas_eci->sendJointPositionRef(qLref, qRref, 0.2);
+	usleep(400000);
+}
+
+
+int main()
+{
+	LiCAS_Simulator * licas_sim = NULL;
+	LiCAS_ECI_UDP * licas_eci = NULL;
+	double rmsError = 0;
+	double singleRmsError = 0;
+	double maxError = 0;
+	double delay = 0;
+	int errorCode = 0;
+	
+	
+	licas_sim = new LiCAS_Simulator("LiCAS_Benchmark_Sim");
+	licas_eci = new LiCAS_ECI_UDP("LiCAS_Benchmark");
+	licas_eci->setEventCallback(NULL, NULL);
+	
+	errorCode = licas_sim->openSimulator("127.0.0.1", BENCH_CMD_PORT, BENCH_FEEDBACK_PORT, BENCH_FEEDBACK_RATE);
+	if(errorCode == 0)
+		errorCode = licas_eci->openUDPInterface("127.0.0.1", BENCH_CMD_PORT, BENCH_FEEDBACK_PORT);
+	if(errorCode == 0)
+		errorCode = licas_eci->waitForLink(2.0);
+	if(errorCode != 0)
+	{
+		fprintf(stderr, "ERROR [in main]: could not open the loopback setup\n");
+		return 1;
+	}
+	usleep(200000);
+	
+	// One joint position reference per period
+	runTrajectory(licas_eci, licas_sim, 0, &rmsError, &maxError, &delay);
+	printResult("trajectory_single_rms_error", 1e3*rmsError, "mrad");
+	printResult("trajectory_single_max_error", 1e3*maxError, "mrad");
+	printResult("trajectory_single_delay", 1e3*delay, "ms");
+	singleRmsError = rmsError;
+	
+	// One chunk with the next setpoints per period
+	runTrajectory(licas_eci, licas_sim, 1, &rmsError, &maxError, &delay);
+	printResult("trajectory_chunk_rms_error", 1e3*rmsError, "mrad");
+	printResult("trajectory_chunk_max_error", 1e3*maxError, "mrad");
+	printResult("trajectory_chunk_delay", 1e3*delay, "ms");
+	printResult("trajectory_chunks_received", (double)licas_sim->getNumTrajectoryChunks(), "packets");
+	printResult("trajectory_chunk_underruns", (double)licas_sim->getNumTrajectoryUnderruns(), "cycles");
+	errorCode |= checkResult("trajectory_chunk_better_than_single", rmsError < singleRmsError);
+	errorCode |= checkResult("trajectory_chunk_no_underruns", licas_sim->getNumTrajectoryChunks() > 0 && licas_sim->getNumTrajectoryUnderruns() == 0);
+	
+	licas_eci->closeInterface();
+	licas_sim->closeSimulator();
+	delete licas_eci;
+	delete licas_sim;
+	
+	
+	return errorCode;
+}
@@ -0,0 +1,144 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_AllocTracker.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Allocation tracking mode. The malloc family is replaced by thin wrappers around the glibc
+ * implementation (__libc_malloc...) that increment a thread local counter. The operator new of
+ * the C++ runtime is implemented over malloc, so it is also accounted.
+ *
+ */
+
+#include "LiCAS_ECI_AllocTracker.h"
+
+#include <atomic>
+#include <stddef.h>
+#include <errno.h>
+
+
+#ifdef LICAS_ECI_ALLOC_TRACKING
+
+// glibc allocator entry points
+extern "C"
+{
+	void * __libc_malloc(size_t size);
+	void * __libc_calloc(size_t n, size_t size);
+	void * __libc_realloc(void * ptr, size_t size);
+	void * __libc_memalign(size_t alignment, size_t size);
+	void __libc_free(void * ptr);
+}
+
+
+// Initial exec TLS model: the counter must be accessible without calling the allocator
+static __thread uint64_t threadAllocations __attribute__((tls_model("initial-exec"))) = 0;
+static std::atomic<uint64_t> totalAllocations(0);
+
+
+static inline void countAllocation()
+{
+	threadAllocations++;
+	totalAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+extern "C"
+{
+
+void * malloc(size_t size)
+{
+	countAllocation();
+	return __libc_malloc(size);
+}
+
+
+void * calloc(size_t n, size_t size)
+{
+	countAllocation();
+	return __libc_calloc(n, size);
+}
+
+
+void * realloc(void * ptr, size_t size)
+{
+	countAllocation();
+	return __libc_realloc(ptr, size);
+}
+
+
+void * memalign(size_t alignment, size_t size)
+{
+	countAllocation();
+	return __libc_memalign(alignment, size);
+}
+
+
+void * aligned_alloc(size_t alignment, size_t size)
+{
+	countAllocation();
+	return __libc_memalign(alignment, size);
+}
+
+
+int posix_memalign(void ** ptr, size_t alignment, size_t size)
+{
+	void * p = NULL;
+
+
+	countAllocation();
+	p = __libc_memalign(alignment, size);
+	if(p == NULL)
+		return ENOMEM;
+	*ptr = p;
+
+
+	return 0;
+}
+
+
+void free(void * ptr)
+{
+	__libc_free(ptr);
+}
+
+}
+
+#endif
+
+
+bool LiCAS_ECI_AllocTracker::isEnabled()
+{
+#ifdef LICAS_ECI_ALLOC_TRACKING
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+uint64_t LiCAS_ECI_AllocTracker::getThreadAllocations()
+{
+#ifdef LICAS_ECI_ALLOC_TRACKING
+	return threadAllocations;
+#else
+	return 0;
+#endif
+}
+
+
+uint64_t LiCAS_ECI_AllocTracker::getTotalAllocations()
+{
+#ifdef LICAS_ECI_ALLOC_TRACKING
+	return totalAllocations.load(std::memory_order_relaxed);
+#else
+	return 0;
+#endif
+}
+
@@ -0,0 +1,52 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_AllocTracker.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Allocation tracking mode. When the library is built with the LICAS_ECI_ALLOC_TRACKING option,
+ * the malloc family is intercepted and every heap allocation is counted on a per-thread basis.
+ * The interface uses these counters to verify that the send and receive paths do not touch the
+ * heap between waitForLink() and closeInterface(). Without the option the counters are always 0.
+ *
+ */
+
+#ifndef LICAS_ECI_ALLOC_TRACKER_H_
+#define LICAS_ECI_ALLOC_TRACKER_H_
+
+
+// Standard library
+#include <stdint.h>
+
+
+class LiCAS_ECI_AllocTracker
+{
+public:
+
+	/*
+	 * Returns true if the library was built with the allocation tracking mode
+	 */
+	static bool isEnabled();
+
+
+	/*
+	 * Number of heap allocations (malloc, calloc, realloc, new...) made by the calling thread
+	 */
+	static uint64_t getThreadAllocations();
+
+
+	/*
+	 * Number of heap allocations made by all the threads of the process
+	 */
+	static uint64_t getTotalAllocations();
+};
+
+#endif
+
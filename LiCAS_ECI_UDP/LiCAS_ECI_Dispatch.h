@@ -0,0 +1,134 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) through UDP sockets - LiCAS_ECI_Dispatch.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Compile-time dispatch table of the received data packets. Each entry associates a packet type
+ * (C-style structure) with its packetID, and the packets are matched by size and packetID. The
+ * table is expanded by the compiler into a sequence of constant comparisons that calls the
+ * handlePacket() overload of the handler for the packet type, so new packet types are supported
+ * adding an entry to the table and a handler, without modifying the reception loop.
+ *
+ * Example:
+ *
+ * 	typedef LiCAS_PacketTable<
+ * 		LiCAS_PacketEntry<LiCAS_STATUS_DATA_PACKET, LiCAS_PACKET_ID_STATUS>,
+ * 		LiCAS_PacketEntry<LiCAS_FEEDBACK_DATA_PACKET, LiCAS_PACKET_ID_FEEDBACK, true>
+ * 	> PACKET_TABLE;
+ *
+ * 	index = PACKET_TABLE::dispatch(handler, buffer, size);	// -1 if no entry matches
+ *
+ */
+
+#ifndef LICAS_ECI_DISPATCH_H_
+#define LICAS_ECI_DISPATCH_H_
+
+
+// Standard library
+#include <stdint.h>
+
+
+// Reception statistics of each entry of the dispatch table
+typedef struct
+{
+	uint8_t packetID;		// Packet identifier of the entry
+	uint8_t flagAnyID;		// 1 if the entry matches any packet identifier
+	uint16_t size;			// Size of the packet in [bytes]
+	uint64_t numPackets;	// Number of packets received
+	float t_lastPacket;		// Time of the last packet received in [s]
+} LiCAS_ECI_PACKET_STATISTICS;
+
+
+/*
+ * Entry of the dispatch table.
+ *
+ * Template parameters:
+ * 	(1) Packet type (C-style structure whose first byte is the packetID)
+ * 	(2) Packet identifier
+ * 	(3) Match any packet identifier with the size of the packet (legacy packets). These entries
+ * 	    must be placed at the end of the table.
+ */
+template <typename PACKET, uint8_t ID, bool ANY_ID = false>
+struct LiCAS_PacketEntry
+{
+	typedef PACKET Packet;
+	
+	static inline bool matches(const char * buffer, int size)
+	{
+		return size == (int)sizeof(PACKET) && (ANY_ID || (uint8_t)buffer[0] == ID);
+	}
+	
+	static inline void describe(LiCAS_ECI_PACKET_STATISTICS * packetStatistics)
+	{
+		packetStatistics->packetID = ID;
+		packetStatistics->flagAnyID = ANY_ID ? 1 : 0;
+		packetStatistics->size = (uint16_t)sizeof(PACKET);
+	}
+};
+
+
+/*
+ * Dispatch table, defined as the list of its entries
+ */
+template <typename... ENTRIES>
+struct LiCAS_PacketTable;
+
+
+template <>
+struct LiCAS_PacketTable<>
+{
+	static const int numEntries = 0;
+	
+	template <typename HANDLER>
+	static inline int dispatch(HANDLER *, const char *, int, int = 0)
+	{
+		return -1;
+	}
+	
+	static inline void describe(LiCAS_ECI_PACKET_STATISTICS *)
+	{
+	}
+};
+
+
+template <typename ENTRY, typename... REST>
+struct LiCAS_PacketTable<ENTRY, REST...>
+{
+	static const int numEntries = 1 + LiCAS_PacketTable<REST...>::numEntries;
+	
+	/*
+	 * Call the handler of the first entry that matches the packet. Returns the index of the entry,
+	 * or -1 if the packet does not match any entry.
+	 */
+	template <typename HANDLER>
+	static inline int dispatch(HANDLER * handler, const char * buffer, int size, int index = 0)
+	{
+		if(ENTRY::matches(buffer, size))
+		{
+			handler->handlePacket((const typename ENTRY::Packet*)buffer);
+			return index;
+		}
+		
+		return LiCAS_PacketTable<REST...>::dispatch(handler, buffer, size, index + 1);
+	}
+	
+	/*
+	 * Fill the identifier and size of each entry in the statistics array
+	 */
+	static inline void describe(LiCAS_ECI_PACKET_STATISTICS * packetStatistics)
+	{
+		ENTRY::describe(packetStatistics);
+		LiCAS_PacketTable<REST...>::describe(packetStatistics + 1);
+	}
+};
+
+#endif
+
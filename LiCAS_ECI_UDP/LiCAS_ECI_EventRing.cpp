@@ -0,0 +1,199 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_EventRing.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Lock-free ring of typed events. Bounded multiple producer ring in which each cell carries a
+ * sequence number: producers reserve a position with a compare-and-swap and publish the cell
+ * updating its sequence, while the single consumer releases the cell for the next lap.
+ *
+ */
+
+#include "LiCAS_ECI_EventRing.h"
+
+
+// Text of each event code
+static const char * eventMessages[LiCAS_NUM_EVENT_CODES] =
+{
+	"ERROR: [in LiCAS_ECI_UDP::openUDPInterface] could not open socket.",
+	"ERROR: [in LiCAS_ECI_UDP::openUDPInterface] could not get host by name.",
+	"ERROR: [in LiCAS_ECI_UDP::sendCommandPacket] could not send command data packet.",
+	"ERROR: [in LiCAS_ECI_UDP::sendCommandPacket] incorrect number of bytes sent of the command data packet.",
+	"ERROR: [in LiCAS_ECI_UDP::udpRxThreadFunction] could not open socket.",
+	"ERROR: [in LiCAS_ECI_UDP::udpRxThreadFunction] could not associate address to socket.",
+	"ERROR: [in LiCAS_ECI_UDP::waitForLink] no feedback received from the LiCAS computer board.",
+	"ERROR [in LiCAS_ECI_UDP::closeInterface]: could not terminate reception thread.",
+	"ERROR [in LiCAS_ECI_UDP::closeInterface]: heap allocations in the send/receive paths.",
+	"ERROR: [in LiCAS_ECI_UDP::exportMetrics] could not write metrics file.",
+	"Waiting reception thread termination...",
+	"LiCAS External Control Interface UDP terminated correctly.",
+	"ERROR: [in LiCAS_ECI_UDP::openUDPInterface] could not add the receiver socket to the reactor.",
+	"WARNING: [in LiCAS_ECI_UDP::checkFeedbackWatchdog] no feedback received within the watchdog timeout.",
+	"Feedback from the LiCAS computer board restored.",
+	"ERROR: [in LiCAS_ECI_UDP::requestFeedbackRate] feedback rate request not acknowledged by the LiCAS computer board.",
+	"ERROR: [in LiCAS_ECI_UDP::drainSendErrors] LiCAS computer board unreachable, link down.",
+	"Link with the LiCAS computer board up.",
+	"ERROR: [in LiCAS_ECI_UDP::updateInterfaceState] network interface to the LiCAS computer board down, commands held.",
+	"Network interface to the LiCAS computer board up, link re-established.",
+	"ERROR: [in LiCAS_ECI_UDP::openLinkMonitor] could not open the link monitor of the network interface.",
+	"ERROR: [in LiCAS_ECI_UDP::addPath] could not open a path of the multipath transport.",
+	"ERROR: [in LiCAS_ECI_UDP::openUDPInterface] could not create the reception thread.",
+	"WARNING: [in LiCAS_ECI_UDP::openUDPInterface] could not add the timer of the feedback watchdog to the reactor, watchdog not checked.",
+	"WARNING: [in LiCAS_ECI_UDP::openUDPInterface] could not add the sender socket to the reactor, link down not detected from the ICMP errors.",
+	"ERROR: [in LiCAS_ECI_UDP::sendTrajectoryChunk] invalid number of setpoints of the trajectory chunk, not sent.",
+	"ERROR: [in LiCAS_ECI_UDP::requestFeedbackRate] invalid feedback rate or channels, not requested.",
+	"ERROR: [in LiCAS_ECI_UDP::requestFeedbackRate, reestablishLink] could not send the feedback rate request.",
+	"ERROR: [in LiCAS_ECI_UDP::openUDPInterface] could not connect the sender socket to the LiCAS computer board.",
+	"WARNING: [in LiCAS_ECI_UDP::openUDPInterface] could not enable the error queue of the sender socket, link down not detected from the ICMP errors.",
+	"ERROR: [in LiCAS_ECI_UDP::reestablishLink] could not connect the sender socket again, link down.",
+	"ERROR: [in LiCAS_ECI_UDP::openUDPInterface] could not start the events thread."
+};
+
+
+/*
+ * Constructor
+ * */
+LiCAS_ECI_EventRing::LiCAS_ECI_EventRing()
+{
+	uint64_t k = 0;
+	
+	
+	for(k = 0; k < EVENT_RING_SIZE; k++)
+		this->cells[k].sequence.store(k, std::memory_order_relaxed);
+	for(k = 0; k < LiCAS_NUM_EVENT_CODES; k++)
+		this->counters[k].store(0, std::memory_order_relaxed);
+	
+	this->enqueuePos.store(0, std::memory_order_relaxed);
+	this->dequeuePos.store(0, std::memory_order_relaxed);
+	this->droppedCount.store(0, std::memory_order_relaxed);
+}
+
+
+/*
+ * Push an event in the ring. It can be called from any thread.
+ */
+int LiCAS_ECI_EventRing::push(uint16_t code, uint8_t severity, int32_t errnoValue, int64_t value, float timeStamp)
+{
+	EVENT_CELL * cell = NULL;
+	uint64_t pos = 0;
+	uint64_t count = 0;
+	int64_t diff = 0;
+	int errorCode = 0;
+	
+	
+	if(code < LiCAS_NUM_EVENT_CODES)
+		count = this->counters[code].fetch_add(1, std::memory_order_relaxed) + 1;
+	
+	// Reserve a free cell
+	pos = this->enqueuePos.load(std::memory_order_relaxed);
+	while(cell == NULL && errorCode == 0)
+	{
+		cell = &this->cells[pos & (EVENT_RING_SIZE - 1)];
+		diff = (int64_t)cell->sequence.load(std::memory_order_acquire) - (int64_t)pos;
+		if(diff == 0)
+		{
+			if(this->enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) == false)
+				cell = NULL;
+		}
+		else if(diff < 0)
+		{
+			// The ring is full
+			cell = NULL;
+			errorCode = 1;
+			this->droppedCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			cell = NULL;
+			pos = this->enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+	
+	// Fill and publish the cell
+	if(errorCode == 0)
+	{
+		cell->event.code = code;
+		cell->event.severity = severity;
+		cell->event.errnoValue = errnoValue;
+		cell->event.value = value;
+		cell->event.timeStamp = timeStamp;
+		cell->event.count = count;
+		cell->sequence.store(pos + 1, std::memory_order_release);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Pop the oldest event of the ring (single consumer).
+ */
+int LiCAS_ECI_EventRing::pop(LiCAS_ECI_EVENT * event)
+{
+	uint64_t pos = this->dequeuePos.load(std::memory_order_relaxed);
+	EVENT_CELL * cell = &this->cells[pos & (EVENT_RING_SIZE - 1)];
+	int flagEvent = 0;
+	
+	
+	if(cell->sequence.load(std::memory_order_acquire) == pos + 1)
+	{
+		*event = cell->event;
+		this->dequeuePos.store(pos + 1, std::memory_order_relaxed);
+		cell->sequence.store(pos + EVENT_RING_SIZE, std::memory_order_release);
+		flagEvent = 1;
+	}
+	
+	
+	return flagEvent;
+}
+
+
+/*
+ * Number of occurrences of an event code
+ */
+uint64_t LiCAS_ECI_EventRing::getCount(uint16_t code)
+{
+	uint64_t count = 0;
+	
+	
+	if(code < LiCAS_NUM_EVENT_CODES)
+		count = this->counters[code].load(std::memory_order_relaxed);
+	
+	
+	return count;
+}
+
+
+/*
+ * Number of events dropped because the ring was full
+ */
+uint64_t LiCAS_ECI_EventRing::getDroppedCount()
+{
+	return this->droppedCount.load(std::memory_order_relaxed);
+}
+
+
+/*
+ * Text describing the event code
+ */
+const char * LiCAS_ECI_EventRing::getMessage(uint16_t code)
+{
+	const char * message = "Unknown event.";
+	
+	
+	if(code < LiCAS_NUM_EVENT_CODES)
+		message = eventMessages[code];
+	
+	
+	return message;
+}
+
@@ -0,0 +1,160 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_EventRing.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Lock-free ring of typed error, warning and information events. The events are raised from any
+ * thread of the interface (including the real-time ones) without blocking nor allocating memory,
+ * and they are consumed by a single low priority thread that delivers them to the user callback
+ * or prints them. Each event code has its own counter. If the ring is full the event is dropped
+ * and accounted in the dropped events counter.
+ *
+ */
+
+#ifndef LICAS_ECI_EVENT_RING_H_
+#define LICAS_ECI_EVENT_RING_H_
+
+
+// Standard library
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+
+// Constant definition
+#define EVENT_RING_SIZE	256		// Number of events in the ring (power of 2)
+
+
+// Severity of the events
+static const uint8_t LiCAS_EVENT_SEVERITY_INFO = 0;
+static const uint8_t LiCAS_EVENT_SEVERITY_WARNING = 1;
+static const uint8_t LiCAS_EVENT_SEVERITY_ERROR = 2;
+
+// Event codes
+static const uint16_t LiCAS_EVENT_OPEN_SOCKET = 0;				// Could not open the sender socket
+static const uint16_t LiCAS_EVENT_HOST_NOT_FOUND = 1;			// Could not get host by name
+static const uint16_t LiCAS_EVENT_SEND_FAILED = 2;				// Could not send a command data packet
+static const uint16_t LiCAS_EVENT_SEND_INCOMPLETE = 3;			// Incorrect number of bytes sent of a command data packet
+static const uint16_t LiCAS_EVENT_RX_SOCKET = 4;				// Could not open the receiver socket
+static const uint16_t LiCAS_EVENT_RX_BIND = 5;					// Could not associate address to the receiver socket
+static const uint16_t LiCAS_EVENT_LINK_TIMEOUT = 6;				// No feedback received in waitForLink
+static const uint16_t LiCAS_EVENT_RX_THREAD_TERMINATION = 7;	// Could not terminate the reception thread
+static const uint16_t LiCAS_EVENT_HOT_PATH_ALLOCATIONS = 8;		// Heap allocations in the send/receive paths (value: allocations)
+static const uint16_t LiCAS_EVENT_METRICS_EXPORT = 9;			// Could not write the metrics file
+static const uint16_t LiCAS_EVENT_CLOSING = 10;					// Waiting reception thread termination
+static const uint16_t LiCAS_EVENT_CLOSED = 11;					// Interface terminated correctly
+static const uint16_t LiCAS_EVENT_REACTOR = 12;					// Could not add the receiver socket to the reactor
+static const uint16_t LiCAS_EVENT_FEEDBACK_TIMEOUT = 13;		// No feedback within the watchdog timeout (value: time since the last one in [ms])
+static const uint16_t LiCAS_EVENT_FEEDBACK_RESTORED = 14;		// Feedback received after a watchdog timeout (value: time without feedback in [ms])
+static const uint16_t LiCAS_EVENT_FEEDBACK_RATE = 15;			// Feedback rate request not acknowledged (value: sequence number)
+static const uint16_t LiCAS_EVENT_LINK_DOWN = 16;				// Computer board unreachable, ICMP error of the sender socket (value: ICMP type << 8 | code)
+static const uint16_t LiCAS_EVENT_LINK_UP = 17;					// Feedback received after a link down event
+static const uint16_t LiCAS_EVENT_INTERFACE_DOWN = 18;			// Network interface to the computer board down, commands held (value: interface index)
+static const uint16_t LiCAS_EVENT_INTERFACE_UP = 19;			// Network interface to the computer board up again (value: interface index)
+static const uint16_t LiCAS_EVENT_LINK_MONITOR = 20;			// Could not open the link monitor of the network interface (value: its socket if not added to the reactor)
+static const uint16_t LiCAS_EVENT_MULTIPATH = 21;				// Could not open a path of the multipath transport, or interface not open or maximum number of paths reached (value: path index)
+static const uint16_t LiCAS_EVENT_RX_THREAD_CREATION = 22;		// Could not create the reception thread
+static const uint16_t LiCAS_EVENT_REACTOR_WATCHDOG = 23;		// Could not add the timer of the feedback watchdog to the reactor
+static const uint16_t LiCAS_EVENT_REACTOR_SEND_ERRORS = 24;		// Could not add the sender socket (ICMP errors) to the reactor
+static const uint16_t LiCAS_EVENT_TRAJECTORY_CHUNK = 25;		// Invalid number of setpoints of a trajectory chunk (value: number of setpoints)
+static const uint16_t LiCAS_EVENT_FEEDBACK_RATE_INVALID = 26;	// Invalid feedback rate or channels requested (value: channels)
+static const uint16_t LiCAS_EVENT_FEEDBACK_RATE_SEND = 27;		// Could not send the feedback rate request (value: bytes sent)
+static const uint16_t LiCAS_EVENT_CONNECT = 28;					// Could not connect the sender socket to the computer board
+static const uint16_t LiCAS_EVENT_RECVERR = 29;					// Could not enable the error queue (IP_RECVERR) of the sender socket
+static const uint16_t LiCAS_EVENT_RECONNECT = 30;				// Could not connect the sender socket again when the network interface is up, link down
+static const uint16_t LiCAS_EVENT_EVENT_THREAD = 31;			// Could not start the events thread, interface not opened
+static const uint16_t LiCAS_NUM_EVENT_CODES = 32;
+
+
+// Event record
+typedef struct
+{
+	uint16_t code;			// Event code (LiCAS_EVENT_...)
+	uint8_t severity;		// Severity (LiCAS_EVENT_SEVERITY_...)
+	int32_t errnoValue;		// Value of errno when the event was raised (0 if not applicable)
+	int64_t value;			// Additional value of the event
+	float timeStamp;		// Elapsed time since the creation of the interface in [s]
+	uint64_t count;			// Number of occurrences of this event code, including this one
+} LiCAS_ECI_EVENT;
+
+
+// Callback for delivering the events to the user
+typedef void (*LiCAS_ECI_EventCallback)(const LiCAS_ECI_EVENT * event, void * userData);
+
+
+class LiCAS_ECI_EventRing
+{
+public:
+
+	/*
+	 * Constructor
+	 * */
+	LiCAS_ECI_EventRing();
+	
+	
+	/*
+	 * Push an event in the ring. It can be called from any thread. Returns 0 if the event was
+	 * stored or 1 if it was dropped because the ring is full.
+	 *
+	 * Parameters:
+	 * 	(1) Event code
+	 * 	(2) Severity of the event
+	 * 	(3) Value of errno (0 if not applicable)
+	 * 	(4) Additional value
+	 * 	(5) Time stamp in [s]
+	 */
+	int push(uint16_t code, uint8_t severity, int32_t errnoValue, int64_t value, float timeStamp);
+	
+	
+	/*
+	 * Pop the oldest event of the ring. It must be called from a single consumer thread.
+	 * Returns 1 if an event was extracted, 0 if the ring is empty.
+	 */
+	int pop(LiCAS_ECI_EVENT * event);
+	
+	
+	/*
+	 * Number of occurrences of an event code
+	 */
+	uint64_t getCount(uint16_t code);
+	
+	
+	/*
+	 * Number of events dropped because the ring was full
+	 */
+	uint64_t getDroppedCount();
+	
+	
+	/*
+	 * Text describing the event code, as printed by the default logger
+	 */
+	static const char * getMessage(uint16_t code);
+	
+
+private:
+
+	typedef struct
+	{
+		std::atomic<uint64_t> sequence;
+		LiCAS_ECI_EVENT event;
+	} EVENT_CELL;
+	
+	EVENT_CELL cells[EVENT_RING_SIZE];
+	
+	std::atomic<uint64_t> enqueuePos;
+	std::atomic<uint64_t> dequeuePos;
+	
+	std::atomic<uint64_t> counters[LiCAS_NUM_EVENT_CODES];
+	std::atomic<uint64_t> droppedCount;
+};
+
+#endif
+
@@ -0,0 +1,252 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_LinkMonitor.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * The interface is up when it is administratively up (IFF_UP) and operationally up (IFF_RUNNING,
+ * carrier of the Ethernet or association of the Wi-Fi). If the kernel drops notifications because
+ * the socket buffer is full (ENOBUFS), the state is read again with an ioctl.
+ *
+ */
+
+#include "LiCAS_ECI_LinkMonitor.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_ECI_LinkMonitor::LiCAS_ECI_LinkMonitor()
+{
+	this->netlinkSocket = -1;
+	this->interfaceIndex = 0;
+	this->flagLinkUp = 0;
+}
+
+
+/*
+ * Destructor
+ * */
+LiCAS_ECI_LinkMonitor::~LiCAS_ECI_LinkMonitor()
+{
+	this->close();
+}
+
+
+/*
+ * Open the rtnetlink socket subscribed to the link notifications.
+ *
+ * Parameters:
+ * 	(1) Address of the LiCAS computer board
+ * 	(2) Name of the network interface (NULL: interface of the route to the computer board)
+ */
+int LiCAS_ECI_LinkMonitor::open(struct in_addr destination, const char * interfaceName)
+{
+	struct sockaddr_nl address;
+	int index = 0;
+	int errorCode = 0;
+	
+	
+	this->close();
+	
+	if(interfaceName != NULL)
+		index = (int)if_nametoindex(interfaceName);
+	else
+		index = getRouteInterface(destination);
+	if(index <= 0)
+		return 1;
+	
+	this->netlinkSocket = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+	if(this->netlinkSocket < 0)
+		errorCode = 2;
+	else
+	{
+		bzero(&address, sizeof(address));
+		address.nl_family = AF_NETLINK;
+		address.nl_groups = RTMGRP_LINK;
+		if(bind(this->netlinkSocket, (struct sockaddr*)&address, sizeof(address)) < 0)
+		{
+			errorCode = 2;
+			::close(this->netlinkSocket);
+			this->netlinkSocket = -1;
+		}
+	}
+	
+	// Initial state, after the subscription so no change is missed
+	if(errorCode == 0)
+	{
+		this->interfaceIndex = index;
+		this->flagLinkUp = this->readLinkState();
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Close the rtnetlink socket
+ */
+void LiCAS_ECI_LinkMonitor::close()
+{
+	if(this->netlinkSocket >= 0)
+	{
+		::close(this->netlinkSocket);
+		this->netlinkSocket = -1;
+	}
+	this->interfaceIndex = 0;
+}
+
+
+/*
+ * Process the pending link notifications of the interface monitored
+ */
+int LiCAS_ECI_LinkMonitor::processMessages()
+{
+	uint32_t buffer[2048];
+	struct nlmsghdr * header;
+	struct ifinfomsg * interfaceInfo;
+	int length = 0;
+	
+	
+	while((length = recv(this->netlinkSocket, buffer, sizeof(buffer), 0)) > 0)
+	{
+		for(header = (struct nlmsghdr*)buffer; NLMSG_OK(header, (unsigned int)length); header = NLMSG_NEXT(header, length))
+		{
+			if(header->nlmsg_type != RTM_NEWLINK && header->nlmsg_type != RTM_DELLINK)
+				continue;
+			interfaceInfo = (struct ifinfomsg*)NLMSG_DATA(header);
+			if(interfaceInfo->ifi_index != this->interfaceIndex)
+				continue;
+			if(header->nlmsg_type == RTM_DELLINK)
+				this->flagLinkUp = 0;
+			else
+				this->flagLinkUp = ((interfaceInfo->ifi_flags & IFF_UP) != 0 && (interfaceInfo->ifi_flags & IFF_RUNNING) != 0) ? 1 : 0;
+		}
+	}
+	
+	// Notifications lost: read the state again
+	if(length < 0 && errno == ENOBUFS)
+		this->flagLinkUp = this->readLinkState();
+	
+	
+	return this->flagLinkUp;
+}
+
+
+/*
+ * Returns 1 if the interface is up and running at the last notification
+ */
+int LiCAS_ECI_LinkMonitor::isLinkUp()
+{
+	return this->flagLinkUp;
+}
+
+
+/*
+ * Descriptor of the rtnetlink socket
+ */
+int LiCAS_ECI_LinkMonitor::getSocket()
+{
+	return this->netlinkSocket;
+}
+
+
+/*
+ * Index of the interface monitored
+ */
+int LiCAS_ECI_LinkMonitor::getInterfaceIndex()
+{
+	return this->interfaceIndex;
+}
+
+
+/*
+ * Index of the interface of the route to a destination (RTM_GETROUTE request with the destination
+ * address, answered with the output interface of the route in the RTA_OIF attribute)
+ */
+int LiCAS_ECI_LinkMonitor::getRouteInterface(struct in_addr destination)
+{
+	struct
+	{
+		struct nlmsghdr header;
+		struct rtmsg route;
+		uint32_t attributes[16];
+	} request;
+	uint32_t buffer[1024];
+	struct timeval timeout;
+	struct nlmsghdr * header;
+	struct rtattr * attribute;
+	int routeSocket = -1;
+	int length = 0;
+	int attributesLength = 0;
+	int index = -1;
+	
+	
+	routeSocket = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+	if(routeSocket < 0)
+		return -1;
+	timeout.tv_sec = 1;
+	timeout.tv_usec = 0;
+	setsockopt(routeSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	
+	bzero(&request, sizeof(request));
+	request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct rtmsg));
+	request.header.nlmsg_type = RTM_GETROUTE;
+	request.header.nlmsg_flags = NLM_F_REQUEST;
+	request.route.rtm_family = AF_INET;
+	request.route.rtm_dst_len = 32;
+	attribute = (struct rtattr*)((char*)&request + NLMSG_ALIGN(request.header.nlmsg_len));
+	attribute->rta_type = RTA_DST;
+	attribute->rta_len = RTA_LENGTH(sizeof(struct in_addr));
+	memcpy(RTA_DATA(attribute), &destination, sizeof(struct in_addr));
+	request.header.nlmsg_len = NLMSG_ALIGN(request.header.nlmsg_len) + RTA_ALIGN(attribute->rta_len);
+	
+	if(send(routeSocket, &request, request.header.nlmsg_len, 0) >= 0 && (length = recv(routeSocket, buffer, sizeof(buffer), 0)) > 0)
+	{
+		for(header = (struct nlmsghdr*)buffer; NLMSG_OK(header, (unsigned int)length); header = NLMSG_NEXT(header, length))
+		{
+			if(header->nlmsg_type != RTM_NEWROUTE)
+				continue;
+			attributesLength = RTM_PAYLOAD(header);
+			for(attribute = RTM_RTA((struct rtmsg*)NLMSG_DATA(header)); RTA_OK(attribute, attributesLength); attribute = RTA_NEXT(attribute, attributesLength))
+			{
+				if(attribute->rta_type == RTA_OIF)
+					index = *(int*)RTA_DATA(attribute);
+			}
+		}
+	}
+	::close(routeSocket);
+	
+	
+	return index;
+}
+
+
+/*
+ * Read the state of the interface with an ioctl (1 if up and running)
+ */
+int LiCAS_ECI_LinkMonitor::readLinkState()
+{
+	struct ifreq request;
+	int ioctlSocket = -1;
+	int flagUp = 0;
+	
+	
+	bzero(&request, sizeof(request));
+	ioctlSocket = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	if(ioctlSocket >= 0 && if_indextoname(this->interfaceIndex, request.ifr_name) != NULL && ioctl(ioctlSocket, SIOCGIFFLAGS, &request) == 0)
+		flagUp = ((request.ifr_flags & IFF_UP) != 0 && (request.ifr_flags & IFF_RUNNING) != 0) ? 1 : 0;
+	if(ioctlSocket >= 0)
+		::close(ioctlSocket);
+	
+	
+	return flagUp;
+}
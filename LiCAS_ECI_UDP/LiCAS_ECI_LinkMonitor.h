@@ -0,0 +1,124 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_LinkMonitor.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Link state monitor of the network interface that carries the route to the LiCAS computer board
+ * (Wi-Fi, Ethernet), subscribed to the link notifications of the kernel through a rtnetlink socket.
+ * The loss of the Wi-Fi association or of the Ethernet carrier is notified by the kernel as soon as
+ * the driver detects it, before any timeout of the communication. The socket is non blocking and it
+ * is polled by the reception thread of the interface or registered in a reactor.
+ *
+ * Example:
+ *
+ * 	monitor.open(addrHost.sin_addr, NULL);	// Interface of the route to the computer board
+ * 	...
+ * 	flagLinkUp = monitor.processMessages();	// When the socket is readable
+ *
+ */
+
+#ifndef LICAS_ECI_LINK_MONITOR_H_
+#define LICAS_ECI_LINK_MONITOR_H_
+
+
+// Standard library
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <netinet/in.h>
+#include <net/if.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+
+class LiCAS_ECI_LinkMonitor
+{
+public:
+
+	/*
+	 * Constructor
+	 * */
+	LiCAS_ECI_LinkMonitor();
+	
+	
+	/*
+	 * Destructor
+	 * */
+	virtual ~LiCAS_ECI_LinkMonitor();
+	
+	
+	/*
+	 * Open the rtnetlink socket subscribed to the link notifications and read the initial state of
+	 * the interface. Returns 0 on success, 1 if the interface is not found (no route to the
+	 * destination) or 2 if the socket could not be opened.
+	 *
+	 * Parameters:
+	 * 	(1) Address of the LiCAS computer board
+	 * 	(2) Name of the network interface (NULL: interface of the route to the computer board)
+	 */
+	int open(struct in_addr destination, const char * interfaceName);
+	
+	
+	/*
+	 * Close the rtnetlink socket
+	 */
+	void close();
+	
+	
+	/*
+	 * Process the pending link notifications. Returns 1 if the interface is up and running
+	 * (carrier or association present), 0 otherwise.
+	 */
+	int processMessages();
+	
+	
+	/*
+	 * Returns 1 if the interface is up and running at the last notification
+	 */
+	int isLinkUp();
+	
+	
+	/*
+	 * Descriptor of the rtnetlink socket (-1 if not open)
+	 */
+	int getSocket();
+	
+	
+	/*
+	 * Index of the interface monitored (0 if not open)
+	 */
+	int getInterfaceIndex();
+	
+	
+	/*
+	 * Index of the interface of the route to a destination, asked to the kernel (RTM_GETROUTE).
+	 * Returns -1 if there is no route.
+	 */
+	static int getRouteInterface(struct in_addr destination);
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	int netlinkSocket;
+	int interfaceIndex;
+	int flagLinkUp;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	
+	int readLinkState();
+};
+
+#endif
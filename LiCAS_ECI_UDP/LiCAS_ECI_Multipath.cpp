@@ -0,0 +1,326 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_Multipath.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * The loss of each path is evaluated when a data packet leaves the deduplication window: if it was
+ * not received over a path by then, it is counted as lost for that path. The one-way latency of
+ * each path is given w.r.t. the minimum difference between the reception time and the time stamp of
+ * the sender observed in all the paths, which removes the offset of the clocks.
+ *
+ */
+
+// Standard library
+#include <time.h>
+#include <unistd.h>
+
+
+// Specific library
+#include "LiCAS_ECI_Multipath.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_ECI_Multipath::LiCAS_ECI_Multipath()
+{
+	this->numPaths = 1;
+	this->txEpoch = 0;
+	this->txSequence = 0;
+	this->newestSequence = 0;
+	this->rxEpoch = 0;
+	this->flagWindowStarted = 0;
+	this->latencyOffset = 0;
+	this->flagLatencyOffset = 0;
+	bzero(this->windowExpected, sizeof(this->windowExpected));
+	bzero(this->windowPaths, sizeof(this->windowPaths));
+	bzero(this->windowTime, sizeof(this->windowTime));
+	bzero(this->paths, sizeof(this->paths));
+	bzero(this->delaySum, sizeof(this->delaySum));
+	bzero(this->numDelays, sizeof(this->numDelays));
+	bzero(this->latencySum, sizeof(this->latencySum));
+	bzero(this->numLatencies, sizeof(this->numLatencies));
+	bzero(this->numEvaluated, sizeof(this->numEvaluated));
+	this->restart();
+}
+
+
+/*
+ * Set the number of paths (up to MAX_MULTIPATH_PATHS)
+ */
+int LiCAS_ECI_Multipath::setNumPaths(int _numPaths)
+{
+	int k = 0;
+	
+	
+	if(_numPaths < 1 || _numPaths > MAX_MULTIPATH_PATHS)
+		return 1;
+	
+	for(k = this->numPaths; k < _numPaths; k++)
+	{
+		bzero(&this->paths[k], sizeof(LiCAS_ECI_PATH_STATISTICS));
+		this->delaySum[k] = 0;
+		this->numDelays[k] = 0;
+		this->latencySum[k] = 0;
+		this->numLatencies[k] = 0;
+		this->numEvaluated[k] = 0;
+	}
+	this->numPaths = _numPaths;
+	
+	
+	return 0;
+}
+
+
+/*
+ * Number of paths
+ */
+int LiCAS_ECI_Multipath::getNumPaths()
+{
+	return this->numPaths;
+}
+
+
+/*
+ * Start the sequence numbers of the sender again with a new epoch, different from the previous one
+ * and taken from the clock and the process identifier (so it changes when the program restarts)
+ */
+void LiCAS_ECI_Multipath::restart()
+{
+	struct timespec t;
+	
+	
+	clock_gettime(CLOCK_REALTIME, &t);
+	this->txEpoch = (uint16_t)(this->txEpoch + 1 + (uint32_t)(t.tv_nsec ^ getpid()) % 0xFFFF);
+	if(this->txEpoch == 0)
+		this->txEpoch = 1;		// Epoch 0 is not valid
+	this->txSequence = 0;
+	this->flagWindowStarted = 0;
+}
+
+
+/*
+ * Put a data packet in an envelope with the next sequence number
+ */
+int LiCAS_ECI_Multipath::wrapPacket(char * buffer, const void * dataPacket, int packetSize, float timeStamp)
+{
+	LiCAS_MULTIPATH_HEADER * header = (LiCAS_MULTIPATH_HEADER*)buffer;
+	
+	
+	if(packetSize < 0 || packetSize + (int)sizeof(LiCAS_MULTIPATH_HEADER) > MAX_MULTIPATH_PACKET_SIZE)
+		return -1;
+	
+	this->txSequence++;
+	header->packetID = LiCAS_PACKET_ID_MULTIPATH;
+	header->pathID = 0;
+	header->epoch = this->txEpoch;
+	header->sequence = this->txSequence;
+	header->timeStamp = timeStamp;
+	memcpy(buffer + sizeof(LiCAS_MULTIPATH_HEADER), dataPacket, packetSize);
+	
+	
+	return packetSize + sizeof(LiCAS_MULTIPATH_HEADER);
+}
+
+
+/*
+ * Set the path of the copy of an envelope before sending it over the path
+ */
+void LiCAS_ECI_Multipath::setPath(char * buffer, int pathID)
+{
+	((LiCAS_MULTIPATH_HEADER*)buffer)->pathID = (uint8_t)pathID;
+	if(pathID >= 0 && pathID < this->numPaths)
+		this->paths[pathID].numSent++;
+}
+
+
+/*
+ * Returns 1 if the buffer contains a data packet in an envelope of a path (always 0 with a single
+ * path)
+ */
+int LiCAS_ECI_Multipath::isWrapped(const char * buffer, int size)
+{
+	const LiCAS_MULTIPATH_HEADER * header = (const LiCAS_MULTIPATH_HEADER*)buffer;
+	
+	
+	if(this->numPaths < 2 || size <= (int)sizeof(LiCAS_MULTIPATH_HEADER) || size > MAX_MULTIPATH_PACKET_SIZE)
+		return 0;
+	
+	
+	return (header->packetID == LiCAS_PACKET_ID_MULTIPATH && header->pathID < this->numPaths && header->epoch != 0) ? 1 : 0;
+}
+
+
+/*
+ * Process a received envelope. Returns 1 if it is the first copy of the data packet.
+ *
+ * Parameters:
+ * 	(1) Envelope received
+ * 	(2) Size of the envelope
+ * 	(3) Time of reception in the clock of the receiver in [s]
+ */
+int LiCAS_ECI_Multipath::acceptPacket(const char * buffer, int size, double t)
+{
+	const LiCAS_MULTIPATH_HEADER * header = (const LiCAS_MULTIPATH_HEADER*)buffer;
+	LiCAS_ECI_PATH_STATISTICS * path = NULL;
+	uint32_t sequence = 0;
+	uint8_t pathBit = 0;
+	double latency = 0;
+	double delay = 0;
+	int32_t gap = 0;
+	int slot = 0;
+	int k = 0;
+	int n = 0;
+	
+	
+	if(size < (int)sizeof(LiCAS_MULTIPATH_HEADER) || header->pathID >= this->numPaths)
+		return -1;
+	sequence = header->sequence;
+	path = &this->paths[header->pathID];
+	pathBit = (uint8_t)(1 << header->pathID);
+	path->numReceived++;
+	
+	// New window if the sender restarted, whose time stamps may start again: the latency is measured again
+	if(this->flagWindowStarted == 0 || header->epoch != this->rxEpoch)
+	{
+		this->resetWindow(sequence);
+		this->rxEpoch = header->epoch;
+		this->flagLatencyOffset = 0;
+		bzero(this->latencySum, sizeof(this->latencySum));
+		bzero(this->numLatencies, sizeof(this->numLatencies));
+	}
+	
+	// One-way latency with the offset of the clocks
+	latency = t - header->timeStamp;
+	this->latencySum[header->pathID] += latency;
+	this->numLatencies[header->pathID]++;
+	if(this->flagLatencyOffset == 0 || latency < this->latencyOffset)
+	{
+		this->latencyOffset = latency;
+		this->flagLatencyOffset = 1;
+	}
+	
+	// Slide the window up to the sequence number received
+	gap = (int32_t)(sequence - this->newestSequence);
+	if(gap >= MULTIPATH_WINDOW)
+	{
+		// The data packets skipped beyond the window were not received over any path
+		for(slot = 0; slot < MULTIPATH_WINDOW; slot++)
+			this->evaluateSlot(slot);
+		for(k = 0; k < this->numPaths; k++)
+		{
+			this->numEvaluated[k] += gap - MULTIPATH_WINDOW;
+			this->paths[k].numLost += gap - MULTIPATH_WINDOW;
+		}
+		for(slot = 0; slot < MULTIPATH_WINDOW; slot++)
+		{
+			this->windowExpected[slot] = 1;
+			this->windowPaths[slot] = 0;
+		}
+		this->newestSequence = sequence;
+	}
+	else if(gap > 0)
+	{
+		for(n = 1; n <= gap; n++)
+		{
+			slot = (this->newestSequence + n) & (MULTIPATH_WINDOW - 1);
+			this->evaluateSlot(slot);
+			this->windowExpected[slot] = 1;
+			this->windowPaths[slot] = 0;
+		}
+		this->newestSequence = sequence;
+	}
+	else if(-gap >= MULTIPATH_WINDOW)
+	{
+		path->numLate++;
+		return 0;
+	}
+	
+	// First copy of the data packet
+	slot = sequence & (MULTIPATH_WINDOW - 1);
+	if(this->windowPaths[slot] == 0)
+	{
+		this->windowPaths[slot] = pathBit;
+		this->windowTime[slot] = t;
+		path->numFirst++;
+		return 1;
+	}
+	
+	// Copy received after the first one (of another path, or repeated by the network)
+	path->numDuplicates++;
+	if((this->windowPaths[slot] & pathBit) == 0)
+	{
+		this->windowPaths[slot] |= pathBit;
+		delay = 1e3*(t - this->windowTime[slot]);
+		this->delaySum[header->pathID] += delay;
+		this->numDelays[header->pathID]++;
+		if(delay > path->delayMax)
+			path->delayMax = (float)delay;
+	}
+	
+	
+	return 0;
+}
+
+
+/*
+ * Copy the statistics of the paths. Returns the number of paths.
+ */
+int LiCAS_ECI_Multipath::getStatistics(LiCAS_ECI_PATH_STATISTICS * pathStatistics)
+{
+	int k = 0;
+	
+	
+	for(k = 0; k < this->numPaths; k++)
+	{
+		pathStatistics[k] = this->paths[k];
+		pathStatistics[k].lossRate = (this->numEvaluated[k] > 0) ? (float)this->paths[k].numLost/this->numEvaluated[k] : 0;
+		if(this->numDelays[k] > 0)
+			pathStatistics[k].delayMean = (float)(this->delaySum[k]/this->numDelays[k]);
+		if(this->numLatencies[k] > 0)
+			pathStatistics[k].latencyMean = (float)(1e3*(this->latencySum[k]/this->numLatencies[k] - this->latencyOffset));
+	}
+	
+	
+	return this->numPaths;
+}
+
+
+/*
+ * Account the paths that did not receive the data packet of a slot leaving the window
+ */
+void LiCAS_ECI_Multipath::evaluateSlot(int slot)
+{
+	int k = 0;
+	
+	
+	if(this->windowExpected[slot] == 0)
+		return;
+	
+	for(k = 0; k < this->numPaths; k++)
+	{
+		this->numEvaluated[k]++;
+		if((this->windowPaths[slot] & (1 << k)) == 0)
+			this->paths[k].numLost++;
+	}
+}
+
+
+/*
+ * Start the window at a sequence number (first data packet, or sender restarted)
+ */
+void LiCAS_ECI_Multipath::resetWindow(uint32_t sequence)
+{
+	bzero(this->windowExpected, sizeof(this->windowExpected));
+	bzero(this->windowPaths, sizeof(this->windowPaths));
+	this->newestSequence = sequence - 1;
+	this->flagWindowStarted = 1;
+}
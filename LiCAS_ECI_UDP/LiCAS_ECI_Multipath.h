@@ -0,0 +1,180 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_Multipath.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Multipath redundant transport. Each data packet is sent over several paths (for example the Wi-Fi
+ * and a LTE or mesh radio link) inside an envelope with a sequence number, and the receiver delivers
+ * the first copy and discards the others, so the packet is lost only if it is lost in all the paths
+ * and its latency is the one of the fastest path. The sequence numbers received recently are kept in
+ * a window of fixed size, so the deduplication does not allocate memory, and the window starts
+ * again when the epoch of the sender changes (sender restarted). The copies received over each
+ * path give its loss rate and latency. With a single path the data packets are sent and received
+ * as they are, without envelope. It is used by the LiCAS ECI and by the computer board
+ * (LiCAS simulator).
+ *
+ * Example:
+ *
+ * 	size = multipath.wrapPacket(buffer, &dataPacket, sizeof(dataPacket), t);	// Sender
+ * 	...
+ * 	if(multipath.isWrapped(buffer, size) == 1 && multipath.acceptPacket(buffer, size, t) == 1)	// Receiver: first copy
+ * 		dispatch(buffer + sizeof(LiCAS_MULTIPATH_HEADER), size - sizeof(LiCAS_MULTIPATH_HEADER));
+ *
+ */
+
+#ifndef LICAS_ECI_MULTIPATH_H_
+#define LICAS_ECI_MULTIPATH_H_
+
+
+// Standard library
+#include <string.h>
+#include <stdint.h>
+
+
+// Specific library
+#include "LiCAS_ECI_Packets.h"
+
+
+// Constant definition
+#define MULTIPATH_WINDOW			64		// Sequence numbers tracked by the deduplication (power of 2)
+#define MAX_MULTIPATH_PACKET_SIZE	1024	// Maximum size of a data packet with its envelope in [bytes]
+
+static_assert(MAX_MULTIPATH_PATHS <= 8, "The paths of the deduplication window are stored as bits of one byte");
+
+
+// Statistics of each path of the multipath transport
+typedef struct
+{
+	uint64_t numSent;			// Copies sent over the path
+	uint64_t numReceived;		// Copies received over the path
+	uint64_t numFirst;			// Copies received before the ones of the other paths (delivered)
+	uint64_t numDuplicates;		// Copies discarded, received after the one of another path
+	uint64_t numLate;			// Copies discarded, older than the deduplication window
+	uint64_t numLost;			// Data packets not received over the path (evaluated when they leave the window)
+	float lossRate;				// Fraction of the data packets evaluated that were not received over the path
+	float delayMean;			// Mean delay of the copies received after the first copy of another path in [ms]
+	float delayMax;				// Maximum delay of the copies w.r.t. the first copy of each data packet in [ms]
+	float latencyMean;			// Mean one-way latency above the minimum of all the paths in [ms] (the clocks are not synchronized)
+} LiCAS_ECI_PATH_STATISTICS;
+
+
+class LiCAS_ECI_Multipath
+{
+public:
+
+	/*
+	 * Constructor
+	 * */
+	LiCAS_ECI_Multipath();
+	
+	
+	/*
+	 * Set the number of paths (up to MAX_MULTIPATH_PATHS, path 0 is the primary one). The
+	 * statistics of the new paths start from zero.
+	 */
+	int setNumPaths(int _numPaths);
+	
+	
+	/*
+	 * Number of paths
+	 */
+	int getNumPaths();
+	
+	
+	/*
+	 * Start the sequence numbers of the sender again with a new epoch, and the window of the
+	 * receiver (interface or computer board opened again). The statistics are kept.
+	 */
+	void restart();
+	
+	
+	/*
+	 * Put a data packet in an envelope with the next sequence number. Returns the size of the
+	 * envelope, or -1 if the data packet does not fit. The path of each copy is set with setPath().
+	 *
+	 * Parameters:
+	 * 	(1) Buffer of MAX_MULTIPATH_PACKET_SIZE bytes where the envelope is written
+	 * 	(2) Data packet
+	 * 	(3) Size of the data packet
+	 * 	(4) Time of sending in the clock of the sender in [s]
+	 */
+	int wrapPacket(char * buffer, const void * dataPacket, int packetSize, float timeStamp);
+	
+	
+	/*
+	 * Set the path of the copy of an envelope before sending it over the path, accounting it
+	 */
+	void setPath(char * buffer, int pathID);
+	
+	
+	/*
+	 * Returns 1 if the buffer contains a data packet in an envelope of a path. It is always 0 with a
+	 * single path, so a data packet whose first byte matches the identifier of the envelope (for
+	 * example a feedback data packet of a board not setting the packet ID) is not unwrapped.
+	 */
+	int isWrapped(const char * buffer, int size);
+	
+	
+	/*
+	 * Process a received envelope. Returns 1 if it is the first copy of the data packet (to be
+	 * delivered, it follows the header), 0 if it is discarded (duplicate or too late) or -1 if the
+	 * envelope is shorter than its header or the path is not valid. When the epoch of the sender
+	 * changes, the latency of the paths is measured again (the clock of the sender may restart).
+	 *
+	 * Parameters:
+	 * 	(1) Envelope received
+	 * 	(2) Size of the envelope
+	 * 	(3) Time of reception in the clock of the receiver in [s]
+	 */
+	int acceptPacket(const char * buffer, int size, double t);
+	
+	
+	/*
+	 * Copy the statistics of the paths. Returns the number of paths.
+	 */
+	int getStatistics(LiCAS_ECI_PATH_STATISTICS * pathStatistics);
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	int numPaths;
+	uint16_t txEpoch;
+	uint32_t txSequence;
+	
+	// Deduplication window (sequence number n in the position n & (MULTIPATH_WINDOW - 1))
+	uint8_t windowExpected[MULTIPATH_WINDOW];	// 1 if the data packet has been sent (a newer one has been received)
+	uint8_t windowPaths[MULTIPATH_WINDOW];		// Paths that received the data packet (one bit per path, 0 if not received)
+	double windowTime[MULTIPATH_WINDOW];		// Time of reception of the first copy
+	uint32_t newestSequence;
+	uint16_t rxEpoch;
+	int flagWindowStarted;
+	
+	// Latency offset (minimum difference between the reception and sending times)
+	double latencyOffset;
+	int flagLatencyOffset;
+	
+	LiCAS_ECI_PATH_STATISTICS paths[MAX_MULTIPATH_PATHS];
+	double delaySum[MAX_MULTIPATH_PATHS];
+	uint64_t numDelays[MAX_MULTIPATH_PATHS];	// Copies with a delay w.r.t. the first copy (first copy over the path)
+	double latencySum[MAX_MULTIPATH_PATHS];		// Latency of the copies received in the epoch of the sender
+	uint64_t numLatencies[MAX_MULTIPATH_PATHS];
+	uint64_t numEvaluated[MAX_MULTIPATH_PATHS];
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	
+	void evaluateSlot(int slot);
+	
+	void resetWindow(uint32_t sequence);
+};
+
+#endif
@@ -0,0 +1,214 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) through UDP sockets - LiCAS_ECI_Packets.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Definition of the C-style data packets exchanged through the UDP sockets between the LiCAS ECI
+ * and the LiCAS control program (or the LiCAS simulator), along with the control modes.
+ *
+ */
+
+#ifndef LICAS_ECI_PACKETS_H_
+#define LICAS_ECI_PACKETS_H_
+
+
+// Standard library
+#include <stdint.h>
+
+
+// Constant definition
+#define NUM_ARM_JOINTS	4	// Number of joints of each arm
+#define MAX_INPUT_AXES	8	// Maximum number of axes of an operator input device
+#define MAX_CHUNK_SETPOINTS	16	// Maximum number of setpoints of a trajectory chunk
+#define MAX_MULTIPATH_PATHS	4	// Maximum number of paths of the multipath redundant transport
+
+
+// NOTES
+// -----
+// Joint position in radians
+// Joint speed in rad/s
+// Joint torque in Nm
+// PWM (pulse width modulation) in [-1, 1] range
+// TCP position in m w.r.t. shoulder base joint
+// TCP velocity in m/s w.r.t. shoulder base joint
+// TCP force in N w.r.t. shoulder base joint
+
+static const uint8_t LiCAS_CONTROL_MODE_JOINT_POS = 1;		// Joint position control mode
+static const uint8_t LiCAS_CONTROL_MODE_JOINT_SPD = 2;		// Joint speed control mode
+static const uint8_t LiCAS_CONTROL_MODE_JOINT_TRQ = 3;		// Joint torque control mode
+static const uint8_t LiCAS_CONTROL_MODE_TCP_POS = 101;		// TCP position control mode
+static const uint8_t LiCAS_CONTROL_MODE_TCP_VEL = 102;		// TCP velocity control mode
+static const uint8_t LiCAS_CONTROL_MODE_TCP_FRC = 103;		// TCP force control mode
+
+static const uint8_t LiCAS_PACKET_ID_FEEDBACK = 1;			// Feedback data packet identifier
+static const uint8_t LiCAS_PACKET_ID_STATUS = 2;			// Status data packet identifier
+static const uint8_t LiCAS_PACKET_ID_DIAGNOSTICS = 3;		// Diagnostics data packet identifier
+static const uint8_t LiCAS_PACKET_ID_BASE_POSE = 4;			// Base pose data packet identifier (IMU/odometry)
+static const uint8_t LiCAS_PACKET_ID_OPERATOR_INPUT = 5;	// Operator input data packet identifier (joystick, haptic device, mocap)
+static const uint8_t LiCAS_PACKET_ID_TRAJECTORY_CHUNK = 6;	// Trajectory chunk data packet identifier (sent by the LiCAS ECI)
+static const uint8_t LiCAS_PACKET_ID_FEEDBACK_RATE = 7;		// Feedback rate request data packet identifier (sent by the LiCAS ECI)
+static const uint8_t LiCAS_PACKET_ID_FEEDBACK_RATE_ACK = 8;	// Feedback rate acknowledgment data packet identifier
+static const uint8_t LiCAS_PACKET_ID_MULTIPATH = 9;			// Multipath envelope identifier (data packet sent over several paths)
+
+// Channels of the feedback data packet (the channels not selected are sent as zero)
+static const uint8_t LiCAS_FEEDBACK_CHANNEL_TCP_POS = 0x01;		// pL, pR
+static const uint8_t LiCAS_FEEDBACK_CHANNEL_JOINT_POS = 0x02;	// qL, qR
+static const uint8_t LiCAS_FEEDBACK_CHANNEL_JOINT_SPD = 0x04;	// dqL, dqR
+static const uint8_t LiCAS_FEEDBACK_CHANNEL_JOINT_TRQ = 0x08;	// tauL, tauR
+static const uint8_t LiCAS_FEEDBACK_CHANNEL_PWM = 0x10;			// pwmL, pwmR
+static const uint8_t LiCAS_FEEDBACK_CHANNEL_ALL = 0x1F;
+
+static const uint8_t LiCAS_FEEDBACK_RATE_APPLIED = 0;		// The requested feedback rate has been applied
+static const uint8_t LiCAS_FEEDBACK_RATE_ADJUSTED = 1;		// The nearest feedback rate supported by the computer board has been applied
+
+
+typedef struct
+{
+	uint8_t mode;
+	float playTime;
+	float refLTCP[3];					// Reference value left arm TCP
+	float refRTCP[3];					// Reference value right arm TCP
+	float refLJ[NUM_ARM_JOINTS];		// Reference value left arm joints
+	float refRJ[NUM_ARM_JOINTS];		// Reference value right arm joints
+	float timeStamp;
+} __attribute__((packed)) LiCAS_CONTROL_REF_DATA_PACKET;
+
+
+typedef struct
+{
+	uint8_t packetID;
+	float pL[3];				// Cartesian position of left TCP in [m]
+	float pR[3];				// Cartesian position of right TCP in [m]
+	float qL[NUM_ARM_JOINTS];	// Joint position left arm in [rad]
+	float qR[NUM_ARM_JOINTS];	// Joint position right arm in [rad]
+	float dqL[NUM_ARM_JOINTS];	// Joint speed left arm in [rad/s]
+	float dqR[NUM_ARM_JOINTS];	// Joint speed right arm in [rad/s]]
+	float tauL[NUM_ARM_JOINTS];	// Joint torque left arm in [Nm]
+	float tauR[NUM_ARM_JOINTS];	// Joint torque right arm in [Nm]
+	float pwmL[NUM_ARM_JOINTS];	// PWM left arm joints in [-1, 1]
+	float pwmR[NUM_ARM_JOINTS];	// PWM right arm joints in [-1, 1]
+} __attribute__((packed)) LiCAS_FEEDBACK_DATA_PACKET;
+
+
+typedef struct
+{
+	uint8_t packetID;
+	uint8_t controlMode;		// Current control mode of the LiCAS control program
+	uint8_t armsEnabled;		// Bit 0: left arm enabled, bit 1: right arm enabled
+	uint8_t errorFlags;			// Error flags of the LiCAS control program (0 if no error)
+	float loopTime;				// Period of the control loop in [s]
+	float cpuLoad;				// CPU load of the computer board in [%]
+	float supplyVoltage;		// Supply voltage of the arms in [V]
+	float timeStamp;			// Time since the start of the LiCAS control program in [s]
+} __attribute__((packed)) LiCAS_STATUS_DATA_PACKET;
+
+
+typedef struct
+{
+	uint8_t packetID;
+	float servoTemperatureL[NUM_ARM_JOINTS];	// Temperature of the left arm servos in [C]
+	float servoTemperatureR[NUM_ARM_JOINTS];	// Temperature of the right arm servos in [C]
+	float servoVoltageL[NUM_ARM_JOINTS];		// Voltage of the left arm servos in [V]
+	float servoVoltageR[NUM_ARM_JOINTS];		// Voltage of the right arm servos in [V]
+	uint8_t servoErrorL[NUM_ARM_JOINTS];		// Error flags of the left arm servos (0 if no error)
+	uint8_t servoErrorR[NUM_ARM_JOINTS];		// Error flags of the right arm servos (0 if no error)
+} __attribute__((packed)) LiCAS_DIAGNOSTICS_DATA_PACKET;
+
+
+// Pose of the base of the arms (aerial platform) given by the IMU/odometry of the platform
+typedef struct
+{
+	uint8_t packetID;
+	uint32_t sequence;			// Sequence number of the sample
+	float timeStamp;			// Time of the measurement in the clock of the publisher in [s]
+	float age;					// Time from the measurement to the sending of the packet in [s]
+	float position[3];			// Position of the base in the world frame in [m]
+	float orientation[4];		// Orientation of the base in the world frame (quaternion w, x, y, z)
+	float velocity[3];			// Linear velocity of the base in the world frame in [m/s]
+	float angularVelocity[3];	// Angular velocity of the base in the base frame in [rad/s]
+} __attribute__((packed)) LiCAS_BASE_POSE_DATA_PACKET;
+
+
+// Sample of an operator input device (joystick, haptic device, motion capture marker)
+typedef struct
+{
+	uint8_t packetID;
+	uint8_t deviceID;				// Identifier of the input device
+	uint8_t numAxes;				// Number of axes of the sample (up to MAX_INPUT_AXES)
+	uint32_t sequence;				// Sequence number of the sample
+	float timeStamp;				// Time of the sample in the clock of the device in [s]
+	float axes[MAX_INPUT_AXES];		// Value of each axis (joystick axes, position of a haptic pen or marker...)
+	uint32_t buttons;				// State of the buttons (one bit per button)
+} __attribute__((packed)) LiCAS_OPERATOR_INPUT_DATA_PACKET;
+
+
+// Timed setpoint of a trajectory chunk
+typedef struct
+{
+	float t;						// Time of the setpoint in the clock of the LiCAS ECI in [s]
+	float refL[NUM_ARM_JOINTS];		// Reference value left arm (joints, or TCP in the first 3 values)
+	float refR[NUM_ARM_JOINTS];		// Reference value right arm (joints, or TCP in the first 3 values)
+} __attribute__((packed)) LiCAS_TRAJECTORY_SETPOINT;
+
+
+// Future setpoints of a trajectory, buffered by the computer board and followed at their time. The
+// chunks sent in consecutive periods overlap, so a setpoint lost in one chunk arrives in the next ones.
+typedef struct
+{
+	uint8_t packetID;
+	uint8_t mode;					// LiCAS_CONTROL_MODE_JOINT_POS or LiCAS_CONTROL_MODE_TCP_POS
+	uint8_t numSetpoints;			// Number of setpoints of the chunk (up to MAX_CHUNK_SETPOINTS)
+	uint16_t trajectoryID;			// Identifier of the trajectory (a new one discards the buffered setpoints)
+	uint32_t firstIndex;			// Index of the first setpoint of the chunk in the trajectory
+	float timeStamp;				// Time of sending in the clock of the LiCAS ECI in [s]
+	LiCAS_TRAJECTORY_SETPOINT setpoints[MAX_CHUNK_SETPOINTS];
+} __attribute__((packed)) LiCAS_TRAJECTORY_CHUNK_DATA_PACKET;
+
+
+// Request of the rate and channels of the feedback data packet, sent by the LiCAS ECI until it is acknowledged
+typedef struct
+{
+	uint8_t packetID;
+	uint8_t channels;				// Channels of the feedback data packet (LiCAS_FEEDBACK_CHANNEL_...)
+	uint16_t sequence;				// Sequence number of the request
+	float rate;						// Requested rate of the feedback data packet in [Hz]
+	float timeStamp;				// Time of sending in the clock of the LiCAS ECI in [s]
+} __attribute__((packed)) LiCAS_FEEDBACK_RATE_DATA_PACKET;
+
+
+// Acknowledgment of a feedback rate request, sent by the computer board before the first feedback data
+// packet at the new rate
+typedef struct
+{
+	uint8_t packetID;
+	uint8_t channels;				// Channels of the feedback data packet applied
+	uint8_t result;					// LiCAS_FEEDBACK_RATE_APPLIED or LiCAS_FEEDBACK_RATE_ADJUSTED
+	uint16_t sequence;				// Sequence number of the request acknowledged
+	float rate;						// Rate of the feedback data packet applied in [Hz]
+	float timeStamp;				// Time since the start of the LiCAS control program in [s]
+} __attribute__((packed)) LiCAS_FEEDBACK_RATE_ACK_DATA_PACKET;
+
+
+// Envelope of a data packet sent over several paths (multipath redundant transport), followed by the
+// data packet. All the copies of a data packet have the same sequence number, so the receiver
+// delivers the first copy received and discards the others. The epoch changes when the sender
+// restarts its sequence numbers, so the receiver starts its window again.
+typedef struct
+{
+	uint8_t packetID;				// LiCAS_PACKET_ID_MULTIPATH
+	uint8_t pathID;					// Path of the copy (0: primary path)
+	uint16_t epoch;					// Epoch of the sequence numbers of the sender
+	uint32_t sequence;				// Sequence number of the data packet
+	float timeStamp;				// Time of sending in the clock of the sender in [s]
+} __attribute__((packed)) LiCAS_MULTIPATH_HEADER;
+
+#endif
+
@@ -0,0 +1,308 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_Reactor.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Event reactor over epoll. The epoll data of each descriptor points to its entry in the table,
+ * while the internal eventfd used for stopping the thread is registered with a NULL pointer.
+ *
+ */
+
+#include "LiCAS_ECI_Reactor.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_ECI_Reactor::LiCAS_ECI_Reactor(const std::string &_reactorName)
+{
+	struct epoll_event event;
+	int k = 0;
+	
+	
+	this->reactorName = _reactorName;
+	this->flagReactorThreadRunning = 0;
+	this->flagTerminateReactorThread = 0;
+	this->threadAccounting = NULL;
+	for(k = 0; k < MAX_REACTOR_DESCRIPTORS; k++)
+	{
+		this->descriptors[k].fd = -1;
+		this->descriptors[k].callback = NULL;
+		this->descriptors[k].userData = NULL;
+	}
+	
+	this->epollFd = epoll_create1(EPOLL_CLOEXEC);
+	this->wakeupEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if(this->epollFd >= 0 && this->wakeupEventFd >= 0)
+	{
+		bzero(&event, sizeof(event));
+		event.events = EPOLLIN;
+		event.data.ptr = NULL;
+		epoll_ctl(this->epollFd, EPOLL_CTL_ADD, this->wakeupEventFd, &event);
+	}
+}
+
+
+/*
+ * Destructor
+ * */
+LiCAS_ECI_Reactor::~LiCAS_ECI_Reactor()
+{
+	this->stop();
+	if(this->wakeupEventFd >= 0)
+		close(this->wakeupEventFd);
+	if(this->epollFd >= 0)
+		close(this->epollFd);
+}
+
+
+/*
+ * Add a descriptor to the reactor.
+ *
+ * Parameters:
+ * 	(1) File descriptor
+ * 	(2) epoll events (typically EPOLLIN)
+ * 	(3) Callback executed when the descriptor is ready
+ * 	(4) User data passed to the callback
+ */
+int LiCAS_ECI_Reactor::addDescriptor(int fd, uint32_t events, LiCAS_ECI_ReactorCallback callback, void * userData)
+{
+	struct epoll_event event;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	// Find a free entry of the table
+	while(k < MAX_REACTOR_DESCRIPTORS && this->descriptors[k].fd >= 0)
+		k++;
+	
+	if(this->epollFd < 0 || fd < 0 || callback == NULL)
+		errorCode = 1;
+	else if(k == MAX_REACTOR_DESCRIPTORS)
+		errorCode = 2;
+	else
+	{
+		this->descriptors[k].fd = fd;
+		this->descriptors[k].events = events;
+		this->descriptors[k].callback = callback;
+		this->descriptors[k].userData = userData;
+		
+		bzero(&event, sizeof(event));
+		event.events = events;
+		event.data.ptr = &this->descriptors[k];
+		if(epoll_ctl(this->epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+		{
+			errorCode = 3;
+			this->descriptors[k].fd = -1;
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Remove a descriptor from the reactor
+ */
+int LiCAS_ECI_Reactor::removeDescriptor(int fd)
+{
+	int errorCode = 1;
+	int k = 0;
+	
+	
+	for(k = 0; k < MAX_REACTOR_DESCRIPTORS; k++)
+	{
+		if(fd >= 0 && this->descriptors[k].fd == fd)
+		{
+			epoll_ctl(this->epollFd, EPOLL_CTL_DEL, fd, NULL);
+			this->descriptors[k].fd = -1;
+			this->descriptors[k].callback = NULL;
+			errorCode = 0;
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Wait until any of the descriptors is ready and execute their callbacks. Returns the number of
+ * callbacks executed, or -1 on error.
+ *
+ * Parameters:
+ * 	(1) Timeout in [ms] (-1: wait indefinitely)
+ */
+int LiCAS_ECI_Reactor::runOnce(int timeout_ms)
+{
+	struct epoll_event events[MAX_REACTOR_DESCRIPTORS + 1];
+	REACTOR_DESCRIPTOR * descriptor = NULL;
+	uint64_t eventValue = 0;
+	int numCallbacks = 0;
+	int numEvents = 0;
+	int k = 0;
+	
+	
+	numEvents = epoll_wait(this->epollFd, events, MAX_REACTOR_DESCRIPTORS + 1, timeout_ms);
+	if(numEvents < 0)
+		numCallbacks = (errno == EINTR) ? 0 : -1;
+	
+	for(k = 0; k < numEvents; k++)
+	{
+		descriptor = (REACTOR_DESCRIPTOR*)events[k].data.ptr;
+		if(descriptor == NULL)
+		{
+			if(read(this->wakeupEventFd, &eventValue, sizeof(eventValue)) < 0)
+				eventValue = 0;
+		}
+		else if(descriptor->fd >= 0 && descriptor->callback != NULL)
+		{
+			descriptor->callback(descriptor->fd, events[k].events, descriptor->userData);
+			numCallbacks++;
+		}
+	}
+	
+	
+	return numCallbacks;
+}
+
+
+/*
+ * Start the reactor thread.
+ *
+ * Parameters:
+ * 	(1) SCHED_FIFO priority of the thread (0: default scheduling policy)
+ */
+int LiCAS_ECI_Reactor::start(int rtPriority)
+{
+	struct sched_param schedParam;
+	int errorCode = 0;
+	
+	
+	if(this->epollFd < 0 || this->wakeupEventFd < 0)
+		errorCode = 1;
+	else if(this->flagReactorThreadRunning == 0)
+	{
+		this->flagTerminateReactorThread = 0;
+		if(pthread_create(&reactorThread, NULL, &LiCAS_ECI_Reactor::reactorThreadEntry, this) != 0)
+			errorCode = 1;
+		else
+		{
+			this->flagReactorThreadRunning = 1;
+			pthread_setname_np(this->reactorThread, this->reactorName.substr(0, 15).c_str());
+			if(rtPriority > 0)
+			{
+				bzero(&schedParam, sizeof(schedParam));
+				schedParam.sched_priority = rtPriority;
+				if(pthread_setschedparam(this->reactorThread, SCHED_FIFO, &schedParam) != 0)
+					errorCode = 2;
+			}
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Stop the reactor thread
+ */
+int LiCAS_ECI_Reactor::stop()
+{
+	uint64_t eventValue = 1;
+	int errorCode = 0;
+	
+	
+	if(this->flagReactorThreadRunning == 1)
+	{
+		this->flagTerminateReactorThread = 1;
+		if(write(this->wakeupEventFd, &eventValue, sizeof(eventValue)) == sizeof(eventValue))
+			pthread_join(this->reactorThread, NULL);
+		else
+		{
+			errorCode = 1;
+			pthread_cancel(this->reactorThread);
+		}
+		this->flagReactorThreadRunning = 0;
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Returns 1 if the reactor thread is running
+ */
+int LiCAS_ECI_Reactor::isRunning()
+{
+	return this->flagReactorThreadRunning;
+}
+
+
+/*
+ * Set the accounting of the CPU usage and wake-up latency of the reactor thread
+ *
+ * Parameters:
+ * 	(1) Thread accounting (NULL for no accounting)
+ */
+void LiCAS_ECI_Reactor::setThreadAccounting(LiCAS_ECI_ThreadAccounting * _threadAccounting)
+{
+	this->threadAccounting = _threadAccounting;
+}
+
+
+/*
+ * Returns the accounting of the reactor thread (NULL if it is not accounted)
+ */
+LiCAS_ECI_ThreadAccounting * LiCAS_ECI_Reactor::getThreadAccounting()
+{
+	return this->threadAccounting;
+}
+
+
+/*
+ * Entry point of the reactor thread
+ */
+void * LiCAS_ECI_Reactor::reactorThreadEntry(void * arg)
+{
+	((LiCAS_ECI_Reactor*)arg)->reactorThreadFunction();
+	
+	
+	return NULL;
+}
+
+
+void LiCAS_ECI_Reactor::reactorThreadFunction()
+{
+	int threadIndex = -1;
+	
+	
+	// The reactor thread is registered by itself, so the callbacks find its entry
+	if(this->threadAccounting != NULL)
+		threadIndex = this->threadAccounting->getThreadIndex(this->reactorName.c_str(), 0);
+	
+	/******************************** THREAD LOOP START ********************************/
+	
+	while(this->flagTerminateReactorThread == 0)
+	{
+		// With accounting, the CPU usage is sampled at least once per second even without events
+		if(this->runOnce((this->threadAccounting != NULL) ? 1000 : -1) < 0)
+			break;
+		if(this->threadAccounting != NULL)
+			this->threadAccounting->updateCpuStatistics(threadIndex);
+	}
+	
+	/******************************** THREAD LOOP END ********************************/
+}
+
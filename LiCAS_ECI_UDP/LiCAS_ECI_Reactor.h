@@ -0,0 +1,167 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_Reactor.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Event reactor over epoll. A single thread sleeps on a set of file descriptors (sockets, timerfd,
+ * eventfd...) and calls the callback associated to each descriptor when it becomes ready, so
+ * several periodic and I/O activities share one thread without polling. The descriptors are kept
+ * in a fixed size table: registering them does not allocate memory. The descriptors must be added
+ * before start() or from a callback executed by the reactor thread.
+ *
+ */
+
+#ifndef LICAS_ECI_REACTOR_H_
+#define LICAS_ECI_REACTOR_H_
+
+
+// Standard library
+#include <string>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "LiCAS_ECI_ThreadAccounting.h"
+
+
+// Constant definition
+#define MAX_REACTOR_DESCRIPTORS	16	// Maximum number of descriptors of the reactor
+
+
+// Callback executed when a descriptor is ready (events: EPOLLIN, EPOLLERR...)
+typedef void (*LiCAS_ECI_ReactorCallback)(int fd, uint32_t events, void * userData);
+
+
+class LiCAS_ECI_Reactor
+{
+public:
+
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Name of the reactor thread (up to 15 characters)
+	 * */
+	LiCAS_ECI_Reactor(const std::string &_reactorName);
+	
+	
+	/*
+	 * Destructor
+	 * */
+	virtual ~LiCAS_ECI_Reactor();
+	
+	
+	/*
+	 * Add a descriptor to the reactor.
+	 *
+	 * Parameters:
+	 * 	(1) File descriptor
+	 * 	(2) epoll events (typically EPOLLIN)
+	 * 	(3) Callback executed when the descriptor is ready
+	 * 	(4) User data passed to the callback
+	 */
+	int addDescriptor(int fd, uint32_t events, LiCAS_ECI_ReactorCallback callback, void * userData);
+	
+	
+	/*
+	 * Remove a descriptor from the reactor
+	 */
+	int removeDescriptor(int fd);
+	
+	
+	/*
+	 * Wait until any of the descriptors is ready and execute their callbacks. Returns the number of
+	 * callbacks executed, or -1 on error.
+	 *
+	 * Parameters:
+	 * 	(1) Timeout in [ms] (-1: wait indefinitely)
+	 */
+	int runOnce(int timeout_ms);
+	
+	
+	/*
+	 * Start the reactor thread.
+	 *
+	 * Parameters:
+	 * 	(1) SCHED_FIFO priority of the thread (0: default scheduling policy). If the priority can
+	 * 	    not be set, the thread runs with the default policy and the function returns 2.
+	 */
+	int start(int rtPriority);
+	
+	
+	/*
+	 * Stop the reactor thread
+	 */
+	int stop();
+	
+	
+	/*
+	 * Returns 1 if the reactor thread is running
+	 */
+	int isRunning();
+	
+	
+	/*
+	 * Set the accounting of the CPU usage and wake-up latency of the reactor thread, shared with
+	 * the callbacks executed by the reactor (NULL: not accounted). It must be set before start().
+	 *
+	 * Parameters:
+	 * 	(1) Thread accounting (NULL for no accounting)
+	 */
+	void setThreadAccounting(LiCAS_ECI_ThreadAccounting * _threadAccounting);
+	
+	
+	/*
+	 * Returns the accounting of the reactor thread (NULL if it is not accounted)
+	 */
+	LiCAS_ECI_ThreadAccounting * getThreadAccounting();
+
+
+private:
+
+	// Entry of the descriptors table
+	typedef struct
+	{
+		int fd;
+		uint32_t events;
+		LiCAS_ECI_ReactorCallback callback;
+		void * userData;
+	} REACTOR_DESCRIPTOR;
+	
+	
+	/***************** PRIVATE VARIABLES *****************/
+	std::string reactorName;
+	
+	int epollFd;
+	int wakeupEventFd;
+	
+	REACTOR_DESCRIPTOR descriptors[MAX_REACTOR_DESCRIPTORS];
+	
+	pthread_t reactorThread;
+	int flagReactorThreadRunning;
+	int flagTerminateReactorThread;
+	
+	LiCAS_ECI_ThreadAccounting * threadAccounting;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	
+	static void * reactorThreadEntry(void * arg);
+	
+	void reactorThreadFunction();
+};
+
+#endif
+
@@ -0,0 +1,511 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_Scheduler.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Multi-rate scheduler of periodic tasks. The timer ticks are numbered from the start of the
+ * scheduler, and a rate group with a period of N ticks is released in the ticks multiple of N. If
+ * the reactor is delayed, the timerfd reports several expirations in a single read: the due groups
+ * are executed once, and the lost releases are accounted as skipped.
+ *
+ */
+
+#include "LiCAS_ECI_Scheduler.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_ECI_Scheduler::LiCAS_ECI_Scheduler(LiCAS_ECI_Reactor * _reactor)
+{
+	int k = 0;
+	
+	
+	this->reactor = _reactor;
+	this->numGroups = 0;
+	this->numTasks = 0;
+	this->timerFd = -1;
+	this->basePeriod = 0;
+	this->tickCount = 0;
+	this->numMissedTicks = 0;
+	this->flagStarted = 0;
+	this->workerEventFd = -1;
+	this->flagWorkerThreadRunning = 0;
+	this->flagTerminateWorkerThread = 0;
+	bzero(&t_start, sizeof(t_start));
+	for(k = 0; k < MAX_RATE_GROUPS; k++)
+	{
+		this->groups[k].numTasks = 0;
+		this->groups[k].flagPending.store(0);
+		this->groupOrder[k] = k;
+	}
+}
+
+
+/*
+ * Destructor
+ * */
+LiCAS_ECI_Scheduler::~LiCAS_ECI_Scheduler()
+{
+	this->stop();
+}
+
+
+/*
+ * Add a rate group. Returns the index of the group, or -1 on error.
+ *
+ * Parameters:
+ * 	(1) Period of the group in [s]
+ * 	(2) Execute the tasks of the group in the worker thread (1) or in the reactor thread (0)
+ */
+int LiCAS_ECI_Scheduler::addRateGroup(float period, int flagOffload)
+{
+	int group = -1;
+	
+	
+	if(this->flagStarted == 0 && this->numGroups < MAX_RATE_GROUPS && period > 0)
+	{
+		group = this->numGroups;
+		this->groups[group].period = period;
+		this->groups[group].flagOffload = (flagOffload != 0) ? 1 : 0;
+		this->groups[group].divider = 1;
+		this->groups[group].numTasks = 0;
+		this->groups[group].t_release = 0;
+		this->numGroups++;
+	}
+	
+	
+	return group;
+}
+
+
+/*
+ * Add a task to a rate group. Returns the index of the task, or -1 on error.
+ *
+ * Parameters:
+ * 	(1) Index of the rate group
+ * 	(2) Name of the task (up to 15 characters)
+ * 	(3) Task function
+ * 	(4) User data passed to the task function
+ * 	(5) Priority of the task within the group (the higher, the earlier executed)
+ */
+int LiCAS_ECI_Scheduler::addTask(int group, const char * name, LiCAS_ECI_TaskFunction function, void * userData, int priority)
+{
+	RATE_GROUP * rateGroup = NULL;
+	int task = -1;
+	int k = 0;
+	
+	
+	if(this->flagStarted == 0 && group >= 0 && group < this->numGroups && function != NULL && this->numTasks < MAX_SCHEDULER_TASKS)
+	{
+		task = this->numTasks;
+		this->tasks[task].function = function;
+		this->tasks[task].userData = userData;
+		bzero(&this->tasks[task].statistics, sizeof(LiCAS_ECI_TASK_STATISTICS));
+		snprintf(this->tasks[task].statistics.name, sizeof(this->tasks[task].statistics.name), "%s", name);
+		this->tasks[task].statistics.group = group;
+		this->tasks[task].statistics.priority = priority;
+		this->tasks[task].statistics.period = this->groups[group].period;
+		this->tasks[task].statistics.flagOffload = this->groups[group].flagOffload;
+		this->numTasks++;
+		
+		// Insert the task in the group keeping the decreasing order of priority
+		rateGroup = &this->groups[group];
+		k = rateGroup->numTasks;
+		while(k > 0 && this->tasks[rateGroup->tasks[k - 1]].statistics.priority < priority)
+		{
+			rateGroup->tasks[k] = rateGroup->tasks[k - 1];
+			k--;
+		}
+		rateGroup->tasks[k] = task;
+		rateGroup->numTasks++;
+	}
+	
+	
+	return task;
+}
+
+
+/*
+ * Check that the periods of the rate groups are harmonic, start the worker thread if any group is
+ * offloaded and register the timer in the reactor.
+ */
+int LiCAS_ECI_Scheduler::start()
+{
+	struct itimerspec timerSpec;
+	int flagOffload = 0;
+	double ratio = 0;
+	int errorCode = 0;
+	int g = 0;
+	int k = 0;
+	
+	
+	if(this->flagStarted == 1 || this->numTasks == 0)
+		errorCode = 1;
+	else
+	{
+		// Sort the groups by increasing period
+		for(k = 0; k < this->numGroups; k++)
+		{
+			g = k;
+			while(g > 0 && this->groups[this->groupOrder[g - 1]].period > this->groups[k].period)
+			{
+				this->groupOrder[g] = this->groupOrder[g - 1];
+				g--;
+			}
+			this->groupOrder[g] = k;
+		}
+		
+		// Each period must be an integer multiple of the next faster one
+		this->basePeriod = this->groups[this->groupOrder[0]].period;
+		for(k = 0; k < this->numGroups; k++)
+		{
+			g = this->groupOrder[k];
+			if(k > 0)
+			{
+				ratio = this->groups[g].period/this->groups[this->groupOrder[k - 1]].period;
+				if(fabs(ratio - round(ratio)) > HARMONIC_PERIOD_TOL*ratio)
+					errorCode = 2;
+			}
+			this->groups[g].divider = (int)round(this->groups[g].period/this->basePeriod);
+			this->groups[g].flagPending.store(0);
+			if(this->groups[g].flagOffload == 1 && this->groups[g].numTasks > 0)
+				flagOffload = 1;
+		}
+	}
+	
+	// Worker thread of the offloaded groups
+	if(errorCode == 0 && flagOffload == 1)
+	{
+		this->workerEventFd = eventfd(0, EFD_CLOEXEC);
+		this->flagTerminateWorkerThread = 0;
+		if(this->workerEventFd < 0 || pthread_create(&workerThread, NULL, &LiCAS_ECI_Scheduler::workerThreadEntry, this) != 0)
+			errorCode = 4;
+		else
+		{
+			this->flagWorkerThreadRunning = 1;
+			pthread_setname_np(this->workerThread, "eci_worker");
+		}
+	}
+	
+	// The first tick is released one base period after the start
+	if(errorCode == 0)
+	{
+		this->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		clock_gettime(CLOCK_MONOTONIC, &t_start);
+		t_start.tv_nsec += (long)(1e9*this->basePeriod);
+		while(t_start.tv_nsec >= 1000000000L)
+		{
+			t_start.tv_nsec -= 1000000000L;
+			t_start.tv_sec++;
+		}
+		this->tickCount = 0;
+		this->numMissedTicks = 0;
+		
+		timerSpec.it_value = t_start;
+		timerSpec.it_interval.tv_sec = (time_t)this->basePeriod;
+		timerSpec.it_interval.tv_nsec = (long)(1e9*(this->basePeriod - timerSpec.it_interval.tv_sec));
+		if(this->timerFd < 0 || timerfd_settime(this->timerFd, TFD_TIMER_ABSTIME, &timerSpec, NULL) != 0 || this->reactor->addDescriptor(this->timerFd, EPOLLIN, &LiCAS_ECI_Scheduler::timerCallback, this) != 0)
+			errorCode = 3;
+		else
+			this->flagStarted = 1;
+	}
+	
+	if(errorCode != 0 && errorCode != 1)
+	{
+		if(this->timerFd >= 0)
+		{
+			close(this->timerFd);
+			this->timerFd = -1;
+		}
+		this->flagStarted = 1;
+		this->stop();
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Unregister the timer and stop the worker thread. Call it after stopping the reactor thread.
+ */
+int LiCAS_ECI_Scheduler::stop()
+{
+	uint64_t eventValue = 1;
+	int errorCode = 0;
+	
+	
+	if(this->flagStarted == 1)
+	{
+		if(this->timerFd >= 0)
+		{
+			this->reactor->removeDescriptor(this->timerFd);
+			close(this->timerFd);
+			this->timerFd = -1;
+		}
+		
+		if(this->flagWorkerThreadRunning == 1)
+		{
+			this->flagTerminateWorkerThread = 1;
+			if(write(this->workerEventFd, &eventValue, sizeof(eventValue)) == sizeof(eventValue))
+				pthread_join(this->workerThread, NULL);
+			else
+			{
+				errorCode = 1;
+				pthread_cancel(this->workerThread);
+			}
+			this->flagWorkerThreadRunning = 0;
+		}
+		if(this->workerEventFd >= 0)
+		{
+			close(this->workerEventFd);
+			this->workerEventFd = -1;
+		}
+		
+		this->flagStarted = 0;
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Period of the timer (period of the fastest rate group) in [s]
+ */
+float LiCAS_ECI_Scheduler::getBasePeriod()
+{
+	return this->basePeriod;
+}
+
+
+/*
+ * Number of timer ticks elapsed without being processed
+ */
+uint64_t LiCAS_ECI_Scheduler::getNumMissedTicks()
+{
+	return this->numMissedTicks;
+}
+
+
+/*
+ * Number of tasks of the scheduler
+ */
+int LiCAS_ECI_Scheduler::getNumTasks()
+{
+	return this->numTasks;
+}
+
+
+/*
+ * Get the statistics of a task
+ */
+int LiCAS_ECI_Scheduler::getTaskStatistics(int task, LiCAS_ECI_TASK_STATISTICS * _statistics)
+{
+	int errorCode = 0;
+	
+	
+	if(task < 0 || task >= this->numTasks)
+		errorCode = 1;
+	else
+		*_statistics = this->tasks[task].statistics;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Callback of the timer, executed by the reactor thread
+ */
+void LiCAS_ECI_Scheduler::timerCallback(int fd, uint32_t, void * userData)
+{
+	uint64_t numExpirations = 0;
+	
+	
+	if(read(fd, &numExpirations, sizeof(numExpirations)) == sizeof(numExpirations) && numExpirations > 0)
+		((LiCAS_ECI_Scheduler*)userData)->processTick(numExpirations);
+}
+
+
+/*
+ * Release the rate groups due in the ticks elapsed since the last call
+ */
+void LiCAS_ECI_Scheduler::processTick(uint64_t numExpirations)
+{
+	RATE_GROUP * rateGroup = NULL;
+	LiCAS_ECI_ThreadAccounting * threadAccounting = this->reactor->getThreadAccounting();
+	uint64_t firstTick = this->tickCount;
+	uint64_t lastTick = this->tickCount + numExpirations - 1;
+	uint64_t numReleases = 0;
+	uint64_t eventValue = 1;
+	int flagNotifyWorker = 0;
+	int g = 0;
+	int k = 0;
+	
+	
+	// Wake-up latency of the reactor thread w.r.t. the last tick
+	if(threadAccounting != NULL)
+		threadAccounting->updateWakeupLatency(threadAccounting->findThread(), this->getElapsedTime() - (double)lastTick*this->basePeriod);
+	
+	this->tickCount += numExpirations;
+	this->numMissedTicks += numExpirations - 1;
+	
+	for(g = 0; g < this->numGroups; g++)
+	{
+		rateGroup = &this->groups[this->groupOrder[g]];
+		
+		// Number of ticks multiple of the group period since the last call
+		numReleases = lastTick/rateGroup->divider - (firstTick + rateGroup->divider - 1)/rateGroup->divider + 1;
+		if(numReleases == 0 || rateGroup->numTasks == 0)
+			continue;
+		
+		// An offloaded group still running when released again skips this release
+		if(rateGroup->flagOffload == 1 && rateGroup->flagPending.load(std::memory_order_acquire) == 1)
+			numReleases++;
+		else
+		{
+			rateGroup->t_release = (double)(lastTick - lastTick % rateGroup->divider)*this->basePeriod;
+			if(rateGroup->flagOffload == 1)
+			{
+				rateGroup->flagPending.store(1, std::memory_order_release);
+				flagNotifyWorker = 1;
+			}
+			else
+				this->executeGroup(this->groupOrder[g]);
+		}
+		for(k = 0; k < rateGroup->numTasks; k++)
+			this->tasks[rateGroup->tasks[k]].statistics.numSkippedReleases += numReleases - 1;
+	}
+	
+	if(flagNotifyWorker == 1 && write(this->workerEventFd, &eventValue, sizeof(eventValue)) != sizeof(eventValue))
+	{
+		for(g = 0; g < this->numGroups; g++)
+			this->groups[g].flagPending.store(0, std::memory_order_release);
+	}
+}
+
+
+/*
+ * Execute the tasks of a rate group in decreasing order of priority
+ */
+void LiCAS_ECI_Scheduler::executeGroup(int group)
+{
+	RATE_GROUP * rateGroup = &this->groups[group];
+	LiCAS_ECI_TASK_STATISTICS * stats = NULL;
+	double deadline = rateGroup->t_release + rateGroup->period;
+	double t_begin = 0;
+	double t_end = 0;
+	float jitter = 0;
+	float executionTime = 0;
+	int k = 0;
+	
+	
+	for(k = 0; k < rateGroup->numTasks; k++)
+	{
+		stats = &this->tasks[rateGroup->tasks[k]].statistics;
+		
+		t_begin = this->getElapsedTime();
+		this->tasks[rateGroup->tasks[k]].function(this->tasks[rateGroup->tasks[k]].userData);
+		t_end = this->getElapsedTime();
+		
+		executionTime = 1e6*(t_end - t_begin);
+		jitter = 1e6*(t_begin - rateGroup->t_release);
+		stats->numExecutions++;
+		stats->executionTimeMean += (executionTime - stats->executionTimeMean)/stats->numExecutions;
+		if(executionTime > stats->executionTimeMax)
+			stats->executionTimeMax = executionTime;
+		if(jitter > stats->releaseJitterMax)
+			stats->releaseJitterMax = jitter;
+		if(t_end > deadline)
+			stats->numOverruns++;
+	}
+}
+
+
+/*
+ * Entry point of the worker thread
+ */
+void * LiCAS_ECI_Scheduler::workerThreadEntry(void * arg)
+{
+	((LiCAS_ECI_Scheduler*)arg)->workerThreadFunction();
+	
+	
+	return NULL;
+}
+
+
+void LiCAS_ECI_Scheduler::workerThreadFunction()
+{
+	LiCAS_ECI_ThreadAccounting * threadAccounting = this->reactor->getThreadAccounting();
+	uint64_t eventValue = 0;
+	double t_release = 0;
+	int threadIndex = -1;
+	int g = 0;
+	
+	
+	// The worker thread is accounted along with the reactor thread
+	if(threadAccounting != NULL)
+		threadIndex = threadAccounting->getThreadIndex("eci_worker", 0);
+	
+	/******************************** THREAD LOOP START ********************************/
+	
+	while(this->flagTerminateWorkerThread == 0)
+	{
+		// Sleep until an offloaded group is released
+		if(read(this->workerEventFd, &eventValue, sizeof(eventValue)) == sizeof(eventValue))
+		{
+			// Wake-up latency w.r.t. the last release of the pending groups (none on termination)
+			if(threadAccounting != NULL)
+			{
+				t_release = -1;
+				for(g = 0; g < this->numGroups; g++)
+				{
+					if(this->groups[g].flagPending.load(std::memory_order_acquire) == 1 && this->groups[g].t_release > t_release)
+						t_release = this->groups[g].t_release;
+				}
+				if(t_release >= 0)
+					threadAccounting->updateWakeupLatency(threadIndex, this->getElapsedTime() - t_release);
+			}
+			
+			for(g = 0; g < this->numGroups && this->flagTerminateWorkerThread == 0; g++)
+			{
+				if(this->groups[this->groupOrder[g]].flagPending.load(std::memory_order_acquire) == 1)
+				{
+					this->executeGroup(this->groupOrder[g]);
+					this->groups[this->groupOrder[g]].flagPending.store(0, std::memory_order_release);
+				}
+			}
+			
+			if(threadAccounting != NULL)
+				threadAccounting->updateCpuStatistics(threadIndex);
+		}
+	}
+	
+	/******************************** THREAD LOOP END ********************************/
+}
+
+
+/*
+ * Elapsed time since the first tick of the scheduler in [s]
+ */
+double LiCAS_ECI_Scheduler::getElapsedTime()
+{
+	struct timespec t;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	
+	
+	return (double)(t.tv_sec - t_start.tv_sec) + 1e-9*(t.tv_nsec - t_start.tv_nsec);
+}
+
@@ -0,0 +1,232 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_Scheduler.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Multi-rate scheduler of periodic tasks. The tasks are organized in rate groups with harmonic
+ * periods (each period is an integer multiple of the next faster one), all of them released by a
+ * single timerfd registered in a LiCAS_ECI_Reactor at the period of the fastest group. In each
+ * tick the due groups are executed from the fastest to the slowest, and the tasks of each group
+ * in decreasing order of priority. Slow groups can be offloaded to a worker thread, so they never
+ * delay the fast ones. For each task the scheduler accounts the number of executions, the
+ * overruns (execution finished after the deadline of its release) and the skipped releases. If
+ * the reactor has a thread accounting, the wake-up latency of the reactor thread w.r.t. each tick
+ * and the CPU usage and wake-up latency of the worker thread are also accounted there.
+ *
+ * Example:
+ *
+ * 	LiCAS_ECI_Reactor reactor("eci_reactor");
+ * 	LiCAS_ECI_Scheduler scheduler(&reactor);
+ *
+ * 	controlGroup = scheduler.addRateGroup(0.002, 0);	// 500 Hz, reactor thread
+ * 	healthGroup = scheduler.addRateGroup(1.0, 1);		// 1 Hz, worker thread
+ * 	scheduler.addTask(controlGroup, "control", controlTask, &controller, 10);
+ * 	scheduler.addTask(healthGroup, "health", healthTask, &licas_eci, 0);
+ * 	scheduler.start();
+ * 	reactor.start(80);
+ *
+ */
+
+#ifndef LICAS_ECI_SCHEDULER_H_
+#define LICAS_ECI_SCHEDULER_H_
+
+
+// Standard library
+#include <atomic>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+
+
+// Specific library
+#include "LiCAS_ECI_Reactor.h"
+
+
+// Constant definition
+#define MAX_RATE_GROUPS			8		// Maximum number of rate groups
+#define MAX_SCHEDULER_TASKS		32		// Maximum number of tasks
+#define HARMONIC_PERIOD_TOL		1e-6	// Relative tolerance of the harmonic periods
+
+
+// Periodic task function
+typedef void (*LiCAS_ECI_TaskFunction)(void * userData);
+
+
+// Statistics of each task
+typedef struct
+{
+	char name[16];					// Name of the task
+	int group;						// Rate group of the task
+	int priority;					// Priority of the task within its rate group
+	float period;					// Period of the task in [s]
+	uint8_t flagOffload;			// 1 if the task is executed by the worker thread
+	uint64_t numExecutions;			// Number of executions
+	uint64_t numOverruns;			// Number of executions finished after the deadline
+	uint64_t numSkippedReleases;	// Number of releases not executed (missed ticks or group still running)
+	float executionTimeMean;		// Mean execution time in [us]
+	float executionTimeMax;			// Maximum execution time in [us]
+	float releaseJitterMax;			// Maximum delay between the nominal release and the start in [us]
+} LiCAS_ECI_TASK_STATISTICS;
+
+
+class LiCAS_ECI_Scheduler
+{
+public:
+
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Reactor that executes the timer of the scheduler
+	 * */
+	LiCAS_ECI_Scheduler(LiCAS_ECI_Reactor * _reactor);
+	
+	
+	/*
+	 * Destructor
+	 * */
+	virtual ~LiCAS_ECI_Scheduler();
+	
+	
+	/*
+	 * Add a rate group. Returns the index of the group, or -1 on error.
+	 *
+	 * Parameters:
+	 * 	(1) Period of the group in [s]
+	 * 	(2) Execute the tasks of the group in the worker thread (1) or in the reactor thread (0)
+	 */
+	int addRateGroup(float period, int flagOffload);
+	
+	
+	/*
+	 * Add a task to a rate group. Returns the index of the task, or -1 on error.
+	 *
+	 * Parameters:
+	 * 	(1) Index of the rate group
+	 * 	(2) Name of the task (up to 15 characters)
+	 * 	(3) Task function
+	 * 	(4) User data passed to the task function
+	 * 	(5) Priority of the task within the group (the higher, the earlier executed)
+	 */
+	int addTask(int group, const char * name, LiCAS_ECI_TaskFunction function, void * userData, int priority);
+	
+	
+	/*
+	 * Check that the periods of the rate groups are harmonic, start the worker thread if any group
+	 * is offloaded and register the timer in the reactor. Error codes:
+	 * 	1: no tasks or already started
+	 * 	2: the periods are not harmonic
+	 * 	3: could not create or register the timer
+	 * 	4: could not start the worker thread
+	 */
+	int start();
+	
+	
+	/*
+	 * Unregister the timer and stop the worker thread. Call it after stopping the reactor thread.
+	 */
+	int stop();
+	
+	
+	/*
+	 * Period of the timer (period of the fastest rate group) in [s]
+	 */
+	float getBasePeriod();
+	
+	
+	/*
+	 * Number of timer ticks elapsed without being processed
+	 */
+	uint64_t getNumMissedTicks();
+	
+	
+	/*
+	 * Number of tasks of the scheduler
+	 */
+	int getNumTasks();
+	
+	
+	/*
+	 * Get the statistics of a task
+	 */
+	int getTaskStatistics(int task, LiCAS_ECI_TASK_STATISTICS * _statistics);
+
+
+private:
+
+	// Rate group
+	typedef struct
+	{
+		float period;
+		int flagOffload;
+		int divider;						// Period in timer ticks
+		int numTasks;
+		int tasks[MAX_SCHEDULER_TASKS];		// Tasks sorted by decreasing priority
+		double t_release;					// Nominal time of the last release in [s]
+		std::atomic<int> flagPending;		// Offloaded group released and not finished
+	} RATE_GROUP;
+	
+	// Task
+	typedef struct
+	{
+		LiCAS_ECI_TaskFunction function;
+		void * userData;
+		LiCAS_ECI_TASK_STATISTICS statistics;
+	} SCHEDULER_TASK;
+	
+	
+	/***************** PRIVATE VARIABLES *****************/
+	LiCAS_ECI_Reactor * reactor;
+	
+	RATE_GROUP groups[MAX_RATE_GROUPS];
+	int groupOrder[MAX_RATE_GROUPS];		// Groups sorted by increasing period
+	int numGroups;
+	
+	SCHEDULER_TASK tasks[MAX_SCHEDULER_TASKS];
+	int numTasks;
+	
+	int timerFd;
+	float basePeriod;
+	uint64_t tickCount;
+	uint64_t numMissedTicks;
+	struct timespec t_start;
+	int flagStarted;
+	
+	// Worker thread of the offloaded groups
+	pthread_t workerThread;
+	int workerEventFd;
+	int flagWorkerThreadRunning;
+	int flagTerminateWorkerThread;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	
+	static void timerCallback(int fd, uint32_t events, void * userData);
+	
+	void processTick(uint64_t numExpirations);
+	
+	void executeGroup(int group);
+	
+	static void * workerThreadEntry(void * arg);
+	
+	void workerThreadFunction();
+	
+	double getElapsedTime();
+};
+
+#endif
+
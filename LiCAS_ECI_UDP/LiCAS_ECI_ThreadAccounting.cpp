@@ -0,0 +1,218 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_ThreadAccounting.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Accounting of the threads of the interface. A thread reserves an entry with an atomic increment
+ * of the number of threads and publishes its ID with the registered flag, so the lookup of the
+ * calling thread from any other thread only compares the published entries.
+ *
+ */
+
+#include "LiCAS_ECI_ThreadAccounting.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_ECI_ThreadAccounting::LiCAS_ECI_ThreadAccounting()
+{
+	this->reset();
+}
+
+
+/*
+ * Index of the calling thread, registering it the first time. Returns -1 if the table is full.
+ *
+ * Parameters:
+ * 	(1) Name of the thread (up to 15 characters)
+ * 	(2) Period of the thread in [s] for the wake-up latency of updatePeriodicWakeup() (0: not periodic)
+ */
+int LiCAS_ECI_ThreadAccounting::getThreadIndex(const char * name, float period)
+{
+	THREAD_ENTRY * entry = NULL;
+	int index = this->findThread();
+	
+	
+	if(index >= 0)
+		return index;
+	
+	index = this->numThreads.fetch_add(1, std::memory_order_relaxed);
+	if(index >= MAX_ECI_THREADS)
+	{
+		this->numThreads.fetch_sub(1, std::memory_order_relaxed);
+		return -1;
+	}
+	
+	entry = &this->entries[index];
+	bzero(&entry->statistics, sizeof(LiCAS_ECI_THREAD_STATISTICS));
+	snprintf(entry->statistics.name, sizeof(entry->statistics.name), "%s", name);
+	entry->period = period;
+	entry->t_lastWakeup = 0;
+	entry->cpuTimeWindow = 0;
+	entry->t_window = getTime();
+	entry->thread = pthread_self();
+	entry->flagRegistered.store(1, std::memory_order_release);
+	
+	
+	return index;
+}
+
+
+/*
+ * Index of the calling thread, or -1 if it is not registered
+ */
+int LiCAS_ECI_ThreadAccounting::findThread()
+{
+	pthread_t thread = pthread_self();
+	int numEntries = this->numThreads.load(std::memory_order_acquire);
+	int k = 0;
+	
+	
+	for(k = 0; k < numEntries && k < MAX_ECI_THREADS; k++)
+	{
+		if(this->entries[k].flagRegistered.load(std::memory_order_acquire) == 1 && pthread_equal(this->entries[k].thread, thread) != 0)
+			return k;
+	}
+	
+	
+	return -1;
+}
+
+
+/*
+ * Update the CPU time, CPU usage and context switches of a thread, at most once per second. A
+ * CPU time below the one of the start of the window (not sampled from the same thread) is
+ * discarded, starting a new window.
+ */
+void LiCAS_ECI_ThreadAccounting::updateCpuStatistics(int index)
+{
+	THREAD_ENTRY * entry = NULL;
+	LiCAS_ECI_THREAD_STATISTICS * th = NULL;
+	struct timespec cpuTime;
+	struct rusage usage;
+	double t = getTime();
+	
+	
+	if(index < 0 || index >= MAX_ECI_THREADS || t - this->entries[index].t_window < 1)
+		return;
+	
+	entry = &this->entries[index];
+	th = &entry->statistics;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuTime);
+	th->cpuTime = cpuTime.tv_sec + 1e-9*cpuTime.tv_nsec;
+	if(th->cpuTime >= entry->cpuTimeWindow)
+		th->cpuUsage = 100*(th->cpuTime - entry->cpuTimeWindow)/(t - entry->t_window);
+	entry->cpuTimeWindow = th->cpuTime;
+	entry->t_window = t;
+	
+	if(getrusage(RUSAGE_THREAD, &usage) == 0)
+	{
+		th->voluntaryContextSwitches = usage.ru_nvcsw;
+		th->involuntaryContextSwitches = usage.ru_nivcsw;
+	}
+}
+
+
+/*
+ * Account the delay of a wake-up of a thread w.r.t. its intended deadline
+ */
+void LiCAS_ECI_ThreadAccounting::updateWakeupLatency(int index, double latency)
+{
+	LiCAS_ECI_THREAD_STATISTICS * th = NULL;
+	float latency_us = 1e6*latency;
+	
+	
+	if(index < 0 || index >= MAX_ECI_THREADS)
+		return;
+	
+	th = &this->entries[index].statistics;
+	th->numWakeups++;
+	th->wakeupLatencyMean += (latency_us - th->wakeupLatencyMean)/th->numWakeups;
+	if(latency_us > th->wakeupLatencyMax)
+		th->wakeupLatencyMax = latency_us;
+}
+
+
+/*
+ * Account the wake-up of a periodic thread w.r.t. its previous wake-up plus its period
+ */
+void LiCAS_ECI_ThreadAccounting::updatePeriodicWakeup(int index)
+{
+	THREAD_ENTRY * entry = NULL;
+	double t = 0;
+	
+	
+	if(index < 0 || index >= MAX_ECI_THREADS || !(this->entries[index].period > 0))
+		return;
+	
+	entry = &this->entries[index];
+	t = getTime();
+	if(entry->t_lastWakeup > 0)
+		this->updateWakeupLatency(index, (t - entry->t_lastWakeup > entry->period) ? t - entry->t_lastWakeup - entry->period : 0);
+	entry->t_lastWakeup = t;
+}
+
+
+/*
+ * Clear the table
+ */
+void LiCAS_ECI_ThreadAccounting::reset()
+{
+	int k = 0;
+	
+	
+	for(k = 0; k < MAX_ECI_THREADS; k++)
+	{
+		this->entries[k].flagRegistered.store(0, std::memory_order_relaxed);
+		this->entries[k].period = 0;
+		this->entries[k].t_lastWakeup = 0;
+		this->entries[k].cpuTimeWindow = 0;
+		this->entries[k].t_window = 0;
+		bzero(&this->entries[k].statistics, sizeof(LiCAS_ECI_THREAD_STATISTICS));
+	}
+	this->numThreads.store(0, std::memory_order_release);
+}
+
+
+/*
+ * Copy the statistics of the threads. Returns the number of threads.
+ */
+int LiCAS_ECI_ThreadAccounting::getStatistics(LiCAS_ECI_THREAD_STATISTICS * threads)
+{
+	int numEntries = this->numThreads.load(std::memory_order_acquire);
+	int k = 0;
+	
+	
+	if(numEntries > MAX_ECI_THREADS)
+		numEntries = MAX_ECI_THREADS;
+	for(k = 0; k < numEntries; k++)
+		threads[k] = this->entries[k].statistics;
+	
+	
+	return numEntries;
+}
+
+
+/*
+ * Monotonic time in [s]
+ */
+double LiCAS_ECI_ThreadAccounting::getTime()
+{
+	struct timespec t;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	
+	
+	return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
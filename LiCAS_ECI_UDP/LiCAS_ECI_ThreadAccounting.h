@@ -0,0 +1,148 @@
+/*
+ *
+ * LiCAS External Control Interface (ECI) - LiCAS_ECI_ThreadAccounting.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Accounting of the CPU usage and wake-up latency of the threads used by the interface (reception,
+ * events, control, reactor and worker threads). Each thread is registered by itself the first time
+ * it is accounted and identified by its pthread ID, so a thread never updates the statistics of
+ * another one. The entries are kept in a fixed size table: registering a thread does not allocate
+ * memory.
+ *
+ */
+
+#ifndef LICAS_ECI_THREAD_ACCOUNTING_H_
+#define LICAS_ECI_THREAD_ACCOUNTING_H_
+
+
+// Standard library
+#include <atomic>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/resource.h>
+
+
+// Constant definition
+#define MAX_ECI_THREADS	8		// Maximum number of threads accounted in the statistics
+
+
+// CPU usage and scheduling latency of a thread used by the interface
+typedef struct
+{
+	char name[16];						// Name of the thread
+	double cpuTime;						// CPU time consumed by the thread in [s] (CLOCK_THREAD_CPUTIME_ID)
+	float cpuUsage;						// CPU usage of the thread in the last second in [%]
+	long voluntaryContextSwitches;		// Voluntary context switches (getrusage)
+	long involuntaryContextSwitches;	// Involuntary context switches, preemptions (getrusage)
+	uint64_t numWakeups;				// Number of wake-ups with known deadline
+	float wakeupLatencyMean;			// Mean delay of the wake-ups w.r.t. the intended deadline in [us]
+	float wakeupLatencyMax;				// Maximum delay of the wake-ups w.r.t. the intended deadline in [us]
+} LiCAS_ECI_THREAD_STATISTICS;
+
+
+class LiCAS_ECI_ThreadAccounting
+{
+public:
+
+	/*
+	 * Constructor
+	 * */
+	LiCAS_ECI_ThreadAccounting();
+	
+	
+	/*
+	 * Index of the calling thread, registering it the first time. Returns -1 if the table is full.
+	 *
+	 * Parameters:
+	 * 	(1) Name of the thread (up to 15 characters)
+	 * 	(2) Period of the thread in [s] for the wake-up latency of updatePeriodicWakeup() (0: not periodic)
+	 */
+	int getThreadIndex(const char * name, float period);
+	
+	
+	/*
+	 * Index of the calling thread, or -1 if it is not registered
+	 */
+	int findThread();
+	
+	
+	/*
+	 * Update the CPU time, CPU usage and context switches of a thread, at most once per second. It
+	 * must be called from the thread itself.
+	 *
+	 * Parameters:
+	 * 	(1) Index of the thread (ignored if negative)
+	 */
+	void updateCpuStatistics(int index);
+	
+	
+	/*
+	 * Account the delay of a wake-up of a thread w.r.t. its intended deadline
+	 *
+	 * Parameters:
+	 * 	(1) Index of the thread (ignored if negative)
+	 * 	(2) Wake-up latency in [s]
+	 */
+	void updateWakeupLatency(int index, double latency);
+	
+	
+	/*
+	 * Account the wake-up of a periodic thread w.r.t. its previous wake-up plus its period (the
+	 * early wake-ups are accounted with zero latency). Ignored if the thread is not periodic.
+	 *
+	 * Parameters:
+	 * 	(1) Index of the thread (ignored if negative)
+	 */
+	void updatePeriodicWakeup(int index);
+	
+	
+	/*
+	 * Clear the table. None of the accounted threads may be updating its statistics.
+	 */
+	void reset();
+	
+	
+	/*
+	 * Copy the statistics of the threads. Returns the number of threads.
+	 */
+	int getStatistics(LiCAS_ECI_THREAD_STATISTICS * threads);
+
+
+private:
+
+	// Entry of the threads table
+	typedef struct
+	{
+		pthread_t thread;
+		std::atomic<int> flagRegistered;	// 1 once the thread ID is published
+		float period;						// Period of the thread in [s] (0: not periodic)
+		double t_lastWakeup;				// Time of the last periodic wake-up in [s]
+		double cpuTimeWindow;				// CPU time at the start of the window in [s]
+		double t_window;					// Start of the window of the CPU usage in [s]
+		LiCAS_ECI_THREAD_STATISTICS statistics;
+	} THREAD_ENTRY;
+	
+	
+	/***************** PRIVATE VARIABLES *****************/
+	THREAD_ENTRY entries[MAX_ECI_THREADS];
+	std::atomic<int> numThreads;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	
+	static double getTime();
+};
+
+#endif
+
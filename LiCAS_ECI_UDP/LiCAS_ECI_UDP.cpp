@@ -22,20 +22,13 @@
 
 
 
-const uint8_t LiCAS_ECI_UDP::LiCAS_CONTROL_MODE_JOINT_POS = 1;	// Joint position control mode
-const uint8_t LiCAS_ECI_UDP::LiCAS_CONTROL_MODE_JOINT_SPD = 2;	// Joint speed control mode
-const uint8_t LiCAS_ECI_UDP::LiCAS_CONTROL_MODE_JOINT_TRQ = 3;	// Joint torque control mode
-const uint8_t LiCAS_ECI_UDP::LiCAS_CONTROL_MODE_TCP_POS = 101;	// TCP position control mode
-const uint8_t LiCAS_ECI_UDP::LiCAS_CONTROL_MODE_TCP_VEL = 102;	// TCP velocity control mode
-const uint8_t LiCAS_ECI_UDP::LiCAS_CONTROL_MODE_TCP_FRC = 103;	// TCP force control mode
-
 /*
  * Constructor
  *
  * Parameters:
  * 	(1) Name of the LiCAS interface (example: "LiCAS-A1")
  * */
-LiCAS_ECI_UDP::LiCAS_ECI_UDP(const string &_LiCAS_Interface_Name)
+LiCAS_ECI_UDP::LiCAS_ECI_UDP(const std::string &_LiCAS_Interface_Name)
 {
 	int k = 0;
 	
@@ -47,6 +40,8 @@ LiCAS_ECI_UDP::LiCAS_ECI_UDP(const string &_LiCAS_Interface_Name)
 	this->UDP_TxPort = -1;
 	this->UDP_RxPort = -1;
 	this->socketSender = -1;
+	this->LiCAS_DataLogFile = NULL;
+	this->logBuffer = NULL;
 	
 	// Init time stamp
 	gettimeofday(&tini, NULL);
@@ -56,6 +51,69 @@ LiCAS_ECI_UDP::LiCAS_ECI_UDP(const string &_LiCAS_Interface_Name)
 	this->flagFeedbackReceived = 0;
 	this->flagTerminateThread = 0;
 	this->flagRxThreadTerminated = 0;
+	this->flagHotPathArmed = 0;
+	
+	this->txHotPathAllocations = 0;
+	this->rxHotPathAllocations = 0;
+	
+	// Adaptive scheduling (disabled by default)
+	this->wakeupEventFd = -1;
+	this->flagIdlePolicyEnabled = 0;
+	this->idleDetectionTime = 1.0;
+	this->idleWakeupPeriod = 0.1;
+	this->flagCommandChanged = 0;
+	this->t_lastActivity = 0;
+	this->t_idleStart = 0;
+	this->t_lastIdleLog = 0;
+	bzero(&statistics, sizeof(LiCAS_ECI_STATISTICS));
+	bzero(&boardStatus, sizeof(LiCAS_STATUS_DATA_PACKET));
+	bzero(&boardDiagnostics, sizeof(LiCAS_DIAGNOSTICS_DATA_PACKET));
+	this->flagPendingLog = 0;
+	
+	// Identifier and size of the packet types received
+	this->statistics.numRxPacketTypes = LiCAS_ECI_RX_PACKET_TABLE::numEntries;
+	LiCAS_ECI_RX_PACKET_TABLE::describe(this->statistics.rxPackets);
+	
+	// Events
+	this->eventEventFd = -1;
+	this->flagEventThreadRunning = 0;
+	this->flagTerminateEventThread = 0;
+	this->eventCallback = NULL;
+	this->eventCallbackUserData = NULL;
+	this->feedbackCallback = NULL;
+	this->feedbackCallbackUserData = NULL;
+	
+	// Reception executed by a reactor
+	this->reactor = NULL;
+	this->socketReceiverReactor = -1;
+	this->watchdogTimerFd = -1;
+	
+	// Feedback rate negotiation and watchdog
+	this->socketReceiverActive = -1;
+	this->feedbackRateSequence = 0;
+	this->feedbackRateAckSequence = 0;
+	this->feedbackTimeout = FEEDBACK_WATCHDOG_TIMEOUT;
+	this->t_lastFeedback = 0;
+	this->flagFeedbackLost = 0;
+	this->t_feedbackWindow = 0;
+	this->feedbackWindowPackets = 0;
+	this->statistics.feedbackTimeout = FEEDBACK_WATCHDOG_TIMEOUT;
+	bzero(&lastFeedbackRateRequest, sizeof(LiCAS_FEEDBACK_RATE_DATA_PACKET));
+	
+	// Multipath redundant transport (only the primary path)
+	this->numPaths = 1;
+	this->statistics.numPaths = 1;
+	for(k = 0; k < MAX_MULTIPATH_PATHS; k++)
+	{
+		this->pathSocketSender[k] = -1;
+		this->pathSocketReceiver[k] = -1;
+	}
+	
+	// Trajectory chunks
+	this->trajectoryID = 0;
+	
+	// Thread accounting
+	this->numControlThreads = 0;
 	
 	for(k = 0; k < NUM_ARM_JOINTS; k++)
 	{
@@ -67,6 +125,10 @@ LiCAS_ECI_UDP::LiCAS_ECI_UDP(const string &_LiCAS_Interface_Name)
 		this->tauR[k] = 0;
 		this->pwmL[k] = 0;
 		this->pwmR[k] = 0;
+		this->qL_lastRef[k] = 0;
+		this->qR_lastRef[k] = 0;
+		this->qL_idleCheck[k] = 0;
+		this->qR_idleCheck[k] = 0;
 	}
 	t_lastUpdate = 0;
 	elapsedTimeLastUpdate = 0;
@@ -78,6 +140,7 @@ LiCAS_ECI_UDP::LiCAS_ECI_UDP(const string &_LiCAS_Interface_Name)
  * */
 LiCAS_ECI_UDP::~LiCAS_ECI_UDP()
 {
+	this->stopEventThread();
 }
 
 
@@ -89,26 +152,59 @@ LiCAS_ECI_UDP::~LiCAS_ECI_UDP()
  *	(2) UDP port for sending the control references to the LiCAS control program
  *	(3) UDP port for receiving the feedback data packet from the LiCAS control program
  */
-int LiCAS_ECI_UDP::openUDPInterface(const string &_LiCAS_IP_Address, int _UDP_TxPort, int _UDP_RxPort)
+int LiCAS_ECI_UDP::openUDPInterface(const std::string &_LiCAS_IP_Address, int _UDP_TxPort, int _UDP_RxPort)
+{
+	return this->openUDPInterface(_LiCAS_IP_Address, _UDP_TxPort, _UDP_RxPort, NULL);
+}
+
+
+/*
+ * Open the UDP socket interface with the reception executed by a reactor instead of the own
+ * reception thread.
+ *
+ * Parameters:
+ * 	(1) IP address of the computer board executing the LiCAS control program
+ *	(2) UDP port for sending the control references to the LiCAS control program
+ *	(3) UDP port for receiving the feedback data packet from the LiCAS control program
+ *	(4) Reactor that executes the reception (NULL for the own reception thread)
+ */
+int LiCAS_ECI_UDP::openUDPInterface(const std::string &_LiCAS_IP_Address, int _UDP_TxPort, int _UDP_RxPort, LiCAS_ECI_Reactor * _reactor)
 {
+	int enable = 1;
 	int errorCode = 0;
 	
 	
+	// The threads of the previous session are not accounted any more
+	this->threadAccounting.reset();
+	this->numControlThreads = 0;
+	
+	// Start the thread that delivers the events of the interface
+	if(this->startEventThread() != 0)
+	{
+		errorCode = 4;
+		this->raiseEvent(LiCAS_EVENT_EVENT_THREAD, LiCAS_EVENT_SEVERITY_ERROR, 0, 0);
+	}
+	
+	// New epoch of the sequence numbers of the multipath transport (the computer board starts its window again)
+	this->multipath.restart();
+	
 	// Open the UDP socket for sending the control references to the LiCAS dual arm
-	this->socketSender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if(socketSender < 0)
+	this->socketSender = -1;
+	if(errorCode == 0)
+		this->socketSender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if(errorCode == 0 && socketSender < 0)
     {
     	errorCode = 1;
-    	cout << endl << "ERROR: [in LiCAS_ECI_UDP::openUDPInterface] could not open socket." << endl;
+    	this->raiseEvent(LiCAS_EVENT_OPEN_SOCKET, LiCAS_EVENT_SEVERITY_ERROR, errno, 0);
    	}
-   	else
+   	else if(errorCode == 0)
 	{
 	   	host = gethostbyname(_LiCAS_IP_Address.c_str());
 	    if(host == NULL)
 		{
 		    errorCode = 2;
 			close(socketSender);
-		    cout << "ERROR: [in LiCAS_ECI_UDP::openUDPInterface] could not get host by name." << endl;
+		    this->raiseEvent(LiCAS_EVENT_HOST_NOT_FOUND, LiCAS_EVENT_SEVERITY_ERROR, 0, h_errno);
 		}
 		else
 		{
@@ -117,6 +213,18 @@ int LiCAS_ECI_UDP::openUDPInterface(const string &_LiCAS_IP_Address, int _UDP_Tx
 			this->addrHost.sin_family = AF_INET;
 			bcopy((char*)host->h_addr, (char*)&addrHost.sin_addr.s_addr, host->h_length);
 			this->addrHost.sin_port = htons(_UDP_TxPort);
+			
+			// Connected sender socket whose ICMP errors (port or host unreachable) are queued in its
+			// error queue, drained by the reception thread or the reactor. Without the error queue
+			// the link down is still detected by the feedback watchdog.
+			if(connect(this->socketSender, (struct sockaddr*)&addrHost, sizeof(struct sockaddr_in)) != 0)
+			{
+				errorCode = 2;
+				this->raiseEvent(LiCAS_EVENT_CONNECT, LiCAS_EVENT_SEVERITY_ERROR, errno, 0);
+				close(socketSender);
+			}
+			else if(setsockopt(this->socketSender, SOL_IP, IP_RECVERR, &enable, sizeof(enable)) != 0)
+				this->raiseEvent(LiCAS_EVENT_RECVERR, LiCAS_EVENT_SEVERITY_WARNING, errno, 0);
 		}
 	}
 	
@@ -127,9 +235,227 @@ int LiCAS_ECI_UDP::openUDPInterface(const string &_LiCAS_IP_Address, int _UDP_Tx
 		this->UDP_TxPort = _UDP_TxPort;
 		this->UDP_RxPort = _UDP_RxPort;
 		
-		// Init the thread for receiving the feedback data packet from the LiCAS dual arm
-		udpRxThread = thread(&LiCAS_ECI_UDP::udpRxThreadFunction, this);
-		udpRxThread.detach();
+		// Open log data file. Its buffer is preallocated here so the reception thread does not allocate memory
+		this->LiCAS_DataLogFile = fopen("LiCAS_DataLog.txt", "w");
+		if(this->LiCAS_DataLogFile != NULL)
+		{
+			this->logBuffer = new char[LOG_BUFFER_SIZE];
+			setvbuf(this->LiCAS_DataLogFile, this->logBuffer, _IOFBF, LOG_BUFFER_SIZE);
+		}
+		
+		// Event for waking up the reception thread (new command in idle mode, termination)
+		this->wakeupEventFd = eventfd(0, EFD_NONBLOCK);
+		
+		if(_reactor == NULL)
+		{
+			// Init the thread for receiving the feedback data packet from the LiCAS dual arm
+			if(pthread_create(&udpRxThread, NULL, &LiCAS_ECI_UDP::udpRxThreadEntry, this) != 0)
+			{
+				errorCode = 3;
+				this->raiseEvent(LiCAS_EVENT_RX_THREAD_CREATION, LiCAS_EVENT_SEVERITY_ERROR, errno, 0);
+			}
+			else
+				pthread_detach(udpRxThread);
+		}
+		else
+		{
+			// The feedback data packets are received by the reactor thread
+			this->socketReceiverReactor = this->openRxSocket();
+			if(this->socketReceiverReactor < 0)
+				errorCode = 3;
+			else if(_reactor->addDescriptor(this->socketReceiverReactor, EPOLLIN, &LiCAS_ECI_UDP::reactorRxCallback, this) != 0)
+			{
+				errorCode = 3;
+				this->raiseEvent(LiCAS_EVENT_REACTOR, LiCAS_EVENT_SEVERITY_ERROR, 0, this->socketReceiverReactor);
+				close(this->socketReceiverReactor);
+				this->socketReceiverReactor = -1;
+				this->socketReceiverActive = -1;
+			}
+			else
+			{
+				this->reactor = _reactor;
+				
+				// The reactor thread is accounted along with the threads of the first interface opened on it
+				if(_reactor->getThreadAccounting() == NULL)
+					_reactor->setThreadAccounting(&this->threadAccounting);
+				
+				// The feedback watchdog is checked by a timer of the reactor
+				this->watchdogTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+				if(this->watchdogTimerFd < 0 || _reactor->addDescriptor(this->watchdogTimerFd, EPOLLIN, &LiCAS_ECI_UDP::reactorWatchdogCallback, this) != 0)
+				{
+					this->raiseEvent(LiCAS_EVENT_REACTOR_WATCHDOG, LiCAS_EVENT_SEVERITY_WARNING, 0, this->watchdogTimerFd);
+					if(this->watchdogTimerFd >= 0)
+						close(this->watchdogTimerFd);
+					this->watchdogTimerFd = -1;
+				}
+				else
+					this->setWatchdogTimer();
+				
+				// The errors of the sender socket are drained by the reactor (EPOLLERR is always reported)
+				if(_reactor->addDescriptor(this->socketSender, EPOLLERR, &LiCAS_ECI_UDP::reactorSendErrorCallback, this) != 0)
+					this->raiseEvent(LiCAS_EVENT_REACTOR_SEND_ERRORS, LiCAS_EVENT_SEVERITY_WARNING, 0, this->socketSender);
+			}
+		}
+		
+		// Without reception (thread or reactor) the interface is not open
+		if(errorCode != 0)
+		{
+			close(this->socketSender);
+			this->socketSender = -1;
+			close(this->wakeupEventFd);
+			this->wakeupEventFd = -1;
+			if(this->LiCAS_DataLogFile != NULL)
+			{
+				fclose(this->LiCAS_DataLogFile);
+				this->LiCAS_DataLogFile = NULL;
+			}
+			if(this->logBuffer != NULL)
+			{
+				delete [] this->logBuffer;
+				this->logBuffer = NULL;
+			}
+		}
+	}
+	
+	if(errorCode != 0)
+		this->stopEventThread();
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Open the monitor of the link state of the network interface to the LiCAS computer board.
+ *
+ * Parameters:
+ * 	(1) Name of the network interface (NULL: interface of the route to the computer board)
+ */
+int LiCAS_ECI_UDP::openLinkMonitor(const char * interfaceName)
+{
+	int errorCode = 0;
+	
+	
+	if(this->socketSender < 0)
+	{
+		this->raiseEvent(LiCAS_EVENT_LINK_MONITOR, LiCAS_EVENT_SEVERITY_ERROR, 0, 0);
+		return 1;
+	}
+	
+	if(this->linkMonitor.open(this->addrHost.sin_addr, interfaceName) != 0)
+	{
+		errorCode = 2;
+		this->raiseEvent(LiCAS_EVENT_LINK_MONITOR, LiCAS_EVENT_SEVERITY_ERROR, errno, 0);
+	}
+	else if(this->reactor != NULL && this->reactor->addDescriptor(this->linkMonitor.getSocket(), EPOLLIN, &LiCAS_ECI_UDP::reactorLinkMonitorCallback, this) != 0)
+	{
+		errorCode = 3;
+		this->raiseEvent(LiCAS_EVENT_LINK_MONITOR, LiCAS_EVENT_SEVERITY_ERROR, 0, this->linkMonitor.getSocket());
+		this->linkMonitor.close();
+	}
+	else
+	{
+		// Initial state of the interface (the notifications are processed by the reception thread or the reactor)
+		this->statistics.interfaceIndex = this->linkMonitor.getInterfaceIndex();
+		if(this->linkMonitor.isLinkUp() == 0)
+		{
+			this->statistics.flagInterfaceDown = 1;
+			this->statistics.numInterfaceDown++;
+			this->raiseEvent(LiCAS_EVENT_INTERFACE_DOWN, LiCAS_EVENT_SEVERITY_ERROR, 0, this->statistics.interfaceIndex);
+		}
+		
+		// The reception thread polls the socket of the link monitor from its next wake-up
+		if(this->reactor == NULL)
+			this->wakeupRxThread();
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Add a path to the multipath redundant transport.
+ *
+ * Parameters:
+ * 	(1) IP address of the computer board through the path
+ *	(2) UDP port for sending the control references through the path
+ *	(3) UDP port for receiving the feedback data packet through the path
+ *	(4) Network interface of the path (NULL: given by the route to the computer board)
+ */
+int LiCAS_ECI_UDP::addPath(const std::string &_LiCAS_IP_Address, int _UDP_TxPort, int _UDP_RxPort, const char * interfaceName)
+{
+	struct sockaddr_in addrReceiver;
+	struct hostent * pathHost;
+	int pathIndex = this->numPaths;
+	int socketPathSender = -1;
+	int socketPathReceiver = -1;
+	int errorCode = 0;
+	
+	
+	if(this->socketSender < 0 || pathIndex >= MAX_MULTIPATH_PATHS)
+	{
+		this->raiseEvent(LiCAS_EVENT_MULTIPATH, LiCAS_EVENT_SEVERITY_ERROR, 0, pathIndex);
+		return 1;
+	}
+	
+	pathHost = gethostbyname(_LiCAS_IP_Address.c_str());
+	socketPathSender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	socketPathReceiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if(pathHost == NULL || socketPathSender < 0 || socketPathReceiver < 0)
+		errorCode = 2;
+	else
+	{
+		// Address of the computer board through the path
+		bzero((char*)&addrPath[pathIndex], sizeof(struct sockaddr_in));
+		this->addrPath[pathIndex].sin_family = AF_INET;
+		bcopy((char*)pathHost->h_addr, (char*)&addrPath[pathIndex].sin_addr.s_addr, pathHost->h_length);
+		this->addrPath[pathIndex].sin_port = htons(_UDP_TxPort);
+		
+		// Both sockets of the path bound to its network interface (requires the CAP_NET_RAW capability before Linux 5.7)
+		if(interfaceName != NULL &&
+			(setsockopt(socketPathSender, SOL_SOCKET, SO_BINDTODEVICE, interfaceName, strlen(interfaceName) + 1) != 0 ||
+			setsockopt(socketPathReceiver, SOL_SOCKET, SO_BINDTODEVICE, interfaceName, strlen(interfaceName) + 1) != 0))
+			errorCode = 3;
+	}
+	
+	if(errorCode == 0)
+	{
+		bzero((char*)&addrReceiver, sizeof(struct sockaddr_in));
+		addrReceiver.sin_family = AF_INET;
+		addrReceiver.sin_addr.s_addr = INADDR_ANY;
+		addrReceiver.sin_port = htons(_UDP_RxPort);
+		if(bind(socketPathReceiver, (struct sockaddr*)&addrReceiver, sizeof(addrReceiver)) < 0)
+			errorCode = 4;
+		else
+			fcntl(socketPathReceiver, F_SETFL, O_NONBLOCK);
+	}
+	
+	if(errorCode == 0 && this->reactor != NULL && this->reactor->addDescriptor(socketPathReceiver, EPOLLIN, &LiCAS_ECI_UDP::reactorRxCallback, this) != 0)
+		errorCode = 5;
+	
+	if(errorCode != 0)
+	{
+		this->raiseEvent(LiCAS_EVENT_MULTIPATH, LiCAS_EVENT_SEVERITY_ERROR, errno, pathIndex);
+		if(socketPathSender >= 0)
+			close(socketPathSender);
+		if(socketPathReceiver >= 0)
+			close(socketPathReceiver);
+	}
+	else
+	{
+		// The primary path is the path 0
+		this->pathSocketSender[0] = this->socketSender;
+		this->addrPath[0] = this->addrHost;
+		this->pathSocketSender[pathIndex] = socketPathSender;
+		this->pathSocketReceiver[pathIndex] = socketPathReceiver;
+		this->multipath.setNumPaths(pathIndex + 1);
+		this->statistics.numPaths = pathIndex + 1;
+		
+		// The reception thread polls the receiver socket of the path from its next wake-up
+		__atomic_store_n(&this->numPaths, pathIndex + 1, __ATOMIC_RELEASE);
+		if(this->reactor == NULL)
+			this->wakeupRxThread();
 	}
 	
 	
@@ -148,13 +474,13 @@ int LiCAS_ECI_UDP::openUDPInterface(const string &_LiCAS_IP_Address, int _UDP_Tx
 int LiCAS_ECI_UDP::sendJointPositionRef(float * qLref, float * qRref, float playTime)
 {
 	LiCAS_CONTROL_REF_DATA_PACKET controlRefDataPacket;
-	int bytesSent = 0;
+	uint64_t allocations = LiCAS_ECI_AllocTracker::getThreadAllocations();
 	int k = 0;
 	int errorCode = 0;
 	
 	
 	// Set the fields of the data packet
-	controlRefDataPacket.mode = this->LiCAS_CONTROL_MODE_JOINT_POS;
+	controlRefDataPacket.mode = LiCAS_CONTROL_MODE_JOINT_POS;
 	controlRefDataPacket.playTime = playTime;
 	for(k = 0; k < NUM_ARM_JOINTS; k++)
 	{
@@ -163,215 +489,1680 @@ int LiCAS_ECI_UDP::sendJointPositionRef(float * qLref, float * qRref, float play
 	}
 	controlRefDataPacket.timeStamp = this->getElapsedTime();
 	
+	// Detect command changes for the adaptive scheduling, waking up the reception thread if it is idle
+	this->checkCommandChange(qLref, qRref);
 	
-	// Send the control references data packet
-	bytesSent = sendto(this->socketSender, (char*)&controlRefDataPacket, sizeof(LiCAS_CONTROL_REF_DATA_PACKET), 0, (struct sockaddr*)&addrHost, sizeof(struct sockaddr));
-	if(bytesSent < 0)
-	{
-		errorCode = 1;
-		cout << "ERROR: [in LiCAS_ECI_UDP::sendJointPositionRef] could not send data packet." << endl;
-	}
-	else if(bytesSent != sizeof(LiCAS_CONTROL_REF_DATA_PACKET))
-	{
-		errorCode = 1;
-		cout << "ERROR: [in LiCAS_ECI_UDP::sendJointPositionRef] incorrect number packet." << endl;
-	}
+	errorCode = this->sendCommandPacket(&controlRefDataPacket, sizeof(LiCAS_CONTROL_REF_DATA_PACKET), controlRefDataPacket.timeStamp, allocations);
 	
 	
 	return errorCode;
 }
 
-	
+
 /*
- * Get the elapsed time since the creation of the interface instance
+ * Send joint torque references to the LiCAS dual arm.
+ *
+ * Parameters:
+ * 	(1) Left arm joint torque in [Nm]
+ * 	(2) Right arm joint torque in [Nm]
  */
-float LiCAS_ECI_UDP::getElapsedTime()
+int LiCAS_ECI_UDP::sendJointTorqueRef(float * tauLref, float * tauRref)
 {
-	float t = 0;
+	LiCAS_CONTROL_REF_DATA_PACKET controlRefDataPacket;
+	uint64_t allocations = LiCAS_ECI_AllocTracker::getThreadAllocations();
+	int k = 0;
+	int errorCode = 0;
 	
 	
-	gettimeofday(&tact, NULL);
-	elapsedTime = (tact.tv_sec - tini.tv_sec) + 1e-6*(tact.tv_usec - tini.tv_usec);
+	// Set the fields of the data packet
+	controlRefDataPacket.mode = LiCAS_CONTROL_MODE_JOINT_TRQ;
+	controlRefDataPacket.playTime = 0;
+	for(k = 0; k < 3; k++)
+	{
+		controlRefDataPacket.refLTCP[k] = 0;
+		controlRefDataPacket.refRTCP[k] = 0;
+	}
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		controlRefDataPacket.refLJ[k] = tauLref[k];
+		controlRefDataPacket.refRJ[k] = tauRref[k];
+	}
+	controlRefDataPacket.timeStamp = this->getElapsedTime();
 	
-	t = (float)elapsedTime;
+	errorCode = this->sendCommandPacket(&controlRefDataPacket, sizeof(LiCAS_CONTROL_REF_DATA_PACKET), controlRefDataPacket.timeStamp, allocations);
 	
 	
-	return t;
+	return errorCode;
 }
 
 
-void LiCAS_ECI_UDP::udpRxThreadFunction()
+/*
+ * Send TCP (tool center point) position references to the LiCAS dual arm.
+ *
+ * Parameters:
+ * 	(1) Left arm TCP position reference
+ * 	(2) Right arm TCP position reference
+ * 	(3) Time for reaching the reference from current position
+ */
+int LiCAS_ECI_UDP::sendTCPPositionRef(float * pLref, float * pRref, float playTime)
 {
-	LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback;
-	struct sockaddr_in addrReceiver;
-	struct sockaddr_in addrSender;
-	socklen_t addrLength;
-	int socketReceiver = -1;
-	int dataReceived = 0;
-	char buffer[1024];
-	
-	ofstream LiCAS_DataLogFile;
-	
-	int errorCode = 0;
+	LiCAS_CONTROL_REF_DATA_PACKET controlRefDataPacket;
+	uint64_t allocations = LiCAS_ECI_AllocTracker::getThreadAllocations();
+	float refL[NUM_ARM_JOINTS] = {0};
+	float refR[NUM_ARM_JOINTS] = {0};
 	int k = 0;
+	int errorCode = 0;
 	
 	
-	// Open the socket in datagram mode
-	socketReceiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-	if(socketReceiver < 0) 
-	{
-		errorCode = 1;
-		cout << endl << "ERROR: [in LiCAS_ECI_UDP::udpRxThreadFunction] could not open socket." << endl;
-	}
-	else
+	// Set the fields of the data packet (joint references not used in this mode)
+	bzero(&controlRefDataPacket, sizeof(LiCAS_CONTROL_REF_DATA_PACKET));
+	controlRefDataPacket.mode = LiCAS_CONTROL_MODE_TCP_POS;
+	controlRefDataPacket.playTime = playTime;
+	for(k = 0; k < 3; k++)
 	{
-		// Set listenning address (any) and port
-		bzero((char*)&addrReceiver, sizeof(struct sockaddr_in));
-		addrReceiver.sin_family = AF_INET;
-		addrReceiver.sin_addr.s_addr = INADDR_ANY;
-		addrReceiver.sin_port = htons(this->UDP_RxPort);
-	
-		// Associates the address to the socket
-		if(bind(socketReceiver, (struct sockaddr*)&addrReceiver, sizeof(addrReceiver)) < 0)
-		{
-			errorCode = 2;
-			close(socketReceiver);
-			cout << endl << "ERROR: [in LiCAS_ECI_UDP::udpRxThreadFunction] could not associate address to socket." << endl;
-		}
-		else
-		{
-			// Set the socket as non blocking
-			fcntl(socketReceiver, F_SETFL, O_NONBLOCK);
-		}
+		controlRefDataPacket.refLTCP[k] = pLref[k];
+		controlRefDataPacket.refRTCP[k] = pRref[k];
+		refL[k] = pLref[k];
+		refR[k] = pRref[k];
 	}
+	controlRefDataPacket.timeStamp = this->getElapsedTime();
 	
-	// Open log data file
-	if(errorCode == 0)
-	{
-		LiCAS_DataLogFile.open("LiCAS_DataLog.txt");
-	}
-
-	/******************************** THREAD LOOP START ********************************/
-
-	while(errorCode == 0 && flagTerminateThread == 0)
-	{
-		dataReceived = recvfrom(socketReceiver, buffer, 1023, 0, (struct sockaddr*)&addrSender, &addrLength);
-		if(dataReceived == sizeof(LiCAS_FEEDBACK_DATA_PACKET))
-		{
-			// Get pointer to data in the structure from the buffer pointer
-			dataPacketFeedback = (LiCAS_FEEDBACK_DATA_PACKET*)buffer;
-			
-			// Copy the received feedback on the public variables
-			for(k = 0; k < 3; k++)
-			{
-				this->pL[k] = dataPacketFeedback->pL[k];
-				this->pR[k] = dataPacketFeedback->pR[k];
-			}
-			for(k = 0; k < NUM_ARM_JOINTS; k++)
-			{
-				this->qL[k] = dataPacketFeedback->qL[k];
-				this->qR[k] = dataPacketFeedback->qR[k];
-				this->dqL[k] = dataPacketFeedback->dqL[k];
-				this->dqR[k] = dataPacketFeedback->dqR[k];
-				this->tauL[k] = dataPacketFeedback->tauL[k];
-				this->tauR[k] = dataPacketFeedback->tauR[k];
-				this->pwmL[k] = dataPacketFeedback->pwmL[k];
-				this->pwmR[k] = dataPacketFeedback->pwmR[k];
-				
-				printf("LEFT ARM Cartesian Position: {%.1f, %.1f, %.1f} [cm]\n", 100*pL[0], 100*pL[1], 100*pL[2]);
-				printf("LEFT ARM Joint Position: {%.1f, %.1f, %.1f, %.1f} [deg]\n", qL[0], qL[1], qL[2], qL[3]);
-				printf("LEFT ARM Joint Velocity: {%.1f, %.1f, %.1f, %.1f} [deg/s]\n", dqL[0], dqL[1], dqL[2], dqL[3]);
-				printf("LEFT ARM Joint PWM: {%.1f, %.1f, %.1f, %.1f} \n", pwmL[0], pwmL[1], pwmL[2], pwmL[3]);
-				printf("\n");
-				
-				printf("RIGHT ARM Cartesian Position: {%.1f, %.1f, %.1f} [cm]\n", 100*pR[0], 100*pR[1], 100*pR[2]);
-				printf("RIGHT ARM Joint Position: {%.1f, %.1f, %.1f, %.1f} [deg]\n", qR[0], qR[1], qR[2], qR[3]);
-				printf("RIGHT ARM Joint Velocity: {%.1f, %.1f, %.1f, %.1f} [deg/s]\n", dqR[0], dqR[1], dqR[2], dqR[3]);
-				printf("RIGHT ARM Joint PWM: {%.1f, %.1f, %.1f, %.1f} \n", pwmR[0], pwmR[1], pwmR[2], pwmR[3]);
-				printf("\n");
-				printf("---\n");
-			}
-				
-		
-			// Save data on log file
-			LiCAS_DataLogFile << getElapsedTime() << "\t";
-			for(k = 0; k < 3; k++)
-				LiCAS_DataLogFile << pL[k] << "\t";
-			for(k = 0; k < 3; k++)
-				LiCAS_DataLogFile << pR[k] << "\t";
-			for(k = 0; k < NUM_ARM_JOINTS; k++)
-				LiCAS_DataLogFile << qL[k] << "\t";
-			for(k = 0; k < NUM_ARM_JOINTS; k++)
-				LiCAS_DataLogFile << qR[k] << "\t";
-			for(k = 0; k < NUM_ARM_JOINTS; k++)
-				LiCAS_DataLogFile << dqL[k] << "\t";
-			for(k = 0; k < NUM_ARM_JOINTS; k++)
-				LiCAS_DataLogFile << dqR[k] << "\t";
-			for(k = 0; k < NUM_ARM_JOINTS; k++)
-				LiCAS_DataLogFile << tauL[k] << "\t";
-			for(k = 0; k < NUM_ARM_JOINTS; k++)
-				LiCAS_DataLogFile << tauR[k] << "\t";
-			for(k = 0; k < NUM_ARM_JOINTS; k++)
-				LiCAS_DataLogFile << pwmL[k] << "\t";
-			for(k = 0; k < NUM_ARM_JOINTS; k++)
-				LiCAS_DataLogFile << pwmR[k] << "\t";
-			LiCAS_DataLogFile << endl;
-		
-			
-			elapsedTimeLastUpdate = getElapsedTime() - t_lastUpdate;
-			t_lastUpdate = getElapsedTime();
-			
-			// Set the feedback received float
-			this->flagFeedbackReceived = 1;
-		}
-		
-		// Wait 10 ms
-		usleep(10000);
-	}
+	this->checkCommandChange(refL, refR);
 	
-	/******************************** THREAD LOOP END ********************************/
+	errorCode = this->sendCommandPacket(&controlRefDataPacket, sizeof(LiCAS_CONTROL_REF_DATA_PACKET), controlRefDataPacket.timeStamp, allocations);
 	
-	// Close log file
-	LiCAS_DataLogFile.close();
 	
-	// Close the socket
-	if(errorCode == 0)
-		close(socketReceiver);
-	this->flagRxThreadTerminated = 1;
+	return errorCode;
 }
 
-	
+
 /*
- * Close the UDP socket interface
+ * Send a chunk of future joint position setpoints of a trajectory.
+ *
+ * Parameters:
+ * 	(1) Index of the first setpoint of the chunk in the trajectory
+ * 	(2) Setpoints, with their time in the clock of the interface
+ * 	(3) Number of setpoints (up to MAX_CHUNK_SETPOINTS)
  */
-int LiCAS_ECI_UDP::closeInterface()
+int LiCAS_ECI_UDP::sendJointTrajectoryChunk(uint32_t firstIndex, const LiCAS_TRAJECTORY_SETPOINT * setpoints, int numSetpoints)
 {
-	int errorCode = 0;
-	float timer = 0;
-
+	return this->sendTrajectoryChunk(LiCAS_CONTROL_MODE_JOINT_POS, firstIndex, setpoints, numSetpoints);
+}
 
-	this->flagTerminateThread = 1;
-	usleep(10000);	// Waits 10 ms to termiante thread
 
-	// Close sender socket
-	close(this->socketSender);
-	this->socketSender = -1;
+/*
+ * Send a chunk of future TCP position setpoints of a trajectory.
+ *
+ * Parameters:
+ * 	(1) Index of the first setpoint of the chunk in the trajectory
+ * 	(2) Setpoints, with their time in the clock of the interface
+ * 	(3) Number of setpoints (up to MAX_CHUNK_SETPOINTS)
+ */
+int LiCAS_ECI_UDP::sendTCPTrajectoryChunk(uint32_t firstIndex, const LiCAS_TRAJECTORY_SETPOINT * setpoints, int numSetpoints)
+{
+	return this->sendTrajectoryChunk(LiCAS_CONTROL_MODE_TCP_POS, firstIndex, setpoints, numSetpoints);
+}
 
-	cout << "Waiting reception thread termination..." << endl;
-	while(this->flagRxThreadTerminated == 0 && timer < 1)
-	{
-		usleep(10000);
-		timer += 0.01;
-	}
-	
-	if(timer >= 1)
-	{
-		errorCode = 1;
-		cout << "ERROR [in LiCAS_ECI_UDP::closeInterface]: could not terminate reception thread." << endl;
-	}
-	else
-		cout << "LiCAS External Control Interface UDP terminated correctly." << endl;
 
+/*
+ * Start a new trajectory
+ */
+void LiCAS_ECI_UDP::startTrajectory()
+{
+	this->trajectoryID++;
+}
+
+
+/*
+ * Set the fields of a trajectory chunk data packet and send it. The first setpoint is taken as the
+ * command for the adaptive scheduling.
+ */
+int LiCAS_ECI_UDP::sendTrajectoryChunk(uint8_t mode, uint32_t firstIndex, const LiCAS_TRAJECTORY_SETPOINT * setpoints, int numSetpoints)
+{
+	LiCAS_TRAJECTORY_CHUNK_DATA_PACKET trajectoryChunkDataPacket;
+	uint64_t allocations = LiCAS_ECI_AllocTracker::getThreadAllocations();
+	float refL[NUM_ARM_JOINTS];
+	float refR[NUM_ARM_JOINTS];
+	int errorCode = 0;
+	
+	
+	if(numSetpoints < 1 || numSetpoints > MAX_CHUNK_SETPOINTS)
+	{
+		this->raiseEvent(LiCAS_EVENT_TRAJECTORY_CHUNK, LiCAS_EVENT_SEVERITY_ERROR, 0, numSetpoints);
+		return 1;
+	}
+	
+	// Set the fields of the data packet (the unused setpoints are zero)
+	bzero(&trajectoryChunkDataPacket, sizeof(LiCAS_TRAJECTORY_CHUNK_DATA_PACKET));
+	trajectoryChunkDataPacket.packetID = LiCAS_PACKET_ID_TRAJECTORY_CHUNK;
+	trajectoryChunkDataPacket.mode = mode;
+	trajectoryChunkDataPacket.numSetpoints = (uint8_t)numSetpoints;
+	trajectoryChunkDataPacket.trajectoryID = this->trajectoryID;
+	trajectoryChunkDataPacket.firstIndex = firstIndex;
+	memcpy(trajectoryChunkDataPacket.setpoints, setpoints, numSetpoints*sizeof(LiCAS_TRAJECTORY_SETPOINT));
+	trajectoryChunkDataPacket.timeStamp = this->getElapsedTime();
+	
+	memcpy(refL, setpoints[0].refL, sizeof(refL));
+	memcpy(refR, setpoints[0].refR, sizeof(refR));
+	this->checkCommandChange(refL, refR);
+	
+	errorCode = this->sendCommandPacket(&trajectoryChunkDataPacket, sizeof(LiCAS_TRAJECTORY_CHUNK_DATA_PACKET), trajectoryChunkDataPacket.timeStamp, allocations);
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Send a command data packet (control references or trajectory chunk), accounting the CPU usage of
+ * the control thread and the allocations of the send path since the given count
+ */
+int LiCAS_ECI_UDP::sendCommandPacket(const void * commandPacket, int packetSize, float timeStamp, uint64_t allocations)
+{
+	char threadName[24];
+	int threadIndex = this->threadAccounting.findThread();
+	int numThread = 0;
+	int bytesSent = 0;
+	int errorCode = 0;
+	
+	
+	// CPU usage and wake-up latency of the thread calling this method (a control thread not
+	// registered with registerControlThread() is registered the first time it sends a command)
+	if(threadIndex < 0)
+	{
+		numThread = __atomic_fetch_add(&this->numControlThreads, 1, __ATOMIC_RELAXED);
+		if(numThread == 0)
+			snprintf(threadName, sizeof(threadName), "eci_control");
+		else
+			snprintf(threadName, sizeof(threadName), "eci_control_%d", numThread + 1);
+		threadIndex = this->threadAccounting.getThreadIndex(threadName, 0);
+	}
+	this->threadAccounting.updatePeriodicWakeup(threadIndex);
+	this->threadAccounting.updateCpuStatistics(threadIndex);
+	
+	
+	// Send the command data packet, unless it is held while the network interface is down
+	if(this->numPaths > 1)
+		errorCode = this->sendMultipathPacket(commandPacket, packetSize, timeStamp);
+	else if(this->statistics.flagInterfaceDown == 1)
+	{
+		errorCode = 3;
+		this->statistics.numHeldCommands++;
+	}
+	else if((bytesSent = sendto(this->socketSender, (const char*)commandPacket, packetSize, 0, (struct sockaddr*)&addrHost, sizeof(struct sockaddr))) < 0)
+	{
+		// The unreachable errors are reported once by the error queue of the socket (link down)
+		errorCode = 1;
+		if(errno != ECONNREFUSED && errno != EHOSTUNREACH && errno != ENETUNREACH)
+			this->raiseEvent(LiCAS_EVENT_SEND_FAILED, LiCAS_EVENT_SEVERITY_ERROR, errno, bytesSent);
+	}
+	else if(bytesSent != packetSize)
+	{
+		errorCode = 1;
+		this->raiseEvent(LiCAS_EVENT_SEND_INCOMPLETE, LiCAS_EVENT_SEVERITY_ERROR, 0, bytesSent);
+	}
+	
+	// Account the allocations made by the send path once the link is established
+	if(this->flagHotPathArmed == 1)
+		this->txHotPathAllocations += LiCAS_ECI_AllocTracker::getThreadAllocations() - allocations;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Send a data packet over all the paths of the multipath transport, inside an envelope with its
+ * sequence number. As with a single path, the hold mode applies to the primary path (the monitored
+ * network interface): its copy is held while the interface is down, and the other paths are not
+ * affected. Returns 0 if the data packet is sent over any path, 3 if it is held and not sent over
+ * the other paths, or 1 otherwise.
+ */
+int LiCAS_ECI_UDP::sendMultipathPacket(const void * dataPacket, int packetSize, float timeStamp)
+{
+	char buffer[MAX_MULTIPATH_PACKET_SIZE];
+	int envelopeSize = 0;
+	int numSent = 0;
+	int flagHeld = 0;
+	int k = 0;
+	
+	
+	envelopeSize = this->multipath.wrapPacket(buffer, dataPacket, packetSize, timeStamp);
+	if(envelopeSize < 0)
+		return 1;
+	
+	for(k = 0; k < this->numPaths; k++)
+	{
+		if(k == 0 && this->statistics.flagInterfaceDown == 1)
+		{
+			flagHeld = 1;
+			this->statistics.numHeldCommands++;
+			continue;
+		}
+		this->multipath.setPath(buffer, k);
+		if(sendto(this->pathSocketSender[k], buffer, envelopeSize, 0, (struct sockaddr*)&addrPath[k], sizeof(struct sockaddr)) == envelopeSize)
+			numSent++;
+	}
+	
+	
+	return (numSent > 0) ? 0 : ((flagHeld == 1) ? 3 : 1);
+}
+
+	
+/*
+ * Get the elapsed time since the creation of the interface instance
+ */
+float LiCAS_ECI_UDP::getElapsedTime()
+{
+	float t = 0;
+	
+	
+	gettimeofday(&tact, NULL);
+	elapsedTime = (tact.tv_sec - tini.tv_sec) + 1e-6*(tact.tv_usec - tini.tv_usec);
+	
+	t = (float)elapsedTime;
+	
+	
+	return t;
+}
+
+
+/*
+ * Request the rate and channels of the feedback data packet to the LiCAS computer board, sending
+ * the request again until it is acknowledged.
+ *
+ * Parameters:
+ * 	(1) Rate of the feedback data packet in [Hz]
+ * 	(2) Channels of the feedback data packet (LiCAS_FEEDBACK_CHANNEL_...)
+ * 	(3) Timeout of the acknowledgment in [s]
+ */
+int LiCAS_ECI_UDP::requestFeedbackRate(float rate, uint8_t channels, float timeout)
+{
+	LiCAS_FEEDBACK_RATE_DATA_PACKET dataPacketFeedbackRate;
+	uint16_t sequence = 0;
+	float t_nextRequest = 0;
+	float timer = 0;
+	int bytesSent = 0;
+	int errorCode = 0;
+	
+	
+	if(!(rate > 0) || channels == 0)
+	{
+		this->raiseEvent(LiCAS_EVENT_FEEDBACK_RATE_INVALID, LiCAS_EVENT_SEVERITY_ERROR, 0, channels);
+		return 1;
+	}
+	
+	// Sequence number of the request (0 is never used, it is the initial acknowledged value)
+	sequence = this->feedbackRateSequence + 1;
+	if(sequence == 0)
+		sequence = 1;
+	this->feedbackRateSequence = sequence;
+	
+	bzero(&dataPacketFeedbackRate, sizeof(LiCAS_FEEDBACK_RATE_DATA_PACKET));
+	dataPacketFeedbackRate.packetID = LiCAS_PACKET_ID_FEEDBACK_RATE;
+	dataPacketFeedbackRate.channels = channels;
+	dataPacketFeedbackRate.sequence = sequence;
+	dataPacketFeedbackRate.rate = rate;
+	this->lastFeedbackRateRequest = dataPacketFeedbackRate;
+	
+	// Send the request until it is acknowledged (the request or the acknowledgment may be lost)
+	while(errorCode == 0 && __atomic_load_n(&this->feedbackRateAckSequence, __ATOMIC_ACQUIRE) != sequence && timer < timeout)
+	{
+		if(timer >= t_nextRequest)
+		{
+			dataPacketFeedbackRate.timeStamp = this->getElapsedTime();
+			bytesSent = sendto(this->socketSender, (char*)&dataPacketFeedbackRate, sizeof(LiCAS_FEEDBACK_RATE_DATA_PACKET), 0, (struct sockaddr*)&addrHost, sizeof(struct sockaddr));
+			if(bytesSent != sizeof(LiCAS_FEEDBACK_RATE_DATA_PACKET))
+			{
+				errorCode = 1;
+				this->raiseEvent(LiCAS_EVENT_FEEDBACK_RATE_SEND, LiCAS_EVENT_SEVERITY_ERROR, errno, bytesSent);
+			}
+			t_nextRequest += FEEDBACK_RATE_RETRY_PERIOD;
+		}
+		usleep(1000);
+		timer += 0.001;
+	}
+	
+	if(errorCode == 0 && __atomic_load_n(&this->feedbackRateAckSequence, __ATOMIC_ACQUIRE) != sequence)
+	{
+		errorCode = 2;
+		this->raiseEvent(LiCAS_EVENT_FEEDBACK_RATE, LiCAS_EVENT_SEVERITY_ERROR, 0, sequence);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Configure the adaptive scheduling policy. When enabled, the interface enters in idle mode if the
+ * commands do not change and the feedback is stationary. In idle mode the receiver sockets are not
+ * polled: the reception thread wakes up once per idle wake-up period, processing the feedback
+ * received meanwhile and logging the last one. It returns to full rate immediately when a new
+ * command is sent, or after one idle wake-up period if the motion is detected in the feedback.
+ *
+ * Parameters:
+ * 	(1) Enable (1) or disable (0) the adaptive scheduling
+ * 	(2) Time without command changes and with stationary feedback to enter in idle mode in [s]
+ * 	(3) Wake-up period of the reception thread in idle mode in [s]
+ */
+void LiCAS_ECI_UDP::setIdlePolicy(int enable, float _idleDetectionTime, float _idleWakeupPeriod)
+{
+	this->idleDetectionTime = _idleDetectionTime;
+	this->idleWakeupPeriod = _idleWakeupPeriod;
+	this->flagIdlePolicyEnabled = enable;
+	
+	// The receive buffer holds the feedback received during the idle wake-up periods
+	if(this->statistics.feedbackRate > 0)
+		this->adaptRxBuffer(this->statistics.feedbackRate);
+}
+
+
+/*
+ * Get the statistics of the interface.
+ *
+ * Parameters:
+ * 	(1) Pointer to the structure where the statistics are copied
+ */
+void LiCAS_ECI_UDP::getStatistics(LiCAS_ECI_STATISTICS * _statistics)
+{
+	*_statistics = this->statistics;
+	_statistics->numPaths = this->multipath.getStatistics(_statistics->paths);
+	if(_statistics->flagIdle == 1)
+		_statistics->timeIdle += getElapsedTime() - this->t_idleStart;
+	_statistics->numThreads = this->threadAccounting.getStatistics(_statistics->threads);
+}
+
+
+/*
+ * Print the last feedback received on the standard output
+ */
+void LiCAS_ECI_UDP::printFeedback()
+{
+	printf("LEFT ARM Cartesian Position: {%.1f, %.1f, %.1f} [cm]\n", 100*pL[0], 100*pL[1], 100*pL[2]);
+	printf("LEFT ARM Joint Position: {%.1f, %.1f, %.1f, %.1f} [deg]\n", qL[0], qL[1], qL[2], qL[3]);
+	printf("LEFT ARM Joint Velocity: {%.1f, %.1f, %.1f, %.1f} [deg/s]\n", dqL[0], dqL[1], dqL[2], dqL[3]);
+	printf("LEFT ARM Joint PWM: {%.1f, %.1f, %.1f, %.1f} \n", pwmL[0], pwmL[1], pwmL[2], pwmL[3]);
+	printf("\n");
+	
+	printf("RIGHT ARM Cartesian Position: {%.1f, %.1f, %.1f} [cm]\n", 100*pR[0], 100*pR[1], 100*pR[2]);
+	printf("RIGHT ARM Joint Position: {%.1f, %.1f, %.1f, %.1f} [deg]\n", qR[0], qR[1], qR[2], qR[3]);
+	printf("RIGHT ARM Joint Velocity: {%.1f, %.1f, %.1f, %.1f} [deg/s]\n", dqR[0], dqR[1], dqR[2], dqR[3]);
+	printf("RIGHT ARM Joint PWM: {%.1f, %.1f, %.1f, %.1f} \n", pwmR[0], pwmR[1], pwmR[2], pwmR[3]);
+	printf("\n");
+	printf("---\n");
+}
+
+
+/*
+ * Export the statistics of the interface in the Prometheus text format.
+ *
+ * Parameters:
+ * 	(1) Name of the metrics file
+ */
+int LiCAS_ECI_UDP::exportMetrics(const char * fileName)
+{
+	LiCAS_ECI_STATISTICS stats;
+	LiCAS_ECI_THREAD_STATISTICS * th;
+	std::string tmpFileName = std::string(fileName) + ".tmp";
+	const char * name = this->LiCAS_Interface_Name.c_str();
+	FILE * metricsFile = NULL;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	this->getStatistics(&stats);
+	
+	metricsFile = fopen(tmpFileName.c_str(), "w");
+	if(metricsFile == NULL)
+	{
+		errorCode = 1;
+		this->raiseEvent(LiCAS_EVENT_METRICS_EXPORT, LiCAS_EVENT_SEVERITY_ERROR, errno, 0);
+	}
+	else
+	{
+		fprintf(metricsFile, "# TYPE licas_eci_feedback_packets_total counter\n");
+		fprintf(metricsFile, "licas_eci_feedback_packets_total{interface=\"%s\"} %llu\n", name, (unsigned long long)stats.numFeedbackPackets);
+		fprintf(metricsFile, "# TYPE licas_eci_log_lines_total counter\n");
+		fprintf(metricsFile, "licas_eci_log_lines_total{interface=\"%s\"} %llu\n", name, (unsigned long long)stats.numLogLines);
+		fprintf(metricsFile, "# TYPE licas_eci_rx_wakeups_total counter\n");
+		fprintf(metricsFile, "licas_eci_rx_wakeups_total{interface=\"%s\"} %llu\n", name, (unsigned long long)stats.numRxWakeups);
+		fprintf(metricsFile, "# TYPE licas_eci_rx_wakeups_per_second gauge\n");
+		fprintf(metricsFile, "licas_eci_rx_wakeups_per_second{interface=\"%s\"} %g\n", name, stats.rxWakeupsPerSecond);
+		fprintf(metricsFile, "# TYPE licas_eci_idle gauge\n");
+		fprintf(metricsFile, "licas_eci_idle{interface=\"%s\"} %d\n", name, stats.flagIdle);
+		fprintf(metricsFile, "# TYPE licas_eci_idle_seconds_total counter\n");
+		fprintf(metricsFile, "licas_eci_idle_seconds_total{interface=\"%s\"} %g\n", name, stats.timeIdle);
+		fprintf(metricsFile, "# TYPE licas_eci_feedback_rate_hz gauge\n");
+		fprintf(metricsFile, "licas_eci_feedback_rate_hz{interface=\"%s\",type=\"acknowledged\"} %g\n", name, stats.feedbackRate);
+		fprintf(metricsFile, "licas_eci_feedback_rate_hz{interface=\"%s\",type=\"measured\"} %g\n", name, stats.feedbackRateMeasured);
+		fprintf(metricsFile, "# TYPE licas_eci_feedback_timeouts_total counter\n");
+		fprintf(metricsFile, "licas_eci_feedback_timeouts_total{interface=\"%s\"} %llu\n", name, (unsigned long long)stats.numFeedbackTimeouts);
+		fprintf(metricsFile, "# TYPE licas_eci_rx_buffer_bytes gauge\n");
+		fprintf(metricsFile, "licas_eci_rx_buffer_bytes{interface=\"%s\"} %d\n", name, stats.rxBufferSize);
+		fprintf(metricsFile, "# TYPE licas_eci_interface_down_total counter\n");
+		fprintf(metricsFile, "licas_eci_interface_down_total{interface=\"%s\"} %llu\n", name, (unsigned long long)stats.numInterfaceDown);
+		fprintf(metricsFile, "# TYPE licas_eci_held_commands_total counter\n");
+		fprintf(metricsFile, "licas_eci_held_commands_total{interface=\"%s\"} %llu\n", name, (unsigned long long)stats.numHeldCommands);
+		
+		// Per packet type metrics
+		fprintf(metricsFile, "# TYPE licas_eci_rx_packets_total counter\n");
+		for(k = 0; k < stats.numRxPacketTypes; k++)
+		{
+			if(stats.rxPackets[k].flagAnyID == 1)
+				fprintf(metricsFile, "licas_eci_rx_packets_total{interface=\"%s\",id=\"any\",size=\"%d\"} %llu\n", name, stats.rxPackets[k].size, (unsigned long long)stats.rxPackets[k].numPackets);
+			else
+				fprintf(metricsFile, "licas_eci_rx_packets_total{interface=\"%s\",id=\"%d\",size=\"%d\"} %llu\n", name, stats.rxPackets[k].packetID, stats.rxPackets[k].size, (unsigned long long)stats.rxPackets[k].numPackets);
+		}
+		fprintf(metricsFile, "# TYPE licas_eci_rx_unknown_packets_total counter\n");
+		fprintf(metricsFile, "licas_eci_rx_unknown_packets_total{interface=\"%s\"} %llu\n", name, (unsigned long long)stats.numUnknownPackets);
+		
+		// Per path metrics of the multipath transport
+		if(stats.numPaths > 1)
+		{
+			fprintf(metricsFile, "# TYPE licas_eci_path_packets_total counter\n");
+			for(k = 0; k < stats.numPaths; k++)
+			{
+				fprintf(metricsFile, "licas_eci_path_packets_total{interface=\"%s\",path=\"%d\",type=\"sent\"} %llu\n", name, k, (unsigned long long)stats.paths[k].numSent);
+				fprintf(metricsFile, "licas_eci_path_packets_total{interface=\"%s\",path=\"%d\",type=\"first\"} %llu\n", name, k, (unsigned long long)stats.paths[k].numFirst);
+				fprintf(metricsFile, "licas_eci_path_packets_total{interface=\"%s\",path=\"%d\",type=\"duplicate\"} %llu\n", name, k, (unsigned long long)stats.paths[k].numDuplicates);
+			}
+			fprintf(metricsFile, "# TYPE licas_eci_path_loss_ratio gauge\n");
+			for(k = 0; k < stats.numPaths; k++)
+				fprintf(metricsFile, "licas_eci_path_loss_ratio{interface=\"%s\",path=\"%d\"} %g\n", name, k, stats.paths[k].lossRate);
+			fprintf(metricsFile, "# TYPE licas_eci_path_latency_ms gauge\n");
+			for(k = 0; k < stats.numPaths; k++)
+				fprintf(metricsFile, "licas_eci_path_latency_ms{interface=\"%s\",path=\"%d\"} %g\n", name, k, stats.paths[k].latencyMean);
+		}
+		
+		// Per thread metrics
+		fprintf(metricsFile, "# TYPE licas_eci_thread_cpu_seconds_total counter\n");
+		for(k = 0; k < stats.numThreads; k++)
+			fprintf(metricsFile, "licas_eci_thread_cpu_seconds_total{interface=\"%s\",thread=\"%s\"} %g\n", name, stats.threads[k].name, stats.threads[k].cpuTime);
+		fprintf(metricsFile, "# TYPE licas_eci_thread_cpu_usage_percent gauge\n");
+		for(k = 0; k < stats.numThreads; k++)
+			fprintf(metricsFile, "licas_eci_thread_cpu_usage_percent{interface=\"%s\",thread=\"%s\"} %g\n", name, stats.threads[k].name, stats.threads[k].cpuUsage);
+		fprintf(metricsFile, "# TYPE licas_eci_thread_context_switches_total counter\n");
+		for(k = 0; k < stats.numThreads; k++)
+		{
+			th = &stats.threads[k];
+			fprintf(metricsFile, "licas_eci_thread_context_switches_total{interface=\"%s\",thread=\"%s\",type=\"voluntary\"} %ld\n", name, th->name, th->voluntaryContextSwitches);
+			fprintf(metricsFile, "licas_eci_thread_context_switches_total{interface=\"%s\",thread=\"%s\",type=\"involuntary\"} %ld\n", name, th->name, th->involuntaryContextSwitches);
+		}
+		fprintf(metricsFile, "# TYPE licas_eci_thread_wakeups_total counter\n");
+		for(k = 0; k < stats.numThreads; k++)
+			fprintf(metricsFile, "licas_eci_thread_wakeups_total{interface=\"%s\",thread=\"%s\"} %llu\n", name, stats.threads[k].name, (unsigned long long)stats.threads[k].numWakeups);
+		fprintf(metricsFile, "# TYPE licas_eci_thread_wakeup_latency_mean_us gauge\n");
+		for(k = 0; k < stats.numThreads; k++)
+			fprintf(metricsFile, "licas_eci_thread_wakeup_latency_mean_us{interface=\"%s\",thread=\"%s\"} %g\n", name, stats.threads[k].name, stats.threads[k].wakeupLatencyMean);
+		fprintf(metricsFile, "# TYPE licas_eci_thread_wakeup_latency_max_us gauge\n");
+		for(k = 0; k < stats.numThreads; k++)
+			fprintf(metricsFile, "licas_eci_thread_wakeup_latency_max_us{interface=\"%s\",thread=\"%s\"} %g\n", name, stats.threads[k].name, stats.threads[k].wakeupLatencyMax);
+		
+		fclose(metricsFile);
+		
+		// Replace the previous metrics file
+		if(rename(tmpFileName.c_str(), fileName) != 0)
+		{
+			errorCode = 2;
+			this->raiseEvent(LiCAS_EVENT_METRICS_EXPORT, LiCAS_EVENT_SEVERITY_ERROR, errno, 0);
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Compare the new joint references with the last ones sent
+ */
+void LiCAS_ECI_UDP::checkCommandChange(const float * qLref, const float * qRref)
+{
+	int flagChanged = 0;
+	int k = 0;
+	
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		if(qLref[k] != this->qL_lastRef[k] || qRref[k] != this->qR_lastRef[k])
+			flagChanged = 1;
+		this->qL_lastRef[k] = qLref[k];
+		this->qR_lastRef[k] = qRref[k];
+	}
+	
+	if(flagChanged == 1)
+	{
+		this->flagCommandChanged = 1;
+		if(this->statistics.flagIdle == 1)
+			this->wakeupRxThread();
+	}
+}
+
+
+/*
+ * Wake up the reception thread through its event file descriptor
+ */
+int LiCAS_ECI_UDP::wakeupRxThread()
+{
+	uint64_t eventValue = 1;
+	int errorCode = 0;
+	
+	
+	if(write(this->wakeupEventFd, &eventValue, sizeof(eventValue)) != sizeof(eventValue))
+		errorCode = 1;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Set the callback that receives the events (errors, warnings, information) of the interface.
+ *
+ * Parameters:
+ * 	(1) Callback function (NULL for printing the events on the standard output)
+ * 	(2) Pointer passed to the callback
+ */
+void LiCAS_ECI_UDP::setEventCallback(LiCAS_ECI_EventCallback callback, void * userData)
+{
+	this->eventCallbackUserData = userData;
+	this->eventCallback = callback;
+}
+
+
+/*
+ * Set the callback executed by the reception thread for each feedback data packet received
+ *
+ * Parameters:
+ * 	(1) Callback function (NULL for no callback)
+ * 	(2) Pointer passed to the callback
+ */
+void LiCAS_ECI_UDP::setFeedbackCallback(LiCAS_ECI_FeedbackCallback callback, void * userData)
+{
+	this->feedbackCallbackUserData = userData;
+	this->feedbackCallback = callback;
+}
+
+
+/*
+ * Register the calling thread as a control thread of the interface
+ *
+ * Parameters:
+ * 	(1) Name of the thread (up to 15 characters)
+ * 	(2) Control period of the thread in [s]
+ */
+int LiCAS_ECI_UDP::registerControlThread(const char * name, float period)
+{
+	int errorCode = 0;
+	
+	
+	if(this->threadAccounting.getThreadIndex(name, period) < 0)
+		errorCode = 1;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Account the CPU usage and wake-up latency of the threads of a reactor in the statistics
+ *
+ * Parameters:
+ * 	(1) Reactor whose threads are accounted
+ */
+void LiCAS_ECI_UDP::accountReactorThreads(LiCAS_ECI_Reactor * _reactor)
+{
+	_reactor->setThreadAccounting(&this->threadAccounting);
+}
+
+
+/*
+ * Number of occurrences of an event code
+ */
+uint64_t LiCAS_ECI_UDP::getEventCount(uint16_t code)
+{
+	return this->eventRing.getCount(code);
+}
+
+
+/*
+ * Number of events dropped because the event ring was full
+ */
+uint64_t LiCAS_ECI_UDP::getDroppedEventCount()
+{
+	return this->eventRing.getDroppedCount();
+}
+
+
+/*
+ * Raise an event from any thread without blocking. The event is delivered by the events thread,
+ * or by the calling thread if the events thread is not running.
+ */
+void LiCAS_ECI_UDP::raiseEvent(uint16_t code, uint8_t severity, int32_t errnoValue, int64_t value)
+{
+	uint64_t eventValue = 1;
+	
+	
+	this->eventRing.push(code, severity, errnoValue, value, getElapsedTime());
+	
+	// Without the events thread the event is kept in the ring (the ring has a single consumer), and
+	// delivered when the events thread is started or by closeInterface() and the destructor
+	if(this->flagEventThreadRunning == 0)
+		__atomic_fetch_add(&this->statistics.numDeferredEvents, 1, __ATOMIC_RELAXED);
+	else if(write(this->eventEventFd, &eventValue, sizeof(eventValue)) != sizeof(eventValue))
+		this->statistics.numEventNotifyErrors++;
+}
+
+
+/*
+ * Deliver the events pending in the ring to the user callback or print them
+ */
+void LiCAS_ECI_UDP::deliverEvents()
+{
+	LiCAS_ECI_EventCallback callback = this->eventCallback;
+	LiCAS_ECI_EVENT event;
+	
+	
+	while(this->eventRing.pop(&event) == 1)
+	{
+		if(callback != NULL)
+			callback(&event, this->eventCallbackUserData);
+		else
+		{
+			printf("%s", LiCAS_ECI_EventRing::getMessage(event.code));
+			if(event.errnoValue != 0)
+				printf(" (%s)", strerror(event.errnoValue));
+			if(event.code == LiCAS_EVENT_HOT_PATH_ALLOCATIONS)
+				printf(" (%lld)", (long long)event.value);
+			printf("\n");
+		}
+	}
+}
+
+
+/*
+ * Start the low priority thread that delivers the events
+ */
+int LiCAS_ECI_UDP::startEventThread()
+{
+	int errorCode = 0;
+	
+	
+	if(this->flagEventThreadRunning == 0)
+	{
+		this->eventEventFd = eventfd(0, 0);
+		this->flagTerminateEventThread = 0;
+		if(this->eventEventFd < 0 || pthread_create(&eventThread, NULL, &LiCAS_ECI_UDP::eventThreadEntry, this) != 0)
+		{
+			errorCode = 1;
+			if(this->eventEventFd >= 0)
+				close(this->eventEventFd);
+			this->eventEventFd = -1;
+		}
+		else
+			this->flagEventThreadRunning = 1;
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Stop the events thread, delivering the pending events
+ */
+void LiCAS_ECI_UDP::stopEventThread()
+{
+	uint64_t eventValue = 1;
+	
+	
+	if(this->flagEventThreadRunning == 1)
+	{
+		this->flagTerminateEventThread = 1;
+		if(write(this->eventEventFd, &eventValue, sizeof(eventValue)) == sizeof(eventValue))
+			pthread_join(this->eventThread, NULL);
+		else
+			pthread_cancel(this->eventThread);
+		this->flagEventThreadRunning = 0;
+		close(this->eventEventFd);
+		this->eventEventFd = -1;
+	}
+	this->deliverEvents();
+}
+
+
+/*
+ * Entry point of the events thread
+ */
+void * LiCAS_ECI_UDP::eventThreadEntry(void * arg)
+{
+	((LiCAS_ECI_UDP*)arg)->eventThreadFunction();
+	
+	
+	return NULL;
+}
+
+
+void LiCAS_ECI_UDP::eventThreadFunction()
+{
+	struct sched_param schedParam;
+	uint64_t eventValue = 0;
+	int threadIndex = -1;
+	
+	
+	// Lowest priority: the events never delay the real-time threads
+	bzero(&schedParam, sizeof(schedParam));
+	pthread_setschedparam(pthread_self(), SCHED_IDLE, &schedParam);
+	pthread_setname_np(pthread_self(), "eci_events");
+	threadIndex = this->threadAccounting.getThreadIndex("eci_events", 0);
+	
+	// Events raised while the thread was not running
+	this->deliverEvents();
+	
+	/******************************** THREAD LOOP START ********************************/
+	
+	while(this->flagTerminateEventThread == 0)
+	{
+		// Sleep until an event is raised
+		if(read(this->eventEventFd, &eventValue, sizeof(eventValue)) == sizeof(eventValue))
+		{
+			this->deliverEvents();
+			this->threadAccounting.updateCpuStatistics(threadIndex);
+		}
+	}
+	
+	/******************************** THREAD LOOP END ********************************/
+	
+	this->deliverEvents();
+}
+
+
+/*
+ * Wait until the first feedback data packet is received from the LiCAS computer board.
+ *
+ * Parameters:
+ * 	(1) Timeout in [s]
+ */
+int LiCAS_ECI_UDP::waitForLink(float timeout)
+{
+	int errorCode = 0;
+	float timer = 0;
+	
+	
+	while(this->flagFeedbackReceived == 0 && timer < timeout)
+	{
+		usleep(1000);
+		timer += 0.001;
+	}
+	
+	if(this->flagFeedbackReceived == 0)
+	{
+		errorCode = 1;
+		this->raiseEvent(LiCAS_EVENT_LINK_TIMEOUT, LiCAS_EVENT_SEVERITY_ERROR, 0, 0);
+	}
+	else
+	{
+		// From now on the send and receive paths must not allocate memory
+		this->txHotPathAllocations = 0;
+		this->rxHotPathAllocations = 0;
+		this->flagHotPathArmed = 1;
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Get the number of heap allocations made by the send and receive paths between waitForLink()
+ * and closeInterface().
+ */
+uint64_t LiCAS_ECI_UDP::getHotPathAllocations()
+{
+	return this->txHotPathAllocations + this->rxHotPathAllocations;
+}
+
+
+/*
+ * Entry point of the reception thread
+ */
+void * LiCAS_ECI_UDP::udpRxThreadEntry(void * arg)
+{
+	((LiCAS_ECI_UDP*)arg)->udpRxThreadFunction();
+	
+	
+	return NULL;
+}
+
+
+/*
+ * Handler of the feedback data packet. At full rate all the packets are logged, while in idle mode
+ * only the last one received in each idle wake-up period is logged.
+ */
+void LiCAS_ECI_UDP::handlePacket(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback)
+{
+	this->updateReceptionTime();
+	if(this->flagFeedbackLost == 1)
+	{
+		this->flagFeedbackLost = 0;
+		this->raiseEvent(LiCAS_EVENT_FEEDBACK_RESTORED, LiCAS_EVENT_SEVERITY_INFO, 0, (int64_t)(1000*(this->t_lastUpdate - this->t_lastFeedback)));
+	}
+	this->t_lastFeedback = this->t_lastUpdate;
+	if(this->statistics.flagLinkDown == 1)
+	{
+		this->statistics.flagLinkDown = 0;
+		this->raiseEvent(LiCAS_EVENT_LINK_UP, LiCAS_EVENT_SEVERITY_INFO, 0, 0);
+	}
+	this->processFeedbackPacket(dataPacketFeedback);
+	if(this->feedbackCallback != NULL)
+		this->feedbackCallback(dataPacketFeedback, this->t_lastUpdate, this->feedbackCallbackUserData);
+	if(this->statistics.flagIdle == 0)
+		this->logFeedback();
+	else
+		this->flagPendingLog = 1;
+}
+
+
+/*
+ * Handler of the status data packet
+ */
+void LiCAS_ECI_UDP::handlePacket(const LiCAS_STATUS_DATA_PACKET * dataPacketStatus)
+{
+	this->updateReceptionTime();
+	this->boardStatus = *dataPacketStatus;
+}
+
+
+/*
+ * Handler of the diagnostics data packet
+ */
+void LiCAS_ECI_UDP::handlePacket(const LiCAS_DIAGNOSTICS_DATA_PACKET * dataPacketDiagnostics)
+{
+	this->updateReceptionTime();
+	this->boardDiagnostics = *dataPacketDiagnostics;
+}
+
+
+/*
+ * Handler of the feedback rate acknowledgment data packet: the receive buffer, the watchdog timeout
+ * and the statistics are adapted to the rate applied by the computer board. The acknowledgments of
+ * the previous requests (retransmissions) are ignored.
+ */
+void LiCAS_ECI_UDP::handlePacket(const LiCAS_FEEDBACK_RATE_ACK_DATA_PACKET * dataPacketFeedbackRateAck)
+{
+	uint16_t sequence = dataPacketFeedbackRateAck->sequence;
+	float rate = dataPacketFeedbackRateAck->rate;
+	
+	
+	this->updateReceptionTime();
+	if(sequence != this->feedbackRateSequence || !(rate > 0))
+		return;
+	
+	this->statistics.feedbackRate = rate;
+	this->statistics.feedbackChannels = dataPacketFeedbackRateAck->channels;
+	this->feedbackTimeout = fmaxf(FEEDBACK_WATCHDOG_PERIODS/rate, FEEDBACK_WATCHDOG_MIN_TIMEOUT);
+	this->statistics.feedbackTimeout = this->feedbackTimeout;
+	this->adaptRxBuffer(rate);
+	this->setWatchdogTimer();
+	
+	// Release the thread waiting in requestFeedbackRate()
+	__atomic_store_n(&this->feedbackRateAckSequence, sequence, __ATOMIC_RELEASE);
+}
+
+
+/*
+ * Adapt the receive buffer of the socket to the feedback data packets received in the buffer time,
+ * or in two wake-up periods in idle mode if longer. SO_RCVBUFFORCE exceeds the system limit when
+ * the process has the CAP_NET_ADMIN capability.
+ */
+void LiCAS_ECI_UDP::adaptRxBuffer(float rate)
+{
+	socklen_t optionLength = sizeof(int);
+	int bufferSize = 0;
+	
+	
+	if(this->socketReceiverActive < 0)
+		return;
+	
+	bufferSize = (int)(RX_BUFFER_PACKET_SIZE*rate*fmaxf(RX_BUFFER_TIME, 2*this->idleWakeupPeriod));
+	if(bufferSize < RX_BUFFER_MIN_SIZE)
+		bufferSize = RX_BUFFER_MIN_SIZE;
+	if(setsockopt(this->socketReceiverActive, SOL_SOCKET, SO_RCVBUFFORCE, &bufferSize, sizeof(bufferSize)) != 0)
+		setsockopt(this->socketReceiverActive, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+	
+	// Size applied by the kernel (double of the requested one, for its bookkeeping)
+	if(getsockopt(this->socketReceiverActive, SOL_SOCKET, SO_RCVBUF, &bufferSize, &optionLength) == 0)
+		this->statistics.rxBufferSize = bufferSize;
+}
+
+
+/*
+ * Feedback watchdog: an event is raised when no feedback data packet has been received within the
+ * watchdog timeout, extended by the wake-up period in idle mode (the packets are processed late).
+ * The feedback rate measured is updated once per second.
+ */
+void LiCAS_ECI_UDP::checkFeedbackWatchdog(float t)
+{
+	float timeout = this->feedbackTimeout;
+	
+	
+	if(this->statistics.flagIdle == 1)
+		timeout += this->idleWakeupPeriod;
+	if(this->flagFeedbackReceived == 1 && this->flagFeedbackLost == 0 && t - this->t_lastFeedback > timeout)
+	{
+		this->flagFeedbackLost = 1;
+		this->statistics.numFeedbackTimeouts++;
+		this->raiseEvent(LiCAS_EVENT_FEEDBACK_TIMEOUT, LiCAS_EVENT_SEVERITY_WARNING, 0, (int64_t)(1000*(t - this->t_lastFeedback)));
+	}
+	
+	if(t - this->t_feedbackWindow >= 1)
+	{
+		this->statistics.feedbackRateMeasured = (this->statistics.numFeedbackPackets - this->feedbackWindowPackets)/(t - this->t_feedbackWindow);
+		this->feedbackWindowPackets = this->statistics.numFeedbackPackets;
+		this->t_feedbackWindow = t;
+	}
+}
+
+
+/*
+ * Callback of the watchdog timer executed by the reactor
+ */
+void LiCAS_ECI_UDP::reactorWatchdogCallback(int fd, uint32_t, void * userData)
+{
+	uint64_t expirations = 0;
+	
+	
+	if(read(fd, &expirations, sizeof(expirations)) == sizeof(expirations))
+		((LiCAS_ECI_UDP*)userData)->checkFeedbackWatchdog(((LiCAS_ECI_UDP*)userData)->getElapsedTime());
+}
+
+
+/*
+ * Set the period of the watchdog timer of the reactor to the watchdog timeout
+ */
+void LiCAS_ECI_UDP::setWatchdogTimer()
+{
+	struct itimerspec timerSpec;
+	
+	
+	if(this->watchdogTimerFd < 0)
+		return;
+	
+	timerSpec.it_interval.tv_sec = (time_t)this->feedbackTimeout;
+	timerSpec.it_interval.tv_nsec = (long)(1e9*(this->feedbackTimeout - timerSpec.it_interval.tv_sec));
+	timerSpec.it_value = timerSpec.it_interval;
+	timerfd_settime(this->watchdogTimerFd, 0, &timerSpec, NULL);
+}
+
+
+/*
+ * Drain the error queue of the sender socket (IP_RECVERR). An ICMP port or host unreachable error
+ * means that the LiCAS control program or the computer board is down, so the link down event is
+ * raised after the first command sent, without waiting for the feedback watchdog.
+ */
+void LiCAS_ECI_UDP::drainSendErrors(int fd)
+{
+	struct msghdr message;
+	struct iovec messageData;
+	struct cmsghdr * cmsg;
+	struct sock_extended_err * extendedError;
+	char buffer[256];
+	char controlBuffer[256];
+	
+	
+	messageData.iov_base = buffer;
+	messageData.iov_len = sizeof(buffer);
+	bzero(&message, sizeof(message));
+	message.msg_iov = &messageData;
+	message.msg_iovlen = 1;
+	message.msg_control = controlBuffer;
+	message.msg_controllen = sizeof(controlBuffer);
+	while(recvmsg(fd, &message, MSG_ERRQUEUE | MSG_DONTWAIT) >= 0)
+	{
+		for(cmsg = CMSG_FIRSTHDR(&message); cmsg != NULL; cmsg = CMSG_NXTHDR(&message, cmsg))
+		{
+			if(cmsg->cmsg_level != SOL_IP || cmsg->cmsg_type != IP_RECVERR)
+				continue;
+			extendedError = (struct sock_extended_err*)CMSG_DATA(cmsg);
+			if((extendedError->ee_errno == ECONNREFUSED || extendedError->ee_errno == EHOSTUNREACH || extendedError->ee_errno == ENETUNREACH) &&
+				this->statistics.flagLinkDown == 0)
+			{
+				this->statistics.flagLinkDown = 1;
+				this->statistics.numLinkDown++;
+				this->raiseEvent(LiCAS_EVENT_LINK_DOWN, LiCAS_EVENT_SEVERITY_ERROR, extendedError->ee_errno, (extendedError->ee_type << 8) | extendedError->ee_code);
+			}
+		}
+		message.msg_control = controlBuffer;
+		message.msg_controllen = sizeof(controlBuffer);
+	}
+}
+
+
+/*
+ * Callback of the errors of the sender socket executed by the reactor
+ */
+void LiCAS_ECI_UDP::reactorSendErrorCallback(int fd, uint32_t, void * userData)
+{
+	((LiCAS_ECI_UDP*)userData)->drainSendErrors(fd);
+}
+
+
+/*
+ * Process the notifications of the link monitor. When the network interface goes down the commands
+ * are held, and when it is up again the link is re-established.
+ */
+void LiCAS_ECI_UDP::updateInterfaceState()
+{
+	int flagLinkUp = this->linkMonitor.processMessages();
+	
+	
+	if(flagLinkUp == 0 && this->statistics.flagInterfaceDown == 0)
+	{
+		this->statistics.flagInterfaceDown = 1;
+		this->statistics.numInterfaceDown++;
+		this->raiseEvent(LiCAS_EVENT_INTERFACE_DOWN, LiCAS_EVENT_SEVERITY_ERROR, 0, this->statistics.interfaceIndex);
+	}
+	else if(flagLinkUp == 1 && this->statistics.flagInterfaceDown == 1)
+	{
+		this->statistics.flagInterfaceDown = 0;
+		this->raiseEvent(LiCAS_EVENT_INTERFACE_UP, LiCAS_EVENT_SEVERITY_INFO, 0, this->statistics.interfaceIndex);
+		this->reestablishLink();
+	}
+}
+
+
+/*
+ * Callback of the link monitor executed by the reactor
+ */
+void LiCAS_ECI_UDP::reactorLinkMonitorCallback(int, uint32_t, void * userData)
+{
+	((LiCAS_ECI_UDP*)userData)->updateInterfaceState();
+}
+
+
+/*
+ * Re-establish the link when the network interface is up again: the sender socket is connected
+ * again (so it takes the route of the interface), the last feedback rate request is sent again (the
+ * board may have restarted with its default rate) and the next command is sent at full rate. If the
+ * socket can not be connected (no route yet) the link is down until the feedback is received again.
+ */
+void LiCAS_ECI_UDP::reestablishLink()
+{
+	if(connect(this->socketSender, (struct sockaddr*)&addrHost, sizeof(struct sockaddr_in)) != 0)
+	{
+		if(this->statistics.flagLinkDown == 0)
+		{
+			this->statistics.flagLinkDown = 1;
+			this->statistics.numLinkDown++;
+		}
+		this->raiseEvent(LiCAS_EVENT_RECONNECT, LiCAS_EVENT_SEVERITY_ERROR, errno, this->statistics.interfaceIndex);
+	}
+	else if(this->statistics.feedbackRate > 0)
+	{
+		this->lastFeedbackRateRequest.timeStamp = this->getElapsedTime();
+		if(sendto(this->socketSender, (char*)&this->lastFeedbackRateRequest, sizeof(LiCAS_FEEDBACK_RATE_DATA_PACKET), 0, (struct sockaddr*)&addrHost, sizeof(struct sockaddr)) < 0)
+			this->raiseEvent(LiCAS_EVENT_FEEDBACK_RATE_SEND, LiCAS_EVENT_SEVERITY_ERROR, errno, 0);
+	}
+	
+	this->flagCommandChanged = 1;
+	if(this->statistics.flagIdle == 1)
+		this->wakeupRxThread();
+}
+
+
+/*
+ * Update the time of the last data packet received
+ */
+void LiCAS_ECI_UDP::updateReceptionTime()
+{
+	float t = getElapsedTime();
+	
+	
+	elapsedTimeLastUpdate = t - t_lastUpdate;
+	t_lastUpdate = t;
+}
+
+
+/*
+ * Copy the received feedback data packet on the public variables
+ */
+void LiCAS_ECI_UDP::processFeedbackPacket(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback)
+{
+	int k = 0;
+	
+	
+	for(k = 0; k < 3; k++)
+	{
+		this->pL[k] = dataPacketFeedback->pL[k];
+		this->pR[k] = dataPacketFeedback->pR[k];
+	}
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		this->qL[k] = dataPacketFeedback->qL[k];
+		this->qR[k] = dataPacketFeedback->qR[k];
+		this->dqL[k] = dataPacketFeedback->dqL[k];
+		this->dqR[k] = dataPacketFeedback->dqR[k];
+		this->tauL[k] = dataPacketFeedback->tauL[k];
+		this->tauR[k] = dataPacketFeedback->tauR[k];
+		this->pwmL[k] = dataPacketFeedback->pwmL[k];
+		this->pwmR[k] = dataPacketFeedback->pwmR[k];
+	}
+	
+	this->statistics.numFeedbackPackets++;
+	
+	// Set the feedback received float
+	this->flagFeedbackReceived = 1;
+}
+
+
+/*
+ * Save the last feedback received on the log file
+ */
+void LiCAS_ECI_UDP::logFeedback()
+{
+	int k = 0;
+	
+	
+	// Save data on log file
+	if(LiCAS_DataLogFile != NULL)
+	{
+		fprintf(LiCAS_DataLogFile, "%g\t", getElapsedTime());
+		for(k = 0; k < 3; k++)
+			fprintf(LiCAS_DataLogFile, "%g\t", pL[k]);
+		for(k = 0; k < 3; k++)
+			fprintf(LiCAS_DataLogFile, "%g\t", pR[k]);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(LiCAS_DataLogFile, "%g\t", qL[k]);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(LiCAS_DataLogFile, "%g\t", qR[k]);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(LiCAS_DataLogFile, "%g\t", dqL[k]);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(LiCAS_DataLogFile, "%g\t", dqR[k]);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(LiCAS_DataLogFile, "%g\t", tauL[k]);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(LiCAS_DataLogFile, "%g\t", tauR[k]);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(LiCAS_DataLogFile, "%g\t", pwmL[k]);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(LiCAS_DataLogFile, "%g\t", pwmR[k]);
+		fprintf(LiCAS_DataLogFile, "\n");
+	}
+	
+	this->statistics.numLogLines++;
+}
+
+
+/*
+ * Idle detection: the interface enters in idle mode when the commands have not changed and the
+ * feedback has been stationary during the idle detection time, and leaves it on the first change.
+ */
+void LiCAS_ECI_UDP::updateIdleState(float t)
+{
+	int flagMotion = 0;
+	int k = 0;
+	
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		if(fabsf(this->dqL[k]) > IDLE_JOINT_SPEED_THRESHOLD || fabsf(this->dqR[k]) > IDLE_JOINT_SPEED_THRESHOLD ||
+			fabsf(this->qL[k] - this->qL_idleCheck[k]) > IDLE_JOINT_POS_THRESHOLD || fabsf(this->qR[k] - this->qR_idleCheck[k]) > IDLE_JOINT_POS_THRESHOLD)
+			flagMotion = 1;
+		this->qL_idleCheck[k] = this->qL[k];
+		this->qR_idleCheck[k] = this->qR[k];
+	}
+	
+	if(flagMotion == 1 || this->flagCommandChanged == 1 || this->flagIdlePolicyEnabled == 0)
+	{
+		this->flagCommandChanged = 0;
+		this->t_lastActivity = t;
+		if(this->statistics.flagIdle == 1)
+		{
+			this->statistics.timeIdle += t - this->t_idleStart;
+			this->statistics.flagIdle = 0;
+		}
+	}
+	else if(this->statistics.flagIdle == 0 && t - this->t_lastActivity > this->idleDetectionTime)
+	{
+		this->t_idleStart = t;
+		this->statistics.flagIdle = 1;
+	}
+}
+
+
+void LiCAS_ECI_UDP::udpRxThreadFunction()
+{
+	struct pollfd pollFds[3 + MAX_MULTIPATH_PATHS];
+	struct msghdr message;
+	struct iovec messageData;
+	struct timespec t_deadline;
+	struct timespec t_wakeup;
+	struct timespec t_wakeupReal;
+	int socketReceiver = -1;
+	int threadIndex = -1;
+	int dataReceived = 0;
+	int numPackets = 0;
+	int numEvents = 0;
+	int timeout_ms = 0;
+	int numRxPaths = 1;
+	int k = 0;
+	uint64_t eventValue = 0;
+	char buffer[1024];
+	char controlBuffer[256];
+	
+	uint64_t allocationsArmed = 0;
+	int flagAllocationsArmed = 0;
+	
+	uint64_t wakeupsWindow = 0;
+	float t_window = 0;
+	float t = 0;
+	
+	int errorCode = 0;
+	
+	
+	// Open the socket in datagram mode
+	socketReceiver = this->openRxSocket();
+	if(socketReceiver < 0)
+		errorCode = 1;
+	
+	// Thread accounting
+	pthread_setname_np(pthread_self(), "eci_rx");
+	threadIndex = this->threadAccounting.getThreadIndex("eci_rx", 0);
+	
+	// Message for receiving the feedback data packets along with their time stamp
+	messageData.iov_base = buffer;
+	messageData.iov_len = sizeof(buffer);
+	bzero(&message, sizeof(message));
+	message.msg_iov = &messageData;
+	message.msg_iovlen = 1;
+	
+	// The thread sleeps until a feedback data packet, a wake-up event (new command, termination), an
+	// error of the sender socket (POLLERR is always reported), a link notification or a data packet of
+	// the other paths of the multipath transport is received
+	pollFds[0].fd = this->wakeupEventFd;
+	pollFds[0].events = POLLIN;
+	pollFds[1].fd = this->socketSender;
+	pollFds[1].events = 0;
+	pollFds[2].fd = -1;
+	pollFds[2].events = POLLIN;
+	pollFds[3].fd = socketReceiver;
+	pollFds[3].events = POLLIN;
+	
+	/******************************** THREAD LOOP START ********************************/
+	
+	while(errorCode == 0 && flagTerminateThread == 0)
+	{
+		// Take the allocation count of this thread when the link is established
+		if(flagAllocationsArmed == 0 && this->flagHotPathArmed == 1)
+		{
+			allocationsArmed = LiCAS_ECI_AllocTracker::getThreadAllocations();
+			flagAllocationsArmed = 1;
+		}
+		
+		// In idle mode the receiver sockets are not polled: the thread only wakes up once per idle
+		// period (draining the feedback received meanwhile) or when a new command is sent
+		if(this->statistics.flagIdle == 1)
+			timeout_ms = (int)(1000*this->idleWakeupPeriod);
+		else
+			timeout_ms = (int)fminf(RX_THREAD_TIMEOUT_MS, ceilf(1000*this->feedbackTimeout));
+		// Socket of the link monitor (ignored by poll while it is not open) and receiver sockets of the paths
+		pollFds[2].fd = this->linkMonitor.getSocket();
+		numRxPaths = __atomic_load_n(&this->numPaths, __ATOMIC_ACQUIRE);
+		for(k = 1; k < numRxPaths; k++)
+		{
+			pollFds[3 + k].fd = this->pathSocketReceiver[k];
+			pollFds[3 + k].events = POLLIN;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &t_deadline);
+		numEvents = poll(pollFds, (this->statistics.flagIdle == 1) ? 3 : 3 + numRxPaths, timeout_ms);
+		clock_gettime(CLOCK_MONOTONIC, &t_wakeup);
+		clock_gettime(CLOCK_REALTIME, &t_wakeupReal);
+		
+		this->statistics.numRxWakeups++;
+		wakeupsWindow++;
+		
+		// Wake-up latency on timeout w.r.t. the end of the timeout
+		if(numEvents == 0)
+			this->threadAccounting.updateWakeupLatency(threadIndex, (t_wakeup.tv_sec - t_deadline.tv_sec) + 1e-9*(t_wakeup.tv_nsec - t_deadline.tv_nsec) - 1e-3*timeout_ms);
+		
+		// Clear the wake-up event
+		if(read(this->wakeupEventFd, &eventValue, sizeof(eventValue)) < 0)
+			eventValue = 0;
+		
+		// Errors of the sender socket (computer board unreachable)
+		if(numEvents > 0 && (pollFds[1].revents & POLLERR) != 0)
+			this->drainSendErrors(this->socketSender);
+		
+		// Link notifications of the network interface
+		if(numEvents > 0 && (pollFds[2].revents & POLLIN) != 0)
+			this->updateInterfaceState();
+		
+		// Process all the data packets received since the last wake-up
+		numPackets = 0;
+		message.msg_control = controlBuffer;
+		message.msg_controllen = sizeof(controlBuffer);
+		while((dataReceived = recvmsg(socketReceiver, &message, 0)) >= 0)
+		{
+			// Wake-up latency on packet reception w.r.t. the arrival of the first packet
+			if(numPackets == 0 && numEvents > 0 && this->statistics.flagIdle == 0)
+				accountPacketLatency(&this->threadAccounting, threadIndex, &message, &t_wakeupReal);
+			message.msg_control = controlBuffer;
+			message.msg_controllen = sizeof(controlBuffer);
+			
+			this->dispatchPacket(buffer, dataReceived);
+			numPackets++;
+		}
+		
+		// Copies of the data packets received over the other paths
+		for(k = 1; k < numRxPaths; k++)
+		{
+			while((dataReceived = recv(this->pathSocketReceiver[k], buffer, sizeof(buffer), 0)) >= 0)
+			{
+				this->dispatchPacket(buffer, dataReceived);
+				numPackets++;
+			}
+		}
+		
+		// In idle mode only the last feedback data packet of each idle wake-up period is logged
+		t = getElapsedTime();
+		if(this->flagPendingLog == 1 && t - this->t_lastIdleLog >= this->idleWakeupPeriod)
+		{
+			this->logFeedback();
+			this->flagPendingLog = 0;
+			this->t_lastIdleLog = t;
+		}
+		
+		this->updateIdleState(t);
+		this->checkFeedbackWatchdog(t);
+		
+		// Wake-ups per second and CPU usage of the reception thread
+		if(t - t_window >= 1)
+		{
+			this->threadAccounting.updateCpuStatistics(threadIndex);
+			this->statistics.rxWakeupsPerSecond = wakeupsWindow/(t - t_window);
+			wakeupsWindow = 0;
+			t_window = t;
+		}
+	}
+	
+	/******************************** THREAD LOOP END ********************************/
+	
+	// Allocations made by this thread while the link was established
+	if(flagAllocationsArmed == 1)
+		this->rxHotPathAllocations = LiCAS_ECI_AllocTracker::getThreadAllocations() - allocationsArmed;
+	
+	// Close the socket
+	if(errorCode == 0)
+		close(socketReceiver);
+	this->socketReceiverActive = -1;
+	this->flagRxThreadTerminated = 1;
+}
+
+
+
+/*
+ * Open the receiver socket of the feedback data packets (non blocking, with the kernel reception
+ * time stamp). Returns the socket, or -1 on error.
+ */
+int LiCAS_ECI_UDP::openRxSocket()
+{
+	struct sockaddr_in addrReceiver;
+	int socketReceiver = -1;
+	int enable = 1;
+	
+	
+	// Open the socket in datagram mode
+	socketReceiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if(socketReceiver < 0) 
+		this->raiseEvent(LiCAS_EVENT_RX_SOCKET, LiCAS_EVENT_SEVERITY_ERROR, errno, 0);
+	else
+	{
+		// Set listenning address (any) and port
+		bzero((char*)&addrReceiver, sizeof(struct sockaddr_in));
+		addrReceiver.sin_family = AF_INET;
+		addrReceiver.sin_addr.s_addr = INADDR_ANY;
+		addrReceiver.sin_port = htons(this->UDP_RxPort);
+	
+		// Associates the address to the socket
+		if(bind(socketReceiver, (struct sockaddr*)&addrReceiver, sizeof(addrReceiver)) < 0)
+		{
+			this->raiseEvent(LiCAS_EVENT_RX_BIND, LiCAS_EVENT_SEVERITY_ERROR, errno, this->UDP_RxPort);
+			close(socketReceiver);
+			socketReceiver = -1;
+		}
+		else
+		{
+			// Set the socket as non blocking
+			fcntl(socketReceiver, F_SETFL, O_NONBLOCK);
+			
+			// Kernel reception time stamp of the packets, used for measuring the wake-up latency
+			setsockopt(socketReceiver, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+			
+			// The receive buffer is adapted to the feedback rate acknowledged
+			this->socketReceiverActive = socketReceiver;
+			if(this->statistics.feedbackRate > 0)
+				this->adaptRxBuffer(this->statistics.feedbackRate);
+		}
+	}
+	
+	
+	return socketReceiver;
+}
+
+
+/*
+ * Dispatch a received data packet to its handler according to its packetID and size
+ */
+void LiCAS_ECI_UDP::dispatchPacket(const char * buffer, int size)
+{
+	int packetIndex = -1;
+	
+	
+	// Data packet received over several paths: only its first copy is dispatched
+	if(this->multipath.isWrapped(buffer, size) == 1)
+	{
+		packetIndex = this->multipath.acceptPacket(buffer, size, this->getElapsedTime());
+		if(packetIndex == 1)
+			this->dispatchPacket(buffer + sizeof(LiCAS_MULTIPATH_HEADER), size - sizeof(LiCAS_MULTIPATH_HEADER));
+		else if(packetIndex < 0)
+			this->statistics.numUnknownPackets++;
+		return;
+	}
+	
+	packetIndex = LiCAS_ECI_RX_PACKET_TABLE::dispatch(this, buffer, size);
+	if(packetIndex < 0)
+		this->statistics.numUnknownPackets++;
+	else
+	{
+		this->statistics.rxPackets[packetIndex].numPackets++;
+		this->statistics.rxPackets[packetIndex].t_lastPacket = this->t_lastUpdate;
+	}
+}
+
+
+/*
+ * Callback of the receiver socket executed by the reactor
+ */
+void LiCAS_ECI_UDP::reactorRxCallback(int fd, uint32_t, void * userData)
+{
+	((LiCAS_ECI_UDP*)userData)->reactorRxFunction(fd);
+}
+
+
+/*
+ * Process all the data packets received since the last wake-up of the reactor
+ */
+void LiCAS_ECI_UDP::reactorRxFunction(int fd)
+{
+	LiCAS_ECI_ThreadAccounting * threadAccounting = this->reactor->getThreadAccounting();
+	uint64_t allocations = LiCAS_ECI_AllocTracker::getThreadAllocations();
+	int flagHotPathArmed = this->flagHotPathArmed;
+	struct msghdr message;
+	struct iovec messageData;
+	struct timespec t_wakeupReal;
+	int dataReceived = 0;
+	int numPackets = 0;
+	char buffer[1024];
+	char controlBuffer[256];
+	
+	
+	clock_gettime(CLOCK_REALTIME, &t_wakeupReal);
+	this->statistics.numRxWakeups++;
+	
+	messageData.iov_base = buffer;
+	messageData.iov_len = sizeof(buffer);
+	bzero(&message, sizeof(message));
+	message.msg_iov = &messageData;
+	message.msg_iovlen = 1;
+	message.msg_control = controlBuffer;
+	message.msg_controllen = sizeof(controlBuffer);
+	while((dataReceived = recvmsg(fd, &message, 0)) >= 0)
+	{
+		// Wake-up latency of the reactor thread w.r.t. the arrival of the first packet
+		if(numPackets == 0 && threadAccounting != NULL)
+			accountPacketLatency(threadAccounting, threadAccounting->findThread(), &message, &t_wakeupReal);
+		message.msg_control = controlBuffer;
+		message.msg_controllen = sizeof(controlBuffer);
+		
+		this->dispatchPacket(buffer, dataReceived);
+		numPackets++;
+	}
+	
+	// Account the allocations made by the receive path once the link is established
+	if(flagHotPathArmed == 1)
+		this->rxHotPathAllocations += LiCAS_ECI_AllocTracker::getThreadAllocations() - allocations;
+}
+
+
+/*
+ * Account the wake-up latency of a thread w.r.t. the arrival of a data packet, given by its kernel
+ * reception time stamp (SO_TIMESTAMPNS)
+ *
+ * Parameters:
+ * 	(1) Thread accounting
+ * 	(2) Index of the thread (ignored if negative)
+ * 	(3) Message received, with the control data
+ * 	(4) Wake-up time of the thread (CLOCK_REALTIME)
+ */
+void LiCAS_ECI_UDP::accountPacketLatency(LiCAS_ECI_ThreadAccounting * threadAccounting, int threadIndex, struct msghdr * message, const struct timespec * t_wakeupReal)
+{
+	struct cmsghdr * cmsg;
+	struct timespec * t_packet;
+	
+	
+	for(cmsg = CMSG_FIRSTHDR(message); cmsg != NULL; cmsg = CMSG_NXTHDR(message, cmsg))
+	{
+		if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+		{
+			t_packet = (struct timespec*)CMSG_DATA(cmsg);
+			threadAccounting->updateWakeupLatency(threadIndex, (t_wakeupReal->tv_sec - t_packet->tv_sec) + 1e-9*(t_wakeupReal->tv_nsec - t_packet->tv_nsec));
+		}
+	}
+}
+
+	
+/*
+ * Close the UDP socket interface
+ */
+int LiCAS_ECI_UDP::closeInterface()
+{
+	int errorCode = 0;
+	float timer = 0;
+	int k = 0;
+	
+	
+	this->flagTerminateThread = 1;
+	if(this->reactor != NULL)
+	{
+		// Reception executed by the reactor (already stopped)
+		this->reactor->removeDescriptor(this->socketReceiverReactor);
+		close(this->socketReceiverReactor);
+		this->socketReceiverReactor = -1;
+		this->socketReceiverActive = -1;
+		this->reactor->removeDescriptor(this->socketSender);
+		if(this->linkMonitor.getSocket() >= 0)
+			this->reactor->removeDescriptor(this->linkMonitor.getSocket());
+		for(k = 1; k < this->numPaths; k++)
+			this->reactor->removeDescriptor(this->pathSocketReceiver[k]);
+		if(this->reactor->getThreadAccounting() == &this->threadAccounting)
+			this->reactor->setThreadAccounting(NULL);
+		if(this->watchdogTimerFd >= 0)
+		{
+			this->reactor->removeDescriptor(this->watchdogTimerFd);
+			close(this->watchdogTimerFd);
+			this->watchdogTimerFd = -1;
+		}
+		this->reactor = NULL;
+		this->flagRxThreadTerminated = 1;
+	}
+	else if(this->wakeupRxThread() != 0)
+		usleep(10000);	// Waits 10 ms to termiante thread
+	
+	// Close sender socket
+	close(this->socketSender);
+	this->socketSender = -1;
+	
+	this->raiseEvent(LiCAS_EVENT_CLOSING, LiCAS_EVENT_SEVERITY_INFO, 0, 0);
+	while(this->flagRxThreadTerminated == 0 && timer < 1)
+	{
+		usleep(10000);
+		timer += 0.01;
+	}
+	
+	if(timer >= 1)
+	{
+		errorCode = 1;
+		this->raiseEvent(LiCAS_EVENT_RX_THREAD_TERMINATION, LiCAS_EVENT_SEVERITY_ERROR, 0, 0);
+	}
+	else
+	{
+		close(this->wakeupEventFd);
+		this->wakeupEventFd = -1;
+		
+		// Close the link monitor once the reception thread does not poll it anymore
+		this->linkMonitor.close();
+		this->statistics.interfaceIndex = 0;
+		this->statistics.flagInterfaceDown = 0;
+		
+		// Close the sockets of the paths of the multipath transport
+		for(k = 1; k < this->numPaths; k++)
+		{
+			close(this->pathSocketSender[k]);
+			close(this->pathSocketReceiver[k]);
+			this->pathSocketSender[k] = -1;
+			this->pathSocketReceiver[k] = -1;
+		}
+		this->numPaths = 1;
+		this->multipath.setNumPaths(1);
+		
+		// Close log file once the reception thread does not use it anymore
+		if(this->LiCAS_DataLogFile != NULL)
+		{
+			fclose(this->LiCAS_DataLogFile);
+			this->LiCAS_DataLogFile = NULL;
+		}
+		if(this->logBuffer != NULL)
+		{
+			delete [] this->logBuffer;
+			this->logBuffer = NULL;
+		}
+		
+		this->raiseEvent(LiCAS_EVENT_CLOSED, LiCAS_EVENT_SEVERITY_INFO, 0, 0);
+	}
+	
+	// Check that the send and receive paths did not allocate memory during the session
+	if(this->flagHotPathArmed == 1 && LiCAS_ECI_AllocTracker::isEnabled() && this->getHotPathAllocations() != 0)
+	{
+		errorCode = 2;
+		this->raiseEvent(LiCAS_EVENT_HOT_PATH_ALLOCATIONS, LiCAS_EVENT_SEVERITY_ERROR, 0, (int64_t)this->getHotPathAllocations());
+	}
+	this->flagHotPathArmed = 0;
+	
+	// Deliver the pending events and stop the events thread
+	this->stopEventThread();
+	
 	
 	return errorCode;
 }
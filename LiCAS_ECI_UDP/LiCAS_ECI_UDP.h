@@ -23,11 +23,14 @@
 
 
 // Standard library
+#ifndef LICAS_ECI_LEAN
 #include <iostream>
 #include <thread>
 #include <fstream>
+#endif
 #include <string>
 #include <string.h>
+#include <stdio.h>
 #include <stdint.h>
 #include <unistd.h>
 #include <sys/time.h>
@@ -35,14 +38,97 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netdb.h>
+#include <linux/errqueue.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <math.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <sys/resource.h>
+
+
+// Specific library
+#include "LiCAS_ECI_Packets.h"
+#include "LiCAS_ECI_AllocTracker.h"
+#include "LiCAS_ECI_EventRing.h"
+#include "LiCAS_ECI_Dispatch.h"
+#include "LiCAS_ECI_Reactor.h"
+#include "LiCAS_ECI_LinkMonitor.h"
+#include "LiCAS_ECI_Multipath.h"
+#include "LiCAS_ECI_ThreadAccounting.h"
 
 
 // Constant definition
-#define NUM_ARM_JOINTS	4	// Number of joints of each arm
+#define LOG_BUFFER_SIZE	65536	// Size of the data log file buffer preallocated at open time in [bytes]
+#define RX_THREAD_TIMEOUT_MS	100		// Maximum sleep time of the reception thread at full rate in [ms]
+#define IDLE_JOINT_SPEED_THRESHOLD	0.01	// Joint speed below which the feedback is stationary in [rad/s]
+#define IDLE_JOINT_POS_THRESHOLD	0.001	// Joint position change below which the feedback is stationary in [rad]
+#define MAX_RX_PACKET_TYPES	8	// Maximum number of entries of the reception dispatch table
+#define FEEDBACK_WATCHDOG_TIMEOUT	0.5		// Watchdog timeout of the feedback before a feedback rate is acknowledged in [s]
+#define FEEDBACK_WATCHDOG_PERIODS	10		// Watchdog timeout of the feedback in periods of the acknowledged feedback rate
+#define FEEDBACK_WATCHDOG_MIN_TIMEOUT	0.02	// Minimum watchdog timeout of the feedback in [s]
+#define FEEDBACK_RATE_RETRY_PERIOD	0.05	// Period of the retransmission of a feedback rate request in [s]
+#define RX_BUFFER_TIME		0.25	// Time of feedback held by the receive buffer of the socket in [s]
+#define RX_BUFFER_PACKET_SIZE	1024	// Receive buffer space taken by each datagram, including the kernel overhead in [bytes]
+#define RX_BUFFER_MIN_SIZE	16384	// Minimum receive buffer of the socket in [bytes]
+
+
+// Dispatch table of the data packets received from the LiCAS computer board. New packet types are
+// added with an entry here and a handlePacket() overload in the LiCAS_ECI_UDP class.
+typedef LiCAS_PacketTable<
+	LiCAS_PacketEntry<LiCAS_FEEDBACK_DATA_PACKET, LiCAS_PACKET_ID_FEEDBACK>,
+	LiCAS_PacketEntry<LiCAS_STATUS_DATA_PACKET, LiCAS_PACKET_ID_STATUS>,
+	LiCAS_PacketEntry<LiCAS_DIAGNOSTICS_DATA_PACKET, LiCAS_PACKET_ID_DIAGNOSTICS>,
+	LiCAS_PacketEntry<LiCAS_FEEDBACK_RATE_ACK_DATA_PACKET, LiCAS_PACKET_ID_FEEDBACK_RATE_ACK>,
+	LiCAS_PacketEntry<LiCAS_FEEDBACK_DATA_PACKET, LiCAS_PACKET_ID_FEEDBACK, true>	// Feedback from boards not setting the packetID
+> LiCAS_ECI_RX_PACKET_TABLE;
+
+static_assert(LiCAS_ECI_RX_PACKET_TABLE::numEntries <= MAX_RX_PACKET_TYPES, "Too many entries in the dispatch table");
 
 
+// Callback executed by the reception thread for each feedback data packet (t: time of the interface in [s])
+typedef void (*LiCAS_ECI_FeedbackCallback)(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t, void * userData);
+
+
+// Statistics of the interface
+typedef struct
+{
+	uint64_t numFeedbackPackets;	// Number of feedback data packets received
+	uint64_t numLogLines;			// Number of lines written in the data log file
+	uint64_t numRxWakeups;			// Number of wake-ups of the reception thread
+	uint64_t numEventNotifyErrors;	// Number of events that could not be notified to the events thread
+	uint64_t numDeferredEvents;		// Number of events raised while the events thread was not running
+	uint64_t numUnknownPackets;		// Number of data packets received not matching any packet type
+	int numRxPacketTypes;			// Number of entries of the reception dispatch table
+	LiCAS_ECI_PACKET_STATISTICS rxPackets[MAX_RX_PACKET_TYPES];	// Statistics of each packet type
+	float rxWakeupsPerSecond;		// Wake-ups per second of the reception thread (last second)
+	float timeIdle;					// Total time in idle mode in [s]
+	int flagIdle;					// 1 if the interface is in idle mode (adaptive scheduling)
+	float feedbackRate;				// Feedback rate acknowledged by the computer board in [Hz] (0 if not negotiated)
+	uint8_t feedbackChannels;		// Channels of the feedback data packet acknowledged (LiCAS_FEEDBACK_CHANNEL_...)
+	float feedbackRateMeasured;		// Feedback data packets received per second (last second)
+	float feedbackTimeout;			// Watchdog timeout of the feedback in [s]
+	uint64_t numFeedbackTimeouts;	// Number of watchdog timeouts of the feedback
+	int rxBufferSize;				// Receive buffer of the socket in [bytes] (0 if not adapted to the feedback rate)
+	int flagLinkDown;				// 1 if the computer board is unreachable, until a feedback data packet is received
+	uint64_t numLinkDown;			// Number of link down events (ICMP errors of the sender socket)
+	int interfaceIndex;				// Index of the network interface monitored (0 if the link monitor is not open)
+	int flagInterfaceDown;			// 1 if the network interface to the computer board is down (hold mode)
+	uint64_t numInterfaceDown;		// Number of interface down events of the link monitor
+	uint64_t numHeldCommands;		// Number of command data packets held (not sent over the primary path) while the interface is down
+	int numPaths;					// Number of paths of the multipath transport (1 if not enabled)
+	LiCAS_ECI_PATH_STATISTICS paths[MAX_MULTIPATH_PATHS];	// Statistics of each path (commands sent, feedback received)
+	int numThreads;					// Number of threads accounted
+	LiCAS_ECI_THREAD_STATISTICS threads[MAX_ECI_THREADS];	// Statistics of each thread
+} LiCAS_ECI_STATISTICS;
+
+
+// The lean build (LICAS_ECI_LEAN) does not inject the std namespace into the includers
+#ifndef LICAS_ECI_LEAN
 using namespace std;
+#endif
 
 
 class LiCAS_ECI_UDP
@@ -64,6 +150,9 @@ public:
 	float t_lastUpdate;				// Instance time since last update
 	float elapsedTimeLastUpdate;	// Elapsed time since last update
 	
+	LiCAS_STATUS_DATA_PACKET boardStatus;				// Last status data packet received
+	LiCAS_DIAGNOSTICS_DATA_PACKET boardDiagnostics;	// Last diagnostics data packet received
+	
 	
 	/***************** PUBLIC METHODS *****************/
 	
@@ -73,9 +162,9 @@ public:
 	 * Parameters:
 	 * 	(1) Name of the LiCAS interface (example: "LiCAS-A1")
 	 * */
-	LiCAS_ECI_UDP(const string &_LiCAS_Interface_Name);
-
-
+	LiCAS_ECI_UDP(const std::string &_LiCAS_Interface_Name);
+	
+	
 	/*
 	 * Destructor
 	 * */
@@ -84,13 +173,67 @@ public:
 	
 	/*
 	 * Open the UDP socket interface for sending/receiving data to/from the LiCAS computer board.
+	 * Error codes: 1: could not open the sender socket, 2: could not get the host or connect, 3:
+	 * could not start the reception, 4: could not start the events thread.
 	 *
 	 * Parameters:
 	 * 	(1) IP address of the computer board executing the LiCAS control program
 	 *	(2) UDP port for sending the control references to the LiCAS control program
 	 *	(3) UDP port for receiving the feedback data packet from the LiCAS control program
 	 */
-	int openUDPInterface(const string &_LiCAS_IP_Address, int _UDP_TxPort, int _UDP_RxPort);
+	int openUDPInterface(const std::string &_LiCAS_IP_Address, int _UDP_TxPort, int _UDP_RxPort);
+	
+	
+	/*
+	 * Open the UDP socket interface with the reception executed by a reactor instead of the own
+	 * reception thread, so several interfaces (for example the master and slave arms of a bilateral
+	 * teleoperation) share one thread. The receiver socket is added to the reactor, which must not
+	 * be running yet, and the reactor must be stopped before closing the interface. The adaptive
+	 * scheduling is not applied in this mode.
+	 *
+	 * Parameters:
+	 * 	(1) IP address of the computer board executing the LiCAS control program
+	 *	(2) UDP port for sending the control references to the LiCAS control program
+	 *	(3) UDP port for receiving the feedback data packet from the LiCAS control program
+	 *	(4) Reactor that executes the reception (NULL for the own reception thread)
+	 */
+	int openUDPInterface(const std::string &_LiCAS_IP_Address, int _UDP_TxPort, int _UDP_RxPort, LiCAS_ECI_Reactor * _reactor);
+	
+	
+	/*
+	 * Open the monitor of the link state of the network interface to the LiCAS computer board
+	 * (optional). The loss of the Ethernet carrier or of the Wi-Fi association is notified by the
+	 * kernel (rtnetlink) and detected immediately, without waiting for the feedback watchdog. While
+	 * the interface is down the interface is in hold mode: the commands are not sent over the
+	 * primary path (the one of openUDPInterface(), whose interface is monitored) so the references
+	 * of the control loop do not reach the arms late. With the multipath transport the commands are
+	 * still sent over the other paths, and error code 3 is returned only if no copy is sent. When
+	 * the interface is up again, the sender socket is connected again, the last feedback rate
+	 * request is sent again and the next command is sent at full rate. It must be called after
+	 * openUDPInterface(), and before starting the reactor if the reception is executed by a reactor.
+	 *
+	 * Parameters:
+	 * 	(1) Name of the network interface (NULL: interface of the route to the computer board)
+	 */
+	int openLinkMonitor(const char * interfaceName);
+	
+	
+	/*
+	 * Add a path to the multipath redundant transport, for example a LTE or mesh radio link in
+	 * addition to the Wi-Fi (the path of openUDPInterface() is the primary one, path 0). Each
+	 * command data packet is sent over all the paths, inside an envelope with a sequence number,
+	 * and the first copy of each data packet received from the computer board is delivered while the
+	 * others are discarded. The paths must be added in the same order in the computer board. The
+	 * loss rate and latency of each path are given in the statistics. It must be called after
+	 * openUDPInterface(), and before starting the reactor if the reception is executed by a reactor.
+	 *
+	 * Parameters:
+	 * 	(1) IP address of the computer board through the path
+	 *	(2) UDP port for sending the control references through the path
+	 *	(3) UDP port for receiving the feedback data packet through the path
+	 *	(4) Network interface of the path (NULL: given by the route to the computer board)
+	 */
+	int addPath(const std::string &_LiCAS_IP_Address, int _UDP_TxPort, int _UDP_RxPort, const char * interfaceName);
 	
 	
 	/*
@@ -115,6 +258,185 @@ public:
 	int sendTCPPositionRef(float * pLref, float * pRref, float playTime);
 	
 	
+	/*
+	 * Send joint torque references to the LiCAS dual arm (for example the effort reflected on the
+	 * master arm of a bilateral teleoperation). They are not considered as command changes by the
+	 * adaptive scheduling.
+	 *
+	 * Parameters:
+	 * 	(1) Left arm joint torque in [Nm]
+	 * 	(2) Right arm joint torque in [Nm]
+	 */
+	int sendJointTorqueRef(float * tauLref, float * tauRref);
+	
+	
+	/*
+	 * Send a chunk of future joint position setpoints of a trajectory. The computer board buffers
+	 * the setpoints and follows them at their time (interpolating between them), so the jitter and
+	 * the loss of packets are absorbed if the chunks sent in consecutive periods overlap. A chunk
+	 * overwrites the setpoints with the same index that are still buffered.
+	 *
+	 * Parameters:
+	 * 	(1) Index of the first setpoint of the chunk in the trajectory (see startTrajectory())
+	 * 	(2) Setpoints, with their time in the clock of the interface (see getElapsedTime())
+	 * 	(3) Number of setpoints (up to MAX_CHUNK_SETPOINTS)
+	 */
+	int sendJointTrajectoryChunk(uint32_t firstIndex, const LiCAS_TRAJECTORY_SETPOINT * setpoints, int numSetpoints);
+	
+	
+	/*
+	 * Send a chunk of future TCP position setpoints of a trajectory (first 3 values of the
+	 * references of each arm). See sendJointTrajectoryChunk().
+	 */
+	int sendTCPTrajectoryChunk(uint32_t firstIndex, const LiCAS_TRAJECTORY_SETPOINT * setpoints, int numSetpoints);
+	
+	
+	/*
+	 * Start a new trajectory: the computer board discards the setpoints buffered when it receives
+	 * the first chunk of the new trajectory, whose setpoint indices start again.
+	 */
+	void startTrajectory();
+	
+	
+	/*
+	 * Request the rate and channels of the feedback data packet to the LiCAS computer board, for
+	 * example 20 Hz of joint positions for monitoring or 500 Hz of all the channels for contact
+	 * tasks. The request is sent again until it is acknowledged or the timeout expires. On the
+	 * acknowledgment, the receive buffer of the socket, the watchdog timeout of the feedback and the
+	 * statistics are adapted to the rate applied by the board, which may be the nearest one it
+	 * supports. Do not call it from a real-time thread (it blocks until the acknowledgment).
+	 *
+	 * Parameters:
+	 * 	(1) Rate of the feedback data packet in [Hz]
+	 * 	(2) Channels of the feedback data packet (LiCAS_FEEDBACK_CHANNEL_..., the others are zero)
+	 * 	(3) Timeout of the acknowledgment in [s]
+	 */
+	int requestFeedbackRate(float rate, uint8_t channels, float timeout);
+	
+	
+	/*
+	 * Configure the adaptive scheduling policy. When enabled, the interface enters in idle mode if the
+	 * commands do not change and the feedback is stationary. In idle mode the receiver sockets are not
+	 * polled: the reception thread wakes up once per idle wake-up period, processing the feedback
+	 * received meanwhile and logging the last one. It returns to full rate immediately when a new
+	 * command is sent, or after one idle wake-up period if the motion is detected in the feedback.
+	 *
+	 * Parameters:
+	 * 	(1) Enable (1) or disable (0) the adaptive scheduling
+	 * 	(2) Time without command changes and with stationary feedback to enter in idle mode in [s]
+	 * 	(3) Wake-up period of the reception thread in idle mode in [s]
+	 */
+	void setIdlePolicy(int enable, float _idleDetectionTime, float _idleWakeupPeriod);
+	
+	
+	/*
+	 * Get the statistics of the interface.
+	 *
+	 * Parameters:
+	 * 	(1) Pointer to the structure where the statistics are copied
+	 */
+	void getStatistics(LiCAS_ECI_STATISTICS * _statistics);
+	
+	
+	/*
+	 * Print the last feedback received on the standard output. The reception thread does not print
+	 * the feedback, so call it from a low priority thread of the application at a low rate.
+	 */
+	void printFeedback();
+	
+	
+	/*
+	 * Export the statistics of the interface, including the CPU usage and scheduling latency of each
+	 * thread, in the Prometheus text format. The file is replaced atomically, so it can be read by
+	 * a metrics collector at any time. Do not call it from a real-time thread (it allocates memory).
+	 *
+	 * Parameters:
+	 * 	(1) Name of the metrics file
+	 */
+	int exportMetrics(const char * fileName);
+	
+	
+	/*
+	 * Set the callback that receives the events (errors, warnings, information) of the interface.
+	 * The events are raised without blocking from any thread and delivered by a low priority
+	 * thread. By default (NULL callback), the events are printed on the standard output. The events
+	 * raised while the interface is not open are delivered when it is opened or closed.
+	 *
+	 * Parameters:
+	 * 	(1) Callback function (NULL for printing the events on the standard output)
+	 * 	(2) Pointer passed to the callback
+	 */
+	void setEventCallback(LiCAS_ECI_EventCallback callback, void * userData);
+	
+	
+	/*
+	 * Set the callback executed by the reception thread for each feedback data packet received, after
+	 * updating the public variables (for example an online estimator, see LiCAS_PayloadEstimator). It
+	 * must be set before opening the interface, and it must not block nor allocate memory.
+	 *
+	 * Parameters:
+	 * 	(1) Callback function (NULL for no callback)
+	 * 	(2) Pointer passed to the callback
+	 */
+	void setFeedbackCallback(LiCAS_ECI_FeedbackCallback callback, void * userData);
+	
+	
+	/*
+	 * Register the calling thread as a control thread of the interface, so its CPU usage and the
+	 * wake-up latency of each command sent w.r.t. the previous one plus the control period are
+	 * accounted in the statistics. A thread sending commands without registering is registered the
+	 * first time it sends a command, without wake-up latency. It must be called after
+	 * openUDPInterface(), since the accounted threads are cleared when the interface is opened.
+	 *
+	 * Parameters:
+	 * 	(1) Name of the thread (up to 15 characters)
+	 * 	(2) Control period of the thread in [s]
+	 */
+	int registerControlThread(const char * name, float period);
+	
+	
+	/*
+	 * Account the CPU usage and wake-up latency of the threads of a reactor (the reactor thread and
+	 * the worker thread of its scheduler) in the statistics of this interface. It is done
+	 * automatically for the first interface opened with the reception executed by the reactor. It
+	 * must be called after openUDPInterface() and before starting the reactor and its scheduler.
+	 *
+	 * Parameters:
+	 * 	(1) Reactor whose threads are accounted
+	 */
+	void accountReactorThreads(LiCAS_ECI_Reactor * _reactor);
+	
+	
+	/*
+	 * Number of occurrences of an event code (LiCAS_EVENT_...)
+	 */
+	uint64_t getEventCount(uint16_t code);
+	
+	
+	/*
+	 * Number of events dropped because the event ring was full
+	 */
+	uint64_t getDroppedEventCount();
+	
+	
+	/*
+	 * Wait until the first feedback data packet is received from the LiCAS computer board.
+	 * From this moment and until closeInterface() is called, the send and receive paths are not
+	 * allowed to allocate memory (verified when built with LICAS_ECI_ALLOC_TRACKING).
+	 *
+	 * Parameters:
+	 * 	(1) Timeout in [s]
+	 */
+	int waitForLink(float timeout);
+	
+	
+	/*
+	 * Get the number of heap allocations made by the send and receive paths between waitForLink()
+	 * and closeInterface(). Only meaningful when built with the LICAS_ECI_ALLOC_TRACKING option.
+	 */
+	uint64_t getHotPathAllocations();
+	
+	
 	/*
 	 * Get the elapsed time since the creation of the interface instance
 	 */
@@ -129,63 +451,21 @@ public:
 
 private:
 
-	// NOTES
-	// -----
-	// Joint position in radians
-	// Joint speed in rad/s
-	// Joint torque in Nm
-	// PWM (pulse width modulation) in [-1, 1] range
-	// TCP position in m w.r.t. shoulder base joint
-	// TCP velocity in m/s w.r.t. shoulder base joint
-	// TCP force in N w.r.t. shoulder base joint
-
-	static const uint8_t LiCAS_CONTROL_MODE_JOINT_POS;	// Joint position control mode
-	static const uint8_t LiCAS_CONTROL_MODE_JOINT_SPD;	// Joint speed control mode
-	static const uint8_t LiCAS_CONTROL_MODE_JOINT_TRQ;	// Joint torque control mode
-	static const uint8_t LiCAS_CONTROL_MODE_TCP_POS;	// TCP position control mode
-	static const uint8_t LiCAS_CONTROL_MODE_TCP_VEL;	// TCP velocity control mode
-	static const uint8_t LiCAS_CONTROL_MODE_TCP_FRC;	// TCP force control mode
-	
-	typedef struct
-	{
-		uint8_t mode;
-		float playTime;
-		float refLTCP[3];					// Reference value left arm TCP
-		float refRTCP[3];					// Reference value right arm TCP
-		float refLJ[NUM_ARM_JOINTS];		// Reference value left arm joints
-		float refRJ[NUM_ARM_JOINTS];		// Reference value right arm joints
-		float timeStamp;
-	} __attribute__((packed)) LiCAS_CONTROL_REF_DATA_PACKET;
-	
-	
-	typedef struct
-	{
-		uint8_t packetID;
-		float pL[3];				// Cartesian position of left TCP in [m]
-		float pR[3];				// Cartesian position of right TCP in [m]
-		float qL[NUM_ARM_JOINTS];	// Joint position left arm in [rad]
-		float qR[NUM_ARM_JOINTS];	// Joint position right arm in [rad]
-		float dqL[NUM_ARM_JOINTS];	// Joint speed left arm in [rad/s]
-		float dqR[NUM_ARM_JOINTS];	// Joint speed right arm in [rad/s]]
-		float tauL[NUM_ARM_JOINTS];	// Joint torque left arm in [Nm]
-		float tauR[NUM_ARM_JOINTS];	// Joint torque right arm in [Nm]
-		float pwmL[NUM_ARM_JOINTS];	// PWM left arm joints in [-1, 1]
-		float pwmR[NUM_ARM_JOINTS];	// PWM right arm joints in [-1, 1]
-	} __attribute__((packed)) LiCAS_FEEDBACK_DATA_PACKET;
-	
-
 	/***************** PRIVATE VARIABLES *****************/
-	string LiCAS_Interface_Name;
+	std::string LiCAS_Interface_Name;
 	
-	thread udpRxThread;
+	pthread_t udpRxThread;
 	
 	struct sockaddr_in addrHost;
     struct hostent * host;
-	string LiCAS_IP_Address;
+	std::string LiCAS_IP_Address;
 	int UDP_TxPort;
 	int UDP_RxPort;
 	int socketSender;
 	
+	FILE * LiCAS_DataLogFile;
+	char * logBuffer;
+	
 	struct timeval tini;
 	struct timeval tact;
 	double elapsedTime;
@@ -193,12 +473,150 @@ private:
 	int flagFeedbackReceived;
 	int flagTerminateThread;
 	int flagRxThreadTerminated;
+	int flagHotPathArmed;
+	
+	uint64_t txHotPathAllocations;
+	uint64_t rxHotPathAllocations;
+	
+	// Adaptive scheduling
+	int wakeupEventFd;
+	int flagIdlePolicyEnabled;
+	float idleDetectionTime;
+	float idleWakeupPeriod;
+	int flagCommandChanged;
+	float t_lastActivity;
+	float t_idleStart;
+	float t_lastIdleLog;
+	float qL_lastRef[NUM_ARM_JOINTS];
+	float qR_lastRef[NUM_ARM_JOINTS];
+	float qL_idleCheck[NUM_ARM_JOINTS];
+	float qR_idleCheck[NUM_ARM_JOINTS];
+	
+	LiCAS_ECI_STATISTICS statistics;
+	int flagPendingLog;
+	
+	// Trajectory chunks
+	uint16_t trajectoryID;
+	
+	// Events
+	LiCAS_ECI_EventRing eventRing;
+	pthread_t eventThread;
+	int eventEventFd;
+	int flagEventThreadRunning;
+	int flagTerminateEventThread;
+	LiCAS_ECI_EventCallback eventCallback;
+	void * eventCallbackUserData;
+	
+	// Feedback pipeline
+	LiCAS_ECI_FeedbackCallback feedbackCallback;
+	void * feedbackCallbackUserData;
+	
+	// Reception executed by a reactor (NULL for the own reception thread)
+	LiCAS_ECI_Reactor * reactor;
+	int socketReceiverReactor;
+	int watchdogTimerFd;
+	
+	// Feedback rate negotiation and watchdog
+	int socketReceiverActive;			// Receiver socket of the reception thread or the reactor
+	uint16_t feedbackRateSequence;
+	uint16_t feedbackRateAckSequence;
+	float feedbackTimeout;
+	float t_lastFeedback;
+	int flagFeedbackLost;
+	float t_feedbackWindow;
+	uint64_t feedbackWindowPackets;
+	LiCAS_FEEDBACK_RATE_DATA_PACKET lastFeedbackRateRequest;	// Last feedback rate request, sent again when the link is re-established
+	
+	// Link state of the network interface
+	LiCAS_ECI_LinkMonitor linkMonitor;
+	
+	// Multipath redundant transport (path 0 is the primary one: socketSender and the receiver socket)
+	LiCAS_ECI_Multipath multipath;
+	int numPaths;
+	int pathSocketSender[MAX_MULTIPATH_PATHS];
+	int pathSocketReceiver[MAX_MULTIPATH_PATHS];
+	struct sockaddr_in addrPath[MAX_MULTIPATH_PATHS];
+	
+	// Thread accounting
+	LiCAS_ECI_ThreadAccounting threadAccounting;
+	int numControlThreads;				// Control threads registered when sending their first command
 	
 	
 	/***************** PRIVATE METHODS *****************/
 	
+	static void * udpRxThreadEntry(void * arg);
+	
 	void udpRxThreadFunction();
 	
+	int openRxSocket();
+	
+	void dispatchPacket(const char * buffer, int size);
+	
+	static void reactorRxCallback(int fd, uint32_t events, void * userData);
+	
+	void reactorRxFunction(int fd);
+	
+	static void accountPacketLatency(LiCAS_ECI_ThreadAccounting * threadAccounting, int threadIndex, struct msghdr * message, const struct timespec * t_wakeupReal);
+	
+	// Handlers of the packet types of the dispatch table
+	template <typename... ENTRIES> friend struct LiCAS_PacketTable;
+	
+	void handlePacket(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback);
+	
+	void handlePacket(const LiCAS_STATUS_DATA_PACKET * dataPacketStatus);
+	
+	void handlePacket(const LiCAS_DIAGNOSTICS_DATA_PACKET * dataPacketDiagnostics);
+	
+	void handlePacket(const LiCAS_FEEDBACK_RATE_ACK_DATA_PACKET * dataPacketFeedbackRateAck);
+	
+	void adaptRxBuffer(float rate);
+	
+	void checkFeedbackWatchdog(float t);
+	
+	static void reactorWatchdogCallback(int fd, uint32_t events, void * userData);
+	
+	void setWatchdogTimer();
+	
+	void drainSendErrors(int fd);
+	
+	static void reactorSendErrorCallback(int fd, uint32_t events, void * userData);
+	
+	void updateInterfaceState();
+	
+	static void reactorLinkMonitorCallback(int fd, uint32_t events, void * userData);
+	
+	void reestablishLink();
+	
+	int sendMultipathPacket(const void * dataPacket, int packetSize, float timeStamp);
+	
+	void updateReceptionTime();
+	
+	void processFeedbackPacket(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback);
+	
+	void logFeedback();
+	
+	void updateIdleState(float t);
+	
+	void checkCommandChange(const float * qLref, const float * qRref);
+	
+	int sendTrajectoryChunk(uint8_t mode, uint32_t firstIndex, const LiCAS_TRAJECTORY_SETPOINT * setpoints, int numSetpoints);
+	
+	int sendCommandPacket(const void * commandPacket, int packetSize, float timeStamp, uint64_t allocations);
+	
+	int wakeupRxThread();
+	
+	void raiseEvent(uint16_t code, uint8_t severity, int32_t errnoValue, int64_t value);
+	
+	void deliverEvents();
+	
+	int startEventThread();
+	
+	void stopEventThread();
+	
+	static void * eventThreadEntry(void * arg);
+	
+	void eventThreadFunction();
+	
 
 };
 
@@ -0,0 +1,245 @@
+/*
+ *
+ * LiCAS Identification - Bode_Analyzer.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Frequency response of the joints from the excitation log (references sent, LiCAS_Excitation)
+ * and the data log of the LiCAS ECI (feedback received, LiCAS_DataLog.txt). Both logs use the
+ * time of the interface, so the estimate includes the delays of the communication. The joints
+ * excited are detected from the references, both signals are resampled by linear interpolation
+ * at the mean rate of the feedback over the common interval, and the Bode diagram of each joint
+ * is estimated (LiCAS_FrequencyResponse). The points are saved in LiCAS_Bode.txt:
+ *
+ * 	joint frequency[Hz] magnitude[dB] phase[deg] coherence
+ *
+ * Usage: ./LiCAS_BodeAnalyzer LiCAS_ExcitationLog.txt LiCAS_DataLog.txt [segmentLength]
+ *
+ * The program returns 1 if no joint is excited or if an excited joint has no reliable points.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+
+// Specific library
+#include "LiCAS_FrequencyResponse.h"
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_Packets.h"
+
+
+#define NUM_LOG_JOINTS			(2*NUM_ARM_JOINTS)
+#define MIN_EXCITATION_STD		1e-5	// Standard deviation of the reference of the excited joints in [rad]
+#define BODE_FILE_NAME			"LiCAS_Bode.txt"
+
+
+// Joint positions (left and right arm) of a log along the time
+typedef struct
+{
+	std::vector<float> t;
+	std::vector<float> q[NUM_LOG_JOINTS];
+} JOINT_LOG;
+
+
+/*
+ * Read the joint positions of a log, skipping the first columns after the time and the lines that
+ * do not contain numbers (comments)
+ */
+static int loadJointLog(const char * fileName, int numSkippedColumns, JOINT_LOG * log)
+{
+	FILE * logFile = NULL;
+	char line[1024];
+	char * cursor = NULL;
+	char * end = NULL;
+	float values[1 + 6 + NUM_LOG_JOINTS];
+	int numColumns = 1 + numSkippedColumns + NUM_LOG_JOINTS;
+	int k = 0;
+	
+	
+	logFile = fopen(fileName, "r");
+	if(logFile == NULL)
+		return 1;
+	while(fgets(line, sizeof(line), logFile) != NULL)
+	{
+		cursor = line;
+		for(k = 0; k < numColumns; k++)
+		{
+			values[k] = strtof(cursor, &end);
+			if(end == cursor)
+				break;
+			cursor = end;
+		}
+		if(k < numColumns || (log->t.size() > 0 && values[0] <= log->t.back()))
+			continue;
+		
+		log->t.push_back(values[0]);
+		for(k = 0; k < NUM_LOG_JOINTS; k++)
+			log->q[k].push_back(values[1 + numSkippedColumns + k]);
+	}
+	fclose(logFile);
+	
+	
+	return (log->t.size() >= 2) ? 0 : 1;
+}
+
+
+/*
+ * Resample a joint of a log at a uniform rate by linear interpolation
+ */
+static void resample(const JOINT_LOG & log, int joint, double t0, double dt, int numSamples, float * output)
+{
+	size_t index = 0;
+	double t = 0;
+	double s = 0;
+	int n = 0;
+	
+	
+	for(n = 0; n < numSamples; n++)
+	{
+		t = t0 + n*dt;
+		while(index + 2 < log.t.size() && log.t[index + 1] < t)
+			index++;
+		s = (t - log.t[index])/(log.t[index + 1] - log.t[index]);
+		s = (s < 0) ? 0 : ((s > 1) ? 1 : s);
+		output[n] = log.q[joint][index] + s*(log.q[joint][index + 1] - log.q[joint][index]);
+	}
+}
+
+
+/*
+ * Standard deviation of a joint of a log
+ */
+static double getStd(const JOINT_LOG & log, int joint)
+{
+	double mean = 0;
+	double variance = 0;
+	size_t n = 0;
+	
+	
+	for(n = 0; n < log.t.size(); n++)
+		mean += log.q[joint][n];
+	mean /= log.t.size();
+	for(n = 0; n < log.t.size(); n++)
+		variance += (log.q[joint][n] - mean)*(log.q[joint][n] - mean);
+	
+	
+	return sqrt(variance/log.t.size());
+}
+
+
+int main(int argc, char ** argv)
+{
+	LiCAS_FrequencyResponse response;
+	JOINT_LOG txLog;
+	JOINT_LOG rxLog;
+	std::vector<float> x;
+	std::vector<float> y;
+	FILE * bodeFile = NULL;
+	const char * jointNames[NUM_LOG_JOINTS] = {"L1", "L2", "L3", "L4", "R1", "R2", "R3", "R4"};
+	double t0 = 0;
+	double t1 = 0;
+	double sampleRate = 0;
+	int numSamples = 0;
+	int segmentLength = 0;
+	int numExcitedJoints = 0;
+	int numReliablePoints = 0;
+	int errorCode = 0;
+	int joint = 0;
+	int k = 0;
+	
+	
+	if(argc < 3)
+	{
+		printf("Usage: ./LiCAS_BodeAnalyzer LiCAS_ExcitationLog.txt LiCAS_DataLog.txt [segmentLength]\n");
+		printf("\tsegmentLength: samples of the FFT segments, power of two (default: about 1/8 of the log)\n");
+		return 1;
+	}
+	
+	// Excitation log: t, qLref, qRref. Data log: t, pL, pR, qL, qR...
+	if(loadJointLog(argv[1], 0, &txLog) != 0 || loadJointLog(argv[2], 6, &rxLog) != 0)
+	{
+		printf("ERROR [in main]: could not read the logs\n");
+		return 1;
+	}
+	
+	// Common interval, resampled at the mean rate of the feedback
+	t0 = fmax(txLog.t.front(), rxLog.t.front());
+	t1 = fmin(txLog.t.back(), rxLog.t.back());
+	sampleRate = (rxLog.t.size() - 1)/(rxLog.t.back() - rxLog.t.front());
+	numSamples = (t1 > t0) ? (int)((t1 - t0)*sampleRate) : 0;
+	if(argc > 3)
+		segmentLength = atoi(argv[3]);
+	else
+	{
+		segmentLength = MIN_FFT_SIZE;
+		while(2*segmentLength <= numSamples/8 && 2*segmentLength <= MAX_FFT_SIZE)
+			segmentLength *= 2;
+	}
+	printf("Common interval: %.2f [s], %d samples at %.1f [Hz], segments of %d samples\n", t1 - t0, numSamples, sampleRate, segmentLength);
+	
+	bodeFile = fopen(BODE_FILE_NAME, "w");
+	if(bodeFile == NULL)
+	{
+		printf("ERROR [in main]: could not create %s\n", BODE_FILE_NAME);
+		return 1;
+	}
+	fprintf(bodeFile, "# joint frequency[Hz] magnitude[dB] phase[deg] coherence\n");
+	
+	x.resize(numSamples);
+	y.resize(numSamples);
+	for(joint = 0; joint < NUM_LOG_JOINTS; joint++)
+	{
+		if(getStd(txLog, joint) < MIN_EXCITATION_STD)
+			continue;
+		numExcitedJoints++;
+		
+		resample(txLog, joint, t0, 1.0/sampleRate, numSamples, x.data());
+		resample(rxLog, joint, t0, 1.0/sampleRate, numSamples, y.data());
+		if(response.estimate(x.data(), y.data(), numSamples, sampleRate, segmentLength) != 0)
+		{
+			printf("ERROR [in main]: invalid segment length %d for %d samples\n", segmentLength, numSamples);
+			errorCode = 1;
+			break;
+		}
+		
+		numReliablePoints = 0;
+		for(k = 0; k < response.getNumPoints(); k++)
+		{
+			const LiCAS_BODE_POINT & point = response.getPoint(k);
+			
+			fprintf(bodeFile, "%s\t%g\t%g\t%g\t%g\n", jointNames[joint], point.frequency, point.magnitude, point.phase, point.coherence);
+			if(point.coherence >= COHERENCE_THRESHOLD)
+				numReliablePoints++;
+		}
+		printf("Joint %s: %d segments, %d reliable points, bandwidth ", jointNames[joint], response.getNumSegments(), numReliablePoints);
+		if(response.getBandwidth() > 0)
+			printf("%.2f [Hz]", response.getBandwidth());
+		else
+			printf("above the band");
+		printf(", delay %.2f [ms]\n", 1e3*response.getDelay());
+		if(numReliablePoints == 0)
+			errorCode = 1;
+	}
+	fclose(bodeFile);
+	
+	if(numExcitedJoints == 0)
+	{
+		printf("ERROR [in main]: no excited joints in %s\n", argv[1]);
+		errorCode = 1;
+	}
+	
+	
+	return errorCode;
+}
+
@@ -0,0 +1,124 @@
+/*
+ *
+ * LiCAS Identification - ExcitationOptimizer_Tool.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * This program computes an optimized excitation trajectory for the identification of the dynamic
+ * parameters of the arms (LiCAS_ExcitationOptimizer) and saves it in a trajectory file, sampled at
+ * 500 Hz, that is played through the LiCAS ECI by the LiCAS_Excitation program. The dynamics of
+ * both arms are mirror symmetric, so the trajectory is optimized with the model of the left arm
+ * (with the calibrated geometry of LiCAS_Geometry_Left.txt if available) and the same joint
+ * positions are applied to the selected arms.
+ *
+ * Usage: ./LiCAS_ExcitationOptimizer trajectory_file [L|R|LR] [numPeriods] [numStarts] [numThreads]
+ * Example: ./LiCAS_ExcitationOptimizer LiCAS_Trajectory.txt LR 3 16 0
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Specific library
+#include "LiCAS_ExcitationOptimizer.h"
+
+
+#define GEOMETRY_FILE_NAME		"LiCAS_Geometry_Left.txt"
+#define TRAJECTORY_PERIOD		0.002	// Sampling period of the trajectory file in [s]
+
+
+int main(int argc, char ** argv)
+{
+	LiCAS_ARM_GEOMETRY geometry = LiCAS_ArmKinematics::getDefaultGeometry();
+	LiCAS_OPTIMIZER_PARAMETERS parameters = LiCAS_ExcitationOptimizer::getDefaultParameters();
+	LiCAS_OPTIMIZER_RESULT result;
+	LiCAS_FOURIER_TRAJECTORY trajectory;
+	LiCAS_Regressor * regressor = NULL;
+	LiCAS_ExcitationOptimizer * optimizer = NULL;
+	int armMask = TRAJECTORY_ARM_LEFT | TRAJECTORY_ARM_RIGHT;
+	int numPeriods = 3;
+	int errorCode = 0;
+	int j = 0;
+	int l = 0;
+	
+	
+	if(argc < 2)
+	{
+		printf("Usage: ./LiCAS_ExcitationOptimizer trajectory_file [L|R|LR] [numPeriods] [numStarts] [numThreads]\n");
+		printf("\tL|R|LR: arms of the trajectory (default: LR)\n");
+		printf("\tnumPeriods: periods of %.0f s of the trajectory (default: 3)\n", 1.0/parameters.baseFrequency);
+		printf("\tnumStarts: random starts of the optimization (default: %d)\n", parameters.numStarts);
+		printf("\tnumThreads: threads of the optimization (default: number of cores)\n");
+		return 1;
+	}
+	if(argc > 2)
+		armMask = (strchr(argv[2], 'L') != NULL ? TRAJECTORY_ARM_LEFT : 0) | (strchr(argv[2], 'R') != NULL ? TRAJECTORY_ARM_RIGHT : 0);
+	if(argc > 3)
+		numPeriods = atoi(argv[3]);
+	if(argc > 4)
+		parameters.numStarts = atoi(argv[4]);
+	if(argc > 5)
+		parameters.numThreads = atoi(argv[5]);
+	if(armMask == 0 || numPeriods < 1)
+	{
+		printf("ERROR [in main]: invalid arms (L, R or LR) or number of periods\n");
+		return 1;
+	}
+	
+	if(LiCAS_ArmKinematics::loadGeometry(GEOMETRY_FILE_NAME, &geometry) == 0)
+		printf("Geometry: %s\n", GEOMETRY_FILE_NAME);
+	else
+		printf("Geometry: nominal\n");
+	regressor = new LiCAS_Regressor(LiCAS_ARM_LEFT, geometry);
+	optimizer = new LiCAS_ExcitationOptimizer(*regressor);
+	if(optimizer->setParameters(parameters) != 0)
+	{
+		printf("ERROR [in main]: invalid number of starts (1 to %d)\n", MAX_OPTIMIZER_STARTS);
+		errorCode = 1;
+	}
+	else
+	{
+		printf("Optimizing: %d base parameters, %d starts of %d iterations\n", regressor->getNumBaseParameters(), parameters.numStarts, parameters.numIterations);
+		errorCode = optimizer->optimize(&trajectory, &result);
+		printf("Condition number: %.1f (best random start %.1f), %d threads, %.2f s\n", result.conditionFinal, result.conditionInitial, result.numThreads, result.optimizationTime);
+		if(errorCode != 0)
+			printf("ERROR [in main]: no trajectory within the limits of the joints\n");
+		else if(LiCAS_ExcitationOptimizer::saveTrajectory(argv[1], trajectory, TRAJECTORY_PERIOD, numPeriods, armMask) != 0)
+		{
+			printf("ERROR [in main]: could not create %s\n", argv[1]);
+			errorCode = 1;
+		}
+		else
+		{
+			printf("Fourier coefficients (q0; a_l; b_l) of each joint:\n");
+			for(j = 0; j < NUM_ARM_JOINTS; j++)
+			{
+				printf("\tq%d: %.4f;", j + 1, trajectory.q0[j]);
+				for(l = 0; l < trajectory.numHarmonics; l++)
+					printf(" %.4f", trajectory.a[j][l]);
+				printf(";");
+				for(l = 0; l < trajectory.numHarmonics; l++)
+					printf(" %.4f", trajectory.b[j][l]);
+				printf("\n");
+			}
+			printf("Trajectory saved in %s (%d periods, %.1f s)\n", argv[1], numPeriods, numPeriods/parameters.baseFrequency);
+		}
+	}
+	delete optimizer;
+	delete regressor;
+	
+	
+	return errorCode;
+}
+
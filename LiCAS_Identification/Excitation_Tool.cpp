@@ -0,0 +1,153 @@
+/*
+ *
+ * LiCAS Identification - Excitation_Tool.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * This program streams a chirp or multisine excitation (LiCAS_Excitation) through the LiCAS ECI to
+ * the selected joints of the arms, physical or simulated, around their current position. The
+ * references are saved in LiCAS_ExcitationLog.txt and the feedback in LiCAS_DataLog.txt, which
+ * are processed by the LiCAS_BodeAnalyzer program. The joints are given as a comma separated
+ * list of arm (L or R) and joint number (1 to 4). With a trajectory file instead (for example
+ * the optimized excitation of the LiCAS_ExcitationOptimizer program), the trajectory is played
+ * with LiCAS_TrajectoryPlayer after a smooth approach to its first sample.
+ *
+ * Usage: ./LiCAS_Excitation IP_Address TxPort RxPort joints chirp|multisine fMin fMax amplitude duration
+ * Usage: ./LiCAS_Excitation IP_Address TxPort RxPort trajectory_file
+ * Example: ./LiCAS_Excitation 127.0.0.1 23000 24003 L1,R4 chirp 0.2 20 0.05 60
+ * Example: ./LiCAS_Excitation 127.0.0.1 23000 24003 LiCAS_Trajectory.txt
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+// Specific library
+#include "LiCAS_Excitation.h"
+#include "LiCAS_TrajectoryPlayer.h"
+
+
+#define EXCITATION_LOG_FILE_NAME	"LiCAS_ExcitationLog.txt"
+#define APPROACH_TIME				5.0		// Duration of the approach to the first sample of the trajectory in [s]
+
+
+/*
+ * Joint mask from a list of joints ("L1,R4"). Returns 0 if the list is not valid.
+ */
+static uint32_t parseJoints(const char * joints)
+{
+	uint32_t jointMask = 0;
+	int joint = 0;
+	size_t k = 0;
+	
+	
+	for(k = 0; joints[k] != '\0'; k += 3)
+	{
+		joint = joints[k + 1] - '1';
+		if(joint < 0 || joint >= NUM_ARM_JOINTS || (joints[k + 2] != ',' && joints[k + 2] != '\0'))
+			return 0;
+		if(joints[k] == 'L' || joints[k] == 'l')
+			jointMask |= EXCITATION_JOINT_LEFT(joint);
+		else if(joints[k] == 'R' || joints[k] == 'r')
+			jointMask |= EXCITATION_JOINT_RIGHT(joint);
+		else
+			return 0;
+		if(joints[k + 2] == '\0')
+			break;
+	}
+	
+	
+	return jointMask;
+}
+
+
+int main(int argc, char ** argv)
+{
+	LiCAS_ECI_UDP * licas_eci = NULL;
+	LiCAS_EXCITATION_PARAMETERS parameters = LiCAS_Excitation::getDefaultParameters();
+	LiCAS_Excitation excitation;
+	LiCAS_TrajectoryPlayer player;
+	int errorCode = 0;
+	
+	
+	if(argc != 10 && argc != 5)
+	{
+		printf("Usage: ./LiCAS_Excitation IP_Address TxPort RxPort joints chirp|multisine fMin fMax amplitude duration\n");
+		printf("Usage: ./LiCAS_Excitation IP_Address TxPort RxPort trajectory_file\n");
+		printf("Example: ./LiCAS_Excitation 127.0.0.1 23000 24003 L1,R4 chirp 0.2 20 0.05 60\n");
+		return 1;
+	}
+	
+	if(argc == 5)
+	{
+		errorCode = player.load(argv[4]);
+		if(errorCode != 0)
+		{
+			printf("ERROR [in main]: could not load trajectory file %s (error %d)\n", argv[4], errorCode);
+			return 1;
+		}
+		printf("Trajectory: %d samples, period %.4f s\n", player.getNumSamples(), player.getPeriod());
+	}
+	else
+	{
+		parameters.jointMask = parseJoints(argv[4]);
+		parameters.type = (strcmp(argv[5], "multisine") == 0) ? EXCITATION_MULTISINE : EXCITATION_CHIRP;
+		parameters.fMin = atof(argv[6]);
+		parameters.fMax = atof(argv[7]);
+		parameters.amplitude = atof(argv[8]);
+		parameters.duration = atof(argv[9]);
+		if(parameters.jointMask == 0 || (strcmp(argv[5], "chirp") != 0 && strcmp(argv[5], "multisine") != 0))
+		{
+			printf("ERROR [in main]: invalid joints (example: L1,R4) or type of excitation (chirp or multisine)\n");
+			return 1;
+		}
+		if(excitation.setParameters(parameters) != 0)
+		{
+			printf("ERROR [in main]: invalid parameters (fMax below %.1f Hz, duration of at least %.1f s)\n", 0.5/parameters.period, 4*EXCITATION_TAPER_TIME);
+			return 1;
+		}
+	}
+	
+	licas_eci = new LiCAS_ECI_UDP("LiCAS_Excitation");
+	errorCode = licas_eci->openUDPInterface(argv[1], atoi(argv[2]), atoi(argv[3]));
+	if(errorCode != 0)
+		printf("ERROR [in main]: could not open LiCAS ECI\n");
+	else
+	{
+		if(licas_eci->waitForLink(5.0) != 0)
+		{
+			errorCode = 1;
+			printf("ERROR [in main]: LiCAS control program not responding\n");
+		}
+		else
+		{
+			if(argc == 5)
+				errorCode = player.execute(licas_eci, APPROACH_TIME, EXCITATION_LOG_FILE_NAME);
+			else
+				errorCode = excitation.execute(licas_eci, EXCITATION_LOG_FILE_NAME);
+			if(errorCode != 0)
+				printf("ERROR [in main]: excitation interrupted (error %d)\n", errorCode);
+			
+			// Feedback of the end of the response
+			usleep(500000);
+		}
+		licas_eci->closeInterface();
+	}
+	delete licas_eci;
+	
+	
+	return errorCode;
+}
+
@@ -0,0 +1,248 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_Excitation.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * The chirp sweeps the frequency exponentially, f(t) = fMin*(fMax/fMin)^(t/T), so every decade
+ * receives the same time. The multisine contains the harmonics of 1/multisinePeriod between fMin
+ * and fMax with the same amplitude (sparse if there are more than MAX_MULTISINE_HARMONICS), and
+ * its peak is normalized to the amplitude over one period.
+ *
+ */
+
+#include "LiCAS_Excitation.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_Excitation::LiCAS_Excitation()
+{
+	this->parameters = getDefaultParameters();
+	this->numHarmonics = 0;
+	this->multisineScale = 0;
+}
+
+
+/*
+ * Default parameters: chirp from 0.2 to 20 Hz, 0.05 rad, 60 s, 500 Hz, multisine period of 8.192 s,
+ * no joints selected
+ */
+LiCAS_EXCITATION_PARAMETERS LiCAS_Excitation::getDefaultParameters()
+{
+	LiCAS_EXCITATION_PARAMETERS defaultParameters;
+	
+	
+	defaultParameters.type = EXCITATION_CHIRP;
+	defaultParameters.fMin = 0.2;
+	defaultParameters.fMax = 20;
+	defaultParameters.amplitude = 0.05;
+	defaultParameters.duration = 60;
+	defaultParameters.period = 0.002;
+	defaultParameters.multisinePeriod = 8.192;
+	defaultParameters.jointMask = 0;
+	
+	
+	return defaultParameters;
+}
+
+
+/*
+ * Set the parameters of the excitation. Returns 0 if the parameters are valid, or 1 otherwise
+ * (the maximum frequency must be below the Nyquist frequency of the streaming period).
+ */
+int LiCAS_Excitation::setParameters(const LiCAS_EXCITATION_PARAMETERS & _parameters)
+{
+	float peak = 0;
+	float t = 0;
+	int first = 0;
+	int last = 0;
+	int step = 1;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	if(_parameters.fMin <= 0 || _parameters.fMax <= _parameters.fMin || _parameters.amplitude <= 0 || _parameters.period <= 0 ||
+			_parameters.fMax >= 0.5/_parameters.period || _parameters.duration < 4*EXCITATION_TAPER_TIME ||
+			(_parameters.type != EXCITATION_CHIRP && _parameters.type != EXCITATION_MULTISINE))
+		errorCode = 1;
+	else if(_parameters.type == EXCITATION_MULTISINE && (_parameters.multisinePeriod <= 0 || _parameters.fMax*_parameters.multisinePeriod < 1))
+		errorCode = 1;
+	else
+	{
+		this->parameters = _parameters;
+		this->numHarmonics = 0;
+		
+		if(this->parameters.type == EXCITATION_MULTISINE)
+		{
+			// Harmonics of the multisine period within the band
+			first = (int)ceil(this->parameters.fMin*this->parameters.multisinePeriod);
+			last = (int)floor(this->parameters.fMax*this->parameters.multisinePeriod);
+			first = (first < 1) ? 1 : first;
+			step = (last - first)/MAX_MULTISINE_HARMONICS + 1;
+			for(k = first; k <= last && this->numHarmonics < MAX_MULTISINE_HARMONICS; k += step)
+			{
+				this->harmonicFrequency[this->numHarmonics] = 2*M_PI*k/this->parameters.multisinePeriod;
+				this->numHarmonics++;
+			}
+			
+			// Schroeder phases
+			for(k = 0; k < this->numHarmonics; k++)
+				this->harmonicPhase[k] = -M_PI*k*(k + 1)/this->numHarmonics;
+			
+			// Peak of the multisine over one period
+			this->multisineScale = 1;
+			for(t = 0; t < this->parameters.multisinePeriod; t += 0.25*this->parameters.period)
+				peak = fmax(peak, fabs(this->getMultisine(t)));
+			this->multisineScale = (peak > 0) ? 1.0/peak : 0;
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Excitation signal at a time since the start in [rad], including the taper
+ */
+float LiCAS_Excitation::getSignal(float t) const
+{
+	float T = this->parameters.duration;
+	float ratio = this->parameters.fMax/this->parameters.fMin;
+	float taper = 1;
+	float signal = 0;
+	
+	
+	if(t <= 0 || t >= T)
+		return 0;
+	
+	if(t < EXCITATION_TAPER_TIME)
+		taper = 0.5*(1 - cos(M_PI*t/EXCITATION_TAPER_TIME));
+	else if(t > T - EXCITATION_TAPER_TIME)
+		taper = 0.5*(1 - cos(M_PI*(T - t)/EXCITATION_TAPER_TIME));
+	
+	if(this->parameters.type == EXCITATION_CHIRP)
+		signal = sin(2*M_PI*this->parameters.fMin*T/log(ratio)*(pow((double)ratio, (double)t/T) - 1));
+	else
+		signal = this->getMultisine(t);
+	
+	
+	return this->parameters.amplitude*taper*signal;
+}
+
+
+/*
+ * Joint position references at a time since the start in [rad]
+ */
+void LiCAS_Excitation::getReference(float t, const float qL0[NUM_ARM_JOINTS], const float qR0[NUM_ARM_JOINTS], float qL[NUM_ARM_JOINTS], float qR[NUM_ARM_JOINTS]) const
+{
+	float signal = this->getSignal(t);
+	int k = 0;
+	
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		qL[k] = qL0[k] + ((this->parameters.jointMask & EXCITATION_JOINT_LEFT(k)) ? signal : 0);
+		qR[k] = qR0[k] + ((this->parameters.jointMask & EXCITATION_JOINT_RIGHT(k)) ? signal : 0);
+	}
+}
+
+
+/*
+ * Stream the excitation around the current joint positions through the interface (blocking call).
+ * Returns 0 at the end of the excitation, 1 if a reference could not be sent, or 2 if the
+ * excitation log could not be created.
+ */
+int LiCAS_Excitation::execute(LiCAS_ECI_UDP * licas_eci, const char * logFileName)
+{
+	FILE * logFile = NULL;
+	struct timespec t_next;
+	float qL0[NUM_ARM_JOINTS];
+	float qR0[NUM_ARM_JOINTS];
+	float qL[NUM_ARM_JOINTS];
+	float qR[NUM_ARM_JOINTS];
+	long periodNs = (long)(1e9*this->parameters.period);
+	int numCycles = (int)ceil(this->parameters.duration/this->parameters.period);
+	int cycle = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	logFile = fopen(logFileName, "w");
+	if(logFile == NULL)
+		return 2;
+	fprintf(logFile, "# t qLref[%d] qRref[%d]\n", NUM_ARM_JOINTS, NUM_ARM_JOINTS);
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		qL0[k] = licas_eci->qL[k];
+		qR0[k] = licas_eci->qR[k];
+	}
+	
+	clock_gettime(CLOCK_MONOTONIC, &t_next);
+	for(cycle = 0; cycle <= numCycles && errorCode == 0; cycle++)
+	{
+		this->getReference(cycle*this->parameters.period, qL0, qR0, qL, qR);
+		if(licas_eci->sendJointPositionRef(qL, qR, this->parameters.period) != 0)
+			errorCode = 1;
+		
+		// Reference with the time base of the data log of the interface
+		fprintf(logFile, "%.6f", licas_eci->getElapsedTime());
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(logFile, "\t%g", qL[k]);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(logFile, "\t%g", qR[k]);
+		fprintf(logFile, "\n");
+		
+		// Absolute wake-up time of the next cycle (no drift)
+		t_next.tv_nsec += periodNs;
+		while(t_next.tv_nsec >= 1000000000)
+		{
+			t_next.tv_nsec -= 1000000000;
+			t_next.tv_sec++;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t_next, NULL);
+	}
+	fclose(logFile);
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Number of harmonics of the multisine
+ */
+int LiCAS_Excitation::getNumHarmonics() const
+{
+	return this->numHarmonics;
+}
+
+
+/*
+ * Normalized multisine (without taper)
+ */
+float LiCAS_Excitation::getMultisine(float t) const
+{
+	float signal = 0;
+	int k = 0;
+	
+	
+	// The multisine is periodic: the argument is kept small for the precision of the phase
+	t = fmod(t, this->parameters.multisinePeriod);
+	for(k = 0; k < this->numHarmonics; k++)
+		signal += cos(this->harmonicFrequency[k]*t + this->harmonicPhase[k]);
+	
+	
+	return this->multisineScale*signal;
+}
+
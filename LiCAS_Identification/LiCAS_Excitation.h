@@ -0,0 +1,152 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_Excitation.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Excitation signals for the identification of the frequency response of the joint servos. The
+ * selected joints follow a logarithmic chirp or a multisine (Schroeder phases, low crest factor)
+ * around their current position, while the rest of the joints hold their position. The signal
+ * starts and ends with a cosine taper, so the references do not have steps. The references are
+ * streamed through the LiCAS ECI at a fixed period, and each reference is written in an excitation
+ * log with the time of the interface, so it can be compared with the feedback of the data log
+ * (LiCAS_DataLog.txt) by the LiCAS_BodeAnalyzer program.
+ *
+ * Example:
+ *
+ * 	LiCAS_EXCITATION_PARAMETERS parameters = LiCAS_Excitation::getDefaultParameters();
+ * 	LiCAS_Excitation excitation;
+ *
+ * 	parameters.jointMask = EXCITATION_JOINT_LEFT(0);
+ * 	if(excitation.setParameters(parameters) == 0)
+ * 		excitation.execute(licas_eci, "LiCAS_ExcitationLog.txt");
+ *
+ */
+
+#ifndef LICAS_EXCITATION_H_
+#define LICAS_EXCITATION_H_
+
+
+// Standard library
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+
+
+// Types of excitation signal
+#define EXCITATION_CHIRP			0
+#define EXCITATION_MULTISINE		1
+
+// Bits of the joint mask
+#define EXCITATION_JOINT_LEFT(k)	(1 << (k))
+#define EXCITATION_JOINT_RIGHT(k)	(1 << (NUM_ARM_JOINTS + (k)))
+
+#define MAX_MULTISINE_HARMONICS		256
+#define EXCITATION_TAPER_TIME		1.0		// Duration of the taper at the start and at the end in [s]
+
+
+// Parameters of the excitation
+typedef struct
+{
+	int type;					// EXCITATION_CHIRP or EXCITATION_MULTISINE
+	float fMin;					// Minimum frequency in [Hz]
+	float fMax;					// Maximum frequency in [Hz]
+	float amplitude;			// Peak amplitude of the joint references in [rad]
+	float duration;				// Duration of the excitation in [s]
+	float period;				// Streaming period in [s]
+	float multisinePeriod;		// Period of the multisine in [s] (frequency resolution 1/multisinePeriod)
+	uint32_t jointMask;			// Excited joints: EXCITATION_JOINT_LEFT(k) | EXCITATION_JOINT_RIGHT(k)
+} LiCAS_EXCITATION_PARAMETERS;
+
+
+class LiCAS_Excitation
+{
+public:
+
+	/*
+	 * Constructor
+	 * */
+	LiCAS_Excitation();
+	
+	
+	/*
+	 * Default parameters: chirp from 0.2 to 20 Hz, 0.05 rad, 60 s, 500 Hz, multisine period of 8.192 s,
+	 * no joints selected
+	 */
+	static LiCAS_EXCITATION_PARAMETERS getDefaultParameters();
+	
+	
+	/*
+	 * Set the parameters of the excitation. Returns 0 if the parameters are valid, or 1 otherwise
+	 * (the maximum frequency must be below the Nyquist frequency of the streaming period).
+	 */
+	int setParameters(const LiCAS_EXCITATION_PARAMETERS & _parameters);
+	
+	
+	/*
+	 * Excitation signal at a time since the start in [rad], including the taper
+	 */
+	float getSignal(float t) const;
+	
+	
+	/*
+	 * Joint position references at a time since the start in [rad]
+	 *
+	 * Parameters:
+	 * 	(1) Time since the start of the excitation in [s]
+	 * 	(2) Initial joint positions of the left arm in [rad]
+	 * 	(3) Initial joint positions of the right arm in [rad]
+	 * 	(4) Output joint position references of the left arm in [rad]
+	 * 	(5) Output joint position references of the right arm in [rad]
+	 */
+	void getReference(float t, const float qL0[NUM_ARM_JOINTS], const float qR0[NUM_ARM_JOINTS], float qL[NUM_ARM_JOINTS], float qR[NUM_ARM_JOINTS]) const;
+	
+	
+	/*
+	 * Stream the excitation around the current joint positions through the interface (blocking call).
+	 * Returns 0 at the end of the excitation, 1 if a reference could not be sent, or 2 if the
+	 * excitation log could not be created.
+	 *
+	 * Parameters:
+	 * 	(1) LiCAS ECI, with the link established
+	 * 	(2) Name of the excitation log: time of the interface and joint references (qL, qR) per line
+	 */
+	int execute(LiCAS_ECI_UDP * licas_eci, const char * logFileName);
+	
+	
+	/*
+	 * Number of harmonics of the multisine
+	 */
+	int getNumHarmonics() const;
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	LiCAS_EXCITATION_PARAMETERS parameters;
+	
+	// Multisine
+	int numHarmonics;
+	float harmonicFrequency[MAX_MULTISINE_HARMONICS];	// Angular frequency of the harmonics in [rad/s]
+	float harmonicPhase[MAX_MULTISINE_HARMONICS];
+	float multisineScale;								// Normalization of the peak of the multisine
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	float getMultisine(float t) const;
+};
+
+#endif
+
@@ -0,0 +1,625 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_ExcitationOptimizer.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * The speed and the acceleration at the start of the period are
+ *
+ * 	dq(0) = sum_l a_l,	ddq(0) = wf*sum_l l*b_l
+ *
+ * so the coefficients of the last harmonic are a_L = -sum a_l and b_L = -sum l*b_l/L (l < L), and
+ * the variables of the optimization are the offsets and the coefficients of the first L-1 harmonics.
+ * The condition number is the square root of the ratio between the extreme eigenvalues of W'*W,
+ * with W the stacked regressor of the base parameters, computed with the Jacobi method.
+ *
+ */
+
+#include "LiCAS_ExcitationOptimizer.h"
+
+
+#define ES_INITIAL_STEP		0.1		// Initial step of the evolution strategy
+#define ES_ADAPTATION		10		// Iterations between the adaptations of the step (1/5 success rule)
+
+
+static double getTime()
+{
+	struct timespec t;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	
+	
+	return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+
+/*
+ * Gaussian random number (Box-Muller) with a reentrant generator
+ */
+static double getGaussian(unsigned int * seed)
+{
+	double u1 = (rand_r(seed) + 1.0)/(RAND_MAX + 2.0);
+	double u2 = (rand_r(seed) + 1.0)/(RAND_MAX + 2.0);
+	
+	
+	return sqrt(-2*log(u1))*cos(2*M_PI*u2);
+}
+
+
+/*
+ * Eigenvalues of a symmetric matrix (cyclic Jacobi method). The matrix is overwritten.
+ */
+static void getEigenvalues(double * A, int n, double * lambda)
+{
+	double offDiagonal = 0;
+	double diagonal = 0;
+	double theta = 0;
+	double t = 0;
+	double c = 0;
+	double s = 0;
+	double Akp = 0;
+	double Akq = 0;
+	int sweep = 0;
+	int p = 0;
+	int q = 0;
+	int k = 0;
+	
+	
+	for(sweep = 0; sweep < 50; sweep++)
+	{
+		offDiagonal = 0;
+		diagonal = 0;
+		for(p = 0; p < n; p++)
+		{
+			diagonal += A[p*n + p]*A[p*n + p];
+			for(q = p + 1; q < n; q++)
+				offDiagonal += A[p*n + q]*A[p*n + q];
+		}
+		if(offDiagonal <= 1e-30*diagonal)
+			break;
+		
+		for(p = 0; p < n - 1; p++)
+		{
+			for(q = p + 1; q < n; q++)
+			{
+				if(A[p*n + q] == 0)
+					continue;
+				theta = (A[q*n + q] - A[p*n + p])/(2*A[p*n + q]);
+				t = ((theta >= 0) ? 1.0 : -1.0)/(fabs(theta) + sqrt(theta*theta + 1));
+				c = 1/sqrt(t*t + 1);
+				s = t*c;
+				
+				// A = J'*A*J, with the rotation J in the plane (p, q)
+				for(k = 0; k < n; k++)
+				{
+					Akp = A[k*n + p];
+					Akq = A[k*n + q];
+					A[k*n + p] = c*Akp - s*Akq;
+					A[k*n + q] = s*Akp + c*Akq;
+				}
+				for(k = 0; k < n; k++)
+				{
+					Akp = A[p*n + k];
+					Akq = A[q*n + k];
+					A[p*n + k] = c*Akp - s*Akq;
+					A[q*n + k] = s*Akp + c*Akq;
+				}
+			}
+		}
+	}
+	
+	for(p = 0; p < n; p++)
+		lambda[p] = A[p*n + p];
+}
+
+
+/*
+ * Constructor
+ * */
+LiCAS_ExcitationOptimizer::LiCAS_ExcitationOptimizer(const LiCAS_Regressor & _regressor) : regressor(_regressor)
+{
+	this->limits = getDefaultLimits();
+	this->parameters = getDefaultParameters();
+}
+
+
+/*
+ * Default limits: conservative range of the joints, 2 rad/s and 8 rad/s^2
+ */
+LiCAS_EXCITATION_LIMITS LiCAS_ExcitationOptimizer::getDefaultLimits()
+{
+	LiCAS_EXCITATION_LIMITS defaultLimits;
+	const float qMin[NUM_ARM_JOINTS] = {-1.5, -0.3, -1.2, -2.2};
+	const float qMax[NUM_ARM_JOINTS] = {1.0, 1.2, 1.2, 0.0};
+	int k = 0;
+	
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		defaultLimits.qMin[k] = qMin[k];
+		defaultLimits.qMax[k] = qMax[k];
+		defaultLimits.dqMax[k] = 2.0;
+		defaultLimits.ddqMax[k] = 8.0;
+	}
+	
+	
+	return defaultLimits;
+}
+
+
+/*
+ * Default parameters: 0.1 Hz, 5 harmonics, 200 samples, 16 starts of 300 iterations, all cores
+ */
+LiCAS_OPTIMIZER_PARAMETERS LiCAS_ExcitationOptimizer::getDefaultParameters()
+{
+	LiCAS_OPTIMIZER_PARAMETERS defaultParameters;
+	
+	
+	defaultParameters.baseFrequency = 0.1;
+	defaultParameters.numHarmonics = 5;
+	defaultParameters.numSamples = 200;
+	defaultParameters.numStarts = 16;
+	defaultParameters.numIterations = 300;
+	defaultParameters.numThreads = 0;
+	
+	
+	return defaultParameters;
+}
+
+
+/*
+ * Set the limits of the joints
+ */
+void LiCAS_ExcitationOptimizer::setLimits(const LiCAS_EXCITATION_LIMITS & _limits)
+{
+	this->limits = _limits;
+}
+
+
+/*
+ * Set the parameters of the optimization. Returns 0 if the parameters are valid, or 1 otherwise.
+ */
+int LiCAS_ExcitationOptimizer::setParameters(const LiCAS_OPTIMIZER_PARAMETERS & _parameters)
+{
+	int errorCode = 0;
+	
+	
+	if(_parameters.baseFrequency <= 0 || _parameters.numHarmonics < 2 || _parameters.numHarmonics > MAX_FOURIER_HARMONICS ||
+		_parameters.numSamples < 2*_parameters.numHarmonics || _parameters.numSamples > MAX_OPTIMIZER_SAMPLES ||
+		_parameters.numStarts < 1 || _parameters.numStarts > MAX_OPTIMIZER_STARTS || _parameters.numIterations < 0)
+		errorCode = 1;
+	else
+		this->parameters = _parameters;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Joint positions, speeds and accelerations of a trajectory at a time in [s]
+ */
+void LiCAS_ExcitationOptimizer::getTrajectory(const LiCAS_FOURIER_TRAJECTORY & trajectory, float t, float q[NUM_ARM_JOINTS], float dq[NUM_ARM_JOINTS], float ddq[NUM_ARM_JOINTS])
+{
+	double wf = 2*M_PI*trajectory.baseFrequency;
+	double phase = 0;
+	double s = 0;
+	double c = 0;
+	int j = 0;
+	int l = 0;
+	
+	
+	// The trajectory is periodic: the argument is kept small for the precision of the phase
+	t = fmod(t, 1.0/trajectory.baseFrequency);
+	for(j = 0; j < NUM_ARM_JOINTS; j++)
+	{
+		q[j] = trajectory.q0[j];
+		dq[j] = 0;
+		ddq[j] = 0;
+	}
+	for(l = 1; l <= trajectory.numHarmonics; l++)
+	{
+		phase = wf*l*t;
+		s = sin(phase);
+		c = cos(phase);
+		for(j = 0; j < NUM_ARM_JOINTS; j++)
+		{
+			q[j] += (trajectory.a[j][l - 1]*s - trajectory.b[j][l - 1]*c)/(wf*l);
+			dq[j] += trajectory.a[j][l - 1]*c + trajectory.b[j][l - 1]*s;
+			ddq[j] += wf*l*(-trajectory.a[j][l - 1]*s + trajectory.b[j][l - 1]*c);
+		}
+	}
+}
+
+
+/*
+ * Condition number of the regressor of the base parameters stacked over a period of the trajectory
+ */
+double LiCAS_ExcitationOptimizer::getConditionNumber(const LiCAS_FOURIER_TRAJECTORY & trajectory) const
+{
+	const int * baseParameters = this->regressor.getBaseParameters();
+	LiCAS_REGRESSOR Y;
+	double WtW[NUM_DYNAMIC_PARAMETERS*NUM_DYNAMIC_PARAMETERS];
+	double lambda[NUM_DYNAMIC_PARAMETERS];
+	double row[NUM_DYNAMIC_PARAMETERS];
+	float q[NUM_ARM_JOINTS];
+	float dq[NUM_ARM_JOINTS];
+	float ddq[NUM_ARM_JOINTS];
+	double lambdaMin = 0;
+	double lambdaMax = 0;
+	int numBase = this->regressor.getNumBaseParameters();
+	int n = 0;
+	int j = 0;
+	int r = 0;
+	int c = 0;
+	
+	
+	for(r = 0; r < numBase*numBase; r++)
+		WtW[r] = 0;
+	for(n = 0; n < this->parameters.numSamples; n++)
+	{
+		getTrajectory(trajectory, n/(trajectory.baseFrequency*this->parameters.numSamples), q, dq, ddq);
+		this->regressor.getRegressor(q, dq, ddq, Y);
+		for(j = 0; j < NUM_ARM_JOINTS; j++)
+		{
+			for(c = 0; c < numBase; c++)
+				row[c] = Y[j][baseParameters[c]];
+			for(r = 0; r < numBase; r++)
+				for(c = r; c < numBase; c++)
+					WtW[r*numBase + c] += row[r]*row[c];
+		}
+	}
+	for(r = 0; r < numBase; r++)
+		for(c = 0; c < r; c++)
+			WtW[r*numBase + c] = WtW[c*numBase + r];
+	
+	getEigenvalues(WtW, numBase, lambda);
+	lambdaMin = lambda[0];
+	lambdaMax = lambda[0];
+	for(r = 1; r < numBase; r++)
+	{
+		lambdaMin = fmin(lambdaMin, lambda[r]);
+		lambdaMax = fmax(lambdaMax, lambda[r]);
+	}
+	
+	// Singular regressors are bounded, so they are still better than the trajectories out of the limits
+	lambdaMin = fmax(lambdaMin, 1e-20*lambdaMax);
+	
+	
+	return (lambdaMax > 0) ? sqrt(lambdaMax/lambdaMin) : 1e10;
+}
+
+
+/*
+ * Maximum violation of the limits over a period of the trajectory
+ */
+double LiCAS_ExcitationOptimizer::getLimitViolation(const LiCAS_FOURIER_TRAJECTORY & trajectory) const
+{
+	float q[NUM_ARM_JOINTS];
+	float dq[NUM_ARM_JOINTS];
+	float ddq[NUM_ARM_JOINTS];
+	double range = 0;
+	double violation = 0;
+	int n = 0;
+	int j = 0;
+	
+	
+	for(n = 0; n < this->parameters.numSamples; n++)
+	{
+		getTrajectory(trajectory, n/(trajectory.baseFrequency*this->parameters.numSamples), q, dq, ddq);
+		for(j = 0; j < NUM_ARM_JOINTS; j++)
+		{
+			range = this->limits.qMax[j] - this->limits.qMin[j];
+			violation = fmax(violation, (this->limits.qMin[j] - q[j])/range);
+			violation = fmax(violation, (q[j] - this->limits.qMax[j])/range);
+			violation = fmax(violation, fabs(dq[j])/this->limits.dqMax[j] - 1);
+			violation = fmax(violation, fabs(ddq[j])/this->limits.ddqMax[j] - 1);
+		}
+	}
+	
+	
+	return violation;
+}
+
+
+/*
+ * Random trajectory around the center of the range, with a speed below a quarter of the limit
+ */
+void LiCAS_ExcitationOptimizer::getRandomTrajectory(unsigned int * seed, LiCAS_FOURIER_TRAJECTORY * trajectory) const
+{
+	double x[NUM_FOURIER_VARIABLES];
+	double amplitude = 0;
+	int L = this->parameters.numHarmonics;
+	int j = 0;
+	int l = 0;
+	
+	
+	trajectory->baseFrequency = this->parameters.baseFrequency;
+	trajectory->numHarmonics = L;
+	for(j = 0; j < NUM_ARM_JOINTS; j++)
+	{
+		trajectory->q0[j] = 0.5*(this->limits.qMin[j] + this->limits.qMax[j]);
+		amplitude = 0.25*this->limits.dqMax[j]/(2*L);
+		for(l = 0; l < L - 1; l++)
+		{
+			trajectory->a[j][l] = amplitude*(2.0*rand_r(seed)/RAND_MAX - 1);
+			trajectory->b[j][l] = amplitude*(2.0*rand_r(seed)/RAND_MAX - 1);
+		}
+	}
+	
+	// Last harmonic (rest at the start of the period)
+	this->getVariables(*trajectory, x);
+	this->setVariables(x, trajectory);
+}
+
+
+/*
+ * Optimize the excitation trajectory
+ */
+int LiCAS_ExcitationOptimizer::optimize(LiCAS_FOURIER_TRAJECTORY * trajectory, LiCAS_OPTIMIZER_RESULT * result)
+{
+	OPTIMIZER_WORK work[MAX_OPTIMIZER_THREADS];
+	pthread_t threads[MAX_OPTIMIZER_THREADS];
+	int flagThreadCreated[MAX_OPTIMIZER_THREADS];
+	double t0 = getTime();
+	double costInitial = 0;
+	int numThreads = this->parameters.numThreads;
+	int best = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	if(numThreads <= 0)
+		numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	numThreads = (numThreads < 1) ? 1 : ((numThreads > MAX_OPTIMIZER_THREADS) ? MAX_OPTIMIZER_THREADS : numThreads);
+	numThreads = (numThreads > this->parameters.numStarts) ? this->parameters.numStarts : numThreads;
+	
+	for(k = 0; k < numThreads; k++)
+	{
+		work[k].optimizer = this;
+		work[k].first = k;
+		work[k].stride = numThreads;
+		flagThreadCreated[k] = 0;
+	}
+	
+	// The calling thread processes the first starts
+	for(k = 1; k < numThreads; k++)
+	{
+		if(pthread_create(&threads[k], NULL, &LiCAS_ExcitationOptimizer::workEntry, &work[k]) == 0)
+			flagThreadCreated[k] = 1;
+		else
+			workEntry(&work[k]);
+	}
+	workEntry(&work[0]);
+	for(k = 1; k < numThreads; k++)
+	{
+		if(flagThreadCreated[k] == 1)
+			pthread_join(threads[k], NULL);
+	}
+	
+	// Best start (the first one in case of tie, so the result does not depend on the threads)
+	costInitial = this->startCostInitial[0];
+	for(k = 1; k < this->parameters.numStarts; k++)
+	{
+		costInitial = fmin(costInitial, this->startCostInitial[k]);
+		if(this->startCostFinal[k] < this->startCostFinal[best])
+			best = k;
+	}
+	*trajectory = this->startTrajectory[best];
+	if(this->startCostFinal[best] >= LIMIT_PENALTY)
+		errorCode = 1;
+	
+	if(result != NULL)
+	{
+		result->numBaseParameters = this->regressor.getNumBaseParameters();
+		result->numStarts = this->parameters.numStarts;
+		result->numThreads = numThreads;
+		result->conditionInitial = costInitial;
+		result->conditionFinal = this->startCostFinal[best];
+		result->optimizationTime = getTime() - t0;
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Sample a trajectory into a trajectory file
+ */
+int LiCAS_ExcitationOptimizer::saveTrajectory(const char * fileName, const LiCAS_FOURIER_TRAJECTORY & trajectory, float period, int numPeriods, int armMask)
+{
+	FILE * file = NULL;
+	float q[NUM_ARM_JOINTS];
+	float dq[NUM_ARM_JOINTS];
+	float ddq[NUM_ARM_JOINTS];
+	int numSamples = (int)round(numPeriods/(trajectory.baseFrequency*period));
+	int n = 0;
+	int k = 0;
+	
+	
+	file = fopen(fileName, "w");
+	if(file == NULL)
+		return 1;
+	fprintf(file, "# t qL[%d] qR[%d]\n", NUM_ARM_JOINTS, NUM_ARM_JOINTS);
+	
+	// The last sample closes the last period (at rest)
+	for(n = 0; n <= numSamples; n++)
+	{
+		getTrajectory(trajectory, n*period, q, dq, ddq);
+		fprintf(file, "%.6f", n*period);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			if(armMask & TRAJECTORY_ARM_LEFT)
+				fprintf(file, "\t%.6f", q[k]);
+			else
+				fprintf(file, "\tnan");
+		}
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			if(armMask & TRAJECTORY_ARM_RIGHT)
+				fprintf(file, "\t%.6f", q[k]);
+			else
+				fprintf(file, "\tnan");
+		}
+		fprintf(file, "\n");
+	}
+	fclose(file);
+	
+	
+	return 0;
+}
+
+
+/*
+ * Entry point of the threads of the optimization
+ */
+void * LiCAS_ExcitationOptimizer::workEntry(void * arg)
+{
+	OPTIMIZER_WORK * work = (OPTIMIZER_WORK*)arg;
+	LiCAS_ExcitationOptimizer * optimizer = work->optimizer;
+	int start = 0;
+	
+	
+	for(start = work->first; start < optimizer->parameters.numStarts; start += work->stride)
+		optimizer->search(start, &optimizer->startTrajectory[start], &optimizer->startCostInitial[start], &optimizer->startCostFinal[start]);
+	
+	
+	return NULL;
+}
+
+
+/*
+ * (1+1) evolution strategy from a random trajectory, with the 1/5 success rule for the step
+ */
+void LiCAS_ExcitationOptimizer::search(int start, LiCAS_FOURIER_TRAJECTORY * trajectory, double * costInitial, double * costFinal) const
+{
+	LiCAS_FOURIER_TRAJECTORY trial;
+	double x[NUM_FOURIER_VARIABLES];
+	double y[NUM_FOURIER_VARIABLES];
+	unsigned int seed = 1 + start;
+	double step = ES_INITIAL_STEP;
+	double cost = 0;
+	double trialCost = 0;
+	int numVariables = this->getNumVariables();
+	int numSuccesses = 0;
+	int iteration = 0;
+	int k = 0;
+	
+	
+	this->getRandomTrajectory(&seed, trajectory);
+	this->getVariables(*trajectory, x);
+	cost = this->getCost(*trajectory);
+	*costInitial = cost;
+	trial = *trajectory;
+	
+	for(iteration = 1; iteration <= this->parameters.numIterations; iteration++)
+	{
+		for(k = 0; k < numVariables; k++)
+			y[k] = x[k] + step*getGaussian(&seed);
+		this->setVariables(y, &trial);
+		trialCost = this->getCost(trial);
+		if(trialCost < cost)
+		{
+			for(k = 0; k < numVariables; k++)
+				x[k] = y[k];
+			cost = trialCost;
+			numSuccesses++;
+		}
+		
+		if(iteration % ES_ADAPTATION == 0)
+		{
+			step *= (numSuccesses > ES_ADAPTATION/5) ? 1.22 : 0.82;
+			numSuccesses = 0;
+		}
+	}
+	this->setVariables(x, trajectory);
+	*costFinal = cost;
+}
+
+
+/*
+ * Cost of a trajectory: condition number within the limits, or a penalty that decreases towards
+ * the limits otherwise
+ */
+double LiCAS_ExcitationOptimizer::getCost(const LiCAS_FOURIER_TRAJECTORY & trajectory) const
+{
+	double violation = this->getLimitViolation(trajectory);
+	
+	
+	return (violation > 0) ? LIMIT_PENALTY*(1 + violation) : this->getConditionNumber(trajectory);
+}
+
+
+/*
+ * Variables of the optimization from a trajectory: offsets and first L-1 harmonics of each joint
+ */
+void LiCAS_ExcitationOptimizer::getVariables(const LiCAS_FOURIER_TRAJECTORY & trajectory, double * x) const
+{
+	int L = this->parameters.numHarmonics;
+	int i = 0;
+	int j = 0;
+	int l = 0;
+	
+	
+	for(j = 0; j < NUM_ARM_JOINTS; j++)
+	{
+		x[i++] = trajectory.q0[j];
+		for(l = 0; l < L - 1; l++)
+		{
+			x[i++] = trajectory.a[j][l];
+			x[i++] = trajectory.b[j][l];
+		}
+	}
+}
+
+
+/*
+ * Trajectory from the variables of the optimization, with the last harmonic of rest at the start
+ */
+void LiCAS_ExcitationOptimizer::setVariables(const double * x, LiCAS_FOURIER_TRAJECTORY * trajectory) const
+{
+	double sumA = 0;
+	double sumB = 0;
+	int L = this->parameters.numHarmonics;
+	int i = 0;
+	int j = 0;
+	int l = 0;
+	
+	
+	trajectory->baseFrequency = this->parameters.baseFrequency;
+	trajectory->numHarmonics = L;
+	for(j = 0; j < NUM_ARM_JOINTS; j++)
+	{
+		trajectory->q0[j] = x[i++];
+		sumA = 0;
+		sumB = 0;
+		for(l = 0; l < L - 1; l++)
+		{
+			trajectory->a[j][l] = x[i++];
+			trajectory->b[j][l] = x[i++];
+			sumA += trajectory->a[j][l];
+			sumB += (l + 1)*trajectory->b[j][l];
+		}
+		trajectory->a[j][L - 1] = -sumA;
+		trajectory->b[j][L - 1] = -sumB/L;
+	}
+}
+
+
+/*
+ * Number of variables of the optimization
+ */
+int LiCAS_ExcitationOptimizer::getNumVariables() const
+{
+	return NUM_ARM_JOINTS*(1 + 2*(this->parameters.numHarmonics - 1));
+}
+
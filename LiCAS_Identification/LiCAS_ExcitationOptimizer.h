@@ -0,0 +1,234 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_ExcitationOptimizer.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Optimized excitation trajectories for the identification of the dynamic parameters of an arm.
+ * Each joint follows a periodic trajectory given by a finite Fourier series,
+ *
+ * 	q(t) = q0 + sum_l [a_l/(wf*l)*sin(wf*l*t) - b_l/(wf*l)*cos(wf*l*t)],	l = 1..L
+ *
+ * so the speed and the acceleration are analytic and the measurements can be averaged over several
+ * periods. The last harmonic is fixed so the speed and the acceleration are zero at the start of
+ * each period, and the trajectory can be started and stopped at rest. The coefficients are chosen
+ * to minimize the condition number of the regressor of the base parameters (LiCAS_Regressor)
+ * stacked over one period, with the position, speed and acceleration limits of the joints as a
+ * penalty. The cost is not convex and has many local minima, so it is minimized with a (1+1)
+ * evolution strategy from several random starts, distributed among several threads. Each start
+ * uses its own random seed, so the result does not depend on the number of threads.
+ *
+ * The optimized trajectory is sampled into a trajectory file (saveTrajectory) that is played
+ * through the LiCAS ECI by LiCAS_TrajectoryPlayer.
+ *
+ */
+
+#ifndef LICAS_EXCITATION_OPTIMIZER_H_
+#define LICAS_EXCITATION_OPTIMIZER_H_
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "LiCAS_Regressor.h"
+
+
+// Constant definition
+#define MAX_FOURIER_HARMONICS		10
+#define MAX_OPTIMIZER_THREADS		64
+#define MAX_OPTIMIZER_STARTS		256
+#define MAX_OPTIMIZER_SAMPLES		1000
+#define NUM_FOURIER_VARIABLES		(NUM_ARM_JOINTS*(1 + 2*MAX_FOURIER_HARMONICS))
+#define LIMIT_PENALTY				1e12	// Cost of the trajectories out of the limits
+
+// Arms written in the trajectory file
+#define TRAJECTORY_ARM_LEFT			1
+#define TRAJECTORY_ARM_RIGHT		2
+
+
+// Limits of the joints
+typedef struct
+{
+	float qMin[NUM_ARM_JOINTS];		// Minimum joint positions in [rad]
+	float qMax[NUM_ARM_JOINTS];		// Maximum joint positions in [rad]
+	float dqMax[NUM_ARM_JOINTS];	// Maximum joint speeds in [rad/s]
+	float ddqMax[NUM_ARM_JOINTS];	// Maximum joint accelerations in [rad/s^2]
+} LiCAS_EXCITATION_LIMITS;
+
+
+// Fourier series trajectory of the joints
+typedef struct
+{
+	float baseFrequency;							// Fundamental frequency in [Hz] (period 1/baseFrequency)
+	int numHarmonics;								// Number of harmonics L
+	float q0[NUM_ARM_JOINTS];						// Offset of the joint positions in [rad]
+	float a[NUM_ARM_JOINTS][MAX_FOURIER_HARMONICS];	// Sine coefficients of the joint speeds in [rad/s]
+	float b[NUM_ARM_JOINTS][MAX_FOURIER_HARMONICS];	// Cosine coefficients of the joint speeds in [rad/s]
+} LiCAS_FOURIER_TRAJECTORY;
+
+
+// Parameters of the optimization
+typedef struct
+{
+	float baseFrequency;		// Fundamental frequency in [Hz]
+	int numHarmonics;			// Number of harmonics (2 to MAX_FOURIER_HARMONICS)
+	int numSamples;				// Samples of the period used to evaluate the cost
+	int numStarts;				// Number of random starts
+	int numIterations;			// Iterations of the evolution strategy of each start
+	int numThreads;				// Number of threads (0: number of cores)
+} LiCAS_OPTIMIZER_PARAMETERS;
+
+
+// Result of the optimization
+typedef struct
+{
+	int numBaseParameters;
+	int numStarts;
+	int numThreads;
+	double conditionInitial;	// Best condition number of the random starts
+	double conditionFinal;		// Condition number of the optimized trajectory
+	double optimizationTime;	// Duration of the optimization in [s]
+} LiCAS_OPTIMIZER_RESULT;
+
+
+class LiCAS_ExcitationOptimizer
+{
+public:
+
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Regressor of the arm
+	 * */
+	LiCAS_ExcitationOptimizer(const LiCAS_Regressor & _regressor);
+	
+	
+	/*
+	 * Default limits: conservative range of the joints, 2 rad/s and 8 rad/s^2
+	 */
+	static LiCAS_EXCITATION_LIMITS getDefaultLimits();
+	
+	
+	/*
+	 * Default parameters: 0.1 Hz, 5 harmonics, 200 samples, 16 starts of 300 iterations, all cores
+	 */
+	static LiCAS_OPTIMIZER_PARAMETERS getDefaultParameters();
+	
+	
+	/*
+	 * Set the limits of the joints
+	 */
+	void setLimits(const LiCAS_EXCITATION_LIMITS & _limits);
+	
+	
+	/*
+	 * Set the parameters of the optimization. Returns 0 if the parameters are valid, or 1 otherwise.
+	 */
+	int setParameters(const LiCAS_OPTIMIZER_PARAMETERS & _parameters);
+	
+	
+	/*
+	 * Joint positions, speeds and accelerations of a trajectory at a time in [s]
+	 */
+	static void getTrajectory(const LiCAS_FOURIER_TRAJECTORY & trajectory, float t, float q[NUM_ARM_JOINTS], float dq[NUM_ARM_JOINTS], float ddq[NUM_ARM_JOINTS]);
+	
+	
+	/*
+	 * Condition number of the regressor of the base parameters stacked over a period of the
+	 * trajectory (it does not consider the limits)
+	 */
+	double getConditionNumber(const LiCAS_FOURIER_TRAJECTORY & trajectory) const;
+	
+	
+	/*
+	 * Maximum violation of the limits over a period of the trajectory, relative to the range of the
+	 * positions and to the maximum speeds and accelerations (0 if the trajectory is within the limits)
+	 */
+	double getLimitViolation(const LiCAS_FOURIER_TRAJECTORY & trajectory) const;
+	
+	
+	/*
+	 * Random trajectory within the limits, with a small amplitude around the center of the range
+	 */
+	void getRandomTrajectory(unsigned int * seed, LiCAS_FOURIER_TRAJECTORY * trajectory) const;
+	
+	
+	/*
+	 * Optimize the excitation trajectory. Returns 0 on success, or 1 if no trajectory within the
+	 * limits was found.
+	 *
+	 * Parameters:
+	 * 	(1) Output optimized trajectory
+	 * 	(2) Output result of the optimization (can be NULL)
+	 */
+	int optimize(LiCAS_FOURIER_TRAJECTORY * trajectory, LiCAS_OPTIMIZER_RESULT * result);
+	
+	
+	/*
+	 * Sample a trajectory into a trajectory file: time and joint positions of the left and right arms
+	 * (qL, qR) per line, with "nan" in the joints of the arms not selected. Returns 0 on success, or
+	 * 1 if the file could not be created.
+	 *
+	 * Parameters:
+	 * 	(1) Name of the trajectory file
+	 * 	(2) Trajectory
+	 * 	(3) Sampling period in [s]
+	 * 	(4) Number of periods of the trajectory
+	 * 	(5) Arms: TRAJECTORY_ARM_LEFT | TRAJECTORY_ARM_RIGHT (the same joint positions in both arms)
+	 */
+	static int saveTrajectory(const char * fileName, const LiCAS_FOURIER_TRAJECTORY & trajectory, float period, int numPeriods, int armMask);
+
+
+private:
+
+	// Work of a thread: starts first, first + stride, ...
+	typedef struct
+	{
+		LiCAS_ExcitationOptimizer * optimizer;
+		int first;
+		int stride;
+	} OPTIMIZER_WORK;
+	
+	
+	/***************** PRIVATE VARIABLES *****************/
+	const LiCAS_Regressor & regressor;
+	LiCAS_EXCITATION_LIMITS limits;
+	LiCAS_OPTIMIZER_PARAMETERS parameters;
+	
+	// Result of each start
+	LiCAS_FOURIER_TRAJECTORY startTrajectory[MAX_OPTIMIZER_STARTS];
+	double startCostInitial[MAX_OPTIMIZER_STARTS];
+	double startCostFinal[MAX_OPTIMIZER_STARTS];
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	static void * workEntry(void * arg);
+	
+	void search(int start, LiCAS_FOURIER_TRAJECTORY * trajectory, double * costInitial, double * costFinal) const;
+	
+	double getCost(const LiCAS_FOURIER_TRAJECTORY & trajectory) const;
+	
+	void getVariables(const LiCAS_FOURIER_TRAJECTORY & trajectory, double * x) const;
+	
+	void setVariables(const double * x, LiCAS_FOURIER_TRAJECTORY * trajectory) const;
+	
+	int getNumVariables() const;
+};
+
+#endif
+
@@ -0,0 +1,287 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_FrequencyResponse.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Since the input x and the output y are real, each segment is transformed with a single complex
+ * FFT of z = x + j*y, and the spectra are separated with the symmetry of the transform of real
+ * signals: X[k] = (Z[k] + conj(Z[N-k]))/2, Y[k] = (Z[k] - conj(Z[N-k]))/(2j).
+ *
+ */
+
+#include "LiCAS_FrequencyResponse.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_FrequencyResponse::LiCAS_FrequencyResponse()
+{
+	this->numSegments = 0;
+}
+
+
+/*
+ * Estimate the frequency response. Returns 0 on success, or 1 if the segment length is not a
+ * power of two between MIN_FFT_SIZE and MAX_FFT_SIZE, or there are less samples than a segment.
+ */
+int LiCAS_FrequencyResponse::estimate(const float * x, const float * y, int numSamples, float sampleRate, int segmentLength)
+{
+	LiCAS_BODE_POINT point;
+	double meanX = 0;
+	double meanY = 0;
+	double XRe = 0;
+	double XIm = 0;
+	double YRe = 0;
+	double YIm = 0;
+	double phase = 0;
+	double previousPhase = 0;
+	double step = 0;
+	int N = segmentLength;
+	int hop = segmentLength/2;
+	int start = 0;
+	int n = 0;
+	int k = 0;
+	
+	
+	this->points.clear();
+	this->numSegments = 0;
+	if(N < MIN_FFT_SIZE || N > MAX_FFT_SIZE || (N & (N - 1)) != 0 || numSamples < N || sampleRate <= 0)
+		return 1;
+	
+	this->window.resize(N);
+	this->zRe.resize(N);
+	this->zIm.resize(N);
+	this->Sxx.assign(N/2 + 1, 0);
+	this->Syy.assign(N/2 + 1, 0);
+	this->SyxRe.assign(N/2 + 1, 0);
+	this->SyxIm.assign(N/2 + 1, 0);
+	for(n = 0; n < N; n++)
+		this->window[n] = 0.5*(1 - cos(2*M_PI*n/N));
+	
+	// Welch averaging of the spectra of the segments
+	for(start = 0; start + N <= numSamples; start += hop)
+	{
+		meanX = 0;
+		meanY = 0;
+		for(n = 0; n < N; n++)
+		{
+			meanX += x[start + n];
+			meanY += y[start + n];
+		}
+		meanX /= N;
+		meanY /= N;
+		for(n = 0; n < N; n++)
+		{
+			this->zRe[n] = this->window[n]*(x[start + n] - meanX);
+			this->zIm[n] = this->window[n]*(y[start + n] - meanY);
+		}
+		fft(this->zRe.data(), this->zIm.data(), N);
+		
+		for(k = 1; k <= N/2; k++)
+		{
+			XRe = 0.5*(this->zRe[k] + this->zRe[N - k]);
+			XIm = 0.5*(this->zIm[k] - this->zIm[N - k]);
+			YRe = 0.5*(this->zIm[k] + this->zIm[N - k]);
+			YIm = -0.5*(this->zRe[k] - this->zRe[N - k]);
+			this->Sxx[k] += XRe*XRe + XIm*XIm;
+			this->Syy[k] += YRe*YRe + YIm*YIm;
+			this->SyxRe[k] += XRe*YRe + XIm*YIm;
+			this->SyxIm[k] += XRe*YIm - XIm*YRe;
+		}
+		this->numSegments++;
+	}
+	
+	// H1 estimate, coherence and unwrapped phase
+	for(k = 1; k <= N/2; k++)
+	{
+		point.frequency = k*sampleRate/N;
+		if(this->Sxx[k] > 0)
+		{
+			point.magnitude = 10*log10((this->SyxRe[k]*this->SyxRe[k] + this->SyxIm[k]*this->SyxIm[k])/(this->Sxx[k]*this->Sxx[k]) + 1e-30);
+			point.coherence = (this->Syy[k] > 0) ? (this->SyxRe[k]*this->SyxRe[k] + this->SyxIm[k]*this->SyxIm[k])/(this->Sxx[k]*this->Syy[k]) : 0;
+			phase = atan2(this->SyxIm[k], this->SyxRe[k])*180/M_PI;
+		}
+		else
+		{
+			point.magnitude = -600;
+			point.coherence = 0;
+			phase = previousPhase;
+		}
+		if(k > 1)
+		{
+			step = fmod(phase - previousPhase + 540.0, 360.0) - 180.0;
+			phase = previousPhase + step;
+		}
+		point.phase = phase;
+		previousPhase = phase;
+		this->points.push_back(point);
+	}
+	
+	
+	return 0;
+}
+
+
+/*
+ * Number of points of the estimate (segmentLength/2, without the DC component)
+ */
+int LiCAS_FrequencyResponse::getNumPoints() const
+{
+	return (int)this->points.size();
+}
+
+
+/*
+ * Point of the estimate
+ */
+const LiCAS_BODE_POINT & LiCAS_FrequencyResponse::getPoint(int k) const
+{
+	return this->points[k];
+}
+
+
+/*
+ * Number of segments averaged in the last estimate
+ */
+int LiCAS_FrequencyResponse::getNumSegments() const
+{
+	return this->numSegments;
+}
+
+
+/*
+ * Bandwidth in [Hz]: first reliable frequency in which the magnitude is 3 dB below the magnitude
+ * of the lowest reliable frequency. Returns 0 if the magnitude does not fall 3 dB in the band.
+ */
+float LiCAS_FrequencyResponse::getBandwidth() const
+{
+	float referenceMagnitude = 0;
+	float bandwidth = 0;
+	int flagReference = 0;
+	size_t k = 0;
+	
+	
+	for(k = 0; k < this->points.size() && bandwidth == 0; k++)
+	{
+		if(this->points[k].coherence < COHERENCE_THRESHOLD)
+			continue;
+		if(flagReference == 0)
+		{
+			referenceMagnitude = this->points[k].magnitude;
+			flagReference = 1;
+		}
+		else if(this->points[k].magnitude < referenceMagnitude - 3)
+			bandwidth = this->points[k].frequency;
+	}
+	
+	
+	return bandwidth;
+}
+
+
+/*
+ * Equivalent delay in [s]: slope of the phase w.r.t. the angular frequency, fitted by least
+ * squares over the reliable points. Returns 0 if there are less than two reliable points.
+ */
+float LiCAS_FrequencyResponse::getDelay() const
+{
+	double w = 0;
+	double phase = 0;
+	double sw = 0;
+	double sp = 0;
+	double sww = 0;
+	double swp = 0;
+	double det = 0;
+	int numPoints = 0;
+	size_t k = 0;
+	
+	
+	for(k = 0; k < this->points.size(); k++)
+	{
+		if(this->points[k].coherence < COHERENCE_THRESHOLD)
+			continue;
+		w = 2*M_PI*this->points[k].frequency;
+		phase = this->points[k].phase*M_PI/180;
+		sw += w;
+		sp += phase;
+		sww += w*w;
+		swp += w*phase;
+		numPoints++;
+	}
+	det = numPoints*sww - sw*sw;
+	
+	
+	return (numPoints >= 2 && det > 0) ? -(numPoints*swp - sw*sp)/det : 0;
+}
+
+
+/*
+ * Radix-2 FFT in place (the size must be a power of two)
+ */
+void LiCAS_FrequencyResponse::fft(float * re, float * im, int n)
+{
+	float tRe = 0;
+	float tIm = 0;
+	double angle = 0;
+	float wRe = 0;
+	float wIm = 0;
+	int length = 0;
+	int half = 0;
+	int i = 0;
+	int j = 0;
+	int k = 0;
+	
+	
+	// Bit reversal permutation
+	for(i = 1, j = 0; i < n; i++)
+	{
+		k = n >> 1;
+		while(j & k)
+		{
+			j ^= k;
+			k >>= 1;
+		}
+		j |= k;
+		if(i < j)
+		{
+			tRe = re[i];
+			re[i] = re[j];
+			re[j] = tRe;
+			tIm = im[i];
+			im[i] = im[j];
+			im[j] = tIm;
+		}
+	}
+	
+	// Butterflies
+	for(length = 2; length <= n; length <<= 1)
+	{
+		half = length >> 1;
+		for(k = 0; k < half; k++)
+		{
+			angle = -2*M_PI*k/length;
+			wRe = cos(angle);
+			wIm = sin(angle);
+			for(i = k; i < n; i += length)
+			{
+				j = i + half;
+				tRe = wRe*re[j] - wIm*im[j];
+				tIm = wRe*im[j] + wIm*re[j];
+				re[j] = re[i] - tRe;
+				im[j] = im[i] - tIm;
+				re[i] += tRe;
+				im[i] += tIm;
+			}
+		}
+	}
+}
+
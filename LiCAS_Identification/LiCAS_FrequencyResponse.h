@@ -0,0 +1,133 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_FrequencyResponse.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Non-parametric estimation of the frequency response (Bode diagram) of a joint from its reference
+ * (input) and its measured position (output), sampled uniformly. The spectra are averaged with
+ * the Welch method: segments of a power of two samples with 50% overlap, Hann window and mean
+ * removal, transformed with a radix-2 FFT. The response is the H1 estimate, H = Syx/Sxx, and the
+ * coherence |Syx|^2/(Sxx*Syy) indicates the frequencies in which the estimate is reliable
+ * (excited band, linear behavior, low noise).
+ *
+ */
+
+#ifndef LICAS_FREQUENCY_RESPONSE_H_
+#define LICAS_FREQUENCY_RESPONSE_H_
+
+
+// Standard library
+#include <vector>
+#include <math.h>
+
+
+// Constant definition
+#define MIN_FFT_SIZE			16
+#define MAX_FFT_SIZE			65536
+#define COHERENCE_THRESHOLD		0.9		// Minimum coherence of the reliable points of the estimate
+
+
+// Point of the Bode diagram
+typedef struct
+{
+	float frequency;			// Frequency in [Hz]
+	float magnitude;			// Magnitude in [dB]
+	float phase;				// Phase in [deg] (unwrapped)
+	float coherence;			// Coherence in [0, 1]
+} LiCAS_BODE_POINT;
+
+
+class LiCAS_FrequencyResponse
+{
+public:
+
+	/*
+	 * Constructor
+	 * */
+	LiCAS_FrequencyResponse();
+	
+	
+	/*
+	 * Estimate the frequency response. Returns 0 on success, or 1 if the segment length is not a
+	 * power of two between MIN_FFT_SIZE and MAX_FFT_SIZE, or there are less samples than a segment.
+	 *
+	 * Parameters:
+	 * 	(1) Input signal (joint reference)
+	 * 	(2) Output signal (joint position)
+	 * 	(3) Number of samples
+	 * 	(4) Sample rate in [Hz]
+	 * 	(5) Samples of each segment (frequency resolution sampleRate/segmentLength)
+	 */
+	int estimate(const float * x, const float * y, int numSamples, float sampleRate, int segmentLength);
+	
+	
+	/*
+	 * Number of points of the estimate (segmentLength/2, without the DC component)
+	 */
+	int getNumPoints() const;
+	
+	
+	/*
+	 * Point of the estimate
+	 */
+	const LiCAS_BODE_POINT & getPoint(int k) const;
+	
+	
+	/*
+	 * Number of segments averaged in the last estimate
+	 */
+	int getNumSegments() const;
+	
+	
+	/*
+	 * Bandwidth in [Hz]: first reliable frequency in which the magnitude is 3 dB below the magnitude
+	 * of the lowest reliable frequency. Returns 0 if the magnitude does not fall 3 dB in the band.
+	 */
+	float getBandwidth() const;
+	
+	
+	/*
+	 * Equivalent delay in [s]: slope of the phase w.r.t. the angular frequency, fitted by least
+	 * squares over the reliable points. Returns 0 if there are less than two reliable points.
+	 */
+	float getDelay() const;
+	
+	
+	/*
+	 * Radix-2 FFT in place (the size must be a power of two)
+	 *
+	 * Parameters:
+	 * 	(1) Real part
+	 * 	(2) Imaginary part
+	 * 	(3) Size
+	 */
+	static void fft(float * re, float * im, int n);
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	std::vector<LiCAS_BODE_POINT> points;
+	int numSegments;
+	
+	// Buffers of the estimate, reused among calls. The input and the output are transformed together
+	// as the real and imaginary parts of a single complex signal.
+	std::vector<float> window;
+	std::vector<float> zRe;
+	std::vector<float> zIm;
+	std::vector<double> Sxx;
+	std::vector<double> Syy;
+	std::vector<double> SyxRe;
+	std::vector<double> SyxIm;
+};
+
+#endif
+
@@ -0,0 +1,263 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_PayloadEstimator.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * The inertia of the point mass about the elbow, I = (|h|^2*E - h*h')/m with h the first moment,
+ * is not linear in the parameters. Its contribution is evaluated with the previous estimate and
+ * subtracted from the residual, so the model of the estimator is the same as the model of
+ * LiCAS_ArmDynamics::setPayload.
+ *
+ */
+
+#include "LiCAS_PayloadEstimator.h"
+
+
+// First column of the forearm in the regressor
+#define PAYLOAD_FIRST_COLUMN	(NUM_LINK_PARAMETERS*(NUM_ARM_JOINTS - 1))
+
+
+/*
+ * Constructor
+ *
+ * Parameters:
+ * 	(1) Geometry of the arms
+ * 	(2) Dynamic parameters of the arms without payload (left arm)
+ * 	(3) Forgetting factor of the recursive least squares per update, in (0, 1]
+ * */
+LiCAS_PayloadEstimator::LiCAS_PayloadEstimator(const LiCAS_ARM_GEOMETRY & _geometry, const LiCAS_ARM_DYNAMICS & _dynamics, float _forgettingFactor)
+{
+	int side = 0;
+	
+	
+	this->forgettingFactor = _forgettingFactor;
+	for(side = 0; side < 2; side++)
+	{
+		this->arm[side].regressor = new LiCAS_Regressor(side, _geometry);
+		this->arm[side].model = new LiCAS_ArmDynamics(side, _geometry, _dynamics);
+		this->arm[side].feedforward = NULL;
+		this->resetArm(&this->arm[side]);
+	}
+}
+
+
+/*
+ * Destructor
+ * */
+LiCAS_PayloadEstimator::~LiCAS_PayloadEstimator()
+{
+	int side = 0;
+	
+	
+	for(side = 0; side < 2; side++)
+	{
+		delete this->arm[side].regressor;
+		delete this->arm[side].model;
+	}
+}
+
+
+/*
+ * Set the models of the feedforward that receive the estimated payload after each update
+ */
+void LiCAS_PayloadEstimator::setFeedforward(LiCAS_ArmDynamics * _feedforwardL, LiCAS_ArmDynamics * _feedforwardR)
+{
+	this->arm[LiCAS_ARM_LEFT].feedforward = _feedforwardL;
+	this->arm[LiCAS_ARM_RIGHT].feedforward = _feedforwardR;
+}
+
+
+/*
+ * Update the estimate of an arm with a new feedback sample
+ */
+void LiCAS_PayloadEstimator::update(int side, const float q[NUM_ARM_JOINTS], const float dq[NUM_ARM_JOINTS], const float tau[NUM_ARM_JOINTS], float t)
+{
+	PAYLOAD_ARM_ESTIMATOR * estimator = &this->arm[side];
+	LiCAS_REGRESSOR Y;
+	float tauModel[NUM_ARM_JOINTS];
+	double inertia[6];
+	double Pphi[NUM_PAYLOAD_PARAMETERS];
+	double gain[NUM_PAYLOAD_PARAMETERS];
+	const double * phi = NULL;
+	double h2 = 0;
+	double residual = 0;
+	double denominator = 0;
+	double trace = 0;
+	float dt = t - estimator->tPrevious;
+	float alpha = 0;
+	int i = 0;
+	int j = 0;
+	int k = 0;
+	
+	
+	// Joint accelerations: filtered difference of the joint speeds
+	if(estimator->numSamples == 0 || dt <= 0 || dt > PAYLOAD_MAX_PERIOD)
+	{
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			estimator->dqPrevious[k] = dq[k];
+			estimator->ddq[k] = 0;
+		}
+		estimator->tPrevious = t;
+		estimator->numSamples = 1;
+		return;
+	}
+	alpha = dt/(dt + 1.0/(2*M_PI*PAYLOAD_ACCELERATION_CUTOFF));
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		estimator->ddq[k] += alpha*((dq[k] - estimator->dqPrevious[k])/dt - estimator->ddq[k]);
+		estimator->dqPrevious[k] = dq[k];
+	}
+	estimator->tPrevious = t;
+	estimator->numSamples++;
+	
+	// Residual of the nominal model, without the inertia of the point mass of the previous estimate
+	estimator->model->inverseDynamics(q, dq, estimator->ddq, tauModel);
+	estimator->regressor->getRegressor(q, dq, estimator->ddq, Y);
+	for(k = 0; k < 6; k++)
+		inertia[k] = 0;
+	if(estimator->theta[0] > PAYLOAD_MIN_MASS)
+	{
+		h2 = estimator->theta[1]*estimator->theta[1] + estimator->theta[2]*estimator->theta[2] + estimator->theta[3]*estimator->theta[3];
+		inertia[0] = (h2 - estimator->theta[1]*estimator->theta[1])/estimator->theta[0];
+		inertia[1] = -estimator->theta[1]*estimator->theta[2]/estimator->theta[0];
+		inertia[2] = -estimator->theta[1]*estimator->theta[3]/estimator->theta[0];
+		inertia[3] = (h2 - estimator->theta[2]*estimator->theta[2])/estimator->theta[0];
+		inertia[4] = -estimator->theta[2]*estimator->theta[3]/estimator->theta[0];
+		inertia[5] = (h2 - estimator->theta[3]*estimator->theta[3])/estimator->theta[0];
+	}
+	
+	// Exponential forgetting, limited so the covariance does not grow without excitation
+	for(i = 0; i < NUM_PAYLOAD_PARAMETERS; i++)
+		trace += estimator->P[i][i];
+	if(trace/this->forgettingFactor < PAYLOAD_MAX_COVARIANCE)
+	{
+		for(i = 0; i < NUM_PAYLOAD_PARAMETERS; i++)
+			for(j = 0; j < NUM_PAYLOAD_PARAMETERS; j++)
+				estimator->P[i][j] /= this->forgettingFactor;
+	}
+	
+	// Recursive least squares, one scalar update per joint
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		phi = &Y[k][PAYLOAD_FIRST_COLUMN];
+		residual = tau[k] - tauModel[k];
+		for(i = 0; i < 6; i++)
+			residual -= Y[k][PAYLOAD_FIRST_COLUMN + NUM_PAYLOAD_PARAMETERS + i]*inertia[i];
+		denominator = 1;
+		for(i = 0; i < NUM_PAYLOAD_PARAMETERS; i++)
+		{
+			Pphi[i] = 0;
+			for(j = 0; j < NUM_PAYLOAD_PARAMETERS; j++)
+				Pphi[i] += estimator->P[i][j]*phi[j];
+			denominator += phi[i]*Pphi[i];
+			residual -= phi[i]*estimator->theta[i];
+		}
+		for(i = 0; i < NUM_PAYLOAD_PARAMETERS; i++)
+		{
+			gain[i] = Pphi[i]/denominator;
+			estimator->theta[i] += gain[i]*residual;
+		}
+		for(i = 0; i < NUM_PAYLOAD_PARAMETERS; i++)
+			for(j = 0; j < NUM_PAYLOAD_PARAMETERS; j++)
+				estimator->P[i][j] -= gain[i]*Pphi[j];
+	}
+	
+	// Mass and position of the payload
+	estimator->mass = (estimator->theta[0] > 0) ? estimator->theta[0] : 0;
+	for(k = 0; k < 3; k++)
+		estimator->position[k] = (estimator->theta[0] > PAYLOAD_MIN_MASS) ? estimator->theta[1 + k]/estimator->theta[0] : 0;
+	if(estimator->feedforward != NULL)
+		estimator->feedforward->setPayload(estimator->mass, estimator->position);
+}
+
+
+/*
+ * Feedback callback of the LiCAS ECI: update of both arms
+ */
+void LiCAS_PayloadEstimator::feedbackCallback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t, void * userData)
+{
+	LiCAS_PayloadEstimator * estimator = (LiCAS_PayloadEstimator*)userData;
+	float q[NUM_ARM_JOINTS];
+	float dq[NUM_ARM_JOINTS];
+	float tau[NUM_ARM_JOINTS];
+	int k = 0;
+	
+	
+	// Copy of the fields of the packed structure
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		q[k] = dataPacketFeedback->qL[k];
+		dq[k] = dataPacketFeedback->dqL[k];
+		tau[k] = dataPacketFeedback->tauL[k];
+	}
+	estimator->update(LiCAS_ARM_LEFT, q, dq, tau, t);
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		q[k] = dataPacketFeedback->qR[k];
+		dq[k] = dataPacketFeedback->dqR[k];
+		tau[k] = dataPacketFeedback->tauR[k];
+	}
+	estimator->update(LiCAS_ARM_RIGHT, q, dq, tau, t);
+}
+
+
+/*
+ * Get the estimated payload of an arm
+ */
+void LiCAS_PayloadEstimator::getPayload(int side, float * mass, float position[3]) const
+{
+	int k = 0;
+	
+	
+	*mass = this->arm[side].mass;
+	for(k = 0; k < 3; k++)
+		position[k] = this->arm[side].position[k];
+}
+
+
+/*
+ * Restart the estimation of both arms
+ */
+void LiCAS_PayloadEstimator::reset()
+{
+	this->resetArm(&this->arm[LiCAS_ARM_LEFT]);
+	this->resetArm(&this->arm[LiCAS_ARM_RIGHT]);
+}
+
+
+/*
+ * No payload and initial covariance
+ */
+void LiCAS_PayloadEstimator::resetArm(PAYLOAD_ARM_ESTIMATOR * estimator)
+{
+	int i = 0;
+	int j = 0;
+	
+	
+	for(i = 0; i < NUM_PAYLOAD_PARAMETERS; i++)
+	{
+		estimator->theta[i] = 0;
+		for(j = 0; j < NUM_PAYLOAD_PARAMETERS; j++)
+			estimator->P[i][j] = (i == j) ? PAYLOAD_INITIAL_COVARIANCE : 0;
+	}
+	for(i = 0; i < NUM_ARM_JOINTS; i++)
+	{
+		estimator->dqPrevious[i] = 0;
+		estimator->ddq[i] = 0;
+	}
+	estimator->tPrevious = 0;
+	estimator->numSamples = 0;
+	estimator->mass = 0;
+	for(i = 0; i < 3; i++)
+		estimator->position[i] = 0;
+}
+
@@ -0,0 +1,157 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_PayloadEstimator.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Online estimation of the payload of the arms (tool or grasped object) from the joint torques of
+ * the feedback. The payload is a point mass attached to the forearm, and the torque residual of
+ * each arm (measured torque minus the torque of the nominal model LiCAS_ArmDynamics) is linear in
+ * its mass and first moments (mass times position), given by the columns of the forearm in the
+ * regressor of LiCAS_Regressor. These 4 parameters are estimated by recursive least squares with
+ * exponential forgetting, one scalar update per joint, so each feedback data packet is processed
+ * in constant time and without allocating memory. The joint accelerations are obtained from the
+ * joint speeds with a first order low pass filter.
+ *
+ * The estimate (mass and position of the payload) can be applied after each update to the models
+ * used for the gravity and inverse dynamics feedforward (LiCAS_ArmDynamics::setPayload). The
+ * estimator is executed in the feedback pipeline of the LiCAS ECI through its feedback callback.
+ *
+ * Example:
+ *
+ * 	LiCAS_PayloadEstimator estimator(geometry, LiCAS_ArmDynamics::getDefaultDynamics(), 0.999);
+ *
+ * 	estimator.setFeedforward(&feedforwardL, &feedforwardR);
+ * 	licas_eci->setFeedbackCallback(LiCAS_PayloadEstimator::feedbackCallback, &estimator);
+ *
+ */
+
+#ifndef LICAS_PAYLOAD_ESTIMATOR_H_
+#define LICAS_PAYLOAD_ESTIMATOR_H_
+
+
+// Standard library
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "../LiCAS_Kinematics/LiCAS_ArmDynamics.h"
+#include "LiCAS_Regressor.h"
+
+
+// Constant definition
+#define NUM_PAYLOAD_PARAMETERS			4		// m, m*px, m*py, m*pz
+#define PAYLOAD_INITIAL_COVARIANCE		1.0		// Initial covariance of the parameters
+#define PAYLOAD_MAX_COVARIANCE			100.0	// Maximum trace of the covariance (no wind-up without excitation)
+#define PAYLOAD_MIN_MASS				0.01	// Minimum mass for estimating the position of the payload in [kg]
+#define PAYLOAD_ACCELERATION_CUTOFF		10.0	// Cutoff frequency of the joint acceleration filter in [Hz]
+#define PAYLOAD_MAX_PERIOD				0.1		// Maximum time between updates for the joint accelerations in [s]
+
+
+class LiCAS_PayloadEstimator
+{
+public:
+
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Geometry of the arms
+	 * 	(2) Dynamic parameters of the arms without payload (left arm)
+	 * 	(3) Forgetting factor of the recursive least squares per update, in (0, 1]
+	 * */
+	LiCAS_PayloadEstimator(const LiCAS_ARM_GEOMETRY & _geometry, const LiCAS_ARM_DYNAMICS & _dynamics, float _forgettingFactor);
+	
+	
+	/*
+	 * Destructor
+	 * */
+	virtual ~LiCAS_PayloadEstimator();
+	
+	
+	/*
+	 * Set the models of the feedforward that receive the estimated payload after each update (the
+	 * update is made by the thread that calls update(), the reception thread of the LiCAS ECI).
+	 *
+	 * Parameters:
+	 * 	(1) Model of the left arm (NULL for none)
+	 * 	(2) Model of the right arm (NULL for none)
+	 */
+	void setFeedforward(LiCAS_ArmDynamics * _feedforwardL, LiCAS_ArmDynamics * _feedforwardR);
+	
+	
+	/*
+	 * Update the estimate of an arm with a new feedback sample
+	 *
+	 * Parameters:
+	 * 	(1) Arm side: LiCAS_ARM_LEFT or LiCAS_ARM_RIGHT
+	 * 	(2) Joint positions in [rad]
+	 * 	(3) Joint speeds in [rad/s]
+	 * 	(4) Joint torques in [Nm]
+	 * 	(5) Time of the sample in [s]
+	 */
+	void update(int side, const float q[NUM_ARM_JOINTS], const float dq[NUM_ARM_JOINTS], const float tau[NUM_ARM_JOINTS], float t);
+	
+	
+	/*
+	 * Feedback callback of the LiCAS ECI (userData: pointer to the estimator). It updates the
+	 * estimates of both arms with the feedback data packet.
+	 */
+	static void feedbackCallback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t, void * userData);
+	
+	
+	/*
+	 * Get the estimated payload of an arm
+	 *
+	 * Parameters:
+	 * 	(1) Arm side: LiCAS_ARM_LEFT or LiCAS_ARM_RIGHT
+	 * 	(2) Mass of the payload in [kg]
+	 * 	(3) Position of the payload in the frame of the forearm in [m]
+	 */
+	void getPayload(int side, float * mass, float position[3]) const;
+	
+	
+	/*
+	 * Restart the estimation of both arms (no payload, initial covariance)
+	 */
+	void reset();
+
+
+private:
+
+	// State of the estimator of an arm
+	typedef struct
+	{
+		LiCAS_Regressor * regressor;
+		LiCAS_ArmDynamics * model;			// Nominal model without payload
+		LiCAS_ArmDynamics * feedforward;	// Model that receives the estimate
+		double theta[NUM_PAYLOAD_PARAMETERS];
+		double P[NUM_PAYLOAD_PARAMETERS][NUM_PAYLOAD_PARAMETERS];
+		float dqPrevious[NUM_ARM_JOINTS];
+		float ddq[NUM_ARM_JOINTS];
+		float tPrevious;
+		int numSamples;
+		float mass;
+		float position[3];
+	} PAYLOAD_ARM_ESTIMATOR;
+	
+	
+	/***************** PRIVATE VARIABLES *****************/
+	float forgettingFactor;
+	PAYLOAD_ARM_ESTIMATOR arm[2];		// Left and right arms
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	void resetArm(PAYLOAD_ARM_ESTIMATOR * estimator);
+};
+
+#endif
+
@@ -0,0 +1,340 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_Regressor.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * The regressor is built with the Newton-Euler equations in the base frame. The forward recursion
+ * computes the angular velocity and acceleration of each link and the linear acceleration of its
+ * origin (with the gravity as an upwards acceleration of the base). The wrench of a link per unit
+ * of each of its parameters is computed in the frame of the link,
+ *
+ * 	f = m*a + alpha x mc + w x (w x mc)
+ * 	n = I*alpha + w x (I*w) + mc x a
+ *
+ * and its contribution to the torque of each joint j moving the link is the projection on the
+ * axis of the joint of the moment about the origin of the joint. The kinematics is computed in
+ * double precision, so the dependent columns are detected reliably.
+ *
+ */
+
+#include "LiCAS_Regressor.h"
+
+
+typedef LiCAS_Matrix<3, 1, double> LiCAS_Vector3d;
+typedef LiCAS_Matrix<3, 3, double> LiCAS_Matrix3d;
+
+
+static LiCAS_Matrix3d getRotationX(double angle)
+{
+	LiCAS_Matrix3d R = LiCAS_Matrix3d::identity();
+	
+	
+	R(1, 1) = cos(angle);
+	R(1, 2) = -sin(angle);
+	R(2, 1) = sin(angle);
+	R(2, 2) = cos(angle);
+	
+	
+	return R;
+}
+
+
+static LiCAS_Matrix3d getRotationY(double angle)
+{
+	LiCAS_Matrix3d R = LiCAS_Matrix3d::identity();
+	
+	
+	R(0, 0) = cos(angle);
+	R(0, 2) = sin(angle);
+	R(2, 0) = -sin(angle);
+	R(2, 2) = cos(angle);
+	
+	
+	return R;
+}
+
+
+static LiCAS_Matrix3d getRotationZ(double angle)
+{
+	LiCAS_Matrix3d R = LiCAS_Matrix3d::identity();
+	
+	
+	R(0, 0) = cos(angle);
+	R(0, 1) = -sin(angle);
+	R(1, 0) = sin(angle);
+	R(1, 1) = cos(angle);
+	
+	
+	return R;
+}
+
+
+/*
+ * Symmetric matrix with a unit element of the inertia tensor (Ixx, Ixy, Ixz, Iyy, Iyz, Izz)
+ */
+static LiCAS_Matrix3d getUnitInertia(int k)
+{
+	static const int row[6] = {0, 0, 0, 1, 1, 2};
+	static const int col[6] = {0, 1, 2, 1, 2, 2};
+	LiCAS_Matrix3d I = LiCAS_Matrix3d::zeros();
+	
+	
+	I(row[k], col[k]) = 1;
+	I(col[k], row[k]) = 1;
+	
+	
+	return I;
+}
+
+
+/*
+ * Constructor
+ * */
+LiCAS_Regressor::LiCAS_Regressor(int _side, const LiCAS_ARM_GEOMETRY & _geometry)
+{
+	this->side = _side;
+	this->mirror = (_side == LiCAS_ARM_RIGHT) ? -1.0 : 1.0;
+	this->geometry = _geometry;
+	this->numBaseParameters = 0;
+	this->findBaseParameters();
+}
+
+
+/*
+ * Regressor of the inverse dynamics
+ */
+void LiCAS_Regressor::getRegressor(const float q[NUM_ARM_JOINTS], const float dq[NUM_ARM_JOINTS], const float ddq[NUM_ARM_JOINTS], LiCAS_REGRESSOR Y) const
+{
+	LiCAS_Matrix3d R[NUM_ARM_JOINTS];
+	LiCAS_Matrix3d Rt;
+	LiCAS_Matrix3d I;
+	LiCAS_Vector3d p[NUM_ARM_JOINTS];
+	LiCAS_Vector3d z[NUM_ARM_JOINTS];
+	LiCAS_Vector3d w;
+	LiCAS_Vector3d alpha;
+	LiCAS_Vector3d a;
+	LiCAS_Vector3d wPrev = LiCAS_Vector3d::zeros();
+	LiCAS_Vector3d alphaPrev = LiCAS_Vector3d::zeros();
+	LiCAS_Vector3d aPrev = LiCAS_Vector3d::zeros();
+	LiCAS_Vector3d pPrev;
+	LiCAS_Vector3d r;
+	LiCAS_Vector3d wl;
+	LiCAS_Vector3d alphal;
+	LiCAS_Vector3d al;
+	LiCAS_Vector3d e;
+	LiCAS_Vector3d f;
+	LiCAS_Vector3d n;
+	LiCAS_Vector3d upperArm;
+	double angle[NUM_ARM_JOINTS];
+	int column = 0;
+	int i = 0;
+	int j = 0;
+	int k = 0;
+	
+	
+	for(i = 0; i < NUM_ARM_JOINTS; i++)
+	{
+		angle[i] = (double)q[i] + this->geometry.jointOffset[i];
+		for(k = 0; k < NUM_DYNAMIC_PARAMETERS; k++)
+			Y[i][k] = 0;
+	}
+	
+	// Frames and axes of the joints (same chain as LiCAS_ArmKinematics)
+	R[0] = getRotationY(angle[0]);
+	R[1] = R[0]*getRotationX(this->mirror*angle[1]);
+	R[2] = R[1]*getRotationZ(this->mirror*angle[2]);
+	R[3] = R[2]*getRotationY(angle[3]);
+	p[0][0] = 0;
+	p[0][1] = this->mirror*this->geometry.shoulderOffsetY;
+	p[0][2] = this->geometry.shoulderOffsetZ;
+	p[1] = p[0];
+	p[2] = p[0];
+	upperArm[0] = 0;
+	upperArm[1] = 0;
+	upperArm[2] = -this->geometry.upperArmLength;
+	p[3] = p[0] + R[2]*upperArm;
+	for(k = 0; k < 3; k++)
+	{
+		z[0][k] = R[0](k, 1);
+		z[1][k] = this->mirror*R[1](k, 0);
+		z[2][k] = this->mirror*R[2](k, 2);
+		z[3][k] = R[3](k, 1);
+	}
+	
+	// Gravity as an upwards acceleration of the base
+	aPrev[2] = GRAVITY_ACCELERATION;
+	pPrev = p[0];
+	for(i = 0; i < NUM_ARM_JOINTS; i++)
+	{
+		// Forward recursion: velocities and accelerations of the link
+		r = p[i] - pPrev;
+		w = wPrev + (double)dq[i]*z[i];
+		alpha = alphaPrev + (double)ddq[i]*z[i] + cross(wPrev, (double)dq[i]*z[i]);
+		a = aPrev + cross(alphaPrev, r) + cross(wPrev, cross(wPrev, r));
+		
+		// Link frame
+		Rt = transpose(R[i]);
+		wl = Rt*w;
+		alphal = Rt*alpha;
+		al = Rt*a;
+		
+		// Wrench of the link per unit of each parameter, projected on the joints moving the link
+		for(k = 0; k < NUM_LINK_PARAMETERS; k++)
+		{
+			f = LiCAS_Vector3d::zeros();
+			n = LiCAS_Vector3d::zeros();
+			if(k == 0)
+				f = al;
+			else if(k < 4)
+			{
+				e = LiCAS_Vector3d::zeros();
+				e[k - 1] = 1;
+				f = cross(alphal, e) + cross(wl, cross(wl, e));
+				n = cross(e, al);
+			}
+			else
+			{
+				I = getUnitInertia(k - 4);
+				n = I*alphal + cross(wl, I*wl);
+			}
+			f = R[i]*f;
+			n = R[i]*n;
+			
+			column = NUM_LINK_PARAMETERS*i + k;
+			for(j = 0; j <= i; j++)
+				Y[j][column] = dot(z[j], n + cross(p[i] - p[j], f));
+		}
+		
+		wPrev = w;
+		alphaPrev = alpha;
+		aPrev = a;
+		pPrev = p[i];
+	}
+	
+	// Viscous and Coulomb friction
+	for(j = 0; j < NUM_ARM_JOINTS; j++)
+	{
+		column = NUM_ARM_JOINTS*NUM_LINK_PARAMETERS + NUM_FRICTION_PARAMETERS*j;
+		Y[j][column] = dq[j];
+		Y[j][column + 1] = (dq[j] > 0) ? 1 : ((dq[j] < 0) ? -1 : 0);
+	}
+}
+
+
+/*
+ * Number of base parameters (independent columns of the regressor)
+ */
+int LiCAS_Regressor::getNumBaseParameters() const
+{
+	return this->numBaseParameters;
+}
+
+
+/*
+ * Columns of the regressor of the base parameters
+ */
+const int * LiCAS_Regressor::getBaseParameters() const
+{
+	return this->baseParameters;
+}
+
+
+/*
+ * Independent columns of the regressor stacked for random samples, selected with a Gram-Schmidt
+ * orthogonalization with pivoting on the normalized columns
+ */
+void LiCAS_Regressor::findBaseParameters()
+{
+	LiCAS_REGRESSOR Y;
+	double * M = NULL;
+	double residual[NUM_DYNAMIC_PARAMETERS];
+	int flagSelected[NUM_DYNAMIC_PARAMETERS];
+	float q[NUM_ARM_JOINTS];
+	float dq[NUM_ARM_JOINTS];
+	float ddq[NUM_ARM_JOINTS];
+	unsigned int seed = 1;
+	int numRows = BASE_PARAMETER_SAMPLES*NUM_ARM_JOINTS;
+	double projection = 0;
+	double length = 0;
+	int pivot = 0;
+	int n = 0;
+	int i = 0;
+	int j = 0;
+	int k = 0;
+	
+	
+	// Stacked regressor (rows of the samples, column major) with normalized columns
+	M = new double[numRows*NUM_DYNAMIC_PARAMETERS];
+	for(n = 0; n < BASE_PARAMETER_SAMPLES; n++)
+	{
+		for(j = 0; j < NUM_ARM_JOINTS; j++)
+		{
+			q[j] = M_PI*(2.0*rand_r(&seed)/RAND_MAX - 1);
+			dq[j] = 2*(2.0*rand_r(&seed)/RAND_MAX - 1);
+			ddq[j] = 5*(2.0*rand_r(&seed)/RAND_MAX - 1);
+		}
+		this->getRegressor(q, dq, ddq, Y);
+		for(j = 0; j < NUM_ARM_JOINTS; j++)
+			for(k = 0; k < NUM_DYNAMIC_PARAMETERS; k++)
+				M[k*numRows + n*NUM_ARM_JOINTS + j] = Y[j][k];
+	}
+	for(k = 0; k < NUM_DYNAMIC_PARAMETERS; k++)
+	{
+		length = 0;
+		for(i = 0; i < numRows; i++)
+			length += M[k*numRows + i]*M[k*numRows + i];
+		length = sqrt(length);
+		for(i = 0; i < numRows; i++)
+			M[k*numRows + i] = (length > 0) ? M[k*numRows + i]/length : 0;
+		residual[k] = (length > 0) ? 1 : 0;
+		flagSelected[k] = 0;
+	}
+	
+	// Select the column with the largest residual until the remaining columns are dependent
+	this->numBaseParameters = 0;
+	while(this->numBaseParameters < NUM_DYNAMIC_PARAMETERS)
+	{
+		pivot = -1;
+		for(k = 0; k < NUM_DYNAMIC_PARAMETERS; k++)
+			if(flagSelected[k] == 0 && (pivot < 0 || residual[k] > residual[pivot]))
+				pivot = k;
+		if(pivot < 0 || residual[pivot] < BASE_PARAMETER_TOLERANCE*BASE_PARAMETER_TOLERANCE)
+			break;
+		flagSelected[pivot] = 1;
+		this->numBaseParameters++;
+		
+		length = sqrt(residual[pivot]);
+		for(i = 0; i < numRows; i++)
+			M[pivot*numRows + i] /= length;
+		for(k = 0; k < NUM_DYNAMIC_PARAMETERS; k++)
+		{
+			if(flagSelected[k] == 1)
+				continue;
+			projection = 0;
+			for(i = 0; i < numRows; i++)
+				projection += M[pivot*numRows + i]*M[k*numRows + i];
+			residual[k] = 0;
+			for(i = 0; i < numRows; i++)
+			{
+				M[k*numRows + i] -= projection*M[pivot*numRows + i];
+				residual[k] += M[k*numRows + i]*M[k*numRows + i];
+			}
+		}
+	}
+	delete [] M;
+	
+	// Base parameters in the order of the parameters
+	n = 0;
+	for(k = 0; k < NUM_DYNAMIC_PARAMETERS; k++)
+		if(flagSelected[k] == 1)
+			this->baseParameters[n++] = k;
+}
+
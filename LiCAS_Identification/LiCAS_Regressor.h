@@ -0,0 +1,108 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_Regressor.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Regressor of the inverse dynamics of an arm: the joint torques are linear in the dynamic
+ * parameters, tau = Y(q, dq, ddq)*theta, so the parameters can be identified by least squares from
+ * the torques measured along an excitation trajectory. Each of the 4 links (the link moved by each
+ * joint, with the kinematic chain of LiCAS_ArmKinematics) has 10 inertial parameters expressed in
+ * its frame: mass, first moments (mass times center of mass) and inertia tensor about the origin
+ * of the frame. Each joint has viscous and Coulomb friction.
+ *
+ * Not all the parameters affect the torques (for example the mass of the first link) and some of
+ * them only appear in linear combinations. The base parameters, a subset of independent columns of
+ * the regressor, are found numerically at construction with random samples, and only them are
+ * used to evaluate the excitation trajectories (LiCAS_ExcitationOptimizer).
+ *
+ */
+
+#ifndef LICAS_REGRESSOR_H_
+#define LICAS_REGRESSOR_H_
+
+
+// Standard library
+#include <stdlib.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_Kinematics/LiCAS_ArmDynamics.h"
+
+
+// Constant definition
+#define NUM_LINK_PARAMETERS			10		// m, m*cx, m*cy, m*cz, Ixx, Ixy, Ixz, Iyy, Iyz, Izz
+#define NUM_FRICTION_PARAMETERS		2		// Viscous, Coulomb
+#define NUM_DYNAMIC_PARAMETERS		(NUM_ARM_JOINTS*(NUM_LINK_PARAMETERS + NUM_FRICTION_PARAMETERS))
+#define BASE_PARAMETER_SAMPLES		100		// Random samples used to find the base parameters
+#define BASE_PARAMETER_TOLERANCE	1e-6	// Relative residual of the dependent columns
+
+
+// Regressor of an arm: torque of each joint in [Nm] per unit of each dynamic parameter
+typedef double LiCAS_REGRESSOR[NUM_ARM_JOINTS][NUM_DYNAMIC_PARAMETERS];
+
+
+class LiCAS_Regressor
+{
+public:
+
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Arm side: LiCAS_ARM_LEFT or LiCAS_ARM_RIGHT
+	 * 	(2) Geometry of the arm
+	 * */
+	LiCAS_Regressor(int _side, const LiCAS_ARM_GEOMETRY & _geometry);
+	
+	
+	/*
+	 * Regressor of the inverse dynamics. The parameters of the link i (0 to 3) are the columns
+	 * NUM_LINK_PARAMETERS*i to NUM_LINK_PARAMETERS*i + 9, and the viscous and Coulomb friction of the
+	 * joint j are the columns NUM_ARM_JOINTS*NUM_LINK_PARAMETERS + 2*j and + 2*j + 1.
+	 *
+	 * Parameters:
+	 * 	(1) Joint positions in [rad]
+	 * 	(2) Joint speeds in [rad/s]
+	 * 	(3) Joint accelerations in [rad/s^2]
+	 * 	(4) Output regressor
+	 */
+	void getRegressor(const float q[NUM_ARM_JOINTS], const float dq[NUM_ARM_JOINTS], const float ddq[NUM_ARM_JOINTS], LiCAS_REGRESSOR Y) const;
+	
+	
+	/*
+	 * Number of base parameters (independent columns of the regressor)
+	 */
+	int getNumBaseParameters() const;
+	
+	
+	/*
+	 * Columns of the regressor of the base parameters
+	 */
+	const int * getBaseParameters() const;
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	int side;
+	double mirror;						// 1 for the left arm, -1 for the right arm
+	LiCAS_ARM_GEOMETRY geometry;
+	int numBaseParameters;
+	int baseParameters[NUM_DYNAMIC_PARAMETERS];
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	void findBaseParameters();
+};
+
+#endif
+
@@ -0,0 +1,196 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_TrajectoryPlayer.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ */
+
+#include "LiCAS_TrajectoryPlayer.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_TrajectoryPlayer::LiCAS_TrajectoryPlayer()
+{
+	this->numSamples = 0;
+	this->period = 0;
+}
+
+
+/*
+ * Load a trajectory file
+ */
+int LiCAS_TrajectoryPlayer::load(const char * fileName)
+{
+	FILE * file = NULL;
+	char line[512];
+	float value[1 + 2*NUM_ARM_JOINTS];
+	float t0 = 0;
+	float t = 0;
+	float tPrevious = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	this->qL.clear();
+	this->qR.clear();
+	this->numSamples = 0;
+	this->period = 0;
+	file = fopen(fileName, "r");
+	if(file == NULL)
+		return 1;
+	
+	while(errorCode == 0 && fgets(line, sizeof(line), file) != NULL)
+	{
+		if(line[0] == '#' || line[0] == '\n')
+			continue;
+		if(sscanf(line, "%f %f %f %f %f %f %f %f %f", &value[0], &value[1], &value[2], &value[3], &value[4],
+			&value[5], &value[6], &value[7], &value[8]) != 1 + 2*NUM_ARM_JOINTS)
+		{
+			errorCode = 2;
+			break;
+		}
+		t = value[0];
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			this->qL.push_back(value[1 + k]);
+			this->qR.push_back(value[1 + NUM_ARM_JOINTS + k]);
+		}
+		
+		// Fixed sampling period
+		if(this->numSamples == 0)
+			t0 = t;
+		else if(this->numSamples == 1)
+			this->period = t - t0;
+		else if(fabs(t - tPrevious - this->period) > TRAJECTORY_PERIOD_TOLERANCE*this->period)
+			errorCode = 2;
+		tPrevious = t;
+		this->numSamples++;
+	}
+	fclose(file);
+	
+	if(errorCode == 0 && (this->numSamples < 2 || this->period < MIN_TRAJECTORY_PERIOD))
+		errorCode = 2;
+	if(errorCode != 0)
+	{
+		this->qL.clear();
+		this->qR.clear();
+		this->numSamples = 0;
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Number of samples of the trajectory
+ */
+int LiCAS_TrajectoryPlayer::getNumSamples() const
+{
+	return this->numSamples;
+}
+
+
+/*
+ * Sampling period of the trajectory in [s]
+ */
+float LiCAS_TrajectoryPlayer::getPeriod() const
+{
+	return this->period;
+}
+
+
+/*
+ * Stream the trajectory through the interface (blocking call)
+ */
+int LiCAS_TrajectoryPlayer::execute(LiCAS_ECI_UDP * licas_eci, float approachTime, const char * logFileName)
+{
+	FILE * logFile = NULL;
+	struct timespec t_next;
+	float qL0[NUM_ARM_JOINTS];
+	float qR0[NUM_ARM_JOINTS];
+	float qLref[NUM_ARM_JOINTS];
+	float qRref[NUM_ARM_JOINTS];
+	float qLtarget = 0;
+	float qRtarget = 0;
+	float s = 1;
+	long periodNs = (long)(1e9*this->period);
+	int numApproachCycles = 0;
+	int sample = 0;
+	int cycle = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	if(this->numSamples == 0)
+		return 3;
+	logFile = fopen(logFileName, "w");
+	if(logFile == NULL)
+		return 2;
+	fprintf(logFile, "# t qLref[%d] qRref[%d]\n", NUM_ARM_JOINTS, NUM_ARM_JOINTS);
+	
+	// The joints without trajectory (nan) hold their current position
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		qL0[k] = licas_eci->qL[k];
+		qR0[k] = licas_eci->qR[k];
+	}
+	
+	numApproachCycles = (approachTime > 0) ? (int)ceil(approachTime/this->period) : 0;
+	clock_gettime(CLOCK_MONOTONIC, &t_next);
+	for(cycle = 0; cycle < numApproachCycles + this->numSamples && errorCode == 0; cycle++)
+	{
+		// Cosine approach to the first sample, then the samples of the trajectory
+		if(cycle < numApproachCycles)
+		{
+			sample = 0;
+			s = 0.5*(1 - cos(M_PI*(cycle + 1)/numApproachCycles));
+		}
+		else
+		{
+			sample = cycle - numApproachCycles;
+			s = 1;
+		}
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			qLtarget = this->qL[sample*NUM_ARM_JOINTS + k];
+			qRtarget = this->qR[sample*NUM_ARM_JOINTS + k];
+			qLref[k] = isnan(qLtarget) ? qL0[k] : qL0[k] + s*(qLtarget - qL0[k]);
+			qRref[k] = isnan(qRtarget) ? qR0[k] : qR0[k] + s*(qRtarget - qR0[k]);
+		}
+		if(licas_eci->sendJointPositionRef(qLref, qRref, this->period) != 0)
+			errorCode = 1;
+		
+		// Reference with the time base of the data log of the interface
+		fprintf(logFile, "%.6f", licas_eci->getElapsedTime());
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(logFile, "\t%g", qLref[k]);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			fprintf(logFile, "\t%g", qRref[k]);
+		fprintf(logFile, "\n");
+		
+		// Absolute wake-up time of the next cycle (no drift)
+		t_next.tv_nsec += periodNs;
+		while(t_next.tv_nsec >= 1000000000)
+		{
+			t_next.tv_nsec -= 1000000000;
+			t_next.tv_sec++;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t_next, NULL);
+	}
+	fclose(logFile);
+	
+	
+	return errorCode;
+}
+
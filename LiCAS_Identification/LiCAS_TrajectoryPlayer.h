@@ -0,0 +1,103 @@
+/*
+ *
+ * LiCAS Identification - LiCAS_TrajectoryPlayer.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Player of joint trajectory files through the LiCAS ECI. A trajectory file has the time in [s]
+ * and the joint positions of the left and right arms in [rad] per line (t qL[4] qR[4]), sampled
+ * at a fixed period, with "nan" in the joints that hold their position, and lines starting with
+ * '#' as comments (for example the trajectories of LiCAS_ExcitationOptimizer). The arms are first
+ * moved from their current position to the first sample with a smooth (cosine) profile, and then
+ * the samples are streamed at the period of the file. Each reference is written in an excitation
+ * log with the time of the interface, with the format of LiCAS_Excitation.
+ *
+ * Example:
+ *
+ * 	LiCAS_TrajectoryPlayer player;
+ *
+ * 	if(player.load("LiCAS_Trajectory.txt") == 0)
+ * 		player.execute(licas_eci, 5.0, "LiCAS_ExcitationLog.txt");
+ *
+ */
+
+#ifndef LICAS_TRAJECTORY_PLAYER_H_
+#define LICAS_TRAJECTORY_PLAYER_H_
+
+
+// Standard library
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+#include <vector>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+
+
+// Constant definition
+#define MIN_TRAJECTORY_PERIOD		0.001	// Minimum sampling period of the trajectory files in [s]
+#define TRAJECTORY_PERIOD_TOLERANCE	0.01	// Relative tolerance of the sampling period
+
+
+class LiCAS_TrajectoryPlayer
+{
+public:
+
+	/*
+	 * Constructor
+	 * */
+	LiCAS_TrajectoryPlayer();
+	
+	
+	/*
+	 * Load a trajectory file. Returns 0 on success, 1 if the file could not be opened, or 2 if the
+	 * format is not valid (less than two samples, or a sampling period that is not fixed).
+	 */
+	int load(const char * fileName);
+	
+	
+	/*
+	 * Number of samples of the trajectory
+	 */
+	int getNumSamples() const;
+	
+	
+	/*
+	 * Sampling period of the trajectory in [s]
+	 */
+	float getPeriod() const;
+	
+	
+	/*
+	 * Stream the trajectory through the interface (blocking call). Returns 0 at the end of the
+	 * trajectory, 1 if a reference could not be sent, 2 if the excitation log could not be created,
+	 * or 3 if there is no trajectory loaded.
+	 *
+	 * Parameters:
+	 * 	(1) LiCAS ECI, with the link established
+	 * 	(2) Duration of the approach to the first sample in [s]
+	 * 	(3) Name of the excitation log: time of the interface and joint references (qL, qR) per line
+	 */
+	int execute(LiCAS_ECI_UDP * licas_eci, float approachTime, const char * logFileName);
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	std::vector<float> qL;			// Joint positions of the left arm (NUM_ARM_JOINTS per sample)
+	std::vector<float> qR;			// Joint positions of the right arm (NUM_ARM_JOINTS per sample)
+	int numSamples;
+	float period;
+};
+
+#endif
+
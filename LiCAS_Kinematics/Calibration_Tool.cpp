@@ -0,0 +1,264 @@
+/*
+ *
+ * LiCAS Kinematics - Calibration_Tool.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Kinematic calibration of the arms (LiCAS_Calibration) from the data log of the LiCAS ECI
+ * (LiCAS_DataLog.txt: time, pL, pR, qL, qR... per line, with the TCP positions w.r.t. the
+ * shoulders) and, optionally, from a motion capture file with the TCP positions in the base frame
+ * of the arms (one sample per line: "t xL yL zL xR yR zR" in [s] and [m], "nan" if an arm is not
+ * tracked). The joint positions of the motion capture samples are interpolated from the data log.
+ * The calibrated geometry of each arm is saved in LiCAS_Geometry_Left.txt and
+ * LiCAS_Geometry_Right.txt (see LiCAS_ArmKinematics::loadGeometry()).
+ *
+ * Usage: ./LiCAS_Calibration LiCAS_DataLog.txt [numThreads] [mocap.txt]
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+
+// Specific library
+#include "LiCAS_Calibration.h"
+
+
+#define LOG_NUM_COLUMNS		(1 + 6 + 2*NUM_ARM_JOINTS)		// Columns of the log used: t, pL, pR, qL, qR
+
+
+// Sample of the data log
+typedef struct
+{
+	float t;
+	float pL[3];
+	float pR[3];
+	float qL[NUM_ARM_JOINTS];
+	float qR[NUM_ARM_JOINTS];
+} LOG_SAMPLE;
+
+
+/*
+ * Read the data log of the LiCAS ECI (samples before the reception of feedback are skipped)
+ */
+static int loadDataLog(const char * fileName, std::vector<LOG_SAMPLE> & log)
+{
+	LOG_SAMPLE sample;
+	FILE * logFile = NULL;
+	char line[1024];
+	char * cursor = NULL;
+	char * end = NULL;
+	float values[LOG_NUM_COLUMNS];
+	float sum = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	logFile = fopen(fileName, "r");
+	if(logFile == NULL)
+		errorCode = 1;
+	else
+	{
+		while(fgets(line, sizeof(line), logFile) != NULL)
+		{
+			cursor = line;
+			sum = 0;
+			for(k = 0; k < LOG_NUM_COLUMNS; k++)
+			{
+				values[k] = strtof(cursor, &end);
+				if(end == cursor)
+					break;
+				cursor = end;
+				sum += fabs(values[k]);
+			}
+			if(k < LOG_NUM_COLUMNS || sum == fabs(values[0]))
+				continue;
+			
+			sample.t = values[0];
+			for(k = 0; k < 3; k++)
+			{
+				sample.pL[k] = values[1 + k];
+				sample.pR[k] = values[4 + k];
+			}
+			for(k = 0; k < NUM_ARM_JOINTS; k++)
+			{
+				sample.qL[k] = values[7 + k];
+				sample.qR[k] = values[7 + NUM_ARM_JOINTS + k];
+			}
+			log.push_back(sample);
+		}
+		fclose(logFile);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Joint positions of the data log interpolated at a time. Returns 1 if the time is out of the log.
+ */
+static int interpolateJoints(const std::vector<LOG_SAMPLE> & log, float t, float qL[NUM_ARM_JOINTS], float qR[NUM_ARM_JOINTS])
+{
+	size_t low = 0;
+	size_t high = log.size() - 1;
+	size_t middle = 0;
+	float s = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	if(log.size() < 2 || t < log[0].t || t > log[high].t)
+		errorCode = 1;
+	else
+	{
+		// Binary search of the interval (the log is sorted by time)
+		while(high - low > 1)
+		{
+			middle = (low + high)/2;
+			if(log[middle].t <= t)
+				low = middle;
+			else
+				high = middle;
+		}
+		s = (log[high].t > log[low].t) ? (t - log[low].t)/(log[high].t - log[low].t) : 0;
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			qL[k] = log[low].qL[k] + s*(log[high].qL[k] - log[low].qL[k]);
+			qR[k] = log[low].qR[k] + s*(log[high].qR[k] - log[low].qR[k]);
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Read the motion capture file and add its samples to the calibrations
+ */
+static int loadMotionCapture(const char * fileName, const std::vector<LOG_SAMPLE> & log, LiCAS_Calibration * calibrationL, LiCAS_Calibration * calibrationR)
+{
+	FILE * mocapFile = NULL;
+	char line[512];
+	float qL[NUM_ARM_JOINTS];
+	float qR[NUM_ARM_JOINTS];
+	float pL[3];
+	float pR[3];
+	float t = 0;
+	int numSamples = 0;
+	
+	
+	mocapFile = fopen(fileName, "r");
+	if(mocapFile != NULL)
+	{
+		while(fgets(line, sizeof(line), mocapFile) != NULL)
+		{
+			if(sscanf(line, "%f %f %f %f %f %f %f", &t, &pL[0], &pL[1], &pL[2], &pR[0], &pR[1], &pR[2]) != 7 || interpolateJoints(log, t, qL, qR) != 0)
+				continue;
+			if(!isnan(pL[0]) && !isnan(pL[1]) && !isnan(pL[2]))
+				calibrationL->addSample(qL, pL, 1);
+			if(!isnan(pR[0]) && !isnan(pR[1]) && !isnan(pR[2]))
+				calibrationR->addSample(qR, pR, 1);
+			numSamples++;
+		}
+		fclose(mocapFile);
+	}
+	
+	
+	return (mocapFile != NULL) ? numSamples : -1;
+}
+
+
+/*
+ * Fit the geometry of an arm, print the result and save it
+ */
+static int calibrateArm(LiCAS_Calibration * calibration, const char * armName, const char * fileName, int numThreads)
+{
+	LiCAS_ARM_GEOMETRY geometry;
+	LiCAS_CALIBRATION_RESULT result;
+	int errorCode = 0;
+	
+	
+	errorCode = calibration->solve(numThreads, &geometry, &result);
+	if(errorCode != 0)
+		printf("ERROR [in calibrateArm]: could not calibrate the %s arm (%d samples)\n", armName, calibration->getNumSamples());
+	else
+	{
+		printf("%s arm: %d samples, %d iterations, %d threads, %.3f [s]\n", armName, result.numSamples, result.numIterations, result.numThreads, result.solveTime);
+		printf("\tRMS error: %.2f -> %.2f [mm] (max %.2f [mm])\n", 1e3*result.rmsInitial, 1e3*result.rmsFinal, 1e3*result.maxErrorFinal);
+		printf("\tLink lengths: %.4f, %.4f [m]\n", geometry.upperArmLength, geometry.forearmLength);
+		printf("\tJoint offsets: {%.4f, %.4f, %.4f, %.4f} [rad]\n", geometry.jointOffset[0], geometry.jointOffset[1], geometry.jointOffset[2], geometry.jointOffset[3]);
+		printf("\tShoulder offsets: %.4f, %.4f [m]\n", geometry.shoulderOffsetY, geometry.shoulderOffsetZ);
+		errorCode = LiCAS_ArmKinematics::saveGeometry(fileName, geometry);
+		if(errorCode != 0)
+			printf("ERROR [in calibrateArm]: could not write %s\n", fileName);
+	}
+	
+	
+	return errorCode;
+}
+
+
+int main(int argc, char ** argv)
+{
+	std::vector<LOG_SAMPLE> log;
+	LiCAS_Calibration calibrationL(LiCAS_ARM_LEFT, LiCAS_ArmKinematics::getDefaultGeometry());
+	LiCAS_Calibration calibrationR(LiCAS_ARM_RIGHT, LiCAS_ArmKinematics::getDefaultGeometry());
+	int numThreads = 0;
+	int numMocapSamples = 0;
+	int errorCode = 0;
+	size_t n = 0;
+	
+	
+	if(argc < 2)
+	{
+		printf("Usage: ./LiCAS_Calibration LiCAS_DataLog.txt [numThreads] [mocap.txt]\n");
+		printf("\tnumThreads: threads of the fit (default: number of cores)\n");
+		printf("\tmocap.txt: TCP positions in the base frame, \"t xL yL zL xR yR zR\" per line\n");
+		return 1;
+	}
+	if(argc > 2)
+		numThreads = atoi(argv[2]);
+	
+	if(loadDataLog(argv[1], log) != 0 || log.size() == 0)
+	{
+		printf("ERROR [in main]: could not read samples from %s\n", argv[1]);
+		return 1;
+	}
+	for(n = 0; n < log.size(); n++)
+	{
+		calibrationL.addSample(log[n].qL, log[n].pL, 0);
+		calibrationR.addSample(log[n].qR, log[n].pR, 0);
+	}
+	printf("Data log: %zu samples\n", log.size());
+	
+	if(argc > 3)
+	{
+		numMocapSamples = loadMotionCapture(argv[3], log, &calibrationL, &calibrationR);
+		if(numMocapSamples < 0)
+		{
+			printf("ERROR [in main]: could not read %s\n", argv[3]);
+			return 1;
+		}
+		printf("Motion capture: %d samples\n", numMocapSamples);
+	}
+	
+	errorCode = calibrateArm(&calibrationL, "Left", "LiCAS_Geometry_Left.txt", numThreads);
+	errorCode |= calibrateArm(&calibrationR, "Right", "LiCAS_Geometry_Right.txt", numThreads);
+	
+	
+	return errorCode;
+}
+
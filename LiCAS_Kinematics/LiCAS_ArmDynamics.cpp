@@ -0,0 +1,388 @@
+/*
+ *
+ * LiCAS Kinematics - LiCAS_ArmDynamics.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Both algorithms work in the frames of the links. The rotation of the joint i about the axis k of
+ * its frame only changes the other two components of a vector, so the rotations between the
+ * frames of consecutive links are applied with two products instead of a 3x3 matrix. The wrench
+ * of each link is computed about the origin of its frame, with the first moment h = m*c and the
+ * inertia about the origin, so the backward recursion does not need the center of mass:
+ *
+ * 	f = m*a + alpha x h + w x (w x h)
+ * 	n = I*alpha + w x (I*w) + h x a
+ *
+ * The gravity is introduced as an upwards acceleration of the base.
+ *
+ */
+
+#include "LiCAS_ArmDynamics.h"
+
+
+// Axis of each joint in the frame of its link (0: X, 1: Y, 2: Z) and joints mirrored in the right arm
+static const int jointAxis[NUM_ARM_JOINTS] = {1, 0, 2, 1};
+static const int jointMirrored[NUM_ARM_JOINTS] = {0, 1, 1, 0};
+
+
+/*
+ * Rotation of a vector by the elementary rotation about an axis (cosine c, sine s). The inverse
+ * rotation is obtained with -s.
+ */
+static inline __attribute__((always_inline)) LiCAS_Vector3 rotate(int axis, float c, float s, const LiCAS_Vector3 & v)
+{
+	LiCAS_Vector3 r = v;
+	int i = (axis + 1) % 3;
+	int j = (axis + 2) % 3;
+	
+	
+	r[i] = c*v[i] - s*v[j];
+	r[j] = s*v[i] + c*v[j];
+	
+	
+	return r;
+}
+
+
+/*
+ * Elementary rotation matrix about an axis (cosine c, sine s)
+ */
+static LiCAS_Matrix3 getRotation(int axis, float c, float s)
+{
+	LiCAS_Matrix3 R = LiCAS_Matrix3::identity();
+	int i = (axis + 1) % 3;
+	int j = (axis + 2) % 3;
+	
+	
+	R(i, i) = c;
+	R(i, j) = -s;
+	R(j, i) = s;
+	R(j, j) = c;
+	
+	
+	return R;
+}
+
+
+/*
+ * Skew symmetric matrix of the cross product: getSkew(a)*b = a x b
+ */
+static LiCAS_Matrix3 getSkew(const LiCAS_Vector3 & v)
+{
+	LiCAS_Matrix3 S = LiCAS_Matrix3::zeros();
+	
+	
+	S(0, 1) = -v[2];
+	S(0, 2) = v[1];
+	S(1, 0) = v[2];
+	S(1, 2) = -v[0];
+	S(2, 0) = -v[1];
+	S(2, 1) = v[0];
+	
+	
+	return S;
+}
+
+
+/*
+ * Constructor
+ *
+ * Parameters:
+ * 	(1) Arm side: LiCAS_ARM_LEFT or LiCAS_ARM_RIGHT
+ * 	(2) Geometry of the arms
+ * 	(3) Dynamic parameters of the arms (left arm)
+ * */
+LiCAS_ArmDynamics::LiCAS_ArmDynamics(int _side, const LiCAS_ARM_GEOMETRY & _geometry, const LiCAS_ARM_DYNAMICS & _dynamics)
+{
+	LiCAS_Matrix3 S;
+	int i = 0;
+	
+	
+	this->side = _side;
+	this->mirror = (_side == LiCAS_ARM_RIGHT) ? -1.0 : 1.0;
+	this->geometry = _geometry;
+	
+	for(i = 0; i < NUM_ARM_JOINTS; i++)
+	{
+		// Mirror image of the link of the left arm for the right arm
+		this->mass[i] = _dynamics.mass[i];
+		this->centerOfMass[i][0] = _dynamics.centerOfMass[i][0];
+		this->centerOfMass[i][1] = this->mirror*_dynamics.centerOfMass[i][1];
+		this->centerOfMass[i][2] = _dynamics.centerOfMass[i][2];
+		this->inertiaCOM[i](0, 0) = _dynamics.inertia[i][0];
+		this->inertiaCOM[i](0, 1) = this->mirror*_dynamics.inertia[i][1];
+		this->inertiaCOM[i](0, 2) = _dynamics.inertia[i][2];
+		this->inertiaCOM[i](1, 1) = _dynamics.inertia[i][3];
+		this->inertiaCOM[i](1, 2) = this->mirror*_dynamics.inertia[i][4];
+		this->inertiaCOM[i](2, 2) = _dynamics.inertia[i][5];
+		this->inertiaCOM[i](1, 0) = this->inertiaCOM[i](0, 1);
+		this->inertiaCOM[i](2, 0) = this->inertiaCOM[i](0, 2);
+		this->inertiaCOM[i](2, 1) = this->inertiaCOM[i](1, 2);
+		
+		// Parallel axis theorem: I_origin = I_com - m*[c]x*[c]x
+		this->firstMoment[i] = this->mass[i]*this->centerOfMass[i];
+		S = getSkew(this->centerOfMass[i]);
+		this->inertiaOrigin[i] = this->inertiaCOM[i] - this->mass[i]*(S*S);
+		
+		this->origin[i] = LiCAS_Vector3::zeros();
+		this->viscousFriction[i] = _dynamics.viscousFriction[i];
+		this->coulombFriction[i] = _dynamics.coulombFriction[i];
+	}
+	this->origin[0][1] = this->mirror*this->geometry.shoulderOffsetY;
+	this->origin[0][2] = this->geometry.shoulderOffsetZ;
+	this->origin[3][2] = -this->geometry.upperArmLength;
+	
+	// No payload
+	this->forearmMass = this->mass[NUM_ARM_JOINTS - 1];
+	this->forearmFirstMoment = this->firstMoment[NUM_ARM_JOINTS - 1];
+	this->forearmInertiaOrigin = this->inertiaOrigin[NUM_ARM_JOINTS - 1];
+	this->payloadMass = 0;
+	this->payloadPosition = LiCAS_Vector3::zeros();
+}
+
+
+/*
+ * Nominal dynamic parameters of the arms: light shoulder links, and upper arm and forearm as rods
+ * with the servos close to the joints
+ */
+LiCAS_ARM_DYNAMICS LiCAS_ArmDynamics::getDefaultDynamics()
+{
+	LiCAS_ARM_DYNAMICS dynamics;
+	const float mass[NUM_ARM_JOINTS] = {0.08, 0.10, 0.30, 0.25};
+	const float centerOfMassZ[NUM_ARM_JOINTS] = {0.0, -0.02, -0.12, -0.10};
+	const float inertiaXY[NUM_ARM_JOINTS] = {4e-5, 6e-5, 1.6e-3, 1.3e-3};
+	const float inertiaZ[NUM_ARM_JOINTS] = {4e-5, 5e-5, 1.4e-4, 1.0e-4};
+	int i = 0;
+	int k = 0;
+	
+	
+	for(i = 0; i < NUM_ARM_JOINTS; i++)
+	{
+		dynamics.mass[i] = mass[i];
+		dynamics.centerOfMass[i][0] = 0;
+		dynamics.centerOfMass[i][1] = 0;
+		dynamics.centerOfMass[i][2] = centerOfMassZ[i];
+		for(k = 0; k < 6; k++)
+			dynamics.inertia[i][k] = 0;
+		dynamics.inertia[i][0] = inertiaXY[i];
+		dynamics.inertia[i][3] = inertiaXY[i];
+		dynamics.inertia[i][5] = inertiaZ[i];
+		dynamics.viscousFriction[i] = 0.05;
+		dynamics.coulombFriction[i] = 0.02;
+	}
+	
+	
+	return dynamics;
+}
+
+
+/*
+ * Inverse dynamics (RNEA) including gravity and friction
+ */
+void LiCAS_ArmDynamics::inverseDynamics(const float q[NUM_ARM_JOINTS], const float dq[NUM_ARM_JOINTS], const float ddq[NUM_ARM_JOINTS], float tau[NUM_ARM_JOINTS]) const
+{
+	this->recursiveNewtonEuler(q, dq, ddq, GRAVITY_ACCELERATION, tau);
+	LiCAS_Unroll<NUM_ARM_JOINTS>::run([&](int i) __attribute__((always_inline)) {
+		tau[i] += this->viscousFriction[i]*dq[i] + ((dq[i] > 0) ? this->coulombFriction[i] : ((dq[i] < 0) ? -this->coulombFriction[i] : 0));
+	});
+}
+
+
+/*
+ * Gravity torques
+ */
+void LiCAS_ArmDynamics::getGravityTorque(const float q[NUM_ARM_JOINTS], float tau[NUM_ARM_JOINTS]) const
+{
+	const float zero[NUM_ARM_JOINTS] = {0};
+	
+	
+	this->recursiveNewtonEuler(q, zero, zero, GRAVITY_ACCELERATION, tau);
+}
+
+
+/*
+ * Joint space inertia matrix (CRBA). The composite inertia of the links i..N-1 is accumulated in
+ * the frame of the link i, about its origin, and the column i of the matrix is the projection on
+ * the axes of the previous joints of the wrench needed to accelerate the composite body about the
+ * joint i.
+ */
+void LiCAS_ArmDynamics::getMassMatrix(const float q[NUM_ARM_JOINTS], LiCAS_JointMatrix * M) const
+{
+	LiCAS_Matrix3 compositeInertia[NUM_ARM_JOINTS];
+	LiCAS_Vector3 compositeMoment[NUM_ARM_JOINTS];
+	float compositeMass[NUM_ARM_JOINTS];
+	float c[NUM_ARM_JOINTS];
+	float s[NUM_ARM_JOINTS];
+	float sign[NUM_ARM_JOINTS];
+	const float * offset = this->geometry.jointOffset;
+	
+	
+	LiCAS_Unroll<NUM_ARM_JOINTS>::run([&](int i) __attribute__((always_inline)) {
+		sign[i] = (jointMirrored[i] != 0) ? this->mirror : 1.0f;
+		c[i] = cosf(sign[i]*(q[i] + offset[i]));
+		s[i] = sinf(sign[i]*(q[i] + offset[i]));
+		compositeMass[i] = this->mass[i];
+		compositeMoment[i] = this->firstMoment[i];
+		compositeInertia[i] = this->inertiaOrigin[i];
+	});
+	
+	// Composite bodies, from the forearm to the shoulder
+	LiCAS_Unroll<NUM_ARM_JOINTS - 1>::run([&](int k) __attribute__((always_inline)) {
+		int i = NUM_ARM_JOINTS - 2 - k;
+		int j = i + 1;
+		LiCAS_Matrix3 R = getRotation(jointAxis[j], c[j], s[j]);
+		LiCAS_Vector3 h = R*compositeMoment[j];
+		LiCAS_Matrix3 Sr = getSkew(this->origin[j]);
+		LiCAS_Matrix3 Sh = getSkew(h);
+		
+		compositeMass[i] += compositeMass[j];
+		compositeMoment[i] += compositeMass[j]*this->origin[j] + h;
+		compositeInertia[i] += R*compositeInertia[j]*transpose(R) - Sr*Sh - Sh*Sr - compositeMass[j]*(Sr*Sr);
+	});
+	
+	// Columns of the matrix
+	LiCAS_Unroll<NUM_ARM_JOINTS>::run([&](int i) __attribute__((always_inline)) {
+		LiCAS_Vector3 axis = LiCAS_Vector3::zeros();
+		LiCAS_Vector3 f;
+		LiCAS_Vector3 n;
+		
+		axis[jointAxis[i]] = sign[i];
+		f = cross(axis, compositeMoment[i]);
+		n = compositeInertia[i]*axis;
+		(*M)(i, i) = sign[i]*n[jointAxis[i]];
+		LiCAS_Unroll<NUM_ARM_JOINTS - 1>::run([&](int k) __attribute__((always_inline)) {
+			int j = i - 1 - k;
+			if(j >= 0)
+			{
+				f = rotate(jointAxis[j + 1], c[j + 1], s[j + 1], f);
+				n = rotate(jointAxis[j + 1], c[j + 1], s[j + 1], n) + cross(this->origin[j + 1], f);
+				(*M)(i, j) = sign[j]*n[jointAxis[j]];
+				(*M)(j, i) = (*M)(i, j);
+			}
+		});
+	});
+}
+
+
+/*
+ * Dynamic parameters of the arm as a linear vector
+ */
+void LiCAS_ArmDynamics::getParameters(double parameters[NUM_ARM_DYNAMIC_PARAMETERS]) const
+{
+	int i = 0;
+	
+	
+	for(i = 0; i < NUM_ARM_JOINTS; i++)
+	{
+		parameters[10*i] = this->mass[i];
+		parameters[10*i + 1] = this->firstMoment[i][0];
+		parameters[10*i + 2] = this->firstMoment[i][1];
+		parameters[10*i + 3] = this->firstMoment[i][2];
+		parameters[10*i + 4] = this->inertiaOrigin[i](0, 0);
+		parameters[10*i + 5] = this->inertiaOrigin[i](0, 1);
+		parameters[10*i + 6] = this->inertiaOrigin[i](0, 2);
+		parameters[10*i + 7] = this->inertiaOrigin[i](1, 1);
+		parameters[10*i + 8] = this->inertiaOrigin[i](1, 2);
+		parameters[10*i + 9] = this->inertiaOrigin[i](2, 2);
+		parameters[10*NUM_ARM_JOINTS + 2*i] = this->viscousFriction[i];
+		parameters[10*NUM_ARM_JOINTS + 2*i + 1] = this->coulombFriction[i];
+	}
+}
+
+
+/*
+ * Set the payload of the arm as a point mass attached to the forearm
+ */
+void LiCAS_ArmDynamics::setPayload(float payloadMass, const float payloadPosition[3])
+{
+	LiCAS_Matrix3 S;
+	int k = 0;
+	
+	
+	this->payloadMass = payloadMass;
+	for(k = 0; k < 3; k++)
+		this->payloadPosition[k] = payloadPosition[k];
+	S = getSkew(this->payloadPosition);
+	this->mass[NUM_ARM_JOINTS - 1] = this->forearmMass + payloadMass;
+	this->firstMoment[NUM_ARM_JOINTS - 1] = this->forearmFirstMoment + payloadMass*this->payloadPosition;
+	this->inertiaOrigin[NUM_ARM_JOINTS - 1] = this->forearmInertiaOrigin - payloadMass*(S*S);
+}
+
+
+/*
+ * Get the payload of the arm
+ */
+void LiCAS_ArmDynamics::getPayload(float * payloadMass, float payloadPosition[3]) const
+{
+	int k = 0;
+	
+	
+	*payloadMass = this->payloadMass;
+	for(k = 0; k < 3; k++)
+		payloadPosition[k] = this->payloadPosition[k];
+}
+
+
+/*
+ * Recursive Newton-Euler algorithm without friction: velocities and accelerations from the base
+ * to the forearm, and wrenches from the forearm to the base
+ */
+void LiCAS_ArmDynamics::recursiveNewtonEuler(const float q[NUM_ARM_JOINTS], const float dq[NUM_ARM_JOINTS], const float ddq[NUM_ARM_JOINTS], float gravity, float tau[NUM_ARM_JOINTS]) const
+{
+	LiCAS_Vector3 f[NUM_ARM_JOINTS];
+	LiCAS_Vector3 n[NUM_ARM_JOINTS];
+	LiCAS_Vector3 w = LiCAS_Vector3::zeros();
+	LiCAS_Vector3 alpha = LiCAS_Vector3::zeros();
+	LiCAS_Vector3 a = LiCAS_Vector3::zeros();
+	float c[NUM_ARM_JOINTS];
+	float s[NUM_ARM_JOINTS];
+	float sign[NUM_ARM_JOINTS];
+	const float * offset = this->geometry.jointOffset;
+	
+	
+	a[2] = gravity;
+	LiCAS_Unroll<NUM_ARM_JOINTS>::run([&](int i) __attribute__((always_inline)) {
+		int axis = jointAxis[i];
+		LiCAS_Vector3 jointRate = LiCAS_Vector3::zeros();
+		LiCAS_Vector3 wPrev;
+		
+		sign[i] = (jointMirrored[i] != 0) ? this->mirror : 1.0f;
+		c[i] = cosf(sign[i]*(q[i] + offset[i]));
+		s[i] = sinf(sign[i]*(q[i] + offset[i]));
+		
+		// Acceleration of the origin with the motion of the previous link, then in the frame of the link
+		a = a + cross(alpha, this->origin[i]) + cross(w, cross(w, this->origin[i]));
+		a = rotate(axis, c[i], -s[i], a);
+		wPrev = rotate(axis, c[i], -s[i], w);
+		alpha = rotate(axis, c[i], -s[i], alpha);
+		jointRate[axis] = sign[i]*dq[i];
+		w = wPrev + jointRate;
+		alpha[axis] += sign[i]*ddq[i];
+		alpha += cross(wPrev, jointRate);
+		
+		f[i] = this->mass[i]*a + cross(alpha, this->firstMoment[i]) + cross(w, cross(w, this->firstMoment[i]));
+		n[i] = this->inertiaOrigin[i]*alpha + cross(w, this->inertiaOrigin[i]*w) + cross(this->firstMoment[i], a);
+	});
+	
+	LiCAS_Unroll<NUM_ARM_JOINTS>::run([&](int k) __attribute__((always_inline)) {
+		int i = NUM_ARM_JOINTS - 1 - k;
+		int j = i + 1;
+		LiCAS_Vector3 fChild;
+		
+		if(j < NUM_ARM_JOINTS)
+		{
+			fChild = rotate(jointAxis[j], c[j], s[j], f[j]);
+			f[i] += fChild;
+			n[i] += rotate(jointAxis[j], c[j], s[j], n[j]) + cross(this->origin[j], fChild);
+		}
+		tau[i] = sign[i]*n[i][jointAxis[i]];
+	});
+}
+
@@ -0,0 +1,165 @@
+/*
+ *
+ * LiCAS Kinematics - LiCAS_ArmDynamics.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Rigid body dynamics of the arms for the torque feedforward of the joint speed and torque control
+ * modes: inverse dynamics with the recursive Newton-Euler algorithm (RNEA), including gravity and
+ * joint friction, and joint space inertia matrix with the composite rigid body algorithm (CRBA).
+ * The links follow the kinematic chain of LiCAS_ArmKinematics: the link i is moved by the joint i
+ * and its frame is the frame after that joint (the shoulder links share the origin of the shoulder,
+ * the forearm has its origin at the elbow). The recursions over the chain are unrolled at compile
+ * time (LiCAS_Unroll over NUM_ARM_JOINTS), and the elementary rotations of the joints are applied
+ * to the vectors directly, so the inverse dynamics of both arms takes a few hundred nanoseconds.
+ *
+ * The dynamic parameters are given for the left arm. The right arm is its mirror image with respect
+ * to the XZ plane, so its links use the mirrored center of mass (-y) and products of inertia (-Ixy,
+ * -Iyz).
+ *
+ * A payload held by the arm (tool or grasped object) is modeled as a point mass attached to the
+ * forearm, and its estimate can be updated at run time (see LiCAS_PayloadEstimator).
+ *
+ * Example:
+ *
+ * 	LiCAS_ArmDynamics dynamics(LiCAS_ARM_LEFT, LiCAS_ArmKinematics::getDefaultGeometry(), LiCAS_ArmDynamics::getDefaultDynamics());
+ * 	float tau[NUM_ARM_JOINTS];
+ *
+ * 	dynamics.inverseDynamics(q, dq, ddq, tau);
+ *
+ */
+
+#ifndef LICAS_ARM_DYNAMICS_H_
+#define LICAS_ARM_DYNAMICS_H_
+
+
+// Standard library
+#include <math.h>
+
+
+// Specific library
+#include "LiCAS_Matrix.h"
+#include "LiCAS_ArmKinematics.h"
+
+
+// Constant definition
+#define GRAVITY_ACCELERATION		9.81	// [m/s^2]
+#define NUM_ARM_DYNAMIC_PARAMETERS	(12*NUM_ARM_JOINTS)	// Inertial parameters (10) and friction (2) of each joint
+
+
+// Dynamic parameters of an arm (left arm)
+typedef struct
+{
+	float mass[NUM_ARM_JOINTS];				// Mass of each link in [kg]
+	float centerOfMass[NUM_ARM_JOINTS][3];	// Center of mass in the frame of the link in [m]
+	float inertia[NUM_ARM_JOINTS][6];		// Inertia about the center of mass (Ixx, Ixy, Ixz, Iyy, Iyz, Izz) in [kg*m^2]
+	float viscousFriction[NUM_ARM_JOINTS];	// Viscous friction of each joint in [Nm*s/rad]
+	float coulombFriction[NUM_ARM_JOINTS];	// Coulomb friction of each joint in [Nm]
+} LiCAS_ARM_DYNAMICS;
+
+
+class LiCAS_ArmDynamics
+{
+public:
+
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Arm side: LiCAS_ARM_LEFT or LiCAS_ARM_RIGHT
+	 * 	(2) Geometry of the arms
+	 * 	(3) Dynamic parameters of the arms (left arm)
+	 * */
+	LiCAS_ArmDynamics(int _side, const LiCAS_ARM_GEOMETRY & _geometry, const LiCAS_ARM_DYNAMICS & _dynamics);
+	
+	
+	/*
+	 * Nominal dynamic parameters of the arms
+	 */
+	static LiCAS_ARM_DYNAMICS getDefaultDynamics();
+	
+	
+	/*
+	 * Inverse dynamics (RNEA): joint torques in [Nm] for the given joint positions in [rad], speeds in
+	 * [rad/s] and accelerations in [rad/s^2], including gravity and friction
+	 */
+	void inverseDynamics(const float q[NUM_ARM_JOINTS], const float dq[NUM_ARM_JOINTS], const float ddq[NUM_ARM_JOINTS], float tau[NUM_ARM_JOINTS]) const;
+	
+	
+	/*
+	 * Gravity torques in [Nm] for the given joint positions in [rad]
+	 */
+	void getGravityTorque(const float q[NUM_ARM_JOINTS], float tau[NUM_ARM_JOINTS]) const;
+	
+	
+	/*
+	 * Joint space inertia matrix (CRBA) in [kg*m^2] for the given joint positions in [rad]
+	 */
+	void getMassMatrix(const float q[NUM_ARM_JOINTS], LiCAS_JointMatrix * M) const;
+	
+	
+	/*
+	 * Dynamic parameters of the arm (mirrored for the right arm) as a linear vector: for each link i,
+	 * mass, first moments (mass times center of mass) and inertia about the origin of the frame
+	 * (Ixx, Ixy, Ixz, Iyy, Iyz, Izz) at 10*i, and the viscous and Coulomb friction of each joint j at
+	 * 10*NUM_ARM_JOINTS + 2*j. The joint torques are linear in these parameters.
+	 */
+	void getParameters(double parameters[NUM_ARM_DYNAMIC_PARAMETERS]) const;
+	
+	
+	/*
+	 * Set the payload of the arm as a point mass attached to the forearm. It is added to the forearm
+	 * link (mass, first moment and inertia about the elbow), so it is included in all the torques.
+	 *
+	 * Parameters:
+	 * 	(1) Mass of the payload in [kg] (0 for no payload)
+	 * 	(2) Position of the payload in the frame of the forearm in [m] (origin at the elbow, the TCP
+	 * 	is at (0, 0, -forearmLength)). It is not mirrored for the right arm.
+	 */
+	void setPayload(float payloadMass, const float payloadPosition[3]);
+	
+	
+	/*
+	 * Get the payload of the arm: mass in [kg] and position in the frame of the forearm in [m]
+	 */
+	void getPayload(float * payloadMass, float payloadPosition[3]) const;
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	int side;
+	float mirror;								// 1 for the left arm, -1 for the right arm
+	LiCAS_ARM_GEOMETRY geometry;
+	
+	// Constant terms of the links, in the frame of each link
+	float mass[NUM_ARM_JOINTS];
+	LiCAS_Vector3 centerOfMass[NUM_ARM_JOINTS];
+	LiCAS_Vector3 firstMoment[NUM_ARM_JOINTS];	// Mass times center of mass
+	LiCAS_Matrix3 inertiaCOM[NUM_ARM_JOINTS];	// Inertia about the center of mass
+	LiCAS_Matrix3 inertiaOrigin[NUM_ARM_JOINTS];	// Inertia about the origin of the frame
+	LiCAS_Vector3 origin[NUM_ARM_JOINTS];		// Origin of the frame in the frame of the previous link (base for the first)
+	float viscousFriction[NUM_ARM_JOINTS];
+	float coulombFriction[NUM_ARM_JOINTS];
+	
+	// Forearm without payload, and payload
+	float forearmMass;
+	LiCAS_Vector3 forearmFirstMoment;
+	LiCAS_Matrix3 forearmInertiaOrigin;
+	float payloadMass;
+	LiCAS_Vector3 payloadPosition;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	void recursiveNewtonEuler(const float q[NUM_ARM_JOINTS], const float dq[NUM_ARM_JOINTS], const float ddq[NUM_ARM_JOINTS], float gravity, float tau[NUM_ARM_JOINTS]) const;
+};
+
+#endif
+
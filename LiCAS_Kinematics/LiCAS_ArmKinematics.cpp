@@ -0,0 +1,313 @@
+/*
+ *
+ * LiCAS Kinematics - LiCAS_ArmKinematics.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Forward kinematics of the arms:
+ *
+ * 	T_tcp = T_base_shoulder * Ry(q1) * Rx(s*q2) * Rz(s*q3) * Tz(-L1) * Ry(q4) * Tz(-L2)
+ *
+ * where s = 1 for the left arm and s = -1 for the right arm (mirrored joints), and q are the
+ * measured joint positions plus the joint offsets of the geometry.
+ *
+ */
+
+#include "LiCAS_ArmKinematics.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_ArmKinematics::LiCAS_ArmKinematics(int _side, const LiCAS_ARM_GEOMETRY & _geometry)
+{
+	this->side = _side;
+	this->mirror = (_side == LiCAS_ARM_RIGHT) ? -1.0 : 1.0;
+	this->geometry = _geometry;
+	this->T_base_shoulder = LiCAS_Translation(0, this->mirror*_geometry.shoulderOffsetY, _geometry.shoulderOffsetZ);
+}
+
+
+/*
+ * Nominal geometry of the arms
+ */
+LiCAS_ARM_GEOMETRY LiCAS_ArmKinematics::getDefaultGeometry()
+{
+	LiCAS_ARM_GEOMETRY geometry;
+	int k = 0;
+	
+	
+	geometry.shoulderOffsetY = 0.16;
+	geometry.shoulderOffsetZ = 0;
+	geometry.upperArmLength = 0.25;
+	geometry.forearmLength = 0.25;
+	geometry.upperArmRadius = 0.04;
+	geometry.forearmRadius = 0.035;
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+		geometry.jointOffset[k] = 0;
+	
+	
+	return geometry;
+}
+
+
+/*
+ * Load the geometry of an arm from a text file ("name value" lines, see saveGeometry()). The
+ * fields not present in the file keep their values. Returns 0 on success, or 1 if the file could
+ * not be read.
+ */
+int LiCAS_ArmKinematics::loadGeometry(const char * fileName, LiCAS_ARM_GEOMETRY * geometry)
+{
+	FILE * geometryFile = NULL;
+	char line[256];
+	char name[64];
+	float values[NUM_ARM_JOINTS];
+	int numValues = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	geometryFile = fopen(fileName, "r");
+	if(geometryFile == NULL)
+		errorCode = 1;
+	else
+	{
+		while(fgets(line, sizeof(line), geometryFile) != NULL)
+		{
+			numValues = sscanf(line, "%63s %f %f %f %f", name, &values[0], &values[1], &values[2], &values[3]) - 1;
+			if(numValues < 1 || name[0] == '#')
+				continue;
+			if(strcmp(name, "shoulderOffsetY") == 0)
+				geometry->shoulderOffsetY = values[0];
+			else if(strcmp(name, "shoulderOffsetZ") == 0)
+				geometry->shoulderOffsetZ = values[0];
+			else if(strcmp(name, "upperArmLength") == 0)
+				geometry->upperArmLength = values[0];
+			else if(strcmp(name, "forearmLength") == 0)
+				geometry->forearmLength = values[0];
+			else if(strcmp(name, "upperArmRadius") == 0)
+				geometry->upperArmRadius = values[0];
+			else if(strcmp(name, "forearmRadius") == 0)
+				geometry->forearmRadius = values[0];
+			else if(strcmp(name, "jointOffset") == 0 && numValues == NUM_ARM_JOINTS)
+			{
+				for(k = 0; k < NUM_ARM_JOINTS; k++)
+					geometry->jointOffset[k] = values[k];
+			}
+		}
+		fclose(geometryFile);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Save the geometry of an arm in a text file. Returns 0 on success, or 1 if the file could not be
+ * written.
+ */
+int LiCAS_ArmKinematics::saveGeometry(const char * fileName, const LiCAS_ARM_GEOMETRY & geometry)
+{
+	FILE * geometryFile = NULL;
+	int errorCode = 0;
+	
+	
+	geometryFile = fopen(fileName, "w");
+	if(geometryFile == NULL)
+		errorCode = 1;
+	else
+	{
+		fprintf(geometryFile, "# LiCAS arm geometry: lengths in [m], joint offsets in [rad]\n");
+		fprintf(geometryFile, "shoulderOffsetY %.6f\n", geometry.shoulderOffsetY);
+		fprintf(geometryFile, "shoulderOffsetZ %.6f\n", geometry.shoulderOffsetZ);
+		fprintf(geometryFile, "upperArmLength %.6f\n", geometry.upperArmLength);
+		fprintf(geometryFile, "forearmLength %.6f\n", geometry.forearmLength);
+		fprintf(geometryFile, "upperArmRadius %.6f\n", geometry.upperArmRadius);
+		fprintf(geometryFile, "forearmRadius %.6f\n", geometry.forearmRadius);
+		fprintf(geometryFile, "jointOffset %.6f %.6f %.6f %.6f\n", geometry.jointOffset[0], geometry.jointOffset[1], geometry.jointOffset[2], geometry.jointOffset[3]);
+		if(fclose(geometryFile) != 0)
+			errorCode = 1;
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Forward kinematics: frames of the arm for the given joint positions in [rad]
+ */
+void LiCAS_ArmKinematics::forwardKinematics(const float q[NUM_ARM_JOINTS], LiCAS_ARM_FRAMES * frames) const
+{
+	const float * offset = this->geometry.jointOffset;
+	
+	
+	frames->T_shoulder = this->T_base_shoulder*LiCAS_RotationY(q[0] + offset[0])*LiCAS_RotationX(this->mirror*(q[1] + offset[1]))*LiCAS_RotationZ(this->mirror*(q[2] + offset[2]));
+	frames->T_elbow = frames->T_shoulder*LiCAS_Translation(0, 0, -this->geometry.upperArmLength)*LiCAS_RotationY(q[3] + offset[3]);
+	frames->T_tcp = frames->T_elbow*LiCAS_Translation(0, 0, -this->geometry.forearmLength);
+}
+
+
+/*
+ * Position of the TCP in [m] for the given joint positions in [rad]
+ */
+LiCAS_Vector3 LiCAS_ArmKinematics::getTCPPosition(const float q[NUM_ARM_JOINTS]) const
+{
+	LiCAS_ARM_FRAMES frames;
+	LiCAS_Vector3 p;
+	
+	
+	this->forwardKinematics(q, &frames);
+	p[0] = frames.T_tcp(0, 3);
+	p[1] = frames.T_tcp(1, 3);
+	p[2] = frames.T_tcp(2, 3);
+	
+	
+	return p;
+}
+
+
+/*
+ * Capsules of the links of the arm (upper arm, forearm) for the given joint positions in [rad]
+ */
+void LiCAS_ArmKinematics::getCapsules(const float q[NUM_ARM_JOINTS], LiCAS_CAPSULE capsules[NUM_ARM_LINKS]) const
+{
+	LiCAS_ARM_FRAMES frames;
+	int k = 0;
+	
+	
+	this->forwardKinematics(q, &frames);
+	for(k = 0; k < 3; k++)
+	{
+		capsules[0].p0[k] = frames.T_shoulder(k, 3);
+		capsules[0].p1[k] = frames.T_elbow(k, 3);
+		capsules[1].p0[k] = frames.T_elbow(k, 3);
+		capsules[1].p1[k] = frames.T_tcp(k, 3);
+	}
+	capsules[0].radius = this->geometry.upperArmRadius;
+	capsules[1].radius = this->geometry.forearmRadius;
+}
+
+
+/*
+ * Jacobian of the TCP position with respect to the joint positions in [m/rad]: column i is the
+ * cross product of the axis of the joint i by the vector from the joint to the TCP
+ */
+void LiCAS_ArmKinematics::getJacobian(const float q[NUM_ARM_JOINTS], LiCAS_Jacobian * J) const
+{
+	LiCAS_Transform T_pitch = this->T_base_shoulder*LiCAS_RotationY(q[0] + this->geometry.jointOffset[0]);
+	LiCAS_Transform T_roll = T_pitch*LiCAS_RotationX(this->mirror*(q[1] + this->geometry.jointOffset[1]));
+	LiCAS_ARM_FRAMES frames;
+	LiCAS_Vector3 axis[NUM_ARM_JOINTS];
+	LiCAS_Vector3 r[NUM_ARM_JOINTS];
+	LiCAS_Vector3 column;
+	int i = 0;
+	int k = 0;
+	
+	
+	this->forwardKinematics(q, &frames);
+	for(k = 0; k < 3; k++)
+	{
+		axis[0][k] = T_pitch(k, 1);
+		axis[1][k] = this->mirror*T_roll(k, 0);
+		axis[2][k] = this->mirror*frames.T_shoulder(k, 2);
+		axis[3][k] = frames.T_elbow(k, 1);
+		r[0][k] = frames.T_tcp(k, 3) - frames.T_shoulder(k, 3);
+		r[3][k] = frames.T_tcp(k, 3) - frames.T_elbow(k, 3);
+	}
+	r[1] = r[0];
+	r[2] = r[0];
+	
+	for(i = 0; i < NUM_ARM_JOINTS; i++)
+	{
+		column = cross(axis[i], r[i]);
+		for(k = 0; k < 3; k++)
+			(*J)(k, i) = column[k];
+	}
+}
+
+
+/*
+ * Inverse kinematics of the TCP position with damped least squares, starting from a seed (the
+ * previous solution when tracking a path, so the redundancy is solved with minimum joint motion).
+ * Returns 0 if the position error is below IK_TOLERANCE, or 1 otherwise (the joint positions of
+ * the minimum error found are returned).
+ *
+ * Parameters:
+ * 	(1) TCP position in [m]
+ * 	(2) Seed joint positions in [rad]
+ * 	(3) Output joint positions in [rad]
+ * 	(4) Output position error in [m] (can be NULL)
+ */
+int LiCAS_ArmKinematics::inverseKinematics(const LiCAS_Vector3 & p, const float qSeed[NUM_ARM_JOINTS], float q[NUM_ARM_JOINTS], float * positionError) const
+{
+	LiCAS_Jacobian J;
+	LiCAS_Matrix3 A;
+	LiCAS_Vector3 e;
+	LiCAS_Vector3 y;
+	LiCAS_JointVector dq;
+	float qIter[NUM_ARM_JOINTS];
+	float error = 0;
+	float errorMin = 1e9;
+	float stepMax = 0;
+	int iteration = 0;
+	int k = 0;
+	
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+		qIter[k] = qSeed[k];
+	
+	for(iteration = 0; iteration <= IK_MAX_ITERATIONS; iteration++)
+	{
+		e = p - this->getTCPPosition(qIter);
+		error = norm(e);
+		if(error < errorMin)
+		{
+			errorMin = error;
+			for(k = 0; k < NUM_ARM_JOINTS; k++)
+				q[k] = qIter[k];
+		}
+		if(error < IK_TOLERANCE || iteration == IK_MAX_ITERATIONS)
+			break;
+		
+		// dq = J'*(J*J' + lambda^2*I)^-1*e
+		this->getJacobian(qIter, &J);
+		A = J*transpose(J);
+		for(k = 0; k < 3; k++)
+			A(k, k) += IK_DAMPING*IK_DAMPING;
+		if(LiCAS_CholeskySolve(A, e, y) != 0)
+			break;
+		dq = transpose(J)*y;
+		
+		// Limit the step (large errors or close to singularities)
+		stepMax = 0;
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			stepMax = fmax(stepMax, fabs(dq[k]));
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+			qIter[k] += (stepMax > IK_MAX_STEP) ? dq[k]*IK_MAX_STEP/stepMax : dq[k];
+	}
+	
+	if(positionError != NULL)
+		*positionError = errorMin;
+	
+	
+	return (errorMin < IK_TOLERANCE) ? 0 : 1;
+}
+
+
+/*
+ * Geometry of the arm
+ */
+const LiCAS_ARM_GEOMETRY & LiCAS_ArmKinematics::getGeometry() const
+{
+	return this->geometry;
+}
+
@@ -0,0 +1,173 @@
+/*
+ *
+ * LiCAS Kinematics - LiCAS_ArmKinematics.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Forward kinematics and capsule model of the arms. The base frame is located at the middle point
+ * between the shoulders, with the X axis pointing forward, the Y axis to the left and the Z axis
+ * upwards. Each arm has 4 joints: shoulder pitch (Y axis), shoulder roll (X axis), shoulder yaw
+ * (axis of the upper arm) and elbow pitch (Y axis). With all joints at zero the arms hang down
+ * along the -Z axis. The joints of the right arm are mirrored with respect to the XZ plane, so the
+ * same joint values produce symmetric postures. The default geometry is a nominal one, and it has
+ * to be adjusted to the dimensions of the arms in use (LiCAS_ARM_GEOMETRY), for example with the
+ * LiCAS_Calibration program.
+ *
+ */
+
+#ifndef LICAS_ARM_KINEMATICS_H_
+#define LICAS_ARM_KINEMATICS_H_
+
+
+// Standard library
+#include <stdio.h>
+#include <string.h>
+
+
+// Specific library
+#include "LiCAS_Matrix.h"
+
+
+// Arm side
+static const int LiCAS_ARM_LEFT = 0;
+static const int LiCAS_ARM_RIGHT = 1;
+
+// Links of the capsule model of each arm
+#define NUM_ARM_LINKS	2		// Upper arm and forearm
+
+// Inverse kinematics of the TCP position (damped least squares)
+#define IK_MAX_ITERATIONS	20
+#define IK_TOLERANCE		1e-4	// Position error of convergence in [m]
+#define IK_DAMPING			0.01	// Damping factor in [m] (robustness near singularities)
+#define IK_MAX_STEP			0.2		// Maximum joint step per iteration in [rad]
+
+
+// Geometry of the arms
+typedef struct
+{
+	float shoulderOffsetY;		// Distance from the base frame to each shoulder along the Y axis in [m]
+	float shoulderOffsetZ;		// Height of the shoulders over the base frame in [m]
+	float upperArmLength;		// Distance from shoulder to elbow in [m]
+	float forearmLength;		// Distance from elbow to TCP in [m]
+	float upperArmRadius;		// Radius of the capsule of the upper arm in [m]
+	float forearmRadius;		// Radius of the capsule of the forearm in [m]
+	float jointOffset[NUM_ARM_JOINTS];	// Offsets added to the measured joint positions in [rad] (calibration)
+} LiCAS_ARM_GEOMETRY;
+
+
+// Capsule: segment p0-p1 swept by a sphere
+typedef struct
+{
+	LiCAS_Vector3 p0;
+	LiCAS_Vector3 p1;
+	float radius;
+} LiCAS_CAPSULE;
+
+
+// Frames of the arm computed by the forward kinematics (expressed in the base frame)
+typedef struct
+{
+	LiCAS_Transform T_shoulder;		// Shoulder frame after the shoulder joints
+	LiCAS_Transform T_elbow;		// Elbow frame after the elbow joint
+	LiCAS_Transform T_tcp;			// Tool center point frame
+} LiCAS_ARM_FRAMES;
+
+
+class LiCAS_ArmKinematics
+{
+public:
+
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Arm side: LiCAS_ARM_LEFT or LiCAS_ARM_RIGHT
+	 * 	(2) Geometry of the arms
+	 * */
+	LiCAS_ArmKinematics(int _side, const LiCAS_ARM_GEOMETRY & _geometry);
+	
+	
+	/*
+	 * Nominal geometry of the arms
+	 */
+	static LiCAS_ARM_GEOMETRY getDefaultGeometry();
+	
+	
+	/*
+	 * Load the geometry of an arm from a text file ("name value" lines, see saveGeometry()). The
+	 * fields not present in the file keep their values. Returns 0 on success, or 1 if the file could
+	 * not be read.
+	 */
+	static int loadGeometry(const char * fileName, LiCAS_ARM_GEOMETRY * geometry);
+	
+	
+	/*
+	 * Save the geometry of an arm in a text file. Returns 0 on success, or 1 if the file could not be
+	 * written.
+	 */
+	static int saveGeometry(const char * fileName, const LiCAS_ARM_GEOMETRY & geometry);
+	
+	
+	/*
+	 * Forward kinematics: frames of the arm for the given joint positions in [rad]
+	 */
+	void forwardKinematics(const float q[NUM_ARM_JOINTS], LiCAS_ARM_FRAMES * frames) const;
+	
+	
+	/*
+	 * Position of the TCP in [m] for the given joint positions in [rad]
+	 */
+	LiCAS_Vector3 getTCPPosition(const float q[NUM_ARM_JOINTS]) const;
+	
+	
+	/*
+	 * Capsules of the links of the arm (upper arm, forearm) for the given joint positions in [rad]
+	 */
+	void getCapsules(const float q[NUM_ARM_JOINTS], LiCAS_CAPSULE capsules[NUM_ARM_LINKS]) const;
+	
+	
+	/*
+	 * Jacobian of the TCP position with respect to the joint positions in [m/rad]
+	 */
+	void getJacobian(const float q[NUM_ARM_JOINTS], LiCAS_Jacobian * J) const;
+	
+	
+	/*
+	 * Inverse kinematics of the TCP position with damped least squares, starting from a seed (the
+	 * previous solution when tracking a path, so the redundancy is solved with minimum joint motion).
+	 * Returns 0 if the position error is below IK_TOLERANCE, or 1 otherwise (the joint positions of
+	 * the minimum error found are returned).
+	 *
+	 * Parameters:
+	 * 	(1) TCP position in [m]
+	 * 	(2) Seed joint positions in [rad]
+	 * 	(3) Output joint positions in [rad]
+	 * 	(4) Output position error in [m] (can be NULL)
+	 */
+	int inverseKinematics(const LiCAS_Vector3 & p, const float qSeed[NUM_ARM_JOINTS], float q[NUM_ARM_JOINTS], float * positionError) const;
+	
+	
+	/*
+	 * Geometry of the arm
+	 */
+	const LiCAS_ARM_GEOMETRY & getGeometry() const;
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	int side;
+	float mirror;						// 1 for the left arm, -1 for the right arm
+	LiCAS_ARM_GEOMETRY geometry;
+	LiCAS_Transform T_base_shoulder;	// Fixed transform from the base frame to the shoulder
+};
+
+#endif
+
@@ -0,0 +1,316 @@
+/*
+ *
+ * LiCAS Kinematics - LiCAS_Calibration.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Parameters of the fit: {jointOffset[0..3], upperArmLength, forearmLength, shoulderOffsetY,
+ * shoulderOffsetZ}. The columns of the Jacobian of the TCP position are the columns of the joint
+ * Jacobian (joint offsets), the direction of the links (link lengths), and the axes Y and Z of the
+ * base frame for the shoulder offsets (null for the samples w.r.t. the shoulder).
+ *
+ */
+
+#include "LiCAS_Calibration.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_Calibration::LiCAS_Calibration(int _side, const LiCAS_ARM_GEOMETRY & _geometry)
+{
+	this->side = _side;
+	this->initialGeometry = _geometry;
+	this->numBaseFrameSamples = 0;
+}
+
+
+/*
+ * Add a sample: joint positions in [rad] and TCP position in [m], in the base frame (1) or
+ * w.r.t. the shoulder (0)
+ */
+void LiCAS_Calibration::addSample(const float q[NUM_ARM_JOINTS], const float p[3], int flagBaseFrame)
+{
+	LiCAS_CALIBRATION_SAMPLE sample;
+	int k = 0;
+	
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+		sample.q[k] = q[k];
+	for(k = 0; k < 3; k++)
+		sample.p[k] = p[k];
+	sample.flagBaseFrame = (flagBaseFrame != 0) ? 1 : 0;
+	this->samples.push_back(sample);
+	this->numBaseFrameSamples += sample.flagBaseFrame;
+}
+
+
+/*
+ * Number of samples added
+ */
+int LiCAS_Calibration::getNumSamples() const
+{
+	return (int)this->samples.size();
+}
+
+
+/*
+ * Fit the geometry to the samples. The shoulder offsets are only fitted if there are samples in
+ * the base frame. Returns 0 on success, or 1 if there are not enough samples or the normal
+ * equations are singular.
+ *
+ * Parameters:
+ * 	(1) Number of threads (0: number of cores)
+ * 	(2) Output calibrated geometry
+ * 	(3) Output result of the fit (can be NULL)
+ */
+int LiCAS_Calibration::solve(int numThreads, LiCAS_ARM_GEOMETRY * geometry, LiCAS_CALIBRATION_RESULT * result)
+{
+	LiCAS_Matrix<NUM_CALIBRATION_PARAMETERS, NUM_CALIBRATION_PARAMETERS, double> A;
+	LiCAS_Matrix<NUM_CALIBRATION_PARAMETERS, 1, double> g;
+	LiCAS_Matrix<NUM_CALIBRATION_PARAMETERS, 1, double> delta;
+	LiCAS_ARM_GEOMETRY trialGeometry;
+	CALIBRATION_WORK current;
+	CALIBRATION_WORK trial;
+	struct timespec t_start;
+	struct timespec t_end;
+	double parameters[NUM_CALIBRATION_PARAMETERS];
+	double trialParameters[NUM_CALIBRATION_PARAMETERS];
+	double lambda = 1e-3;
+	double rmsInitial = 0;
+	int numFreeParameters = (this->numBaseFrameSamples > 0) ? NUM_CALIBRATION_PARAMETERS : NUM_CALIBRATION_PARAMETERS - 2;
+	int iteration = 0;
+	int flagConverged = 0;
+	int errorCode = 0;
+	int i = 0;
+	int j = 0;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &t_start);
+	if(numThreads <= 0)
+		numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	numThreads = (numThreads < 1) ? 1 : ((numThreads > MAX_CALIBRATION_THREADS) ? MAX_CALIBRATION_THREADS : numThreads);
+	
+	*geometry = this->initialGeometry;
+	if(this->samples.size() < (size_t)numFreeParameters)
+		errorCode = 1;
+	else
+	{
+		getParameters(this->initialGeometry, parameters);
+		this->evaluate(this->initialGeometry, numThreads, 1, &current);
+		rmsInitial = sqrt(current.cost/this->samples.size());
+		
+		// Levenberg-Marquardt iterations
+		for(iteration = 0; iteration < MAX_CALIBRATION_ITERATIONS && flagConverged == 0; iteration++)
+		{
+			// (J'*J + lambda*diag(J'*J))*delta = -J'*r, with the fixed parameters removed
+			for(i = 0; i < NUM_CALIBRATION_PARAMETERS; i++)
+			{
+				for(j = 0; j < NUM_CALIBRATION_PARAMETERS; j++)
+					A(i, j) = (i < numFreeParameters && j < numFreeParameters) ? current.JtJ(i, j) : 0;
+				A(i, i) = (i < numFreeParameters) ? A(i, i)*(1 + lambda) + 1e-12 : 1;
+				g(i, 0) = (i < numFreeParameters) ? -current.Jtr(i, 0) : 0;
+			}
+			if(LiCAS_CholeskySolve(A, g, delta) != 0)
+			{
+				errorCode = 1;
+				break;
+			}
+			
+			for(i = 0; i < NUM_CALIBRATION_PARAMETERS; i++)
+				trialParameters[i] = parameters[i] + delta(i, 0);
+			trialGeometry = this->initialGeometry;
+			setParameters(trialParameters, &trialGeometry);
+			this->evaluate(trialGeometry, numThreads, 1, &trial);
+			
+			if(trial.cost < current.cost)
+			{
+				// Step accepted: converged if the cost does not decrease significantly
+				if(current.cost - trial.cost < 1e-10*current.cost || norm(delta) < 1e-10)
+					flagConverged = 1;
+				for(i = 0; i < NUM_CALIBRATION_PARAMETERS; i++)
+					parameters[i] = trialParameters[i];
+				current = trial;
+				lambda = fmax(0.1*lambda, 1e-9);
+			}
+			else
+			{
+				lambda *= 10;
+				if(lambda > 1e9)
+					flagConverged = 1;
+			}
+		}
+		setParameters(parameters, geometry);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t_end);
+	
+	if(result != NULL)
+	{
+		result->numSamples = (int)this->samples.size();
+		result->numIterations = iteration;
+		result->numThreads = numThreads;
+		result->rmsInitial = rmsInitial;
+		result->rmsFinal = (errorCode == 0) ? sqrt(current.cost/this->samples.size()) : rmsInitial;
+		result->maxErrorFinal = (errorCode == 0) ? current.maxError : 0;
+		result->solveTime = (t_end.tv_sec - t_start.tv_sec) + 1e-9*(t_end.tv_nsec - t_start.tv_nsec);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Entry point of the threads of the evaluation
+ */
+void * LiCAS_Calibration::workEntry(void * arg)
+{
+	CALIBRATION_WORK * work = (CALIBRATION_WORK*)arg;
+	
+	
+	work->calibration->accumulate(work);
+	
+	
+	return NULL;
+}
+
+
+/*
+ * Cost and normal equations of a range of samples
+ */
+void LiCAS_Calibration::accumulate(CALIBRATION_WORK * work) const
+{
+	const LiCAS_ARM_GEOMETRY & geometry = work->kinematics->getGeometry();
+	const LiCAS_CALIBRATION_SAMPLE * sample = NULL;
+	LiCAS_Matrix<3, NUM_CALIBRATION_PARAMETERS, double> J = LiCAS_Matrix<3, NUM_CALIBRATION_PARAMETERS, double>::zeros();
+	LiCAS_Matrix<3, 1, double> r;
+	LiCAS_ARM_FRAMES frames;
+	LiCAS_Jacobian Jq;
+	float mirror = (this->side == LiCAS_ARM_RIGHT) ? -1.0 : 1.0;
+	float shoulder[3] = {0, mirror*geometry.shoulderOffsetY, geometry.shoulderOffsetZ};
+	double error = 0;
+	size_t n = 0;
+	int i = 0;
+	int k = 0;
+	
+	
+	work->JtJ = LiCAS_Matrix<NUM_CALIBRATION_PARAMETERS, NUM_CALIBRATION_PARAMETERS, double>::zeros();
+	work->Jtr = LiCAS_Matrix<NUM_CALIBRATION_PARAMETERS, 1, double>::zeros();
+	work->cost = 0;
+	work->maxError = 0;
+	for(n = work->first; n < work->last; n++)
+	{
+		sample = &this->samples[n];
+		work->kinematics->forwardKinematics(sample->q, &frames);
+		for(k = 0; k < 3; k++)
+			r[k] = frames.T_tcp(k, 3) - ((sample->flagBaseFrame != 0) ? 0 : shoulder[k]) - sample->p[k];
+		error = dot(r, r);
+		work->cost += error;
+		work->maxError = fmax(work->maxError, sqrt(error));
+		
+		if(work->flagJacobian != 0)
+		{
+			work->kinematics->getJacobian(sample->q, &Jq);
+			for(k = 0; k < 3; k++)
+			{
+				for(i = 0; i < NUM_ARM_JOINTS; i++)
+					J(k, i) = Jq(k, i);
+				J(k, 4) = -frames.T_shoulder(k, 2);
+				J(k, 5) = -frames.T_elbow(k, 2);
+			}
+			J(1, 6) = (sample->flagBaseFrame != 0) ? mirror : 0;
+			J(2, 7) = (sample->flagBaseFrame != 0) ? 1 : 0;
+			work->JtJ += transpose(J)*J;
+			work->Jtr += transpose(J)*r;
+		}
+	}
+}
+
+
+/*
+ * Cost (and normal equations) of all the samples for a geometry, splitting the samples among the
+ * threads
+ */
+void LiCAS_Calibration::evaluate(const LiCAS_ARM_GEOMETRY & geometry, int numThreads, int flagJacobian, CALIBRATION_WORK * total) const
+{
+	LiCAS_ArmKinematics kinematics(this->side, geometry);
+	CALIBRATION_WORK work[MAX_CALIBRATION_THREADS];
+	pthread_t threads[MAX_CALIBRATION_THREADS];
+	int flagThreadCreated[MAX_CALIBRATION_THREADS];
+	size_t blockSize = (this->samples.size() + numThreads - 1)/numThreads;
+	int k = 0;
+	
+	
+	for(k = 0; k < numThreads; k++)
+	{
+		work[k].calibration = this;
+		work[k].kinematics = &kinematics;
+		work[k].first = (k*blockSize < this->samples.size()) ? k*blockSize : this->samples.size();
+		work[k].last = ((k + 1)*blockSize < this->samples.size()) ? (k + 1)*blockSize : this->samples.size();
+		work[k].flagJacobian = flagJacobian;
+		flagThreadCreated[k] = 0;
+	}
+	
+	// The calling thread processes the first block
+	for(k = 1; k < numThreads; k++)
+	{
+		if(pthread_create(&threads[k], NULL, &LiCAS_Calibration::workEntry, &work[k]) == 0)
+			flagThreadCreated[k] = 1;
+		else
+			this->accumulate(&work[k]);
+	}
+	this->accumulate(&work[0]);
+	
+	*total = work[0];
+	for(k = 1; k < numThreads; k++)
+	{
+		if(flagThreadCreated[k] == 1)
+			pthread_join(threads[k], NULL);
+		total->JtJ += work[k].JtJ;
+		total->Jtr += work[k].Jtr;
+		total->cost += work[k].cost;
+		total->maxError = fmax(total->maxError, work[k].maxError);
+	}
+}
+
+
+/*
+ * Vector of parameters of the fit from a geometry
+ */
+void LiCAS_Calibration::getParameters(const LiCAS_ARM_GEOMETRY & geometry, double * parameters)
+{
+	int k = 0;
+	
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+		parameters[k] = geometry.jointOffset[k];
+	parameters[4] = geometry.upperArmLength;
+	parameters[5] = geometry.forearmLength;
+	parameters[6] = geometry.shoulderOffsetY;
+	parameters[7] = geometry.shoulderOffsetZ;
+}
+
+
+/*
+ * Geometry from a vector of parameters of the fit (the radii of the capsules are not modified)
+ */
+void LiCAS_Calibration::setParameters(const double * parameters, LiCAS_ARM_GEOMETRY * geometry)
+{
+	int k = 0;
+	
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+		geometry->jointOffset[k] = parameters[k];
+	geometry->upperArmLength = parameters[4];
+	geometry->forearmLength = parameters[5];
+	geometry->shoulderOffsetY = parameters[6];
+	geometry->shoulderOffsetZ = parameters[7];
+}
+
@@ -0,0 +1,147 @@
+/*
+ *
+ * LiCAS Kinematics - LiCAS_Calibration.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Kinematic calibration of an arm: the joint offsets, the link lengths and (with measurements in
+ * the base frame) the position of the shoulder are fitted by nonlinear least squares
+ * (Levenberg-Marquardt) to a set of joint positions and measured TCP positions. The samples come
+ * from the data log of the LiCAS ECI (TCP position w.r.t. the shoulder) or from an external
+ * motion capture system (TCP position in the base frame of the arms). In each iteration the
+ * samples are split among several threads, and each thread accumulates the normal equations
+ * (J'*J and J'*r) of its samples with the analytic Jacobian, so the memory does not grow with the
+ * number of samples and the fit scales with the number of cores.
+ *
+ */
+
+#ifndef LICAS_CALIBRATION_H_
+#define LICAS_CALIBRATION_H_
+
+
+// Standard library
+#include <vector>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "LiCAS_Matrix.h"
+#include "LiCAS_ArmKinematics.h"
+
+
+// Constant definition
+#define NUM_CALIBRATION_PARAMETERS	8		// Joint offsets (4), link lengths (2) and shoulder offsets (2)
+#define MAX_CALIBRATION_THREADS		64
+#define MAX_CALIBRATION_ITERATIONS	50
+
+
+// Sample of the calibration
+typedef struct
+{
+	float q[NUM_ARM_JOINTS];	// Measured joint positions in [rad]
+	float p[3];					// Measured TCP position in [m]
+	int flagBaseFrame;			// TCP position in the base frame (1) or w.r.t. the shoulder (0)
+} LiCAS_CALIBRATION_SAMPLE;
+
+
+// Result of the calibration
+typedef struct
+{
+	int numSamples;
+	int numIterations;
+	int numThreads;
+	double rmsInitial;			// RMS of the position error with the initial geometry in [m]
+	double rmsFinal;			// RMS of the position error with the calibrated geometry in [m]
+	double maxErrorFinal;		// Maximum position error with the calibrated geometry in [m]
+	double solveTime;			// Duration of the fit in [s]
+} LiCAS_CALIBRATION_RESULT;
+
+
+class LiCAS_Calibration
+{
+public:
+
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Arm side: LiCAS_ARM_LEFT or LiCAS_ARM_RIGHT
+	 * 	(2) Initial geometry of the arm
+	 * */
+	LiCAS_Calibration(int _side, const LiCAS_ARM_GEOMETRY & _geometry);
+	
+	
+	/*
+	 * Add a sample: joint positions in [rad] and TCP position in [m], in the base frame (1) or
+	 * w.r.t. the shoulder (0)
+	 */
+	void addSample(const float q[NUM_ARM_JOINTS], const float p[3], int flagBaseFrame);
+	
+	
+	/*
+	 * Number of samples added
+	 */
+	int getNumSamples() const;
+	
+	
+	/*
+	 * Fit the geometry to the samples. The shoulder offsets are only fitted if there are samples in
+	 * the base frame. Returns 0 on success, or 1 if there are not enough samples or the normal
+	 * equations are singular.
+	 *
+	 * Parameters:
+	 * 	(1) Number of threads (0: number of cores)
+	 * 	(2) Output calibrated geometry
+	 * 	(3) Output result of the fit (can be NULL)
+	 */
+	int solve(int numThreads, LiCAS_ARM_GEOMETRY * geometry, LiCAS_CALIBRATION_RESULT * result);
+
+
+private:
+
+	// Work of a thread: normal equations of a range of samples
+	typedef struct
+	{
+		const LiCAS_Calibration * calibration;
+		const LiCAS_ArmKinematics * kinematics;
+		size_t first;
+		size_t last;
+		LiCAS_Matrix<NUM_CALIBRATION_PARAMETERS, NUM_CALIBRATION_PARAMETERS, double> JtJ;
+		LiCAS_Matrix<NUM_CALIBRATION_PARAMETERS, 1, double> Jtr;
+		double cost;
+		double maxError;
+		int flagJacobian;
+	} CALIBRATION_WORK;
+	
+	
+	/***************** PRIVATE VARIABLES *****************/
+	int side;
+	LiCAS_ARM_GEOMETRY initialGeometry;
+	std::vector<LiCAS_CALIBRATION_SAMPLE> samples;
+	int numBaseFrameSamples;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	static void * workEntry(void * arg);
+	
+	void accumulate(CALIBRATION_WORK * work) const;
+	
+	void evaluate(const LiCAS_ARM_GEOMETRY & geometry, int numThreads, int flagJacobian, CALIBRATION_WORK * total) const;
+	
+	static void getParameters(const LiCAS_ARM_GEOMETRY & geometry, double * parameters);
+	
+	static void setParameters(const double * parameters, LiCAS_ARM_GEOMETRY * geometry);
+};
+
+#endif
+
@@ -0,0 +1,601 @@
+/*
+ *
+ * LiCAS Kinematics - LiCAS_Matrix.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Header-only fixed-size matrices for the kinematics, estimation and control of the arms. The
+ * dimensions are template parameters, so the matrices live on the stack (no heap allocation) and
+ * the element-wise operations and products are fully unrolled by the compiler. The matrices of
+ * floats with rows of 4 elements (4x4 transforms, Nx4 matrices with NUM_ARM_JOINTS = 4...) are
+ * 16-byte aligned and their products and element-wise operations use 4-wide SIMD vectors (GCC
+ * vector extensions: SSE on x86, NEON on ARM). The elements are stored by rows.
+ *
+ * Example:
+ *
+ * 	LiCAS_Transform T = LiCAS_Transform::identity();
+ * 	LiCAS_Jacobian J;
+ * 	LiCAS_JointVector dq;
+ * 	LiCAS_Vector3 v = J*dq;
+ *
+ */
+
+#ifndef LICAS_MATRIX_H_
+#define LICAS_MATRIX_H_
+
+
+// Standard library
+#include <math.h>
+#include <string.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_Packets.h"
+
+
+// 4-wide float vector (16 bytes), allowed to alias the elements of the matrices
+typedef float LiCAS_v4sf __attribute__((vector_size(16), may_alias));
+
+
+/*
+ * Compile-time loop: executes f(0), f(1)... f(N-1) without loop control
+ */
+template <int N>
+struct LiCAS_Unroll
+{
+	template <typename F>
+	static inline __attribute__((always_inline)) void run(F f)
+	{
+		LiCAS_Unroll<N - 1>::run(f);
+		f(N - 1);
+	}
+};
+
+
+template <>
+struct LiCAS_Unroll<0>
+{
+	template <typename F>
+	static inline __attribute__((always_inline)) void run(F)
+	{
+	}
+};
+
+
+/*
+ * Alignment of the matrices: 16 bytes if the elements can be processed as 4-wide float vectors
+ */
+template <int SIZE, typename T>
+struct LiCAS_MatrixAlignment
+{
+	static constexpr int value = alignof(T);
+};
+
+
+template <int SIZE>
+struct LiCAS_MatrixAlignment<SIZE, float>
+{
+	static constexpr int value = (SIZE % 4 == 0) ? 16 : alignof(float);
+};
+
+
+/*
+ * Fixed-size matrix of ROWS x COLS elements stored by rows
+ */
+template <int ROWS, int COLS, typename T = float>
+struct LiCAS_Matrix
+{
+	static constexpr int rows = ROWS;
+	static constexpr int cols = COLS;
+	static constexpr int size = ROWS*COLS;
+	
+	alignas(LiCAS_MatrixAlignment<ROWS*COLS, T>::value) T data[ROWS*COLS];
+	
+	
+	inline T & operator()(int i, int j) { return data[i*COLS + j]; }
+	inline const T & operator()(int i, int j) const { return data[i*COLS + j]; }
+	
+	inline T & operator[](int k) { return data[k]; }
+	inline const T & operator[](int k) const { return data[k]; }
+	
+	
+	static inline LiCAS_Matrix zeros()
+	{
+		LiCAS_Matrix M;
+		
+		
+		LiCAS_Unroll<ROWS*COLS>::run([&](int k) { M.data[k] = 0; });
+		
+		
+		return M;
+	}
+	
+	
+	static inline LiCAS_Matrix identity()
+	{
+		LiCAS_Matrix M = zeros();
+		
+		
+		LiCAS_Unroll<(ROWS < COLS) ? ROWS : COLS>::run([&](int k) { M.data[k*COLS + k] = 1; });
+		
+		
+		return M;
+	}
+	
+	
+	/*
+	 * Copy from/to arrays of ROWS*COLS elements (for example the joint arrays of the ECI)
+	 */
+	static inline LiCAS_Matrix fromArray(const T * values)
+	{
+		LiCAS_Matrix M;
+		
+		
+		LiCAS_Unroll<ROWS*COLS>::run([&](int k) { M.data[k] = values[k]; });
+		
+		
+		return M;
+	}
+	
+	
+	inline void toArray(T * values) const
+	{
+		LiCAS_Unroll<ROWS*COLS>::run([&](int k) { values[k] = data[k]; });
+	}
+};
+
+
+// Matrices of the arms
+typedef LiCAS_Matrix<3, 1> LiCAS_Vector3;								// Cartesian position/velocity
+typedef LiCAS_Matrix<3, 3> LiCAS_Matrix3;								// Rotation matrix
+typedef LiCAS_Matrix<4, 4> LiCAS_Transform;								// Homogeneous transform
+typedef LiCAS_Matrix<NUM_ARM_JOINTS, 1> LiCAS_JointVector;				// Joint positions/speeds/torques
+typedef LiCAS_Matrix<3, NUM_ARM_JOINTS> LiCAS_Jacobian;					// TCP position Jacobian
+typedef LiCAS_Matrix<NUM_ARM_JOINTS, NUM_ARM_JOINTS> LiCAS_JointMatrix;	// Inertia, gains...
+
+
+/*
+ * Element-wise operations, vectorized when the size is a multiple of 4 floats
+ */
+template <int ROWS, int COLS, typename T, typename F>
+static inline __attribute__((always_inline)) void LiCAS_ElementWise(LiCAS_Matrix<ROWS, COLS, T> & C, const LiCAS_Matrix<ROWS, COLS, T> & A, const LiCAS_Matrix<ROWS, COLS, T> & B, F f)
+{
+	LiCAS_Unroll<ROWS*COLS>::run([&](int k) { C.data[k] = f(A.data[k], B.data[k]); });
+}
+
+
+template <int ROWS, int COLS, typename F>
+static inline __attribute__((always_inline)) void LiCAS_ElementWise(LiCAS_Matrix<ROWS, COLS, float> & C, const LiCAS_Matrix<ROWS, COLS, float> & A, const LiCAS_Matrix<ROWS, COLS, float> & B, F f)
+{
+	if((ROWS*COLS) % 4 == 0)
+	{
+		LiCAS_Unroll<(ROWS*COLS)/4>::run([&](int k) {
+			*(LiCAS_v4sf*)&C.data[4*k] = f(*(const LiCAS_v4sf*)&A.data[4*k], *(const LiCAS_v4sf*)&B.data[4*k]);
+		});
+	}
+	else
+		LiCAS_Unroll<ROWS*COLS>::run([&](int k) { C.data[k] = f(A.data[k], B.data[k]); });
+}
+
+
+template <int ROWS, int COLS, typename T>
+static inline LiCAS_Matrix<ROWS, COLS, T> operator+(const LiCAS_Matrix<ROWS, COLS, T> & A, const LiCAS_Matrix<ROWS, COLS, T> & B)
+{
+	LiCAS_Matrix<ROWS, COLS, T> C;
+	
+	
+	LiCAS_ElementWise(C, A, B, [](auto a, auto b) { return a + b; });
+	
+	
+	return C;
+}
+
+
+template <int ROWS, int COLS, typename T>
+static inline LiCAS_Matrix<ROWS, COLS, T> operator-(const LiCAS_Matrix<ROWS, COLS, T> & A, const LiCAS_Matrix<ROWS, COLS, T> & B)
+{
+	LiCAS_Matrix<ROWS, COLS, T> C;
+	
+	
+	LiCAS_ElementWise(C, A, B, [](auto a, auto b) { return a - b; });
+	
+	
+	return C;
+}
+
+
+template <int ROWS, int COLS, typename T>
+static inline LiCAS_Matrix<ROWS, COLS, T> operator*(T s, const LiCAS_Matrix<ROWS, COLS, T> & A)
+{
+	LiCAS_Matrix<ROWS, COLS, T> C;
+	
+	
+	LiCAS_ElementWise(C, A, A, [s](auto a, auto) { return s*a; });
+	
+	
+	return C;
+}
+
+
+template <int ROWS, int COLS, typename T>
+static inline LiCAS_Matrix<ROWS, COLS, T> operator*(const LiCAS_Matrix<ROWS, COLS, T> & A, T s)
+{
+	return s*A;
+}
+
+
+template <int ROWS, int COLS, typename T>
+static inline LiCAS_Matrix<ROWS, COLS, T> & operator+=(LiCAS_Matrix<ROWS, COLS, T> & A, const LiCAS_Matrix<ROWS, COLS, T> & B)
+{
+	LiCAS_ElementWise(A, A, B, [](auto a, auto b) { return a + b; });
+	
+	
+	return A;
+}
+
+
+template <int ROWS, int COLS, typename T>
+static inline LiCAS_Matrix<ROWS, COLS, T> & operator-=(LiCAS_Matrix<ROWS, COLS, T> & A, const LiCAS_Matrix<ROWS, COLS, T> & B)
+{
+	LiCAS_ElementWise(A, A, B, [](auto a, auto b) { return a - b; });
+	
+	
+	return A;
+}
+
+
+/*
+ * Matrix product. If the rows of the result are multiple of 4 floats, each row is computed as a
+ * linear combination of the rows of B with 4-wide vectors.
+ */
+template <int M, int K, int N, typename T, bool SIMD>
+struct LiCAS_MatrixProduct
+{
+	static inline __attribute__((always_inline)) void run(LiCAS_Matrix<M, N, T> & C, const LiCAS_Matrix<M, K, T> & A, const LiCAS_Matrix<K, N, T> & B)
+	{
+		LiCAS_Unroll<M>::run([&](int i) __attribute__((always_inline)) {
+			LiCAS_Unroll<N>::run([&](int j) __attribute__((always_inline)) {
+				T sum = 0;
+				LiCAS_Unroll<K>::run([&](int k) __attribute__((always_inline)) { sum += A.data[i*K + k]*B.data[k*N + j]; });
+				C.data[i*N + j] = sum;
+			});
+		});
+	}
+};
+
+
+template <int M, int K, int N>
+struct LiCAS_MatrixProduct<M, K, N, float, true>
+{
+	static inline __attribute__((always_inline)) void run(LiCAS_Matrix<M, N, float> & C, const LiCAS_Matrix<M, K, float> & A, const LiCAS_Matrix<K, N, float> & B)
+	{
+		LiCAS_Unroll<M>::run([&](int i) __attribute__((always_inline)) {
+			LiCAS_v4sf row[N/4];
+			LiCAS_Unroll<N/4>::run([&](int c) __attribute__((always_inline)) { row[c] = A.data[i*K]*(*(const LiCAS_v4sf*)&B.data[4*c]); });
+			LiCAS_Unroll<K - 1>::run([&](int k) __attribute__((always_inline)) {
+				LiCAS_Unroll<N/4>::run([&](int c) __attribute__((always_inline)) { row[c] += A.data[i*K + k + 1]*(*(const LiCAS_v4sf*)&B.data[(k + 1)*N + 4*c]); });
+			});
+			LiCAS_Unroll<N/4>::run([&](int c) __attribute__((always_inline)) { *(LiCAS_v4sf*)&C.data[i*N + 4*c] = row[c]; });
+		});
+	}
+};
+
+
+template <int M, int K, int N, typename T>
+static inline LiCAS_Matrix<M, N, T> operator*(const LiCAS_Matrix<M, K, T> & A, const LiCAS_Matrix<K, N, T> & B)
+{
+	LiCAS_Matrix<M, N, T> C;
+	
+	
+	LiCAS_MatrixProduct<M, K, N, T, LiCAS_MatrixAlignment<N, T>::value == 16>::run(C, A, B);
+	
+	
+	return C;
+}
+
+
+template <int ROWS, int COLS, typename T>
+static inline LiCAS_Matrix<COLS, ROWS, T> transpose(const LiCAS_Matrix<ROWS, COLS, T> & A)
+{
+	LiCAS_Matrix<COLS, ROWS, T> C;
+	
+	
+	LiCAS_Unroll<ROWS>::run([&](int i) {
+		LiCAS_Unroll<COLS>::run([&](int j) { C.data[j*ROWS + i] = A.data[i*COLS + j]; });
+	});
+	
+	
+	return C;
+}
+
+
+/*
+ * Vector operations
+ */
+template <int N, typename T>
+static inline T dot(const LiCAS_Matrix<N, 1, T> & a, const LiCAS_Matrix<N, 1, T> & b)
+{
+	T sum = 0;
+	
+	
+	LiCAS_Unroll<N>::run([&](int k) { sum += a.data[k]*b.data[k]; });
+	
+	
+	return sum;
+}
+
+
+template <int N, typename T>
+static inline T norm(const LiCAS_Matrix<N, 1, T> & a)
+{
+	return sqrt(dot(a, a));
+}
+
+
+template <typename T>
+static inline LiCAS_Matrix<3, 1, T> cross(const LiCAS_Matrix<3, 1, T> & a, const LiCAS_Matrix<3, 1, T> & b)
+{
+	LiCAS_Matrix<3, 1, T> c;
+	
+	
+	c.data[0] = a.data[1]*b.data[2] - a.data[2]*b.data[1];
+	c.data[1] = a.data[2]*b.data[0] - a.data[0]*b.data[2];
+	c.data[2] = a.data[0]*b.data[1] - a.data[1]*b.data[0];
+	
+	
+	return c;
+}
+
+
+/*
+ * Solve the linear system A*x = b by LU decomposition with partial pivoting. Returns 0 if the
+ * system was solved, or 1 if A is singular.
+ */
+template <int N, int M, typename T>
+static inline int LiCAS_Solve(const LiCAS_Matrix<N, N, T> & A, const LiCAS_Matrix<N, M, T> & b, LiCAS_Matrix<N, M, T> & x)
+{
+	LiCAS_Matrix<N, N, T> LU = A;
+	T factor = 0;
+	T tmp = 0;
+	int pivot = 0;
+	int errorCode = 0;
+	int i = 0;
+	int j = 0;
+	int k = 0;
+	
+	
+	x = b;
+	for(k = 0; k < N && errorCode == 0; k++)
+	{
+		// Row with the largest pivot
+		pivot = k;
+		for(i = k + 1; i < N; i++)
+		{
+			if(fabs(LU(i, k)) > fabs(LU(pivot, k)))
+				pivot = i;
+		}
+		if(LU(pivot, k) == 0)
+			errorCode = 1;
+		else
+		{
+			if(pivot != k)
+			{
+				for(j = 0; j < N; j++)
+				{
+					tmp = LU(k, j);
+					LU(k, j) = LU(pivot, j);
+					LU(pivot, j) = tmp;
+				}
+				for(j = 0; j < M; j++)
+				{
+					tmp = x(k, j);
+					x(k, j) = x(pivot, j);
+					x(pivot, j) = tmp;
+				}
+			}
+			
+			// Elimination below the pivot
+			for(i = k + 1; i < N; i++)
+			{
+				factor = LU(i, k)/LU(k, k);
+				for(j = k; j < N; j++)
+					LU(i, j) -= factor*LU(k, j);
+				for(j = 0; j < M; j++)
+					x(i, j) -= factor*x(k, j);
+			}
+		}
+	}
+	
+	// Back substitution
+	for(k = N - 1; k >= 0 && errorCode == 0; k--)
+	{
+		for(j = 0; j < M; j++)
+		{
+			for(i = k + 1; i < N; i++)
+				x(k, j) -= LU(k, i)*x(i, j);
+			x(k, j) /= LU(k, k);
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Solve the linear system A*x = b with A symmetric positive definite (covariances, inertia
+ * matrices, normal equations) by Cholesky decomposition. Returns 0 if the system was solved, or 1
+ * if A is not positive definite.
+ */
+template <int N, int M, typename T>
+static inline int LiCAS_CholeskySolve(const LiCAS_Matrix<N, N, T> & A, const LiCAS_Matrix<N, M, T> & b, LiCAS_Matrix<N, M, T> & x)
+{
+	LiCAS_Matrix<N, N, T> L = LiCAS_Matrix<N, N, T>::zeros();
+	T sum = 0;
+	int errorCode = 0;
+	int i = 0;
+	int j = 0;
+	int k = 0;
+	
+	
+	// A = L*L'
+	for(j = 0; j < N && errorCode == 0; j++)
+	{
+		sum = A(j, j);
+		for(k = 0; k < j; k++)
+			sum -= L(j, k)*L(j, k);
+		if(sum <= 0)
+			errorCode = 1;
+		else
+		{
+			L(j, j) = sqrt(sum);
+			for(i = j + 1; i < N; i++)
+			{
+				sum = A(i, j);
+				for(k = 0; k < j; k++)
+					sum -= L(i, k)*L(j, k);
+				L(i, j) = sum/L(j, j);
+			}
+		}
+	}
+	
+	// Forward (L*y = b) and backward (L'*x = y) substitution
+	if(errorCode == 0)
+	{
+		for(j = 0; j < M; j++)
+		{
+			for(i = 0; i < N; i++)
+			{
+				sum = b(i, j);
+				for(k = 0; k < i; k++)
+					sum -= L(i, k)*x(k, j);
+				x(i, j) = sum/L(i, i);
+			}
+			for(i = N - 1; i >= 0; i--)
+			{
+				sum = x(i, j);
+				for(k = i + 1; k < N; k++)
+					sum -= L(k, i)*x(k, j);
+				x(i, j) = sum/L(i, i);
+			}
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Inverse of a square matrix. Returns 0 if the inverse was computed, or 1 if A is singular.
+ */
+template <int N, typename T>
+static inline int LiCAS_Inverse(const LiCAS_Matrix<N, N, T> & A, LiCAS_Matrix<N, N, T> & Ainv)
+{
+	return LiCAS_Solve(A, LiCAS_Matrix<N, N, T>::identity(), Ainv);
+}
+
+
+/*
+ * Homogeneous transforms
+ */
+static inline LiCAS_Transform LiCAS_RotationX(float angle)
+{
+	LiCAS_Transform T = LiCAS_Transform::identity();
+	float c = cosf(angle);
+	float s = sinf(angle);
+	
+	
+	T(1, 1) = c;	T(1, 2) = -s;
+	T(2, 1) = s;	T(2, 2) = c;
+	
+	
+	return T;
+}
+
+
+static inline LiCAS_Transform LiCAS_RotationY(float angle)
+{
+	LiCAS_Transform T = LiCAS_Transform::identity();
+	float c = cosf(angle);
+	float s = sinf(angle);
+	
+	
+	T(0, 0) = c;	T(0, 2) = s;
+	T(2, 0) = -s;	T(2, 2) = c;
+	
+	
+	return T;
+}
+
+
+static inline LiCAS_Transform LiCAS_RotationZ(float angle)
+{
+	LiCAS_Transform T = LiCAS_Transform::identity();
+	float c = cosf(angle);
+	float s = sinf(angle);
+	
+	
+	T(0, 0) = c;	T(0, 1) = -s;
+	T(1, 0) = s;	T(1, 1) = c;
+	
+	
+	return T;
+}
+
+
+static inline LiCAS_Transform LiCAS_Translation(float x, float y, float z)
+{
+	LiCAS_Transform T = LiCAS_Transform::identity();
+	
+	
+	T(0, 3) = x;
+	T(1, 3) = y;
+	T(2, 3) = z;
+	
+	
+	return T;
+}
+
+
+/*
+ * Inverse of a rigid transform: [R' -R'*p; 0 1]
+ */
+static inline LiCAS_Transform LiCAS_RigidInverse(const LiCAS_Transform & T)
+{
+	LiCAS_Transform Tinv = LiCAS_Transform::identity();
+	
+	
+	LiCAS_Unroll<3>::run([&](int i) {
+		LiCAS_Unroll<3>::run([&](int j) { Tinv(i, j) = T(j, i); });
+		Tinv(i, 3) = -(T(0, i)*T(0, 3) + T(1, i)*T(1, 3) + T(2, i)*T(2, 3));
+	});
+	
+	
+	return Tinv;
+}
+
+
+/*
+ * Transform a point: R*p + t
+ */
+static inline LiCAS_Vector3 LiCAS_TransformPoint(const LiCAS_Transform & T, const LiCAS_Vector3 & p)
+{
+	LiCAS_Vector3 q;
+	
+	
+	LiCAS_Unroll<3>::run([&](int i) { q.data[i] = T(i, 0)*p.data[0] + T(i, 1)*p.data[1] + T(i, 2)*p.data[2] + T(i, 3); });
+	
+	
+	return q;
+}
+
+#endif
+
@@ -0,0 +1,514 @@
+/*
+ *
+ * LiCAS Kinematics - LiCAS_SDF.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Distance field of the environment. The field is built with the separable squared Euclidean
+ * distance transform of Felzenszwalb and Huttenlocher over the voxels that contain points,
+ * propagating the index of the nearest seed voxel. The final distance of each voxel is computed
+ * to the point of its nearest seed voxel, so the error is well below the voxel size.
+ *
+ */
+
+#include "LiCAS_SDF.h"
+
+
+// Limit of the number of voxels of the grid built offline (128 MB of quantized distances)
+#define SDF_MAX_VOXELS	(1 << 26)
+
+
+/*
+ * 1D squared distance transform of the sampled function f (INFINITY where there is no seed),
+ * propagating the seed indexes of argIn to argOut. v and z are working buffers of n and n + 1
+ * elements.
+ */
+static void distanceTransform1D(const float * f, const int * argIn, int n, float * d, int * argOut, int * v, double * z)
+{
+	double s = 0;
+	int first = 0;
+	int k = 0;
+	int q = 0;
+	
+	
+	while(first < n && f[first] == INFINITY)
+		first++;
+	
+	if(first == n)
+	{
+		for(q = 0; q < n; q++)
+		{
+			d[q] = INFINITY;
+			argOut[q] = -1;
+		}
+	}
+	else
+	{
+		// Lower envelope of the parabolas rooted at the seeds
+		v[0] = first;
+		z[0] = -INFINITY;
+		z[1] = INFINITY;
+		for(q = first + 1; q < n; q++)
+		{
+			if(f[q] == INFINITY)
+				continue;
+			s = ((f[q] + (double)q*q) - (f[v[k]] + (double)v[k]*v[k]))/(2.0*q - 2.0*v[k]);
+			while(s <= z[k])
+			{
+				k--;
+				s = ((f[q] + (double)q*q) - (f[v[k]] + (double)v[k]*v[k]))/(2.0*q - 2.0*v[k]);
+			}
+			k++;
+			v[k] = q;
+			z[k] = s;
+			z[k + 1] = INFINITY;
+		}
+		
+		k = 0;
+		for(q = 0; q < n; q++)
+		{
+			while(z[k + 1] < q)
+				k++;
+			d[q] = (float)((double)(q - v[k])*(q - v[k]) + f[v[k]]);
+			argOut[q] = argIn[v[k]];
+		}
+	}
+}
+
+
+/*
+ * Squared distance transform along one axis of the grid: lines of n voxels separated by stride
+ */
+static void distanceTransformAxis(std::vector<float> & f, std::vector<int> & arg, int numVoxels, int n, int stride)
+{
+	std::vector<float> fLine(n), dLine(n);
+	std::vector<int> argLine(n), argOutLine(n), v(n);
+	std::vector<double> z(n + 1);
+	int lineStart = 0;
+	int k = 0;
+	
+	
+	for(lineStart = 0; lineStart < numVoxels; lineStart++)
+	{
+		// First voxel of each line: index along the axis equal to 0
+		if((lineStart/stride) % n != 0)
+			continue;
+		
+		for(k = 0; k < n; k++)
+		{
+			fLine[k] = f[lineStart + k*stride];
+			argLine[k] = arg[lineStart + k*stride];
+		}
+		distanceTransform1D(fLine.data(), argLine.data(), n, dLine.data(), argOutLine.data(), v.data(), z.data());
+		for(k = 0; k < n; k++)
+		{
+			f[lineStart + k*stride] = dLine[k];
+			arg[lineStart + k*stride] = argOutLine[k];
+		}
+	}
+}
+
+
+/*
+ * Constructor
+ * */
+LiCAS_SDF::LiCAS_SDF()
+{
+	this->mapAddress = NULL;
+	this->mapSize = 0;
+	this->header = NULL;
+	this->grid = NULL;
+	this->nx = 0;
+	this->ny = 0;
+	this->nz = 0;
+	this->origin[0] = this->origin[1] = this->origin[2] = 0;
+	this->invResolution = 0;
+	this->scale = 0;
+	this->maxDistance = 0;
+}
+
+
+/*
+ * Destructor
+ * */
+LiCAS_SDF::~LiCAS_SDF()
+{
+	this->close();
+}
+
+
+/*
+ * Build the distance field from a set of points of the surface of the obstacles and save it.
+ *
+ * Parameters:
+ * 	(1) Points of the environment in [m] (base frame of the arms)
+ * 	(2) Size of the voxels in [m]
+ * 	(3) Margin added around the bounding box of the points in [m]
+ * 	(4) Saturation distance in [m]
+ * 	(5) Name of the SDF file
+ */
+int LiCAS_SDF::build(const std::vector<LiCAS_Vector3> & points, float resolution, float margin, float maxDistance, const char * fileName)
+{
+	LiCAS_SDF_HEADER header;
+	LiCAS_Vector3 pMin, pMax, center;
+	std::vector<float> f;
+	std::vector<int> arg;
+	std::vector<int> seedPoint;
+	std::vector<uint16_t> grid;
+	FILE * sdfFile = NULL;
+	float distance = 0;
+	float dx = 0;
+	int n[3] = {0, 0, 0};
+	int numVoxels = 0;
+	int index = 0;
+	int errorCode = 0;
+	int i[3] = {0, 0, 0};
+	size_t k = 0;
+	int j = 0;
+	
+	
+	if(points.size() == 0 || resolution <= 0 || maxDistance <= 0)
+		errorCode = 1;
+	else
+	{
+		// Bounding box of the points extended by the margin
+		pMin = pMax = points[0];
+		for(k = 1; k < points.size(); k++)
+		{
+			for(j = 0; j < 3; j++)
+			{
+				pMin[j] = fmin(pMin[j], points[k][j]);
+				pMax[j] = fmax(pMax[j], points[k][j]);
+			}
+		}
+		for(j = 0; j < 3; j++)
+		{
+			pMin[j] -= margin;
+			pMax[j] += margin;
+			n[j] = (int)ceil((pMax[j] - pMin[j])/resolution) + 1;
+		}
+		if((double)n[0]*n[1]*n[2] > SDF_MAX_VOXELS)
+			errorCode = 2;
+		else
+			numVoxels = n[0]*n[1]*n[2];
+	}
+	
+	if(errorCode == 0)
+	{
+		// Seed voxels: voxels that contain points, associated to the point nearest to their center
+		f.assign(numVoxels, INFINITY);
+		arg.assign(numVoxels, -1);
+		seedPoint.assign(numVoxels, -1);
+		for(k = 0; k < points.size(); k++)
+		{
+			for(j = 0; j < 3; j++)
+				i[j] = (int)lround((points[k][j] - pMin[j])/resolution);
+			index = (i[2]*n[1] + i[1])*n[0] + i[0];
+			for(j = 0; j < 3; j++)
+				center[j] = pMin[j] + i[j]*resolution;
+			if(seedPoint[index] < 0 || norm(points[k] - center) < norm(points[seedPoint[index]] - center))
+				seedPoint[index] = (int)k;
+			f[index] = 0;
+			arg[index] = index;
+		}
+		
+		// Squared distance (in voxels) to the nearest seed and index of that seed
+		distanceTransformAxis(f, arg, numVoxels, n[0], 1);
+		distanceTransformAxis(f, arg, numVoxels, n[1], n[0]);
+		distanceTransformAxis(f, arg, numVoxels, n[2], n[0]*n[1]);
+		
+		// Distance from the center of each voxel to the point of its nearest seed, quantized
+		bzero(&header, sizeof(header));
+		header.magic = SDF_FILE_MAGIC;
+		header.version = SDF_FILE_VERSION;
+		header.nx = n[0];
+		header.ny = n[1];
+		header.nz = n[2];
+		header.origin[0] = pMin[0];
+		header.origin[1] = pMin[1];
+		header.origin[2] = pMin[2];
+		header.resolution = resolution;
+		header.maxDistance = maxDistance;
+		header.scale = maxDistance/65535.0;
+		header.numPoints = (uint32_t)points.size();
+		
+		grid.resize(numVoxels);
+		for(index = 0; index < numVoxels; index++)
+		{
+			distance = maxDistance;
+			if(arg[index] >= 0)
+			{
+				i[0] = index % n[0];
+				i[1] = (index/n[0]) % n[1];
+				i[2] = index/(n[0]*n[1]);
+				distance = 0;
+				for(j = 0; j < 3; j++)
+				{
+					dx = pMin[j] + i[j]*resolution - points[seedPoint[arg[index]]][j];
+					distance += dx*dx;
+				}
+				distance = fmin(sqrt(distance), maxDistance);
+			}
+			grid[index] = (uint16_t)lround(distance/header.scale);
+		}
+		
+		sdfFile = fopen(fileName, "wb");
+		if(sdfFile == NULL)
+			errorCode = 3;
+		else
+		{
+			if(fwrite(&header, sizeof(header), 1, sdfFile) != 1 || fwrite(grid.data(), sizeof(uint16_t), numVoxels, sdfFile) != (size_t)numVoxels)
+				errorCode = 3;
+			fclose(sdfFile);
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Map a SDF file in memory. The pages are loaded and locked (if allowed) to avoid page faults
+ * during the queries.
+ */
+int LiCAS_SDF::open(const char * fileName)
+{
+	struct stat fileStat;
+	size_t expectedSize = 0;
+	int errorCode = 0;
+	int fd = -1;
+	
+	
+	this->close();
+	
+	fd = ::open(fileName, O_RDONLY | O_CLOEXEC);
+	if(fd < 0 || fstat(fd, &fileStat) != 0 || (size_t)fileStat.st_size < sizeof(LiCAS_SDF_HEADER))
+		errorCode = 1;
+	else
+	{
+		this->mapAddress = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+		if(this->mapAddress == MAP_FAILED)
+		{
+			errorCode = 1;
+			this->mapAddress = NULL;
+		}
+		else
+		{
+			this->mapSize = fileStat.st_size;
+			this->header = (const LiCAS_SDF_HEADER*)this->mapAddress;
+			expectedSize = sizeof(LiCAS_SDF_HEADER) + sizeof(uint16_t)*(size_t)header->nx*header->ny*header->nz;
+			if(header->magic != SDF_FILE_MAGIC || header->version != SDF_FILE_VERSION || header->nx < 2 || header->ny < 2 || header->nz < 2 || this->mapSize != expectedSize)
+			{
+				errorCode = 2;
+				this->close();
+			}
+			else
+			{
+				// Locking the pages requires privileges: the field is usable anyway
+				mlock(this->mapAddress, this->mapSize);
+				
+				this->grid = (const uint16_t*)((const char*)this->mapAddress + sizeof(LiCAS_SDF_HEADER));
+				this->nx = header->nx;
+				this->ny = header->ny;
+				this->nz = header->nz;
+				this->origin[0] = header->origin[0];
+				this->origin[1] = header->origin[1];
+				this->origin[2] = header->origin[2];
+				this->invResolution = 1.0/header->resolution;
+				this->scale = header->scale;
+				this->maxDistance = header->maxDistance;
+			}
+		}
+	}
+	if(fd >= 0)
+		::close(fd);
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Unmap the SDF file
+ */
+void LiCAS_SDF::close()
+{
+	if(this->mapAddress != NULL)
+	{
+		munlock(this->mapAddress, this->mapSize);
+		munmap(this->mapAddress, this->mapSize);
+	}
+	this->mapAddress = NULL;
+	this->mapSize = 0;
+	this->header = NULL;
+	this->grid = NULL;
+}
+
+
+/*
+ * Returns 1 if a SDF file is mapped
+ */
+int LiCAS_SDF::isOpen() const
+{
+	return (this->grid != NULL) ? 1 : 0;
+}
+
+
+/*
+ * Header of the mapped SDF file
+ */
+const LiCAS_SDF_HEADER * LiCAS_SDF::getHeader() const
+{
+	return this->header;
+}
+
+
+/*
+ * Distance to the nearest obstacle in [m] and its gradient at a point. Returns 0 if the point is
+ * inside the grid, or 1 otherwise (distance saturated, null gradient).
+ */
+int LiCAS_SDF::query(const LiCAS_Vector3 & p, float * distance, LiCAS_Vector3 * gradient) const
+{
+	const uint16_t * c = NULL;
+	float ux = (p[0] - this->origin[0])*this->invResolution;
+	float uy = (p[1] - this->origin[1])*this->invResolution;
+	float uz = (p[2] - this->origin[2])*this->invResolution;
+	float fx = 0, fy = 0, fz = 0;
+	float c00 = 0, c10 = 0, c01 = 0, c11 = 0;
+	float c0 = 0, c1 = 0;
+	float c000, c100, c010, c110, c001, c101, c011, c111;
+	int sy = this->nx;
+	int sz = this->nx*this->ny;
+	int ix = 0, iy = 0, iz = 0;
+	
+	
+	// The negated comparisons also reject NaN positions
+	if(this->grid == NULL || !(ux >= 0 && uy >= 0 && uz >= 0 && ux < this->nx - 1 && uy < this->ny - 1 && uz < this->nz - 1))
+	{
+		*distance = this->maxDistance;
+		if(gradient != NULL)
+			*gradient = LiCAS_Vector3::zeros();
+		return 1;
+	}
+	
+	ix = (int)ux;
+	iy = (int)uy;
+	iz = (int)uz;
+	fx = ux - ix;
+	fy = uy - iy;
+	fz = uz - iz;
+	
+	// Distances at the corners of the cell
+	c = this->grid + (iz*this->ny + iy)*this->nx + ix;
+	c000 = c[0];
+	c100 = c[1];
+	c010 = c[sy];
+	c110 = c[sy + 1];
+	c001 = c[sz];
+	c101 = c[sz + 1];
+	c011 = c[sz + sy];
+	c111 = c[sz + sy + 1];
+	
+	// Trilinear interpolation
+	c00 = c000 + fx*(c100 - c000);
+	c10 = c010 + fx*(c110 - c010);
+	c01 = c001 + fx*(c101 - c001);
+	c11 = c011 + fx*(c111 - c011);
+	c0 = c00 + fy*(c10 - c00);
+	c1 = c01 + fy*(c11 - c01);
+	*distance = this->scale*(c0 + fz*(c1 - c0));
+	
+	// Analytic gradient of the interpolant
+	if(gradient != NULL)
+	{
+		(*gradient)[0] = ((1 - fz)*((1 - fy)*(c100 - c000) + fy*(c110 - c010)) + fz*((1 - fy)*(c101 - c001) + fy*(c111 - c011)))*this->scale*this->invResolution;
+		(*gradient)[1] = ((1 - fz)*(c10 - c00) + fz*(c11 - c01))*this->scale*this->invResolution;
+		(*gradient)[2] = (c1 - c0)*this->scale*this->invResolution;
+	}
+	
+	
+	return 0;
+}
+
+
+/*
+ * Distance to the nearest obstacle in [m] at a point
+ */
+float LiCAS_SDF::getDistance(const LiCAS_Vector3 & p) const
+{
+	float distance = 0;
+	
+	
+	this->query(p, &distance, NULL);
+	
+	
+	return distance;
+}
+
+
+/*
+ * Clearance of a capsule: minimum distance from its surface to the obstacles. The minimum of the
+ * samples of the axis is reduced by half the sampling step to cover the points between samples.
+ * The interpolation error (up to half the voxel size near the obstacles) has to be covered by
+ * the clearance margin of the application.
+ */
+void LiCAS_SDF::queryCapsule(const LiCAS_CAPSULE & capsule, LiCAS_CLEARANCE * clearance) const
+{
+	LiCAS_Vector3 axis = capsule.p1 - capsule.p0;
+	LiCAS_Vector3 p;
+	float length = norm(axis);
+	float distance = 0;
+	float distanceMin = INFINITY;
+	float sMin = 0;
+	float s = 0;
+	int numSamples = 0;
+	int k = 0;
+	
+	
+	// Samples separated at most by the voxel size
+	numSamples = (int)ceil(length*this->invResolution) + 1;
+	if(numSamples > MAX_CAPSULE_SAMPLES)
+		numSamples = MAX_CAPSULE_SAMPLES;
+	if(numSamples < 2)
+		numSamples = 2;
+	
+	for(k = 0; k < numSamples; k++)
+	{
+		s = (float)k/(numSamples - 1);
+		p = capsule.p0 + s*axis;
+		this->query(p, &distance, NULL);
+		if(distance < distanceMin)
+		{
+			distanceMin = distance;
+			sMin = s;
+		}
+	}
+	
+	clearance->point = capsule.p0 + sMin*axis;
+	this->query(clearance->point, &distance, &clearance->gradient);
+	clearance->distance = distanceMin - capsule.radius - 0.5*length/(numSamples - 1);
+}
+
+
+/*
+ * Clearance of the links of an arm for the given joint positions in [rad]
+ */
+void LiCAS_SDF::queryArm(const LiCAS_ArmKinematics & kinematics, const float q[NUM_ARM_JOINTS], LiCAS_CLEARANCE clearance[NUM_ARM_LINKS]) const
+{
+	LiCAS_CAPSULE capsules[NUM_ARM_LINKS];
+	int k = 0;
+	
+	
+	kinematics.getCapsules(q, capsules);
+	for(k = 0; k < NUM_ARM_LINKS; k++)
+		this->queryCapsule(capsules[k], &clearance[k]);
+}
+
@@ -0,0 +1,189 @@
+/*
+ *
+ * LiCAS Kinematics - LiCAS_SDF.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Distance field of the environment (power lines, structures...) for real-time clearance queries
+ * around the arms. The field is built offline from a point cloud or mesh (see the LiCAS_SDF_Builder
+ * program) into a voxel grid with the distance to the nearest obstacle quantized to 16 bits, and
+ * stored in a file that is memory-mapped at run time: loading is immediate and the queries do not
+ * allocate memory. The distance and its gradient are interpolated trilinearly. The capsules of the
+ * arms are checked sampling their axis at the resolution of the grid. The distance is unsigned
+ * (the obstacles have no interior) and saturated to the maximum distance of the field, which is
+ * also returned outside the grid. All the positions are expressed in the base frame of the arms.
+ *
+ * Example:
+ *
+ * 	LiCAS_SDF sdf;
+ * 	LiCAS_CLEARANCE clearance;
+ *
+ * 	sdf.open("environment.sdf");
+ * 	kinematicsL.getCapsules(qL, capsules);
+ * 	sdf.queryCapsule(capsules[1], &clearance);	// clearance.distance < margin -> stop the arm
+ *
+ */
+
+#ifndef LICAS_SDF_H_
+#define LICAS_SDF_H_
+
+
+// Standard library
+#include <vector>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <math.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+// Specific library
+#include "LiCAS_Matrix.h"
+#include "LiCAS_ArmKinematics.h"
+
+
+// Constant definition
+#define SDF_FILE_MAGIC			0x4644534C	// "LSDF"
+#define SDF_FILE_VERSION		1
+#define MAX_CAPSULE_SAMPLES		32			// Maximum number of samples along the axis of a capsule
+
+
+// Header of the SDF file, followed by the nx*ny*nz distances (uint16, X index first)
+typedef struct
+{
+	uint32_t magic;			// SDF_FILE_MAGIC
+	uint32_t version;		// SDF_FILE_VERSION
+	uint32_t nx;			// Number of voxels along the X axis
+	uint32_t ny;			// Number of voxels along the Y axis
+	uint32_t nz;			// Number of voxels along the Z axis
+	float origin[3];		// Position of the center of the voxel (0, 0, 0) in [m]
+	float resolution;		// Size of the voxels in [m]
+	float maxDistance;		// Saturation distance in [m]
+	float scale;			// Distance of one quantization step in [m]
+	uint32_t numPoints;		// Number of points of the environment used to build the field
+	uint8_t reserved[16];
+} __attribute__((packed)) LiCAS_SDF_HEADER;
+
+
+// Result of a clearance query
+typedef struct
+{
+	float distance;				// Distance from the surface of the capsule to the nearest obstacle in [m]
+	LiCAS_Vector3 point;		// Point of the axis of the capsule closest to the obstacles
+	LiCAS_Vector3 gradient;		// Gradient of the distance at that point (direction away from the obstacles)
+} LiCAS_CLEARANCE;
+
+
+class LiCAS_SDF
+{
+public:
+
+	/*
+	 * Constructor
+	 * */
+	LiCAS_SDF();
+	
+	
+	/*
+	 * Destructor
+	 * */
+	virtual ~LiCAS_SDF();
+	
+	
+	/*
+	 * Build the distance field from a set of points of the surface of the obstacles and save it.
+	 *
+	 * Parameters:
+	 * 	(1) Points of the environment in [m] (base frame of the arms)
+	 * 	(2) Size of the voxels in [m]
+	 * 	(3) Margin added around the bounding box of the points in [m]
+	 * 	(4) Saturation distance in [m]
+	 * 	(5) Name of the SDF file
+	 */
+	static int build(const std::vector<LiCAS_Vector3> & points, float resolution, float margin, float maxDistance, const char * fileName);
+	
+	
+	/*
+	 * Map a SDF file in memory. The pages are loaded and locked (if allowed) to avoid page faults
+	 * during the queries.
+	 */
+	int open(const char * fileName);
+	
+	
+	/*
+	 * Unmap the SDF file
+	 */
+	void close();
+	
+	
+	/*
+	 * Returns 1 if a SDF file is mapped
+	 */
+	int isOpen() const;
+	
+	
+	/*
+	 * Header of the mapped SDF file
+	 */
+	const LiCAS_SDF_HEADER * getHeader() const;
+	
+	
+	/*
+	 * Distance to the nearest obstacle in [m] and its gradient at a point. Returns 0 if the point is
+	 * inside the grid, or 1 otherwise (distance saturated, null gradient).
+	 */
+	int query(const LiCAS_Vector3 & p, float * distance, LiCAS_Vector3 * gradient) const;
+	
+	
+	/*
+	 * Distance to the nearest obstacle in [m] at a point
+	 */
+	float getDistance(const LiCAS_Vector3 & p) const;
+	
+	
+	/*
+	 * Clearance of a capsule: minimum distance from its surface to the obstacles. The minimum of the
+	 * samples of the axis is reduced by half the sampling step to cover the points between samples.
+	 * The interpolation error (up to half the voxel size near the obstacles) has to be covered by
+	 * the clearance margin of the application.
+	 */
+	void queryCapsule(const LiCAS_CAPSULE & capsule, LiCAS_CLEARANCE * clearance) const;
+	
+	
+	/*
+	 * Clearance of the links of an arm for the given joint positions in [rad]
+	 */
+	void queryArm(const LiCAS_ArmKinematics & kinematics, const float q[NUM_ARM_JOINTS], LiCAS_CLEARANCE clearance[NUM_ARM_LINKS]) const;
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	void * mapAddress;
+	size_t mapSize;
+	
+	const LiCAS_SDF_HEADER * header;
+	const uint16_t * grid;
+	
+	// Copy of the header fields used by the queries
+	int nx;
+	int ny;
+	int nz;
+	float origin[3];
+	float invResolution;
+	float scale;
+	float maxDistance;
+};
+
+#endif
+
@@ -0,0 +1,198 @@
+/*
+ *
+ * LiCAS Kinematics - SDF_Builder.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Offline builder of the distance field of the environment (LiCAS_SDF). The input is a point cloud
+ * in text format (.xyz, .txt: one point per line, "x y z" in [m], additional columns ignored) or a
+ * Wavefront mesh (.obj: vertices and polygonal faces, sampled at half the voxel size). The points
+ * are expressed in the base frame of the arms.
+ *
+ * Usage: ./LiCAS_SDF_Builder input.(xyz|txt|obj) output.sdf resolution [margin] [maxDistance]
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <string>
+
+
+// Specific library
+#include "LiCAS_SDF.h"
+
+
+/*
+ * Read a point cloud in text format
+ */
+static int loadPointCloud(const char * fileName, std::vector<LiCAS_Vector3> & points)
+{
+	LiCAS_Vector3 p;
+	FILE * inputFile = NULL;
+	char line[512];
+	int errorCode = 0;
+	
+	
+	inputFile = fopen(fileName, "r");
+	if(inputFile == NULL)
+		errorCode = 1;
+	else
+	{
+		while(fgets(line, sizeof(line), inputFile) != NULL)
+		{
+			if(sscanf(line, "%f %f %f", &p[0], &p[1], &p[2]) == 3 || sscanf(line, "%f,%f,%f", &p[0], &p[1], &p[2]) == 3)
+				points.push_back(p);
+		}
+		fclose(inputFile);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Sample the surface of a triangle with a maximum spacing
+ */
+static void sampleTriangle(const LiCAS_Vector3 & a, const LiCAS_Vector3 & b, const LiCAS_Vector3 & c, float spacing, std::vector<LiCAS_Vector3> & points)
+{
+	float edge = fmax(norm(b - a), fmax(norm(c - a), norm(c - b)));
+	int n = (int)ceil(edge/spacing);
+	int i = 0;
+	int j = 0;
+	
+	
+	if(n < 1)
+		n = 1;
+	for(i = 0; i <= n; i++)
+	{
+		for(j = 0; i + j <= n; j++)
+			points.push_back(a + ((float)i/n)*(b - a) + ((float)j/n)*(c - a));
+	}
+}
+
+
+/*
+ * Read a Wavefront mesh and sample its faces
+ */
+static int loadMesh(const char * fileName, float spacing, std::vector<LiCAS_Vector3> & points)
+{
+	std::vector<LiCAS_Vector3> vertices;
+	std::vector<int> face;
+	LiCAS_Vector3 v;
+	FILE * inputFile = NULL;
+	char line[1024];
+	char * token = NULL;
+	char * context = NULL;
+	int index = 0;
+	int errorCode = 0;
+	size_t k = 0;
+	
+	
+	inputFile = fopen(fileName, "r");
+	if(inputFile == NULL)
+		errorCode = 1;
+	else
+	{
+		while(fgets(line, sizeof(line), inputFile) != NULL)
+		{
+			if(strncmp(line, "v ", 2) == 0 && sscanf(line + 2, "%f %f %f", &v[0], &v[1], &v[2]) == 3)
+				vertices.push_back(v);
+			else if(strncmp(line, "f ", 2) == 0)
+			{
+				// Vertex indexes of the face ("i", "i/t", "i/t/n" or "i//n", negative: relative)
+				face.clear();
+				token = strtok_r(line + 2, " \t\r\n", &context);
+				while(token != NULL)
+				{
+					index = atoi(token);
+					index = (index < 0) ? (int)vertices.size() + index : index - 1;
+					if(index >= 0 && index < (int)vertices.size())
+						face.push_back(index);
+					token = strtok_r(NULL, " \t\r\n", &context);
+				}
+				
+				// Triangle fan
+				for(k = 2; k < face.size(); k++)
+					sampleTriangle(vertices[face[0]], vertices[face[k - 1]], vertices[face[k]], spacing, points);
+			}
+		}
+		fclose(inputFile);
+		
+		// Mesh without faces: use the vertices as point cloud
+		if(points.size() == 0)
+			points = vertices;
+	}
+	
+	
+	return errorCode;
+}
+
+
+int main(int argc, char ** argv)
+{
+	std::vector<LiCAS_Vector3> points;
+	LiCAS_SDF sdf;
+	std::string inputFileName;
+	float resolution = 0;
+	float margin = 0.5;
+	float maxDistance = 1.0;
+	int errorCode = 0;
+	
+	
+	if(argc < 4)
+	{
+		printf("Usage: ./LiCAS_SDF_Builder input.(xyz|txt|obj) output.sdf resolution [margin] [maxDistance]\n");
+		printf("\tresolution: voxel size in [m]\n");
+		printf("\tmargin: space around the points in [m] (default: 0.5)\n");
+		printf("\tmaxDistance: saturation distance in [m] (default: 1.0)\n");
+		return 1;
+	}
+	
+	inputFileName = argv[1];
+	resolution = atof(argv[3]);
+	if(argc > 4)
+		margin = atof(argv[4]);
+	if(argc > 5)
+		maxDistance = atof(argv[5]);
+	
+	if(inputFileName.size() > 4 && inputFileName.compare(inputFileName.size() - 4, 4, ".obj") == 0)
+		errorCode = loadMesh(argv[1], 0.5*resolution, points);
+	else
+		errorCode = loadPointCloud(argv[1], points);
+	
+	if(errorCode != 0 || points.size() == 0)
+	{
+		printf("ERROR [in main]: could not read points from %s\n", argv[1]);
+		return 1;
+	}
+	printf("Points: %zu\n", points.size());
+	
+	errorCode = LiCAS_SDF::build(points, resolution, margin, maxDistance, argv[2]);
+	if(errorCode == 2)
+		printf("ERROR [in main]: grid too large, increase the resolution or reduce the margin\n");
+	else if(errorCode != 0)
+		printf("ERROR [in main]: could not write %s\n", argv[2]);
+	else if(sdf.open(argv[2]) == 0)
+	{
+		printf("Grid: %u x %u x %u voxels of %.3f [m] (%.1f MB)\n", sdf.getHeader()->nx, sdf.getHeader()->ny, sdf.getHeader()->nz,
+				sdf.getHeader()->resolution, 2e-6*sdf.getHeader()->nx*sdf.getHeader()->ny*sdf.getHeader()->nz);
+		printf("Origin: {%.3f, %.3f, %.3f} [m]\n", sdf.getHeader()->origin[0], sdf.getHeader()->origin[1], sdf.getHeader()->origin[2]);
+	}
+	
+	
+	return errorCode;
+}
+
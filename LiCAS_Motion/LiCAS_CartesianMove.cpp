@@ -0,0 +1,416 @@
+/*
+ *
+ * LiCAS Motion - LiCAS_CartesianMove.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * The cycle k of the motion corresponds to the time t = k*period (the last one is clamped to the
+ * duration). The distance travelled along the longest path follows the trapezoidal profile, and
+ * the paths of both arms are evaluated at the same fraction of their length.
+ *
+ */
+
+#include "LiCAS_CartesianMove.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_CartesianMove::LiCAS_CartesianMove(const LiCAS_ArmKinematics & _kinematicsL, const LiCAS_ArmKinematics & _kinematicsR)
+	: kinematicsL(_kinematicsL), kinematicsR(_kinematicsR)
+{
+	int k = 0;
+	
+	
+	this->parameters = getDefaultParameters();
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		this->qL_cycle[k] = 0;
+		this->qR_cycle[k] = 0;
+	}
+	this->pathL.type = MOVE_PATH_HOLD;
+	this->pathR.type = MOVE_PATH_HOLD;
+	this->length = 0;
+	this->duration = 0;
+	this->accelerationTime = 0;
+	this->cruiseSpeed = 0;
+	this->numCycles = 0;
+	this->cycle = 0;
+	this->flagPlanned = 0;
+	this->failureTime = 0;
+}
+
+
+/*
+ * Default parameters: 0.1 m/s, 0.5 m/s^2, 500 Hz, 3 rad/s
+ */
+LiCAS_MOVE_PARAMETERS LiCAS_CartesianMove::getDefaultParameters()
+{
+	LiCAS_MOVE_PARAMETERS defaultParameters;
+	
+	
+	defaultParameters.speed = 0.1;
+	defaultParameters.acceleration = 0.5;
+	defaultParameters.period = 0.002;
+	defaultParameters.maxJointSpeed = 3.0;
+	
+	
+	return defaultParameters;
+}
+
+
+/*
+ * Set the parameters of the next motions. Returns 0 if the parameters are valid, or 1 otherwise.
+ */
+int LiCAS_CartesianMove::setParameters(const LiCAS_MOVE_PARAMETERS & _parameters)
+{
+	int errorCode = 0;
+	
+	
+	if(_parameters.speed > 0 && _parameters.acceleration > 0 && _parameters.period > 0 && _parameters.maxJointSpeed > 0)
+		this->parameters = _parameters;
+	else
+		errorCode = 1;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Plan and validate a linear motion of the TCP. Returns 0 if the motion is valid, 1 if the paths
+ * are not valid, 2 if the inverse kinematics fails (unreachable point) or 3 if the joint speed
+ * limit is exceeded (singularity). The failure time is available with getFailureTime().
+ *
+ * Parameters:
+ * 	(1) Current joint positions of the left arm in [rad]
+ * 	(2) Current joint positions of the right arm in [rad]
+ * 	(3) Target TCP position of the left arm in [m] (NULL: the arm holds its position)
+ * 	(4) Target TCP position of the right arm in [m] (NULL: the arm holds its position)
+ */
+int LiCAS_CartesianMove::moveL(const float qL[NUM_ARM_JOINTS], const float qR[NUM_ARM_JOINTS], const LiCAS_Vector3 * pL, const LiCAS_Vector3 * pR)
+{
+	int errorCode = 0;
+	
+	
+	this->flagPlanned = 0;
+	if(this->setLinearPath(&this->pathL, this->kinematicsL.getTCPPosition(qL), pL) != 0 ||
+			this->setLinearPath(&this->pathR, this->kinematicsR.getTCPPosition(qR), pR) != 0)
+		errorCode = 1;
+	else
+		errorCode = this->plan(qL, qR);
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Plan and validate a circular motion of the TCP along the arc from the current position through
+ * an intermediate point to the target. The return values are those of moveL().
+ *
+ * Parameters:
+ * 	(1) Current joint positions of the left arm in [rad]
+ * 	(2) Current joint positions of the right arm in [rad]
+ * 	(3) Intermediate TCP position of the left arm in [m] (NULL: the arm holds its position)
+ * 	(4) Target TCP position of the left arm in [m]
+ * 	(5) Intermediate TCP position of the right arm in [m] (NULL: the arm holds its position)
+ * 	(6) Target TCP position of the right arm in [m]
+ */
+int LiCAS_CartesianMove::moveC(const float qL[NUM_ARM_JOINTS], const float qR[NUM_ARM_JOINTS], const LiCAS_Vector3 * viaL, const LiCAS_Vector3 * pL,
+		const LiCAS_Vector3 * viaR, const LiCAS_Vector3 * pR)
+{
+	int errorCode = 0;
+	
+	
+	this->flagPlanned = 0;
+	if(this->setCircularPath(&this->pathL, this->kinematicsL.getTCPPosition(qL), viaL, pL) != 0 ||
+			this->setCircularPath(&this->pathR, this->kinematicsR.getTCPPosition(qR), viaR, pR) != 0)
+		errorCode = 1;
+	else
+		errorCode = this->plan(qL, qR);
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Joint position references of the next cycle of the planned motion. Returns 1 while the motion
+ * is in progress, or 0 when the end has been reached.
+ */
+int LiCAS_CartesianMove::update(float qL[NUM_ARM_JOINTS], float qR[NUM_ARM_JOINTS])
+{
+	int k = 0;
+	
+	
+	if(this->flagPlanned != 0 && this->cycle < this->numCycles)
+	{
+		this->cycle++;
+		this->computeCycle(this->cycle, this->qL_cycle, this->qR_cycle);
+	}
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		qL[k] = this->qL_cycle[k];
+		qR[k] = this->qR_cycle[k];
+	}
+	
+	
+	return (this->flagPlanned != 0 && this->cycle < this->numCycles) ? 1 : 0;
+}
+
+
+/*
+ * Stream the planned motion through the interface at the streaming period (blocking call).
+ * Returns 0 at the end of the motion, or 1 if a reference could not be sent.
+ */
+int LiCAS_CartesianMove::execute(LiCAS_ECI_UDP * licas_eci)
+{
+	struct timespec t_next;
+	float qL[NUM_ARM_JOINTS];
+	float qR[NUM_ARM_JOINTS];
+	long periodNs = (long)(1e9*this->parameters.period);
+	int flagMoving = 1;
+	int errorCode = 0;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &t_next);
+	while(flagMoving == 1 && errorCode == 0)
+	{
+		flagMoving = this->update(qL, qR);
+		if(licas_eci->sendJointPositionRef(qL, qR, this->parameters.period) != 0)
+			errorCode = 1;
+		
+		// Absolute wake-up time of the next cycle (no drift)
+		t_next.tv_nsec += periodNs;
+		while(t_next.tv_nsec >= 1000000000)
+		{
+			t_next.tv_nsec -= 1000000000;
+			t_next.tv_sec++;
+		}
+		if(flagMoving == 1)
+			clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t_next, NULL);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Duration of the planned motion in [s]
+ */
+float LiCAS_CartesianMove::getDuration() const
+{
+	return this->duration;
+}
+
+
+/*
+ * Time along the motion of the validation failure in [s]
+ */
+float LiCAS_CartesianMove::getFailureTime() const
+{
+	return this->failureTime;
+}
+
+
+/*
+ * Linear path from the current TCP position to the target (hold if the target is NULL)
+ */
+int LiCAS_CartesianMove::setLinearPath(LiCAS_TCP_PATH * path, const LiCAS_Vector3 & p0, const LiCAS_Vector3 * p1)
+{
+	path->type = (p1 != NULL) ? MOVE_PATH_LINEAR : MOVE_PATH_HOLD;
+	path->p0 = p0;
+	path->p1 = (p1 != NULL) ? *p1 : p0;
+	path->length = norm(path->p1 - path->p0);
+	
+	
+	return 0;
+}
+
+
+/*
+ * Arc from the current TCP position through the intermediate point to the target (hold if the
+ * intermediate point is NULL). Returns 1 if the points are aligned or coincident.
+ */
+int LiCAS_CartesianMove::setCircularPath(LiCAS_TCP_PATH * path, const LiCAS_Vector3 & p0, const LiCAS_Vector3 * via, const LiCAS_Vector3 * p1)
+{
+	LiCAS_Vector3 a;
+	LiCAS_Vector3 b;
+	LiCAS_Vector3 n;
+	LiCAS_Vector3 r;
+	float n2 = 0;
+	int errorCode = 0;
+	
+	
+	path->type = MOVE_PATH_HOLD;
+	path->p0 = p0;
+	path->p1 = p0;
+	path->length = 0;
+	if(via != NULL && p1 != NULL)
+	{
+		// Circumcenter of the triangle (p0, via, p1)
+		a = *via - p0;
+		b = *p1 - p0;
+		n = cross(a, b);
+		n2 = dot(n, n);
+		if(n2 < 1e-12 || norm(a) < 1e-4 || norm(b) < 1e-4)
+			errorCode = 1;
+		else
+		{
+			path->type = MOVE_PATH_CIRCULAR;
+			path->p1 = *p1;
+			path->center = p0 + (0.5f/n2)*cross(dot(a, a)*b - dot(b, b)*a, n);
+			r = p0 - path->center;
+			path->radius = norm(r);
+			path->e1 = (1.0f/path->radius)*r;
+			path->e2 = cross((1.0f/sqrt(n2))*n, path->e1);
+			
+			// Positive rotation about n from p0 reaches the intermediate point before the target
+			r = *p1 - path->center;
+			path->angle = atan2(dot(r, path->e2), dot(r, path->e1));
+			if(path->angle <= 0)
+				path->angle += 2*M_PI;
+			path->length = path->radius*path->angle;
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Trapezoidal profile along the longest path and validation of all the cycles of the motion
+ */
+int LiCAS_CartesianMove::plan(const float qL[NUM_ARM_JOINTS], const float qR[NUM_ARM_JOINTS])
+{
+	float qL_prev[NUM_ARM_JOINTS];
+	float qR_prev[NUM_ARM_JOINTS];
+	float maxStep = this->parameters.maxJointSpeed*this->parameters.period;
+	float v = this->parameters.speed;
+	float a = this->parameters.acceleration;
+	int errorCode = 0;
+	int k = 0;
+	int j = 0;
+	
+	
+	this->length = fmax(this->pathL.length, this->pathR.length);
+	if(this->length < 1e-6)
+		errorCode = 1;
+	else
+	{
+		// Triangular profile if the cruise speed is not reached
+		if(this->length < v*v/a)
+			v = sqrt(this->length*a);
+		this->cruiseSpeed = v;
+		this->accelerationTime = v/a;
+		this->duration = this->length/v + v/a;
+		this->numCycles = (int)ceil(this->duration/this->parameters.period);
+		
+		// Validation: inverse kinematics of every cycle, warm started as in the execution
+		this->failureTime = 0;
+		for(j = 0; j < NUM_ARM_JOINTS; j++)
+		{
+			qL_prev[j] = qL[j];
+			qR_prev[j] = qR[j];
+			this->qL_cycle[j] = qL[j];
+			this->qR_cycle[j] = qR[j];
+		}
+		for(k = 1; k <= this->numCycles && errorCode == 0; k++)
+		{
+			if(this->computeCycle(k, this->qL_cycle, this->qR_cycle) != 0)
+				errorCode = 2;
+			for(j = 0; j < NUM_ARM_JOINTS && errorCode == 0; j++)
+			{
+				if(fabs(this->qL_cycle[j] - qL_prev[j]) > maxStep || fabs(this->qR_cycle[j] - qR_prev[j]) > maxStep)
+					errorCode = 3;
+			}
+			for(j = 0; j < NUM_ARM_JOINTS; j++)
+			{
+				qL_prev[j] = this->qL_cycle[j];
+				qR_prev[j] = this->qR_cycle[j];
+			}
+			if(errorCode != 0)
+				this->failureTime = fmin(k*this->parameters.period, this->duration);
+		}
+		
+		// Start of the execution
+		for(j = 0; j < NUM_ARM_JOINTS; j++)
+		{
+			this->qL_cycle[j] = qL[j];
+			this->qR_cycle[j] = qR[j];
+		}
+		this->cycle = 0;
+		this->flagPlanned = (errorCode == 0) ? 1 : 0;
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Point of the path at a fraction of its length
+ */
+LiCAS_Vector3 LiCAS_CartesianMove::getPathPoint(const LiCAS_TCP_PATH & path, float s) const
+{
+	LiCAS_Vector3 p;
+	float angle = 0;
+	
+	
+	if(path.type == MOVE_PATH_LINEAR)
+		p = path.p0 + s*(path.p1 - path.p0);
+	else if(path.type == MOVE_PATH_CIRCULAR)
+	{
+		angle = s*path.angle;
+		p = path.center + (path.radius*(float)cos(angle))*path.e1 + (path.radius*(float)sin(angle))*path.e2;
+	}
+	else
+		p = path.p0;
+	
+	
+	return p;
+}
+
+
+/*
+ * Joint positions of the cycle k, solving the inverse kinematics from the joint positions of the
+ * previous cycle (input/output arrays). Returns 1 if the inverse kinematics of an arm fails.
+ */
+int LiCAS_CartesianMove::computeCycle(int k, float qL[NUM_ARM_JOINTS], float qR[NUM_ARM_JOINTS])
+{
+	float t = fmin(k*this->parameters.period, this->duration);
+	float td = this->duration - this->accelerationTime;
+	float a = this->parameters.acceleration;
+	float distance = 0;
+	float s = 0;
+	int errorCode = 0;
+	
+	
+	// Distance along the longest path
+	if(t < this->accelerationTime)
+		distance = 0.5*a*t*t;
+	else if(t < td)
+		distance = this->cruiseSpeed*(t - 0.5*this->accelerationTime);
+	else
+		distance = this->length - 0.5*a*(this->duration - t)*(this->duration - t);
+	s = (k >= this->numCycles) ? 1 : fmin(distance/this->length, 1);
+	
+	if(this->pathL.type != MOVE_PATH_HOLD && this->kinematicsL.inverseKinematics(this->getPathPoint(this->pathL, s), qL, qL, NULL) != 0)
+		errorCode = 1;
+	if(this->pathR.type != MOVE_PATH_HOLD && this->kinematicsR.inverseKinematics(this->getPathPoint(this->pathR, s), qR, qR, NULL) != 0)
+		errorCode = 1;
+	
+	
+	return errorCode;
+}
+
@@ -0,0 +1,198 @@
+/*
+ *
+ * LiCAS Motion - LiCAS_CartesianMove.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Linear (MoveL) and circular (MoveC) motions of the TCP of both arms at a controlled speed. The
+ * path of the TCP is interpolated on the client at the streaming rate, the inverse kinematics of
+ * each arm is solved in every cycle starting from the solution of the previous cycle, and the
+ * joint position references are streamed to the LiCAS control program, so the path followed by
+ * the TCP does not depend on the interpolation of the board. The motion of both arms is
+ * synchronized with a trapezoidal speed profile along the longest path.
+ *
+ * The whole motion is validated when it is planned, before sending any reference: the inverse
+ * kinematics has to converge in every cycle (reachable path) and the joint speeds must be below
+ * the limit (no singularities along the path). The streaming repeats the same computations, so
+ * the executed references are the validated ones. The TCP positions are expressed in the base
+ * frame of the arms (LiCAS_ArmKinematics).
+ *
+ * Example:
+ *
+ * 	LiCAS_CartesianMove move(kinematicsL, kinematicsR);
+ *
+ * 	if(move.moveL(licas_eci->qL, licas_eci->qR, &pL, NULL) == 0)	// The right arm holds its position
+ * 		move.execute(licas_eci);
+ *
+ */
+
+#ifndef LICAS_CARTESIAN_MOVE_H_
+#define LICAS_CARTESIAN_MOVE_H_
+
+
+// Standard library
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "../LiCAS_Kinematics/LiCAS_ArmKinematics.h"
+
+
+// Types of path
+#define MOVE_PATH_HOLD			0		// The TCP holds its position
+#define MOVE_PATH_LINEAR		1
+#define MOVE_PATH_CIRCULAR		2
+
+
+// Parameters of the Cartesian motions
+typedef struct
+{
+	float speed;				// Speed of the TCP along the path in [m/s]
+	float acceleration;			// Acceleration of the TCP along the path in [m/s^2]
+	float period;				// Streaming period in [s]
+	float maxJointSpeed;		// Maximum joint speed allowed along the path in [rad/s]
+} LiCAS_MOVE_PARAMETERS;
+
+
+// Path of the TCP of an arm
+typedef struct
+{
+	int type;					// MOVE_PATH_HOLD, MOVE_PATH_LINEAR or MOVE_PATH_CIRCULAR
+	LiCAS_Vector3 p0;			// Start point
+	LiCAS_Vector3 p1;			// End point
+	LiCAS_Vector3 center;		// Center of the arc
+	LiCAS_Vector3 e1;			// Unit vector from the center to the start point
+	LiCAS_Vector3 e2;			// Unit vector of the plane of the arc, orthogonal to e1
+	float radius;				// Radius of the arc in [m]
+	float angle;				// Angle of the arc in [rad]
+	float length;				// Length of the path in [m]
+} LiCAS_TCP_PATH;
+
+
+class LiCAS_CartesianMove
+{
+public:
+
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Kinematics of the left arm
+	 * 	(2) Kinematics of the right arm
+	 * */
+	LiCAS_CartesianMove(const LiCAS_ArmKinematics & _kinematicsL, const LiCAS_ArmKinematics & _kinematicsR);
+	
+	
+	/*
+	 * Default parameters: 0.1 m/s, 0.5 m/s^2, 500 Hz, 3 rad/s
+	 */
+	static LiCAS_MOVE_PARAMETERS getDefaultParameters();
+	
+	
+	/*
+	 * Set the parameters of the next motions. Returns 0 if the parameters are valid, or 1 otherwise.
+	 */
+	int setParameters(const LiCAS_MOVE_PARAMETERS & _parameters);
+	
+	
+	/*
+	 * Plan and validate a linear motion of the TCP. Returns 0 if the motion is valid, 1 if the paths
+	 * are not valid, 2 if the inverse kinematics fails (unreachable point) or 3 if the joint speed
+	 * limit is exceeded (singularity). The failure time is available with getFailureTime().
+	 *
+	 * Parameters:
+	 * 	(1) Current joint positions of the left arm in [rad]
+	 * 	(2) Current joint positions of the right arm in [rad]
+	 * 	(3) Target TCP position of the left arm in [m] (NULL: the arm holds its position)
+	 * 	(4) Target TCP position of the right arm in [m] (NULL: the arm holds its position)
+	 */
+	int moveL(const float qL[NUM_ARM_JOINTS], const float qR[NUM_ARM_JOINTS], const LiCAS_Vector3 * pL, const LiCAS_Vector3 * pR);
+	
+	
+	/*
+	 * Plan and validate a circular motion of the TCP along the arc from the current position through
+	 * an intermediate point to the target. The return values are those of moveL().
+	 *
+	 * Parameters:
+	 * 	(1) Current joint positions of the left arm in [rad]
+	 * 	(2) Current joint positions of the right arm in [rad]
+	 * 	(3) Intermediate TCP position of the left arm in [m] (NULL: the arm holds its position)
+	 * 	(4) Target TCP position of the left arm in [m]
+	 * 	(5) Intermediate TCP position of the right arm in [m] (NULL: the arm holds its position)
+	 * 	(6) Target TCP position of the right arm in [m]
+	 */
+	int moveC(const float qL[NUM_ARM_JOINTS], const float qR[NUM_ARM_JOINTS], const LiCAS_Vector3 * viaL, const LiCAS_Vector3 * pL,
+			const LiCAS_Vector3 * viaR, const LiCAS_Vector3 * pR);
+	
+	
+	/*
+	 * Joint position references of the next cycle of the planned motion. Returns 1 while the motion
+	 * is in progress, or 0 when the end has been reached.
+	 */
+	int update(float qL[NUM_ARM_JOINTS], float qR[NUM_ARM_JOINTS]);
+	
+	
+	/*
+	 * Stream the planned motion through the interface at the streaming period (blocking call).
+	 * Returns 0 at the end of the motion, or 1 if a reference could not be sent.
+	 */
+	int execute(LiCAS_ECI_UDP * licas_eci);
+	
+	
+	/*
+	 * Duration of the planned motion in [s]
+	 */
+	float getDuration() const;
+	
+	
+	/*
+	 * Time along the motion of the validation failure in [s]
+	 */
+	float getFailureTime() const;
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	const LiCAS_ArmKinematics & kinematicsL;
+	const LiCAS_ArmKinematics & kinematicsR;
+	LiCAS_MOVE_PARAMETERS parameters;
+	
+	// Planned motion
+	LiCAS_TCP_PATH pathL;
+	LiCAS_TCP_PATH pathR;
+	float qL_cycle[NUM_ARM_JOINTS];			// Joint positions of the last cycle (seed of the inverse kinematics)
+	float qR_cycle[NUM_ARM_JOINTS];
+	float length;							// Length of the longest path in [m]
+	float duration;
+	float accelerationTime;
+	float cruiseSpeed;
+	int numCycles;
+	int cycle;
+	int flagPlanned;
+	float failureTime;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	int setLinearPath(LiCAS_TCP_PATH * path, const LiCAS_Vector3 & p0, const LiCAS_Vector3 * p1);
+	
+	int setCircularPath(LiCAS_TCP_PATH * path, const LiCAS_Vector3 & p0, const LiCAS_Vector3 * via, const LiCAS_Vector3 * p1);
+	
+	int plan(const float qL[NUM_ARM_JOINTS], const float qR[NUM_ARM_JOINTS]);
+	
+	LiCAS_Vector3 getPathPoint(const LiCAS_TCP_PATH & path, float s) const;
+	
+	int computeCycle(int k, float qL[NUM_ARM_JOINTS], float qR[NUM_ARM_JOINTS]);
+};
+
+#endif
+
@@ -0,0 +1,603 @@
+/*
+ *
+ * LiCAS Motion - LiCAS_FloatingBase.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * The lookups by time are binary searches over the last half of the histories, so the samples read
+ * are not overwritten by the writer during the search. The orientation is interpolated linearly
+ * and normalized (the samples are close in time), and extrapolated with the angular velocity of
+ * the last sample: q(t + dt) = q(t)*exp(w*dt/2).
+ *
+ */
+
+#include "LiCAS_FloatingBase.h"
+
+
+/*
+ * Normalize a quaternion. Returns its norm.
+ */
+static float normalizeQuaternion(float q[4])
+{
+	float norm = sqrtf(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+	int k = 0;
+	
+	
+	if(norm > 1e-6)
+	{
+		for(k = 0; k < 4; k++)
+			q[k] /= norm;
+	}
+	
+	
+	return norm;
+}
+
+
+/*
+ * Rotation of the base frame w.r.t. the world frame for the given pose
+ */
+static LiCAS_Transform getPoseTransform(const LiCAS_BASE_POSE & pose)
+{
+	LiCAS_Transform T = LiCAS_Transform::identity();
+	float w = pose.orientation[0];
+	float x = pose.orientation[1];
+	float y = pose.orientation[2];
+	float z = pose.orientation[3];
+	int k = 0;
+	
+	
+	T(0, 0) = 1 - 2*(y*y + z*z);
+	T(0, 1) = 2*(x*y - w*z);
+	T(0, 2) = 2*(x*z + w*y);
+	T(1, 0) = 2*(x*y + w*z);
+	T(1, 1) = 1 - 2*(x*x + z*z);
+	T(1, 2) = 2*(y*z - w*x);
+	T(2, 0) = 2*(x*z - w*y);
+	T(2, 1) = 2*(y*z + w*x);
+	T(2, 2) = 1 - 2*(x*x + y*y);
+	for(k = 0; k < 3; k++)
+		T(k, 3) = pose.position[k];
+	
+	
+	return T;
+}
+
+
+/*
+ * Constructor
+ *
+ * Parameters:
+ * 	(1) Pose of the frame of the arms in the frame of the base (IMU/odometry)
+ * */
+LiCAS_FloatingBase::LiCAS_FloatingBase(const LiCAS_Transform & _T_base_arms)
+{
+	int k = 0;
+	
+	
+	this->T_base_arms = _T_base_arms;
+	this->UDP_RxPort = -1;
+	this->socketReceiver = -1;
+	this->flagTerminateThread = 0;
+	this->numBasePosePackets = 0;
+	this->numDiscardedPackets = 0;
+	this->lastSequence = 0;
+	this->lastPoseTime = 0;
+	this->latency = 0;
+	this->feedbackDelay = 0;
+	this->flagEstimateLatency = 0;
+	this->latencyEstimate = -1;
+	for(k = 0; k < BASE_LATENCY_CANDIDATES; k++)
+		this->latencyError[k] = -1;
+	this->pLworldFeedback = LiCAS_Vector3::zeros();
+	this->pRworldFeedback = LiCAS_Vector3::zeros();
+}
+
+
+/*
+ * Destructor
+ * */
+LiCAS_FloatingBase::~LiCAS_FloatingBase()
+{
+	if(this->socketReceiver >= 0)
+		this->closeBasePoseChannel();
+}
+
+
+/*
+ * Open the UDP port of the base pose data packets and start the reception thread
+ *
+ * Parameters:
+ * 	(1) UDP port for receiving the base pose data packets
+ */
+int LiCAS_FloatingBase::openBasePoseChannel(int _UDP_RxPort)
+{
+	struct sockaddr_in addrReceiver;
+	int errorCode = 0;
+	
+	
+	this->socketReceiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	bzero((char*)&addrReceiver, sizeof(struct sockaddr_in));
+	addrReceiver.sin_family = AF_INET;
+	addrReceiver.sin_addr.s_addr = INADDR_ANY;
+	addrReceiver.sin_port = htons(_UDP_RxPort);
+	if(this->socketReceiver < 0 || bind(this->socketReceiver, (struct sockaddr*)&addrReceiver, sizeof(addrReceiver)) < 0)
+	{
+		errorCode = 1;
+		if(this->socketReceiver >= 0)
+			close(this->socketReceiver);
+		this->socketReceiver = -1;
+		printf("ERROR: [in LiCAS_FloatingBase::openBasePoseChannel] could not associate address to socket.\n");
+	}
+	else
+	{
+		fcntl(this->socketReceiver, F_SETFL, O_NONBLOCK);
+		this->UDP_RxPort = _UDP_RxPort;
+		this->flagTerminateThread = 0;
+		pthread_create(&this->basePoseThread, NULL, &LiCAS_FloatingBase::basePoseThreadEntry, this);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Stop the reception thread and close the UDP port
+ */
+int LiCAS_FloatingBase::closeBasePoseChannel()
+{
+	int errorCode = 0;
+	
+	
+	if(this->socketReceiver >= 0)
+	{
+		this->flagTerminateThread = 1;
+		pthread_join(this->basePoseThread, NULL);
+		close(this->socketReceiver);
+		this->socketReceiver = -1;
+	}
+	else
+		errorCode = 1;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Configure the latency of the references
+ *
+ * Parameters:
+ * 	(1) Latency in [s], used until it is estimated (or always if the estimation is disabled)
+ * 	(2) Enable (1) or disable (0) the estimation of the latency from the feedback history
+ * 	(3) Delay of the feedback from the arms to the interface in [s]
+ */
+void LiCAS_FloatingBase::setLatency(float _latency, int _flagEstimateLatency, float _feedbackDelay)
+{
+	int k = 0;
+	
+	
+	this->latency = _latency;
+	this->feedbackDelay = _feedbackDelay;
+	this->latencyEstimate = -1;
+	for(k = 0; k < BASE_LATENCY_CANDIDATES; k++)
+		this->latencyError[k] = -1;
+	this->flagEstimateLatency = _flagEstimateLatency;
+}
+
+
+/*
+ * Latency of the references in [s] (estimated or fixed)
+ */
+float LiCAS_FloatingBase::getLatency() const
+{
+	float estimate = this->latencyEstimate;
+	
+	
+	return (this->flagEstimateLatency != 0 && estimate >= 0) ? estimate : this->latency;
+}
+
+
+/*
+ * Pose of the base at a given time, interpolated from the history or extrapolated from the last sample
+ */
+int LiCAS_FloatingBase::getBasePose(double t, LiCAS_BASE_POSE * pose) const
+{
+	LiCAS_BASE_POSE before;
+	LiCAS_BASE_POSE after;
+	LiCAS_BASE_POSE sample;
+	float q[4];
+	float dq[4];
+	uint64_t count = this->basePoseHistory.getCount();
+	uint64_t lo = 0;
+	uint64_t hi = 0;
+	uint64_t mid = 0;
+	float w = 0;
+	float angle = 0;
+	float s = 0;
+	float dt = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	if(count == 0 || this->basePoseHistory.get(count - 1, &after) != 0)
+		return 1;
+	
+	// Extrapolation from the last sample
+	if(t >= after.t)
+	{
+		dt = t - after.t;
+		if(dt > BASE_MAX_PREDICTION)
+		{
+			dt = BASE_MAX_PREDICTION;
+			errorCode = 3;
+		}
+		*pose = after;
+		pose->t = t;
+		pose->position += dt*after.velocity;
+		w = norm(after.angularVelocity);
+		angle = 0.5*w*dt;
+		dq[0] = cosf(angle);
+		for(k = 0; k < 3; k++)
+			dq[1 + k] = (w > 1e-9) ? sinf(angle)*after.angularVelocity[k]/w : 0;
+		q[0] = after.orientation[0]*dq[0] - after.orientation[1]*dq[1] - after.orientation[2]*dq[2] - after.orientation[3]*dq[3];
+		q[1] = after.orientation[0]*dq[1] + after.orientation[1]*dq[0] + after.orientation[2]*dq[3] - after.orientation[3]*dq[2];
+		q[2] = after.orientation[0]*dq[2] - after.orientation[1]*dq[3] + after.orientation[2]*dq[0] + after.orientation[3]*dq[1];
+		q[3] = after.orientation[0]*dq[3] + after.orientation[1]*dq[2] - after.orientation[2]*dq[1] + after.orientation[3]*dq[0];
+		normalizeQuaternion(q);
+		for(k = 0; k < 4; k++)
+			pose->orientation[k] = q[k];
+		return errorCode;
+	}
+	
+	// Oldest sample of the search
+	hi = count - 1;
+	lo = (count > BASE_POSE_HISTORY_SIZE/2) ? count - BASE_POSE_HISTORY_SIZE/2 : 0;
+	if(this->basePoseHistory.get(lo, &before) != 0)
+	{
+		*pose = after;
+		return 2;
+	}
+	if(t < before.t)
+	{
+		*pose = before;
+		return 2;
+	}
+	
+	// Samples before and after the time: before.t <= t < after.t
+	while(hi - lo > 1)
+	{
+		mid = lo + (hi - lo)/2;
+		if(this->basePoseHistory.get(mid, &sample) != 0)
+			return 2;
+		if(sample.t <= t)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	if(this->basePoseHistory.get(lo, &before) != 0 || this->basePoseHistory.get(hi, &after) != 0)
+		return 2;
+	
+	// Linear interpolation, with the orientation in the same hemisphere
+	s = (t - before.t)/(after.t - before.t);
+	*pose = before;
+	pose->t = t;
+	pose->position += s*(after.position - before.position);
+	pose->velocity += s*(after.velocity - before.velocity);
+	pose->angularVelocity += s*(after.angularVelocity - before.angularVelocity);
+	w = (before.orientation[0]*after.orientation[0] + before.orientation[1]*after.orientation[1] +
+		before.orientation[2]*after.orientation[2] + before.orientation[3]*after.orientation[3] < 0) ? -1.0f : 1.0f;
+	for(k = 0; k < 4; k++)
+		pose->orientation[k] = before.orientation[k] + s*(w*after.orientation[k] - before.orientation[k]);
+	normalizeQuaternion(pose->orientation);
+	
+	
+	return 0;
+}
+
+
+/*
+ * Convert a TCP position from the world frame to the frame of the arms
+ */
+int LiCAS_FloatingBase::worldToArm(const LiCAS_Vector3 & pWorld, double t, LiCAS_Vector3 * pArm) const
+{
+	LiCAS_Transform T_world_arms;
+	int errorCode = 0;
+	
+	
+	errorCode = this->getArmsTransform(t, &T_world_arms);
+	if(errorCode != 1)
+		*pArm = LiCAS_TransformPoint(LiCAS_RigidInverse(T_world_arms), pWorld);
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Send the TCP references of both arms given in the world frame
+ */
+int LiCAS_FloatingBase::sendWorldTCPRef(LiCAS_ECI_UDP * licas_eci, const LiCAS_Vector3 & pLworld, const LiCAS_Vector3 & pRworld, float playTime)
+{
+	LiCAS_BASE_TCP_SAMPLE reference;
+	LiCAS_Transform T_arms_world;
+	float pLref[3];
+	float pRref[3];
+	int k = 0;
+	
+	
+	// Pose of the base in the middle of the play time, once the references take effect
+	reference.t = getTime();
+	if(this->getArmsTransform(reference.t + this->getLatency() + 0.5*playTime, &T_arms_world) == 1)
+		return 1;
+	T_arms_world = LiCAS_RigidInverse(T_arms_world);
+	reference.pL = LiCAS_TransformPoint(T_arms_world, pLworld);
+	reference.pR = LiCAS_TransformPoint(T_arms_world, pRworld);
+	this->refHistory.push(reference);
+	
+	for(k = 0; k < 3; k++)
+	{
+		pLref[k] = reference.pL[k];
+		pRref[k] = reference.pR[k];
+	}
+	
+	
+	return (licas_eci->sendTCPPositionRef(pLref, pRref, playTime) == 0) ? 0 : 2;
+}
+
+
+/*
+ * Add a TCP feedback sample in the frame of the arms
+ */
+void LiCAS_FloatingBase::addFeedback(const float pL[3], const float pR[3], double t)
+{
+	LiCAS_Transform T_world_arms;
+	LiCAS_Vector3 pLarm;
+	LiCAS_Vector3 pRarm;
+	int k = 0;
+	
+	
+	for(k = 0; k < 3; k++)
+	{
+		pLarm[k] = pL[k];
+		pRarm[k] = pR[k];
+	}
+	
+	// TCP in the world frame with the pose of the base when it was measured
+	if(this->getArmsTransform(t - this->feedbackDelay, &T_world_arms) != 1)
+	{
+		this->pLworldFeedback = LiCAS_TransformPoint(T_world_arms, pLarm);
+		this->pRworldFeedback = LiCAS_TransformPoint(T_world_arms, pRarm);
+	}
+	
+	if(this->flagEstimateLatency != 0)
+		this->updateLatency(pLarm, pRarm, t);
+}
+
+
+/*
+ * Feedback callback of the LiCAS ECI: TCP feedback with the time of reception. The time given by the
+ * interface (elapsed since its creation) is not used, since the histories use the monotonic clock.
+ */
+void LiCAS_FloatingBase::feedbackCallback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float, void * userData)
+{
+	float pL[3];
+	float pR[3];
+	int k = 0;
+	
+	
+	// Copy of the fields of the packed structure
+	for(k = 0; k < 3; k++)
+	{
+		pL[k] = dataPacketFeedback->pL[k];
+		pR[k] = dataPacketFeedback->pR[k];
+	}
+	((LiCAS_FloatingBase*)userData)->addFeedback(pL, pR, getTime());
+}
+
+
+/*
+ * Position of the TCP of both arms in the world frame from the last feedback
+ */
+void LiCAS_FloatingBase::getWorldTCP(LiCAS_Vector3 * pL, LiCAS_Vector3 * pR) const
+{
+	*pL = this->pLworldFeedback;
+	*pR = this->pRworldFeedback;
+}
+
+
+/*
+ * Number of base pose data packets received
+ */
+uint64_t LiCAS_FloatingBase::getNumBasePosePackets() const
+{
+	return this->numBasePosePackets;
+}
+
+
+/*
+ * Number of base pose data packets discarded (invalid or out of order)
+ */
+uint64_t LiCAS_FloatingBase::getNumDiscardedPackets() const
+{
+	return this->numDiscardedPackets;
+}
+
+
+/*
+ * Time of the clock of the receiver in [s]
+ */
+double LiCAS_FloatingBase::getTime()
+{
+	struct timespec t;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	
+	
+	return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+
+/*
+ * Entry point of the base pose reception thread
+ */
+void * LiCAS_FloatingBase::basePoseThreadEntry(void * arg)
+{
+	((LiCAS_FloatingBase*)arg)->basePoseThreadFunction();
+	
+	
+	return NULL;
+}
+
+
+/*
+ * Reception of the base pose data packets
+ */
+void LiCAS_FloatingBase::basePoseThreadFunction()
+{
+	struct pollfd pfd;
+	char buffer[256];
+	int dataReceived = 0;
+	double t = 0;
+	
+	
+	pfd.fd = this->socketReceiver;
+	pfd.events = POLLIN;
+	while(this->flagTerminateThread == 0)
+	{
+		if(poll(&pfd, 1, BASE_RX_TIMEOUT_MS) <= 0)
+			continue;
+		
+		while((dataReceived = recv(this->socketReceiver, buffer, sizeof(buffer), 0)) > 0)
+		{
+			t = getTime();
+			if(dataReceived == sizeof(LiCAS_BASE_POSE_DATA_PACKET) && buffer[0] == LiCAS_PACKET_ID_BASE_POSE)
+				this->processBasePosePacket((LiCAS_BASE_POSE_DATA_PACKET*)buffer, t);
+			else
+				this->numDiscardedPackets++;
+		}
+	}
+}
+
+
+/*
+ * Add the pose of a base pose data packet to the history, with the time of the measurement
+ */
+void LiCAS_FloatingBase::processBasePosePacket(const LiCAS_BASE_POSE_DATA_PACKET * dataPacketBasePose, double t)
+{
+	LiCAS_BASE_POSE pose;
+	int k = 0;
+	
+	
+	pose.t = t - dataPacketBasePose->age;
+	for(k = 0; k < 3; k++)
+	{
+		pose.position[k] = dataPacketBasePose->position[k];
+		pose.velocity[k] = dataPacketBasePose->velocity[k];
+		pose.angularVelocity[k] = dataPacketBasePose->angularVelocity[k];
+	}
+	for(k = 0; k < 4; k++)
+		pose.orientation[k] = dataPacketBasePose->orientation[k];
+	
+	// The history is ordered by time
+	if((this->numBasePosePackets > 0 && (int32_t)(dataPacketBasePose->sequence - this->lastSequence) <= 0) ||
+		(this->numBasePosePackets > 0 && pose.t <= this->lastPoseTime) || normalizeQuaternion(pose.orientation) < 1e-6)
+	{
+		this->numDiscardedPackets++;
+		return;
+	}
+	this->lastSequence = dataPacketBasePose->sequence;
+	this->lastPoseTime = pose.t;
+	this->basePoseHistory.push(pose);
+	this->numBasePosePackets++;
+}
+
+
+/*
+ * Pose of the frame of the arms in the world frame at a given time. The return values are those of
+ * getBasePose().
+ */
+int LiCAS_FloatingBase::getArmsTransform(double t, LiCAS_Transform * T_world_arms) const
+{
+	LiCAS_BASE_POSE pose;
+	int errorCode = 0;
+	
+	
+	errorCode = this->getBasePose(t, &pose);
+	if(errorCode != 1)
+		*T_world_arms = getPoseTransform(pose)*this->T_base_arms;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Update the errors of the candidate delays with a feedback sample and take the delay with the
+ * lowest error. The references are walked back from the last one, so the cost is the number of
+ * candidates plus the number of references in the window.
+ */
+void LiCAS_FloatingBase::updateLatency(const LiCAS_Vector3 & pL, const LiCAS_Vector3 & pR, double t)
+{
+	LiCAS_BASE_TCP_SAMPLE reference;
+	LiCAS_BASE_TCP_SAMPLE previous;
+	LiCAS_Vector3 eL;
+	LiCAS_Vector3 eR;
+	uint64_t count = this->refHistory.getCount();
+	uint64_t index = 0;
+	double errorMin = 0;
+	double errorMax = 0;
+	double target = 0;
+	int kMin = 0;
+	int k = 0;
+	
+	
+	if(count == 0 || this->refHistory.get(count - 1, &reference) != 0)
+		return;
+	index = count - 1;
+	for(k = 0; k < BASE_LATENCY_CANDIDATES; k++)
+	{
+		// Last reference sent before the feedback time minus the candidate delay
+		target = t - k*BASE_LATENCY_STEP;
+		while(reference.t > target && index > 0 && this->refHistory.get(index - 1, &previous) == 0)
+		{
+			reference = previous;
+			index--;
+		}
+		if(reference.t > target)
+			break;
+		eL = pL - reference.pL;
+		eR = pR - reference.pR;
+		if(this->latencyError[k] < 0)
+			this->latencyError[k] = dot(eL, eL) + dot(eR, eR);
+		else
+			this->latencyError[k] = BASE_LATENCY_FORGETTING*this->latencyError[k] + (1 - BASE_LATENCY_FORGETTING)*(dot(eL, eL) + dot(eR, eR));
+	}
+	
+	// Delay with the lowest error, if the motion is enough to distinguish the candidates
+	if(this->latencyError[BASE_LATENCY_CANDIDATES - 1] < 0)
+		return;
+	errorMin = this->latencyError[0];
+	errorMax = this->latencyError[0];
+	for(k = 1; k < BASE_LATENCY_CANDIDATES; k++)
+	{
+		if(this->latencyError[k] < errorMin)
+		{
+			errorMin = this->latencyError[k];
+			kMin = k;
+		}
+		errorMax = fmax(errorMax, this->latencyError[k]);
+	}
+	if(errorMax - errorMin > BASE_LATENCY_MIN_SPREAD)
+		this->latencyEstimate = fmax(kMin*BASE_LATENCY_STEP - this->feedbackDelay, 0.0);
+}
+
@@ -0,0 +1,262 @@
+/*
+ *
+ * LiCAS Motion - LiCAS_FloatingBase.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Compensation of the motion of the base of the arms (aerial platform) for TCP targets given in the
+ * world frame. The pose of the base is received from the IMU/odometry of the platform through an
+ * UDP port (LiCAS_BASE_POSE_DATA_PACKET, up to 1 kHz, see LiCAS_BasePoseSimulator for a local
+ * stand-in) and stored in a history with the time of the measurement in the clock of the receiver
+ * (reception time minus the age declared by the publisher). In each control cycle, the world TCP
+ * targets are converted into TCP references in the frame of the arms with the pose of the base
+ * predicted at the time the references are followed (latency plus half the play time), interpolated
+ * from the history or extrapolated with the velocities of the last sample.
+ *
+ * The prediction horizon (latency) is estimated from the feedback history: the TCP positions of
+ * the feedback are compared with the references sent for a set of candidate delays, and the delay
+ * with the lowest error (exponentially weighted) is taken as the latency of the references. The
+ * feedback is also transformed into the world frame with the pose of the base at its time, giving
+ * the position of the TCP in the world frame.
+ *
+ * The base pose history and the references history are lock-free rings (single writer), so the
+ * reception of the base pose, the feedback of the LiCAS ECI and the control loop run in different
+ * threads without locks.
+ *
+ * Example:
+ *
+ * 	LiCAS_FloatingBase floatingBase(LiCAS_Transform::identity());
+ *
+ * 	floatingBase.openBasePoseChannel(25000);
+ * 	licas_eci->setFeedbackCallback(LiCAS_FloatingBase::feedbackCallback, &floatingBase);
+ * 	...
+ * 	floatingBase.sendWorldTCPRef(licas_eci, pLworld, pRworld, 0.002);		// Each control cycle
+ *
+ */
+
+#ifndef LICAS_FLOATING_BASE_H_
+#define LICAS_FLOATING_BASE_H_
+
+
+// Standard library
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "../LiCAS_Kinematics/LiCAS_Matrix.h"
+#include "LiCAS_History.h"
+
+
+// Constant definition
+#define BASE_POSE_HISTORY_SIZE		1024	// Samples of the base pose history (power of 2, 1 s at 1 kHz)
+#define BASE_REF_HISTORY_SIZE		512		// Samples of the references history (power of 2)
+#define BASE_MAX_PREDICTION			0.1		// Maximum extrapolation of the base pose in [s]
+#define BASE_RX_TIMEOUT_MS			100		// Maximum sleep time of the base pose reception thread in [ms]
+#define BASE_LATENCY_CANDIDATES		100		// Candidate delays of the latency estimation
+#define BASE_LATENCY_STEP			0.0005	// Step between the candidate delays in [s]
+#define BASE_LATENCY_FORGETTING		0.995	// Forgetting factor of the delay errors per feedback sample
+#define BASE_LATENCY_MIN_SPREAD		1e-6	// Minimum spread of the delay errors (motion) for the estimation in [m^2]
+
+
+// Pose of the base at a given time
+typedef struct
+{
+	double t;						// Time of the measurement in the clock of the receiver in [s]
+	LiCAS_Vector3 position;			// Position in the world frame in [m]
+	float orientation[4];			// Orientation in the world frame (quaternion w, x, y, z)
+	LiCAS_Vector3 velocity;			// Linear velocity in the world frame in [m/s]
+	LiCAS_Vector3 angularVelocity;	// Angular velocity in the base frame in [rad/s]
+} LiCAS_BASE_POSE;
+
+
+// TCP references sent to the arms, in the frame of the arms
+typedef struct
+{
+	double t;						// Time of sending in [s]
+	LiCAS_Vector3 pL;
+	LiCAS_Vector3 pR;
+} LiCAS_BASE_TCP_SAMPLE;
+
+
+class LiCAS_FloatingBase
+{
+public:
+
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Pose of the frame of the arms in the frame of the base (IMU/odometry)
+	 * */
+	LiCAS_FloatingBase(const LiCAS_Transform & _T_base_arms);
+	
+	
+	/*
+	 * Destructor
+	 * */
+	virtual ~LiCAS_FloatingBase();
+	
+	
+	/*
+	 * Open the UDP port of the base pose data packets and start the reception thread. Returns 0 on
+	 * success, or 1 if the port could not be opened.
+	 *
+	 * Parameters:
+	 * 	(1) UDP port for receiving the base pose data packets
+	 */
+	int openBasePoseChannel(int _UDP_RxPort);
+	
+	
+	/*
+	 * Stop the reception thread and close the UDP port. Returns 1 if the channel was not open.
+	 */
+	int closeBasePoseChannel();
+	
+	
+	/*
+	 * Configure the latency of the references (prediction horizon of the base pose).
+	 *
+	 * Parameters:
+	 * 	(1) Latency in [s], used until it is estimated (or always if the estimation is disabled)
+	 * 	(2) Enable (1) or disable (0) the estimation of the latency from the feedback history
+	 * 	(3) Delay of the feedback from the arms to the interface in [s], subtracted from the delay
+	 * 	between the references and the feedback
+	 */
+	void setLatency(float _latency, int _flagEstimateLatency, float _feedbackDelay);
+	
+	
+	/*
+	 * Latency of the references in [s] (estimated or fixed)
+	 */
+	float getLatency() const;
+	
+	
+	/*
+	 * Pose of the base at a given time: interpolated from the history, or extrapolated from the last
+	 * sample (up to BASE_MAX_PREDICTION). Returns 0 on success, 1 if there are no samples, 2 if the
+	 * time is older than the history (oldest sample), or 3 if the extrapolation is limited.
+	 *
+	 * Parameters:
+	 * 	(1) Time in the clock of the receiver in [s] (see getTime())
+	 * 	(2) Pose of the base
+	 */
+	int getBasePose(double t, LiCAS_BASE_POSE * pose) const;
+	
+	
+	/*
+	 * Convert a TCP position from the world frame to the frame of the arms with the pose of the base
+	 * at the given time. The return values are those of getBasePose().
+	 */
+	int worldToArm(const LiCAS_Vector3 & pWorld, double t, LiCAS_Vector3 * pArm) const;
+	
+	
+	/*
+	 * Send the TCP references of both arms given in the world frame, converted with the pose of the
+	 * base predicted at the current time plus the latency and half the play time (the references are
+	 * followed during the play time). Returns 0 on success, 1 if there are no base pose samples, or 2
+	 * if the references could not be sent.
+	 *
+	 * Parameters:
+	 * 	(1) LiCAS ECI, with the link established
+	 * 	(2) TCP position of the left arm in the world frame in [m]
+	 * 	(3) TCP position of the right arm in the world frame in [m]
+	 * 	(4) Time for reaching the references in [s]
+	 */
+	int sendWorldTCPRef(LiCAS_ECI_UDP * licas_eci, const LiCAS_Vector3 & pLworld, const LiCAS_Vector3 & pRworld, float playTime);
+	
+	
+	/*
+	 * Add a TCP feedback sample, in the frame of the arms, received at the given time (usually called
+	 * from feedbackCallback())
+	 */
+	void addFeedback(const float pL[3], const float pR[3], double t);
+	
+	
+	/*
+	 * Feedback callback of the LiCAS ECI (userData: pointer to the floating base)
+	 */
+	static void feedbackCallback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t, void * userData);
+	
+	
+	/*
+	 * Position of the TCP of both arms in the world frame, from the last feedback and the pose of
+	 * the base at its time
+	 */
+	void getWorldTCP(LiCAS_Vector3 * pL, LiCAS_Vector3 * pR) const;
+	
+	
+	/*
+	 * Number of base pose data packets received, and discarded (invalid or out of order)
+	 */
+	uint64_t getNumBasePosePackets() const;
+	
+	uint64_t getNumDiscardedPackets() const;
+	
+	
+	/*
+	 * Time of the clock of the receiver (CLOCK_MONOTONIC) in [s]
+	 */
+	static double getTime();
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	LiCAS_Transform T_base_arms;
+	
+	// Base pose channel
+	pthread_t basePoseThread;
+	int UDP_RxPort;
+	int socketReceiver;
+	int flagTerminateThread;
+	uint64_t numBasePosePackets;
+	uint64_t numDiscardedPackets;
+	uint32_t lastSequence;
+	double lastPoseTime;
+	
+	LiCAS_History<LiCAS_BASE_POSE, BASE_POSE_HISTORY_SIZE> basePoseHistory;
+	LiCAS_History<LiCAS_BASE_TCP_SAMPLE, BASE_REF_HISTORY_SIZE> refHistory;
+	
+	// Latency
+	float latency;
+	float feedbackDelay;
+	int flagEstimateLatency;
+	float latencyEstimate;
+	double latencyError[BASE_LATENCY_CANDIDATES];	// Mean squared error of each candidate delay (-1 without samples)
+	
+	// TCP in the world frame from the feedback
+	LiCAS_Vector3 pLworldFeedback;
+	LiCAS_Vector3 pRworldFeedback;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	
+	static void * basePoseThreadEntry(void * arg);
+	
+	void basePoseThreadFunction();
+	
+	void processBasePosePacket(const LiCAS_BASE_POSE_DATA_PACKET * dataPacketBasePose, double t);
+	
+	int getArmsTransform(double t, LiCAS_Transform * T_world_arms) const;
+	
+	void updateLatency(const LiCAS_Vector3 & pL, const LiCAS_Vector3 & pR, double t);
+};
+
+#endif
+
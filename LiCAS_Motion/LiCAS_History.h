@@ -0,0 +1,76 @@
+/*
+ *
+ * LiCAS Motion - LiCAS_History.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Lock-free history of the samples of a stream received by one thread and read by others (base
+ * pose of LiCAS_FloatingBase, operator input of LiCAS_OperatorInput). It is a fixed size ring, so
+ * adding a sample does not allocate memory nor block the readers.
+ *
+ */
+
+#ifndef LICAS_HISTORY_H_
+#define LICAS_HISTORY_H_
+
+
+// Standard library
+#include <stdint.h>
+#include <atomic>
+
+
+/*
+ * History of samples with a single writer and any number of readers. The writer overwrites the
+ * oldest sample, and a reader discards a sample if it was overwritten while being copied.
+ */
+template <typename T, int SIZE>
+class LiCAS_History
+{
+public:
+
+	static_assert((SIZE & (SIZE - 1)) == 0, "The size of the history must be a power of 2");
+	
+	LiCAS_History() : count(0) {}
+	
+	// Add a sample (writer)
+	void push(const T & sample)
+	{
+		uint64_t n = this->count.load(std::memory_order_relaxed);
+		
+		this->samples[n & (SIZE - 1)] = sample;
+		this->count.store(n + 1, std::memory_order_release);
+	}
+	
+	// Number of samples added since the creation
+	uint64_t getCount() const
+	{
+		return this->count.load(std::memory_order_acquire);
+	}
+	
+	// Copy of the sample with the given index. Returns 0 on success, or 1 if it is not available.
+	int get(uint64_t index, T * sample) const
+	{
+		if(index >= this->getCount() || this->getCount() - index > SIZE - 1)
+			return 1;
+		*sample = this->samples[index & (SIZE - 1)];
+		std::atomic_thread_fence(std::memory_order_acquire);
+		
+		return (this->getCount() - index > SIZE - 1) ? 1 : 0;
+	}
+
+
+private:
+
+	T samples[SIZE];
+	std::atomic<uint64_t> count;
+};
+
+#endif
+
@@ -0,0 +1,456 @@
+/*
+ *
+ * LiCAS Motion - LiCAS_OperatorInput.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Alpha-beta filter of each axis, with the time between samples dt:
+ *
+ * 	r = z - (x + v*dt),		x = x + v*dt + g*r,		v = v + h*r/dt
+ *
+ * The gains of the critically damped filter with discount factor d are g = 1 - d^2 and h = (1 - d)^2,
+ * so d = 0 gives x = z (raw samples) and v = (z - x)/dt (finite differences). The minimum clock offset
+ * is kept in two consecutive windows, so it is the minimum over the last one or two windows and it
+ * follows the drift of the clock of the device.
+ *
+ */
+
+#include "LiCAS_OperatorInput.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_OperatorInput::LiCAS_OperatorInput()
+{
+	int k = 0;
+	
+	
+	this->UDP_RxPort = -1;
+	this->socketReceiver = -1;
+	this->flagTerminateThread = 0;
+	this->numDiscardedPackets = 0;
+	for(k = 0; k < MAX_INPUT_DEVICES; k++)
+	{
+		this->devices[k].numPackets = 0;
+		this->devices[k].lastSequence = 0;
+		this->devices[k].offsetMin[0] = 0;
+		this->devices[k].offsetMin[1] = 0;
+		this->devices[k].t_window = 0;
+		bzero(&this->devices[k].state, sizeof(LiCAS_INPUT_STATE));
+	}
+	this->setSmoothing(0, 0);
+	this->mappingMode = INPUT_MAP_TCP;
+	for(k = 0; k < INPUT_NUM_OUTPUTS; k++)
+	{
+		this->mapDevice[k] = -1;
+		this->mapAxis[k] = -1;
+		this->mapScale[k] = 0;
+		this->mapOffset[k] = 0;
+	}
+}
+
+
+/*
+ * Destructor
+ * */
+LiCAS_OperatorInput::~LiCAS_OperatorInput()
+{
+	if(this->socketReceiver >= 0)
+		this->closeInputChannel();
+}
+
+
+/*
+ * Open the UDP port of the operator input data packets and start the reception thread
+ *
+ * Parameters:
+ * 	(1) UDP port for receiving the operator input data packets
+ */
+int LiCAS_OperatorInput::openInputChannel(int _UDP_RxPort)
+{
+	struct sockaddr_in addrReceiver;
+	int errorCode = 0;
+	
+	
+	this->socketReceiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	bzero((char*)&addrReceiver, sizeof(struct sockaddr_in));
+	addrReceiver.sin_family = AF_INET;
+	addrReceiver.sin_addr.s_addr = INADDR_ANY;
+	addrReceiver.sin_port = htons(_UDP_RxPort);
+	if(this->socketReceiver < 0 || bind(this->socketReceiver, (struct sockaddr*)&addrReceiver, sizeof(addrReceiver)) < 0)
+	{
+		errorCode = 1;
+		if(this->socketReceiver >= 0)
+			close(this->socketReceiver);
+		this->socketReceiver = -1;
+		printf("ERROR: [in LiCAS_OperatorInput::openInputChannel] could not associate address to socket.\n");
+	}
+	else
+	{
+		fcntl(this->socketReceiver, F_SETFL, O_NONBLOCK);
+		this->UDP_RxPort = _UDP_RxPort;
+		this->flagTerminateThread = 0;
+		pthread_create(&this->inputThread, NULL, &LiCAS_OperatorInput::inputThreadEntry, this);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Stop the reception thread and close the UDP port
+ */
+int LiCAS_OperatorInput::closeInputChannel()
+{
+	int errorCode = 0;
+	
+	
+	if(this->socketReceiver >= 0)
+	{
+		this->flagTerminateThread = 1;
+		pthread_join(this->inputThread, NULL);
+		close(this->socketReceiver);
+		this->socketReceiver = -1;
+	}
+	else
+		errorCode = 1;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Configure the smoothing of the input
+ */
+void LiCAS_OperatorInput::setSmoothing(float discount, float _maxPrediction)
+{
+	discount = fmin(fmax(discount, 0), 0.99);
+	this->gainValue = 1 - discount*discount;
+	this->gainRate = (1 - discount)*(1 - discount);
+	this->maxPrediction = fmax(_maxPrediction, 0);
+}
+
+
+/*
+ * Select the references given by the mapping
+ */
+void LiCAS_OperatorInput::setMappingMode(int _mappingMode)
+{
+	this->mappingMode = _mappingMode;
+}
+
+
+/*
+ * Map an axis of an input device to an output
+ */
+int LiCAS_OperatorInput::setMapping(int output, int device, int axis, float scale, float offset)
+{
+	if(output < 0 || output >= INPUT_NUM_OUTPUTS || device < 0 || device >= MAX_INPUT_DEVICES || axis < -1 || axis >= MAX_INPUT_AXES)
+		return 1;
+	
+	this->mapDevice[output] = device;
+	this->mapAxis[output] = axis;
+	this->mapScale[output] = scale;
+	this->mapOffset[output] = offset;
+	
+	
+	return 0;
+}
+
+
+/*
+ * Input of a device resampled at a given time
+ */
+int LiCAS_OperatorInput::getInput(int device, double t, float * values, uint32_t * buttons) const
+{
+	LiCAS_INPUT_STATE last;
+	LiCAS_INPUT_STATE previous;
+	uint64_t count = 0;
+	uint64_t index = 0;
+	float alpha = 0;
+	float dt = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	for(k = 0; k < MAX_INPUT_AXES; k++)
+		values[k] = 0;
+	if(device < 0 || device >= MAX_INPUT_DEVICES)
+		return 1;
+	count = this->devices[device].history.getCount();
+	if(count == 0 || this->devices[device].history.get(count - 1, &last) != 0)
+		return 1;
+	
+	for(k = 0; k < last.numAxes; k++)
+		values[k] = last.value[k];
+	if(buttons != NULL)
+		*buttons = last.buttons;
+	
+	if(getTime() - last.tReception > INPUT_TIMEOUT)
+		errorCode = 2;
+	else if(t >= last.t)
+	{
+		// Prediction from the last sample
+		dt = fmin(t - last.t, this->maxPrediction);
+		for(k = 0; k < last.numAxes; k++)
+			values[k] += last.rate[k]*dt;
+	}
+	else
+	{
+		// Interpolation between the samples around the given time (the oldest sample if it is older than the history)
+		for(index = count - 1; index > 0 && count - index < INPUT_HISTORY_SIZE/2; index--)
+		{
+			if(this->devices[device].history.get(index - 1, &previous) != 0 || previous.t >= last.t)
+				break;
+			if(previous.t <= t && previous.numAxes == last.numAxes)
+			{
+				alpha = (t - previous.t)/(last.t - previous.t);
+				for(k = 0; k < last.numAxes; k++)
+					values[k] = previous.value[k] + alpha*(last.value[k] - previous.value[k]);
+				break;
+			}
+			last = previous;
+			for(k = 0; k < last.numAxes; k++)
+				values[k] = last.value[k];
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * References of the arms at a given time, given by the mapping of the input
+ */
+int LiCAS_OperatorInput::getReferences(double t, float * refL, float * refR) const
+{
+	float input[MAX_INPUT_DEVICES][MAX_INPUT_AXES];
+	int inputCode[MAX_INPUT_DEVICES];
+	int numOutputs = (this->mappingMode == INPUT_MAP_JOINT) ? 2*NUM_ARM_JOINTS : 6;
+	float value = 0;
+	int errorCode = 0;
+	int device = 0;
+	int k = 0;
+	
+	
+	// Each mapped device is resampled once
+	for(device = 0; device < MAX_INPUT_DEVICES; device++)
+		inputCode[device] = -1;
+	
+	for(k = 0; k < numOutputs; k++)
+	{
+		value = this->mapOffset[k];
+		device = this->mapDevice[k];
+		if(device >= 0 && this->mapAxis[k] >= 0)
+		{
+			if(inputCode[device] < 0)
+			{
+				inputCode[device] = this->getInput(device, t, input[device], NULL);
+				if(inputCode[device] > errorCode)
+					errorCode = inputCode[device];
+			}
+			value += this->mapScale[k]*input[device][this->mapAxis[k]];
+		}
+		
+		if(k < numOutputs/2)
+			refL[k] = value;
+		else
+			refR[k - numOutputs/2] = value;
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Send the references of the arms given by the input predicted at the middle of the play time
+ */
+int LiCAS_OperatorInput::sendReferences(LiCAS_ECI_UDP * licas_eci, float playTime)
+{
+	float refL[NUM_ARM_JOINTS];
+	float refR[NUM_ARM_JOINTS];
+	int errorCode = 0;
+	
+	
+	errorCode = this->getReferences(getTime() + 0.5*playTime, refL, refR);
+	if(errorCode != 0)
+		return errorCode;
+	
+	if(this->mappingMode == INPUT_MAP_JOINT)
+		errorCode = licas_eci->sendJointPositionRef(refL, refR, playTime);
+	else
+		errorCode = licas_eci->sendTCPPositionRef(refL, refR, playTime);
+	
+	
+	return (errorCode == 0) ? 0 : 3;
+}
+
+
+/*
+ * Number of operator input data packets received from a device
+ */
+uint64_t LiCAS_OperatorInput::getNumInputPackets(int device) const
+{
+	return (device >= 0 && device < MAX_INPUT_DEVICES) ? this->devices[device].numPackets : 0;
+}
+
+
+/*
+ * Number of operator input data packets discarded
+ */
+uint64_t LiCAS_OperatorInput::getNumDiscardedPackets() const
+{
+	return this->numDiscardedPackets;
+}
+
+
+/*
+ * Time of the clock of the receiver in [s]
+ */
+double LiCAS_OperatorInput::getTime()
+{
+	struct timespec t;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	
+	
+	return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+
+/*
+ * Entry point of the input reception thread
+ */
+void * LiCAS_OperatorInput::inputThreadEntry(void * arg)
+{
+	((LiCAS_OperatorInput*)arg)->inputThreadFunction();
+	
+	
+	return NULL;
+}
+
+
+/*
+ * Reception of the operator input data packets
+ */
+void LiCAS_OperatorInput::inputThreadFunction()
+{
+	struct pollfd pfd;
+	char buffer[256];
+	int dataReceived = 0;
+	double t = 0;
+	
+	
+	pfd.fd = this->socketReceiver;
+	pfd.events = POLLIN;
+	while(this->flagTerminateThread == 0)
+	{
+		if(poll(&pfd, 1, INPUT_RX_TIMEOUT_MS) <= 0)
+			continue;
+		
+		while((dataReceived = recv(this->socketReceiver, buffer, sizeof(buffer), 0)) > 0)
+		{
+			t = getTime();
+			if(dataReceived == sizeof(LiCAS_OPERATOR_INPUT_DATA_PACKET) && buffer[0] == LiCAS_PACKET_ID_OPERATOR_INPUT)
+				this->processInputPacket((LiCAS_OPERATOR_INPUT_DATA_PACKET*)buffer, t);
+			else
+				this->numDiscardedPackets++;
+		}
+	}
+}
+
+
+/*
+ * Filter the sample of an operator input data packet and add it to the history of its device
+ */
+void LiCAS_OperatorInput::processInputPacket(const LiCAS_OPERATOR_INPUT_DATA_PACKET * dataPacketInput, double t)
+{
+	LiCAS_INPUT_DEVICE * device = NULL;
+	LiCAS_INPUT_STATE * state = NULL;
+	double offset = 0;
+	double t_sample = 0;
+	float dt = 0;
+	float residual = 0;
+	int flagReset = 0;
+	int k = 0;
+	
+	
+	if(dataPacketInput->deviceID >= MAX_INPUT_DEVICES || dataPacketInput->numAxes == 0 || dataPacketInput->numAxes > MAX_INPUT_AXES)
+	{
+		this->numDiscardedPackets++;
+		return;
+	}
+	device = &this->devices[dataPacketInput->deviceID];
+	state = &device->state;
+	
+	// A device is restarted (sequence and clock) after a gap or a change of the number of axes
+	flagReset = (device->numPackets == 0 || t - state->tReception > INPUT_TIMEOUT || dataPacketInput->numAxes != state->numAxes);
+	if(flagReset == 0 && (int32_t)(dataPacketInput->sequence - device->lastSequence) <= 0)
+	{
+		this->numDiscardedPackets++;
+		return;
+	}
+	
+	// Minimum clock offset of the device over the last windows
+	offset = t - dataPacketInput->timeStamp;
+	if(flagReset != 0)
+	{
+		device->offsetMin[0] = offset;
+		device->offsetMin[1] = offset;
+		device->t_window = t;
+	}
+	else if(t - device->t_window > INPUT_OFFSET_WINDOW)
+	{
+		device->offsetMin[1] = device->offsetMin[0];
+		device->offsetMin[0] = offset;
+		device->t_window = t;
+	}
+	else
+		device->offsetMin[0] = fmin(device->offsetMin[0], offset);
+	t_sample = dataPacketInput->timeStamp + fmin(device->offsetMin[0], device->offsetMin[1]);
+	
+	dt = t_sample - state->t;
+	if(flagReset == 0 && dt <= 0)
+	{
+		this->numDiscardedPackets++;
+		return;
+	}
+	
+	// Alpha-beta filter of each axis
+	for(k = 0; k < dataPacketInput->numAxes; k++)
+	{
+		if(flagReset != 0)
+		{
+			state->value[k] = dataPacketInput->axes[k];
+			state->rate[k] = 0;
+		}
+		else
+		{
+			state->value[k] += state->rate[k]*dt;
+			residual = dataPacketInput->axes[k] - state->value[k];
+			state->value[k] += this->gainValue*residual;
+			state->rate[k] += this->gainRate*residual/dt;
+		}
+	}
+	state->t = t_sample;
+	state->tReception = t;
+	state->buttons = dataPacketInput->buttons;
+	state->numAxes = dataPacketInput->numAxes;
+	device->history.push(*state);
+	device->lastSequence = dataPacketInput->sequence;
+	device->numPackets++;
+}
+
@@ -0,0 +1,256 @@
+/*
+ *
+ * LiCAS Motion - LiCAS_OperatorInput.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Input stream of the devices of the operator (joysticks, haptic devices, motion capture markers),
+ * received through an UDP port (LiCAS_OPERATOR_INPUT_DATA_PACKET, up to some kHz, see
+ * LiCAS_InputReplayer for a local stand-in) and mapped to the TCP or joint references of the arms.
+ * Up to MAX_INPUT_DEVICES devices are received in the same port, identified by the deviceID of the
+ * packets.
+ *
+ * The devices sample at their own rate and clock, and the packets arrive with jitter, so the samples
+ * are placed in the clock of the receiver with the minimum offset between the reception time and the
+ * time stamp of the device over the last INPUT_OFFSET_WINDOW seconds (the packets with the lowest
+ * delay), and each axis is smoothed with a critically damped alpha-beta filter that also estimates
+ * its rate. In each control cycle, the input is resampled at the time of the references: interpolated
+ * between the filtered samples, or predicted from the last one with its rate (up to a maximum
+ * prediction), hiding both the latency and the jitter of the input.
+ *
+ * The filtered samples are stored in a lock-free history (LiCAS_History), so the reception thread and
+ * the control loop run without locks. The smoothing and the mapping are configured before opening
+ * the channel.
+ *
+ * Example:
+ *
+ * 	LiCAS_OperatorInput operatorInput;
+ *
+ * 	operatorInput.setSmoothing(0.6, 0.05);
+ * 	operatorInput.setMappingMode(INPUT_MAP_TCP);
+ * 	operatorInput.setMapping(0, 0, 0, 0.5, 0.3);		// Left TCP x = 0.5*(axis 0 of device 0) + 0.3
+ * 	...
+ * 	operatorInput.openInputChannel(26000);
+ * 	...
+ * 	operatorInput.sendReferences(licas_eci, 0.002);		// Each control cycle
+ *
+ */
+
+#ifndef LICAS_OPERATOR_INPUT_H_
+#define LICAS_OPERATOR_INPUT_H_
+
+
+// Standard library
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "LiCAS_History.h"
+
+
+// Constant definition
+#define MAX_INPUT_DEVICES			4		// Maximum number of input devices (deviceID from 0)
+#define INPUT_HISTORY_SIZE			256		// Filtered samples of the history of each device (power of 2)
+#define INPUT_NUM_OUTPUTS			8		// Outputs of the mapping (TCP: 6, joints: 2*NUM_ARM_JOINTS)
+#define INPUT_OFFSET_WINDOW			2.0		// Window of the minimum clock offset of the devices in [s]
+#define INPUT_TIMEOUT				0.2		// Time without samples for considering a device stale in [s]
+#define INPUT_RX_TIMEOUT_MS			100		// Maximum sleep time of the input reception thread in [ms]
+
+#define INPUT_MAP_TCP				0		// Outputs: TCP position of the left (0-2) and right (3-5) arms in [m]
+#define INPUT_MAP_JOINT				1		// Outputs: joint positions of the left (0-3) and right (4-7) arms in [rad]
+
+
+// Filtered sample of an input device
+typedef struct
+{
+	double t;						// Time of the sample in the clock of the receiver in [s]
+	double tReception;				// Reception time of the sample in [s]
+	float value[MAX_INPUT_AXES];	// Filtered value of each axis
+	float rate[MAX_INPUT_AXES];		// Estimated rate of each axis in [1/s]
+	uint32_t buttons;
+	int numAxes;
+} LiCAS_INPUT_STATE;
+
+
+class LiCAS_OperatorInput
+{
+public:
+
+	/*
+	 * Constructor
+	 * */
+	LiCAS_OperatorInput();
+	
+	
+	/*
+	 * Destructor
+	 * */
+	virtual ~LiCAS_OperatorInput();
+	
+	
+	/*
+	 * Open the UDP port of the operator input data packets and start the reception thread. Returns 0
+	 * on success, or 1 if the port could not be opened.
+	 *
+	 * Parameters:
+	 * 	(1) UDP port for receiving the operator input data packets
+	 */
+	int openInputChannel(int _UDP_RxPort);
+	
+	
+	/*
+	 * Stop the reception thread and close the UDP port. Returns 1 if the channel was not open.
+	 */
+	int closeInputChannel();
+	
+	
+	/*
+	 * Configure the smoothing of the input (before opening the channel). The default values (0, 0)
+	 * hold the last sample received.
+	 *
+	 * Parameters:
+	 * 	(1) Discount factor of the alpha-beta filter, in [0, 1): 0 for no smoothing, close to 1 for
+	 * 	a smooth but slow response
+	 * 	(2) Maximum prediction of the input from the last sample in [s] (0 for no prediction)
+	 */
+	void setSmoothing(float discount, float _maxPrediction);
+	
+	
+	/*
+	 * Select the references given by the mapping: INPUT_MAP_TCP (default) or INPUT_MAP_JOINT
+	 */
+	void setMappingMode(int _mappingMode);
+	
+	
+	/*
+	 * Map an axis of an input device to an output: output = scale*axis + offset. The outputs that are
+	 * not mapped are zero. Returns 0 on success, or 1 if the output, the device or the axis are not
+	 * valid.
+	 *
+	 * Parameters:
+	 * 	(1) Output: 0-5 for INPUT_MAP_TCP, 0-7 for INPUT_MAP_JOINT
+	 * 	(2) Input device
+	 * 	(3) Axis of the input device (-1 for a constant output equal to the offset)
+	 * 	(4) Scale of the axis
+	 * 	(5) Offset in [m] or [rad]
+	 */
+	int setMapping(int output, int device, int axis, float scale, float offset);
+	
+	
+	/*
+	 * Input of a device resampled at a given time: interpolated from the history, or predicted from
+	 * the last sample. Returns 0 on success, 1 if there are no samples, or 2 if the device is stale
+	 * (the last sample is held).
+	 *
+	 * Parameters:
+	 * 	(1) Input device
+	 * 	(2) Time in the clock of the receiver in [s] (see getTime())
+	 * 	(3) Value of each axis (MAX_INPUT_AXES)
+	 * 	(4) State of the buttons (may be NULL)
+	 */
+	int getInput(int device, double t, float * values, uint32_t * buttons) const;
+	
+	
+	/*
+	 * References of the arms at a given time, given by the mapping of the input. The return values
+	 * are those of getInput() (the worst of the mapped devices).
+	 *
+	 * Parameters:
+	 * 	(1) Time in the clock of the receiver in [s]
+	 * 	(2) References of the left arm (TCP position or joint positions)
+	 * 	(3) References of the right arm (TCP position or joint positions)
+	 */
+	int getReferences(double t, float * refL, float * refR) const;
+	
+	
+	/*
+	 * Send the references of the arms given by the input predicted at the middle of the play time.
+	 * Returns 0 on success, 1 if there are no samples, 2 if an input device is stale (nothing is
+	 * sent), or 3 if the references could not be sent.
+	 *
+	 * Parameters:
+	 * 	(1) LiCAS ECI, with the link established
+	 * 	(2) Time for reaching the references in [s]
+	 */
+	int sendReferences(LiCAS_ECI_UDP * licas_eci, float playTime);
+	
+	
+	/*
+	 * Number of operator input data packets received from a device, and discarded (invalid or out of
+	 * order)
+	 */
+	uint64_t getNumInputPackets(int device) const;
+	
+	uint64_t getNumDiscardedPackets() const;
+	
+	
+	/*
+	 * Time of the clock of the receiver (CLOCK_MONOTONIC) in [s]
+	 */
+	static double getTime();
+
+
+private:
+
+	// Reception state of an input device
+	struct LiCAS_INPUT_DEVICE
+	{
+		uint64_t numPackets;
+		uint32_t lastSequence;
+		double offsetMin[2];		// Minimum clock offset of the current and previous windows
+		double t_window;			// Start of the current window of the clock offset
+		LiCAS_INPUT_STATE state;	// Last filtered sample
+		LiCAS_History<LiCAS_INPUT_STATE, INPUT_HISTORY_SIZE> history;
+	};
+	
+	
+	/***************** PRIVATE VARIABLES *****************/
+	
+	// Input channel
+	pthread_t inputThread;
+	int UDP_RxPort;
+	int socketReceiver;
+	int flagTerminateThread;
+	uint64_t numDiscardedPackets;
+	LiCAS_INPUT_DEVICE devices[MAX_INPUT_DEVICES];
+	
+	// Smoothing (gains of the alpha-beta filter)
+	float gainValue;
+	float gainRate;
+	float maxPrediction;
+	
+	// Mapping
+	int mappingMode;
+	int mapDevice[INPUT_NUM_OUTPUTS];
+	int mapAxis[INPUT_NUM_OUTPUTS];
+	float mapScale[INPUT_NUM_OUTPUTS];
+	float mapOffset[INPUT_NUM_OUTPUTS];
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	
+	static void * inputThreadEntry(void * arg);
+	
+	void inputThreadFunction();
+	
+	void processInputPacket(const LiCAS_OPERATOR_INPUT_DATA_PACKET * dataPacketInput, double t);
+};
+
+#endif
+
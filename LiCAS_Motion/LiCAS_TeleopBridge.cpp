@@ -0,0 +1,218 @@
+/*
+ *
+ * LiCAS Motion - LiCAS_TeleopBridge.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Both callbacks are executed by the reactor thread, so the state of the bridge is only accessed
+ * by this thread (the getters are intended for monitoring and may read a partially updated state).
+ *
+ */
+
+#include "LiCAS_TeleopBridge.h"
+
+
+/*
+ * Constructor
+ *
+ * Parameters:
+ * 	(1) Interface of the master LiCAS (moved by the operator)
+ * 	(2) Interface of the slave LiCAS
+ * */
+LiCAS_TeleopBridge::LiCAS_TeleopBridge(LiCAS_ECI_UDP * _master, LiCAS_ECI_UDP * _slave)
+{
+	int side = 0;
+	int k = 0;
+	
+	
+	this->master = _master;
+	this->slave = _slave;
+	for(side = 0; side < 2; side++)
+	{
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			this->scale[side][k] = 1;
+			this->offset[side][k] = 0;
+		}
+	}
+	this->torquePerPWM = TELEOP_DEFAULT_PWM_TORQUE;
+	this->reflectionGain = 0;
+	this->effortCutoff = TELEOP_DEFAULT_EFFORT_CUTOFF;
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		this->effortL[k] = 0;
+		this->effortR[k] = 0;
+	}
+	this->t_lastMaster = -1;
+	this->t_lastSlave = -1;
+	this->forwardTimeSum = 0;
+	bzero(&this->statistics, sizeof(LiCAS_TELEOP_STATISTICS));
+	
+	this->master->setFeedbackCallback(&LiCAS_TeleopBridge::masterFeedbackCallback, this);
+	this->slave->setFeedbackCallback(&LiCAS_TeleopBridge::slaveFeedbackCallback, this);
+}
+
+
+/*
+ * Destructor
+ * */
+LiCAS_TeleopBridge::~LiCAS_TeleopBridge()
+{
+	this->master->setFeedbackCallback(NULL, NULL);
+	this->slave->setFeedbackCallback(NULL, NULL);
+}
+
+
+/*
+ * Set the mapping of the master joint positions to the slave joint references of an arm
+ */
+void LiCAS_TeleopBridge::setJointMapping(int side, const float _scale[NUM_ARM_JOINTS], const float _offset[NUM_ARM_JOINTS])
+{
+	int k = 0;
+	
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		this->scale[side][k] = _scale[k];
+		this->offset[side][k] = _offset[k];
+	}
+}
+
+
+/*
+ * Configure the reflection of the slave effort on the master
+ */
+void LiCAS_TeleopBridge::setEffortReflection(float _torquePerPWM, float _reflectionGain, float _effortCutoff)
+{
+	this->torquePerPWM = _torquePerPWM;
+	this->reflectionGain = _reflectionGain;
+	this->effortCutoff = _effortCutoff;
+}
+
+
+/*
+ * Estimated effort of the slave joints in [Nm]
+ */
+void LiCAS_TeleopBridge::getSlaveEffort(float _effortL[NUM_ARM_JOINTS], float _effortR[NUM_ARM_JOINTS]) const
+{
+	int k = 0;
+	
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		_effortL[k] = this->effortL[k];
+		_effortR[k] = this->effortR[k];
+	}
+}
+
+
+/*
+ * Get the statistics of the bridge
+ */
+void LiCAS_TeleopBridge::getStatistics(LiCAS_TELEOP_STATISTICS * _statistics) const
+{
+	*_statistics = this->statistics;
+}
+
+
+/*
+ * Feedback callback of the master interface
+ */
+void LiCAS_TeleopBridge::masterFeedbackCallback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t, void * userData)
+{
+	((LiCAS_TeleopBridge*)userData)->forwardMasterFeedback(dataPacketFeedback, t);
+}
+
+
+/*
+ * Feedback callback of the slave interface
+ */
+void LiCAS_TeleopBridge::slaveFeedbackCallback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t, void * userData)
+{
+	((LiCAS_TeleopBridge*)userData)->reflectSlaveFeedback(dataPacketFeedback, t);
+}
+
+
+/*
+ * Send the mapped master joint positions as the slave joint references
+ */
+void LiCAS_TeleopBridge::forwardMasterFeedback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t)
+{
+	struct timespec t_start;
+	struct timespec t_end;
+	float qLref[NUM_ARM_JOINTS];
+	float qRref[NUM_ARM_JOINTS];
+	float playTime = TELEOP_MAX_PLAY_TIME;
+	float forwardTime = 0;
+	int k = 0;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &t_start);
+	
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		qLref[k] = this->scale[LiCAS_ARM_LEFT][k]*dataPacketFeedback->qL[k] + this->offset[LiCAS_ARM_LEFT][k];
+		qRref[k] = this->scale[LiCAS_ARM_RIGHT][k]*dataPacketFeedback->qR[k] + this->offset[LiCAS_ARM_RIGHT][k];
+	}
+	
+	// The slave reaches the references when the next master feedback is expected
+	if(this->t_lastMaster >= 0 && t - this->t_lastMaster > 0 && t - this->t_lastMaster < TELEOP_MAX_PLAY_TIME)
+		playTime = t - this->t_lastMaster;
+	this->t_lastMaster = t;
+	
+	if(this->slave->sendJointPositionRef(qLref, qRref, playTime) != 0)
+		this->statistics.numSendErrors++;
+	
+	clock_gettime(CLOCK_MONOTONIC, &t_end);
+	forwardTime = 1e6*(t_end.tv_sec - t_start.tv_sec) + 1e-3*(t_end.tv_nsec - t_start.tv_nsec);
+	this->statistics.numMasterPackets++;
+	this->forwardTimeSum += forwardTime;
+	this->statistics.forwardTimeMean = this->forwardTimeSum/this->statistics.numMasterPackets;
+	if(forwardTime > this->statistics.forwardTimeMax)
+		this->statistics.forwardTimeMax = forwardTime;
+}
+
+
+/*
+ * Estimate the effort of the slave joints from their PWM and reflect it on the master
+ */
+void LiCAS_TeleopBridge::reflectSlaveFeedback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t)
+{
+	float tauLref[NUM_ARM_JOINTS];
+	float tauRref[NUM_ARM_JOINTS];
+	float dt = t - this->t_lastSlave;
+	float alpha = 1;
+	int k = 0;
+	
+	
+	// First order low pass filter of the effort (no filtering on the first sample or after a gap)
+	if(this->t_lastSlave >= 0 && dt > 0 && dt < TELEOP_MAX_PLAY_TIME)
+		alpha = dt/(dt + 1.0/(2*M_PI*this->effortCutoff));
+	this->t_lastSlave = t;
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		this->effortL[k] += alpha*(this->torquePerPWM*dataPacketFeedback->pwmL[k] - this->effortL[k]);
+		this->effortR[k] += alpha*(this->torquePerPWM*dataPacketFeedback->pwmR[k] - this->effortR[k]);
+	}
+	this->statistics.numSlavePackets++;
+	
+	// The operator feels the opposite of the effort made by the slave
+	if(this->reflectionGain != 0)
+	{
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			tauLref[k] = -this->reflectionGain*this->effortL[k];
+			tauRref[k] = -this->reflectionGain*this->effortR[k];
+		}
+		if(this->master->sendJointTorqueRef(tauLref, tauRref) != 0)
+			this->statistics.numSendErrors++;
+	}
+}
+
@@ -0,0 +1,158 @@
+/*
+ *
+ * LiCAS Motion - LiCAS_TeleopBridge.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Bilateral teleoperation of a LiCAS (slave) from a second, identical LiCAS moved by the operator
+ * (master). Both interfaces are opened on the same reactor (LiCAS_ECI_Reactor), so the whole bridge
+ * runs in the feedback callbacks of a single thread, without locks nor intermediate buffers:
+ *
+ * 	- Each master feedback data packet is mapped (scale and offset of each joint) and sent at once
+ * 	  as the joint position references of the slave, with the period of the master feedback as the
+ * 	  play time.
+ * 	- Each slave feedback data packet gives the effort of the slave joints, estimated from the PWM
+ * 	  of the servos (torque per unit of PWM) with a first order low pass filter, which is reflected
+ * 	  on the master as joint torque references (opposite sign, scaled by the reflection gain).
+ *
+ * Example:
+ *
+ * 	LiCAS_ECI_Reactor reactor("teleop");
+ * 	LiCAS_TeleopBridge bridge(&master, &slave);		// Before opening the interfaces
+ *
+ * 	master.openUDPInterface("192.168.0.10", 23000, 24003, &reactor);
+ * 	slave.openUDPInterface("192.168.0.20", 23000, 24004, &reactor);
+ * 	reactor.start(80);
+ *
+ */
+
+#ifndef LICAS_TELEOP_BRIDGE_H_
+#define LICAS_TELEOP_BRIDGE_H_
+
+
+// Standard library
+#include <time.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_UDP.h"
+#include "../LiCAS_Kinematics/LiCAS_ArmKinematics.h"
+
+
+// Constant definition
+#define TELEOP_MAX_PLAY_TIME			0.05	// Maximum play time of the slave references in [s]
+#define TELEOP_DEFAULT_PWM_TORQUE		2.0		// Default torque of the servos per unit of PWM in [Nm]
+#define TELEOP_DEFAULT_EFFORT_CUTOFF	20.0	// Default cutoff frequency of the effort filter in [Hz]
+
+
+// Statistics of the bridge
+typedef struct
+{
+	uint64_t numMasterPackets;		// Master feedback data packets forwarded to the slave
+	uint64_t numSlavePackets;		// Slave feedback data packets reflected on the master
+	uint64_t numSendErrors;			// References that could not be sent
+	float forwardTimeMean;			// Mean time from the master feedback to the slave references sent in [us]
+	float forwardTimeMax;			// Maximum time from the master feedback to the slave references sent in [us]
+} LiCAS_TELEOP_STATISTICS;
+
+
+class LiCAS_TeleopBridge
+{
+public:
+
+	/*
+	 * Constructor. It sets the feedback callbacks of both interfaces, so it must be created before
+	 * opening them.
+	 *
+	 * Parameters:
+	 * 	(1) Interface of the master LiCAS (moved by the operator)
+	 * 	(2) Interface of the slave LiCAS
+	 * */
+	LiCAS_TeleopBridge(LiCAS_ECI_UDP * _master, LiCAS_ECI_UDP * _slave);
+	
+	
+	/*
+	 * Destructor. It removes the feedback callbacks of both interfaces.
+	 * */
+	virtual ~LiCAS_TeleopBridge();
+	
+	
+	/*
+	 * Set the mapping of the master joint positions to the slave joint references of an arm:
+	 * qSlave = scale*qMaster + offset (identity by default).
+	 *
+	 * Parameters:
+	 * 	(1) Arm side: LiCAS_ARM_LEFT or LiCAS_ARM_RIGHT
+	 * 	(2) Scale of each joint
+	 * 	(3) Offset of each joint in [rad]
+	 */
+	void setJointMapping(int side, const float scale[NUM_ARM_JOINTS], const float offset[NUM_ARM_JOINTS]);
+	
+	
+	/*
+	 * Configure the reflection of the slave effort on the master.
+	 *
+	 * Parameters:
+	 * 	(1) Torque of the servos per unit of PWM in [Nm]
+	 * 	(2) Gain of the torque reflected on the master (0 for no reflection)
+	 * 	(3) Cutoff frequency of the effort filter in [Hz]
+	 */
+	void setEffortReflection(float _torquePerPWM, float _reflectionGain, float _effortCutoff);
+	
+	
+	/*
+	 * Estimated effort of the slave joints in [Nm]
+	 */
+	void getSlaveEffort(float effortL[NUM_ARM_JOINTS], float effortR[NUM_ARM_JOINTS]) const;
+	
+	
+	/*
+	 * Get the statistics of the bridge
+	 */
+	void getStatistics(LiCAS_TELEOP_STATISTICS * _statistics) const;
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	LiCAS_ECI_UDP * master;
+	LiCAS_ECI_UDP * slave;
+	
+	// Mapping of the joints (left and right arms)
+	float scale[2][NUM_ARM_JOINTS];
+	float offset[2][NUM_ARM_JOINTS];
+	
+	// Effort reflection
+	float torquePerPWM;
+	float reflectionGain;
+	float effortCutoff;
+	float effortL[NUM_ARM_JOINTS];
+	float effortR[NUM_ARM_JOINTS];
+	
+	float t_lastMaster;
+	float t_lastSlave;
+	double forwardTimeSum;
+	LiCAS_TELEOP_STATISTICS statistics;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	
+	static void masterFeedbackCallback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t, void * userData);
+	
+	static void slaveFeedbackCallback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t, void * userData);
+	
+	void forwardMasterFeedback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t);
+	
+	void reflectSlaveFeedback(const LiCAS_FEEDBACK_DATA_PACKET * dataPacketFeedback, float t);
+};
+
+#endif
+
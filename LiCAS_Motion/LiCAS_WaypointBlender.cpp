@@ -0,0 +1,461 @@
+/*
+ *
+ * LiCAS Motion - LiCAS_WaypointBlender.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Corner blend at a waypoint W between the unit directions u_a and u_b with speed v: the velocity
+ * changes linearly from v*u_a to v*u_b in a time T = v*c, where c = max_j(|u_bj - u_aj|/a_max_j),
+ * starting at W - u_a*d and ending at W + u_b*d, with d = v*T/2. The maximum deviation from the
+ * waypoint is |v*(u_b - u_a)|*T/8, reached at the middle of the blend. The blends take up to a
+ * quarter of the adjacent segments, so at least half of each segment is left for the speed
+ * changes of the trapezoidal profile, which is the length used by the planning passes.
+ *
+ */
+
+#include "LiCAS_WaypointBlender.h"
+
+
+/*
+ * Constructor
+ * */
+LiCAS_WaypointBlender::LiCAS_WaypointBlender(int _dimension)
+{
+	float origin[MAX_BLEND_DIMENSION] = {0};
+	int k = 0;
+	
+	
+	this->dimension = (_dimension < 1) ? 1 : ((_dimension > MAX_BLEND_DIMENSION) ? MAX_BLEND_DIMENSION : _dimension);
+	for(k = 0; k < MAX_BLEND_DIMENSION; k++)
+	{
+		this->maxVelocity[k] = 0;
+		this->maxAcceleration[k] = 0;
+	}
+	this->tolerance = 0;
+	this->flagLimits = 0;
+	this->numPieces = 0;
+	this->pieceIndex = 0;
+	this->pieceTime = 0;
+	this->flagMoving = 0;
+	this->reset(origin);
+}
+
+
+/*
+ * Set the velocity and acceleration limits of each axis (positive values, in units/s and
+ * units/s^2). They apply to the waypoints appended after the call.
+ */
+int LiCAS_WaypointBlender::setLimits(const float * _maxVelocity, const float * _maxAcceleration)
+{
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	for(k = 0; k < this->dimension; k++)
+	{
+		if(!(_maxVelocity[k] > 0) || !(_maxAcceleration[k] > 0))
+			errorCode = 1;
+	}
+	if(errorCode == 0)
+	{
+		for(k = 0; k < this->dimension; k++)
+		{
+			this->maxVelocity[k] = _maxVelocity[k];
+			this->maxAcceleration[k] = _maxAcceleration[k];
+		}
+		this->flagLimits = 1;
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Set the maximum deviation of the corner blends from the waypoints (0: stop at every waypoint)
+ */
+void LiCAS_WaypointBlender::setTolerance(float _tolerance)
+{
+	this->tolerance = (_tolerance > 0) ? _tolerance : 0;
+}
+
+
+/*
+ * Discard the buffered waypoints and set the initial position at rest
+ */
+void LiCAS_WaypointBlender::reset(const float * position)
+{
+	LiCAS_BLEND_WAYPOINT * waypoint = NULL;
+	int k = 0;
+	
+	
+	this->currentIndex = 0;
+	this->lockedIndex = 0;
+	this->lastIndex = 0;
+	this->numPieces = 0;
+	this->pieceIndex = 0;
+	this->pieceTime = 0;
+	this->flagMoving = 0;
+	
+	waypoint = this->getWaypoint(0);
+	for(k = 0; k < MAX_BLEND_DIMENSION; k++)
+	{
+		waypoint->position[k] = (k < this->dimension) ? position[k] : 0;
+		waypoint->direction[k] = 0;
+	}
+	waypoint->length = 0;
+	waypoint->maxSpeed = 0;
+	waypoint->maxAcceleration = 0;
+	waypoint->blendFactor = 0;
+	waypoint->junctionSpeed = 0;
+	waypoint->backwardSpeed = 0;
+	waypoint->speed = 0;
+}
+
+
+/*
+ * Append a waypoint to the buffer. Returns 0 if the waypoint was appended (or ignored for being
+ * too close to the previous one), 1 if the buffer is full, or 2 if the limits are not set.
+ */
+int LiCAS_WaypointBlender::addWaypoint(const float * position)
+{
+	LiCAS_BLEND_WAYPOINT * previous = NULL;
+	LiCAS_BLEND_WAYPOINT * waypoint = NULL;
+	float length = 0;
+	float maxSpeed = 1e9;
+	float maxAcceleration = 1e9;
+	float u = 0;
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	if(this->flagLimits == 0)
+		errorCode = 2;
+	else if(this->lastIndex - this->currentIndex + 1 >= MAX_BLEND_WAYPOINTS)
+		errorCode = 1;
+	else
+	{
+		previous = this->getWaypoint(this->lastIndex);
+		for(k = 0; k < this->dimension; k++)
+			length += (position[k] - previous->position[k])*(position[k] - previous->position[k]);
+		length = sqrt(length);
+		
+		if(length >= MIN_SEGMENT_LENGTH)
+		{
+			// Segment from the previous waypoint: speed and acceleration limits along its direction
+			for(k = 0; k < this->dimension; k++)
+			{
+				u = (position[k] - previous->position[k])/length;
+				previous->direction[k] = u;
+				if(fabs(u) > 1e-6)
+				{
+					maxSpeed = fmin(maxSpeed, this->maxVelocity[k]/fabs(u));
+					maxAcceleration = fmin(maxAcceleration, this->maxAcceleration[k]/fabs(u));
+				}
+			}
+			previous->length = length;
+			previous->maxSpeed = maxSpeed;
+			previous->maxAcceleration = maxAcceleration;
+			
+			// New end of the buffer
+			waypoint = this->getWaypoint(this->lastIndex + 1);
+			for(k = 0; k < MAX_BLEND_DIMENSION; k++)
+			{
+				waypoint->position[k] = (k < this->dimension) ? position[k] : 0;
+				waypoint->direction[k] = 0;
+			}
+			waypoint->length = 0;
+			waypoint->maxSpeed = 0;
+			waypoint->maxAcceleration = 0;
+			waypoint->blendFactor = 0;
+			waypoint->junctionSpeed = 0;
+			waypoint->backwardSpeed = 0;
+			waypoint->speed = 0;
+			
+			// The previous end becomes a corner, unless its speed is already fixed (the arm stops there)
+			if(this->lastIndex > this->lockedIndex)
+				this->computeJunction(this->lastIndex);
+			this->lastIndex++;
+			this->planSpeeds();
+		}
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Advance the motion a time step in [s]. Returns 1 while the arm is moving or 0 when it is at
+ * rest at the last waypoint.
+ *
+ * Parameters:
+ * 	(1) Time step in [s]
+ * 	(2) Output position
+ * 	(3) Output velocity (can be NULL)
+ */
+int LiCAS_WaypointBlender::update(float dt, float * position, float * velocity)
+{
+	LiCAS_TRAJECTORY_PIECE * piece = NULL;
+	float remainingTime = dt;
+	float step = 0;
+	float t = 0;
+	int k = 0;
+	
+	
+	if(this->flagMoving == 0 && this->currentIndex < this->lastIndex)
+		this->startSegment();
+	
+	// Consume the time step through the pieces of the trajectory
+	while(remainingTime > 0 && this->flagMoving != 0)
+	{
+		piece = &this->pieces[this->pieceIndex];
+		step = piece->duration - this->pieceTime;
+		if(remainingTime < step)
+		{
+			this->pieceTime += remainingTime;
+			remainingTime = 0;
+		}
+		else
+		{
+			remainingTime -= step;
+			this->pieceTime = 0;
+			this->pieceIndex++;
+			if(this->pieceIndex >= this->numPieces)
+			{
+				// End of the segment: continue with the next one or stay at rest
+				this->currentIndex++;
+				this->flagMoving = 0;
+				if(this->currentIndex < this->lastIndex)
+					this->startSegment();
+			}
+		}
+	}
+	
+	if(this->flagMoving != 0)
+	{
+		piece = &this->pieces[this->pieceIndex];
+		t = this->pieceTime;
+		for(k = 0; k < this->dimension; k++)
+		{
+			position[k] = piece->p0[k] + t*(piece->v0[k] + 0.5*t*piece->a[k]);
+			if(velocity != NULL)
+				velocity[k] = piece->v0[k] + t*piece->a[k];
+		}
+	}
+	else
+	{
+		for(k = 0; k < this->dimension; k++)
+		{
+			position[k] = this->getWaypoint(this->currentIndex)->position[k];
+			if(velocity != NULL)
+				velocity[k] = 0;
+		}
+	}
+	
+	
+	return this->flagMoving;
+}
+
+
+/*
+ * Returns 1 if there is motion pending
+ */
+int LiCAS_WaypointBlender::isMoving() const
+{
+	return (this->flagMoving != 0 || this->currentIndex < this->lastIndex) ? 1 : 0;
+}
+
+
+/*
+ * Number of waypoints not reached yet
+ */
+int LiCAS_WaypointBlender::getNumPendingWaypoints() const
+{
+	return (int)(this->lastIndex - this->currentIndex);
+}
+
+
+/*
+ * Index of the waypoint at the start of the segment in execution (0: position of the reset)
+ */
+int64_t LiCAS_WaypointBlender::getWaypointIndex() const
+{
+	return this->currentIndex;
+}
+
+
+/*
+ * Waypoint of the buffer from its absolute index
+ */
+LiCAS_BLEND_WAYPOINT * LiCAS_WaypointBlender::getWaypoint(int64_t index)
+{
+	return &this->waypoints[index & (MAX_BLEND_WAYPOINTS - 1)];
+}
+
+
+/*
+ * Maximum speed at the corner of a waypoint between its incoming and outgoing segments
+ */
+void LiCAS_WaypointBlender::computeJunction(int64_t index)
+{
+	LiCAS_BLEND_WAYPOINT * previous = this->getWaypoint(index - 1);
+	LiCAS_BLEND_WAYPOINT * waypoint = this->getWaypoint(index);
+	float du = 0;
+	float duNorm = 0;
+	float c = 0;
+	float v = 0;
+	int k = 0;
+	
+	
+	for(k = 0; k < this->dimension; k++)
+	{
+		du = waypoint->direction[k] - previous->direction[k];
+		duNorm += du*du;
+		c = fmax(c, fabs(du)/this->maxAcceleration[k]);
+	}
+	duNorm = sqrt(duNorm);
+	
+	v = fmin(previous->maxSpeed, waypoint->maxSpeed);
+	if(c > 0)
+	{
+		// Blend within a quarter of the adjacent segments, and deviation below the tolerance
+		v = fmin(v, sqrt(fmin(previous->length, waypoint->length)/(2*c)));
+		v = fmin(v, sqrt(8*this->tolerance/(duNorm*c)));
+	}
+	waypoint->blendFactor = c;
+	waypoint->junctionSpeed = v;
+}
+
+
+/*
+ * Speeds at the waypoints not fixed yet: backward pass from the last waypoint (stop) and forward
+ * pass from the last fixed one. The backward pass ends when the speeds do not change.
+ */
+void LiCAS_WaypointBlender::planSpeeds()
+{
+	LiCAS_BLEND_WAYPOINT * waypoint = NULL;
+	LiCAS_BLEND_WAYPOINT * next = NULL;
+	float speed = 0;
+	int64_t index = 0;
+	
+	
+	this->getWaypoint(this->lastIndex)->backwardSpeed = 0;
+	for(index = this->lastIndex - 1; index > this->lockedIndex; index--)
+	{
+		waypoint = this->getWaypoint(index);
+		next = this->getWaypoint(index + 1);
+		speed = fmin(waypoint->junctionSpeed, sqrt(next->backwardSpeed*next->backwardSpeed + waypoint->maxAcceleration*waypoint->length));
+		if(fabs(speed - waypoint->backwardSpeed) < 1e-6)
+			break;
+		waypoint->backwardSpeed = speed;
+	}
+	
+	for(index = this->lockedIndex; index < this->lastIndex; index++)
+	{
+		waypoint = this->getWaypoint(index);
+		next = this->getWaypoint(index + 1);
+		speed = sqrt(waypoint->speed*waypoint->speed + waypoint->maxAcceleration*waypoint->length);
+		next->speed = fmin(next->backwardSpeed, speed);
+	}
+}
+
+
+/*
+ * Start the segment from the current waypoint: the speed at its end is fixed, and the pieces of
+ * the trapezoidal profile and the blend of the next corner are computed.
+ */
+void LiCAS_WaypointBlender::startSegment()
+{
+	LiCAS_BLEND_WAYPOINT * waypoint = this->getWaypoint(this->currentIndex);
+	LiCAS_BLEND_WAYPOINT * next = this->getWaypoint(this->currentIndex + 1);
+	float start[MAX_BLEND_DIMENSION];
+	float blendAcceleration[MAX_BLEND_DIMENSION];
+	float vIn = waypoint->speed;
+	float vOut = next->speed;
+	float vPeak = 0;
+	float a = waypoint->maxAcceleration;
+	float dIn = 0.5*vIn*vIn*waypoint->blendFactor;
+	float dOut = 0.5*vOut*vOut*next->blendFactor;
+	float freeLength = 0;
+	float lengthAcc = 0;
+	float lengthDec = 0;
+	float lengthCruise = 0;
+	float blendTime = 0;
+	int k = 0;
+	
+	
+	this->lockedIndex = this->currentIndex + 1;
+	this->numPieces = 0;
+	this->pieceIndex = 0;
+	this->pieceTime = 0;
+	this->flagMoving = 1;
+	
+	// Trapezoidal profile between the corner blends
+	freeLength = fmax(waypoint->length - dIn - dOut, 0);
+	vPeak = sqrt(a*freeLength + 0.5*(vIn*vIn + vOut*vOut));
+	vPeak = fmax(fmin(vPeak, waypoint->maxSpeed), fmax(vIn, vOut));
+	lengthAcc = (vPeak*vPeak - vIn*vIn)/(2*a);
+	lengthDec = (vPeak*vPeak - vOut*vOut)/(2*a);
+	lengthCruise = fmax(freeLength - lengthAcc - lengthDec, 0);
+	
+	for(k = 0; k < MAX_BLEND_DIMENSION; k++)
+		start[k] = waypoint->position[k] + dIn*waypoint->direction[k];
+	this->addPiece(start, waypoint->direction, vIn, a, (vPeak - vIn)/a);
+	for(k = 0; k < MAX_BLEND_DIMENSION; k++)
+		start[k] += lengthAcc*waypoint->direction[k];
+	this->addPiece(start, waypoint->direction, vPeak, 0, (vPeak > 0) ? lengthCruise/vPeak : 0);
+	for(k = 0; k < MAX_BLEND_DIMENSION; k++)
+		start[k] += lengthCruise*waypoint->direction[k];
+	this->addPiece(start, waypoint->direction, vPeak, -a, (vPeak - vOut)/a);
+	
+	// Blend of the corner at the end of the segment (the next segment exists if vOut > 0)
+	blendTime = vOut*next->blendFactor;
+	if(blendTime > 0)
+	{
+		for(k = 0; k < MAX_BLEND_DIMENSION; k++)
+		{
+			start[k] = next->position[k] - dOut*waypoint->direction[k];
+			blendAcceleration[k] = vOut*(next->direction[k] - waypoint->direction[k])/blendTime;
+		}
+		this->addPiece(start, waypoint->direction, vOut, 0, blendTime);
+		for(k = 0; k < MAX_BLEND_DIMENSION; k++)
+			this->pieces[this->numPieces - 1].a[k] = blendAcceleration[k];
+	}
+	
+	// Segment shorter than the numerical resolution: single piece at the end point
+	if(this->numPieces == 0)
+		this->addPiece(next->position, waypoint->direction, 0, 0, 1e-9);
+}
+
+
+/*
+ * Add a piece of the trajectory along a direction (ignored if its duration is null)
+ */
+void LiCAS_WaypointBlender::addPiece(const float * p0, const float * direction, float v0, float a, float duration)
+{
+	LiCAS_TRAJECTORY_PIECE * piece = NULL;
+	int k = 0;
+	
+	
+	if(duration > 0 && this->numPieces < MAX_SEGMENT_PIECES)
+	{
+		piece = &this->pieces[this->numPieces];
+		for(k = 0; k < MAX_BLEND_DIMENSION; k++)
+		{
+			piece->p0[k] = p0[k];
+			piece->v0[k] = v0*direction[k];
+			piece->a[k] = a*direction[k];
+		}
+		piece->duration = duration;
+		this->numPieces++;
+	}
+}
+
@@ -0,0 +1,191 @@
+/*
+ *
+ * LiCAS Motion - LiCAS_WaypointBlender.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Look-ahead blending of a sequence of waypoints (joint positions of one or both arms, or TCP
+ * positions) into a continuous motion. The waypoints are joined by straight segments, and the
+ * corners are rounded with parabolic blends (constant acceleration) whose deviation from the
+ * waypoint is below the blending tolerance, so the arm does not stop at every waypoint. The speed
+ * at each corner is limited by the tolerance, the velocity and acceleration limits of each axis
+ * and the length of the adjacent segments. The speeds are planned over the buffered waypoints
+ * with a backward pass (the motion can always stop at the last waypoint) and a forward pass
+ * (reachable speeds), and each segment is executed with a trapezoidal speed profile.
+ *
+ * The waypoints are appended incrementally while the motion is running: the planning of a new
+ * waypoint is bounded by the buffer size (MAX_BLEND_WAYPOINTS), and the per-cycle update only
+ * evaluates the current piece of the trajectory. The speed at the end of the segment in execution
+ * is fixed when the segment starts, so the waypoints have to be appended at least one segment
+ * ahead: if the buffer runs out the arm stops at the last waypoint and resumes when new ones are
+ * appended.
+ *
+ * Example (joint positions of both arms streamed at 500 Hz):
+ *
+ * 	LiCAS_WaypointBlender blender(2*NUM_ARM_JOINTS);
+ *
+ * 	blender.setLimits(maxVelocity, maxAcceleration);
+ * 	blender.setTolerance(0.02);
+ * 	blender.reset(q);
+ * 	blender.addWaypoint(q1);
+ * 	blender.addWaypoint(q2);
+ * 	...
+ * 	blender.update(0.002, q, dq);
+ * 	licas_eci->sendJointPositionRef(&q[0], &q[NUM_ARM_JOINTS], 0.002);
+ *
+ */
+
+#ifndef LICAS_WAYPOINT_BLENDER_H_
+#define LICAS_WAYPOINT_BLENDER_H_
+
+
+// Standard library
+#include <stdint.h>
+#include <math.h>
+
+
+// Constant definition
+#define MAX_BLEND_DIMENSION		8		// Maximum number of axes (joints of both arms)
+#define MAX_BLEND_WAYPOINTS		64		// Size of the waypoint buffer (power of 2)
+#define MAX_SEGMENT_PIECES		4		// Acceleration, cruise, deceleration and corner blend
+#define MIN_SEGMENT_LENGTH		1e-6	// Waypoints closer than this to the previous one are ignored
+
+
+// Waypoint of the buffer and segment from it to the next waypoint
+typedef struct
+{
+	float position[MAX_BLEND_DIMENSION];
+	float direction[MAX_BLEND_DIMENSION];	// Unit vector of the segment to the next waypoint
+	float length;							// Length of the segment to the next waypoint
+	float maxSpeed;							// Maximum speed along the segment (velocity limits)
+	float maxAcceleration;					// Maximum acceleration along the segment (acceleration limits)
+	float blendFactor;						// Duration of the corner blend per unit of speed in [s^2/unit]
+	float junctionSpeed;					// Maximum speed at the corner (tolerance and limits)
+	float backwardSpeed;					// Maximum speed to stop at the last waypoint
+	float speed;							// Planned speed at the waypoint
+} LiCAS_BLEND_WAYPOINT;
+
+
+// Piece of the trajectory with constant acceleration: p(t) = p0 + v0*t + 0.5*a*t^2
+typedef struct
+{
+	float p0[MAX_BLEND_DIMENSION];
+	float v0[MAX_BLEND_DIMENSION];
+	float a[MAX_BLEND_DIMENSION];
+	float duration;
+} LiCAS_TRAJECTORY_PIECE;
+
+
+class LiCAS_WaypointBlender
+{
+public:
+
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Number of axes of the waypoints (up to MAX_BLEND_DIMENSION)
+	 * */
+	LiCAS_WaypointBlender(int _dimension);
+	
+	
+	/*
+	 * Set the velocity and acceleration limits of each axis (positive values, in units/s and
+	 * units/s^2). They apply to the waypoints appended after the call.
+	 */
+	int setLimits(const float * maxVelocity, const float * maxAcceleration);
+	
+	
+	/*
+	 * Set the maximum deviation of the corner blends from the waypoints (0: stop at every waypoint)
+	 */
+	void setTolerance(float _tolerance);
+	
+	
+	/*
+	 * Discard the buffered waypoints and set the initial position at rest
+	 */
+	void reset(const float * position);
+	
+	
+	/*
+	 * Append a waypoint to the buffer. Returns 0 if the waypoint was appended (or ignored for being
+	 * too close to the previous one), 1 if the buffer is full, or 2 if the limits are not set.
+	 */
+	int addWaypoint(const float * waypoint);
+	
+	
+	/*
+	 * Advance the motion a time step in [s]. Returns 1 while the arm is moving or 0 when it is at
+	 * rest at the last waypoint.
+	 *
+	 * Parameters:
+	 * 	(1) Time step in [s]
+	 * 	(2) Output position
+	 * 	(3) Output velocity (can be NULL)
+	 */
+	int update(float dt, float * position, float * velocity);
+	
+	
+	/*
+	 * Returns 1 if there is motion pending
+	 */
+	int isMoving() const;
+	
+	
+	/*
+	 * Number of waypoints not reached yet
+	 */
+	int getNumPendingWaypoints() const;
+	
+	
+	/*
+	 * Index of the waypoint at the start of the segment in execution (0: position of the reset)
+	 */
+	int64_t getWaypointIndex() const;
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	int dimension;
+	float maxVelocity[MAX_BLEND_DIMENSION];
+	float maxAcceleration[MAX_BLEND_DIMENSION];
+	float tolerance;
+	int flagLimits;
+	
+	// Waypoint buffer: absolute indexes since the reset
+	LiCAS_BLEND_WAYPOINT waypoints[MAX_BLEND_WAYPOINTS];
+	int64_t currentIndex;		// Start of the segment in execution (or waypoint where the arm is at rest)
+	int64_t lockedIndex;		// Last waypoint with fixed speed
+	int64_t lastIndex;			// Last waypoint of the buffer
+	
+	// Pieces of the segment in execution
+	LiCAS_TRAJECTORY_PIECE pieces[MAX_SEGMENT_PIECES];
+	int numPieces;
+	int pieceIndex;
+	float pieceTime;
+	int flagMoving;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	LiCAS_BLEND_WAYPOINT * getWaypoint(int64_t index);
+	
+	void computeJunction(int64_t index);
+	
+	void planSpeeds();
+	
+	void startSegment();
+	
+	void addPiece(const float * p0, const float * direction, float v0, float a, float duration);
+};
+
+#endif
+
@@ -0,0 +1,241 @@
+/*
+ *
+ * LiCAS Simulator through UDP sockets - LiCAS_BasePoseSimulator.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * The orientation of the platform is a yaw rotation followed by a roll rotation, q = qz(yaw)*qx(roll),
+ * so the angular velocity in the base frame is (droll, sin(roll)*dyaw, cos(roll)*dyaw).
+ *
+ */
+
+#include "LiCAS_BasePoseSimulator.h"
+
+
+// Amplitude in [m] or [rad] and frequency in [Hz] of the disturbances of the platform
+static const float swayAmplitude[3] = {0.05, 0.04, 0.02};
+static const float swayFrequency[3] = {0.5, 0.7, 1.1};
+static const float swayPhase[3] = {0.0, 1.0, 0.5};
+static const float hoverHeight = 1.0;
+static const float rollAmplitude = 0.08;
+static const float rollFrequency = 0.9;
+static const float yawAmplitude = 0.15;
+static const float yawFrequency = 0.4;
+
+
+static double getMonotonicTime()
+{
+	struct timespec t;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	
+	
+	return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+
+/*
+ * Constructor
+ * */
+LiCAS_BasePoseSimulator::LiCAS_BasePoseSimulator()
+{
+	this->socketSender = -1;
+	this->rate = 0;
+	this->age = 0;
+	this->tStart = 0;
+	this->numPackets = 0;
+	this->flagTerminateThread = 0;
+}
+
+
+/*
+ * Destructor
+ * */
+LiCAS_BasePoseSimulator::~LiCAS_BasePoseSimulator()
+{
+	if(this->socketSender >= 0)
+		this->closePublisher();
+}
+
+
+/*
+ * Open the UDP socket and start the publication thread.
+ *
+ * Parameters:
+ * 	(1) IP address of the computer executing the LiCAS ECI
+ *	(2) UDP port of the base pose data packets of the LiCAS ECI
+ *	(3) Rate of the base pose data packets in [Hz]
+ *	(4) Age of the pose measurements when they are sent in [s]
+ */
+int LiCAS_BasePoseSimulator::openPublisher(const std::string &_ECI_IP_Address, int _UDP_TxPort, float _rate, float _age)
+{
+	struct hostent * host;
+	int errorCode = 0;
+	
+	
+	this->socketSender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if(this->socketSender < 0)
+	{
+		errorCode = 1;
+		printf("ERROR: [in LiCAS_BasePoseSimulator::openPublisher] could not open socket.\n");
+	}
+	else
+	{
+		host = gethostbyname(_ECI_IP_Address.c_str());
+		if(host == NULL)
+		{
+			errorCode = 2;
+			close(this->socketSender);
+			this->socketSender = -1;
+			printf("ERROR: [in LiCAS_BasePoseSimulator::openPublisher] could not get host by name.\n");
+		}
+		else
+		{
+			bzero((char*)&addrECI, sizeof(struct sockaddr_in));
+			this->addrECI.sin_family = AF_INET;
+			bcopy((char*)host->h_addr, (char*)&addrECI.sin_addr.s_addr, host->h_length);
+			this->addrECI.sin_port = htons(_UDP_TxPort);
+		}
+	}
+	
+	if(errorCode == 0)
+	{
+		this->rate = _rate;
+		this->age = _age;
+		this->numPackets = 0;
+		this->flagTerminateThread = 0;
+		this->tStart = getMonotonicTime();
+		pthread_create(&publicationThread, NULL, &LiCAS_BasePoseSimulator::publicationThreadEntry, this);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Stop the publication thread and close the UDP socket.
+ */
+int LiCAS_BasePoseSimulator::closePublisher()
+{
+	int errorCode = 0;
+	
+	
+	if(this->socketSender >= 0)
+	{
+		this->flagTerminateThread = 1;
+		pthread_join(this->publicationThread, NULL);
+		close(this->socketSender);
+		this->socketSender = -1;
+	}
+	else
+		errorCode = 1;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Number of base pose data packets sent
+ */
+uint64_t LiCAS_BasePoseSimulator::getNumPackets()
+{
+	return this->numPackets;
+}
+
+
+/*
+ * Time of the start of the motion in the CLOCK_MONOTONIC clock in [s]
+ */
+double LiCAS_BasePoseSimulator::getStartTime()
+{
+	return this->tStart;
+}
+
+
+/*
+ * Pose of the simulated platform at a given time since the start of the motion
+ */
+void LiCAS_BasePoseSimulator::getPose(double t, LiCAS_BASE_POSE_DATA_PACKET * dataPacketBasePose)
+{
+	double w = 0;
+	float roll = rollAmplitude*sin(2*M_PI*rollFrequency*t);
+	float droll = 2*M_PI*rollFrequency*rollAmplitude*cos(2*M_PI*rollFrequency*t);
+	float yaw = yawAmplitude*sin(2*M_PI*yawFrequency*t);
+	float dyaw = 2*M_PI*yawFrequency*yawAmplitude*cos(2*M_PI*yawFrequency*t);
+	int k = 0;
+	
+	
+	dataPacketBasePose->packetID = LiCAS_PACKET_ID_BASE_POSE;
+	for(k = 0; k < 3; k++)
+	{
+		w = 2*M_PI*swayFrequency[k];
+		dataPacketBasePose->position[k] = swayAmplitude[k]*sin(w*t + swayPhase[k]);
+		dataPacketBasePose->velocity[k] = swayAmplitude[k]*w*cos(w*t + swayPhase[k]);
+	}
+	dataPacketBasePose->position[2] += hoverHeight;
+	
+	// q = qz(yaw)*qx(roll)
+	dataPacketBasePose->orientation[0] = cos(0.5*yaw)*cos(0.5*roll);
+	dataPacketBasePose->orientation[1] = cos(0.5*yaw)*sin(0.5*roll);
+	dataPacketBasePose->orientation[2] = sin(0.5*yaw)*sin(0.5*roll);
+	dataPacketBasePose->orientation[3] = sin(0.5*yaw)*cos(0.5*roll);
+	dataPacketBasePose->angularVelocity[0] = droll;
+	dataPacketBasePose->angularVelocity[1] = sin(roll)*dyaw;
+	dataPacketBasePose->angularVelocity[2] = cos(roll)*dyaw;
+}
+
+
+/*
+ * Entry point of the publication thread
+ */
+void * LiCAS_BasePoseSimulator::publicationThreadEntry(void * arg)
+{
+	((LiCAS_BasePoseSimulator*)arg)->publicationThreadFunction();
+	
+	
+	return NULL;
+}
+
+
+void LiCAS_BasePoseSimulator::publicationThreadFunction()
+{
+	LiCAS_BASE_POSE_DATA_PACKET dataPacketBasePose;
+	struct timespec deadline;
+	long period_ns = (long)(1e9/this->rate);
+	double t = 0;
+	uint32_t sequence = 0;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	while(this->flagTerminateThread == 0)
+	{
+		// Pose measured the given age before sending
+		t = getMonotonicTime() - this->tStart;
+		getPose(t - this->age, &dataPacketBasePose);
+		dataPacketBasePose.sequence = sequence++;
+		dataPacketBasePose.timeStamp = (float)(t - this->age);
+		dataPacketBasePose.age = this->age;
+		if(sendto(this->socketSender, (char*)&dataPacketBasePose, sizeof(LiCAS_BASE_POSE_DATA_PACKET), 0, (struct sockaddr*)&addrECI, sizeof(struct sockaddr)) == sizeof(LiCAS_BASE_POSE_DATA_PACKET))
+			this->numPackets++;
+		
+		// Wait until the next period
+		deadline.tv_nsec += period_ns;
+		while(deadline.tv_nsec >= 1000000000L)
+		{
+			deadline.tv_nsec -= 1000000000L;
+			deadline.tv_sec++;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+	}
+}
+
@@ -0,0 +1,123 @@
+/*
+ *
+ * LiCAS Simulator through UDP sockets - LiCAS_BasePoseSimulator.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Local stand-in of the IMU/odometry of the aerial platform. It sends the base pose data packet at
+ * a fixed rate (up to 1 kHz) with the pose of a platform hovering under disturbances: sway of the
+ * position and oscillations of the roll and yaw angles. Each packet carries the pose measured a
+ * given age before the sending time, as the estimation filter of a real platform does.
+ *
+ */
+
+#ifndef LICAS_BASE_POSE_SIMULATOR_H_
+#define LICAS_BASE_POSE_SIMULATOR_H_
+
+
+// Standard library
+#include <string>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_Packets.h"
+
+
+class LiCAS_BasePoseSimulator
+{
+public:
+
+	/*
+	 * Constructor
+	 * */
+	LiCAS_BasePoseSimulator();
+	
+	
+	/*
+	 * Destructor
+	 * */
+	virtual ~LiCAS_BasePoseSimulator();
+	
+	
+	/*
+	 * Open the UDP socket and start the publication thread.
+	 *
+	 * Parameters:
+	 * 	(1) IP address of the computer executing the LiCAS ECI
+	 *	(2) UDP port of the base pose data packets of the LiCAS ECI
+	 *	(3) Rate of the base pose data packets in [Hz]
+	 *	(4) Age of the pose measurements when they are sent in [s]
+	 */
+	int openPublisher(const std::string &_ECI_IP_Address, int _UDP_TxPort, float _rate, float _age);
+	
+	
+	/*
+	 * Stop the publication thread and close the UDP socket.
+	 */
+	int closePublisher();
+	
+	
+	/*
+	 * Number of base pose data packets sent
+	 */
+	uint64_t getNumPackets();
+	
+	
+	/*
+	 * Time of the start of the motion in the CLOCK_MONOTONIC clock in [s]
+	 */
+	double getStartTime();
+	
+	
+	/*
+	 * Pose of the simulated platform at a given time since the start of the motion
+	 *
+	 * Parameters:
+	 * 	(1) Time since the start of the motion in [s]
+	 * 	(2) Data packet with the pose (position, orientation and velocities)
+	 */
+	static void getPose(double t, LiCAS_BASE_POSE_DATA_PACKET * dataPacketBasePose);
+	
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	pthread_t publicationThread;
+	
+	struct sockaddr_in addrECI;
+	int socketSender;
+	float rate;
+	float age;
+	double tStart;
+	
+	uint64_t numPackets;
+	int flagTerminateThread;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	
+	static void * publicationThreadEntry(void * arg);
+	
+	void publicationThreadFunction();
+};
+
+#endif
+
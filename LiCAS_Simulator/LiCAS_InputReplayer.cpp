@@ -0,0 +1,295 @@
+/*
+ *
+ * LiCAS Simulator through UDP sockets - LiCAS_InputReplayer.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * The packets are sent in the order of the recording, so a delay longer than the period of the
+ * samples also delays the following packets, as the queue of a real link does. In a loop, the time
+ * stamp keeps increasing: each replay starts one period after the end of the previous one.
+ *
+ */
+
+#include "LiCAS_InputReplayer.h"
+
+
+static double getMonotonicTime()
+{
+	struct timespec t;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	
+	
+	return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+
+/*
+ * Constructor
+ * */
+LiCAS_InputReplayer::LiCAS_InputReplayer()
+{
+	this->socketSender = -1;
+	this->deviceID = 0;
+	this->jitter = 0;
+	this->flagLoop = 0;
+	this->tStart = 0;
+	this->numPackets = 0;
+	this->flagFinished = 0;
+	this->flagTerminateThread = 0;
+}
+
+
+/*
+ * Destructor
+ * */
+LiCAS_InputReplayer::~LiCAS_InputReplayer()
+{
+	if(this->socketSender >= 0)
+		this->closeReplayer();
+}
+
+
+/*
+ * Load a recording file
+ */
+int LiCAS_InputReplayer::load(const char * fileName)
+{
+	FILE * file = NULL;
+	char line[512];
+	float value[1 + MAX_INPUT_AXES];
+	int numValues = 0;
+	int errorCode = 0;
+	
+	
+	this->samples.clear();
+	file = fopen(fileName, "r");
+	if(file == NULL)
+		return 1;
+	
+	while(errorCode == 0 && fgets(line, sizeof(line), file) != NULL)
+	{
+		if(line[0] == '#' || line[0] == '\n')
+			continue;
+		numValues = sscanf(line, "%f %f %f %f %f %f %f %f %f", &value[0], &value[1], &value[2], &value[3], &value[4],
+			&value[5], &value[6], &value[7], &value[8]);
+		if(numValues < 2 || this->addSample(value[0], &value[1], numValues - 1) != 0)
+			errorCode = 2;
+	}
+	fclose(file);
+	if(this->samples.size() == 0)
+		errorCode = 2;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Add a sample at the end of the recording
+ */
+int LiCAS_InputReplayer::addSample(double t, const float * axes, int numAxes)
+{
+	LiCAS_INPUT_SAMPLE sample;
+	int k = 0;
+	
+	
+	if(numAxes < 1 || numAxes > MAX_INPUT_AXES || (this->samples.size() > 0 && t <= this->samples.back().t))
+		return 1;
+	
+	bzero(&sample, sizeof(LiCAS_INPUT_SAMPLE));
+	sample.t = t;
+	sample.numAxes = numAxes;
+	for(k = 0; k < numAxes; k++)
+		sample.axes[k] = axes[k];
+	this->samples.push_back(sample);
+	
+	
+	return 0;
+}
+
+
+/*
+ * Open the UDP socket and start the replay thread.
+ *
+ * Parameters:
+ * 	(1) IP address of the computer receiving the operator input
+ *	(2) UDP port of the operator input data packets
+ *	(3) Identifier of the input device
+ *	(4) Maximum random delay of the packets in [s]
+ *	(5) Replay the recording in a loop (1) or once (0)
+ */
+int LiCAS_InputReplayer::openReplayer(const std::string &_IP_Address, int _UDP_TxPort, int _deviceID, float _jitter, int _flagLoop)
+{
+	struct hostent * host;
+	int errorCode = 0;
+	
+	
+	if(this->samples.size() == 0)
+	{
+		printf("ERROR: [in LiCAS_InputReplayer::openReplayer] no samples to replay.\n");
+		return 3;
+	}
+	
+	this->socketSender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if(this->socketSender < 0)
+	{
+		errorCode = 1;
+		printf("ERROR: [in LiCAS_InputReplayer::openReplayer] could not open socket.\n");
+	}
+	else
+	{
+		host = gethostbyname(_IP_Address.c_str());
+		if(host == NULL)
+		{
+			errorCode = 2;
+			close(this->socketSender);
+			this->socketSender = -1;
+			printf("ERROR: [in LiCAS_InputReplayer::openReplayer] could not get host by name.\n");
+		}
+		else
+		{
+			bzero((char*)&addrReceiver, sizeof(struct sockaddr_in));
+			this->addrReceiver.sin_family = AF_INET;
+			bcopy((char*)host->h_addr, (char*)&addrReceiver.sin_addr.s_addr, host->h_length);
+			this->addrReceiver.sin_port = htons(_UDP_TxPort);
+		}
+	}
+	
+	if(errorCode == 0)
+	{
+		this->deviceID = _deviceID;
+		this->jitter = _jitter;
+		this->flagLoop = _flagLoop;
+		this->numPackets = 0;
+		this->flagFinished = 0;
+		this->flagTerminateThread = 0;
+		this->tStart = getMonotonicTime();
+		pthread_create(&replayThread, NULL, &LiCAS_InputReplayer::replayThreadEntry, this);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Stop the replay thread and close the UDP socket.
+ */
+int LiCAS_InputReplayer::closeReplayer()
+{
+	int errorCode = 0;
+	
+	
+	if(this->socketSender >= 0)
+	{
+		this->flagTerminateThread = 1;
+		pthread_join(this->replayThread, NULL);
+		close(this->socketSender);
+		this->socketSender = -1;
+	}
+	else
+		errorCode = 1;
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Number of operator input data packets sent
+ */
+uint64_t LiCAS_InputReplayer::getNumPackets()
+{
+	return this->numPackets;
+}
+
+
+/*
+ * Time of the first sample of the recording in the CLOCK_MONOTONIC clock in [s]
+ */
+double LiCAS_InputReplayer::getStartTime()
+{
+	return this->tStart;
+}
+
+
+/*
+ * The recording has been replayed
+ */
+int LiCAS_InputReplayer::isFinished()
+{
+	return this->flagFinished;
+}
+
+
+/*
+ * Entry point of the replay thread
+ */
+void * LiCAS_InputReplayer::replayThreadEntry(void * arg)
+{
+	((LiCAS_InputReplayer*)arg)->replayThreadFunction();
+	
+	
+	return NULL;
+}
+
+
+void LiCAS_InputReplayer::replayThreadFunction()
+{
+	LiCAS_OPERATOR_INPUT_DATA_PACKET dataPacketInput;
+	struct timespec deadline;
+	unsigned int seed = (unsigned int)this->deviceID + 1;
+	double duration = 0;
+	double t_device = 0;
+	double t_send = 0;
+	uint32_t sequence = 0;
+	size_t numSamples = this->samples.size();
+	size_t index = 0;
+	int numLoops = 0;
+	int k = 0;
+	
+	
+	// Duration of the recording, plus one period for the next replay in a loop
+	duration = this->samples.back().t - this->samples.front().t;
+	duration += (numSamples > 1) ? duration/(numSamples - 1) : 0.01;
+	
+	bzero(&dataPacketInput, sizeof(LiCAS_OPERATOR_INPUT_DATA_PACKET));
+	dataPacketInput.packetID = LiCAS_PACKET_ID_OPERATOR_INPUT;
+	dataPacketInput.deviceID = (uint8_t)this->deviceID;
+	while(this->flagTerminateThread == 0 && this->flagFinished == 0)
+	{
+		// Wait until the time of the sample plus the random delay
+		t_device = this->samples[index].t - this->samples.front().t + numLoops*duration;
+		t_send = this->tStart + t_device + this->jitter*rand_r(&seed)/(double)RAND_MAX;
+		deadline.tv_sec = (time_t)t_send;
+		deadline.tv_nsec = (long)(1e9*(t_send - deadline.tv_sec));
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+		
+		dataPacketInput.sequence = sequence++;
+		dataPacketInput.timeStamp = (float)t_device;
+		dataPacketInput.numAxes = (uint8_t)this->samples[index].numAxes;
+		for(k = 0; k < MAX_INPUT_AXES; k++)
+			dataPacketInput.axes[k] = this->samples[index].axes[k];
+		if(sendto(this->socketSender, (char*)&dataPacketInput, sizeof(LiCAS_OPERATOR_INPUT_DATA_PACKET), 0, (struct sockaddr*)&addrReceiver, sizeof(struct sockaddr)) == sizeof(LiCAS_OPERATOR_INPUT_DATA_PACKET))
+			this->numPackets++;
+		
+		index++;
+		if(index == numSamples)
+		{
+			index = 0;
+			numLoops++;
+			if(this->flagLoop == 0)
+				this->flagFinished = 1;
+		}
+	}
+}
+
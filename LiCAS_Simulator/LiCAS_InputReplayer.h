@@ -0,0 +1,154 @@
+/*
+ *
+ * LiCAS Simulator through UDP sockets - LiCAS_InputReplayer.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Local stand-in of an operator input device (joystick, haptic device, motion capture). It replays
+ * a recording of the device, sending each sample as an operator input data packet at its recorded
+ * time, delayed by a random time up to a given jitter (network and USB polling of a real device).
+ * The time stamp of the packets is the recorded time, in the clock of the device. A recording file
+ * has the time in [s] and the value of each axis per line (t a0 a1 ...), with lines starting with
+ * '#' as comments.
+ *
+ */
+
+#ifndef LICAS_INPUT_REPLAYER_H_
+#define LICAS_INPUT_REPLAYER_H_
+
+
+// Standard library
+#include <string>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <vector>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_Packets.h"
+
+
+// Sample of a recording of an input device
+typedef struct
+{
+	double t;						// Time of the sample in [s]
+	float axes[MAX_INPUT_AXES];
+	int numAxes;
+} LiCAS_INPUT_SAMPLE;
+
+
+class LiCAS_InputReplayer
+{
+public:
+
+	/*
+	 * Constructor
+	 * */
+	LiCAS_InputReplayer();
+	
+	
+	/*
+	 * Destructor
+	 * */
+	virtual ~LiCAS_InputReplayer();
+	
+	
+	/*
+	 * Load a recording file, replacing the current samples. Returns 0 on success, 1 if the file could
+	 * not be opened, or 2 if the format is not valid (no samples, or times not increasing).
+	 */
+	int load(const char * fileName);
+	
+	
+	/*
+	 * Add a sample at the end of the recording. Returns 1 if its time is not after the last sample.
+	 *
+	 * Parameters:
+	 * 	(1) Time of the sample in [s]
+	 * 	(2) Value of each axis
+	 * 	(3) Number of axes (up to MAX_INPUT_AXES)
+	 */
+	int addSample(double t, const float * axes, int numAxes);
+	
+	
+	/*
+	 * Open the UDP socket and start the replay thread.
+	 *
+	 * Parameters:
+	 * 	(1) IP address of the computer receiving the operator input
+	 *	(2) UDP port of the operator input data packets
+	 *	(3) Identifier of the input device
+	 *	(4) Maximum random delay of the packets in [s]
+	 *	(5) Replay the recording in a loop (1) or once (0)
+	 */
+	int openReplayer(const std::string &_IP_Address, int _UDP_TxPort, int _deviceID, float _jitter, int _flagLoop);
+	
+	
+	/*
+	 * Stop the replay thread and close the UDP socket.
+	 */
+	int closeReplayer();
+	
+	
+	/*
+	 * Number of operator input data packets sent
+	 */
+	uint64_t getNumPackets();
+	
+	
+	/*
+	 * Time of the first sample of the recording in the CLOCK_MONOTONIC clock in [s]
+	 */
+	double getStartTime();
+	
+	
+	/*
+	 * The recording has been replayed (always 0 in a loop)
+	 */
+	int isFinished();
+
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	pthread_t replayThread;
+	
+	std::vector<LiCAS_INPUT_SAMPLE> samples;
+	
+	struct sockaddr_in addrReceiver;
+	int socketSender;
+	int deviceID;
+	float jitter;
+	int flagLoop;
+	double tStart;
+	
+	uint64_t numPackets;
+	int flagFinished;
+	int flagTerminateThread;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	
+	static void * replayThreadEntry(void * arg);
+	
+	void replayThreadFunction();
+};
+
+#endif
+
@@ -0,0 +1,924 @@
+/*
+ *
+ * LiCAS Simulator through UDP sockets - LiCAS_Simulator.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Local stand-in of the LiCAS control program. It receives the control reference data packets
+ * sent by the LiCAS ECI, interpolates the joint references over the play time as the computer
+ * board does, and sends back the feedback data packet at a fixed rate. The joint torques are
+ * given by the inverse dynamics of the arms along the interpolated motion.
+ *
+ */
+
+#include "LiCAS_Simulator.h"
+
+
+
+/*
+ * Constructor
+ *
+ * Parameters:
+ * 	(1) Name of the simulated LiCAS (example: "LiCAS-A1-Sim")
+ * */
+LiCAS_Simulator::LiCAS_Simulator(const std::string &_LiCAS_Simulator_Name)
+{
+	int k = 0;
+	
+	
+	this->LiCAS_Simulator_Name = _LiCAS_Simulator_Name;
+	
+	// Init variables
+	this->UDP_RxPort = -1;
+	this->UDP_TxPort = -1;
+	this->socketSender = -1;
+	this->socketReceiver = -1;
+	this->loopRate = 0;
+	this->feedbackRate = 0;
+	this->feedbackDecimation = 1;
+	this->feedbackChannels = LiCAS_FEEDBACK_CHANNEL_ALL;
+	this->numFeedbackRateRequests = 0;
+	this->numPaths = 1;
+	for(k = 0; k < MAX_MULTIPATH_PATHS; k++)
+	{
+		this->pathSocketSender[k] = -1;
+		this->pathSocketReceiver[k] = -1;
+	}
+	this->mode = LiCAS_CONTROL_MODE_JOINT_POS;
+	this->playTime = 0;
+	this->t_ref = 0;
+	this->numControlRefPackets = 0;
+	this->numFeedbackPackets = 0;
+	this->numStatusPackets = 0;
+	this->flagTerminateThread = 0;
+	this->flagSimulationThreadTerminated = 0;
+	this->flagTrajectory = 0;
+	this->trajectoryID = 0;
+	this->trajectoryIndex = 0;
+	this->trajectoryOffset = 0;
+	this->trajectoryDelay = SIM_TRAJECTORY_DELAY;
+	this->numTrajectoryChunks = 0;
+	this->numTrajectoryUnderruns = 0;
+	bzero(this->trajectoryBufferValid, sizeof(this->trajectoryBufferValid));
+	this->dynamicsL = new LiCAS_ArmDynamics(LiCAS_ARM_LEFT, LiCAS_ArmKinematics::getDefaultGeometry(), LiCAS_ArmDynamics::getDefaultDynamics());
+	this->dynamicsR = new LiCAS_ArmDynamics(LiCAS_ARM_RIGHT, LiCAS_ArmKinematics::getDefaultGeometry(), LiCAS_ArmDynamics::getDefaultDynamics());
+	
+	clock_gettime(CLOCK_MONOTONIC, &tini);
+	
+	for(k = 0; k < 3; k++)
+	{
+		this->pL[k] = 0;
+		this->pR[k] = 0;
+		this->pL_ini[k] = 0;
+		this->pR_ini[k] = 0;
+		this->pL_ref[k] = 0;
+		this->pR_ref[k] = 0;
+	}
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		this->qL[k] = 0;
+		this->qR[k] = 0;
+		this->dqL[k] = 0;
+		this->dqR[k] = 0;
+		this->tauL[k] = 0;
+		this->tauR[k] = 0;
+		this->pwmL[k] = 0;
+		this->pwmR[k] = 0;
+		this->tauL_ref[k] = 0;
+		this->tauR_ref[k] = 0;
+		this->qL_ini[k] = 0;
+		this->qR_ini[k] = 0;
+		this->qL_ref[k] = 0;
+		this->qR_ref[k] = 0;
+	}
+}
+
+
+/*
+ * Destructor
+ * */
+LiCAS_Simulator::~LiCAS_Simulator()
+{
+	delete this->dynamicsL;
+	delete this->dynamicsR;
+}
+
+
+/*
+ * Open the UDP sockets and start the simulation thread.
+ *
+ * Parameters:
+ * 	(1) IP address of the computer executing the LiCAS ECI
+ *	(2) UDP port for receiving the control references (Tx port of the LiCAS ECI)
+ *	(3) UDP port for sending the feedback data packet (Rx port of the LiCAS ECI)
+ *	(4) Rate of the simulation loop and initial rate of the feedback data packet in [Hz]
+ */
+int LiCAS_Simulator::openSimulator(const std::string &_ECI_IP_Address, int _UDP_RxPort, int _UDP_TxPort, float _feedbackRate)
+{
+	struct sockaddr_in addrReceiver;
+	struct hostent * host;
+	int errorCode = 0;
+	
+	
+	// Open the socket for sending the feedback data packet
+	this->socketSender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if(this->socketSender < 0)
+	{
+		errorCode = 1;
+		printf("ERROR: [in LiCAS_Simulator::openSimulator] could not open socket.\n");
+	}
+	else
+	{
+		host = gethostbyname(_ECI_IP_Address.c_str());
+		if(host == NULL)
+		{
+			errorCode = 2;
+			close(this->socketSender);
+			printf("ERROR: [in LiCAS_Simulator::openSimulator] could not get host by name.\n");
+		}
+		else
+		{
+			bzero((char*)&addrECI, sizeof(struct sockaddr_in));
+			this->addrECI.sin_family = AF_INET;
+			bcopy((char*)host->h_addr, (char*)&addrECI.sin_addr.s_addr, host->h_length);
+			this->addrECI.sin_port = htons(_UDP_TxPort);
+		}
+	}
+	
+	// Open the socket for receiving the control references
+	if(errorCode == 0)
+	{
+		this->socketReceiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		bzero((char*)&addrReceiver, sizeof(struct sockaddr_in));
+		addrReceiver.sin_family = AF_INET;
+		addrReceiver.sin_addr.s_addr = INADDR_ANY;
+		addrReceiver.sin_port = htons(_UDP_RxPort);
+		if(this->socketReceiver < 0 || bind(this->socketReceiver, (struct sockaddr*)&addrReceiver, sizeof(addrReceiver)) < 0)
+		{
+			errorCode = 3;
+			close(this->socketSender);
+			if(this->socketReceiver >= 0)
+				close(this->socketReceiver);
+			printf("ERROR: [in LiCAS_Simulator::openSimulator] could not associate address to socket.\n");
+		}
+		else
+			fcntl(this->socketReceiver, F_SETFL, O_NONBLOCK);
+	}
+	
+	if(errorCode == 0)
+	{
+		this->UDP_RxPort = _UDP_RxPort;
+		this->UDP_TxPort = _UDP_TxPort;
+		this->loopRate = _feedbackRate;
+		this->feedbackRate = _feedbackRate;
+		this->feedbackDecimation = 1;
+		this->feedbackChannels = LiCAS_FEEDBACK_CHANNEL_ALL;
+		this->multipath.restart();
+		this->flagTerminateThread = 0;
+		this->flagSimulationThreadTerminated = 0;
+		
+		pthread_create(&simulationThread, NULL, &LiCAS_Simulator::simulationThreadEntry, this);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Add a path to the multipath redundant transport. The feedback is sent over the path from its own
+ * socket, so it leaves through the network interface of the path.
+ *
+ * Parameters:
+ * 	(1) IP address of the computer executing the LiCAS ECI through the path
+ *	(2) UDP port for receiving the control references through the path
+ *	(3) UDP port for sending the feedback data packet through the path
+ *	(4) Network interface of the path (NULL: given by the route to the LiCAS ECI)
+ */
+int LiCAS_Simulator::addPath(const std::string &_ECI_IP_Address, int _UDP_RxPort, int _UDP_TxPort, const char * interfaceName)
+{
+	struct sockaddr_in addrReceiver;
+	struct hostent * host;
+	int pathIndex = this->numPaths;
+	int socketPathSender = -1;
+	int socketPathReceiver = -1;
+	int errorCode = 0;
+	
+	
+	if(this->socketSender < 0 || pathIndex >= MAX_MULTIPATH_PATHS)
+	{
+		printf("ERROR: [in LiCAS_Simulator::addPath] the simulator is not open or the maximum number of paths is reached.\n");
+		return 1;
+	}
+	
+	host = gethostbyname(_ECI_IP_Address.c_str());
+	if(host == NULL)
+	{
+		errorCode = 2;
+		printf("ERROR: [in LiCAS_Simulator::addPath] could not get host by name.\n");
+	}
+	else
+	{
+		bzero((char*)&addrPath[pathIndex], sizeof(struct sockaddr_in));
+		this->addrPath[pathIndex].sin_family = AF_INET;
+		bcopy((char*)host->h_addr, (char*)&addrPath[pathIndex].sin_addr.s_addr, host->h_length);
+		this->addrPath[pathIndex].sin_port = htons(_UDP_TxPort);
+		
+		// Both sockets of the path bound to its network interface (requires the CAP_NET_RAW capability before Linux 5.7)
+		socketPathSender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		socketPathReceiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		if(socketPathSender < 0 || socketPathReceiver < 0 || (interfaceName != NULL &&
+			(setsockopt(socketPathSender, SOL_SOCKET, SO_BINDTODEVICE, interfaceName, strlen(interfaceName) + 1) != 0 ||
+			setsockopt(socketPathReceiver, SOL_SOCKET, SO_BINDTODEVICE, interfaceName, strlen(interfaceName) + 1) != 0)))
+		{
+			errorCode = 3;
+			printf("ERROR: [in LiCAS_Simulator::addPath] could not bind the sockets to the network interface of the path.\n");
+		}
+		else
+		{
+			bzero((char*)&addrReceiver, sizeof(struct sockaddr_in));
+			addrReceiver.sin_family = AF_INET;
+			addrReceiver.sin_addr.s_addr = INADDR_ANY;
+			addrReceiver.sin_port = htons(_UDP_RxPort);
+			if(bind(socketPathReceiver, (struct sockaddr*)&addrReceiver, sizeof(addrReceiver)) < 0)
+			{
+				errorCode = 4;
+				printf("ERROR: [in LiCAS_Simulator::addPath] could not associate address to socket.\n");
+			}
+			else
+				fcntl(socketPathReceiver, F_SETFL, O_NONBLOCK);
+		}
+	}
+	
+	if(errorCode != 0)
+	{
+		if(socketPathSender >= 0)
+			close(socketPathSender);
+		if(socketPathReceiver >= 0)
+			close(socketPathReceiver);
+	}
+	else
+	{
+		// The primary path is the path 0
+		this->addrPath[0] = this->addrECI;
+		this->pathSocketSender[0] = this->socketSender;
+		this->pathSocketReceiver[0] = this->socketReceiver;
+		this->pathSocketSender[pathIndex] = socketPathSender;
+		this->pathSocketReceiver[pathIndex] = socketPathReceiver;
+		this->multipath.setNumPaths(pathIndex + 1);
+		__atomic_store_n(&this->numPaths, pathIndex + 1, __ATOMIC_RELEASE);
+	}
+	
+	
+	return errorCode;
+}
+
+
+/*
+ * Copy the statistics of the paths of the multipath transport
+ */
+int LiCAS_Simulator::getPathStatistics(LiCAS_ECI_PATH_STATISTICS * pathStatistics)
+{
+	return this->multipath.getStatistics(pathStatistics);
+}
+
+
+/*
+ * Number of control reference data packets received
+ */
+uint64_t LiCAS_Simulator::getNumControlRefPackets()
+{
+	return this->numControlRefPackets;
+}
+
+
+/*
+ * Number of status and diagnostics data packets sent
+ */
+uint64_t LiCAS_Simulator::getNumStatusPackets()
+{
+	return this->numStatusPackets;
+}
+
+
+/*
+ * Number of feedback data packets sent
+ */
+uint64_t LiCAS_Simulator::getNumFeedbackPackets()
+{
+	return this->numFeedbackPackets;
+}
+
+
+/*
+ * Current rate of the feedback data packet in [Hz]
+ */
+float LiCAS_Simulator::getFeedbackRate()
+{
+	return this->feedbackRate;
+}
+
+
+/*
+ * Number of feedback rate request data packets received
+ */
+uint64_t LiCAS_Simulator::getNumFeedbackRateRequests()
+{
+	return this->numFeedbackRateRequests;
+}
+
+
+/*
+ * Delay of the setpoints of the trajectory buffer after their time in [s]
+ */
+void LiCAS_Simulator::setTrajectoryDelay(float _trajectoryDelay)
+{
+	this->trajectoryDelay = _trajectoryDelay;
+}
+
+
+/*
+ * Number of trajectory chunk data packets received
+ */
+uint64_t LiCAS_Simulator::getNumTrajectoryChunks()
+{
+	return this->numTrajectoryChunks;
+}
+
+
+/*
+ * Number of control cycles of a trajectory in which the next setpoint was not buffered
+ */
+uint64_t LiCAS_Simulator::getNumTrajectoryUnderruns()
+{
+	return this->numTrajectoryUnderruns;
+}
+
+
+/*
+ * Elapsed time since the creation of the simulator instance in [s]
+ */
+double LiCAS_Simulator::getElapsedTime()
+{
+	struct timespec tact;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &tact);
+	
+	
+	return (tact.tv_sec - tini.tv_sec) + 1e-9*(tact.tv_nsec - tini.tv_nsec);
+}
+
+
+/*
+ * Entry point of the simulation thread
+ */
+void * LiCAS_Simulator::simulationThreadEntry(void * arg)
+{
+	((LiCAS_Simulator*)arg)->simulationThreadFunction();
+	
+	
+	return NULL;
+}
+
+
+/*
+ * Take a new reference as the target of the interpolation from the current state
+ */
+void LiCAS_Simulator::processControlRefPacket(const LiCAS_CONTROL_REF_DATA_PACKET * controlRefDataPacket, double t)
+{
+	int k = 0;
+	
+	
+	// Joint torques applied on the arms (held by an operator): the position interpolation continues
+	if(controlRefDataPacket->mode == LiCAS_CONTROL_MODE_JOINT_TRQ)
+	{
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			this->tauL_ref[k] = controlRefDataPacket->refLJ[k];
+			this->tauR_ref[k] = controlRefDataPacket->refRJ[k];
+		}
+		this->numControlRefPackets++;
+		return;
+	}
+	
+	// A position reference interrupts the trajectory being followed
+	this->flagTrajectory = 0;
+	this->mode = controlRefDataPacket->mode;
+	this->playTime = controlRefDataPacket->playTime;
+	this->t_ref = t;
+	
+	for(k = 0; k < 3; k++)
+	{
+		this->pL_ini[k] = this->pL[k];
+		this->pR_ini[k] = this->pR[k];
+		this->pL_ref[k] = controlRefDataPacket->refLTCP[k];
+		this->pR_ref[k] = controlRefDataPacket->refRTCP[k];
+	}
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		this->qL_ini[k] = this->qL[k];
+		this->qR_ini[k] = this->qR[k];
+		this->qL_ref[k] = controlRefDataPacket->refLJ[k];
+		this->qR_ref[k] = controlRefDataPacket->refRJ[k];
+	}
+	
+	this->numControlRefPackets++;
+}
+
+
+/*
+ * Store the setpoints of a trajectory chunk in the trajectory buffer. The chunk of a new trajectory
+ * discards the buffered setpoints, and the arms hold their position until its first setpoint.
+ */
+void LiCAS_Simulator::processTrajectoryChunkPacket(const LiCAS_TRAJECTORY_CHUNK_DATA_PACKET * trajectoryChunkDataPacket, double t)
+{
+	uint32_t index = 0;
+	int position = 0;
+	int k = 0;
+	
+	
+	if(trajectoryChunkDataPacket->numSetpoints == 0 || trajectoryChunkDataPacket->numSetpoints > MAX_CHUNK_SETPOINTS ||
+		(trajectoryChunkDataPacket->mode != LiCAS_CONTROL_MODE_JOINT_POS && trajectoryChunkDataPacket->mode != LiCAS_CONTROL_MODE_TCP_POS))
+		return;
+	
+	if(this->flagTrajectory == 0 || trajectoryChunkDataPacket->trajectoryID != this->trajectoryID)
+	{
+		bzero(this->trajectoryBufferValid, sizeof(this->trajectoryBufferValid));
+		this->flagTrajectory = 1;
+		this->trajectoryID = trajectoryChunkDataPacket->trajectoryID;
+		this->trajectoryIndex = trajectoryChunkDataPacket->firstIndex;
+		this->trajectoryOffset = t - trajectoryChunkDataPacket->timeStamp;
+		this->mode = trajectoryChunkDataPacket->mode;
+		this->playTime = 0;
+		this->t_ref = t;
+		for(k = 0; k < 3; k++)
+		{
+			this->pL_ref[k] = this->pL[k];
+			this->pR_ref[k] = this->pR[k];
+		}
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			this->qL_ref[k] = this->qL[k];
+			this->qR_ref[k] = this->qR[k];
+		}
+	}
+	else if(trajectoryChunkDataPacket->mode != this->mode)
+		return;
+	else
+		this->trajectoryOffset = fmin(this->trajectoryOffset, t - trajectoryChunkDataPacket->timeStamp);
+	
+	// The setpoints already followed or beyond the capacity of the buffer are not stored
+	for(k = 0; k < trajectoryChunkDataPacket->numSetpoints; k++)
+	{
+		index = trajectoryChunkDataPacket->firstIndex + k;
+		if((int32_t)(index - this->trajectoryIndex) < 0 || index - this->trajectoryIndex >= SIM_TRAJECTORY_BUFFER_SIZE)
+			continue;
+		position = index & (SIM_TRAJECTORY_BUFFER_SIZE - 1);
+		this->trajectoryBuffer[position] = trajectoryChunkDataPacket->setpoints[k];
+		this->trajectoryBufferIndex[position] = index;
+		this->trajectoryBufferValid[position] = 1;
+	}
+	
+	this->numTrajectoryChunks++;
+}
+
+
+/*
+ * The setpoint with the given index is in the trajectory buffer
+ */
+int LiCAS_Simulator::isSetpointBuffered(uint32_t index)
+{
+	int position = index & (SIM_TRAJECTORY_BUFFER_SIZE - 1);
+	
+	
+	return (this->trajectoryBufferValid[position] == 1 && this->trajectoryBufferIndex[position] == index) ? 1 : 0;
+}
+
+
+/*
+ * Take the references of the trajectory at the given time, interpolated between the buffered
+ * setpoints (the lost setpoints are skipped). The last setpoint is held if the next one is not
+ * buffered.
+ */
+void LiCAS_Simulator::updateTrajectory(double t)
+{
+	const LiCAS_TRAJECTORY_SETPOINT * current = NULL;
+	const LiCAS_TRAJECTORY_SETPOINT * next = NULL;
+	float refL[NUM_ARM_JOINTS];
+	float refR[NUM_ARM_JOINTS];
+	double t_play = t - this->trajectoryOffset - this->trajectoryDelay;
+	float s = 0;
+	int j = 0;
+	int k = 0;
+	
+	
+	// Hold the position until the first setpoint
+	current = &this->trajectoryBuffer[this->trajectoryIndex & (SIM_TRAJECTORY_BUFFER_SIZE - 1)];
+	if(this->isSetpointBuffered(this->trajectoryIndex) == 0 || t_play < current->t)
+		return;
+	
+	// Advance to the segment of the play time
+	do
+	{
+		next = NULL;
+		for(j = 1; j <= MAX_CHUNK_SETPOINTS && next == NULL; j++)
+		{
+			if(this->isSetpointBuffered(this->trajectoryIndex + j) == 1)
+				next = &this->trajectoryBuffer[(this->trajectoryIndex + j) & (SIM_TRAJECTORY_BUFFER_SIZE - 1)];
+		}
+		if(next != NULL && next->t <= t_play)
+		{
+			this->trajectoryBufferValid[this->trajectoryIndex & (SIM_TRAJECTORY_BUFFER_SIZE - 1)] = 0;
+			this->trajectoryIndex += j - 1;
+			current = next;
+		}
+	} while(next != NULL && current == next);
+	
+	if(next != NULL)
+		s = (t_play - current->t)/(next->t - current->t);
+	else
+		this->numTrajectoryUnderruns++;
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		refL[k] = current->refL[k] + ((next != NULL) ? s*(next->refL[k] - current->refL[k]) : 0);
+		refR[k] = current->refR[k] + ((next != NULL) ? s*(next->refR[k] - current->refR[k]) : 0);
+	}
+	
+	// Followed at once by the interpolation of updateState()
+	for(k = 0; k < 3; k++)
+	{
+		this->pL_ref[k] = refL[k];
+		this->pR_ref[k] = refR[k];
+	}
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		this->qL_ref[k] = refL[k];
+		this->qR_ref[k] = refR[k];
+	}
+}
+
+
+/*
+ * Linear interpolation of the joint (or TCP) position towards the last reference over its play time.
+ * The state is evaluated at the end of the control period, so a reference received in this cycle
+ * already moves the arm (otherwise the references streamed at the feedback rate are never followed).
+ */
+void LiCAS_Simulator::updateState(double t, float dt)
+{
+	float ddqL[NUM_ARM_JOINTS];
+	float ddqR[NUM_ARM_JOINTS];
+	float qL_prev = 0;
+	float qR_prev = 0;
+	float dqL_prev = 0;
+	float dqR_prev = 0;
+	float s = 1;
+	int k = 0;
+	
+	
+	if(this->flagTrajectory == 1)
+		this->updateTrajectory(t + dt);
+	
+	if(this->playTime > 0)
+		s = (t + dt - this->t_ref)/this->playTime;
+	if(s > 1)
+		s = 1;
+	
+	if(this->mode == LiCAS_CONTROL_MODE_JOINT_POS)
+	{
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			qL_prev = this->qL[k];
+			qR_prev = this->qR[k];
+			dqL_prev = this->dqL[k];
+			dqR_prev = this->dqR[k];
+			if(s < 1)
+			{
+				this->qL[k] = this->qL_ini[k] + s*(this->qL_ref[k] - this->qL_ini[k]);
+				this->qR[k] = this->qR_ini[k] + s*(this->qR_ref[k] - this->qR_ini[k]);
+			}
+			else
+			{
+				this->qL[k] = this->qL_ref[k];
+				this->qR[k] = this->qR_ref[k];
+			}
+			this->dqL[k] = (this->qL[k] - qL_prev)/dt;
+			this->dqR[k] = (this->qR[k] - qR_prev)/dt;
+			ddqL[k] = (this->dqL[k] - dqL_prev)/dt;
+			ddqR[k] = (this->dqR[k] - dqR_prev)/dt;
+		}
+		
+		// Joint torques needed to follow the motion, plus the joint torque references
+		this->dynamicsL->inverseDynamics(this->qL, this->dqL, ddqL, this->tauL);
+		this->dynamicsR->inverseDynamics(this->qR, this->dqR, ddqR, this->tauR);
+		for(k = 0; k < NUM_ARM_JOINTS; k++)
+		{
+			this->tauL[k] += this->tauL_ref[k];
+			this->tauR[k] += this->tauR_ref[k];
+			
+			// PWM of the servos proportional to the joint torque
+			this->pwmL[k] = fmax(-1.0, fmin(1.0, this->tauL[k]/SIM_PWM_TORQUE));
+			this->pwmR[k] = fmax(-1.0, fmin(1.0, this->tauR[k]/SIM_PWM_TORQUE));
+		}
+	}
+	else if(this->mode == LiCAS_CONTROL_MODE_TCP_POS)
+	{
+		for(k = 0; k < 3; k++)
+		{
+			this->pL[k] = (s < 1) ? this->pL_ini[k] + s*(this->pL_ref[k] - this->pL_ini[k]) : this->pL_ref[k];
+			this->pR[k] = (s < 1) ? this->pR_ini[k] + s*(this->pR_ref[k] - this->pR_ini[k]) : this->pR_ref[k];
+		}
+	}
+}
+
+
+void LiCAS_Simulator::simulationThreadFunction()
+{
+	struct timespec deadline;
+	char buffer[1024];
+	long period_ns = (long)(1e9/this->loopRate);
+	uint64_t cycle = 0;
+	int dataReceived = 0;
+	int numRxPaths = 1;
+	int k = 0;
+	double t = 0;
+	double t_nextStatus = 0;
+	
+	
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	
+	/******************************** THREAD LOOP START ********************************/
+	
+	while(this->flagTerminateThread == 0)
+	{
+		t = this->getElapsedTime();
+		
+		// Process all the control references received since the last cycle (over all the paths)
+		while((dataReceived = recv(this->socketReceiver, buffer, sizeof(buffer), 0)) > 0)
+		{
+			if(this->processPacket(buffer, dataReceived, t) == 1)
+				cycle = 0;
+		}
+		numRxPaths = __atomic_load_n(&this->numPaths, __ATOMIC_ACQUIRE);
+		for(k = 1; k < numRxPaths; k++)
+		{
+			while((dataReceived = recv(this->pathSocketReceiver[k], buffer, sizeof(buffer), 0)) > 0)
+			{
+				if(this->processPacket(buffer, dataReceived, t) == 1)
+					cycle = 0;
+			}
+		}
+		
+		this->updateState(t, 1.0/this->loopRate);
+		
+		// Send the feedback data packet every feedbackDecimation cycles
+		if(cycle % this->feedbackDecimation == 0)
+			this->sendFeedbackPacket(t);
+		cycle++;
+		
+		// Send the status and diagnostics data packets at low rate
+		if(t >= t_nextStatus)
+		{
+			this->sendStatusPackets(t);
+			t_nextStatus = t + SIM_STATUS_PERIOD;
+		}
+		
+		// Wait until the next period
+		deadline.tv_nsec += period_ns;
+		while(deadline.tv_nsec >= 1000000000L)
+		{
+			deadline.tv_nsec -= 1000000000L;
+			deadline.tv_sec++;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+	}
+	
+	/******************************** THREAD LOOP END ********************************/
+	
+	this->flagSimulationThreadTerminated = 1;
+}
+
+
+/*
+ * Process a data packet received from the LiCAS ECI according to its size and packetID. Of the data
+ * packets in a multipath envelope, only the first copy is processed. Returns 1 if the feedback rate
+ * has been changed (the decimation of the feedback starts again).
+ */
+int LiCAS_Simulator::processPacket(const char * buffer, int size, double t)
+{
+	int flagFeedbackRate = 0;
+	
+	
+	if(this->multipath.isWrapped(buffer, size) == 1)
+	{
+		if(this->multipath.acceptPacket(buffer, size, t) == 1)
+			flagFeedbackRate = this->processPacket(buffer + sizeof(LiCAS_MULTIPATH_HEADER), size - sizeof(LiCAS_MULTIPATH_HEADER), t);
+	}
+	else if(size == sizeof(LiCAS_CONTROL_REF_DATA_PACKET))
+		this->processControlRefPacket((LiCAS_CONTROL_REF_DATA_PACKET*)buffer, t);
+	else if(size == sizeof(LiCAS_TRAJECTORY_CHUNK_DATA_PACKET) && buffer[0] == LiCAS_PACKET_ID_TRAJECTORY_CHUNK)
+		this->processTrajectoryChunkPacket((LiCAS_TRAJECTORY_CHUNK_DATA_PACKET*)buffer, t);
+	else if(size == sizeof(LiCAS_FEEDBACK_RATE_DATA_PACKET) && buffer[0] == LiCAS_PACKET_ID_FEEDBACK_RATE)
+	{
+		this->processFeedbackRatePacket((LiCAS_FEEDBACK_RATE_DATA_PACKET*)buffer, t);
+		flagFeedbackRate = 1;
+	}
+	
+	
+	return flagFeedbackRate;
+}
+
+
+/*
+ * Send a data packet to the LiCAS ECI, over all the paths (each one from its own socket) inside an
+ * envelope if the multipath transport is enabled. Returns 1 if it is sent over any path.
+ */
+int LiCAS_Simulator::sendPacket(const void * dataPacket, int packetSize, double t)
+{
+	char buffer[MAX_MULTIPATH_PACKET_SIZE];
+	int envelopeSize = 0;
+	int flagSent = 0;
+	int k = 0;
+	
+	
+	if(this->numPaths == 1)
+		flagSent = (sendto(this->socketSender, (const char*)dataPacket, packetSize, 0, (struct sockaddr*)&addrECI, sizeof(struct sockaddr)) == packetSize) ? 1 : 0;
+	else if((envelopeSize = this->multipath.wrapPacket(buffer, dataPacket, packetSize, (float)t)) > 0)
+	{
+		for(k = 0; k < this->numPaths; k++)
+		{
+			this->multipath.setPath(buffer, k);
+			if(sendto(this->pathSocketSender[k], buffer, envelopeSize, 0, (struct sockaddr*)&addrPath[k], sizeof(struct sockaddr)) == envelopeSize)
+				flagSent = 1;
+		}
+	}
+	
+	
+	return flagSent;
+}
+
+
+/*
+ * Apply the feedback rate request of the LiCAS ECI, with the nearest rate supported by the loop
+ * rate, and send the acknowledgment before the first feedback data packet at the new rate
+ */
+void LiCAS_Simulator::processFeedbackRatePacket(const LiCAS_FEEDBACK_RATE_DATA_PACKET * feedbackRateDataPacket, double t)
+{
+	LiCAS_FEEDBACK_RATE_ACK_DATA_PACKET dataPacketAck;
+	float rate = feedbackRateDataPacket->rate;
+	int decimation = 1;
+	
+	
+	this->numFeedbackRateRequests++;
+	
+	bzero(&dataPacketAck, sizeof(LiCAS_FEEDBACK_RATE_ACK_DATA_PACKET));
+	dataPacketAck.packetID = LiCAS_PACKET_ID_FEEDBACK_RATE_ACK;
+	dataPacketAck.sequence = feedbackRateDataPacket->sequence;
+	dataPacketAck.result = LiCAS_FEEDBACK_RATE_APPLIED;
+	
+	// Nearest integer decimation of the loop rate (the loop rate is the maximum)
+	if(rate > 0)
+		decimation = (int)lroundf(this->loopRate/rate);
+	if(decimation < 1)
+		decimation = 1;
+	this->feedbackDecimation = decimation;
+	this->feedbackRate = this->loopRate/decimation;
+	if(fabsf(this->feedbackRate - rate) > 1e-3*rate)
+		dataPacketAck.result = LiCAS_FEEDBACK_RATE_ADJUSTED;
+	
+	this->feedbackChannels = feedbackRateDataPacket->channels & LiCAS_FEEDBACK_CHANNEL_ALL;
+	if(this->feedbackChannels != feedbackRateDataPacket->channels)
+		dataPacketAck.result = LiCAS_FEEDBACK_RATE_ADJUSTED;
+	
+	dataPacketAck.channels = this->feedbackChannels;
+	dataPacketAck.rate = this->feedbackRate;
+	dataPacketAck.timeStamp = (float)t;
+	this->sendPacket(&dataPacketAck, sizeof(LiCAS_FEEDBACK_RATE_ACK_DATA_PACKET), t);
+}
+
+
+/*
+ * Send the feedback data packet with the selected channels (the others are zero)
+ */
+void LiCAS_Simulator::sendFeedbackPacket(double t)
+{
+	LiCAS_FEEDBACK_DATA_PACKET dataPacketFeedback;
+	uint8_t channels = this->feedbackChannels;
+	int k = 0;
+	
+	
+	bzero(&dataPacketFeedback, sizeof(LiCAS_FEEDBACK_DATA_PACKET));
+	dataPacketFeedback.packetID = LiCAS_PACKET_ID_FEEDBACK;
+	for(k = 0; k < 3 && (channels & LiCAS_FEEDBACK_CHANNEL_TCP_POS) != 0; k++)
+	{
+		dataPacketFeedback.pL[k] = this->pL[k];
+		dataPacketFeedback.pR[k] = this->pR[k];
+	}
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		if((channels & LiCAS_FEEDBACK_CHANNEL_JOINT_POS) != 0)
+		{
+			dataPacketFeedback.qL[k] = this->qL[k];
+			dataPacketFeedback.qR[k] = this->qR[k];
+		}
+		if((channels & LiCAS_FEEDBACK_CHANNEL_JOINT_SPD) != 0)
+		{
+			dataPacketFeedback.dqL[k] = this->dqL[k];
+			dataPacketFeedback.dqR[k] = this->dqR[k];
+		}
+		if((channels & LiCAS_FEEDBACK_CHANNEL_JOINT_TRQ) != 0)
+		{
+			dataPacketFeedback.tauL[k] = this->tauL[k];
+			dataPacketFeedback.tauR[k] = this->tauR[k];
+		}
+		if((channels & LiCAS_FEEDBACK_CHANNEL_PWM) != 0)
+		{
+			dataPacketFeedback.pwmL[k] = this->pwmL[k];
+			dataPacketFeedback.pwmR[k] = this->pwmR[k];
+		}
+	}
+	if(this->sendPacket(&dataPacketFeedback, sizeof(LiCAS_FEEDBACK_DATA_PACKET), t) == 1)
+		this->numFeedbackPackets++;
+}
+
+
+/*
+ * Send the status and diagnostics data packets of the simulated LiCAS computer board
+ */
+void LiCAS_Simulator::sendStatusPackets(double t)
+{
+	LiCAS_STATUS_DATA_PACKET dataPacketStatus;
+	LiCAS_DIAGNOSTICS_DATA_PACKET dataPacketDiagnostics;
+	int k = 0;
+	
+	
+	dataPacketStatus.packetID = LiCAS_PACKET_ID_STATUS;
+	dataPacketStatus.controlMode = this->mode;
+	dataPacketStatus.armsEnabled = 0x03;
+	dataPacketStatus.errorFlags = 0;
+	dataPacketStatus.loopTime = 1.0/this->loopRate;
+	dataPacketStatus.cpuLoad = 0;
+	dataPacketStatus.supplyVoltage = 12.0;
+	dataPacketStatus.timeStamp = (float)t;
+	if(this->sendPacket(&dataPacketStatus, sizeof(LiCAS_STATUS_DATA_PACKET), t) == 1)
+		this->numStatusPackets++;
+	
+	dataPacketDiagnostics.packetID = LiCAS_PACKET_ID_DIAGNOSTICS;
+	for(k = 0; k < NUM_ARM_JOINTS; k++)
+	{
+		dataPacketDiagnostics.servoTemperatureL[k] = 35.0 + 10.0*fabs(this->pwmL[k]);
+		dataPacketDiagnostics.servoTemperatureR[k] = 35.0 + 10.0*fabs(this->pwmR[k]);
+		dataPacketDiagnostics.servoVoltageL[k] = 12.0;
+		dataPacketDiagnostics.servoVoltageR[k] = 12.0;
+		dataPacketDiagnostics.servoErrorL[k] = 0;
+		dataPacketDiagnostics.servoErrorR[k] = 0;
+	}
+	if(this->sendPacket(&dataPacketDiagnostics, sizeof(LiCAS_DIAGNOSTICS_DATA_PACKET), t) == 1)
+		this->numStatusPackets++;
+}
+
+
+/*
+ * Stop the simulation thread and close the UDP sockets.
+ */
+int LiCAS_Simulator::closeSimulator()
+{
+	int errorCode = 0;
+	int k = 0;
+	
+	
+	if(this->socketSender >= 0)
+	{
+		this->flagTerminateThread = 1;
+		pthread_join(this->simulationThread, NULL);
+		
+		close(this->socketSender);
+		close(this->socketReceiver);
+		this->socketSender = -1;
+		this->socketReceiver = -1;
+		
+		// Close the sockets of the other paths of the multipath transport
+		for(k = 1; k < this->numPaths; k++)
+		{
+			close(this->pathSocketSender[k]);
+			close(this->pathSocketReceiver[k]);
+			this->pathSocketSender[k] = -1;
+			this->pathSocketReceiver[k] = -1;
+		}
+		this->numPaths = 1;
+		this->multipath.setNumPaths(1);
+	}
+	else
+		errorCode = 1;
+	
+	
+	return errorCode;
+}
+
@@ -0,0 +1,295 @@
+/*
+ *
+ * LiCAS Simulator through UDP sockets - LiCAS_Simulator.h
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * Local stand-in of the LiCAS control program. It receives the control reference data packets
+ * sent by the LiCAS ECI, interpolates the joint references over the play time as the computer
+ * board does, and sends back the feedback data packet at a fixed rate. It is used to run the
+ * LiCAS ECI programs and benchmarks in localhost without the physical arms. In the joint position
+ * mode, the joint torques of the feedback are those needed by the rigid body model of the arms
+ * (LiCAS_ArmDynamics) to follow the interpolated motion, plus the last joint torque references
+ * received, and the PWM of the servos is proportional to these torques. The joint torque references
+ * do not stop the interpolation of the positions, as if the arms were moved by an operator (master
+ * arm of a bilateral teleoperation).
+ *
+ * The setpoints of the trajectory chunks are stored in a buffer indexed by their index in the
+ * trajectory, and followed with a fixed delay (buffer delay) after their time, converted from the
+ * clock of the LiCAS ECI with the minimum offset observed between the reception time and the time
+ * stamp of the chunks. The references are interpolated between the buffered setpoints, so a chunk
+ * that arrives late or is lost does not stop the motion while the following setpoints are buffered.
+ *
+ * The simulation loop runs at the rate given when the simulator is opened, and the feedback data
+ * packet is sent every N cycles of the loop, so the feedback rates applied on a request of the LiCAS
+ * ECI are the loop rate divided by an integer (the nearest one to the requested rate).
+ *
+ * With the paths of the multipath redundant transport added, the data packets are sent over all the
+ * paths inside an envelope with a sequence number, and only the first copy of each data packet
+ * received from the LiCAS ECI is processed.
+ *
+ */
+
+#ifndef LICAS_SIMULATOR_H_
+#define LICAS_SIMULATOR_H_
+
+
+// Standard library
+#include <string>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <math.h>
+
+
+// Specific library
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_Packets.h"
+#include "../LiCAS_ECI_UDP/LiCAS_ECI_Multipath.h"
+#include "../LiCAS_Kinematics/LiCAS_ArmDynamics.h"
+
+
+#define SIM_STATUS_PERIOD	1.0		// Period of the status and diagnostics data packets in [s]
+#define SIM_PWM_TORQUE		2.0		// Torque of the servos per unit of PWM in [Nm]
+#define SIM_TRAJECTORY_BUFFER_SIZE	256		// Setpoints of the trajectory buffer (power of 2)
+#define SIM_TRAJECTORY_DELAY		0.02	// Default delay of the setpoints of the trajectory buffer in [s]
+
+
+class LiCAS_Simulator
+{
+public:
+
+	/***************** PUBLIC VARIABLES *****************/
+	
+	float pL[3];					// Cartesian position of left TCP in [m]
+	float pR[3];					// Cartesian position of right TCP in [m]
+	float qL[NUM_ARM_JOINTS];		// Joint position left arm in [rad]
+	float qR[NUM_ARM_JOINTS];		// Joint position right arm in [rad]
+	float dqL[NUM_ARM_JOINTS];		// Joint speed left arm in [rad/s]
+	float dqR[NUM_ARM_JOINTS];		// Joint speed right arm in [rad/s]
+	float tauL[NUM_ARM_JOINTS];		// Joint torque left arm in [Nm]
+	float tauR[NUM_ARM_JOINTS];		// Joint torque right arm in [Nm]
+	float pwmL[NUM_ARM_JOINTS];		// Joint PWM left arm in [-1, 1]
+	float pwmR[NUM_ARM_JOINTS];		// Joint PWM right arm in [-1, 1]
+	
+	
+	/***************** PUBLIC METHODS *****************/
+	
+	/*
+	 * Constructor
+	 *
+	 * Parameters:
+	 * 	(1) Name of the simulated LiCAS (example: "LiCAS-A1-Sim")
+	 * */
+	LiCAS_Simulator(const std::string &_LiCAS_Simulator_Name);
+	
+	
+	/*
+	 * Destructor
+	 * */
+	virtual ~LiCAS_Simulator();
+	
+	
+	/*
+	 * Open the UDP sockets and start the simulation thread.
+	 *
+	 * Parameters:
+	 * 	(1) IP address of the computer executing the LiCAS ECI
+	 *	(2) UDP port for receiving the control references (Tx port of the LiCAS ECI)
+	 *	(3) UDP port for sending the feedback data packet (Rx port of the LiCAS ECI)
+	 *	(4) Rate of the simulation loop and initial rate of the feedback data packet in [Hz]
+	 */
+	int openSimulator(const std::string &_ECI_IP_Address, int _UDP_RxPort, int _UDP_TxPort, float _feedbackRate);
+	
+	
+	/*
+	 * Add a path to the multipath redundant transport (after openSimulator(), in the same order as
+	 * in the LiCAS ECI).
+	 *
+	 * Parameters:
+	 * 	(1) IP address of the computer executing the LiCAS ECI through the path
+	 *	(2) UDP port for receiving the control references through the path
+	 *	(3) UDP port for sending the feedback data packet through the path
+	 *	(4) Network interface of the path (NULL: given by the route to the LiCAS ECI)
+	 */
+	int addPath(const std::string &_ECI_IP_Address, int _UDP_RxPort, int _UDP_TxPort, const char * interfaceName);
+	
+	
+	/*
+	 * Copy the statistics of the paths of the multipath transport (data packets sent, control
+	 * references received). Returns the number of paths.
+	 */
+	int getPathStatistics(LiCAS_ECI_PATH_STATISTICS * pathStatistics);
+	
+	
+	/*
+	 * Number of control reference data packets received
+	 */
+	uint64_t getNumControlRefPackets();
+	
+	
+	/*
+	 * Number of feedback data packets sent
+	 */
+	uint64_t getNumFeedbackPackets();
+	
+	
+	/*
+	 * Number of status and diagnostics data packets sent
+	 */
+	uint64_t getNumStatusPackets();
+	
+	
+	/*
+	 * Current rate of the feedback data packet in [Hz]
+	 */
+	float getFeedbackRate();
+	
+	
+	/*
+	 * Number of feedback rate request data packets received
+	 */
+	uint64_t getNumFeedbackRateRequests();
+	
+	
+	/*
+	 * Delay of the setpoints of the trajectory buffer after their time in [s] (before opening the
+	 * simulator). It absorbs the jitter of the trajectory chunks up to this delay.
+	 */
+	void setTrajectoryDelay(float _trajectoryDelay);
+	
+	
+	/*
+	 * Number of trajectory chunk data packets received
+	 */
+	uint64_t getNumTrajectoryChunks();
+	
+	
+	/*
+	 * Number of control cycles of a trajectory in which the next setpoint was not buffered (buffer
+	 * underrun, or end of the trajectory)
+	 */
+	uint64_t getNumTrajectoryUnderruns();
+	
+	
+	/*
+	 * Stop the simulation thread and close the UDP sockets.
+	 */
+	int closeSimulator();
+	
+
+private:
+
+	/***************** PRIVATE VARIABLES *****************/
+	std::string LiCAS_Simulator_Name;
+	
+	pthread_t simulationThread;
+	
+	struct sockaddr_in addrECI;
+	int UDP_RxPort;
+	int UDP_TxPort;
+	int socketSender;
+	int socketReceiver;
+	float loopRate;
+	
+	// Feedback rate negotiated with the LiCAS ECI (feedback sent every feedbackDecimation cycles)
+	float feedbackRate;
+	int feedbackDecimation;
+	uint8_t feedbackChannels;
+	uint64_t numFeedbackRateRequests;
+	
+	// Multipath redundant transport (path 0 is the primary one: socketSender, socketReceiver and addrECI)
+	LiCAS_ECI_Multipath multipath;
+	int numPaths;
+	int pathSocketSender[MAX_MULTIPATH_PATHS];
+	int pathSocketReceiver[MAX_MULTIPATH_PATHS];
+	struct sockaddr_in addrPath[MAX_MULTIPATH_PATHS];
+	
+	// Joint interpolation from the last reference received
+	float qL_ini[NUM_ARM_JOINTS];
+	float qR_ini[NUM_ARM_JOINTS];
+	float qL_ref[NUM_ARM_JOINTS];
+	float qR_ref[NUM_ARM_JOINTS];
+	float pL_ini[3];
+	float pR_ini[3];
+	float pL_ref[3];
+	float pR_ref[3];
+	float tauL_ref[NUM_ARM_JOINTS];
+	float tauR_ref[NUM_ARM_JOINTS];
+	uint8_t mode;
+	float playTime;
+	double t_ref;
+	
+	// Trajectory buffer (setpoint n in the position n & (SIM_TRAJECTORY_BUFFER_SIZE - 1))
+	LiCAS_TRAJECTORY_SETPOINT trajectoryBuffer[SIM_TRAJECTORY_BUFFER_SIZE];
+	uint32_t trajectoryBufferIndex[SIM_TRAJECTORY_BUFFER_SIZE];		// Index of each buffered setpoint
+	uint8_t trajectoryBufferValid[SIM_TRAJECTORY_BUFFER_SIZE];
+	int flagTrajectory;
+	uint16_t trajectoryID;
+	uint32_t trajectoryIndex;			// Index of the setpoint at the start of the current segment
+	double trajectoryOffset;			// Minimum offset of the clock of the LiCAS ECI in [s]
+	float trajectoryDelay;
+	uint64_t numTrajectoryChunks;
+	uint64_t numTrajectoryUnderruns;
+	
+	// Rigid body model of the arms for the joint torques
+	LiCAS_ArmDynamics * dynamicsL;
+	LiCAS_ArmDynamics * dynamicsR;
+	
+	struct timespec tini;
+	
+	uint64_t numControlRefPackets;
+	uint64_t numFeedbackPackets;
+	uint64_t numStatusPackets;
+	
+	int flagTerminateThread;
+	int flagSimulationThreadTerminated;
+	
+	
+	/***************** PRIVATE METHODS *****************/
+	
+	static void * simulationThreadEntry(void * arg);
+	
+	void simulationThreadFunction();
+	
+	int processPacket(const char * buffer, int size, double t);
+	
+	int sendPacket(const void * dataPacket, int packetSize, double t);
+	
+	void processControlRefPacket(const LiCAS_CONTROL_REF_DATA_PACKET * controlRefDataPacket, double t);
+	
+	void processTrajectoryChunkPacket(const LiCAS_TRAJECTORY_CHUNK_DATA_PACKET * trajectoryChunkDataPacket, double t);
+	
+	void processFeedbackRatePacket(const LiCAS_FEEDBACK_RATE_DATA_PACKET * feedbackRateDataPacket, double t);
+	
+	void sendFeedbackPacket(double t);
+	
+	int isSetpointBuffered(uint32_t index);
+	
+	void updateTrajectory(double t);
+	
+	void updateState(double t, float dt);
+	
+	void sendStatusPackets(double t);
+	
+	double getElapsedTime();
+	
+
+};
+
+#endif
+
@@ -0,0 +1,98 @@
+/*
+ *
+ * LiCAS Simulator through UDP sockets - Main_BasePoseSimulator.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * This program publishes the pose of a simulated aerial platform, a local stand-in of its
+ * IMU/odometry, for the floating base compensation of the LiCAS ECI (LiCAS_FloatingBase). It takes
+ * as input argument the IP address of the computer running the LiCAS ECI, the UDP port of the base
+ * pose data packets and, optionally, the rate in Hz and the age of the measurements in seconds.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+
+
+// Specific library
+#include "LiCAS_BasePoseSimulator.h"
+
+
+static volatile sig_atomic_t flagExit = 0;
+
+
+static void signalHandler(int signum)
+{
+	flagExit = 1;
+}
+
+
+int main(int argc, char ** argv)
+{
+	LiCAS_BasePoseSimulator * publisher = NULL;
+	float rate = 1000;
+	float age = 0.005;
+	int errorCode = 0;
+	
+	
+	printf("__________________________________________\n");
+	printf("LiCAS Base Pose Simulator UDP\n");
+	printf("Author: Alejandro Suarez, asuarezfm@us.es\n");
+	printf("LiCAS Robotic Arms Initiative, #licas_ra\n");
+	printf("__________________________________________\n");
+	printf("\n");
+	
+	if(argc < 3 || argc > 5)
+	{
+		errorCode = 1;
+		printf("ERROR [in main]: invalid number of arguments.\n");
+		printf("Specify ECI IP address, UDP port of the base pose and (optionally) rate in Hz and age in s.\n");
+		printf("Example: ./LiCAS_BasePoseSim 127.0.0.1 25000 1000 0.005\n");
+		printf("\n");
+	}
+	else
+	{
+		if(argc >= 4)
+			rate = atof(argv[3]);
+		if(argc == 5)
+			age = atof(argv[4]);
+		
+		signal(SIGINT, signalHandler);
+		signal(SIGTERM, signalHandler);
+		
+		publisher = new LiCAS_BasePoseSimulator();
+		errorCode = publisher->openPublisher(argv[1], atoi(argv[2]), rate, age);
+		
+		if(errorCode != 0)
+			printf("ERROR [in main]: could not open base pose publisher\n");
+		else
+		{
+			// Run until Ctrl+C
+			while(flagExit == 0)
+			{
+				sleep(1);
+				printf("Base pose packets sent: %llu\n", (unsigned long long)publisher->getNumPackets());
+			}
+			
+			publisher->closePublisher();
+		}
+		
+		delete publisher;
+	}
+	
+	
+	return errorCode;
+}
+
@@ -0,0 +1,107 @@
+/*
+ *
+ * LiCAS Simulator through UDP sockets - Main_InputReplayer.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * This program replays a recording of an operator input device (joystick, haptic device, motion
+ * capture), a local stand-in of the device for the operator input stream of the LiCAS ECI
+ * (LiCAS_OperatorInput). It takes as input argument the IP address of the computer receiving the
+ * input, the UDP port of the operator input, the recording file and, optionally, the identifier of
+ * the device, the maximum random delay of the packets in seconds, and 1 for replaying in a loop.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+
+
+// Specific library
+#include "LiCAS_InputReplayer.h"
+
+
+static volatile sig_atomic_t flagExit = 0;
+
+
+static void signalHandler(int signum)
+{
+	flagExit = 1;
+}
+
+
+int main(int argc, char ** argv)
+{
+	LiCAS_InputReplayer * replayer = NULL;
+	int deviceID = 0;
+	float jitter = 0;
+	int flagLoop = 0;
+	int errorCode = 0;
+	
+	
+	printf("__________________________________________\n");
+	printf("LiCAS Operator Input Replayer UDP\n");
+	printf("Author: Alejandro Suarez, asuarezfm@us.es\n");
+	printf("LiCAS Robotic Arms Initiative, #licas_ra\n");
+	printf("__________________________________________\n");
+	printf("\n");
+	
+	if(argc < 4 || argc > 7)
+	{
+		errorCode = 1;
+		printf("ERROR [in main]: invalid number of arguments.\n");
+		printf("Specify IP address, UDP port of the operator input, recording file and (optionally) device ID, jitter in s and loop (0/1).\n");
+		printf("Example: ./LiCAS_InputReplay 127.0.0.1 26000 LiCAS_InputRecording.txt 0 0.002 1\n");
+		printf("\n");
+	}
+	else
+	{
+		if(argc >= 5)
+			deviceID = atoi(argv[4]);
+		if(argc >= 6)
+			jitter = atof(argv[5]);
+		if(argc == 7)
+			flagLoop = atoi(argv[6]);
+		
+		signal(SIGINT, signalHandler);
+		signal(SIGTERM, signalHandler);
+		
+		replayer = new LiCAS_InputReplayer();
+		errorCode = replayer->load(argv[3]);
+		if(errorCode != 0)
+			printf("ERROR [in main]: could not load recording file \"%s\"\n", argv[3]);
+		else
+		{
+			errorCode = replayer->openReplayer(argv[1], atoi(argv[2]), deviceID, jitter, flagLoop);
+			if(errorCode != 0)
+				printf("ERROR [in main]: could not open input replayer\n");
+			else
+			{
+				// Run until the end of the recording or Ctrl+C
+				while(flagExit == 0 && replayer->isFinished() == 0)
+				{
+					sleep(1);
+					printf("Operator input packets sent: %llu\n", (unsigned long long)replayer->getNumPackets());
+				}
+				
+				replayer->closeReplayer();
+			}
+		}
+		
+		delete replayer;
+	}
+	
+	
+	return errorCode;
+}
+
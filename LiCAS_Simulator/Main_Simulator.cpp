@@ -0,0 +1,96 @@
+/*
+ *
+ * LiCAS Simulator - Main_Simulator.cpp
+ *
+ * Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+ *
+ * LiCAS Robotic Arms Project: Lightweight and Compliant Anthropomorphic Dual Arm System
+ *
+ * Instagram: licas_ra
+ * LinkedIn: LiCAS Robotic Arms
+ *
+ * Date: November 2025
+ *
+ * This program runs the LiCAS simulator, a local stand-in of the LiCAS Control Program executed
+ * in the computer board of the arms. It takes as input argument the IP address of the computer
+ * running the LiCAS ECI, the UDP port in which the control references are received, the UDP port
+ * to which the feedback data packets are sent and, optionally, the feedback rate in Hz.
+ *
+ */
+
+
+// Standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+
+
+// Specific library
+#include "LiCAS_Simulator.h"
+
+
+static volatile sig_atomic_t flagExit = 0;
+
+
+static void signalHandler(int signum)
+{
+	flagExit = 1;
+}
+
+
+int main(int argc, char ** argv)
+{
+	LiCAS_Simulator * licas_sim = NULL;
+	float feedbackRate = 100;
+	int errorCode = 0;
+	
+	
+	printf("__________________________________________\n");
+	printf("LiCAS Simulator UDP\n");
+	printf("Author: Alejandro Suarez, asuarezfm@us.es\n");
+	printf("LiCAS Robotic Arms Initiative, #licas_ra\n");
+	printf("__________________________________________\n");
+	printf("\n");
+	
+	if(argc != 4 && argc != 5)
+	{
+		errorCode = 1;
+		printf("ERROR [in main]: invalid number of arguments.\n");
+		printf("Specify ECI IP address, UDP Rx port, UDP Tx port and (optionally) feedback rate in Hz.\n");
+		printf("Example: ./LiCAS_Sim 127.0.0.1 23000 24003 100\n");
+		printf("\n");
+	}
+	else
+	{
+		if(argc == 5)
+			feedbackRate = atof(argv[4]);
+		
+		signal(SIGINT, signalHandler);
+		signal(SIGTERM, signalHandler);
+		
+		licas_sim = new LiCAS_Simulator("LiCAS_A1_Simulator");
+		errorCode = licas_sim->openSimulator(argv[1], atoi(argv[2]), atoi(argv[3]), feedbackRate);
+		
+		if(errorCode != 0)
+			printf("ERROR [in main]: could not open LiCAS simulator\n");
+		else
+		{
+			// Run until Ctrl+C
+			while(flagExit == 0)
+			{
+				sleep(1);
+				printf("Control references received: %llu, feedback packets sent: %llu (%.1f Hz)\n",
+					(unsigned long long)licas_sim->getNumControlRefPackets(), (unsigned long long)licas_sim->getNumFeedbackPackets(), licas_sim->getFeedbackRate());
+			}
+			
+			licas_sim->closeSimulator();
+		}
+		
+		delete licas_sim;
+	}
+	
+	
+	return errorCode;
+}
+
@@ -71,6 +71,12 @@ int main(int argc, char ** argv)
 		
 		if(errorCode != 0)
 			cout << "ERROR [in main]: could not open LiCAS ECI" << endl;
+		else if(licas_eci->waitForLink(5.0) != 0)
+		{
+			errorCode = 1;
+			cout << "ERROR [in main]: LiCAS control program not responding" << endl;
+			licas_eci->closeInterface();
+		}
 		else
 		{
 			// Joint position references
@@ -80,6 +86,7 @@ int main(int argc, char ** argv)
 			double AR[NUM_ARM_JOINTS] = {-30, -10, 45, -60};
 			float f = 0.25;
 			float playTime = 0.25;
+			int numCycles = 0;
 			
 			// Generate a sinusoidal joint position reference for 10 seconds
 			while(t < 10.0)
@@ -93,6 +100,11 @@ int main(int argc, char ** argv)
 				// Send the joint reference through the external control interface
 				licas_eci->sendJointPositionRef(qLref, qRref, playTime);
 				
+				// Print the feedback every 0.5 seconds (outside the reception thread)
+				if(numCycles % 25 == 0)
+					licas_eci->printFeedback();
+				numCycles++;
+				
 				// Wait 20 ms = 50 Hz rate
 				usleep(20000);
 				
@@ -101,7 +113,11 @@ int main(int argc, char ** argv)
 			}
 			
 			// Close interface
-			licas_eci->closeInterface();
+			errorCode = licas_eci->closeInterface();
+			
+			// Report the allocations in the send/receive paths (allocation tracking mode)
+			if(LiCAS_ECI_AllocTracker::isEnabled())
+				cout << "Hot path heap allocations: " << licas_eci->getHotPathAllocations() << endl;
 		}
 	}
 		
@@ -0,0 +1,71 @@
+#!/bin/bash
+#
+# LiCAS External Control Interface (ECI) - benchmark_build_configs.sh
+#
+# Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+#
+# Builds the LiCAS ECI in the Release, LTO and LTO+PGO configurations and runs the loopback
+# benchmarks with each of them, reporting the gain of every benchmark w.r.t. the Release build.
+# The PGO profile is collected running the loopback benchmarks with the instrumented build.
+#
+# Usage (from the repository root): ./Tools/benchmark_build_configs.sh [iterations scale]
+#
+
+SCALE=${1:-1}
+SRC_DIR=$(cd "$(dirname "$0")/.." && pwd)
+WORK_DIR=$(mktemp -d)
+CONFIGS="RELEASE LTO PGO"
+
+
+# Configure and build one configuration. Arguments: build folder, extra cmake options
+build()
+{
+	cmake -S "$SRC_DIR" -B "$1" -DCMAKE_BUILD_TYPE=Release "${@:2}" > /dev/null || exit 1
+	cmake --build "$1" -j"$(nproc)" > /dev/null || exit 1
+}
+
+
+for CONFIG in $CONFIGS
+do
+	BUILD_DIR="$WORK_DIR/build_$CONFIG"
+	echo "Building $CONFIG configuration..."
+
+	case $CONFIG in
+		RELEASE)
+			build "$BUILD_DIR" ;;
+		LTO)
+			build "$BUILD_DIR" -DLICAS_ECI_LTO=ON ;;
+		PGO)
+			build "$BUILD_DIR" -DLICAS_ECI_LTO=ON -DLICAS_ECI_PGO=GENERATE
+			cmake --build "$BUILD_DIR" --target pgo_train > /dev/null 2>&1 || exit 1
+			build "$BUILD_DIR" -DLICAS_ECI_LTO=ON -DLICAS_ECI_PGO=USE ;;
+	esac
+
+	(cd "$BUILD_DIR/Benchmark" && ./LiCAS_ECI_Benchmark $SCALE 2>&1 > /dev/null | grep "^BENCH") > "$WORK_DIR/results_$CONFIG.txt"
+done
+
+
+# Report the results of each configuration and the gain w.r.t. the Release build
+echo
+printf "%-24s" "BENCHMARK"
+for CONFIG in $CONFIGS; do printf "%14s" "$CONFIG"; done
+for CONFIG in $CONFIGS; do if [ "$CONFIG" != "RELEASE" ]; then printf "%12s" "GAIN $CONFIG"; fi; done
+echo
+
+while read TAG NAME VALUE UNITS
+do
+	printf "%-24s" "$NAME [$UNITS]"
+	for CONFIG in $CONFIGS
+	do
+		printf "%14s" "$(awk -v n="$NAME" '$2==n {print $3}' "$WORK_DIR/results_$CONFIG.txt")"
+	done
+	for CONFIG in $CONFIGS
+	do
+		if [ "$CONFIG" != "RELEASE" ]; then
+			awk -v n="$NAME" -v ref="$VALUE" '$2==n {printf "%11.1f%%", 100*(ref - $3)/ref}' "$WORK_DIR/results_$CONFIG.txt"
+		fi
+	done
+	echo
+done < "$WORK_DIR/results_RELEASE.txt"
+
+rm -rf "$WORK_DIR"
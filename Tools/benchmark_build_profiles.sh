@@ -0,0 +1,58 @@
+#!/bin/bash
+#
+# LiCAS External Control Interface (ECI) - benchmark_build_profiles.sh
+#
+# Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+#
+# Compares the full-featured and the lean (LICAS_ECI_LEAN) build profiles of the LiCAS ECI library.
+# For each profile, a minimal program that creates the interface instance is linked against the
+# library, reporting its binary size, the number of global constructors and the startup time.
+#
+# Usage (from the repository root): ./Tools/benchmark_build_profiles.sh [number of runs]
+#
+
+RUNS=${1:-200}
+SRC_DIR=$(cd "$(dirname "$0")/.." && pwd)
+WORK_DIR=$(mktemp -d)
+
+cat > "$WORK_DIR/probe.cpp" << 'PROBE'
+#include "LiCAS_ECI_UDP.h"
+
+int main()
+{
+	LiCAS_ECI_UDP licas_eci("LiCAS_Probe");
+
+	return (int)licas_eci.getElapsedTime();
+}
+PROBE
+
+printf "%-8s %12s %12s %12s %14s\n" "PROFILE" "TEXT [B]" "DATA [B]" "CTORS" "STARTUP [us]"
+
+for PROFILE in FULL LEAN
+do
+	if [ "$PROFILE" == "LEAN" ]; then LEAN=ON; else LEAN=OFF; fi
+	BUILD_DIR="$WORK_DIR/build_$PROFILE"
+
+	cmake -S "$SRC_DIR" -B "$BUILD_DIR" -DLICAS_ECI_LEAN=$LEAN -DCMAKE_BUILD_TYPE=Release > /dev/null || exit 1
+	cmake --build "$BUILD_DIR" --target LiCAS_ECI_UDP > /dev/null || exit 1
+
+	FLAGS="-O2"
+	if [ "$LEAN" == "ON" ]; then FLAGS="$FLAGS -DLICAS_ECI_LEAN -ffunction-sections -fdata-sections -Wl,--gc-sections"; fi
+	g++ $FLAGS -I"$SRC_DIR/LiCAS_ECI_UDP" "$WORK_DIR/probe.cpp" "$BUILD_DIR/LiCAS_ECI_UDP/libLiCAS_ECI_UDP.a" -pthread -o "$WORK_DIR/probe_$PROFILE" || exit 1
+	strip "$WORK_DIR/probe_$PROFILE"
+
+	# Binary size and number of global constructors (entries of .init_array)
+	read TEXT DATA BSS <<< $(size "$WORK_DIR/probe_$PROFILE" | awk 'NR==2 {print $1, $2, $3}')
+	INIT_ARRAY=$(readelf -S -W "$WORK_DIR/probe_$PROFILE" | awk '$2==".init_array" {print $6}')
+	CTORS=$(( 16#${INIT_ARRAY:-0} / 8 ))
+
+	# Average startup time (process creation, dynamic linking, static init and exit)
+	T0=$(date +%s%N)
+	for ((i = 0; i < RUNS; i++)); do "$WORK_DIR/probe_$PROFILE"; done
+	T1=$(date +%s%N)
+	STARTUP=$(( (T1 - T0) / (1000*RUNS) ))
+
+	printf "%-8s %12d %12d %12d %14d\n" "$PROFILE" $TEXT $DATA $CTORS $STARTUP
+done
+
+rm -rf "$WORK_DIR"
@@ -0,0 +1,43 @@
+#!/bin/bash
+#
+# LiCAS Identification - frequency_response_sim.sh
+#
+# Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+#
+# End-to-end check of the identification of the frequency response on the LiCAS simulator. The
+# simulator is executed in localhost, a chirp excitation is streamed to the first joint of the left
+# arm with the LiCAS_Excitation program and the Bode diagram is estimated with LiCAS_BodeAnalyzer.
+# The simulator follows the references with the interpolation of the play time, so the estimate
+# shows the delay of the loop (communication, interpolation and feedback rate). The script fails if
+# any of the programs fails (no excited joints or no reliable points of the estimate).
+#
+# Usage (from the repository root, after building in ./build): ./Tools/frequency_response_sim.sh [build folder] [duration]
+#
+
+BUILD_DIR=$(cd "${1:-build}" && pwd) || exit 1
+DURATION=${2:-20}
+WORK_DIR=$(mktemp -d)
+CMD_PORT=23200
+FEEDBACK_PORT=24200
+FEEDBACK_RATE=500
+
+cd "$WORK_DIR"
+
+"$BUILD_DIR/LiCAS_Simulator/LiCAS_Sim" 127.0.0.1 $CMD_PORT $FEEDBACK_PORT $FEEDBACK_RATE > /dev/null &
+SIM_PID=$!
+sleep 0.5
+
+# The interface prints every feedback packet: only the errors are shown
+"$BUILD_DIR/LiCAS_Identification/LiCAS_Excitation" 127.0.0.1 $CMD_PORT $FEEDBACK_PORT L1 chirp 0.5 50 0.05 $DURATION | grep "ERROR"
+RESULT=${PIPESTATUS[0]}
+
+kill $SIM_PID
+wait $SIM_PID 2> /dev/null
+
+if [ $RESULT -eq 0 ]; then
+	"$BUILD_DIR/LiCAS_Identification/LiCAS_BodeAnalyzer" LiCAS_ExcitationLog.txt LiCAS_DataLog.txt
+	RESULT=$?
+fi
+
+rm -rf "$WORK_DIR"
+exit $RESULT
@@ -0,0 +1,62 @@
+#!/bin/bash
+#
+# LiCAS ECI - link_monitor_veth.sh
+#
+# Copyright (c) 2025 Alejandro Suarez, asuarezfm@us.es
+#
+# End-to-end check of the link monitor of the network interface. The LiCAS simulator is executed in
+# a network namespace connected to the host by a veth pair, so the route to the computer board goes
+# through a real interface. The LiCAS_Link_Benchmark program sets the interface down and up, and
+# reports the detection times of the link monitor, the commands held while the interface is down
+# and the time until the feedback is restored. It must be executed as root.
+#
+# Usage (from the repository root, after building in ./build): sudo ./Tools/link_monitor_veth.sh [build folder]
+#
+
+BUILD_DIR=$(cd "${1:-build}" && pwd) || exit 1
+WORK_DIR=$(mktemp -d)
+NETNS=licas_board
+ECI_IF=licas_eci0
+BOARD_IF=licas_board0
+ECI_IP=10.213.0.1
+BOARD_IP=10.213.0.2
+CMD_PORT=23700
+FEEDBACK_PORT=24700
+FEEDBACK_RATE=500
+
+cleanup()
+{
+	[ -n "$SIM_PID" ] && kill $SIM_PID 2> /dev/null && wait $SIM_PID 2> /dev/null
+	ip link del $ECI_IF 2> /dev/null
+	ip netns del $NETNS 2> /dev/null
+	rm -rf "$WORK_DIR"
+}
+trap cleanup EXIT
+
+# Computer board in the namespace, on the other side of the veth pair
+ip netns add $NETNS || exit 1
+ip link add $ECI_IF type veth peer name $BOARD_IF || exit 1
+ip link set $BOARD_IF netns $NETNS
+ip addr add $ECI_IP/24 dev $ECI_IF
+ip link set $ECI_IF up
+ip netns exec $NETNS ip addr add $BOARD_IP/24 dev $BOARD_IF
+ip netns exec $NETNS ip link set $BOARD_IF up
+ip netns exec $NETNS ip link set lo up
+
+cd "$WORK_DIR"
+
+ip netns exec $NETNS "$BUILD_DIR/LiCAS_Simulator/LiCAS_Sim" $ECI_IP $CMD_PORT $FEEDBACK_PORT $FEEDBACK_RATE > /dev/null &
+SIM_PID=$!
+sleep 0.5
+
+# The interface prints every feedback packet: only the results (stderr) are shown
+"$BUILD_DIR/Benchmark/LiCAS_Link_Benchmark" $ECI_IF $BOARD_IP > /dev/null
+RESULT=$?
+
+if [ $RESULT -eq 0 ]; then
+	echo "Link monitor check passed"
+else
+	echo "Link monitor check FAILED"
+fi
+
+exit $RESULT